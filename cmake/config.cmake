@@ -167,6 +167,17 @@ endif()
 #TODO set to disabled. Stuff fails to compile when its on
 set(OMR_THR_TRACING OFF CACHE BOOL "TODO: Document")
 set(OMR_THR_MCS_LOCKS OFF CACHE BOOL "Enable the usage of the MCS lock in the OMR thread monitor.")
+set(OMR_THR_FUTEX OFF CACHE BOOL "Back the OMR thread library's OS mutexes and condition variables with Linux futexes.")
+if(OMR_THR_FUTEX)
+	omr_assert(FATAL_ERROR
+		TEST OMR_OS_LINUX
+		MESSAGE "OMR_THR_FUTEX enabled, but not supported on current platform"
+	)
+	omr_assert(FATAL_ERROR
+		TEST NOT OMR_THR_FORK_SUPPORT
+		MESSAGE "OMR_THR_FUTEX cannot be combined with OMR_THR_FORK_SUPPORT"
+	)
+endif()
 
 #TODO this should maybe be a OMRTHREAD_LIB string variable?
 set(OMRTHREAD_WIN32_DEFAULT OFF)
@@ -163,6 +163,20 @@ public:
 	 */
 	bool objectAllocationNotify(omrobjectptr_t omrObject) { return true; }
 
+	/**
+	 * This will be called for each object selected by the allocation sampler, roughly once every
+	 * -Xgc:allocationSamplingInterval= bytes allocated by omrVMThread. The returned value identifies the allocation
+	 * site (for example a class or a call site) the sample is charged to; returning 0 discards the sample.
+	 *
+	 * The example language has neither classes nor call sites, so objects are charged to their size.
+	 *
+	 * @param omrVMThread the thread that allocated the object
+	 * @param omrObject the sampled object
+	 * @param sizeInBytes the consumed size of the object
+	 * @return the allocation site for the sample, or 0
+	 */
+	uintptr_t objectAllocationSampled(OMR_VMThread *omrVMThread, omrobjectptr_t omrObject, uintptr_t sizeInBytes) { return sizeInBytes; }
+
 	/**
 	 * Acquire shared VM access. Threads must acquire VM access before accessing any OMR internal
 	 * structures such as the heap. Requests for VM access will be blocked if any other thread is
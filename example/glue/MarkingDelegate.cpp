@@ -25,24 +25,22 @@
 #include "EnvironmentBase.hpp"
 #include "MarkingScheme.hpp"
 #include "omrExampleVM.hpp"
-#include "OMRVMThreadListIterator.hpp"
+#include "ParallelRootScanner.hpp"
 
 #include "MarkingDelegate.hpp"
 
-void
-MM_MarkingDelegate::scanRoots(MM_EnvironmentBase *env)
+/**
+ * Marks the example VM roots, splitting the root table and thread list between the marking threads.
+ */
+class MM_MarkingDelegateRootScanner : public MM_ParallelRootScanner
 {
-	OMR_VM_Example *omrVM = (OMR_VM_Example *)env->getOmrVM()->_language_vm;
-	J9HashTableState state;
-	RootEntry *rEntry = NULL;
-	rEntry = (RootEntry *)hashTableStartDo(omrVM->rootTable, &state);
-	while (rEntry != NULL) {
-		_markingScheme->markObject(env, rEntry->rootPtr);
-		rEntry = (RootEntry *)hashTableNextDo(&state);
-	}
-	OMR_VMThread *walkThread;
-	GC_OMRVMThreadListIterator threadListIterator(env->getOmrVM());
-	while((walkThread = threadListIterator.nextOMRVMThread()) != NULL) {
+private:
+	MM_MarkingScheme *_markingScheme;
+
+protected:
+	virtual void
+	doThread(MM_EnvironmentBase *env, OMR_VMThread *walkThread)
+	{
 		if (NULL != walkThread->_savedObject1) {
 			_markingScheme->markObject(env, (omrobjectptr_t)walkThread->_savedObject1);
 		}
@@ -50,6 +48,29 @@ MM_MarkingDelegate::scanRoots(MM_EnvironmentBase *env)
 			_markingScheme->markObject(env, (omrobjectptr_t)walkThread->_savedObject2);
 		}
 	}
+
+	virtual void
+	doHashTableEntry(MM_EnvironmentBase *env, J9HashTable *hashTable, void *entry)
+	{
+		_markingScheme->markObject(env, ((RootEntry *)entry)->rootPtr);
+	}
+
+public:
+	MM_MarkingDelegateRootScanner(MM_EnvironmentBase *env, MM_MarkingScheme *markingScheme)
+		: MM_ParallelRootScanner(env)
+		, _markingScheme(markingScheme)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+void
+MM_MarkingDelegate::scanRoots(MM_EnvironmentBase *env)
+{
+	OMR_VM_Example *omrVM = (OMR_VM_Example *)env->getOmrVM()->_language_vm;
+	MM_MarkingDelegateRootScanner rootScanner(env, _markingScheme);
+	rootScanner.scanHashTable(env, omrVM->rootTable, RootScannerEntity_GlobalRoots);
+	rootScanner.scanThreads(env);
 }
 
 void
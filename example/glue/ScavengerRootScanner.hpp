@@ -27,15 +27,15 @@
 #include "omrExampleVM.hpp"
 #include "omrhashtable.h"
 
-#include "Base.hpp"
 #include "EnvironmentStandard.hpp"
 #include "ForwardedHeader.hpp"
+#include "ParallelRootScanner.hpp"
 #include "Scavenger.hpp"
 #include "SublistFragment.hpp"
 
 #if defined(OMR_GC_MODRON_SCAVENGER)
 
-class MM_ScavengerRootScanner : public MM_Base
+class MM_ScavengerRootScanner : public MM_ParallelRootScanner
 {
 	/*
 	 * Member data and types
@@ -51,11 +51,33 @@ public:
 	 */
 private:
 protected:
+	virtual void
+	doThread(MM_EnvironmentBase *env, OMR_VMThread *walkThread)
+	{
+		MM_EnvironmentStandard *envStd = MM_EnvironmentStandard::getEnvironment(env);
+		if (NULL != walkThread->_savedObject1) {
+			_scavenger->copyObjectSlot(envStd, (volatile omrobjectptr_t *) &walkThread->_savedObject1);
+		}
+		if (NULL != walkThread->_savedObject2) {
+			_scavenger->copyObjectSlot(envStd, (volatile omrobjectptr_t *) &walkThread->_savedObject2);
+		}
+	}
+
+	virtual void
+	doHashTableEntry(MM_EnvironmentBase *env, J9HashTable *hashTable, void *entry)
+	{
+		RootEntry *rootEntry = (RootEntry *)entry;
+		if (NULL != rootEntry->rootPtr) {
+			_scavenger->copyObjectSlot(MM_EnvironmentStandard::getEnvironment(env), (volatile omrobjectptr_t *) &rootEntry->rootPtr);
+		}
+	}
+
 public:
 	MM_ScavengerRootScanner(MM_EnvironmentBase *env, MM_Scavenger *scavenger)
-		: MM_Base()
+		: MM_ParallelRootScanner(env)
 		, _scavenger(scavenger)
 	{
+		_typeId = __FUNCTION__;
 	};
 
 	void
@@ -75,30 +97,10 @@ public:
 	scanRoots(MM_EnvironmentBase *env)
 	{
 		OMR_VM_Example *omrVM = (OMR_VM_Example *)env->getOmrVM()->_language_vm;
-		if (env->_currentTask->synchronizeGCThreadsAndReleaseSingleThread(env, UNIQUE_ID)) {
-			J9HashTableState state;
-			MM_EnvironmentStandard *envStd = MM_EnvironmentStandard::getEnvironment(env);
-			if (NULL != omrVM->rootTable) {
-				RootEntry *rootEntry = (RootEntry *)hashTableStartDo(omrVM->rootTable, &state);
-				while (NULL != rootEntry) {
-					if (NULL != rootEntry->rootPtr) {
-						_scavenger->copyObjectSlot(envStd, (volatile omrobjectptr_t *) &rootEntry->rootPtr);
-					}
-					rootEntry = (RootEntry *)hashTableNextDo(&state);
-				}
-			}
-			OMR_VMThread *walkThread;
-			GC_OMRVMThreadListIterator threadListIterator(env->getOmrVM());
-			while((walkThread = threadListIterator.nextOMRVMThread()) != NULL) {
-				if (NULL != walkThread->_savedObject1) {
-					_scavenger->copyObjectSlot(envStd, (volatile omrobjectptr_t *) &walkThread->_savedObject1);
-				}
-				if (NULL != walkThread->_savedObject2) {
-					_scavenger->copyObjectSlot(envStd, (volatile omrobjectptr_t *) &walkThread->_savedObject2);
-				}
-			}
-			env->_currentTask->releaseSynchronizedGCThreads(env);
+		if (NULL != omrVM->rootTable) {
+			scanHashTable(env, omrVM->rootTable, RootScannerEntity_GlobalRoots);
 		}
+		scanThreads(env);
 	}
 
 	void rescanThreadSlots(MM_EnvironmentStandard *env) { }
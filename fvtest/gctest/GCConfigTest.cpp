@@ -43,12 +43,18 @@
 const char *gcTests[] = {"fvtest/gctest/configuration/sample_GC_config.xml"
                         , "fvtest/gctest/configuration/test_system_gc.xml"
                         , "fvtest/gctest/configuration/global_GC_config.xml"
+                        , "fvtest/gctest/configuration/allocationsampling_GC_config.xml"
+                        , "fvtest/gctest/configuration/heaptelemetry_GC_config.xml"
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
                         , "fvtest/gctest/configuration/optavgpause_GC_config.xml"
+                        , "fvtest/gctest/configuration/concurrentroots_GC_config.xml"
 #endif
 #if defined(OMR_GC_MODRON_SCAVENGER)
                         , "fvtest/gctest/configuration/scavenger_GC_config.xml"
                         , "fvtest/gctest/configuration/scavenger_GC_backout_config.xml"
+                        , "fvtest/gctest/configuration/pausetime_GC_config.xml"
+                        , "fvtest/gctest/configuration/rootscan_GC_config.xml"
+                        , "fvtest/gctest/configuration/rememberedset_GC_config.xml"
 #endif
 #if defined(OMR_GC_MODRON_SCAVENGER) && defined(OMR_GC_MODRON_CONCURRENT_MARK)
                         , "fvtest/gctest/configuration/gencon_GC_config.xml"
@@ -906,6 +912,72 @@ done:
 	return rt;
 }
 
+int32_t
+GCConfigTest::verifyAllocationSamples(pugi::xml_node node)
+{
+	int32_t rt = 0;
+	OMR_GC_AllocationSample samples[16];
+	uintptr_t minimum = (uintptr_t)node.attribute("minimum").as_int();
+	uintptr_t count = OMR_GC_GetAllocationSamples(exampleVM->_omrVMThread, samples, sizeof(samples) / sizeof(samples[0]), FALSE);
+
+	gcTestEnv->log("Allocation sampler reported %zu site(s):\n", count);
+	for (uintptr_t i = 0; i < count; i++) {
+		gcTestEnv->log("\tsite 0x%zx samples %zu estimated bytes %zu\n", samples[i].site, samples[i].count, samples[i].estimatedBytes);
+		if ((0 == samples[i].count) || ((i > 0) && (samples[i].count > samples[i - 1].count))) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Allocation samples are not ranked by count.\n", __FILE__, __LINE__);
+			rt = 1;
+		}
+	}
+	if (count < minimum) {
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Expected at least %zu sampled allocation site(s), found %zu.\n", __FILE__, __LINE__, minimum, count);
+		rt = 1;
+	}
+	return rt;
+}
+
+int32_t
+GCConfigTest::verifyHeapTelemetry(pugi::xml_node node)
+{
+	int32_t rt = 0;
+	OMR_GC_HeapTelemetrySample samples[16];
+	uintptr_t maxSamples = sizeof(samples) / sizeof(samples[0]);
+	uintptr_t toTake = (uintptr_t)node.attribute("samples").as_int();
+	uintptr_t expected = (uintptr_t)node.attribute("expected").as_int();
+
+	for (uintptr_t i = 0; i < toTake; i++) {
+		if (OMR_ERROR_NONE != OMR_GC_SampleHeapTelemetry(exampleVM->_omrVMThread, NULL)) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Heap telemetry is not available.\n", __FILE__, __LINE__);
+			return 1;
+		}
+	}
+
+	uintptr_t count = OMR_GC_GetHeapTelemetry(exampleVM->_omrVMThread, samples, maxSamples);
+	gcTestEnv->log("Heap telemetry exported %zu sample(s):\n", count);
+	for (uintptr_t i = 0; i < count; i++) {
+		OMR_GC_HeapTelemetrySample *sample = &samples[i];
+		gcTestEnv->log("\theap %zu/%zu tenure %zu/%zu allocated %zu rate %zu discarded %zu fragmentation %zu%%\n",
+				sample->heapFree, sample->heapTotal, sample->tenureFree, sample->tenureTotal,
+				sample->bytesAllocated, sample->allocationRate, sample->tlhDiscardedBytes, sample->tenureFragmentation);
+		if ((sample->heapFree > sample->heapTotal) || (sample->tenureFree > sample->tenureTotal) || (sample->tenureFragmentation > 100)) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Inconsistent heap telemetry sample.\n", __FILE__, __LINE__);
+			rt = 1;
+		}
+		if ((0 == sample->heapTotal) || (0 == sample->bytesAllocated)) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Heap telemetry sample is missing heap or allocation data.\n", __FILE__, __LINE__);
+			rt = 1;
+		}
+		if ((i > 0) && ((sample->timestamp < samples[i - 1].timestamp) || (sample->bytesAllocated < samples[i - 1].bytesAllocated))) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Heap telemetry samples are not exported in order.\n", __FILE__, __LINE__);
+			rt = 1;
+		}
+	}
+	if (count != expected) {
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Expected %zu heap telemetry sample(s), found %zu.\n", __FILE__, __LINE__, expected, count);
+		rt = 1;
+	}
+	return rt;
+}
+
 int32_t
 GCConfigTest::parseGarbagePolicy(pugi::xml_node node)
 {
@@ -1046,6 +1118,18 @@ TEST_P(GCConfigTest, test)
 			pugi::xpath_node_set verboseGCs = configChild.select_nodes(verboseNodeSet);
 			rt = verifyVerboseGC(verboseGCs);
 			ASSERT_EQ(0, rt) << "Failed in verbose GC verification.";
+			/* allocation sampler verification */
+			pugi::xml_node allocationSamples = configChild.child("allocationSamples");
+			if (allocationSamples) {
+				rt = verifyAllocationSamples(allocationSamples);
+				ASSERT_EQ(0, rt) << "Failed in allocation sample verification.";
+			}
+			/* heap telemetry verification */
+			pugi::xml_node heapTelemetry = configChild.child("heapTelemetry");
+			if (heapTelemetry) {
+				rt = verifyHeapTelemetry(heapTelemetry);
+				ASSERT_EQ(0, rt) << "Failed in heap telemetry verification.";
+			}
 			gcTestEnv->log("[ Verification Successful ]\n\n");
 		} else if (0 == strcmp(configChild.name(), "operation")) {
 			gcTestEnv->log("\n++++++++++++++++++++++++++++Operation+++++++++++++++++++++++++++\n");
@@ -108,6 +108,8 @@ protected:
 	void printFile(const char *name);
 #endif
 	int32_t verifyVerboseGC(pugi::xpath_node_set verboseGCs);
+	int32_t verifyAllocationSamples(pugi::xml_node node);
+	int32_t verifyHeapTelemetry(pugi::xml_node node);
 	int32_t parseGarbagePolicy(pugi::xml_node node);
 	int32_t triggerOperation(pugi::xml_node node);
 	int32_t iniXMLStr(const char *configStyle);
@@ -82,6 +82,26 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 					extensions->allowMergedSpaces = atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "maxSizeDefaultMemorySpace")) {
 					extensions->maxSizeDefaultMemorySpace = atoi(attr.value()) * unitSize;
+				} else if (0 == strcmp(attr.name(), "pauseTimeTarget")) {
+					extensions->pauseTimeTarget = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "pauseTimePercentile")) {
+					extensions->pauseTimeTargetPercentile = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "pauseTimeThroughputFloor")) {
+					extensions->pauseTimeThroughputFloor = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "allocationSamplingInterval")) {
+					extensions->allocationSamplingInterval = atoi(attr.value()) * unitSize;
+				} else if (0 == strcmp(attr.name(), "allocationSamplingTopK")) {
+					extensions->allocationSamplingTopK = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "heapTelemetrySamples")) {
+					extensions->heapTelemetrySamples = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "rootScanThreadsPerChunk")) {
+					extensions->rootScanThreadsPerChunk = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "rootScanSlotsPerChunk")) {
+					extensions->rootScanSlotsPerChunk = atoi(attr.value());
+#if defined(OMR_GC_MODRON_SCAVENGER)
+				} else if (0 == strcmp(attr.name(), "rememberedSetScanChunkSize")) {
+					extensions->rememberedSetScanChunkSize = atoi(attr.value());
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 				} else if (0 == strcmp(attr.name(), "gcthreadCount")) {
 					/* TODO: support multi-thread GC*/
 				} else if (0 == strcmp(attr.name(), "GCPolicy")) {
@@ -101,6 +121,12 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 #else
 					gcTestEnv->log(LEVEL_ERROR, "WARNING: concurrentMark=true ignored, requires OMR_GC_MODRON_CONCURRENT_MARK (see configure_common.mk)\n");
 #endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK)*/
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+				} else if (0 == strcmp(attr.name(), "concurrentSlack")) {
+					extensions->concurrentSlack = atoi(attr.value()) * unitSize;
+				} else if (0 == strcmp(attr.name(), "optimizeConcurrentWB")) {
+					extensions->optimizeConcurrentWB = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
 #if defined(OMR_GC_MODRON_SCAVENGER)
 				} else if (0 == strcmp(attr.name(), "forceBackOut")) {
 					extensions->fvtest_forceScavengerBackout = (0 == j9_cmdla_stricmp(attr.value(), "true"));
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup PortTest
+ * @brief Verify asynchronous file I/O.
+ *
+ * Each test runs against both the default backend (io_uring where the kernel
+ * allows it) and the worker thread backend.
+ */
+#include <string.h>
+
+#include "testHelpers.hpp"
+#include "omrport.h"
+
+#define ASYNC_TEST_DEPTH 8
+
+class PortFileAsyncTest : public ::testing::TestWithParam<uint32_t>
+{
+public:
+	static void
+	TearDownTestCase()
+	{
+		testFileCleanUp("tfileAsyncTest");
+	}
+};
+
+/**
+ * Write a file with a linked write and sync, read it back with a vectored read,
+ * and check that a short read breaks its chain.
+ */
+TEST_P(PortFileAsyncTest, file_async_write_read)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrfile_async_write_read";
+	const char *fileName = "tfileAsyncTest_write_read.tst";
+	char part1[] = "hello, ";
+	char part2[] = "asynchronous world";
+	char readBuffer1[sizeof(part1) - 1];
+	char readBuffer2[sizeof(part2) - 1];
+	char tail[64];
+	intptr_t expectedLength = (sizeof(part1) - 1) + (sizeof(part2) - 1);
+	OMRIOVec writeVector[2] = {{part1, sizeof(part1) - 1}, {part2, sizeof(part2) - 1}};
+	OMRIOVec readVector[2] = {{readBuffer1, sizeof(readBuffer1)}, {readBuffer2, sizeof(readBuffer2)}};
+	OMRIOVec tailVector[1] = {{tail, sizeof(tail)}};
+	OMRFileAsyncRequest requests[2];
+	OMRFileAsyncCompletion completions[ASYNC_TEST_DEPTH];
+	struct OMRFileAsyncQueue *queue = NULL;
+	intptr_t fd = -1;
+	intptr_t rc = 0;
+	intptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrfile_async_create(ASYNC_TEST_DEPTH, GetParam(), &queue);
+	if (OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM == rc) {
+		portTestEnv->log("omrfile_async is not supported on this platform\n");
+		goto exit;
+	} else if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_create() returned %zd\n", rc);
+		goto exit;
+	}
+	portTestEnv->log("omrfile_async backend: %s\n", (OMRPORT_FILE_ASYNC_BACKEND_IO_URING == omrfile_async_backend(queue)) ? "io_uring" : "threads");
+	if (OMR_ARE_ANY_BITS_SET(GetParam(), OMRPORT_FILE_ASYNC_USE_THREADS) && (OMRPORT_FILE_ASYNC_BACKEND_THREADS != omrfile_async_backend(queue))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "OMRPORT_FILE_ASYNC_USE_THREADS was ignored\n");
+	}
+
+	omrfile_unlink(fileName);
+	fd = omrfile_open(fileName, EsOpenCreate | EsOpenRead | EsOpenWrite | EsOpenTruncate, 0666);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto destroy;
+	}
+
+	memset(requests, 0, sizeof(requests));
+	requests[0].operation = OMRPORT_FILE_ASYNC_WRITEV;
+	requests[0].flags = OMRPORT_FILE_ASYNC_LINK;
+	requests[0].fd = fd;
+	requests[0].offset = 0;
+	requests[0].iov = writeVector;
+	requests[0].iovCount = 2;
+	requests[0].userData = &requests[0];
+	requests[1].operation = OMRPORT_FILE_ASYNC_FSYNC;
+	requests[1].fd = fd;
+	requests[1].userData = &requests[1];
+	rc = omrfile_async_submit(queue, requests, 2);
+	if (2 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of write and sync returned %zd\n", rc);
+		goto close;
+	}
+	rc = omrfile_async_complete(queue, completions, ASYNC_TEST_DEPTH, 2);
+	if (2 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_complete() returned %zd, expected 2\n", rc);
+		goto close;
+	}
+	for (i = 0; i < rc; i++) {
+		if (&requests[0] == completions[i].userData) {
+			if (expectedLength != completions[i].result) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "write result %zd, expected %zd\n", completions[i].result, expectedLength);
+			}
+		} else if (&requests[1] == completions[i].userData) {
+			if (0 != completions[i].result) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "sync result %zd, expected 0\n", completions[i].result);
+			}
+		} else {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "unexpected completion userData %p\n", completions[i].userData);
+		}
+	}
+
+	/* Read it back into two buffers */
+	memset(requests, 0, sizeof(requests));
+	requests[0].operation = OMRPORT_FILE_ASYNC_READV;
+	requests[0].fd = fd;
+	requests[0].offset = 0;
+	requests[0].iov = readVector;
+	requests[0].iovCount = 2;
+	rc = omrfile_async_submit(queue, requests, 1);
+	if (1 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of read returned %zd\n", rc);
+		goto close;
+	}
+	rc = omrfile_async_complete(queue, completions, ASYNC_TEST_DEPTH, 1);
+	if ((1 != rc) || (expectedLength != completions[0].result)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "read returned %zd completions, result %zd, expected %zd\n", rc, completions[0].result, expectedLength);
+		goto close;
+	}
+	if ((0 != memcmp(readBuffer1, part1, sizeof(readBuffer1))) || (0 != memcmp(readBuffer2, part2, sizeof(readBuffer2)))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "read back different data from what was written\n");
+	}
+
+	/* A read running into end of file is short, which cancels the write linked after it */
+	memset(requests, 0, sizeof(requests));
+	requests[0].operation = OMRPORT_FILE_ASYNC_READV;
+	requests[0].flags = OMRPORT_FILE_ASYNC_LINK;
+	requests[0].fd = fd;
+	requests[0].offset = 0;
+	requests[0].iov = tailVector;
+	requests[0].iovCount = 1;
+	requests[0].userData = &requests[0];
+	requests[1].operation = OMRPORT_FILE_ASYNC_WRITEV;
+	requests[1].fd = fd;
+	requests[1].offset = 1000;
+	requests[1].iov = writeVector;
+	requests[1].iovCount = 2;
+	requests[1].userData = &requests[1];
+	rc = omrfile_async_submit(queue, requests, 2);
+	if (2 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of linked read and write returned %zd\n", rc);
+		goto close;
+	}
+	rc = omrfile_async_complete(queue, completions, ASYNC_TEST_DEPTH, 2);
+	if (2 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_complete() returned %zd, expected 2\n", rc);
+		goto close;
+	}
+	for (i = 0; i < rc; i++) {
+		if (&requests[0] == completions[i].userData) {
+			if (expectedLength != completions[i].result) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "short read result %zd, expected %zd\n", completions[i].result, expectedLength);
+			}
+		} else if (OMRPORT_ERROR_FILE_ASYNC_CANCELED != completions[i].result) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "linked write result %zd, expected OMRPORT_ERROR_FILE_ASYNC_CANCELED\n", completions[i].result);
+		}
+	}
+	if (expectedLength != omrfile_flength(fd)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "file length %lld after cancelled write, expected %zd\n", omrfile_flength(fd), expectedLength);
+	}
+
+close:
+	omrfile_close(fd);
+	omrfile_unlink(fileName);
+destroy:
+	omrfile_async_destroy(queue);
+exit:
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Check that a queue accepts no more than its depth, and rejects bad requests.
+ */
+TEST_P(PortFileAsyncTest, file_async_depth)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrfile_async_depth";
+	const char *fileName = "tfileAsyncTest_depth.tst";
+	OMRFileAsyncRequest requests[ASYNC_TEST_DEPTH + 2];
+	OMRFileAsyncCompletion completions[ASYNC_TEST_DEPTH + 2];
+	struct OMRFileAsyncQueue *queue = NULL;
+	intptr_t fd = -1;
+	intptr_t rc = 0;
+	intptr_t completed = 0;
+	intptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrfile_async_create(ASYNC_TEST_DEPTH, GetParam(), &queue);
+	if (OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM == rc) {
+		goto exit;
+	} else if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_create() returned %zd\n", rc);
+		goto exit;
+	}
+
+	fd = omrfile_open(fileName, EsOpenCreate | EsOpenWrite | EsOpenTruncate, 0666);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto destroy;
+	}
+
+	memset(requests, 0, sizeof(requests));
+	for (i = 0; i < (ASYNC_TEST_DEPTH + 2); i++) {
+		requests[i].operation = OMRPORT_FILE_ASYNC_FSYNC;
+		requests[i].fd = fd;
+	}
+	rc = omrfile_async_submit(queue, requests, ASYNC_TEST_DEPTH + 2);
+	if (ASYNC_TEST_DEPTH != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() accepted %zd requests, expected %d\n", rc, ASYNC_TEST_DEPTH);
+	}
+	if (0 != omrfile_async_submit(queue, requests, 1)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() accepted a request on a full queue\n");
+	}
+	while (completed < ASYNC_TEST_DEPTH) {
+		rc = omrfile_async_complete(queue, completions, ASYNC_TEST_DEPTH + 2, 1);
+		if (rc <= 0) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_complete() returned %zd\n", rc);
+			break;
+		}
+		for (i = 0; i < rc; i++) {
+			if (0 != completions[i].result) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "sync result %zd, expected 0\n", completions[i].result);
+			}
+		}
+		completed += rc;
+	}
+	/* nothing is outstanding, so this must not block */
+	rc = omrfile_async_complete(queue, completions, ASYNC_TEST_DEPTH + 2, 1);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_complete() on an idle queue returned %zd\n", rc);
+	}
+
+	requests[0].operation = 0;
+	rc = omrfile_async_submit(queue, requests, 1);
+	if (OMRPORT_ERROR_FILE_INVAL != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of a bad operation returned %zd\n", rc);
+	}
+	for (i = 0; i < (ASYNC_TEST_DEPTH + 2); i++) {
+		requests[i].operation = OMRPORT_FILE_ASYNC_FSYNC;
+		requests[i].flags = OMRPORT_FILE_ASYNC_LINK;
+	}
+	rc = omrfile_async_submit(queue, requests, ASYNC_TEST_DEPTH + 2);
+	if (OMRPORT_ERROR_FILE_INVAL != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of a chain longer than the queue returned %zd\n", rc);
+	}
+
+	/* Leave work outstanding for destroy to wait for */
+	rc = omrfile_async_submit(queue, requests, ASYNC_TEST_DEPTH);
+	if (ASYNC_TEST_DEPTH != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of a full chain returned %zd\n", rc);
+	}
+	omrfile_async_destroy(queue);
+	omrfile_close(fd);
+	omrfile_unlink(fileName);
+	goto exit;
+
+destroy:
+	omrfile_async_destroy(queue);
+exit:
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, PortFileAsyncTest, ::testing::Values(0, OMRPORT_FILE_ASYNC_USE_THREADS));
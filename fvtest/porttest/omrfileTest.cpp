@@ -4784,6 +4784,215 @@ exit:
 	reportTestExit(OMRPORTLIB, testName);
 }
 
+/**
+ * Verify port file system.
+ * @ref omrfile.c::omrfile_writev "omrfile_writev()"
+ */
+TEST_F(PortFileTest2, file_test41)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrfile_test41";
+	const char *fileName = "tfileTest41.tst";
+	char part1[] = "ABC";
+	char part2[] = "";
+	char part3[] = "DEFGH";
+	char expected[] = "ABCDEFGH";
+	char readBuffer[sizeof(expected)];
+	OMRIOVec iov[3];
+	intptr_t fd = -1;
+	intptr_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	iov[0].base = part1;
+	iov[0].length = sizeof(part1) - 1;
+	iov[1].base = part2;
+	iov[1].length = 0;
+	iov[2].base = part3;
+	iov[2].length = sizeof(part3) - 1;
+
+	fd = omrfile_open(fileName, EsOpenCreate | EsOpenTruncate | EsOpenWrite | EsOpenRead, 0666);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto exit;
+	}
+
+	rc = omrfile_writev(fd, iov, 3);
+	if ((intptr_t)(sizeof(expected) - 1) != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_writev() returned %zd expected %zu\n", rc, sizeof(expected) - 1);
+		goto exit;
+	}
+
+	rc = omrfile_writev(fd, iov, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_writev() of no buffers returned %zd expected 0\n", rc);
+	}
+
+	if (0 != omrfile_seek(fd, 0, EsSeekSet)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_seek() failed\n");
+		goto exit;
+	}
+	memset(readBuffer, 0, sizeof(readBuffer));
+	rc = omrfile_read(fd, readBuffer, sizeof(readBuffer));
+	if (((intptr_t)(sizeof(expected) - 1) != rc) || (0 != memcmp(readBuffer, expected, sizeof(expected) - 1))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_read() returned %zd \"%.*s\" expected \"%s\"\n", rc, (int)OMR_MAX(rc, 0), readBuffer, expected);
+	}
+
+exit:
+	if (-1 != fd) {
+		omrfile_close(fd);
+	}
+	omrfile_unlink(fileName);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Verify port file system.
+ * @ref omrfile.c::omrfile_copy_range "omrfile_copy_range()"
+ */
+TEST_F(PortFileTest2, file_test42)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrfile_test42";
+	const char *inName = "tfileTest42in.tst";
+	const char *outName = "tfileTest42out.tst";
+	char contents[] = "0123456789";
+	char readBuffer[32];
+	intptr_t inFD = -1;
+	intptr_t outFD = -1;
+	int64_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	inFD = omrfile_open(inName, EsOpenCreate | EsOpenTruncate | EsOpenWrite | EsOpenRead, 0666);
+	outFD = omrfile_open(outName, EsOpenCreate | EsOpenTruncate | EsOpenWrite | EsOpenRead, 0666);
+	if ((-1 == inFD) || (-1 == outFD)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto exit;
+	}
+	if ((intptr_t)(sizeof(contents) - 1) != omrfile_write(inFD, contents, sizeof(contents) - 1)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_write() failed\n");
+		goto exit;
+	}
+	if (2 != omrfile_write(outFD, "xx", 2)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_write() failed\n");
+		goto exit;
+	}
+
+	rc = omrfile_copy_range(inFD, 3, outFD, 2, 4);
+	if (OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM == rc) {
+		portTestEnv->log("omrfile_copy_range() is not supported on this platform\n");
+		goto exit;
+	}
+	if (4 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_copy_range() returned %lld expected 4\n", rc);
+		goto exit;
+	}
+
+	/* a copy running past the end of the input is short */
+	rc = omrfile_copy_range(inFD, 8, outFD, 6, 10);
+	if (2 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_copy_range() at the end of the file returned %lld expected 2\n", rc);
+	}
+
+	/* neither file position moves */
+	if (sizeof(contents) - 1 != omrfile_seek(inFD, 0, EsSeekCur)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_copy_range() moved the input file position\n");
+	}
+	if (2 != omrfile_seek(outFD, 0, EsSeekCur)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_copy_range() moved the output file position\n");
+	}
+
+	omrfile_seek(outFD, 0, EsSeekSet);
+	memset(readBuffer, 0, sizeof(readBuffer));
+	rc = omrfile_read(outFD, readBuffer, sizeof(readBuffer));
+	if ((8 != rc) || (0 != memcmp(readBuffer, "xx345689", 8))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "output file contains \"%s\" expected \"xx345689\"\n", readBuffer);
+	}
+
+exit:
+	if (-1 != inFD) {
+		omrfile_close(inFD);
+	}
+	if (-1 != outFD) {
+		omrfile_close(outFD);
+	}
+	omrfile_unlink(inName);
+	omrfile_unlink(outName);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Verify port file system.
+ * @ref omrfile.c::omrfile_sendfile "omrfile_sendfile()"
+ */
+TEST_F(PortFileTest2, file_test43)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrfile_test43";
+	const char *inName = "tfileTest43in.tst";
+	const char *outName = "tfileTest43out.tst";
+	char contents[] = "0123456789";
+	char readBuffer[32];
+	intptr_t inFD = -1;
+	intptr_t outFD = -1;
+	int64_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	inFD = omrfile_open(inName, EsOpenCreate | EsOpenTruncate | EsOpenWrite | EsOpenRead, 0666);
+	outFD = omrfile_open(outName, EsOpenCreate | EsOpenTruncate | EsOpenWrite | EsOpenRead, 0666);
+	if ((-1 == inFD) || (-1 == outFD)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto exit;
+	}
+	if ((intptr_t)(sizeof(contents) - 1) != omrfile_write(inFD, contents, sizeof(contents) - 1)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_write() failed\n");
+		goto exit;
+	}
+
+	rc = omrfile_sendfile(outFD, inFD, 5, 3);
+	if (OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM == rc) {
+		portTestEnv->log("omrfile_sendfile() is not supported on this platform\n");
+		goto exit;
+	}
+	if (3 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_sendfile() returned %lld expected 3\n", rc);
+		goto exit;
+	}
+	rc = omrfile_sendfile(outFD, inFD, 0, 2);
+	if (2 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_sendfile() returned %lld expected 2\n", rc);
+		goto exit;
+	}
+
+	/* the output position advances, the input position does not */
+	if (5 != omrfile_seek(outFD, 0, EsSeekCur)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_sendfile() did not advance the output file position\n");
+	}
+	if (sizeof(contents) - 1 != omrfile_seek(inFD, 0, EsSeekCur)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_sendfile() moved the input file position\n");
+	}
+
+	omrfile_seek(outFD, 0, EsSeekSet);
+	memset(readBuffer, 0, sizeof(readBuffer));
+	rc = omrfile_read(outFD, readBuffer, sizeof(readBuffer));
+	if ((5 != rc) || (0 != memcmp(readBuffer, "56701", 5))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "output file contains \"%s\" expected \"56701\"\n", readBuffer);
+	}
+
+exit:
+	if (-1 != inFD) {
+		omrfile_close(inFD);
+	}
+	if (-1 != outFD) {
+		omrfile_close(outFD);
+	}
+	omrfile_unlink(inName);
+	omrfile_unlink(outName);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
 /**
  * Verify omrfile_lastmod() returns -1 on an invalid file.
  * @ref omrfile.c::omrfile_lastmod "omrfile_lastmod()"
@@ -0,0 +1,351 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+/**
+ * @file
+ * @ingroup PortTest
+ * @brief Verify the thread-caching small block allocator behind omrmem_allocate_memory.
+ *
+ * The allocator is enabled with OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR. Each test
+ * disables it again before returning; blocks it handed out stay valid.
+ */
+#include <string.h>
+
+#include "testHelpers.hpp"
+#include "omrport.h"
+
+#define SMALL_BLOCK_TEST_SIZES 64
+#define SMALL_BLOCK_BENCHMARK_THREADS 4
+#define SMALL_BLOCK_BENCHMARK_ITERATIONS 200000
+#define SMALL_BLOCK_BENCHMARK_LIVE_BLOCKS 64
+#define SMALL_BLOCK_TIMEOUT_MILLIS 60000
+
+/* Test blocks get a category of their own, so the allocator's own thread caches are not counted with them */
+#define SMALL_BLOCK_TEST_CATEGORY 0
+
+static uint32_t childrenOfSmallBlockTestCategory[] = {OMRMEM_CATEGORY_PORT_LIBRARY, OMRMEM_CATEGORY_UNKNOWN};
+static OMRMemCategory smallBlockTestCategory = {"Small block test", SMALL_BLOCK_TEST_CATEGORY, 0, 0, 2, childrenOfSmallBlockTestCategory};
+static OMRMemCategory *smallBlockCategoryList[1] = {&smallBlockTestCategory};
+static OMRMemCategorySet smallBlockCategorySet = {1, smallBlockCategoryList};
+
+static uintptr_t
+smallBlockCategoryWalkFunction(uint32_t categoryCode, const char *categoryName, uintptr_t liveBytes, uintptr_t liveAllocations, BOOLEAN isRoot, uint32_t parentCategoryCode, OMRMemCategoryWalkState *walkState)
+{
+	if (SMALL_BLOCK_TEST_CATEGORY == categoryCode) {
+		*(uintptr_t *)walkState->userData1 = liveAllocations;
+		*(uintptr_t *)walkState->userData2 = liveBytes;
+		return J9MEM_CATEGORIES_STOP_ITERATING;
+	}
+	return J9MEM_CATEGORIES_KEEP_ITERATING;
+}
+
+/**
+ * Read the counters of SMALL_BLOCK_TEST_CATEGORY
+ */
+static void
+getTestCategoryData(struct OMRPortLibrary *portLibrary, uintptr_t *blocks, uintptr_t *bytes)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	OMRMemCategoryWalkState walkState;
+
+	memset(&walkState, 0, sizeof(OMRMemCategoryWalkState));
+	walkState.walkFunction = &smallBlockCategoryWalkFunction;
+	walkState.userData1 = blocks;
+	walkState.userData2 = bytes;
+	omrmem_walk_categories(&walkState);
+}
+
+/**
+ * Allocate one block of each test size under SMALL_BLOCK_TEST_CATEGORY, fill
+ * it, and report what the category counters grew by.
+ */
+static BOOLEAN
+allocateTestBlocks(struct OMRPortLibrary *portLibrary, const char *testName, void **blocks, uintptr_t *blockDelta, uintptr_t *byteDelta)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	uintptr_t initialBlocks = 0;
+	uintptr_t initialBytes = 0;
+	uintptr_t finalBlocks = 0;
+	uintptr_t finalBytes = 0;
+	uintptr_t i = 0;
+
+	getTestCategoryData(OMRPORTLIB, &initialBlocks, &initialBytes);
+	for (i = 0; i < SMALL_BLOCK_TEST_SIZES; i++) {
+		uintptr_t size = i * 17;
+		blocks[i] = omrmem_allocate_memory(size, SMALL_BLOCK_TEST_CATEGORY);
+		if (NULL == blocks[i]) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM for %zu bytes\n", size);
+			return FALSE;
+		}
+		memset(blocks[i], (int)i, size);
+	}
+	getTestCategoryData(OMRPORTLIB, &finalBlocks, &finalBytes);
+	*blockDelta = finalBlocks - initialBlocks;
+	*byteDelta = finalBytes - initialBytes;
+	return TRUE;
+}
+
+/**
+ * Verify that blocks from the small block allocator are tagged and counted
+ * exactly as malloc'd blocks are, and that realloc preserves their contents
+ * whether they move between size classes or out to malloc.
+ */
+TEST(PortMemSmallBlockTest, mem_small_block_categories_and_realloc)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmem_small_block_categories_and_realloc";
+	void *blocks[SMALL_BLOCK_TEST_SIZES];
+	uintptr_t mallocBlocks = 0;
+	uintptr_t mallocBytes = 0;
+	uintptr_t smallBlocks = 0;
+	uintptr_t smallBytes = 0;
+	uintptr_t i = 0;
+	uintptr_t j = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (0 != omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 1)) {
+		portTestEnv->log("Small block allocator not available on this platform, skipping\n");
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	}
+	omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 0);
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, (uintptr_t)&smallBlockCategorySet);
+
+	/* Baseline with malloc */
+	if (!allocateTestBlocks(OMRPORTLIB, testName, blocks, &mallocBlocks, &mallocBytes)) {
+		goto exit;
+	}
+	for (i = 0; i < SMALL_BLOCK_TEST_SIZES; i++) {
+		omrmem_free_memory(blocks[i]);
+	}
+
+	omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 1);
+	if (!allocateTestBlocks(OMRPORTLIB, testName, blocks, &smallBlocks, &smallBytes)) {
+		goto disable;
+	}
+	if ((smallBlocks != mallocBlocks) || (smallBytes != mallocBytes)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Category counters differ: malloc %zu blocks/%zu bytes, small block %zu blocks/%zu bytes\n",
+			mallocBlocks, mallocBytes, smallBlocks, smallBytes);
+	}
+
+	/* Grow each block, within its class, to another class and beyond the largest class */
+	for (i = 0; i < SMALL_BLOCK_TEST_SIZES; i++) {
+		uintptr_t oldSize = i * 17;
+		uintptr_t newSize = (0 == (i % 3)) ? (oldSize + 1) : ((1 == (i % 3)) ? (oldSize * 2 + 40) : (oldSize + 4096));
+		uint8_t *grown = (uint8_t *)omrmem_reallocate_memory(blocks[i], newSize, SMALL_BLOCK_TEST_CATEGORY);
+
+		if (NULL == grown) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM reallocating %zu bytes\n", newSize);
+			continue;
+		}
+		blocks[i] = grown;
+		for (j = 0; j < oldSize; j++) {
+			if (grown[j] != (uint8_t)i) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "Byte %zu of block %zu lost by realloc from %zu to %zu bytes\n", j, i, oldSize, newSize);
+				break;
+			}
+		}
+	}
+
+	/* Blocks allocated while enabled must be freeable once disabled */
+	omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 0);
+	{
+		uintptr_t initialBlocks = 0;
+		uintptr_t initialBytes = 0;
+		uintptr_t finalBlocks = 0;
+		uintptr_t finalBytes = 0;
+
+		getTestCategoryData(OMRPORTLIB, &initialBlocks, &initialBytes);
+		for (i = 0; i < SMALL_BLOCK_TEST_SIZES; i++) {
+			omrmem_free_memory(blocks[i]);
+		}
+		getTestCategoryData(OMRPORTLIB, &finalBlocks, &finalBytes);
+		if ((initialBlocks - finalBlocks) != SMALL_BLOCK_TEST_SIZES) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Freeing %d blocks released %zu from the category\n", SMALL_BLOCK_TEST_SIZES, initialBlocks - finalBlocks);
+		}
+	}
+	goto exit;
+
+disable:
+	omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 0);
+exit:
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, 0);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+typedef struct SmallBlockThreadData {
+	struct OMRPortLibrary *portLibrary;
+	omrthread_monitor_t monitor;
+	uintptr_t finishedCount;
+	uintptr_t seed;
+	void *handoff[SMALL_BLOCK_BENCHMARK_THREADS][SMALL_BLOCK_BENCHMARK_LIVE_BLOCKS];
+} SmallBlockThreadData;
+
+/**
+ * Allocate and free a rolling window of small blocks. Every thread starts by
+ * freeing the blocks the main thread handed it, so each cache sees remote frees.
+ */
+static int J9THREAD_PROC
+smallBlockWorker(void *arg)
+{
+	SmallBlockThreadData *data = (SmallBlockThreadData *)arg;
+	OMRPORT_ACCESS_FROM_OMRPORT(data->portLibrary);
+	void *live[SMALL_BLOCK_BENCHMARK_LIVE_BLOCKS];
+	uintptr_t seed = 0;
+	uintptr_t i = 0;
+
+	omrthread_monitor_enter(data->monitor);
+	seed = data->seed++;
+	omrthread_monitor_exit(data->monitor);
+
+	for (i = 0; i < SMALL_BLOCK_BENCHMARK_LIVE_BLOCKS; i++) {
+		omrmem_free_memory(data->handoff[seed - 1][i]);
+	}
+	memset(live, 0, sizeof(live));
+	for (i = 0; i < SMALL_BLOCK_BENCHMARK_ITERATIONS; i++) {
+		uintptr_t slot = i % SMALL_BLOCK_BENCHMARK_LIVE_BLOCKS;
+		uintptr_t size = 0;
+
+		seed = (seed * 1103515245) + 12345;
+		size = 8 + ((seed >> 16) % 504);
+		omrmem_free_memory(live[slot]);
+		live[slot] = omrmem_allocate_memory(size, SMALL_BLOCK_TEST_CATEGORY);
+		if (NULL != live[slot]) {
+			*(uint8_t *)live[slot] = (uint8_t)size;
+		}
+	}
+	for (i = 0; i < SMALL_BLOCK_BENCHMARK_LIVE_BLOCKS; i++) {
+		omrmem_free_memory(live[i]);
+	}
+
+	omrthread_monitor_enter(data->monitor);
+	data->finishedCount += 1;
+	omrthread_monitor_notify_all(data->monitor);
+	omrthread_monitor_exit(data->monitor);
+	return 0;
+}
+
+/**
+ * Run SMALL_BLOCK_BENCHMARK_THREADS workers to completion.
+ *
+ * @return the elapsed time in nanoseconds, or 0 on failure
+ */
+static uint64_t
+runSmallBlockWorkers(struct OMRPortLibrary *portLibrary, const char *testName)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	SmallBlockThreadData data;
+	uint64_t start = 0;
+	uint64_t elapsed = 0;
+	intptr_t waitRetVal = 0;
+	uintptr_t created = 0;
+	uintptr_t i = 0;
+
+	memset(&data, 0, sizeof(data));
+	data.portLibrary = OMRPORTLIB;
+	data.seed = 1;
+	if (0 != omrthread_monitor_init(&data.monitor, 0)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to initialize monitor\n");
+		return 0;
+	}
+
+	for (i = 0; i < SMALL_BLOCK_BENCHMARK_THREADS; i++) {
+		uintptr_t j = 0;
+		for (j = 0; j < SMALL_BLOCK_BENCHMARK_LIVE_BLOCKS; j++) {
+			data.handoff[i][j] = omrmem_allocate_memory(16 + j, SMALL_BLOCK_TEST_CATEGORY);
+		}
+	}
+
+	start = omrtime_nano_time();
+	for (i = 0; i < SMALL_BLOCK_BENCHMARK_THREADS; i++) {
+		omrthread_t thread = NULL;
+		if (0 != omrthread_create(&thread, 256 * 1024, J9THREAD_PRIORITY_NORMAL, 0, &smallBlockWorker, &data)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to create thread %zu\n", i);
+			break;
+		}
+		created += 1;
+	}
+
+	omrthread_monitor_enter(data.monitor);
+	while ((0 == waitRetVal) && (data.finishedCount < created)) {
+		waitRetVal = omrthread_monitor_wait_timed(data.monitor, SMALL_BLOCK_TIMEOUT_MILLIS, 0);
+	}
+	omrthread_monitor_exit(data.monitor);
+	elapsed = omrtime_nano_time() - start;
+	omrthread_monitor_destroy(data.monitor);
+
+	if (0 != waitRetVal) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Timed out waiting for workers, waitRetVal=%zd\n", waitRetVal);
+		return 0;
+	}
+	return (created == SMALL_BLOCK_BENCHMARK_THREADS) ? elapsed : 0;
+}
+
+/**
+ * Verify that the category counters balance after many threads allocate and
+ * free concurrently, including frees of blocks another thread allocated, and
+ * compare throughput with the allocator disabled (malloc) and enabled.
+ */
+TEST(PortMemSmallBlockTest, mem_small_block_threads_benchmark)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmem_small_block_threads_benchmark";
+	uintptr_t initialBlocks = 0;
+	uintptr_t initialBytes = 0;
+	uintptr_t finalBlocks = 0;
+	uintptr_t finalBytes = 0;
+	uint64_t mallocNanos = 0;
+	uint64_t smallBlockNanos = 0;
+	const uint64_t operations = (uint64_t)SMALL_BLOCK_BENCHMARK_THREADS * SMALL_BLOCK_BENCHMARK_ITERATIONS;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (0 != omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 1)) {
+		portTestEnv->log("Small block allocator not available on this platform, skipping\n");
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	}
+	omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 0);
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, (uintptr_t)&smallBlockCategorySet);
+
+	mallocNanos = runSmallBlockWorkers(OMRPORTLIB, testName);
+
+	omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 1);
+	getTestCategoryData(OMRPORTLIB, &initialBlocks, &initialBytes);
+	smallBlockNanos = runSmallBlockWorkers(OMRPORTLIB, testName);
+	getTestCategoryData(OMRPORTLIB, &finalBlocks, &finalBytes);
+	omrport_control(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, 0);
+
+	if ((finalBlocks != initialBlocks) || (finalBytes != initialBytes)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Category counters did not balance: %zu blocks/%zu bytes before, %zu blocks/%zu bytes after\n",
+			initialBlocks, initialBytes, finalBlocks, finalBytes);
+	}
+	if ((0 != mallocNanos) && (0 != smallBlockNanos)) {
+		portTestEnv->log("%d threads x %d allocate/free pairs: malloc %llu ns/op, small block cache %llu ns/op\n",
+			SMALL_BLOCK_BENCHMARK_THREADS, SMALL_BLOCK_BENCHMARK_ITERATIONS,
+			(unsigned long long)(mallocNanos / operations), (unsigned long long)(smallBlockNanos / operations));
+	}
+
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, 0);
+	reportTestExit(OMRPORTLIB, testName);
+}
@@ -1464,6 +1464,297 @@ TEST(PortMemTest, mem_test9_category_walk)
 	reportTestExit(OMRPORTLIB, testName);
 }
 
+#define MEM_TEST10_THREADS 8
+#define MEM_TEST10_ALLOCATIONS_PER_THREAD 256
+#define MEM_TEST10_TIMEOUT_MILLIS 60000
+#define MEM_TEST10_BLOCK_SIZE 32
+
+typedef struct MemTest10Data {
+	struct OMRPortLibrary *portLibrary;
+	omrthread_monitor_t monitor;
+	uintptr_t nextThreadIndex;
+	uintptr_t finishedCount;
+	void *blocks[MEM_TEST10_THREADS][MEM_TEST10_ALLOCATIONS_PER_THREAD];
+} MemTest10Data;
+
+/**
+ * Allocates MEM_TEST10_ALLOCATIONS_PER_THREAD blocks under DUMMY_CATEGORY_TWO.
+ * The blocks are freed by the main thread.
+ */
+static int J9THREAD_PROC
+categoryStripeAllocator(void *arg)
+{
+	MemTest10Data *data = (MemTest10Data *)arg;
+	OMRPORT_ACCESS_FROM_OMRPORT(data->portLibrary);
+	uintptr_t threadIndex = 0;
+	uintptr_t i = 0;
+
+	omrthread_monitor_enter(data->monitor);
+	threadIndex = data->nextThreadIndex;
+	data->nextThreadIndex += 1;
+	omrthread_monitor_exit(data->monitor);
+
+	for (i = 0; i < MEM_TEST10_ALLOCATIONS_PER_THREAD; i++) {
+		data->blocks[threadIndex][i] = omrmem_allocate_memory(MEM_TEST10_BLOCK_SIZE, DUMMY_CATEGORY_TWO);
+	}
+
+	omrthread_monitor_enter(data->monitor);
+	data->finishedCount += 1;
+	omrthread_monitor_notify_all(data->monitor);
+	omrthread_monitor_exit(data->monitor);
+
+	return 0;
+}
+
+/**
+ * Verifies that the category counters stay exact when many threads allocate
+ * under the same category concurrently and the blocks are freed on another
+ * thread, i.e. that the striped counters sum correctly in omrmem_walk_categories.
+ */
+TEST(PortMemTest, mem_test10_category_concurrent_counters)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmem_test10_category_concurrent_counters";
+	struct CategoriesState categoriesState;
+	MemTest10Data *data = NULL;
+	uintptr_t initialBlocks = 0;
+	uintptr_t initialBytes = 0;
+	uintptr_t expectedBlocks = 0;
+	uintptr_t expectedBytes = 0;
+	uintptr_t bytesPerBlock = 0;
+	uintptr_t i = 0;
+	uintptr_t j = 0;
+	intptr_t waitRetVal = 0;
+	void *ptr = NULL;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, (uintptr_t) &dummyCategorySet);
+
+	data = (MemTest10Data *)omrmem_allocate_memory(sizeof(MemTest10Data), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == data) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+		goto end;
+	}
+	memset(data, 0, sizeof(MemTest10Data));
+	data->portLibrary = OMRPORTLIB;
+
+	if (0 != omrthread_monitor_init(&data->monitor, 0)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to initialize monitor\n");
+		goto freeData;
+	}
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	initialBlocks = categoriesState.dummyCategoryTwoBlocks;
+	initialBytes = categoriesState.dummyCategoryTwoBytes;
+
+	/* The byte counters include the memory tags, so measure what one block adds */
+	ptr = omrmem_allocate_memory(MEM_TEST10_BLOCK_SIZE, DUMMY_CATEGORY_TWO);
+	if (NULL == ptr) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+		goto destroyMonitor;
+	}
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	bytesPerBlock = categoriesState.dummyCategoryTwoBytes - initialBytes;
+	omrmem_free_memory(ptr);
+
+	for (i = 0; i < MEM_TEST10_THREADS; i++) {
+		omrthread_t thread = NULL;
+		intptr_t rc = omrthread_create(&thread, 128 * 1024, J9THREAD_PRIORITY_NORMAL, 0, &categoryStripeAllocator, data);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to create thread, rc=%zd, i=%zu\n", rc, i);
+			goto destroyMonitor;
+		}
+	}
+
+	omrthread_monitor_enter(data->monitor);
+	while ((0 == waitRetVal) && (data->finishedCount < MEM_TEST10_THREADS)) {
+		waitRetVal = omrthread_monitor_wait_timed(data->monitor, MEM_TEST10_TIMEOUT_MILLIS, 0);
+	}
+	omrthread_monitor_exit(data->monitor);
+	if (0 != waitRetVal) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Timed out waiting for allocating threads, waitRetVal=%zd\n", waitRetVal);
+		goto destroyMonitor;
+	}
+
+	expectedBlocks = initialBlocks;
+	expectedBytes = initialBytes;
+	for (i = 0; i < MEM_TEST10_THREADS; i++) {
+		for (j = 0; j < MEM_TEST10_ALLOCATIONS_PER_THREAD; j++) {
+			if (NULL == data->blocks[i][j]) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+			} else {
+				expectedBlocks += 1;
+				expectedBytes += bytesPerBlock;
+			}
+		}
+	}
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	if (categoriesState.dummyCategoryTwoBlocks != expectedBlocks) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after allocation. Expected %zu, got %zu.\n", expectedBlocks, categoriesState.dummyCategoryTwoBlocks);
+	}
+	if (categoriesState.dummyCategoryTwoBytes != expectedBytes) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of bytes after allocation. Expected %zu, got %zu.\n", expectedBytes, categoriesState.dummyCategoryTwoBytes);
+	}
+
+	/* Free everything from this thread, so the decrements land on a different stripe from the increments */
+	for (i = 0; i < MEM_TEST10_THREADS; i++) {
+		for (j = 0; j < MEM_TEST10_ALLOCATIONS_PER_THREAD; j++) {
+			omrmem_free_memory(data->blocks[i][j]);
+		}
+	}
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	if (categoriesState.dummyCategoryTwoBlocks != initialBlocks) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after free. Expected %zu, got %zu.\n", initialBlocks, categoriesState.dummyCategoryTwoBlocks);
+	}
+	if (categoriesState.dummyCategoryTwoBytes != initialBytes) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of bytes after free. Expected %zu, got %zu.\n", initialBytes, categoriesState.dummyCategoryTwoBytes);
+	}
+
+destroyMonitor:
+	omrthread_monitor_destroy(data->monitor);
+freeData:
+	omrmem_free_memory(data);
+end:
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, 0);
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+#define MEM_TEST11_BLOCK_SIZE 61
+#define MEM_TEST11_BLOCKS 3
+
+/**
+ * Verify sampled memory tagging.
+ *
+ * With a large OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL nearly every block
+ * gets a light header, which must be accounted and freed correctly. With an
+ * interval of 1 every block is sampled, so corrupting the padding of a live
+ * block must be reported by OMRPORT_CTLDATA_MEM_TAG_VERIFY.
+ */
+TEST(PortMemTest, mem_test11_sampled_tags)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmem_test11_sampled_tags";
+	struct CategoriesState categoriesState;
+	uintptr_t initialBytes = 0;
+	uintptr_t initialBlocks = 0;
+	uint8_t *blocks[MEM_TEST11_BLOCKS];
+	uint8_t *ptr = NULL;
+	uintptr_t i = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, (uintptr_t) &dummyCategorySet);
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	initialBytes = categoriesState.dummyCategoryTwoBytes;
+	initialBlocks = categoriesState.dummyCategoryTwoBlocks;
+
+	if (0 != omrport_control(OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL, 1000000)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to enable memory tag sampling\n");
+		goto end;
+	}
+
+	/* The first block after enabling sampling is sampled, and there is a small chance the next one is too */
+	for (i = 0; i < 4; i++) {
+		ptr = (uint8_t *)omrmem_allocate_memory(MEM_TEST11_BLOCK_SIZE, DUMMY_CATEGORY_TWO);
+		if (NULL == ptr) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+			goto end;
+		}
+		if (J9MEMTAG_EYECATCHER_LIGHT_HEADER == ((J9MemTag *)ptr - 1)->eyeCatcher) {
+			break;
+		}
+		omrmem_free_memory(ptr);
+		ptr = NULL;
+	}
+	if (NULL == ptr) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "No block was allocated with a light header\n");
+		goto end;
+	}
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	if (categoriesState.dummyCategoryTwoBlocks != (initialBlocks + 1)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after light allocation. Expected %zu, got %zu.\n", initialBlocks + 1, categoriesState.dummyCategoryTwoBlocks);
+	}
+	if (categoriesState.dummyCategoryTwoBytes != (initialBytes + sizeof(J9MemTag) + 64)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of bytes after light allocation. Expected %zu, got %zu.\n", initialBytes + sizeof(J9MemTag) + 64, categoriesState.dummyCategoryTwoBytes);
+	}
+
+	memset(ptr, 0x5A, MEM_TEST11_BLOCK_SIZE);
+	ptr = (uint8_t *)omrmem_reallocate_memory(ptr, 4 * MEM_TEST11_BLOCK_SIZE, DUMMY_CATEGORY_TWO);
+	if (NULL == ptr) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+		goto end;
+	}
+	for (i = 0; i < MEM_TEST11_BLOCK_SIZE; i++) {
+		if (0x5A != ptr[i]) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Reallocated block lost its contents at offset %zu\n", i);
+			break;
+		}
+	}
+	omrmem_free_memory(ptr);
+	ptr = NULL;
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	if (categoriesState.dummyCategoryTwoBlocks != initialBlocks) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after free. Expected %zu, got %zu.\n", initialBlocks, categoriesState.dummyCategoryTwoBlocks);
+	}
+	if (categoriesState.dummyCategoryTwoBytes != initialBytes) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of bytes after free. Expected %zu, got %zu.\n", initialBytes, categoriesState.dummyCategoryTwoBytes);
+	}
+
+	/* Sample every block, so that the verifier sees all of them */
+	omrport_control(OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL, 1);
+	for (i = 0; i < MEM_TEST11_BLOCKS; i++) {
+		blocks[i] = (uint8_t *)omrmem_allocate_memory(MEM_TEST11_BLOCK_SIZE, DUMMY_CATEGORY_TWO);
+		if (NULL == blocks[i]) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+		}
+	}
+	if ((NULL != blocks[0]) && (NULL != blocks[1]) && (NULL != blocks[2])) {
+		rc = omrport_control(OMRPORT_CTLDATA_MEM_TAG_VERIFY, 0);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Verifier reported %d corrupted blocks, expected none\n", rc);
+		}
+
+		/* Overrun into the padding of one block */
+		blocks[1][MEM_TEST11_BLOCK_SIZE] = 0;
+		rc = omrport_control(OMRPORT_CTLDATA_MEM_TAG_VERIFY, 0);
+		if (1 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Verifier reported %d corrupted blocks, expected 1\n", rc);
+		}
+		blocks[1][MEM_TEST11_BLOCK_SIZE] = J9MEMTAG_PADDING_BYTE;
+
+		/* Run the background verifier for a few periods */
+		if (0 != omrport_control(OMRPORT_CTLDATA_MEM_TAG_VERIFY_PERIOD, 5)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to start the memory tag verifier\n");
+		}
+		omrthread_sleep(50);
+		if (0 != omrport_control(OMRPORT_CTLDATA_MEM_TAG_VERIFY_PERIOD, 0)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to stop the memory tag verifier\n");
+		}
+	}
+	for (i = 0; i < MEM_TEST11_BLOCKS; i++) {
+		omrmem_free_memory(blocks[i]);
+	}
+
+	/* Freed blocks are no longer verified */
+	rc = omrport_control(OMRPORT_CTLDATA_MEM_TAG_VERIFY, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Verifier reported %d corrupted blocks after free, expected none\n", rc);
+	}
+
+end:
+	omrport_control(OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL, 0);
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, 0);
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
 /* attempt to free all mem pointers stored in memPtrs array with length */
 static void
 freeMemPointers(struct OMRPortLibrary *portLibrary, void **memPtrs, uintptr_t length)
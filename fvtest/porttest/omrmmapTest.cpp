@@ -2180,6 +2180,236 @@ TEST_F(PortMmapTest, mmap_testDontNeed)
 	reportTestExit(OMRPORTLIB, testName);
 }
 
+/**
+ * Create filename holding length bytes, byte i having the value (i % 251).
+ *
+ * @return 0 on success, -1 on failure
+ */
+static intptr_t
+createPatternFile(struct OMRPortLibrary *portLibrary, const char *testName, const char *filename, uintptr_t length)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	uint8_t *buffer = NULL;
+	intptr_t fd = -1;
+	intptr_t rc = -1;
+	uintptr_t i = 0;
+
+	buffer = (uint8_t *)omrmem_allocate_memory(length, OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == buffer) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Could not allocate %zu bytes\n", length);
+		return -1;
+	}
+	for (i = 0; i < length; i++) {
+		buffer[i] = (uint8_t)(i % 251);
+	}
+
+	omrfile_unlink(filename);
+	fd = omrfile_open(filename, EsOpenCreateNew | EsOpenRead | EsOpenWrite, 0660);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Create of file %s failed: lastErrorNumber=%d, lastErrorMessage=%s\n", filename, omrerror_last_error_number(), omrerror_last_error_message());
+	} else {
+		if ((intptr_t)length != omrfile_write(fd, buffer, (intptr_t)length)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Write to file %s failed: lastErrorNumber=%d, lastErrorMessage=%s\n", filename, omrerror_last_error_number(), omrerror_last_error_message());
+		} else {
+			rc = 0;
+		}
+		omrfile_close(fd);
+	}
+	omrmem_free_memory(buffer);
+	return rc;
+}
+
+/**
+ * Check every byte of a mapping of a file written by createPatternFile, starting at file offset fileOffset.
+ *
+ * @return TRUE if the contents match
+ */
+static BOOLEAN
+checkPattern(const uint8_t *mapAddr, uintptr_t length, uintptr_t fileOffset)
+{
+	uintptr_t i = 0;
+
+	for (i = 0; i < length; i++) {
+		if (mapAddr[i] != (uint8_t)((fileOffset + i) % 251)) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/**
+ * Verify OMRPORT_MMAP_FLAG_POPULATE mappings, @ref omrmmap.c::omrmmap_advise "omrmmap_advise()"
+ * and @ref omrmmap.c::omrmmap_prefetch "omrmmap_prefetch()".
+ */
+TEST_F(PortMmapTest, mmap_test14)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmmap_test14";
+	const char *filename = "mmapTest14.tst";
+#define J9MMAP_TEST14_FILE_SIZE (1024 * 1024)
+	intptr_t fd = -1;
+	intptr_t rc = 0;
+	int32_t capabilities = omrmmap_capabilities();
+	J9MmapHandle *mmapHandle = NULL;
+	uint8_t *mapAddr = NULL;
+	uint32_t advice = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (0 != createPatternFile(OMRPORTLIB, testName, filename, J9MMAP_TEST14_FILE_SIZE)) {
+		goto exit;
+	}
+	fd = omrfile_open(filename, EsOpenRead, 0660);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Open of file %s for mapping failed: lastErrorNumber=%d, lastErrorMessage=%s\n", filename, omrerror_last_error_number(), omrerror_last_error_message());
+		goto exit;
+	}
+	mmapHandle = omrmmap_map_file(fd, 0, 0, NULL, OMRPORT_MMAP_FLAG_READ | OMRPORT_MMAP_FLAG_POPULATE, OMRMEM_CATEGORY_PORT_LIBRARY);
+	omrfile_close(fd);
+	if ((NULL == mmapHandle) || (NULL == mmapHandle->pointer)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Mmap_map_file of file %s failed: lastErrorNumber=%d, lastErrorMessage=%s\n", filename, omrerror_last_error_number(), omrerror_last_error_message());
+		goto exit;
+	}
+	mapAddr = (uint8_t *)mmapHandle->pointer;
+	if (J9MMAP_TEST14_FILE_SIZE != mmapHandle->size) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Mapping size is %zu, expected %d\n", mmapHandle->size, J9MMAP_TEST14_FILE_SIZE);
+	}
+	if (!checkPattern(mapAddr, J9MMAP_TEST14_FILE_SIZE, 0)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Populated mapping does not match the file\n");
+	}
+
+	if (OMRPORT_MMAP_CAPABILITY_ADVISE == (capabilities & OMRPORT_MMAP_CAPABILITY_ADVISE)) {
+		/* Unaligned ranges are widened to whole pages rather than rejected */
+		for (advice = OMRPORT_MMAP_ADVICE_NORMAL; advice <= OMRPORT_MMAP_ADVICE_WILLNEED; advice++) {
+			rc = omrmmap_advise(mapAddr + 10, J9MMAP_TEST14_FILE_SIZE - 20, advice);
+			if (0 != rc) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_advise(%u) failed: rc=%zd, lastErrorMessage=%s\n", advice, rc, omrerror_last_error_message());
+			}
+		}
+		rc = omrmmap_advise(mapAddr, J9MMAP_TEST14_FILE_SIZE, OMRPORT_MMAP_ADVICE_NORMAL);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_advise(NORMAL) failed: rc=%zd\n", rc);
+		}
+		rc = omrmmap_advise(mapAddr, J9MMAP_TEST14_FILE_SIZE, 99);
+		if (OMRPORT_ERROR_MMAP_ADVISE_INVALIDADVICE != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_advise with invalid advice returned %zd\n", rc);
+		}
+
+		rc = omrmmap_prefetch(mmapHandle, 0, 0);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_prefetch of the whole mapping failed: rc=%zd\n", rc);
+		}
+		/* Ranges running past the end of the mapping are clipped to it */
+		rc = omrmmap_prefetch(mmapHandle, J9MMAP_TEST14_FILE_SIZE / 2, J9MMAP_TEST14_FILE_SIZE);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_prefetch past the end of the mapping failed: rc=%zd\n", rc);
+		}
+		rc = omrmmap_prefetch(mmapHandle, J9MMAP_TEST14_FILE_SIZE, 4096);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_prefetch beyond the mapping failed: rc=%zd\n", rc);
+		}
+	} else {
+		rc = omrmmap_advise(mapAddr, J9MMAP_TEST14_FILE_SIZE, OMRPORT_MMAP_ADVICE_SEQUENTIAL);
+		if (OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_advise returned %zd without OMRPORT_MMAP_CAPABILITY_ADVISE\n", rc);
+		}
+	}
+
+	if (!checkPattern(mapAddr, J9MMAP_TEST14_FILE_SIZE, 0)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Mapping changed after advice\n");
+	}
+	omrmmap_unmap_file(mmapHandle);
+
+exit:
+	omrfile_unlink(filename);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Verify OMRPORT_MMAP_FLAG_HUGEPAGE mappings.  The flag is only a request, so the mapping must behave like
+ * an ordinary one whether or not huge pages back it.
+ */
+TEST_F(PortMmapTest, mmap_test15)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmmap_test15";
+	const char *filename = "mmapTest15.tst";
+#define J9MMAP_TEST15_FILE_SIZE (6 * 1024 * 1024)
+#define J9MMAP_TEST15_OFFSET (64 * 1024)
+	const uintptr_t mapSize = J9MMAP_TEST15_FILE_SIZE - J9MMAP_TEST15_OFFSET;
+	intptr_t fd = -1;
+	intptr_t rc = 0;
+	int32_t capabilities = omrmmap_capabilities();
+	J9MmapHandle *mmapHandle = NULL;
+	uint8_t *mapAddr = NULL;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (0 != createPatternFile(OMRPORTLIB, testName, filename, J9MMAP_TEST15_FILE_SIZE)) {
+		goto exit;
+	}
+	fd = omrfile_open(filename, EsOpenRead, 0660);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Open of file %s for mapping failed: lastErrorNumber=%d, lastErrorMessage=%s\n", filename, omrerror_last_error_number(), omrerror_last_error_message());
+		goto exit;
+	}
+	mmapHandle = omrmmap_map_file(fd, J9MMAP_TEST15_OFFSET, mapSize, NULL, OMRPORT_MMAP_FLAG_COPYONWRITE | OMRPORT_MMAP_FLAG_HUGEPAGE | OMRPORT_MMAP_FLAG_POPULATE, OMRMEM_CATEGORY_PORT_LIBRARY);
+	omrfile_close(fd);
+	if ((NULL == mmapHandle) || (NULL == mmapHandle->pointer)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Mmap_map_file of file %s failed: lastErrorNumber=%d, lastErrorMessage=%s\n", filename, omrerror_last_error_number(), omrerror_last_error_message());
+		goto exit;
+	}
+	mapAddr = (uint8_t *)mmapHandle->pointer;
+	portTestEnv->log("%s: mapped %zu bytes at %p, huge pages %s\n", testName, mapSize, mapAddr,
+		(OMRPORT_MMAP_CAPABILITY_HUGEPAGE == (capabilities & OMRPORT_MMAP_CAPABILITY_HUGEPAGE)) ? "enabled" : "disabled");
+
+#if defined(LINUX) && defined(J9HAMMER)
+	if (OMRPORT_MMAP_CAPABILITY_HUGEPAGE == (capabilities & OMRPORT_MMAP_CAPABILITY_HUGEPAGE)) {
+		/* The address must agree with the file offset modulo the 2M huge page size */
+		const uintptr_t hugePageSize = 2 * 1024 * 1024;
+		if ((((uintptr_t)mapAddr) & (hugePageSize - 1)) != J9MMAP_TEST15_OFFSET) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Huge page mapping at %p is not aligned with file offset %d\n", mapAddr, J9MMAP_TEST15_OFFSET);
+		}
+	}
+#endif /* defined(LINUX) && defined(J9HAMMER) */
+
+	if (!checkPattern(mapAddr, mapSize, J9MMAP_TEST15_OFFSET)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Huge page mapping does not match the file\n");
+	}
+	mapAddr[0] = 0xff;
+	mapAddr[mapSize - 1] = 0xff;
+	if ((0xff != mapAddr[0]) || (0xff != mapAddr[mapSize - 1])) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Copy on write to huge page mapping was lost\n");
+	}
+
+	rc = omrmmap_advise(mapAddr, mapSize, OMRPORT_MMAP_ADVICE_HUGEPAGE);
+	if ((0 != rc) && (OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED != rc)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmmap_advise(HUGEPAGE) failed: rc=%zd, lastErrorMessage=%s\n", rc, omrerror_last_error_message());
+	}
+	omrmmap_unmap_file(mmapHandle);
+
+	/* A copy on write mapping must leave the file untouched */
+	fd = omrfile_open(filename, EsOpenRead, 0660);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Reopen of file %s failed\n", filename);
+		goto exit;
+	}
+	mmapHandle = omrmmap_map_file(fd, 0, 0, NULL, OMRPORT_MMAP_FLAG_READ | OMRPORT_MMAP_FLAG_HUGEPAGE, OMRMEM_CATEGORY_PORT_LIBRARY);
+	omrfile_close(fd);
+	if ((NULL == mmapHandle) || (NULL == mmapHandle->pointer)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Second mapping of file %s failed: lastErrorMessage=%s\n", filename, omrerror_last_error_message());
+		goto exit;
+	}
+	if (!checkPattern((uint8_t *)mmapHandle->pointer, J9MMAP_TEST15_FILE_SIZE, 0)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "File was modified through a copy on write huge page mapping\n");
+	}
+	omrmmap_unmap_file(mmapHandle);
+
+exit:
+	omrfile_unlink(filename);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
 int32_t
 omrmmap_runTests(struct OMRPortLibrary *portLibrary, char *argv0, char *omrmmap_child)
 {
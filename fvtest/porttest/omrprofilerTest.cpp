@@ -0,0 +1,327 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup PortTest
+ * @brief Verify the sampling profiler.
+ *
+ * Exercise the API for the port library profiler. These functions can be found
+ * in the file @ref omrprofiler.c
+ */
+#include <string.h>
+#if defined(LINUX)
+#include <signal.h>
+#endif /* defined(LINUX) */
+
+#include "testHelpers.hpp"
+#include "omrport.h"
+
+#define PROFILER_TEST_WORKERS 2
+#define PROFILER_TEST_SPIN_MILLIS 200
+#define PROFILER_TEST_MAX_FRAMES 64
+#define PROFILER_TEST_TIMEOUT_MILLIS 60000
+
+typedef struct ProfilerWorkerData {
+	struct OMRPortLibrary *portLibrary;
+	struct OMRProfiler *profiler;
+	omrthread_monitor_t monitor;
+	uintptr_t finishedCount;
+	uintptr_t failedCount;
+} ProfilerWorkerData;
+
+typedef struct ProfilerDrainData {
+	uintptr_t samples;
+	uintptr_t badSamples;
+	uintptr_t threadIds[PROFILER_TEST_WORKERS + 1];
+	uintptr_t threadCount;
+	uint64_t lastTimestamp;
+	uintptr_t firstFrame;
+} ProfilerDrainData;
+
+/**
+ * Spin until the calling thread has used PROFILER_TEST_SPIN_MILLIS of CPU time, so that
+ * its CPU-time timer fires however busy the machine is.
+ */
+static uintptr_t
+profilerTestSpin(void)
+{
+	omrthread_t self = omrthread_self();
+	int64_t end = omrthread_get_self_cpu_time(self) + ((int64_t)PROFILER_TEST_SPIN_MILLIS * 1000000);
+	volatile uintptr_t counter = 0;
+
+	while (omrthread_get_self_cpu_time(self) < end) {
+		uintptr_t i = 0;
+		for (i = 0; i < 10000; i++) {
+			counter += i;
+		}
+	}
+	return counter;
+}
+
+static int J9THREAD_PROC
+profilerTestWorker(void *arg)
+{
+	ProfilerWorkerData *data = (ProfilerWorkerData *)arg;
+	OMRPORT_ACCESS_FROM_OMRPORT(data->portLibrary);
+	BOOLEAN failed = FALSE;
+
+	if (0 != omrprofiler_register_thread(data->profiler)) {
+		failed = TRUE;
+	} else {
+		profilerTestSpin();
+		if (0 != omrprofiler_unregister_thread(data->profiler)) {
+			failed = TRUE;
+		}
+	}
+
+	omrthread_monitor_enter(data->monitor);
+	data->finishedCount += 1;
+	if (failed) {
+		data->failedCount += 1;
+	}
+	omrthread_monitor_notify_all(data->monitor);
+	omrthread_monitor_exit(data->monitor);
+	return 0;
+}
+
+static void
+profilerTestDrain(struct OMRPortLibrary *portLibrary, const OMRProfilerSample *sample, void *userData)
+{
+	ProfilerDrainData *data = (ProfilerDrainData *)userData;
+	uintptr_t i = 0;
+
+	if ((0 == sample->frameCount) || (sample->frameCount > PROFILER_TEST_MAX_FRAMES) || (0 == sample->frames[0])) {
+		data->badSamples += 1;
+	}
+	if (0 == data->firstFrame) {
+		data->firstFrame = sample->frames[0];
+	}
+	for (i = 0; i < data->threadCount; i++) {
+		if (data->threadIds[i] == sample->threadId) {
+			break;
+		}
+	}
+	if ((i == data->threadCount) && (data->threadCount < (PROFILER_TEST_WORKERS + 1))) {
+		data->threadIds[data->threadCount] = sample->threadId;
+		data->threadCount += 1;
+	}
+	data->samples += 1;
+}
+
+/**
+ * Profile the main thread and two workers, and check that each thread is sampled,
+ * that every sample drains exactly once, and that the samples symbolize.
+ */
+TEST(PortProfilerTest, profiler_sample_threads)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrprofiler_sample_threads";
+	struct OMRProfiler *profiler = NULL;
+	struct OMRProfiler *secondProfiler = NULL;
+	ProfilerWorkerData workerData;
+	ProfilerDrainData drainData;
+	OMRProfilerStats stats;
+	OMRProfilerSymbol symbol;
+	intptr_t waitRetVal = 0;
+	uintptr_t created = 0;
+	intptr_t drained = 0;
+	int32_t rc = 0;
+	uintptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrprofiler_create(1000000, PROFILER_TEST_MAX_FRAMES, 4096, &profiler);
+	if (OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM == rc) {
+		portTestEnv->log("Profiler not available on this platform, skipping\n");
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	} else if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_create() returned %d\n", rc);
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	}
+
+	rc = omrprofiler_create(1000000, PROFILER_TEST_MAX_FRAMES, 4096, &secondProfiler);
+	if ((OMRPORT_ERROR_EXIST != rc) || (NULL != secondProfiler)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "a second omrprofiler_create() returned %d, expected %d\n", rc, OMRPORT_ERROR_EXIST);
+	}
+
+	rc = omrprofiler_register_thread(profiler);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_register_thread() returned %d\n", rc);
+	}
+	rc = omrprofiler_register_thread(profiler);
+	if (OMRPORT_ERROR_EXIST != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "registering a thread twice returned %d, expected %d\n", rc, OMRPORT_ERROR_EXIST);
+	}
+	rc = omrprofiler_start(profiler);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_start() returned %d\n", rc);
+	}
+
+	memset(&workerData, 0, sizeof(workerData));
+	workerData.portLibrary = OMRPORTLIB;
+	workerData.profiler = profiler;
+	if (0 != omrthread_monitor_init(&workerData.monitor, 0)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to initialize monitor\n");
+		goto destroy;
+	}
+	for (i = 0; i < PROFILER_TEST_WORKERS; i++) {
+		omrthread_t thread = NULL;
+		if (0 != omrthread_create(&thread, 256 * 1024, J9THREAD_PRIORITY_NORMAL, 0, &profilerTestWorker, &workerData)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to create thread %zu\n", i);
+			break;
+		}
+		created += 1;
+	}
+	profilerTestSpin();
+
+	omrthread_monitor_enter(workerData.monitor);
+	while ((0 == waitRetVal) && (workerData.finishedCount < created)) {
+		waitRetVal = omrthread_monitor_wait_timed(workerData.monitor, PROFILER_TEST_TIMEOUT_MILLIS, 0);
+	}
+	omrthread_monitor_exit(workerData.monitor);
+	omrthread_monitor_destroy(workerData.monitor);
+	if (0 != waitRetVal) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Timed out waiting for workers, waitRetVal=%zd\n", waitRetVal);
+		goto destroy;
+	}
+	if (0 != workerData.failedCount) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "%zu workers failed to register or unregister\n", workerData.failedCount);
+	}
+
+	rc = omrprofiler_stop(profiler);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_stop() returned %d\n", rc);
+	}
+	rc = omrprofiler_unregister_thread(profiler);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_unregister_thread() returned %d\n", rc);
+	}
+	rc = omrprofiler_unregister_thread(profiler);
+	if (OMRPORT_ERROR_NOTFOUND != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "unregistering a thread twice returned %d, expected %d\n", rc, OMRPORT_ERROR_NOTFOUND);
+	}
+
+	/* unregistered threads keep their samples until they are drained */
+	memset(&drainData, 0, sizeof(drainData));
+	drained = omrprofiler_drain(profiler, profilerTestDrain, &drainData);
+	omrprofiler_get_stats(profiler, &stats);
+	portTestEnv->log("recorded %llu samples from %zu threads, dropped %llu\n", stats.recorded, drainData.threadCount, stats.dropped);
+	if ((drained != (intptr_t)drainData.samples) || (stats.recorded != stats.drained) || (stats.drained != drainData.samples)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "drained %zd samples, callback saw %zu, recorded %llu, stats drained %llu\n",
+			drained, drainData.samples, stats.recorded, stats.drained);
+	}
+	if (0 != stats.threads) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "%u threads still registered\n", stats.threads);
+	}
+	if (0 != drainData.badSamples) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "%zu samples had no frames or too many\n", drainData.badSamples);
+	}
+	if (drainData.threadCount != (created + 1)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "samples came from %zu threads, expected %zu\n", drainData.threadCount, created + 1);
+	}
+	if (0 != omrprofiler_drain(profiler, profilerTestDrain, &drainData)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "a second omrprofiler_drain() found samples\n");
+	}
+
+	if (0 != drainData.firstFrame) {
+		rc = omrprofiler_symbolize(drainData.firstFrame, &symbol);
+		if ((0 != rc) || (NULL == symbol.moduleName)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_symbolize(%p) returned %d\n", (void *)drainData.firstFrame, rc);
+		} else {
+			portTestEnv->log("first sample in %s+0x%zx (%s)\n", symbol.moduleName, symbol.moduleOffset,
+				(NULL != symbol.symbolName) ? symbol.symbolName : "?");
+		}
+	}
+
+destroy:
+	omrprofiler_destroy(profiler);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Check that symbolization resolves a port library function to its module, and
+ * that an address outside any module is not found.
+ */
+TEST(PortProfilerTest, profiler_symbolize)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrprofiler_symbolize";
+	OMRProfilerSymbol symbol;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrprofiler_symbolize((uintptr_t)OMRPORTLIB->profiler_symbolize, &symbol);
+	if (OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM == rc) {
+		portTestEnv->log("Symbolization not available on this platform, skipping\n");
+	} else if ((0 != rc) || (NULL == symbol.moduleName)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_symbolize(profiler_symbolize) returned %d\n", rc);
+	} else {
+		portTestEnv->log("profiler_symbolize is %s+0x%zx in %s\n",
+			(NULL != symbol.symbolName) ? symbol.symbolName : "?", symbol.symbolOffset, symbol.moduleName);
+
+		rc = omrprofiler_symbolize(0, &symbol);
+		if ((OMRPORT_ERROR_NOTFOUND != rc) || (NULL != symbol.moduleName)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_symbolize(NULL) returned %d, expected %d\n", rc, OMRPORT_ERROR_NOTFOUND);
+		}
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Check that a SIGPROF arriving after the profiler is destroyed, as one already queued by
+ * a deleted timer can, does not take the default action and terminate the process.
+ */
+TEST(PortProfilerTest, profiler_destroy_ignores_late_signal)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrprofiler_destroy_ignores_late_signal";
+	struct OMRProfiler *profiler = NULL;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrprofiler_create(100000, PROFILER_TEST_MAX_FRAMES, 16, &profiler);
+	if (OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM == rc) {
+		portTestEnv->log("Profiler not available on this platform, skipping\n");
+	} else if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrprofiler_create() returned %d\n", rc);
+	} else {
+		omrprofiler_destroy(profiler);
+#if defined(LINUX)
+		struct sigaction action;
+
+		memset(&action, 0, sizeof(action));
+		if ((0 != sigaction(SIGPROF, NULL, &action)) || (SIG_DFL == action.sa_handler)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "SIGPROF has the default action after omrprofiler_destroy()\n");
+		} else {
+			raise(SIGPROF);
+		}
+#endif /* defined(LINUX) */
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
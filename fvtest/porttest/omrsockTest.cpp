@@ -19,47 +19,130 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+
+#include <string.h>
+
 #include "omrcfg.h"
 #if defined(OMR_PORT_SOCKET_SUPPORT)
 #include "omrport.h"
 #include "omrportsock.h"
 #include "testHelpers.hpp"
 
+/* Echo benchmark: connections, bytes each client sends, and the size of one send */
+#define ECHO_CONNECTIONS 4
+#define ECHO_BYTES_PER_CONNECTION (16 * 1024 * 1024)
+#define ECHO_CHUNK (64 * 1024)
+/* Period of the byte pattern sent by echo clients, a prime so it drifts across chunks */
+#define ECHO_PATTERN_PERIOD 251
+#define ECHO_TIMEOUT_NANOS (60 * (int64_t)1000000000)
+
 /**
  * Start a server which creates a socket, binds to an address/port and 
  * listens for clients.
  * 
  * @param[in] portLibrary
  * @param[in] addrStr The address of the server.
- * @param[in] port The server port.
+ * @param[in] port The server port, "0" to let the system choose one.
  * @param[in] family Socket address family wanted.
  * @param[out] serverSocket A pointer to the server socket. 
- * @param[out] serverAddr The socket address of the server created.
+ * @param[out] serverAddr The socket address of the server created, including the port chosen.
  * 
  * @return 0 on success, return an error otherwise.
  */ 
 int32_t
 start_server(struct OMRPortLibrary *portLibrary, const char *addrStr, const char *port, int32_t family, omrsock_socket_t *serverSocket, omrsock_sockaddr_t serverAddr) 
 {
-    return OMRPORT_ERROR_NOTEXIST;
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	omrsock_addrinfo_t hints = NULL;
+	OMRAddrInfoNode result;
+	int32_t rc = 0;
+
+	rc = omrsock_getaddrinfo_create_hints(&hints, family, OMRSOCK_STREAM, OMRSOCK_IPPROTO_DEFAULT, OMRSOCK_AI_NUMERICHOST | OMRSOCK_AI_NUMERICSERV);
+	if (0 != rc) {
+		return rc;
+	}
+	rc = omrsock_getaddrinfo((char *)addrStr, (char *)port, hints, &result);
+	if (0 != rc) {
+		return rc;
+	}
+	rc = omrsock_getaddrinfo_address(&result, serverAddr, 0);
+	omrsock_freeaddrinfo(&result);
+	if (0 != rc) {
+		return rc;
+	}
+
+	rc = omrsock_socket(serverSocket, family, OMRSOCK_STREAM, OMRSOCK_IPPROTO_DEFAULT);
+	if (0 != rc) {
+		return rc;
+	}
+	rc = omrsock_bind(*serverSocket, serverAddr);
+	if (0 == rc) {
+		rc = omrsock_listen(*serverSocket, 128);
+	}
+	if (0 == rc) {
+		rc = omrsock_getsockname(*serverSocket, serverAddr);
+	}
+	if (0 != rc) {
+		omrsock_close(serverSocket);
+	}
+	return rc;
 }
 
 /**
  * Create the client socket, and then connect to the server.
  *  
  * @param[in] portLibrary
- * @param[in] addrStr The address of the server.
- * @param[in] port The server port.
+ * @param[in] serverAddr The socket address of the server.
  * @param[in] family Socket address family wanted.
- * @param[in] sessionClientSocket A pointer to the client socket. 
- * @param[in] sessionClientAddr The socket address of the client created. 
+ * @param[out] sessionClientSocket A pointer to the client socket. 
  * 
  * @return 0 on success, return an error otherwise.
  */ 
 int32_t
-connect_client_to_server(struct OMRPortLibrary *portLibrary, const char *addrStr, const char *port, int32_t family, omrsock_socket_t *sessionClientSocket, omrsock_sockaddr_t sessionClientAddr) 
+connect_client_to_server(struct OMRPortLibrary *portLibrary, omrsock_sockaddr_t serverAddr, int32_t family, omrsock_socket_t *sessionClientSocket) 
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	int32_t rc = omrsock_socket(sessionClientSocket, family, OMRSOCK_STREAM, OMRSOCK_IPPROTO_DEFAULT);
+
+	if (0 != rc) {
+		return rc;
+	}
+	rc = omrsock_connect(*sessionClientSocket, serverAddr);
+	if (0 != rc) {
+		omrsock_close(sessionClientSocket);
+	}
+	return rc;
+}
+
+/**
+ * Create a connected pair of loopback stream sockets.
+ *
+ * @param[in] portLibrary
+ * @param[out] clientSocket The connecting end.
+ * @param[out] acceptedSocket The accepted end.
+ *
+ * @return 0 on success, return an error otherwise.
+ */
+static int32_t
+connect_loopback_pair(struct OMRPortLibrary *portLibrary, omrsock_socket_t *clientSocket, omrsock_socket_t *acceptedSocket)
 {
-    return OMRPORT_ERROR_NOTEXIST;
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	omrsock_socket_t serverSocket = NULL;
+	OMRSockAddrStorage serverAddr;
+	int32_t rc = start_server(OMRPORTLIB, "127.0.0.1", "0", OMRSOCK_AF_INET, &serverSocket, &serverAddr);
+
+	if (0 != rc) {
+		return rc;
+	}
+	rc = connect_client_to_server(OMRPORTLIB, &serverAddr, OMRSOCK_AF_INET, clientSocket);
+	if (0 == rc) {
+		rc = omrsock_accept(serverSocket, NULL, acceptedSocket);
+		if (0 != rc) {
+			omrsock_close(clientSocket);
+		}
+	}
+	omrsock_close(&serverSocket);
+	return rc;
 }
 
 /**
@@ -72,7 +155,46 @@ connect_client_to_server(struct OMRPortLibrary *portLibrary, const char *addrStr
  */
 TEST(PortSockTest, library_function_pointers_not_null)
 {
-    /* Unimplemented. */
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_library_function_pointers_not_null";
+	void *functions[] = {
+		(void *)OMRPORTLIB->sock_getaddrinfo_create_hints,
+		(void *)OMRPORTLIB->sock_getaddrinfo,
+		(void *)OMRPORTLIB->sock_getaddrinfo_length,
+		(void *)OMRPORTLIB->sock_getaddrinfo_family,
+		(void *)OMRPORTLIB->sock_getaddrinfo_socktype,
+		(void *)OMRPORTLIB->sock_getaddrinfo_protocol,
+		(void *)OMRPORTLIB->sock_freeaddrinfo,
+		(void *)OMRPORTLIB->sock_socket,
+		(void *)OMRPORTLIB->sock_bind,
+		(void *)OMRPORTLIB->sock_listen,
+		(void *)OMRPORTLIB->sock_connect,
+		(void *)OMRPORTLIB->sock_accept,
+		(void *)OMRPORTLIB->sock_send,
+		(void *)OMRPORTLIB->sock_sendto,
+		(void *)OMRPORTLIB->sock_recv,
+		(void *)OMRPORTLIB->sock_recvfrom,
+		(void *)OMRPORTLIB->sock_close,
+		(void *)OMRPORTLIB->sock_sendmsg,
+		(void *)OMRPORTLIB->sock_getaddrinfo_address,
+		(void *)OMRPORTLIB->sock_getsockname,
+		(void *)OMRPORTLIB->sock_fcntl,
+		(void *)OMRPORTLIB->sock_poll_create,
+		(void *)OMRPORTLIB->sock_poll_destroy,
+		(void *)OMRPORTLIB->sock_poll_ctl,
+		(void *)OMRPORTLIB->sock_poll_wait,
+		(void *)OMRPORTLIB->sock_poll_timer_start,
+		(void *)OMRPORTLIB->sock_poll_timer_cancel,
+	};
+	uintptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+	for (i = 0; i < sizeof(functions) / sizeof(functions[0]); i++) {
+		if (NULL == functions[i]) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "socket function %zu is NULL\n", i);
+		}
+	}
+	reportTestExit(OMRPORTLIB, testName);
 }
 
 /**
@@ -83,7 +205,47 @@ TEST(PortSockTest, library_function_pointers_not_null)
  */
 TEST(PortSockTest, per_thread_buffer_functionality)
 {
-    /* Unimplemented. */
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_per_thread_buffer_functionality";
+	omrsock_addrinfo_t hints1 = NULL;
+	omrsock_addrinfo_t hints2 = NULL;
+	uint32_t length = 0;
+	int32_t value = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrsock_getaddrinfo_create_hints(&hints1, OMRSOCK_AF_INET, OMRSOCK_STREAM, OMRSOCK_IPPROTO_TCP, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_getaddrinfo_create_hints() returned %d\n", rc);
+		goto exit;
+	}
+	/* a thread has one hints buffer, reused by each call */
+	rc = omrsock_getaddrinfo_create_hints(&hints2, OMRSOCK_AF_INET6, OMRSOCK_DGRAM, OMRSOCK_IPPROTO_UDP, 0);
+	if ((0 != rc) || (hints1 != hints2)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "second omrsock_getaddrinfo_create_hints() returned %d, hints %p expected %p\n", rc, hints2, hints1);
+		goto exit;
+	}
+
+	omrsock_getaddrinfo_length(hints2, &length);
+	if (1 != length) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "hints length %u expected 1\n", length);
+	}
+	omrsock_getaddrinfo_family(hints2, &value, 0);
+	if (OMRSOCK_AF_INET6 != value) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "hints family %d expected %d\n", value, OMRSOCK_AF_INET6);
+	}
+	omrsock_getaddrinfo_socktype(hints2, &value, 0);
+	if (OMRSOCK_DGRAM != value) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "hints socket type %d expected %d\n", value, OMRSOCK_DGRAM);
+	}
+	omrsock_getaddrinfo_protocol(hints2, &value, 0);
+	if (OMRSOCK_IPPROTO_UDP != value) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "hints protocol %d expected %d\n", value, OMRSOCK_IPPROTO_UDP);
+	}
+
+exit:
+	reportTestExit(OMRPORTLIB, testName);
 }
 
 /**
@@ -95,8 +257,7 @@ TEST(PortSockTest, per_thread_buffer_functionality)
  * @ref omrsock_getaddrinfo_create_hints. The generated hints are passed into 
  * @ref omrsock_getaddrinfo. The results generated are used to create a socket.
  *
- * Address families tested will include IPv4, IPv6(if supported on machine), 
- * unspecified family. Socket types tested will include Stream and Datagram.
+ * Socket types tested include Stream and Datagram, for the IPv4 loopback address.
  *
  * @note Errors such as failed function calls, and/or returning the wrong family or 
  * socket type from @ref omrsock_getaddrinfo compared to the ones passed into hints, 
@@ -104,7 +265,61 @@ TEST(PortSockTest, per_thread_buffer_functionality)
  */
 TEST(PortSockTest, getaddrinfo_creation_and_extraction)
 {
-    /* Unimplemented. */
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_getaddrinfo_creation_and_extraction";
+	int32_t socktypes[] = {OMRSOCK_STREAM, OMRSOCK_DGRAM};
+	uintptr_t t = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	for (t = 0; t < sizeof(socktypes) / sizeof(socktypes[0]); t++) {
+		omrsock_addrinfo_t hints = NULL;
+		OMRAddrInfoNode result;
+		uint32_t length = 0;
+		uint32_t i = 0;
+		int32_t rc = omrsock_getaddrinfo_create_hints(&hints, OMRSOCK_AF_INET, socktypes[t], OMRSOCK_IPPROTO_DEFAULT, OMRSOCK_AI_NUMERICHOST);
+
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_getaddrinfo_create_hints() returned %d\n", rc);
+			continue;
+		}
+		rc = omrsock_getaddrinfo((char *)"127.0.0.1", (char *)"4321", hints, &result);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_getaddrinfo() returned %d\n", rc);
+			continue;
+		}
+		omrsock_getaddrinfo_length(&result, &length);
+		if (0 == length) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_getaddrinfo() returned no addresses\n");
+		}
+
+		for (i = 0; i < length; i++) {
+			omrsock_socket_t sock = NULL;
+			int32_t family = 0;
+			int32_t socktype = 0;
+			int32_t protocol = 0;
+
+			omrsock_getaddrinfo_family(&result, &family, i);
+			omrsock_getaddrinfo_socktype(&result, &socktype, i);
+			omrsock_getaddrinfo_protocol(&result, &protocol, i);
+			if ((OMRSOCK_AF_INET != family) || (socktypes[t] != socktype)) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "result %u has family %d and type %d, expected %d and %d\n", i, family, socktype, OMRSOCK_AF_INET, socktypes[t]);
+			}
+			rc = omrsock_socket(&sock, family, socktype, protocol);
+			if (0 != rc) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_socket() for result %u returned %d\n", i, rc);
+			} else {
+				omrsock_close(&sock);
+			}
+		}
+
+		if (0 == omrsock_getaddrinfo_family(&result, &rc, length)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_getaddrinfo_family() accepted an index past the end\n");
+		}
+		omrsock_freeaddrinfo(&result);
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
 }
 
 /**
@@ -114,15 +329,652 @@ TEST(PortSockTest, getaddrinfo_creation_and_extraction)
  * client starts and sends a request to connect to the server. The messages are
  * sent both ways, and it is checked if they were sent correctly.
  * 
- * Address families tested include IPv4 and IPv6 (if supported). Socket types
- * tested include stream and datagram.
+ * Address families tested include IPv4 and IPv6 (if supported).
  *
  * @note Errors such as failed function calls, failure to create server and/or client, wrong 
  * message sent/received, will be reported.
  */
 TEST(PortSockTest, two_socket_communication)
 {
-    /* Unimplemented. */
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_two_socket_communication";
+	const char *addresses[] = {"127.0.0.1", "::1"};
+	int32_t families[] = {OMRSOCK_AF_INET, OMRSOCK_AF_INET6};
+	uintptr_t f = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	for (f = 0; f < sizeof(families) / sizeof(families[0]); f++) {
+		omrsock_socket_t serverSocket = NULL;
+		omrsock_socket_t clientSocket = NULL;
+		omrsock_socket_t acceptedSocket = NULL;
+		OMRSockAddrStorage serverAddr;
+		OMRSockAddrStorage clientAddr;
+		uint8_t request[] = "ping";
+		uint8_t response[] = "pong";
+		uint8_t buffer[16];
+		int32_t rc = start_server(OMRPORTLIB, addresses[f], "0", families[f], &serverSocket, &serverAddr);
+
+		if (0 != rc) {
+			if (OMRSOCK_AF_INET6 == families[f]) {
+				portTestEnv->log("IPv6 loopback is not available, rc=%d\n", rc);
+			} else {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "start_server(%s) returned %d\n", addresses[f], rc);
+			}
+			continue;
+		}
+		rc = connect_client_to_server(OMRPORTLIB, &serverAddr, families[f], &clientSocket);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "connect_client_to_server(%s) returned %d\n", addresses[f], rc);
+			omrsock_close(&serverSocket);
+			continue;
+		}
+		rc = omrsock_accept(serverSocket, &clientAddr, &acceptedSocket);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_accept() returned %d\n", rc);
+			goto close;
+		}
+
+		rc = omrsock_send(clientSocket, request, sizeof(request), 0);
+		if ((int32_t)sizeof(request) != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_send() returned %d\n", rc);
+			goto close;
+		}
+		memset(buffer, 0, sizeof(buffer));
+		rc = omrsock_recv(acceptedSocket, buffer, sizeof(request), 0);
+		if (((int32_t)sizeof(request) != rc) || (0 != memcmp(buffer, request, sizeof(request)))) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "server received %d bytes \"%s\"\n", rc, buffer);
+			goto close;
+		}
+		rc = omrsock_send(acceptedSocket, response, sizeof(response), 0);
+		memset(buffer, 0, sizeof(buffer));
+		rc = omrsock_recv(clientSocket, buffer, sizeof(response), 0);
+		if (((int32_t)sizeof(response) != rc) || (0 != memcmp(buffer, response, sizeof(response)))) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "client received %d bytes \"%s\"\n", rc, buffer);
+			goto close;
+		}
+
+		/* an orderly close reads as 0 bytes */
+		omrsock_close(&clientSocket);
+		rc = omrsock_recv(acceptedSocket, buffer, sizeof(buffer), 0);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_recv() after the peer closed returned %d\n", rc);
+		}
+
+close:
+		if (NULL != acceptedSocket) {
+			omrsock_close(&acceptedSocket);
+		}
+		if (NULL != clientSocket) {
+			omrsock_close(&clientSocket);
+		}
+		omrsock_close(&serverSocket);
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Test @ref omrsock_sendmsg, gathering several buffers into one send, with and
+ * without OMRSOCK_MSG_ZEROCOPY.
+ */
+TEST(PortSockTest, sendmsg_gathers_buffers)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_sendmsg_gathers_buffers";
+	const uint32_t largeSize = 64 * 1024;
+	omrsock_socket_t clientSocket = NULL;
+	omrsock_socket_t acceptedSocket = NULL;
+	uint8_t header[] = "header:";
+	uint8_t *large = NULL;
+	uint8_t *received = NULL;
+	int32_t flags[] = {0, OMRSOCK_MSG_ZEROCOPY};
+	uintptr_t f = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	large = (uint8_t *)omrmem_allocate_memory(largeSize, OMRMEM_CATEGORY_PORT_LIBRARY);
+	received = (uint8_t *)omrmem_allocate_memory(largeSize + sizeof(header), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if ((NULL == large) || (NULL == received)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to allocate buffers\n");
+		goto exit;
+	}
+	for (uint32_t i = 0; i < largeSize; i++) {
+		large[i] = (uint8_t)(i % ECHO_PATTERN_PERIOD);
+	}
+
+	rc = connect_loopback_pair(OMRPORTLIB, &clientSocket, &acceptedSocket);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "connect_loopback_pair() returned %d\n", rc);
+		goto exit;
+	}
+
+	for (f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+		OMRIOVec iov[3] = {{header, sizeof(header) - 1}, {NULL, 0}, {large, largeSize}};
+		int32_t expected = (int32_t)(sizeof(header) - 1 + largeSize);
+		int32_t sent = 0;
+		int32_t total = 0;
+
+		/* a blocking socket sends everything, but accept a short send and finish it */
+		sent = omrsock_sendmsg(clientSocket, iov, 3, flags[f]);
+		if (sent < 0) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_sendmsg(flags=0x%x) returned %d\n", flags[f], sent);
+			break;
+		}
+		while (total < expected) {
+			rc = omrsock_recv(acceptedSocket, received + total, expected - total, 0);
+			if (rc <= 0) {
+				break;
+			}
+			total += rc;
+			if ((total == sent) && (sent < expected)) {
+				int32_t largeSent = sent - (int32_t)(sizeof(header) - 1);
+				rc = omrsock_send(clientSocket, large + largeSent, expected - sent, 0);
+				if (rc > 0) {
+					sent += rc;
+				}
+			}
+		}
+		if ((expected != total)
+			|| (0 != memcmp(received, header, sizeof(header) - 1))
+			|| (0 != memcmp(received + sizeof(header) - 1, large, largeSize))
+		) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_sendmsg(flags=0x%x) delivered %d of %d bytes or the wrong data\n", flags[f], total, expected);
+		}
+	}
+
+exit:
+	if (NULL != clientSocket) {
+		omrsock_close(&clientSocket);
+	}
+	if (NULL != acceptedSocket) {
+		omrsock_close(&acceptedSocket);
+	}
+	omrmem_free_memory(large);
+	omrmem_free_memory(received);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Test readiness reporting by a poll set, in level and edge-triggered modes,
+ * and that non-blocking sockets report OMRPORT_ERROR_SOCKET_WOULDBLOCK.
+ */
+TEST(PortSockTest, poll_readiness)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_poll_readiness";
+	omrsock_socket_t clientSocket = NULL;
+	omrsock_socket_t acceptedSocket = NULL;
+	omrsock_poll_t pollSet = NULL;
+	OMRSockPollEvent events[4];
+	uint8_t message[] = "ready";
+	uint8_t buffer[64];
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = connect_loopback_pair(OMRPORTLIB, &clientSocket, &acceptedSocket);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "connect_loopback_pair() returned %d\n", rc);
+		goto exit;
+	}
+	rc = omrsock_fcntl(acceptedSocket, OMRSOCK_O_NONBLOCK);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_fcntl() returned %d\n", rc);
+		goto exit;
+	}
+	rc = omrsock_recv(acceptedSocket, buffer, sizeof(buffer), 0);
+	if (OMRPORT_ERROR_SOCKET_WOULDBLOCK != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_recv() on an empty non-blocking socket returned %d\n", rc);
+	}
+
+	rc = omrsock_poll_create(&pollSet, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_create() returned %d\n", rc);
+		goto exit;
+	}
+	rc = omrsock_poll_ctl(pollSet, OMRSOCK_POLL_ADD, acceptedSocket, OMRSOCK_POLLIN | OMRSOCK_POLLET, &acceptedSocket);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_ctl(ADD) returned %d\n", rc);
+		goto exit;
+	}
+	rc = omrsock_poll_ctl(pollSet, OMRSOCK_POLL_ADD, acceptedSocket, OMRSOCK_POLLIN, NULL);
+	if (OMRPORT_ERROR_SOCKET_ALREADY_REGISTERED != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "second omrsock_poll_ctl(ADD) returned %d\n", rc);
+	}
+
+	rc = omrsock_poll_wait(pollSet, events, 4, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() with nothing ready returned %d\n", rc);
+	}
+
+	omrsock_send(clientSocket, message, sizeof(message), 0);
+	rc = omrsock_poll_wait(pollSet, events, 4, 5 * (int64_t)1000000000);
+	if ((1 != rc) || (&acceptedSocket != events[0].userData) || !OMR_ARE_ANY_BITS_SET(events[0].events, OMRSOCK_POLLIN)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() after a send returned %d\n", rc);
+		goto exit;
+	}
+
+#if defined(LINUX)
+	/* edge-triggered: the unread data is not reported again */
+	rc = omrsock_poll_wait(pollSet, events, 4, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "edge-triggered omrsock_poll_wait() reported the same data again, rc=%d\n", rc);
+	}
+#endif /* defined(LINUX) */
+
+	/* level-triggered: it is reported while it stays unread */
+	rc = omrsock_poll_ctl(pollSet, OMRSOCK_POLL_MODIFY, acceptedSocket, OMRSOCK_POLLIN, buffer);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_ctl(MODIFY) returned %d\n", rc);
+	}
+	rc = omrsock_poll_wait(pollSet, events, 4, 0);
+	if ((1 != rc) || (buffer != events[0].userData)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "level-triggered omrsock_poll_wait() returned %d\n", rc);
+	}
+
+	rc = omrsock_recv(acceptedSocket, buffer, sizeof(buffer), 0);
+	if ((int32_t)sizeof(message) != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_recv() returned %d\n", rc);
+	}
+	rc = omrsock_poll_wait(pollSet, events, 4, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() after reading everything returned %d\n", rc);
+	}
+
+	/* the peer closing is reported as readable */
+	omrsock_close(&clientSocket);
+	rc = omrsock_poll_wait(pollSet, events, 4, 5 * (int64_t)1000000000);
+	if ((1 != rc) || !OMR_ARE_ANY_BITS_SET(events[0].events, OMRSOCK_POLLIN | OMRSOCK_POLLHUP)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() after the peer closed returned %d\n", rc);
+	}
+
+	rc = omrsock_poll_ctl(pollSet, OMRSOCK_POLL_REMOVE, acceptedSocket, 0, NULL);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_ctl(REMOVE) returned %d\n", rc);
+	}
+	rc = omrsock_poll_ctl(pollSet, OMRSOCK_POLL_REMOVE, acceptedSocket, 0, NULL);
+	if (OMRPORT_ERROR_SOCKET_NOT_REGISTERED != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "second omrsock_poll_ctl(REMOVE) returned %d\n", rc);
+	}
+
+exit:
+	if (NULL != pollSet) {
+		omrsock_poll_destroy(pollSet);
+	}
+	if (NULL != clientSocket) {
+		omrsock_close(&clientSocket);
+	}
+	if (NULL != acceptedSocket) {
+		omrsock_close(&acceptedSocket);
+	}
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Test timers delivered by a poll set: ordering, periodic expiry, cancellation,
+ * and that none is reported before its deadline.
+ */
+TEST(PortSockTest, poll_timers)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_poll_timers";
+	const int64_t millis = 1000000;
+	omrsock_poll_t pollSet = NULL;
+	omrsock_timer_t periodic = NULL;
+	OMRSockPollEvent events[4];
+	int oneShotTag = 0;
+	int periodicTag = 0;
+	uintptr_t periodicCount = 0;
+	BOOLEAN oneShotSeen = FALSE;
+	int64_t start = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrsock_poll_create(&pollSet, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_create() returned %d\n", rc);
+		goto exit;
+	}
+
+	start = omrtime_nano_time();
+	rc = omrsock_poll_timer_start(pollSet, 30 * millis, 10 * millis, &periodicTag, &periodic);
+	if (0 == rc) {
+		rc = omrsock_poll_timer_start(pollSet, 10 * millis, 0, &oneShotTag, NULL);
+	}
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_timer_start() returned %d\n", rc);
+		goto exit;
+	}
+
+	while (periodicCount < 3) {
+		int32_t i = 0;
+
+		rc = omrsock_poll_wait(pollSet, events, 4, 5000 * millis);
+		if (rc <= 0) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() returned %d while timers were running\n", rc);
+			goto exit;
+		}
+		for (i = 0; i < rc; i++) {
+			int64_t elapsed = omrtime_nano_time() - start;
+
+			if (OMRSOCK_POLLTIMER != events[i].events) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "unexpected events 0x%x\n", events[i].events);
+			} else if (&oneShotTag == events[i].userData) {
+				if (oneShotSeen || (elapsed < 10 * millis)) {
+					outputErrorMessage(PORTTEST_ERROR_ARGS, "one-shot timer reported again or early, after %lld ns\n", elapsed);
+				}
+				oneShotSeen = TRUE;
+			} else if (&periodicTag == events[i].userData) {
+				if (!oneShotSeen || (elapsed < (int64_t)(30 + 10 * periodicCount) * millis)) {
+					outputErrorMessage(PORTTEST_ERROR_ARGS, "periodic timer reported out of order or early, after %lld ns\n", elapsed);
+				}
+				periodicCount += 1;
+			}
+		}
+	}
+
+	rc = omrsock_poll_timer_cancel(pollSet, periodic);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_timer_cancel() returned %d\n", rc);
+	}
+	rc = omrsock_poll_wait(pollSet, events, 4, 30 * millis);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() after canceling returned %d\n", rc);
+	}
+	if ((omrtime_nano_time() - start) < 60 * millis) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() returned before its timeout\n");
+	}
+
+exit:
+	if (NULL != pollSet) {
+		omrsock_poll_destroy(pollSet);
+	}
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Test that a timer which expired before omrsock_poll_wait is called is reported,
+ * even though no socket becomes ready during the wait.
+ */
+TEST(PortSockTest, poll_timer_expired_before_wait)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_poll_timer_expired_before_wait";
+	const int64_t millis = 1000000;
+	omrsock_poll_t pollSet = NULL;
+	OMRSockPollEvent events[4];
+	int oneShotTag = 0;
+	int64_t start = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrsock_poll_create(&pollSet, 0);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_create() returned %d\n", rc);
+		goto exit;
+	}
+	rc = omrsock_poll_timer_start(pollSet, millis, 0, &oneShotTag, NULL);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_timer_start() returned %d\n", rc);
+		goto exit;
+	}
+
+	start = omrtime_nano_time();
+	while ((omrtime_nano_time() - start) < 20 * millis) {
+		/* let the timer expire without waiting on the poll set */
+	}
+
+	rc = omrsock_poll_wait(pollSet, events, 4, 200 * millis);
+	if ((1 != rc) || (OMRSOCK_POLLTIMER != events[0].events) || (&oneShotTag != events[0].userData)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() returned %d, expected the expired timer\n", rc);
+	}
+
+exit:
+	if (NULL != pollSet) {
+		omrsock_poll_destroy(pollSet);
+	}
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+typedef struct EchoConnection {
+	omrsock_socket_t sock;
+	BOOLEAN isClient;
+	uint8_t *buffer; /* server: data waiting to be echoed; client: receive buffer */
+	int32_t pending; /* server: bytes of buffer not yet echoed */
+	int32_t offset; /* server: start of the bytes not yet echoed */
+	uint64_t sent; /* client: bytes sent */
+	uint64_t received; /* client: bytes received back */
+} EchoConnection;
+
+/**
+ * Move data on an edge-triggered connection until it would block.
+ *
+ * @return 1 when a client has received everything back, -1 on failure, 0 otherwise.
+ */
+static int32_t
+echo_pump(struct OMRPortLibrary *portLibrary, EchoConnection *connection, uint8_t *pattern)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	BOOLEAN progress = TRUE;
+
+	while (progress) {
+		int32_t rc = 0;
+
+		progress = FALSE;
+		if (connection->isClient) {
+			if (connection->sent < ECHO_BYTES_PER_CONNECTION) {
+				int32_t length = (int32_t)OMR_MIN(ECHO_BYTES_PER_CONNECTION - connection->sent, ECHO_CHUNK);
+				rc = omrsock_send(connection->sock, pattern + (connection->sent % ECHO_PATTERN_PERIOD), length, 0);
+				if (rc > 0) {
+					connection->sent += rc;
+					progress = TRUE;
+				} else if (OMRPORT_ERROR_SOCKET_WOULDBLOCK != rc) {
+					return -1;
+				}
+			}
+			rc = omrsock_recv(connection->sock, connection->buffer, ECHO_CHUNK, 0);
+			if (rc > 0) {
+				int32_t start = (int32_t)(connection->received % ECHO_PATTERN_PERIOD);
+				if (0 != memcmp(connection->buffer, pattern + start, rc)) {
+					return -1;
+				}
+				connection->received += rc;
+				if (ECHO_BYTES_PER_CONNECTION == connection->received) {
+					return 1;
+				}
+				progress = TRUE;
+			} else if (OMRPORT_ERROR_SOCKET_WOULDBLOCK != rc) {
+				return -1;
+			}
+		} else {
+			if (connection->pending > 0) {
+				rc = omrsock_send(connection->sock, connection->buffer + connection->offset, connection->pending, 0);
+				if (rc > 0) {
+					connection->offset += rc;
+					connection->pending -= rc;
+					progress = TRUE;
+				} else if (OMRPORT_ERROR_SOCKET_WOULDBLOCK != rc) {
+					return -1;
+				}
+			}
+			/* stop reading while the client is not taking its echo, it must not overrun the buffer */
+			if (0 == connection->pending) {
+				rc = omrsock_recv(connection->sock, connection->buffer, ECHO_CHUNK, 0);
+				if (rc > 0) {
+					connection->offset = 0;
+					connection->pending = rc;
+					progress = TRUE;
+				} else if (0 == rc) {
+					return 1;
+				} else if (OMRPORT_ERROR_SOCKET_WOULDBLOCK != rc) {
+					return -1;
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+/**
+ * Measure the throughput of an echo server over loopback connections, driven by
+ * one thread through an edge-triggered poll set, with a timer as a watchdog.
+ */
+TEST(PortSockTest, poll_echo_throughput)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsock_poll_echo_throughput";
+	EchoConnection connections[2 * ECHO_CONNECTIONS];
+	uint32_t connectionCount = 0;
+	uint32_t clientsDone = 0;
+	omrsock_socket_t serverSocket = NULL;
+	OMRSockAddrStorage serverAddr;
+	omrsock_poll_t pollSet = NULL;
+	OMRSockPollEvent events[16];
+	uint8_t *pattern = NULL;
+	int watchdogTag = 0;
+	BOOLEAN failed = FALSE;
+	int64_t start = 0;
+	int64_t elapsed = 0;
+	uint32_t i = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+	memset(connections, 0, sizeof(connections));
+
+	pattern = (uint8_t *)omrmem_allocate_memory(ECHO_CHUNK + ECHO_PATTERN_PERIOD, OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == pattern) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to allocate the pattern\n");
+		goto exit;
+	}
+	for (i = 0; i < ECHO_CHUNK + ECHO_PATTERN_PERIOD; i++) {
+		pattern[i] = (uint8_t)(i % ECHO_PATTERN_PERIOD);
+	}
+
+	rc = start_server(OMRPORTLIB, "127.0.0.1", "0", OMRSOCK_AF_INET, &serverSocket, &serverAddr);
+	if (0 == rc) {
+		rc = omrsock_fcntl(serverSocket, OMRSOCK_O_NONBLOCK);
+	}
+	if (0 == rc) {
+		rc = omrsock_poll_create(&pollSet, 0);
+	}
+	if (0 == rc) {
+		rc = omrsock_poll_ctl(pollSet, OMRSOCK_POLL_ADD, serverSocket, OMRSOCK_POLLIN, &serverSocket);
+	}
+	if (0 == rc) {
+		rc = omrsock_poll_timer_start(pollSet, ECHO_TIMEOUT_NANOS, 0, &watchdogTag, NULL);
+	}
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to set up the echo server, rc=%d\n", rc);
+		goto exit;
+	}
+
+	start = omrtime_nano_time();
+	for (i = 0; i < ECHO_CONNECTIONS; i++) {
+		EchoConnection *client = &connections[connectionCount];
+
+		client->isClient = TRUE;
+		client->buffer = (uint8_t *)omrmem_allocate_memory(ECHO_CHUNK, OMRMEM_CATEGORY_PORT_LIBRARY);
+		rc = omrsock_socket(&client->sock, OMRSOCK_AF_INET, OMRSOCK_STREAM, OMRSOCK_IPPROTO_DEFAULT);
+		if ((0 != rc) || (NULL == client->buffer)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to create client %u, rc=%d\n", i, rc);
+			goto exit;
+		}
+		connectionCount += 1;
+		omrsock_fcntl(client->sock, OMRSOCK_O_NONBLOCK);
+		rc = omrsock_connect(client->sock, &serverAddr);
+		if ((0 != rc) && (OMRPORT_ERROR_SOCKET_IN_PROGRESS != rc)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_connect() returned %d\n", rc);
+			goto exit;
+		}
+		/* writable once connected */
+		rc = omrsock_poll_ctl(pollSet, OMRSOCK_POLL_ADD, client->sock, OMRSOCK_POLLIN | OMRSOCK_POLLOUT | OMRSOCK_POLLET, client);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_ctl() returned %d\n", rc);
+			goto exit;
+		}
+	}
+
+	while (!failed && (clientsDone < ECHO_CONNECTIONS)) {
+		int32_t count = omrsock_poll_wait(pollSet, events, sizeof(events) / sizeof(events[0]), -1);
+
+		if (count < 0) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsock_poll_wait() returned %d\n", count);
+			break;
+		}
+		for (int32_t e = 0; e < count; e++) {
+			if (&watchdogTag == events[e].userData) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "echo did not finish in time, %u of %u clients done\n", clientsDone, ECHO_CONNECTIONS);
+				failed = TRUE;
+			} else if (&serverSocket == events[e].userData) {
+				omrsock_socket_t accepted = NULL;
+
+				while (0 == omrsock_accept(serverSocket, NULL, &accepted)) {
+					EchoConnection *server = &connections[connectionCount];
+
+					if (connectionCount == sizeof(connections) / sizeof(connections[0])) {
+						omrsock_close(&accepted);
+						outputErrorMessage(PORTTEST_ERROR_ARGS, "unexpected connection\n");
+						failed = TRUE;
+						break;
+					}
+					server->sock = accepted;
+					server->buffer = (uint8_t *)omrmem_allocate_memory(ECHO_CHUNK, OMRMEM_CATEGORY_PORT_LIBRARY);
+					connectionCount += 1;
+					omrsock_fcntl(accepted, OMRSOCK_O_NONBLOCK);
+					if ((NULL == server->buffer) || (0 != omrsock_poll_ctl(pollSet, OMRSOCK_POLL_ADD, accepted, OMRSOCK_POLLIN | OMRSOCK_POLLOUT | OMRSOCK_POLLET, server))) {
+						outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to register an accepted connection\n");
+						failed = TRUE;
+						break;
+					}
+				}
+			} else {
+				EchoConnection *connection = (EchoConnection *)events[e].userData;
+
+				if (NULL == connection->sock) {
+					continue;
+				}
+				rc = echo_pump(OMRPORTLIB, connection, pattern);
+				if (rc < 0) {
+					outputErrorMessage(PORTTEST_ERROR_ARGS, "echo %s connection failed after %llu bytes\n", connection->isClient ? "client" : "server", connection->isClient ? connection->received : 0);
+					failed = TRUE;
+				} else if (rc > 0) {
+					/* the server side follows its client's close */
+					if (connection->isClient) {
+						clientsDone += 1;
+					}
+					omrsock_poll_ctl(pollSet, OMRSOCK_POLL_REMOVE, connection->sock, 0, NULL);
+					omrsock_close(&connection->sock);
+				}
+			}
+		}
+	}
+	elapsed = omrtime_nano_time() - start;
+
+	if (!failed && (ECHO_CONNECTIONS == clientsDone)) {
+		double megabytes = (double)ECHO_CONNECTIONS * ECHO_BYTES_PER_CONNECTION / (1024 * 1024);
+		portTestEnv->log("echoed %.0f MB over %d loopback connections in %lld ms: %.1f MB/s\n",
+			megabytes, ECHO_CONNECTIONS, elapsed / 1000000, megabytes * 1000000000 / (double)OMR_MAX(elapsed, 1));
+	}
+
+exit:
+	for (i = 0; i < connectionCount; i++) {
+		if (NULL != connections[i].sock) {
+			omrsock_close(&connections[i].sock);
+		}
+		omrmem_free_memory(connections[i].buffer);
+	}
+	if (NULL != pollSet) {
+		omrsock_poll_destroy(pollSet);
+	}
+	if (NULL != serverSocket) {
+		omrsock_close(&serverSocket);
+	}
+	omrmem_free_memory(pattern);
+	reportTestExit(OMRPORTLIB, testName);
 }
 
 #endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
@@ -42,11 +42,13 @@
 #include <windows.h>
 #endif /* defined(OMR_OS_WINDOWS) */
 
+#include "AtomicSupport.hpp"
 #include "testHelpers.hpp"
 #include "omrport.h"
 
 
 static int J9THREAD_PROC nanoTimeDirectionTest(void *portLibrary);
+static int J9THREAD_PROC nanoTimeMonotonicTest(void *arg);
 
 /**
  * @internal
@@ -760,3 +762,191 @@ TEST(PortTimeTest, time_test_hires_delta_rounding)
 exit:
 	reportTestExit(OMRPORTLIB, testName);
 }
+
+/**
+ * Verify the cycle clock agrees with omrtime_nano_time.
+ *
+ * Functions verified by this test:
+ * @arg @ref omrtime.c::omrtime_cycle_clock "omrtime_cycle_clock()"
+ * @arg @ref omrtime.c::omrtime_cycle_frequency "omrtime_cycle_frequency()"
+ * @arg @ref omrtime.c::omrtime_cycles_to_nanos "omrtime_cycles_to_nanos()"
+ */
+TEST(PortTimeTest, time_test_cycle_clock)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrtime_test_cycle_clock";
+	const int64_t intervalNanos = 100 * 1000 * 1000;
+	const uintptr_t timedCalls = 1000000;
+	uint64_t frequency = omrtime_cycle_frequency();
+	uint64_t startCycles = 0;
+	uint64_t endCycles = 0;
+	int64_t startNanos = 0;
+	int64_t endNanos = 0;
+	uint64_t cycleNanos = 0;
+	double error = 0.0;
+	uintptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (0 == frequency) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_cycle_frequency returned 0\n");
+		goto exit;
+	}
+	error = omrtime_test_compute_error_pct((double)J9CONST_I64(1000000000), (double)omrtime_cycles_to_nanos(frequency));
+	if (error > 0.01) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_cycles_to_nanos(%llu) is %llu, not one second\n", frequency, omrtime_cycles_to_nanos(frequency));
+	}
+
+	/* Spin rather than sleep so that the two clocks are read close together at both ends */
+	startCycles = omrtime_cycle_clock();
+	startNanos = omrtime_nano_time();
+	do {
+		endNanos = omrtime_nano_time();
+		endCycles = omrtime_cycle_clock();
+		if (endCycles < startCycles) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_cycle_clock went backwards from %llu to %llu\n", startCycles, endCycles);
+			goto exit;
+		}
+	} while ((endNanos - startNanos) < intervalNanos);
+
+	cycleNanos = omrtime_cycles_to_nanos(endCycles - startCycles);
+	error = omrtime_test_compute_error_pct((double)(endNanos - startNanos), (double)cycleNanos);
+	portTestEnv->log("frequency: %llu Hz    nano_time interval: %lld ns    cycle clock interval: %llu ns    error: %lf\n",
+		frequency, endNanos - startNanos, cycleNanos, error);
+	if (error > 0.02) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "cycle clock and omrtime_nano_time disagree by more than 2%%\n");
+	}
+
+	startNanos = omrtime_nano_time();
+	for (i = 0; i < timedCalls; i++) {
+		omrtime_nano_time();
+	}
+	endNanos = omrtime_nano_time();
+	portTestEnv->log("omrtime_nano_time: %.1lf ns per call\n", (double)(endNanos - startNanos) / (double)timedCalls);
+	startNanos = omrtime_nano_time();
+	for (i = 0; i < timedCalls; i++) {
+		omrtime_cycle_clock();
+	}
+	endNanos = omrtime_nano_time();
+	portTestEnv->log("omrtime_cycle_clock: %.1lf ns per call\n", (double)(endNanos - startNanos) / (double)timedCalls);
+
+exit:
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+#define J9TIME_TEST_MONOTONIC_DURATION_NANOS J9CONST_I64(2500000000) /* long enough to cross several clock resyncs */
+
+typedef struct J9TimeTestMonotonicStruct {
+	struct OMRPortLibrary *portLibrary;
+	omrthread_monitor_t monitor;
+	volatile uint64_t latest;
+	uintptr_t numThreads;
+	uintptr_t finishedCount;
+	uintptr_t failures;
+	uint64_t calls;
+} J9TimeTestMonotonicStruct;
+
+/**
+ * Check that omrtime_nano_time never returns less than a value another thread has already seen.
+ * Each thread publishes the latest time it read, and every read must be at least the latest
+ * time published before it was taken.
+ */
+TEST(PortTimeTest, time_nano_time_monotonic_across_threads)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	omrthread_t self;
+	const char *testName = "omrtime_nano_time_monotonic_across_threads";
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (0 == omrthread_attach_ex(&self, J9THREAD_ATTR_DEFAULT)) {
+		J9TimeTestMonotonicStruct tms;
+		memset(&tms, 0, sizeof(tms));
+		tms.portLibrary = OMRPORTLIB;
+		tms.latest = (uint64_t)omrtime_nano_time();
+		tms.numThreads = omrsysinfo_get_number_CPUs_by_type(OMRPORT_CPU_ONLINE) * 2;
+		if (tms.numThreads < 4) {
+			tms.numThreads = 4;
+		}
+
+		if (0 == omrthread_monitor_init(&tms.monitor, 0)) {
+			uintptr_t i = 0;
+			intptr_t waitRetVal = 0;
+
+			omrthread_monitor_enter(tms.monitor);
+			for (i = 0; i < tms.numThreads; i++) {
+				omrthread_t thread = NULL;
+				intptr_t rc = omrthread_create(&thread, 128 * 1024, J9THREAD_PRIORITY_NORMAL, 0, &nanoTimeMonotonicTest, &tms);
+				if (0 != rc) {
+					outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to create thread, rc=%zd, i=%zu", rc, i);
+					tms.numThreads = i;
+					break;
+				}
+			}
+			while ((0 == waitRetVal) && (tms.finishedCount < tms.numThreads)) {
+				waitRetVal = omrthread_monitor_wait_timed(tms.monitor, J9TIME_TEST_DIRECTION_TIMEOUT_MILLIS, 0);
+			}
+			if (0 != waitRetVal) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "omrthread_monitor_wait_timed() failed, waitRetVal=%zd", waitRetVal);
+			}
+			portTestEnv->log("%zu threads made %llu calls, %zu went backwards\n", tms.numThreads, tms.calls, tms.failures);
+			if (0 != tms.failures) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_nano_time() went backwards across threads %zu times", tms.failures);
+			}
+			omrthread_monitor_exit(tms.monitor);
+			omrthread_monitor_destroy(tms.monitor);
+		} else {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to initialize tms.monitor");
+		}
+
+		omrthread_detach(self);
+	} else {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Failed to attach to thread library");
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+static int
+J9THREAD_PROC nanoTimeMonotonicTest(void *arg)
+{
+	J9TimeTestMonotonicStruct *tms = (J9TimeTestMonotonicStruct *)arg;
+	OMRPORT_ACCESS_FROM_OMRPORT(tms->portLibrary);
+	int64_t start = omrtime_nano_time();
+	int64_t now = start;
+	uint64_t calls = 0;
+	uintptr_t failures = 0;
+
+	while ((now - start) < J9TIME_TEST_MONOTONIC_DURATION_NANOS) {
+		uint64_t seen = tms->latest;
+
+		VM_AtomicSupport::readBarrier();
+		now = omrtime_nano_time();
+		calls += 1;
+		if ((uint64_t)now < seen) {
+			if (0 == failures) {
+				portTestEnv->log(LEVEL_ERROR, "\tomrtime_nano_time() returned %lld after another thread saw %llu\n", now, seen);
+			}
+			failures += 1;
+		} else {
+			while ((uint64_t)now > seen) {
+				uint64_t witnessed = VM_AtomicSupport::lockCompareExchangeU64(&tms->latest, seen, (uint64_t)now);
+				if (witnessed == seen) {
+					break;
+				}
+				seen = witnessed;
+			}
+		}
+	}
+
+	omrthread_monitor_enter(tms->monitor);
+	tms->calls += calls;
+	tms->failures += failures;
+	tms->finishedCount += 1;
+	if (tms->numThreads == tms->finishedCount) {
+		omrthread_monitor_notify(tms->monitor);
+	}
+	omrthread_monitor_exit(tms->monitor);
+
+	return 0;
+}
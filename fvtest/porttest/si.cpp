@@ -2303,6 +2303,152 @@ exit:
 	return;
 }
 
+/**
+ * Test omrsysinfo_get_cpu_list.
+ */
+TEST(PortSysinfoTest, sysinfo_get_cpu_list)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsysinfo_get_cpu_list";
+	uintptr_t cpuCount = 0;
+	uint32_t *cpuList = NULL;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	/* size the list, then fetch it with the cpuset subsystem enabled */
+	omrsysinfo_cgroup_enable_subsystems(OMR_CGROUP_SUBSYSTEM_CPUSET);
+	rc = omrsysinfo_get_cpu_list(NULL, &cpuCount);
+	if (OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED == rc) {
+		portTestEnv->log("omrsysinfo_get_cpu_list is not supported on this platform\n");
+	} else if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cpu_list failed with error code %d\n", rc);
+	} else if (0 == cpuCount) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cpu_list returned no CPUs\n");
+	} else {
+		uintptr_t listedCount = cpuCount;
+		uintptr_t configured = omrsysinfo_get_number_CPUs_by_type(OMRPORT_CPU_PHYSICAL);
+
+		cpuList = (uint32_t *)omrmem_allocate_memory(sizeof(uint32_t) * cpuCount, OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == cpuList) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to allocate the CPU list\n");
+			goto exit;
+		}
+		rc = omrsysinfo_get_cpu_list(cpuList, &listedCount);
+		if ((0 != rc) || (listedCount != cpuCount)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cpu_list returned %d with %zu CPUs, expected 0 with %zu CPUs\n", rc, (size_t)listedCount, (size_t)cpuCount);
+		} else {
+			uintptr_t i = 0;
+			portTestEnv->log("omrsysinfo_get_cpu_list: %zu usable CPUs of %zu\n", (size_t)cpuCount, (size_t)configured);
+			if ((0 != configured) && (cpuCount > configured)) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cpu_list listed %zu CPUs, more than the %zu physical CPUs\n", (size_t)cpuCount, (size_t)configured);
+			}
+			for (i = 1; i < cpuCount; i++) {
+				if (cpuList[i] <= cpuList[i - 1]) {
+					outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cpu_list IDs are not ascending at index %zu\n", (size_t)i);
+					break;
+				}
+			}
+		}
+		omrmem_free_memory(cpuList);
+	}
+
+exit:
+	reportTestExit(OMRPORTLIB, testName);
+	return;
+}
+
+/**
+ * Test omrsysinfo_get_cpu_topology and omrsysinfo_destroy_cpu_topology.
+ */
+TEST(PortSysinfoTest, sysinfo_get_cpu_topology)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsysinfo_get_cpu_topology";
+	OMRCPUTopology topology;
+	uintptr_t cpuListCount = 0;
+	int32_t rc = 0;
+	int32_t cpu = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	rc = omrsysinfo_get_cpu_topology(NULL);
+	if (OMRPORT_ERROR_SYSINFO_NULL_OBJECT_RECEIVED != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cpu_topology(NULL) returned %d\n", rc);
+	}
+
+	rc = omrsysinfo_get_cpu_topology(&topology);
+	if (OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED == rc) {
+		portTestEnv->log("omrsysinfo_get_cpu_topology is not supported on this platform\n");
+		goto exit;
+	} else if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cpu_topology failed with error code %d\n", rc);
+		goto exit;
+	}
+
+	portTestEnv->log("omrsysinfo_get_cpu_topology: %d CPUs, %d bound on %d cores, %d packages, %d nodes\n",
+		topology.cpuCount, topology.boundCount, topology.coreCount, topology.packageCount, topology.nodeCount);
+	if ((0 >= topology.boundCount) || (topology.boundCount > topology.cpuCount)
+		|| (0 >= topology.coreCount) || (topology.coreCount > topology.boundCount)
+		|| (topology.packageCount > topology.coreCount) || (topology.nodeCount > topology.boundCount)
+	) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "inconsistent topology counts\n");
+	}
+	if ((0 == omrsysinfo_get_cpu_list(NULL, &cpuListCount)) && ((uintptr_t)topology.boundCount != cpuListCount)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "%d bound CPUs, but omrsysinfo_get_cpu_list lists %zu\n", topology.boundCount, (size_t)cpuListCount);
+	}
+
+	for (cpu = 0; cpu < topology.cpuCount; cpu++) {
+		OMRCPUTopologyEntry *entry = &topology.cpus[cpu];
+		intptr_t slot = 0;
+
+		if (entry->cpu != cpu) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "entry %d describes CPU %d\n", cpu, entry->cpu);
+			break;
+		}
+		if (entry->bound && (OMRPORT_PROCINFO_PROC_ONLINE != entry->online)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "CPU %d is bound but not online\n", cpu);
+		}
+		if ((entry->core < 0) || (entry->core > cpu) || (topology.cpus[entry->core].core != entry->core)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "CPU %d has invalid core %d\n", cpu, entry->core);
+		}
+		if (OMRPORT_PROCINFO_PROC_ONLINE != entry->online) {
+			continue;
+		}
+		for (slot = 0; slot < OMRPORT_CACHE_SLOTS; slot++) {
+			OMRCacheInfo *cache = &entry->caches[slot];
+
+			if (0 == cache->size) {
+				continue;
+			}
+			if ((0 != cache->lineSize) && (0 != (cache->lineSize & (cache->lineSize - 1)))) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "CPU %d cache %d has line size %u\n", cpu, (int)slot, cache->lineSize);
+			}
+			if ((cache->id < 0) || (cache->sharingCount < 1)) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "CPU %d cache %d has id %d shared by %d CPUs\n", cpu, (int)slot, cache->id, cache->sharingCount);
+			} else if ((cache->id < topology.cpuCount) && (topology.cpus[cache->id].caches[slot].size != cache->size)) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "CPU %d cache %d differs in size from the one of CPU %d sharing it\n", cpu, (int)slot, cache->id);
+			}
+			if (0 == cpu) {
+				portTestEnv->log("CPU 0 cache %d: %llu bytes, %u byte lines, %u ways, shared by %d CPUs\n",
+					(int)slot, (unsigned long long)cache->size, cache->lineSize, cache->associativity, cache->sharingCount);
+			}
+		}
+		if ((0 != entry->caches[OMRPORT_CACHE_L2].size) && (entry->caches[OMRPORT_CACHE_L2].size < entry->caches[OMRPORT_CACHE_L1D].size)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "CPU %d has an L2 cache smaller than its L1 data cache\n", cpu);
+		}
+	}
+
+	omrsysinfo_destroy_cpu_topology(&topology);
+	if (NULL != topology.cpus) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_destroy_cpu_topology did not clear the array\n");
+	}
+
+exit:
+	reportTestExit(OMRPORTLIB, testName);
+	return;
+}
+
 /**
  * Test omrsysinfo_cgroup_get_memlimit.
  */
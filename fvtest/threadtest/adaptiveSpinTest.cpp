@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "threadTestLib.hpp"
+
+#include "omrTest.h"
+#include "testHelper.hpp"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+extern ThreadTestEnvironment *omrTestEnv;
+
+#if defined(OMR_THR_THREE_TIER_LOCKING) && defined(OMR_THR_ADAPTIVE_SPIN) && defined(OMR_THR_JLM)
+
+#define LONG_HOLD_ROUNDS 16
+#define LONG_HOLD_MILLIS 10
+
+/*
+ * A monitor whose holder sleeps while another thread contends for it should stop
+ * spinning and block straight away, and report its decisions in its JLM tracing data.
+ */
+class AdaptiveSpinTest: public ::testing::Test {
+public:
+	static omrthread_monitor_t monitor;
+	static volatile uintptr_t round;
+	static volatile uintptr_t completed;
+
+	static int J9THREAD_PROC contender(void *arg);
+
+protected:
+	static uintptr_t *
+	adaptSpinBudget(void)
+	{
+		return (uintptr_t *)*omrthread_global((char *)"adaptSpinBudget");
+	}
+
+	virtual void
+	SetUp(void)
+	{
+		ASSERT_EQ(0, omrthread_jlm_init(J9THREAD_LIB_FLAG_JLM_ENABLED));
+		ASSERT_EQ(0, omrthread_monitor_init_with_name(&monitor, 0, "adaptive spin test"));
+		ASSERT_TRUE(NULL != omrthread_monitor_get_tracing(monitor));
+		round = 0;
+		completed = 0;
+	}
+
+	virtual void
+	TearDown(void)
+	{
+		omrthread_monitor_destroy(monitor);
+		omrthread_jlm_init(0);
+	}
+
+	/* Hold the monitor across a sleep each round while the contender tries to enter it */
+	static void
+	runLongHolds(void)
+	{
+		omrthread_t thread = NULL;
+		uintptr_t i = 0;
+
+		createJoinableThread(&thread, contender, NULL);
+		for (i = 1; i <= LONG_HOLD_ROUNDS; i++) {
+			omrthread_monitor_enter(monitor);
+			round = i;
+			omrthread_sleep(LONG_HOLD_MILLIS);
+			omrthread_monitor_exit(monitor);
+			while (completed < i) {
+				omrthread_yield();
+			}
+		}
+		VERBOSE_JOIN(thread, 0);
+	}
+};
+
+omrthread_monitor_t AdaptiveSpinTest::monitor = NULL;
+volatile uintptr_t AdaptiveSpinTest::round = 0;
+volatile uintptr_t AdaptiveSpinTest::completed = 0;
+
+int J9THREAD_PROC
+AdaptiveSpinTest::contender(void *arg)
+{
+	uintptr_t i = 0;
+
+	for (i = 1; i <= LONG_HOLD_ROUNDS; i++) {
+		while (round < i) {
+			omrthread_yield();
+		}
+		omrthread_monitor_enter(monitor);
+		omrthread_monitor_exit(monitor);
+		completed = i;
+	}
+	return 0;
+}
+
+TEST_F(AdaptiveSpinTest, UncontendedEntersDoNotAdapt)
+{
+	J9ThreadMonitor *mon = (J9ThreadMonitor *)monitor;
+	J9ThreadMonitorTracing *tracing = omrthread_monitor_get_tracing(monitor);
+	uintptr_t i = 0;
+
+	for (i = 0; i < 1000; i++) {
+		omrthread_monitor_enter(monitor);
+		omrthread_monitor_exit(monitor);
+	}
+
+	ASSERT_EQ(UDATA_MAX, mon->spinBudget);
+	ASSERT_EQ((uintptr_t)0, tracing->spin_acquire_count + tracing->spin_fail_count + tracing->spin_skip_count);
+}
+
+TEST_F(AdaptiveSpinTest, LongHoldsStopSpinning)
+{
+	J9ThreadMonitor *mon = (J9ThreadMonitor *)monitor;
+	J9ThreadMonitorTracing *tracing = omrthread_monitor_get_tracing(monitor);
+
+	ASSERT_NE((uintptr_t)0, *adaptSpinBudget());
+	runLongHolds();
+
+	omrTestEnv->log(LEVEL_INFO, "spin acquired %zu, spun out %zu, skipped %zu, budget %zu, success %zu%%\n",
+			tracing->spin_acquire_count, tracing->spin_fail_count, tracing->spin_skip_count,
+			tracing->spin_budget, tracing->spin_success_percent);
+
+	/* Halving from the full budget falls below one round of spinning within the rounds run,
+	 * and no probe is due before they end.
+	 */
+	ASSERT_LT(LONG_HOLD_ROUNDS, OMRTHREAD_ADAPT_SPIN_PROBE_INTERVAL);
+	ASSERT_EQ((uintptr_t)0, mon->spinBudget);
+	ASSERT_EQ((uintptr_t)0, tracing->spin_budget);
+	ASSERT_NE((uintptr_t)0, tracing->spin_fail_count);
+	ASSERT_NE((uintptr_t)0, tracing->spin_skip_count);
+	ASSERT_LT(tracing->spin_success_percent, (uintptr_t)100);
+}
+
+TEST_F(AdaptiveSpinTest, StaticSpinWhenDisabled)
+{
+	J9ThreadMonitor *mon = (J9ThreadMonitor *)monitor;
+	J9ThreadMonitorTracing *tracing = omrthread_monitor_get_tracing(monitor);
+	uintptr_t *enabled = adaptSpinBudget();
+	uintptr_t saved = *enabled;
+
+	*enabled = 0;
+	runLongHolds();
+	*enabled = saved;
+
+	ASSERT_EQ(UDATA_MAX, mon->spinBudget);
+	ASSERT_EQ((uintptr_t)0, tracing->spin_skip_count);
+}
+
+#endif /* defined(OMR_THR_THREE_TIER_LOCKING) && defined(OMR_THR_ADAPTIVE_SPIN) && defined(OMR_THR_JLM) */
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#if defined(LINUX)
+#include <ucontext.h>
+#endif /* defined(LINUX) */
+
+#include "omrport.h"
+#include "threadTestLib.hpp"
+
+#include "omrTest.h"
+#include "testHelper.hpp"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+extern ThreadTestEnvironment *omrTestEnv;
+
+#define CONTENDED_ROUNDS 4
+#define CONTENDED_HOLD_MILLIS 20
+#define TIMED_WAITS 3
+#define TIMED_WAIT_MILLIS 10
+#define MAX_PROFILE_RECORDS 16
+
+/*
+ * Block repeatedly on a monitor that another thread holds across a sleep, and check
+ * that the contention profiler attributes the blocked time and a call site to it.
+ */
+class ContentionProfileTest: public ::testing::Test {
+public:
+	static omrthread_monitor_t monitor;
+	static volatile uintptr_t held;
+	static volatile uintptr_t samples;
+
+	static int J9THREAD_PROC holder(void *arg);
+
+	/* Sample the call site with omrintrospect, as a VM with a port library would */
+	static uintptr_t
+	sampler(void *userData, void **frames, uintptr_t maxFrames)
+	{
+		uintptr_t count = 0;
+		samples += 1;
+#if defined(LINUX)
+		OMRPORT_ACCESS_FROM_OMRPORT((OMRPortLibrary *)userData);
+		J9PlatformThread threadInfo;
+		J9PlatformStackFrame *frame = NULL;
+		ucontext_t context;
+
+		memset(&threadInfo, 0, sizeof(threadInfo));
+		getcontext(&context);
+		threadInfo.context = &context;
+		omrintrospect_backtrace_thread(&threadInfo, NULL, NULL);
+		frame = threadInfo.callstack;
+		while (NULL != frame) {
+			J9PlatformStackFrame *parent = frame->parent_frame;
+			if (count < maxFrames) {
+				frames[count] = (void *)frame->instruction_pointer;
+				count += 1;
+			}
+			omrmem_free_memory(frame);
+			frame = parent;
+		}
+#else /* defined(LINUX) */
+		frames[0] = (void *)&sampler;
+		count = 1;
+#endif /* defined(LINUX) */
+		return count;
+	}
+
+protected:
+	virtual void
+	SetUp(void)
+	{
+		ASSERT_EQ(0, omrthread_monitor_init_with_name(&monitor, 0, "contention profile test"));
+		held = 0;
+		samples = 0;
+	}
+
+	virtual void
+	TearDown(void)
+	{
+		omrthread_contention_profile_disable();
+		omrthread_monitor_destroy(monitor);
+	}
+
+	/* Have another thread hold the monitor across a sleep while this thread enters it */
+	static void
+	contend(void)
+	{
+		omrthread_t thread = NULL;
+		uintptr_t i = 0;
+
+		for (i = 0; i < CONTENDED_ROUNDS; i++) {
+			held = 0;
+			createJoinableThread(&thread, holder, NULL);
+			while (0 == held) {
+				omrthread_yield();
+			}
+			omrthread_monitor_enter(monitor);
+			omrthread_monitor_exit(monitor);
+			VERBOSE_JOIN(thread, 0);
+		}
+	}
+
+	static J9ThreadMonitorContentionInfo *
+	findMonitor(J9ThreadMonitorContentionInfo *records, uintptr_t count)
+	{
+		uintptr_t i = 0;
+
+		for (i = 0; i < count; i++) {
+			if (monitor == records[i].monitor) {
+				return &records[i];
+			}
+		}
+		return NULL;
+	}
+};
+
+omrthread_monitor_t ContentionProfileTest::monitor = NULL;
+volatile uintptr_t ContentionProfileTest::held = 0;
+volatile uintptr_t ContentionProfileTest::samples = 0;
+
+int J9THREAD_PROC
+ContentionProfileTest::holder(void *arg)
+{
+	omrthread_monitor_enter(monitor);
+	held = 1;
+	omrthread_sleep(CONTENDED_HOLD_MILLIS);
+	omrthread_monitor_exit(monitor);
+	return 0;
+}
+
+TEST_F(ContentionProfileTest, BlockedEntersAreProfiled)
+{
+	J9ThreadMonitorContentionInfo records[MAX_PROFILE_RECORDS];
+	J9ThreadMonitorContentionInfo *info = NULL;
+	uintptr_t count = 0;
+	uintptr_t histogramTotal = 0;
+	uintptr_t i = 0;
+
+	ASSERT_EQ(0, omrthread_contention_profile_enable(1, sampler, omrTestEnv->getPortLibrary()));
+	contend();
+
+	count = omrthread_contention_profile_dump(records, MAX_PROFILE_RECORDS);
+	info = findMonitor(records, count);
+	ASSERT_TRUE(NULL != info);
+	ASSERT_STREQ("contention profile test", info->name);
+
+	omrTestEnv->log(LEVEL_INFO, "blocked %zu times for %llu total, %llu max, %zu call site frames\n",
+			info->contention.blockedEnterCount, (unsigned long long)info->contention.blockedEnterTime,
+			(unsigned long long)info->contention.maxBlockedEnterTime, info->contention.callSiteFrameCount);
+
+	ASSERT_EQ((uintptr_t)CONTENDED_ROUNDS, info->contention.blockedEnterCount);
+	for (i = 0; i < J9THREAD_CONTENTION_HISTOGRAM_BUCKETS; i++) {
+		histogramTotal += info->contention.blockedEnterHistogram[i];
+	}
+	ASSERT_EQ(info->contention.blockedEnterCount, histogramTotal);
+	ASSERT_GE(info->contention.blockedEnterTime, info->contention.maxBlockedEnterTime);
+	ASSERT_EQ((uintptr_t)CONTENDED_ROUNDS, samples);
+	ASSERT_NE((uintptr_t)0, info->contention.callSiteFrameCount);
+	ASSERT_LE(info->contention.callSiteFrameCount, (uintptr_t)J9THREAD_CONTENTION_CALLSITE_FRAMES);
+
+	/* Records are returned most contended first */
+	for (i = 1; i < count; i++) {
+		ASSERT_GE(records[i - 1].contention.blockedEnterTime, records[i].contention.blockedEnterTime);
+	}
+}
+
+TEST_F(ContentionProfileTest, WaitsAreProfiled)
+{
+	J9ThreadMonitorContention *record = NULL;
+	uintptr_t i = 0;
+
+	ASSERT_EQ(0, omrthread_contention_profile_enable(0, NULL, NULL));
+	omrthread_monitor_enter(monitor);
+	for (i = 0; i < TIMED_WAITS; i++) {
+		ASSERT_EQ(J9THREAD_TIMED_OUT, omrthread_monitor_wait_timed(monitor, TIMED_WAIT_MILLIS, 0));
+	}
+	omrthread_monitor_exit(monitor);
+
+	record = ((J9ThreadMonitor *)monitor)->contention;
+	ASSERT_TRUE(NULL != record);
+	ASSERT_EQ((uintptr_t)TIMED_WAITS, record->waitCount);
+	ASSERT_EQ((uintptr_t)0, record->blockedEnterCount);
+	/* Waits for notification are not contention, so the monitor is not reported as contended */
+	ASSERT_EQ((uintptr_t)0, record->callSiteFrameCount);
+}
+
+TEST_F(ContentionProfileTest, NothingRecordedWhenDisabled)
+{
+	J9ThreadMonitorContentionInfo records[MAX_PROFILE_RECORDS];
+	uintptr_t count = 0;
+
+	ASSERT_EQ(0, omrthread_contention_profile_enable(1, sampler, omrTestEnv->getPortLibrary()));
+	omrthread_contention_profile_disable();
+	contend();
+
+	count = omrthread_contention_profile_dump(records, MAX_PROFILE_RECORDS);
+	ASSERT_TRUE(NULL == findMonitor(records, count));
+	ASSERT_EQ((uintptr_t)0, samples);
+}
+
+TEST_F(ContentionProfileTest, ResetDiscardsRecords)
+{
+	J9ThreadMonitorContentionInfo records[MAX_PROFILE_RECORDS];
+	uintptr_t count = 0;
+
+	ASSERT_EQ(0, omrthread_contention_profile_enable(0, NULL, NULL));
+	contend();
+	omrthread_contention_profile_reset();
+
+	count = omrthread_contention_profile_dump(records, MAX_PROFILE_RECORDS);
+	ASSERT_TRUE(NULL == findMonitor(records, count));
+}
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#if defined(LINUX)
+#include <ucontext.h>
+#endif /* defined(LINUX) */
+
+#include <string.h>
+
+#include "omrport.h"
+#include "omrTest.h"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+extern ThreadTestEnvironment *omrTestEnv;
+
+#define MAX_EXPORTED_EDGES 256
+
+/*
+ * Enter named monitors in conflicting orders on one thread, so no real deadlock can
+ * happen, and check that the tracker reports each latent inversion once.
+ */
+class LockOrderTest: public ::testing::Test {
+public:
+	static uintptr_t reports;
+	static J9ThreadLockOrderInversion lastReport;
+
+	/* Capture call stacks with omrintrospect, as a VM with a port library would */
+	static uintptr_t
+	sampler(void *userData, void **frames, uintptr_t maxFrames)
+	{
+		uintptr_t count = 0;
+#if defined(LINUX)
+		OMRPORT_ACCESS_FROM_OMRPORT((OMRPortLibrary *)userData);
+		J9PlatformThread threadInfo;
+		J9PlatformStackFrame *frame = NULL;
+		ucontext_t context;
+
+		memset(&threadInfo, 0, sizeof(threadInfo));
+		getcontext(&context);
+		threadInfo.context = &context;
+		omrintrospect_backtrace_thread(&threadInfo, NULL, NULL);
+		frame = threadInfo.callstack;
+		while (NULL != frame) {
+			J9PlatformStackFrame *parent = frame->parent_frame;
+			if (count < maxFrames) {
+				frames[count] = (void *)frame->instruction_pointer;
+				count += 1;
+			}
+			omrmem_free_memory(frame);
+			frame = parent;
+		}
+#else /* defined(LINUX) */
+		frames[0] = (void *)&sampler;
+		count = 1;
+#endif /* defined(LINUX) */
+		return count;
+	}
+
+	static void
+	report(void *userData, const J9ThreadLockOrderInversion *inversion)
+	{
+		reports += 1;
+		lastReport = *inversion;
+		omrTestEnv->log(LEVEL_INFO, "lock order inversion: entering \"%s\" holding \"%s\", but \"%s\" was entered holding \"%s\" (%zu frames)\n",
+				inversion->enteringName, inversion->heldName,
+				inversion->conflictEnteredName, inversion->conflictHeldName, (size_t)inversion->conflictFrameCount);
+	}
+
+	static void
+	nest(omrthread_monitor_t outer, omrthread_monitor_t inner)
+	{
+		ASSERT_EQ(0, omrthread_monitor_enter(outer));
+		ASSERT_EQ(0, omrthread_monitor_enter(inner));
+		ASSERT_EQ(0, omrthread_monitor_exit(inner));
+		ASSERT_EQ(0, omrthread_monitor_exit(outer));
+	}
+
+	static BOOLEAN
+	hasEdge(const char *heldName, const char *enteredName, uintptr_t *inverted)
+	{
+		J9ThreadLockOrderEdge edges[MAX_EXPORTED_EDGES];
+		uintptr_t count = OMR_MIN(omrthread_lock_order_export(edges, MAX_EXPORTED_EDGES), MAX_EXPORTED_EDGES);
+
+		for (uintptr_t i = 0; i < count; i++) {
+			if ((0 == strcmp(heldName, edges[i].heldName)) && (0 == strcmp(enteredName, edges[i].enteredName))) {
+				*inverted = edges[i].inverted;
+				return TRUE;
+			}
+		}
+		return FALSE;
+	}
+
+protected:
+	virtual void
+	SetUp(void)
+	{
+		reports = 0;
+		memset(&lastReport, 0, sizeof(lastReport));
+		ASSERT_EQ(0, omrthread_lock_order_enable(sampler, report, omrTestEnv->getPortLibrary()));
+	}
+
+	virtual void
+	TearDown(void)
+	{
+		omrthread_lock_order_disable();
+	}
+};
+
+uintptr_t LockOrderTest::reports = 0;
+J9ThreadLockOrderInversion LockOrderTest::lastReport;
+
+TEST_F(LockOrderTest, directInversion)
+{
+	omrthread_monitor_t first = NULL;
+	omrthread_monitor_t second = NULL;
+	uintptr_t inverted = 0;
+
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&first, 0, "lock order direct first"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&second, 0, "lock order direct second"));
+
+	nest(first, second);
+	ASSERT_EQ((uintptr_t)0, reports);
+	nest(second, first);
+	ASSERT_EQ((uintptr_t)1, reports);
+	ASSERT_STREQ("lock order direct second", lastReport.heldName);
+	ASSERT_STREQ("lock order direct first", lastReport.enteringName);
+	ASSERT_STREQ("lock order direct first", lastReport.conflictHeldName);
+	ASSERT_STREQ("lock order direct second", lastReport.conflictEnteredName);
+	ASSERT_EQ(omrthread_self(), lastReport.thread);
+	ASSERT_LT((uintptr_t)0, lastReport.conflictFrameCount);
+	ASSERT_LT((uintptr_t)0, lastReport.frameCount);
+
+	/* each inversion is reported once */
+	nest(second, first);
+	ASSERT_EQ((uintptr_t)1, reports);
+
+	ASSERT_TRUE(hasEdge("lock order direct first", "lock order direct second", &inverted));
+	ASSERT_EQ((uintptr_t)0, inverted);
+	ASSERT_TRUE(hasEdge("lock order direct second", "lock order direct first", &inverted));
+	ASSERT_NE((uintptr_t)0, inverted);
+
+	ASSERT_EQ(0, omrthread_monitor_destroy(first));
+	ASSERT_EQ(0, omrthread_monitor_destroy(second));
+}
+
+TEST_F(LockOrderTest, transitiveInversion)
+{
+	omrthread_monitor_t a = NULL;
+	omrthread_monitor_t b = NULL;
+	omrthread_monitor_t c = NULL;
+
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&a, 0, "lock order transitive a"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&b, 0, "lock order transitive b"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&c, 0, "lock order transitive c"));
+
+	nest(a, b);
+	nest(b, c);
+	ASSERT_EQ((uintptr_t)0, reports);
+	nest(c, a);
+	ASSERT_EQ((uintptr_t)1, reports);
+	ASSERT_STREQ("lock order transitive c", lastReport.heldName);
+	ASSERT_STREQ("lock order transitive a", lastReport.enteringName);
+	ASSERT_STREQ("lock order transitive a", lastReport.conflictHeldName);
+	ASSERT_STREQ("lock order transitive b", lastReport.conflictEnteredName);
+
+	ASSERT_EQ(0, omrthread_monitor_destroy(a));
+	ASSERT_EQ(0, omrthread_monitor_destroy(b));
+	ASSERT_EQ(0, omrthread_monitor_destroy(c));
+}
+
+TEST_F(LockOrderTest, classesAreNamesNotInstances)
+{
+	omrthread_monitor_t outer = NULL;
+	omrthread_monitor_t inner = NULL;
+	omrthread_monitor_t sameName = NULL;
+	omrthread_monitor_t unnamed = NULL;
+	uintptr_t inverted = 0;
+
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&outer, 0, "lock order class"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&sameName, 0, "lock order class"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&inner, 0, "lock order class inner"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&unnamed, 0, NULL));
+
+	/* nesting two instances of one class adds no edge */
+	nest(outer, sameName);
+	ASSERT_FALSE(hasEdge("lock order class", "lock order class", &inverted));
+
+	/* an order seen through one instance applies to every instance */
+	nest(outer, inner);
+	nest(inner, sameName);
+	ASSERT_EQ((uintptr_t)1, reports);
+
+	/* unnamed monitors are not tracked */
+	nest(inner, unnamed);
+	ASSERT_EQ((uintptr_t)1, reports);
+
+	ASSERT_EQ(0, omrthread_monitor_destroy(outer));
+	ASSERT_EQ(0, omrthread_monitor_destroy(sameName));
+	ASSERT_EQ(0, omrthread_monitor_destroy(inner));
+	ASSERT_EQ(0, omrthread_monitor_destroy(unnamed));
+}
+
+TEST_F(LockOrderTest, tryEnterAddsNoEdge)
+{
+	omrthread_monitor_t first = NULL;
+	omrthread_monitor_t second = NULL;
+	uintptr_t inverted = 0;
+
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&first, 0, "lock order try first"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&second, 0, "lock order try second"));
+
+	ASSERT_EQ(0, omrthread_monitor_enter(first));
+	ASSERT_EQ(0, omrthread_monitor_try_enter(second));
+	ASSERT_EQ(0, omrthread_monitor_exit(second));
+	ASSERT_EQ(0, omrthread_monitor_exit(first));
+	ASSERT_FALSE(hasEdge("lock order try first", "lock order try second", &inverted));
+
+	/* but a monitor owned through a try-enter is ordered before later enters */
+	ASSERT_EQ(0, omrthread_monitor_try_enter(second));
+	ASSERT_EQ(0, omrthread_monitor_enter(first));
+	ASSERT_EQ(0, omrthread_monitor_exit(first));
+	ASSERT_EQ(0, omrthread_monitor_exit(second));
+	ASSERT_TRUE(hasEdge("lock order try second", "lock order try first", &inverted));
+	ASSERT_EQ((uintptr_t)0, reports);
+
+	ASSERT_EQ(0, omrthread_monitor_destroy(first));
+	ASSERT_EQ(0, omrthread_monitor_destroy(second));
+}
+
+TEST_F(LockOrderTest, disabled)
+{
+	omrthread_monitor_t first = NULL;
+	omrthread_monitor_t second = NULL;
+	uintptr_t inverted = 0;
+
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&first, 0, "lock order disabled first"));
+	ASSERT_EQ(0, omrthread_monitor_init_with_name(&second, 0, "lock order disabled second"));
+
+	omrthread_lock_order_disable();
+	nest(first, second);
+	nest(second, first);
+	ASSERT_FALSE(hasEdge("lock order disabled first", "lock order disabled second", &inverted));
+	ASSERT_EQ((uintptr_t)0, reports);
+
+	ASSERT_EQ(0, omrthread_monitor_destroy(first));
+	ASSERT_EQ(0, omrthread_monitor_destroy(second));
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "threadTestLib.hpp"
+
+#include "omrTest.h"
+#include "testHelper.hpp"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+extern ThreadTestEnvironment *omrTestEnv;
+
+#define NOTIFY_WAITERS 8
+
+/*
+ * Exercise monitor wait/notify through whichever OS synchronization backend the
+ * thread library was built with. Notified waiters must reacquire the monitor one
+ * at a time, whether they are woken directly or requeued onto the monitor's mutex.
+ */
+class MonitorNotifyTest: public ::testing::Test {
+public:
+	static omrthread_monitor_t monitor;
+	static volatile uintptr_t waiting;
+	static volatile uintptr_t released;
+	static volatile uintptr_t woken;
+	static volatile uintptr_t inside;
+	static volatile uintptr_t overlapped;
+
+	static int J9THREAD_PROC waiter(void *arg);
+
+protected:
+	omrthread_t threads[NOTIFY_WAITERS];
+
+	virtual void
+	SetUp(void)
+	{
+		ASSERT_EQ(0, omrthread_monitor_init_with_name(&monitor, 0, "monitor notify test"));
+		waiting = 0;
+		released = 0;
+		woken = 0;
+		inside = 0;
+		overlapped = 0;
+	}
+
+	virtual void
+	TearDown(void)
+	{
+		omrthread_monitor_destroy(monitor);
+	}
+
+	void
+	startWaiters(void)
+	{
+		uintptr_t i = 0;
+
+		for (i = 0; i < NOTIFY_WAITERS; i++) {
+			createJoinableThread(&threads[i], waiter, NULL);
+		}
+		omrthread_monitor_enter(monitor);
+		while (NOTIFY_WAITERS != waiting) {
+			omrthread_monitor_exit(monitor);
+			omrthread_yield();
+			omrthread_monitor_enter(monitor);
+		}
+		omrthread_monitor_exit(monitor);
+	}
+
+	void
+	joinWaiters(void)
+	{
+		uintptr_t i = 0;
+
+		for (i = 0; i < NOTIFY_WAITERS; i++) {
+			VERBOSE_JOIN(threads[i], 0);
+		}
+	}
+};
+
+omrthread_monitor_t MonitorNotifyTest::monitor = NULL;
+volatile uintptr_t MonitorNotifyTest::waiting = 0;
+volatile uintptr_t MonitorNotifyTest::released = 0;
+volatile uintptr_t MonitorNotifyTest::woken = 0;
+volatile uintptr_t MonitorNotifyTest::inside = 0;
+volatile uintptr_t MonitorNotifyTest::overlapped = 0;
+
+int J9THREAD_PROC
+MonitorNotifyTest::waiter(void *arg)
+{
+	omrthread_monitor_enter(monitor);
+	waiting += 1;
+	while (0 == released) {
+		omrthread_monitor_wait(monitor);
+	}
+	released -= 1;
+	woken += 1;
+
+	/* Nobody else may be running inside the monitor while we yield in it */
+	inside += 1;
+	omrthread_yield();
+	if (1 != inside) {
+		overlapped += 1;
+	}
+	inside -= 1;
+	omrthread_monitor_exit(monitor);
+	return 0;
+}
+
+TEST_F(MonitorNotifyTest, NotifyAllWakesEveryWaiter)
+{
+	startWaiters();
+
+	omrthread_monitor_enter(monitor);
+	released = NOTIFY_WAITERS;
+	ASSERT_EQ(0, omrthread_monitor_notify_all(monitor));
+	/* Nobody can have run yet: the notified waiters still need the monitor */
+	ASSERT_EQ((uintptr_t)0, woken);
+	omrthread_monitor_exit(monitor);
+
+	joinWaiters();
+	ASSERT_EQ((uintptr_t)NOTIFY_WAITERS, woken);
+	ASSERT_EQ((uintptr_t)0, overlapped);
+}
+
+TEST_F(MonitorNotifyTest, NotifyWakesOneWaiterAtATime)
+{
+	uintptr_t i = 0;
+
+	startWaiters();
+
+	for (i = 1; i <= NOTIFY_WAITERS; i++) {
+		omrthread_monitor_enter(monitor);
+		released += 1;
+		ASSERT_EQ(0, omrthread_monitor_notify(monitor));
+		while (woken < i) {
+			omrthread_monitor_exit(monitor);
+			omrthread_yield();
+			omrthread_monitor_enter(monitor);
+		}
+		ASSERT_EQ(i, woken);
+		omrthread_monitor_exit(monitor);
+	}
+
+	joinWaiters();
+	ASSERT_EQ((uintptr_t)0, overlapped);
+}
+
+TEST_F(MonitorNotifyTest, TimedWaitTimesOut)
+{
+	omrthread_monitor_enter(monitor);
+	ASSERT_EQ(J9THREAD_TIMED_OUT, omrthread_monitor_wait_timed(monitor, 20, 0));
+	/* The monitor must still be owned after the timeout */
+	ASSERT_EQ(0, omrthread_monitor_notify_all(monitor));
+	omrthread_monitor_exit(monitor);
+}
@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "omrTest.h"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+extern ThreadTestEnvironment *omrTestEnv;
+
+#define PLACED_THREADS 8
+
+/*
+ * Threads created with a NUMA placement policy record the node affinity they start
+ * with. Without NUMA (or with a single node) every policy must degrade to no affinity.
+ */
+class NumaPlacementTest: public ::testing::Test {
+public:
+	struct PlacedThread {
+		omrthread_t thread;
+		uintptr_t affinity[4];
+		uintptr_t affinityCount;
+		uintptr_t currentNode;
+	};
+
+	static int J9THREAD_PROC
+	recordPlacement(void *arg)
+	{
+		PlacedThread *placed = (PlacedThread *)arg;
+		placed->affinityCount = sizeof(placed->affinity) / sizeof(placed->affinity[0]);
+		omrthread_numa_get_node_affinity(omrthread_self(), placed->affinity, &placed->affinityCount);
+		placed->currentNode = omrthread_numa_get_thread_node(omrthread_self());
+		return 0;
+	}
+
+	static void
+	createPlaced(PlacedThread *placed, uintptr_t count, omrthread_numa_placement_t placement, omrthread_t colocateWith)
+	{
+		omrthread_attr_t attr = NULL;
+		ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_init(&attr));
+		ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE));
+		ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_numa_placement(&attr, placement, colocateWith));
+		for (uintptr_t i = 0; i < count; i++) {
+			memset(&placed[i], 0, sizeof(placed[i]));
+			ASSERT_EQ(J9THREAD_SUCCESS, omrthread_create_ex(&placed[i].thread, &attr, FALSE, recordPlacement, &placed[i]));
+		}
+		for (uintptr_t i = 0; i < count; i++) {
+			ASSERT_EQ(J9THREAD_SUCCESS, omrthread_join(placed[i].thread));
+		}
+		ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_destroy(&attr));
+	}
+};
+
+TEST_F(NumaPlacementTest, AttrValidatesPlacement)
+{
+	omrthread_attr_t attr = NULL;
+
+	ASSERT_EQ(J9THREAD_ERR_INVALID_ATTR, omrthread_attr_set_numa_placement(NULL, J9THREAD_NUMA_PLACEMENT_NONE, NULL));
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_init(&attr));
+	EXPECT_EQ(J9THREAD_ERR_INVALID_VALUE, omrthread_attr_set_numa_placement(&attr, omrthread_numa_placement_LastEnum, NULL));
+	EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_numa_placement(&attr, J9THREAD_NUMA_PLACEMENT_INTERLEAVE, NULL));
+	EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_numa_placement(&attr, J9THREAD_NUMA_PLACEMENT_FILL_FIRST, NULL));
+	EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_numa_placement(&attr, J9THREAD_NUMA_PLACEMENT_COLOCATE, omrthread_self()));
+	EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_destroy(&attr));
+}
+
+TEST_F(NumaPlacementTest, InterleaveSpreadsAcrossNodes)
+{
+	PlacedThread placed[PLACED_THREADS];
+	uintptr_t maxNode = omrthread_numa_get_max_node();
+	uintptr_t nodesUsed = 0;
+
+	ASSERT_NO_FATAL_FAILURE(createPlaced(placed, PLACED_THREADS, J9THREAD_NUMA_PLACEMENT_INTERLEAVE, NULL));
+	for (uintptr_t i = 0; i < PLACED_THREADS; i++) {
+		uintptr_t node = placed[i].affinity[0];
+		ASSERT_LE(node, maxNode);
+		EXPECT_LE(placed[i].currentNode, maxNode);
+		for (uintptr_t j = 0; j < i; j++) {
+			if (placed[j].affinity[0] == node) {
+				node = 0;
+				break;
+			}
+		}
+		if (0 != node) {
+			nodesUsed += 1;
+		}
+	}
+	omrTestEnv->log(LEVEL_VERBOSE, "%zu threads interleaved over %zu of %zu nodes\n", (size_t)PLACED_THREADS, (size_t)nodesUsed, (size_t)maxNode);
+	if (maxNode > 1) {
+		EXPECT_LT((uintptr_t)1, nodesUsed);
+	} else {
+		EXPECT_EQ((uintptr_t)0, nodesUsed);
+	}
+}
+
+TEST_F(NumaPlacementTest, FillFirstUsesLowestNode)
+{
+	PlacedThread placed[1];
+	uintptr_t maxNode = omrthread_numa_get_max_node();
+
+	ASSERT_NO_FATAL_FAILURE(createPlaced(placed, 1, J9THREAD_NUMA_PLACEMENT_FILL_FIRST, NULL));
+	ASSERT_LE(placed[0].affinity[0], maxNode);
+	if (maxNode > 1) {
+		EXPECT_NE((uintptr_t)0, placed[0].affinity[0]);
+	}
+}
+
+TEST_F(NumaPlacementTest, ColocateFollowsTargetAffinity)
+{
+	PlacedThread placed[2];
+	uintptr_t maxNode = omrthread_numa_get_max_node();
+	uintptr_t node = 1;
+
+	if (maxNode > 1) {
+		ASSERT_EQ(0, omrthread_numa_set_node_affinity(omrthread_self(), &node, 1, 0));
+	}
+	ASSERT_NO_FATAL_FAILURE(createPlaced(placed, 2, J9THREAD_NUMA_PLACEMENT_COLOCATE, NULL));
+	if (maxNode > 1) {
+		ASSERT_EQ(0, omrthread_numa_set_node_affinity(omrthread_self(), NULL, 0, 0));
+		for (uintptr_t i = 0; i < 2; i++) {
+			EXPECT_EQ((uintptr_t)1, placed[i].affinityCount);
+			EXPECT_EQ(node, placed[i].affinity[0]);
+			EXPECT_EQ(node, placed[i].currentNode);
+		}
+	} else {
+		for (uintptr_t i = 0; i < 2; i++) {
+			EXPECT_EQ((uintptr_t)0, placed[i].affinity[0]);
+			EXPECT_EQ((uintptr_t)0, placed[i].currentNode);
+		}
+	}
+}
+
+TEST_F(NumaPlacementTest, CurrentNodeOfSelf)
+{
+	EXPECT_LE(omrthread_numa_get_thread_node(omrthread_self()), omrthread_numa_get_max_node());
+	EXPECT_EQ((uintptr_t)0, omrthread_numa_get_thread_node(NULL));
+}
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include <stdlib.h>
+
+#include "omrTest.h"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+#define WORDLOCK_THREADS 4
+#define WORDLOCK_ITERATIONS 100000
+#define WORDLOCK_FOOTPRINT_LOCKS (1024 * 1024)
+
+typedef struct WordLockCounter {
+	omrthread_wordlock_t lock;
+	uintptr_t count;
+} WordLockCounter;
+
+typedef struct WordLockHandoff {
+	omrthread_wordlock_t lock;
+	uintptr_t produced;
+	uintptr_t consumed;
+	uintptr_t waiting;
+} WordLockHandoff;
+
+static int J9THREAD_PROC
+incrementUnderLock(void *arg)
+{
+	WordLockCounter *counter = (WordLockCounter *)arg;
+
+	for (uintptr_t i = 0; i < WORDLOCK_ITERATIONS; i++) {
+		omrthread_wordlock_enter(&counter->lock);
+		counter->count += 1;
+		if (0 == (i % 1000)) {
+			/* hold the lock across a reschedule so other threads park */
+			omrthread_yield();
+		}
+		omrthread_wordlock_exit(&counter->lock);
+	}
+	return 0;
+}
+
+static int J9THREAD_PROC
+consume(void *arg)
+{
+	WordLockHandoff *handoff = (WordLockHandoff *)arg;
+
+	omrthread_wordlock_enter(&handoff->lock);
+	handoff->waiting += 1;
+	omrthread_wordlock_notify_all(&handoff->lock);
+	while (handoff->consumed == handoff->produced) {
+		omrthread_wordlock_wait(&handoff->lock, 0, 0);
+	}
+	handoff->consumed += 1;
+	omrthread_wordlock_exit(&handoff->lock);
+	return 0;
+}
+
+static uintptr_t
+neverPark(void *userData)
+{
+	return FALSE;
+}
+
+static void
+recordUnpark(void *userData, uintptr_t unparked, uintptr_t moreWaiters)
+{
+	((uintptr_t *)userData)[0] = unparked;
+	((uintptr_t *)userData)[1] = moreWaiters;
+}
+
+TEST(ParkingLot, wordLockIsOneWord)
+{
+	ASSERT_EQ(sizeof(uintptr_t), sizeof(omrthread_wordlock_t));
+}
+
+TEST(ParkingLot, wordLockTryEnter)
+{
+	omrthread_wordlock_t lock = J9THREAD_WORDLOCK_INITIALIZER;
+
+	ASSERT_EQ(0, omrthread_wordlock_try_enter(&lock));
+	ASSERT_NE(0, omrthread_wordlock_try_enter(&lock));
+	omrthread_wordlock_exit(&lock);
+	ASSERT_EQ((uintptr_t)J9THREAD_WORDLOCK_INITIALIZER, lock);
+}
+
+TEST(ParkingLot, wordLockMutualExclusion)
+{
+	WordLockCounter counter = { J9THREAD_WORDLOCK_INITIALIZER, 0 };
+	omrthread_t threads[WORDLOCK_THREADS];
+
+	for (uintptr_t i = 0; i < WORDLOCK_THREADS; i++) {
+		createJoinableThread(&threads[i], incrementUnderLock, &counter);
+	}
+	for (uintptr_t i = 0; i < WORDLOCK_THREADS; i++) {
+		VERBOSE_JOIN(threads[i], J9THREAD_SUCCESS);
+	}
+	ASSERT_EQ((uintptr_t)(WORDLOCK_THREADS * WORDLOCK_ITERATIONS), counter.count);
+	ASSERT_EQ((uintptr_t)J9THREAD_WORDLOCK_INITIALIZER, counter.lock);
+}
+
+TEST(ParkingLot, wordLockWaitNotify)
+{
+	WordLockHandoff handoff = { J9THREAD_WORDLOCK_INITIALIZER, 0, 0, 0 };
+	omrthread_t threads[WORDLOCK_THREADS];
+
+	for (uintptr_t i = 0; i < WORDLOCK_THREADS; i++) {
+		createJoinableThread(&threads[i], consume, &handoff);
+	}
+
+	omrthread_wordlock_enter(&handoff.lock);
+	while (handoff.waiting < WORDLOCK_THREADS) {
+		omrthread_wordlock_wait(&handoff.lock, 0, 0);
+	}
+	/* release the consumers one at a time */
+	for (uintptr_t i = 0; i < WORDLOCK_THREADS; i++) {
+		handoff.produced += 1;
+		omrthread_wordlock_notify(&handoff.lock);
+		while (handoff.consumed < handoff.produced) {
+			omrthread_wordlock_exit(&handoff.lock);
+			omrthread_yield();
+			omrthread_wordlock_enter(&handoff.lock);
+			omrthread_wordlock_notify_all(&handoff.lock);
+		}
+	}
+	omrthread_wordlock_exit(&handoff.lock);
+
+	for (uintptr_t i = 0; i < WORDLOCK_THREADS; i++) {
+		VERBOSE_JOIN(threads[i], J9THREAD_SUCCESS);
+	}
+	ASSERT_EQ((uintptr_t)WORDLOCK_THREADS, handoff.consumed);
+}
+
+TEST(ParkingLot, wordLockWaitTimesOut)
+{
+	omrthread_wordlock_t lock = J9THREAD_WORDLOCK_INITIALIZER;
+
+	omrthread_wordlock_enter(&lock);
+	ASSERT_EQ(J9THREAD_TIMED_OUT, omrthread_wordlock_wait(&lock, 10, 0));
+	/* the lock is held again after the wait */
+	ASSERT_NE(0, omrthread_wordlock_try_enter(&lock));
+	omrthread_wordlock_exit(&lock);
+}
+
+TEST(ParkingLot, parkValidationAndEmptyUnpark)
+{
+	uintptr_t key = 0;
+	uintptr_t result[2] = { TRUE, TRUE };
+
+	ASSERT_EQ(J9THREAD_WOULD_BLOCK, omrthread_parking_lot_park(&key, neverPark, NULL, NULL, 0, 0));
+	ASSERT_EQ(J9THREAD_TIMED_OUT, omrthread_parking_lot_park(&key, NULL, NULL, NULL, 1, 0));
+	ASSERT_EQ((uintptr_t)0, omrthread_parking_lot_unpark_one(&key, recordUnpark, result));
+	ASSERT_EQ((uintptr_t)FALSE, result[0]);
+	ASSERT_EQ((uintptr_t)FALSE, result[1]);
+	ASSERT_EQ((uintptr_t)0, omrthread_parking_lot_unpark_all(&key));
+}
+
+TEST(ParkingLot, manyLocks)
+{
+	/* a million locks need only a million words */
+	omrthread_wordlock_t *locks = (omrthread_wordlock_t *)calloc(WORDLOCK_FOOTPRINT_LOCKS, sizeof(omrthread_wordlock_t));
+
+	ASSERT_TRUE(NULL != locks);
+	for (uintptr_t i = 0; i < WORDLOCK_FOOTPRINT_LOCKS; i++) {
+		omrthread_wordlock_enter(&locks[i]);
+	}
+	for (uintptr_t i = 0; i < WORDLOCK_FOOTPRINT_LOCKS; i++) {
+		omrthread_wordlock_exit(&locks[i]);
+	}
+	free((void *)locks);
+}
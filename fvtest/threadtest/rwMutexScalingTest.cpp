@@ -0,0 +1,259 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+/*
+ * Read-heavy rwmutex benchmark. Each worker reads a pair of counters under the mutex and,
+ * every RWMUTEX_WRITE_PERIOD iterations, updates them under write access. Readers check
+ * that they never observe a torn update. Throughput of read-biased and unbiased mutexes is
+ * logged for increasing thread counts (run with -logLevel=info to see it).
+ */
+
+#include "omrport.h"
+#include "omrTest.h"
+#include "testHelper.hpp"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+#define RWMUTEX_ITERATIONS 100000
+#define RWMUTEX_WRITE_PERIOD 1000
+#define RWMUTEX_MAX_WORKERS 8
+
+typedef struct ScalingTestInfo {
+	omrthread_rwmutex_t mutex;
+	omrthread_monitor_t startMonitor;
+	volatile uintptr_t started;
+	volatile BOOLEAN go;
+	volatile uintptr_t first;
+	volatile uintptr_t second;
+	volatile uintptr_t tornReads;
+	volatile uintptr_t writes;
+} ScalingTestInfo;
+
+static int J9THREAD_PROC
+scalingWorker(void *arg)
+{
+	ScalingTestInfo *info = (ScalingTestInfo *)arg;
+	uintptr_t tornReads = 0;
+	uintptr_t i = 0;
+
+	omrthread_monitor_enter(info->startMonitor);
+	info->started += 1;
+	omrthread_monitor_notify_all(info->startMonitor);
+	while (!info->go) {
+		omrthread_monitor_wait(info->startMonitor);
+	}
+	omrthread_monitor_exit(info->startMonitor);
+
+	for (i = 1; i <= RWMUTEX_ITERATIONS; i++) {
+		if (0 == (i % RWMUTEX_WRITE_PERIOD)) {
+			omrthread_rwmutex_enter_write(info->mutex);
+			/* writer re-entry, and read access while holding write access */
+			omrthread_rwmutex_enter_write(info->mutex);
+			omrthread_rwmutex_enter_read(info->mutex);
+			info->first += 1;
+			info->second += 1;
+			info->writes += 1;
+			omrthread_rwmutex_exit_read(info->mutex);
+			omrthread_rwmutex_exit_write(info->mutex);
+			omrthread_rwmutex_exit_write(info->mutex);
+		} else {
+			omrthread_rwmutex_enter_read(info->mutex);
+			if (info->first != info->second) {
+				tornReads += 1;
+			}
+			omrthread_rwmutex_exit_read(info->mutex);
+		}
+	}
+
+	omrthread_monitor_enter(info->startMonitor);
+	info->tornReads += tornReads;
+	omrthread_monitor_exit(info->startMonitor);
+	return 0;
+}
+
+/**
+ * Run the workload on a number of threads.
+ * @return elapsed time in microseconds
+ */
+static uint64_t
+runScalingWorkload(uintptr_t flags, uintptr_t workers)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(omrTestEnv->getPortLibrary());
+	ScalingTestInfo info;
+	omrthread_t threads[RWMUTEX_MAX_WORKERS];
+	uint64_t start = 0;
+	uint64_t end = 0;
+	uintptr_t i = 0;
+
+	memset(&info, 0, sizeof(info));
+	EXPECT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_init(&info.mutex, flags, "rwmutex scaling test"));
+	EXPECT_EQ(0, omrthread_monitor_init_with_name(&info.startMonitor, 0, "rwmutex scaling test start"));
+
+	for (i = 0; i < workers; i++) {
+		createJoinableThread(&threads[i], scalingWorker, &info);
+	}
+
+	omrthread_monitor_enter(info.startMonitor);
+	while (info.started < workers) {
+		omrthread_monitor_wait(info.startMonitor);
+	}
+	start = omrtime_hires_clock();
+	info.go = TRUE;
+	omrthread_monitor_notify_all(info.startMonitor);
+	omrthread_monitor_exit(info.startMonitor);
+
+	for (i = 0; i < workers; i++) {
+		VERBOSE_JOIN(threads[i], 0);
+	}
+	end = omrtime_hires_clock();
+
+	EXPECT_EQ((uintptr_t)0, info.tornReads);
+	EXPECT_EQ(workers * (RWMUTEX_ITERATIONS / RWMUTEX_WRITE_PERIOD), info.writes);
+	EXPECT_EQ(info.first, info.second);
+	EXPECT_FALSE(omrthread_rwmutex_is_writelocked(info.mutex));
+
+	omrthread_monitor_destroy(info.startMonitor);
+	EXPECT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_destroy(info.mutex));
+
+	return omrtime_hires_delta(start, end, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+}
+
+TEST(RWMutex, ReadHeavyScaling)
+{
+	uintptr_t workers = 0;
+
+	omrTestEnv->log(LEVEL_INFO, "%8s %16s %16s  (reads+writes per ms)\n", "threads", "read-biased", "unbiased");
+	for (workers = 1; workers <= RWMUTEX_MAX_WORKERS; workers *= 2) {
+		uint64_t operations = (uint64_t)workers * RWMUTEX_ITERATIONS * 1000;
+		uint64_t biased = runScalingWorkload(0, workers);
+		uint64_t unbiased = runScalingWorkload(J9THREAD_RWMUTEX_NO_READ_BIAS, workers);
+
+		omrTestEnv->log(LEVEL_INFO, "%8zu %16llu %16llu\n", workers,
+				(unsigned long long)(operations / OMR_MAX(biased, 1)),
+				(unsigned long long)(operations / OMR_MAX(unbiased, 1)));
+	}
+}
+
+TEST(RWMutex, BiasedReaderBlocksTryEnterWrite)
+{
+	omrthread_rwmutex_t mutex = NULL;
+
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_init(&mutex, 0, "rwmutex bias test"));
+
+	/* nested reads, both published in this thread's reader slots */
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_enter_read(mutex));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_enter_read(mutex));
+	ASSERT_FALSE(omrthread_rwmutex_is_writelocked(mutex));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_exit_read(mutex));
+
+	/* the revoked bias must still see the remaining reader */
+	ASSERT_EQ(J9THREAD_RWMUTEX_WOULDBLOCK, omrthread_rwmutex_try_enter_write(mutex));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_exit_read(mutex));
+
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_try_enter_write(mutex));
+	ASSERT_TRUE(omrthread_rwmutex_is_writelocked(mutex));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_exit_write(mutex));
+
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_destroy(mutex));
+}
+
+typedef struct RevocationTestInfo {
+	omrthread_rwmutex_t mutex;
+	volatile uintptr_t writerEntered;
+	volatile intptr_t tryResult;
+} RevocationTestInfo;
+
+static int J9THREAD_PROC
+revokingWriter(void *arg)
+{
+	RevocationTestInfo *info = (RevocationTestInfo *)arg;
+
+	omrthread_rwmutex_enter_write(info->mutex);
+	info->writerEntered = 1;
+	omrthread_rwmutex_exit_write(info->mutex);
+	return 0;
+}
+
+static int J9THREAD_PROC
+tryingWriter(void *arg)
+{
+	RevocationTestInfo *info = (RevocationTestInfo *)arg;
+
+	info->tryResult = omrthread_rwmutex_try_enter_write(info->mutex);
+	if (J9THREAD_RWMUTEX_OK == info->tryResult) {
+		omrthread_rwmutex_exit_write(info->mutex);
+	}
+	return 0;
+}
+
+TEST(RWMutex, RevocationExcludesOtherWriters)
+{
+	RevocationTestInfo info;
+	omrthread_t writer = NULL;
+	omrthread_t trier = NULL;
+
+	memset(&info, 0, sizeof(info));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_init(&info.mutex, 0, "rwmutex revocation test"));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_enter_read(info.mutex));
+
+	/* the first writer revokes the bias and waits for this thread's published read */
+	createJoinableThread(&writer, revokingWriter, &info);
+	omrthread_sleep(100);
+
+	/* while the first writer is still draining readers, a second one must not get in */
+	createJoinableThread(&trier, tryingWriter, &info);
+	VERBOSE_JOIN(trier, 0);
+	EXPECT_EQ(J9THREAD_RWMUTEX_WOULDBLOCK, info.tryResult);
+	EXPECT_EQ((uintptr_t)0, info.writerEntered);
+
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_exit_read(info.mutex));
+	VERBOSE_JOIN(writer, 0);
+	EXPECT_EQ((uintptr_t)1, info.writerEntered);
+
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_destroy(info.mutex));
+}
+
+TEST(RWMutex, RevokingWriterBlocksDuringLongRead)
+{
+	RevocationTestInfo info;
+	omrthread_t writer = NULL;
+	int64_t writerCpuTime = 0;
+
+	memset(&info, 0, sizeof(info));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_init(&info.mutex, 0, "rwmutex long read test"));
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_enter_read(info.mutex));
+
+	createJoinableThread(&writer, revokingWriter, &info);
+	omrthread_sleep(500);
+
+	/* the writer waits for the published read on syncMon rather than yielding until it is dropped */
+	writerCpuTime = omrthread_get_cpu_time(writer);
+	EXPECT_EQ((uintptr_t)0, info.writerEntered);
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_exit_read(info.mutex));
+	VERBOSE_JOIN(writer, 0);
+	EXPECT_EQ((uintptr_t)1, info.writerEntered);
+	if (writerCpuTime >= 0) {
+		EXPECT_LT(writerCpuTime, (int64_t)100000000) << "writer spent " << writerCpuTime << "ns of CPU waiting";
+	}
+
+	ASSERT_EQ(J9THREAD_RWMUTEX_OK, omrthread_rwmutex_destroy(info.mutex));
+}
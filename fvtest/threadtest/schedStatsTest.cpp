@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrTest.h"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+extern ThreadTestEnvironment *omrTestEnv;
+
+#define SAMPLED_THREADS 3
+#define MAX_SAMPLES 64
+#define SLEEPS 5
+
+/*
+ * Sample a few threads that sleep repeatedly (and so switch out voluntarily) while
+ * parked on a monitor, and check the batch sample describes each of them.
+ */
+class SchedStatsTest: public ::testing::Test {
+public:
+	static omrthread_monitor_t monitor;
+	static volatile uintptr_t started;
+	static volatile uintptr_t release;
+
+	static int J9THREAD_PROC
+	sleeper(void *arg)
+	{
+		for (uintptr_t i = 0; i < SLEEPS; i++) {
+			omrthread_sleep(1);
+		}
+		omrthread_monitor_enter(monitor);
+		started += 1;
+		omrthread_monitor_notify_all(monitor);
+		while (0 == release) {
+			omrthread_monitor_wait(monitor);
+		}
+		omrthread_monitor_exit(monitor);
+		return 0;
+	}
+
+protected:
+	virtual void
+	SetUp()
+	{
+		started = 0;
+		release = 0;
+		ASSERT_EQ(0, omrthread_monitor_init_with_name(&monitor, 0, "SchedStatsTest"));
+	}
+
+	virtual void
+	TearDown()
+	{
+		omrthread_monitor_destroy(monitor);
+	}
+};
+
+omrthread_monitor_t SchedStatsTest::monitor = NULL;
+volatile uintptr_t SchedStatsTest::started = 0;
+volatile uintptr_t SchedStatsTest::release = 0;
+
+TEST_F(SchedStatsTest, SamplesEveryThread)
+{
+	omrthread_attr_t attr = NULL;
+	omrthread_t threads[SAMPLED_THREADS];
+	J9ThreadSchedStats stats[MAX_SAMPLES];
+	uintptr_t count = MAX_SAMPLES;
+	uintptr_t totalCount = 0;
+
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_init(&attr));
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE));
+	for (uintptr_t i = 0; i < SAMPLED_THREADS; i++) {
+		ASSERT_EQ(J9THREAD_SUCCESS, omrthread_create_ex(&threads[i], &attr, FALSE, sleeper, NULL));
+	}
+	omrthread_attr_destroy(&attr);
+
+	omrthread_monitor_enter(monitor);
+	while (SAMPLED_THREADS != started) {
+		omrthread_monitor_wait(monitor);
+	}
+	omrthread_monitor_exit(monitor);
+
+	/* a zero capacity only counts the threads */
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_get_sched_stats(NULL, &totalCount, J9THREAD_SCHED_STATS_ALL));
+	ASSERT_LE((uintptr_t)(SAMPLED_THREADS + 1), totalCount);
+	ASSERT_GE((uintptr_t)MAX_SAMPLES, totalCount);
+
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_get_sched_stats(stats, &count, J9THREAD_SCHED_STATS_ALL));
+	ASSERT_EQ(totalCount, count);
+
+	for (uintptr_t i = 0; i < SAMPLED_THREADS; i++) {
+		J9ThreadSchedStats *sample = NULL;
+		for (uintptr_t j = 0; j < count; j++) {
+			if (stats[j].thread == threads[i]) {
+				sample = &stats[j];
+				break;
+			}
+		}
+		ASSERT_TRUE(NULL != sample) << "thread " << i << " missing from the sample";
+		omrTestEnv->log(LEVEL_VERBOSE, "tid %zu: cpu %lldns, delay %lldns, %lld/%lld switches, cpu %zd\n",
+			(size_t)sample->tid, (long long)sample->cpuTime, (long long)sample->runDelay,
+			(long long)sample->voluntaryContextSwitches, (long long)sample->involuntaryContextSwitches, (ssize_t)sample->lastCpu);
+#if defined(LINUX)
+		EXPECT_LE(0, sample->cpuTime);
+		EXPECT_LE(0, sample->runDelay);
+		EXPECT_LE((int64_t)SLEEPS, sample->voluntaryContextSwitches);
+		EXPECT_LE(0, sample->involuntaryContextSwitches);
+		EXPECT_LE(0, sample->lastCpu);
+#endif /* defined(LINUX) */
+	}
+
+	omrthread_monitor_enter(monitor);
+	release = 1;
+	omrthread_monitor_notify_all(monitor);
+	omrthread_monitor_exit(monitor);
+	for (uintptr_t i = 0; i < SAMPLED_THREADS; i++) {
+		EXPECT_EQ(J9THREAD_SUCCESS, omrthread_join(threads[i]));
+	}
+}
+
+TEST_F(SchedStatsTest, UnrequestedFieldsAreUnset)
+{
+	J9ThreadSchedStats stats[MAX_SAMPLES];
+	uintptr_t count = MAX_SAMPLES;
+
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_get_sched_stats(stats, &count, J9THREAD_SCHED_STATS_LAST_CPU));
+	ASSERT_LE((uintptr_t)1, count);
+	for (uintptr_t i = 0; (i < count) && (i < MAX_SAMPLES); i++) {
+		EXPECT_EQ(-1, stats[i].cpuTime);
+		EXPECT_EQ(-1, stats[i].voluntaryContextSwitches);
+	}
+}
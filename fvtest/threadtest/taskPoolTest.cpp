@@ -0,0 +1,206 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrTest.h"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+#define WORKERS 4
+#define RANGE 10000
+/* enough small batches for the owner's 1024 entry deque to wrap many times */
+#define STRESS_BATCH 4
+#define STRESS_ROUNDS 32768
+
+typedef struct FibTask {
+	uintptr_t n;
+	uintptr_t result;
+} FibTask;
+
+static void
+fib(omrthread_taskpool_t pool, void *arg)
+{
+	FibTask *fibTask = (FibTask *)arg;
+
+	if (fibTask->n < 2) {
+		fibTask->result = fibTask->n;
+	} else {
+		FibTask left = { fibTask->n - 1, 0 };
+		FibTask right = { fibTask->n - 2, 0 };
+		J9ThreadTask task;
+
+		omrthread_task_init(&task, fib, &left);
+		omrthread_taskpool_fork(pool, &task);
+		fib(pool, &right);
+		omrthread_taskpool_join(pool, &task);
+		fibTask->result = left.result + right.result;
+	}
+}
+
+static void
+countRange(void *userData, uintptr_t begin, uintptr_t end)
+{
+	volatile uintptr_t *counts = (volatile uintptr_t *)userData;
+
+	for (uintptr_t i = begin; i < end; i++) {
+		counts[i] += 1;
+	}
+}
+
+typedef struct WorkerIndexTask {
+	intptr_t index;
+} WorkerIndexTask;
+
+static void
+recordWorkerIndex(omrthread_taskpool_t pool, void *arg)
+{
+	((WorkerIndexTask *)arg)->index = omrthread_taskpool_worker_index(pool);
+}
+
+static J9ThreadTask stressTasks[STRESS_BATCH * STRESS_ROUNDS];
+static volatile uintptr_t stressRuns[STRESS_BATCH * STRESS_ROUNDS];
+static volatile uintptr_t stressDone;
+
+static void
+countRun(omrthread_taskpool_t pool, void *arg)
+{
+	*(volatile uintptr_t *)arg += 1;
+}
+
+/* Fork small batches and join them newest first, so the owner keeps popping its last task while thieves steal it */
+static void
+forkBatches(omrthread_taskpool_t pool, void *arg)
+{
+	intptr_t *workerIndex = (intptr_t *)arg;
+
+	*workerIndex = omrthread_taskpool_worker_index(pool);
+	for (uintptr_t round = 0; round < STRESS_ROUNDS; round++) {
+		uintptr_t first = round * STRESS_BATCH;
+
+		for (uintptr_t i = first; i < (first + STRESS_BATCH); i++) {
+			omrthread_task_init(&stressTasks[i], countRun, (void *)&stressRuns[i]);
+			omrthread_taskpool_fork(pool, &stressTasks[i]);
+		}
+		for (uintptr_t i = first + STRESS_BATCH; i > first; i--) {
+			omrthread_taskpool_join(pool, &stressTasks[i - 1]);
+		}
+	}
+	stressDone = 1;
+}
+
+TEST(TaskPool, createRejectsZeroWorkers)
+{
+	omrthread_taskpool_t pool = NULL;
+
+	ASSERT_EQ(J9THREAD_ERR_INVALID_VALUE, omrthread_taskpool_create(&pool, 0, J9THREAD_CATEGORY_SYSTEM_THREAD, J9THREAD_NUMA_PLACEMENT_NONE));
+}
+
+TEST(TaskPool, forkJoinFromExternalThread)
+{
+	omrthread_taskpool_t pool = NULL;
+	FibTask root = { 20, 0 };
+	J9ThreadTask task;
+
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_taskpool_create(&pool, WORKERS, J9THREAD_CATEGORY_SYSTEM_THREAD, J9THREAD_NUMA_PLACEMENT_NONE));
+	ASSERT_EQ((uintptr_t)WORKERS, omrthread_taskpool_worker_count(pool));
+	ASSERT_EQ(-1, omrthread_taskpool_worker_index(pool));
+
+	omrthread_task_init(&task, fib, &root);
+	omrthread_taskpool_fork(pool, &task);
+	omrthread_taskpool_join(pool, &task);
+	ASSERT_EQ((uintptr_t)6765, root.result);
+
+	omrthread_taskpool_destroy(pool);
+}
+
+TEST(TaskPool, workerIndex)
+{
+	omrthread_taskpool_t pool = NULL;
+	WorkerIndexTask indexTask = { -1 };
+	J9ThreadTask task;
+
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_taskpool_create(&pool, WORKERS, J9THREAD_CATEGORY_SYSTEM_THREAD, J9THREAD_NUMA_PLACEMENT_NONE));
+	omrthread_task_init(&task, recordWorkerIndex, &indexTask);
+	omrthread_taskpool_fork(pool, &task);
+	omrthread_taskpool_join(pool, &task);
+	/* the external joiner may run the task itself */
+	ASSERT_GE(indexTask.index, -1);
+	ASSERT_LT(indexTask.index, WORKERS);
+	omrthread_taskpool_destroy(pool);
+}
+
+TEST(TaskPool, parallelForVisitsEachIndexOnce)
+{
+	omrthread_taskpool_t pool = NULL;
+	static volatile uintptr_t counts[RANGE];
+
+	memset((void *)counts, 0, sizeof(counts));
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_taskpool_create(&pool, WORKERS, J9THREAD_CATEGORY_SYSTEM_THREAD, J9THREAD_NUMA_PLACEMENT_NONE));
+
+	omrthread_taskpool_parallel_for(pool, 0, RANGE, 16, countRange, (void *)counts);
+	for (uintptr_t i = 0; i < RANGE; i++) {
+		ASSERT_EQ((uintptr_t)1, counts[i]) << "index " << i;
+	}
+
+	/* an empty range does nothing */
+	omrthread_taskpool_parallel_for(pool, 5, 5, 1, countRange, (void *)counts);
+	ASSERT_EQ((uintptr_t)1, counts[5]);
+
+	omrthread_taskpool_destroy(pool);
+}
+
+TEST(TaskPool, interleavedWorkers)
+{
+	omrthread_taskpool_t pool = NULL;
+	FibTask root = { 15, 0 };
+	J9ThreadTask task;
+
+	/* placement falls back to no binding when NUMA support is not available */
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_taskpool_create(&pool, WORKERS, J9THREAD_CATEGORY_SYSTEM_THREAD, J9THREAD_NUMA_PLACEMENT_INTERLEAVE));
+	omrthread_task_init(&task, fib, &root);
+	omrthread_taskpool_fork(pool, &task);
+	omrthread_taskpool_join(pool, &task);
+	ASSERT_EQ((uintptr_t)610, root.result);
+	omrthread_taskpool_destroy(pool);
+}
+
+TEST(TaskPool, popRacingStealsAcrossDequeWrap)
+{
+	omrthread_taskpool_t pool = NULL;
+	intptr_t workerIndex = -1;
+	J9ThreadTask task;
+
+	memset((void *)stressRuns, 0, sizeof(stressRuns));
+	stressDone = 0;
+	ASSERT_EQ(J9THREAD_SUCCESS, omrthread_taskpool_create(&pool, WORKERS, J9THREAD_CATEGORY_SYSTEM_THREAD, J9THREAD_NUMA_PLACEMENT_NONE));
+	omrthread_task_init(&task, forkBatches, &workerIndex);
+	omrthread_taskpool_fork(pool, &task);
+	/* leave the task to a worker, so its batches go on a deque rather than the pool queue */
+	while (0 == stressDone) {
+		omrthread_sleep(1);
+	}
+	omrthread_taskpool_join(pool, &task);
+	ASSERT_GE(workerIndex, 0);
+	/* a pop that lost the last task to a thief must not leave a stale slot behind to be run again */
+	for (uintptr_t i = 0; i < (STRESS_BATCH * STRESS_ROUNDS); i++) {
+		ASSERT_EQ((uintptr_t)1, stressRuns[i]) << "task " << i;
+	}
+	omrthread_taskpool_destroy(pool);
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/*
+ * Checks that the current-thread TLS path agrees with omrthread_tls_get/set and keeps
+ * finalizer semantics, and times both paths (run with -logLevel=info to see it).
+ */
+
+#include "omrport.h"
+#include "omrTest.h"
+#include "thread_api.h"
+#include "threadTestHelp.h"
+
+extern ThreadTestEnvironment *omrTestEnv;
+
+#define TLS_BENCHMARK_ITERATIONS 10000000
+
+static volatile uintptr_t finalized = 0;
+static void *finalizedValue = NULL;
+
+static void J9THREAD_PROC
+countingFinalizer(void *value)
+{
+	finalized += 1;
+	finalizedValue = value;
+}
+
+typedef struct TlsChildInfo {
+	omrthread_tls_key_t key;
+	void *initialValue;
+	void *value;
+} TlsChildInfo;
+
+static int J9THREAD_PROC
+tlsChild(void *arg)
+{
+	TlsChildInfo *info = (TlsChildInfo *)arg;
+
+	info->initialValue = omrthread_tls_get_current(info->key);
+	omrthread_tls_set_current(info->key, info->value);
+	return 0;
+}
+
+TEST(TLSFastPath, matchesSlowPath)
+{
+	omrthread_tls_key_t key = 0;
+	omrthread_t self = omrthread_self();
+	int first = 0;
+	int second = 0;
+
+	ASSERT_EQ(0, omrthread_tls_alloc(&key));
+	ASSERT_TRUE(NULL == omrthread_tls_get_current(key));
+
+	ASSERT_EQ(0, omrthread_tls_set(self, key, &first));
+	ASSERT_EQ((void *)&first, omrthread_tls_get_current(key));
+
+	ASSERT_EQ(0, omrthread_tls_set_current(key, &second));
+	ASSERT_EQ((void *)&second, omrthread_tls_get(self, key));
+
+	ASSERT_EQ(0, omrthread_tls_free(key));
+}
+
+TEST(TLSFastPath, finalizerRunsOnThreadExit)
+{
+	omrthread_tls_key_t key = 0;
+	omrthread_t child = NULL;
+	TlsChildInfo info;
+	int marker = 0;
+
+	finalized = 0;
+	finalizedValue = NULL;
+	ASSERT_EQ(0, omrthread_tls_alloc_with_finalizer(&key, countingFinalizer));
+	ASSERT_EQ(0, omrthread_tls_set_current(key, &info));
+
+	info.key = key;
+	info.initialValue = &info;
+	info.value = &marker;
+	createJoinableThread(&child, tlsChild, &info);
+	VERBOSE_JOIN(child, J9THREAD_SUCCESS);
+
+	/* the child starts with its own empty slot, and its value is finalized when it exits */
+	ASSERT_TRUE(NULL == info.initialValue);
+	ASSERT_EQ((uintptr_t)1, finalized);
+	ASSERT_EQ((void *)&marker, finalizedValue);
+	ASSERT_EQ((void *)&info, omrthread_tls_get_current(key));
+
+	ASSERT_EQ(0, omrthread_tls_free(key));
+}
+
+TEST(TLSFastPath, Benchmark)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(omrTestEnv->getPortLibrary());
+	omrthread_tls_key_t key = 0;
+	uintptr_t sum = 0;
+	uint64_t start = 0;
+	uint64_t slow = 0;
+	uint64_t fast = 0;
+	uintptr_t i = 0;
+	int value = 0;
+
+	ASSERT_EQ(0, omrthread_tls_alloc(&key));
+	ASSERT_EQ(0, omrthread_tls_set_current(key, &value));
+
+	start = omrtime_hires_clock();
+	for (i = 0; i < TLS_BENCHMARK_ITERATIONS; i++) {
+		sum += (uintptr_t)omrthread_tls_get(omrthread_self(), key);
+	}
+	slow = omrtime_hires_delta(start, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_NANOSECONDS);
+
+	start = omrtime_hires_clock();
+	for (i = 0; i < TLS_BENCHMARK_ITERATIONS; i++) {
+		sum -= (uintptr_t)omrthread_tls_get_current(key);
+	}
+	fast = omrtime_hires_delta(start, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_NANOSECONDS);
+
+	ASSERT_EQ((uintptr_t)0, sum);
+	omrTestEnv->log(LEVEL_INFO, "omrthread_tls_get(omrthread_self()): %.2f ns/op\n", (double)slow / TLS_BENCHMARK_ITERATIONS);
+	omrTestEnv->log(LEVEL_INFO, "omrthread_tls_get_current:           %.2f ns/op\n", (double)fast / TLS_BENCHMARK_ITERATIONS);
+
+	ASSERT_EQ(0, omrthread_tls_free(key));
+}
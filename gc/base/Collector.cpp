@@ -29,6 +29,7 @@
 #include "ModronAssertions.h"
 #include "ObjectAllocationInterface.hpp"
 #include "OMRVMThreadListIterator.hpp"
+#include "PauseTimeController.hpp"
 
 class MM_MemorySubSpace;
 class MM_MemorySpace;
@@ -250,6 +251,9 @@ MM_Collector::preCollect(MM_EnvironmentBase* env, MM_MemorySubSpace* subSpace, M
 		 */
 		if (!env->getCycleStateGCCode().isExplicitGC()) {
 			recordExcessiveStatsForGCStart(env);
+			if (NULL != extensions->pauseTimeController) {
+				extensions->pauseTimeController->collectionStarted(env);
+			}
 			/* Inner invocations will see the flag as true */
 			extensions->isRecursiveGC = true;
 		}
@@ -428,6 +432,13 @@ MM_Collector::postCollect(MM_EnvironmentBase* env, MM_MemorySubSpace* subSpace)
 	masterThreadCpuTime -= _masterThreadCpuTimeStart;
 	extensions->_masterThreadCpuTimeNanos += masterThreadCpuTime;
 
+	/* Feed the pause of the outermost implicit collection to the pause time controller before the
+	 * collector specific post collect work, so that its decisions are visible to the cycle end reporting.
+	 */
+	if (!_isRecursiveGC && !env->getCycleStateGCCode().isExplicitGC() && (NULL != extensions->pauseTimeController)) {
+		extensions->pauseTimeController->collectionCompleted(env, extensions->didGlobalGC);
+	}
+
 	internalPostCollect(env, subSpace);
 
 	extensions->bytesAllocatedMost = 0;
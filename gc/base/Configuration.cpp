@@ -37,11 +37,14 @@
 #include "GlobalCollector.hpp"
 #include "Heap.hpp"
 #include "HeapRegionManager.hpp"
+#include "HeapTelemetry.hpp"
 #include "OMR_VM.hpp"
 #include "OMR_VMThread.hpp"
 #include "MemoryManager.hpp"
 #include "MemorySpace.hpp"
+#include "ObjectAllocationSampler.hpp"
 #include "ParallelDispatcher.hpp"
+#include "PauseTimeController.hpp"
 #include "ReferenceChainWalkerMarkMap.hpp"
 #if defined(OMR_GC_THREAD_LOCAL_HEAP)
 #include "TLHAllocationInterface.hpp"
@@ -74,6 +77,18 @@ MM_Configuration::initialize(MM_EnvironmentBase* env)
 				initializeGCParameters(env);
 				extensions->_lightweightNonReentrantLockPool = pool_new(sizeof(J9ThreadMonitorTracing), 0, 0, 0, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_MM, POOL_FOR_PORT(env->getPortLibrary()));
 				result = (NULL != extensions->_lightweightNonReentrantLockPool);
+				if (result && (0 != extensions->pauseTimeTarget)) {
+					extensions->pauseTimeController = MM_PauseTimeController::newInstance(env);
+					result = (NULL != extensions->pauseTimeController);
+				}
+				if (result && (0 != extensions->allocationSamplingInterval)) {
+					extensions->allocationSampler = MM_ObjectAllocationSampler::newInstance(env);
+					result = (NULL != extensions->allocationSampler);
+				}
+				if (result && (0 != extensions->heapTelemetrySamples)) {
+					extensions->heapTelemetry = MM_HeapTelemetry::newInstance(env);
+					result = (NULL != extensions->heapTelemetry);
+				}
 			}
 		}
 	}
@@ -108,6 +123,21 @@ MM_Configuration::tearDown(MM_EnvironmentBase* env)
 		extensions->setGlobalCollector(NULL);
 	}
 
+	if (NULL != extensions->pauseTimeController) {
+		extensions->pauseTimeController->kill(env);
+		extensions->pauseTimeController = NULL;
+	}
+
+	if (NULL != extensions->allocationSampler) {
+		extensions->allocationSampler->kill(env);
+		extensions->allocationSampler = NULL;
+	}
+
+	if (NULL != extensions->heapTelemetry) {
+		extensions->heapTelemetry->kill(env);
+		extensions->heapTelemetry = NULL;
+	}
+
 	if (!extensions->isMetronomeGC()) {
 		/* In Metronome, dispatcher is created and destroyed by the collector */
 		if (NULL != extensions->dispatcher) {
@@ -147,6 +147,7 @@ public:
 	MM_FreeEntrySizeClassStats _freeEntrySizeClassStats;  /**< GC thread local statistics structure for heap free entry size (sizeClass) distribution */
 
 	uintptr_t _oolTraceAllocationBytes; /**< Tracks the bytes allocated since the last ool object trace */
+	uintptr_t _allocationSamplingBytes; /**< Tracks the bytes allocated since the last allocation site sample */
 
 	uintptr_t approxScanCacheCount; /**< Local copy of approximate entries in global Cache Scan List. Updated upon allocation of new cache. */
 
@@ -400,6 +401,15 @@ public:
 	 */
 	bool objectAllocationNotify(omrobjectptr_t omrObject) { return _delegate.objectAllocationNotify(omrObject); }
 
+	/**
+	 * Called for an object selected by the allocation sampler (see MM_ObjectAllocationSampler). The allocating
+	 * thread is the thread bound to the receiver, but the call may be made from a GC thread while TLHs are flushed.
+	 * @param omrObject the sampled object
+	 * @param sizeInBytes the consumed size of the object
+	 * @return the language-defined allocation site to charge the sample to, or 0 to discard the sample
+	 */
+	uintptr_t objectAllocationSampled(omrobjectptr_t omrObject, uintptr_t sizeInBytes) { return _delegate.objectAllocationSampled(_omrVMThread, omrObject, sizeInBytes); }
+
 	/**
 	 *	Verbose: allocation Failure Start Report if required
 	 *	set flag allocation Failure Start Report required
@@ -646,6 +656,7 @@ public:
 		,_slaveThreadCpuTimeNanos(0)
 		,_freeEntrySizeClassStats()
 		,_oolTraceAllocationBytes(0)
+		,_allocationSamplingBytes(0)
 		,approxScanCacheCount(0)
 		,_activeValidator(NULL)
 		,_lastSyncPointReached(NULL)
@@ -698,6 +709,7 @@ public:
 		,_slaveThreadCpuTimeNanos(0)
 		,_freeEntrySizeClassStats()
 		,_oolTraceAllocationBytes(0)
+		,_allocationSamplingBytes(0)
 		,approxScanCacheCount(0)
 		,_activeValidator(NULL)
 		,_lastSyncPointReached(NULL)
@@ -61,10 +61,13 @@ class MM_GlobalCollector;
 class MM_Heap;
 class MM_HeapMap;
 class MM_HeapRegionManager;
+class MM_HeapTelemetry;
 
 class MM_InterRegionRememberedSet;
 class MM_MemoryManager;
 class MM_MemorySubSpace;
+class MM_ObjectAllocationSampler;
+class MM_PauseTimeController;
 #if defined(OMR_GC_OBJECT_MAP)
 class MM_ObjectMap;
 #endif /* defined(OMR_GC_OBJECT_MAP) */
@@ -264,6 +267,7 @@ public:
 
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	MM_SublistPool rememberedSet;
+	uintptr_t rememberedSetScanChunkSize; /**< number of remembered set slots claimed at a time by a scavenger thread - set by -Xgc:rememberedSetScanChunkSize= */
 	uintptr_t oldHeapSizeOnLastGlobalGC;
 	uintptr_t freeOldHeapSizeOnLastGlobalGC;
 	float concurrentKickoffTenuringHeadroom; /**< percentage of free memory remaining in tenure heap. Used in conjunction with free memory to determine concurrent mark kickoff */
@@ -289,6 +293,11 @@ public:
 	bool doOutOfLineAllocationTrace;
 	bool doFrequentObjectAllocationSampling; /**< Whether to track object allocations*/
 	uintptr_t oolObjectSamplingBytesGranularity; /**< How often (in bytes) we do an ool allocation trace */
+	uintptr_t allocationSamplingInterval; /**< Bytes allocated per thread between two allocation site samples (0 disables sampling) - set by -Xgc:allocationSamplingInterval= */
+	uintptr_t allocationSamplingTopK; /**< Number of allocation sites tracked by the allocation sampler - set by -Xgc:allocationSamplingTopK= */
+	MM_ObjectAllocationSampler *allocationSampler; /**< Top-K aggregation of allocation samples (NULL if sampling is disabled) */
+	uintptr_t heapTelemetrySamples; /**< Number of samples kept by the heap telemetry ring (0 disables heap telemetry) - set by -Xgc:heapTelemetrySamples= */
+	MM_HeapTelemetry *heapTelemetry; /**< Heap telemetry sampler and ring (NULL if heap telemetry is disabled) */
 	uintptr_t frequentObjectAllocationSamplingRate; /**< # bytes to sample / # bytes allocated */
 	MM_FrequentObjectsStats* frequentObjectsStats;
 	uint32_t frequentObjectAllocationSamplingDepth; /**< # of frequent objects we'd like to report */
@@ -383,6 +392,8 @@ public:
 
 	bool rootScannerStatsEnabled; /**< Enable/disable recording of performance statistics for the root scanner.  Defaults to false. */
 	bool rootScannerStatsUsed; /**< Flag that indicates if rootScannerStats are used for in the last increment (by any thread, for any of its roots) */
+	uintptr_t rootScanThreadsPerChunk; /**< number of threads in each work unit claimed by the parallel root scanner - set by -Xgc:rootScanThreadsPerChunk= */
+	uintptr_t rootScanSlotsPerChunk; /**< number of hash table entries or sublist slots in each work unit claimed by the parallel root scanner - set by -Xgc:rootScanSlotsPerChunk= */
 
 	/* bools and counters for -Xgc:fvtest options */
 	bool fvtest_forceOldResize;
@@ -435,6 +446,11 @@ public:
 	bool gcThreadCountForced; /**< true if number of GC threads is specified in java options. Currently we have a few ways to do this:
 										-Xgcthreads		-Xthreads= (RT only)	-XthreadCount= */
 
+	uintptr_t pauseTimeTarget; /**< Pause time goal in milliseconds (0 disables the pause time controller) - set by -Xgc:pauseTimeTarget= */
+	uintptr_t pauseTimeTargetPercentile; /**< Percentile of recent pauses that must meet pauseTimeTarget - set by -Xgc:pauseTimePercentile= */
+	uintptr_t pauseTimeThroughputFloor; /**< Minimum percentage of wall time left to the application while meeting the pause goal - set by -Xgc:pauseTimeThroughputFloor= */
+	MM_PauseTimeController *pauseTimeController; /**< Feedback controller deriving nursery size, concurrent kickoff and GC thread count from the pause time goal (NULL if disabled) */
+
 #if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC)
 	enum ScavengerScanOrdering {
 		OMR_GC_SCAVENGER_SCANORDERING_BREADTH_FIRST = 0,
@@ -1360,6 +1376,7 @@ public:
 		, gcmetadataPageFlags(OMRPORT_VMEM_PAGE_FLAG_NOT_USED)
 #if defined(OMR_GC_MODRON_SCAVENGER)
 		, rememberedSet()
+		, rememberedSetScanChunkSize(OMR_SCV_REMSET_FRAGMENT_SIZE * 8)
 		, oldHeapSizeOnLastGlobalGC(UDATA_MAX)
 		, freeOldHeapSizeOnLastGlobalGC(UDATA_MAX)
 		, concurrentKickoffTenuringHeadroom((float)0.02)
@@ -1378,6 +1395,11 @@ public:
 		, doOutOfLineAllocationTrace(true) /* Tracing after ever x bytes allocated per thread. Enabled by default. */
 		, doFrequentObjectAllocationSampling(false) /* Finds most frequently allocated classes. Disabled by default. */
 		, oolObjectSamplingBytesGranularity(16*1024*1024) /* Default granularity set to 16M (shows <1% perf loss). */
+		, allocationSamplingInterval(0)
+		, allocationSamplingTopK(32)
+		, allocationSampler(NULL)
+		, heapTelemetrySamples(0)
+		, heapTelemetry(NULL)
 		, frequentObjectAllocationSamplingRate(100)
 		, frequentObjectsStats(NULL)
 		, frequentObjectAllocationSamplingDepth(0)
@@ -1449,6 +1471,8 @@ public:
 		, markingArraySplitMinimumAmount(DEFAULT_ARRAY_SPLIT_MINIMUM_SIZE)
 		, rootScannerStatsEnabled(false)
 		, rootScannerStatsUsed(false)
+		, rootScanThreadsPerChunk(16)
+		, rootScanSlotsPerChunk(1024)
 		, fvtest_forceOldResize(0)
 		, fvtest_oldResizeCounter(0)
 #if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC)
@@ -1491,6 +1515,10 @@ public:
 #endif /* OMR_GC_BATCH_CLEAR_TLH */
 		, gcThreadCount(0)
 		, gcThreadCountForced(false)
+		, pauseTimeTarget(0)
+		, pauseTimeTargetPercentile(95)
+		, pauseTimeThroughputFloor(95)
+		, pauseTimeController(NULL)
 #if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC)
 		, scavengerScanOrdering(OMR_GC_SCAVENGER_SCANORDERING_HIERARCHICAL)
 #endif /* OMR_GC_MODRON_SCAVENGER || OMR_GC_VLHGC */
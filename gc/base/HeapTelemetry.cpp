@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+
+#include <string.h>
+
+#include "HeapTelemetry.hpp"
+
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+#include "ConcurrentGC.hpp"
+#include "ConcurrentGCStats.hpp"
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Heap.hpp"
+#include "MemoryPool.hpp"
+#include "MemorySpace.hpp"
+#include "MemorySubSpace.hpp"
+
+MM_HeapTelemetry *
+MM_HeapTelemetry::newInstance(MM_EnvironmentBase *env)
+{
+	MM_HeapTelemetry *telemetry = (MM_HeapTelemetry *)env->getForge()->allocate(sizeof(MM_HeapTelemetry), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != telemetry) {
+		new(telemetry) MM_HeapTelemetry(env);
+		if (!telemetry->initialize(env)) {
+			telemetry->kill(env);
+			telemetry = NULL;
+		}
+	}
+	return telemetry;
+}
+
+MM_HeapTelemetry::MM_HeapTelemetry(MM_EnvironmentBase *env)
+	: MM_BaseVirtual()
+	, _ring(NULL)
+	, _ringSize(env->getExtensions()->heapTelemetrySamples)
+	, _nextIndex(0)
+	, _bytesAllocated(0)
+	, _tlhDiscardedBytes(0)
+{
+	_typeId = __FUNCTION__;
+}
+
+bool
+MM_HeapTelemetry::initialize(MM_EnvironmentBase *env)
+{
+	if (0 == _ringSize) {
+		return false;
+	}
+
+	_ring = (Slot *)env->getForge()->allocate(sizeof(Slot) * _ringSize, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _ring) {
+		return false;
+	}
+	memset(_ring, 0, sizeof(Slot) * _ringSize);
+
+	return true;
+}
+
+void
+MM_HeapTelemetry::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _ring) {
+		env->getForge()->free(_ring);
+		_ring = NULL;
+	}
+}
+
+void
+MM_HeapTelemetry::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+/**
+ * Find the memory pool backing the tenure subspace, descending through subspaces (e.g. flat) that have no pool of their own.
+ */
+MM_MemoryPool *
+MM_HeapTelemetry::getTenureMemoryPool(MM_EnvironmentBase *env)
+{
+	MM_MemoryPool *pool = NULL;
+	MM_MemorySpace *memorySpace = env->getExtensions()->heap->getDefaultMemorySpace();
+	if (NULL != memorySpace) {
+		MM_MemorySubSpace *subspace = memorySpace->getTenureMemorySubSpace();
+		while ((NULL != subspace) && (NULL == (pool = subspace->getMemoryPool()))) {
+			subspace = subspace->getChildren();
+		}
+	}
+	return pool;
+}
+
+bool
+MM_HeapTelemetry::readSlot(uintptr_t index, OMR_GC_HeapTelemetrySample *sample)
+{
+	Slot *slot = &_ring[index % _ringSize];
+	uintptr_t published = (2 * index) + 2;
+
+	if (published != slot->sequence) {
+		return false;
+	}
+	MM_AtomicOperations::readBarrier();
+	*sample = slot->sample;
+	MM_AtomicOperations::readBarrier();
+	/* the slot may have been reclaimed by a writer while it was copied */
+	return published == slot->sequence;
+}
+
+void
+MM_HeapTelemetry::sample(MM_EnvironmentBase *env, OMR_GC_HeapTelemetrySample *sample)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	MM_Heap *heap = extensions->heap;
+	OMR_GC_HeapTelemetrySample current;
+
+	memset(&current, 0, sizeof(current));
+	current.timestamp = omrtime_hires_delta(0, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+
+	current.heapTotal = heap->getActiveMemorySize();
+	current.heapFree = heap->getApproximateActiveFreeMemorySize();
+	current.tenureTotal = heap->getActiveMemorySize(MEMORY_TYPE_OLD);
+	current.tenureFree = heap->getApproximateActiveFreeMemorySize(MEMORY_TYPE_OLD);
+	if (extensions->isScavengerEnabled()) {
+		current.nurseryTotal = heap->getActiveMemorySize(MEMORY_TYPE_NEW);
+		current.nurseryFree = heap->getApproximateActiveFreeMemorySize(MEMORY_TYPE_NEW);
+	}
+
+	current.bytesAllocated = _bytesAllocated;
+	current.tlhDiscardedBytes = _tlhDiscardedBytes;
+
+	MM_MemoryPool *tenurePool = getTenureMemoryPool(env);
+	if (NULL != tenurePool) {
+		uintptr_t poolFree = tenurePool->getApproximateFreeMemorySize();
+		uintptr_t largestFree = tenurePool->getLargestFreeEntry();
+		current.tenureFreeEntryCount = tenurePool->getActualFreeEntryCount();
+		current.tenureLargestFreeEntry = largestFree;
+		/* the largest entry is only maintained by global collections so it may exceed the current free size */
+		if ((0 != poolFree) && (largestFree < poolFree)) {
+			current.tenureFragmentation = (uintptr_t)(((uint64_t)(poolFree - largestFree) * 100) / poolFree);
+		}
+	}
+
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+	if (extensions->isConcurrentMarkEnabled() && (NULL != extensions->getGlobalCollector())) {
+		MM_ConcurrentGCStats *stats = ((MM_ConcurrentGC *)extensions->getGlobalCollector())->getConcurrentGCStats();
+		current.concurrentMarkMode = stats->getExecutionMode();
+		current.concurrentMarkTraced = stats->getTotalTraced();
+		current.concurrentMarkTarget = stats->getTraceSizeTarget();
+	}
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
+
+	uintptr_t index = MM_AtomicOperations::add(&_nextIndex, 1) - 1;
+
+	/* allocation rate is relative to the previous sample in the ring, if it is still there */
+	OMR_GC_HeapTelemetrySample previous;
+	if ((0 < index) && readSlot(index - 1, &previous) && (current.timestamp > previous.timestamp) && (current.bytesAllocated >= previous.bytesAllocated)) {
+		uint64_t elapsed = current.timestamp - previous.timestamp;
+		current.allocationRate = (uintptr_t)(((uint64_t)(current.bytesAllocated - previous.bytesAllocated) * 1000000) / elapsed);
+	}
+
+	Slot *slot = &_ring[index % _ringSize];
+	slot->sequence = (2 * index) + 1;
+	MM_AtomicOperations::writeBarrier();
+	slot->sample = current;
+	MM_AtomicOperations::writeBarrier();
+	slot->sequence = (2 * index) + 2;
+
+	if (NULL != sample) {
+		*sample = current;
+	}
+}
+
+uintptr_t
+MM_HeapTelemetry::exportSamples(OMR_GC_HeapTelemetrySample *samples, uintptr_t maxSamples)
+{
+	uintptr_t end = _nextIndex;
+	uintptr_t available = OMR_MIN(end, OMR_MIN(_ringSize, maxSamples));
+	uintptr_t count = 0;
+
+	for (uintptr_t index = end - available; index < end; index++) {
+		if (readSlot(index, &samples[count])) {
+			count += 1;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#if !defined(HEAPTELEMETRY_HPP_)
+#define HEAPTELEMETRY_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrgc.h"
+#include "modronbase.h"
+
+#include "AtomicOperations.hpp"
+#include "BaseVirtual.hpp"
+
+class MM_EnvironmentBase;
+class MM_MemoryPool;
+
+/**
+ * Records periodic heap samples into a fixed size ring for external monitoring.
+ *
+ * Sampling only reads values the GC already maintains without locking (approximate free sizes,
+ * free list statistics, concurrent mark counters) plus two counters maintained here with atomic
+ * adds on the TLH refresh and out-of-line allocation paths. It can therefore be called at high
+ * frequency from a monitoring thread without acquiring exclusive VM access or waiting for a GC.
+ *
+ * Ring slots are published with a sequence number (odd while a slot is being written) so readers
+ * can copy the ring without locks and skip slots that are overwritten during the copy.
+ *
+ * @ingroup GC_Base_Core
+ */
+class MM_HeapTelemetry : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	struct Slot {
+		volatile uintptr_t sequence; /**< 2 * index + 2 once the sample for index is published, odd while it is written */
+		OMR_GC_HeapTelemetrySample sample;
+	};
+
+	Slot *_ring; /**< fixed size sample ring */
+	uintptr_t _ringSize; /**< number of slots in _ring */
+	volatile uintptr_t _nextIndex; /**< number of samples ever claimed; the next sample is written to slot _nextIndex % _ringSize */
+	volatile uintptr_t _bytesAllocated; /**< bytes handed out to TLHs and out-of-line allocations */
+	volatile uintptr_t _tlhDiscardedBytes; /**< bytes left unused in retired TLHs */
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	bool readSlot(uintptr_t index, OMR_GC_HeapTelemetrySample *sample);
+	MM_MemoryPool *getTenureMemoryPool(MM_EnvironmentBase *env);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_HeapTelemetry *newInstance(MM_EnvironmentBase *env);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Take a sample of the current heap state and publish it in the ring.
+	 * @param env the environment of the sampling thread
+	 * @param sample if not NULL, receives a copy of the published sample
+	 */
+	void sample(MM_EnvironmentBase *env, OMR_GC_HeapTelemetrySample *sample);
+
+	/**
+	 * Copy the most recent samples in the ring, oldest first. Samples overwritten during the copy are skipped.
+	 * @param samples caller-provided array receiving the samples
+	 * @param maxSamples number of entries available in samples
+	 * @return the number of entries written
+	 */
+	uintptr_t exportSamples(OMR_GC_HeapTelemetrySample *samples, uintptr_t maxSamples);
+
+	/**
+	 * Account for memory handed out to a TLH or to an out-of-line allocation.
+	 */
+	MMINLINE void bytesAllocated(uintptr_t bytes)
+	{
+		MM_AtomicOperations::add(&_bytesAllocated, bytes);
+	}
+
+	/**
+	 * Account for the net change of unused memory in retired TLHs (negative when a cached TLH is reused).
+	 */
+	MMINLINE void tlhBytesDiscarded(intptr_t bytes)
+	{
+		MM_AtomicOperations::add(&_tlhDiscardedBytes, (uintptr_t)bytes);
+	}
+
+	MMINLINE uintptr_t getRingSize() { return _ringSize; }
+
+	MM_HeapTelemetry(MM_EnvironmentBase *env);
+};
+
+#endif /* HEAPTELEMETRY_HPP_ */
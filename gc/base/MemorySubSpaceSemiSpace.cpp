@@ -38,6 +38,7 @@
 #include "MemorySubSpace.hpp"
 #include "MemorySubSpaceRegionIterator.hpp"
 #include "MemorySubSpaceSemiSpace.hpp"
+#include "PauseTimeController.hpp"
 #include "PhysicalSubArena.hpp"
 
 #if defined(OMR_VALGRIND_MEMCHECK)
@@ -835,7 +836,10 @@ MM_MemorySubSpaceSemiSpace::checkSubSpaceMemoryPostCollectResize(MM_EnvironmentB
 	MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(env->getOmrVM());
 	uintptr_t regionSize = extensions->getHeap()->getHeapRegionManager()->getRegionSize();
 
-	if(extensions->dynamicNewSpaceSizing) {
+	if (NULL != extensions->pauseTimeController) {
+		/* The pause time controller owns nursery sizing when a pause time goal is set */
+		checkSubSpaceMemoryPauseTimeResize(env);
+	} else if(extensions->dynamicNewSpaceSizing) {
 		bool doDynamicNewSpaceSizing = true;
 		bool debug = extensions->debugDynamicNewSpaceSizing;
 		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
@@ -1006,6 +1010,31 @@ MM_MemorySubSpaceSemiSpace::checkSubSpaceMemoryPostCollectResize(MM_EnvironmentB
 	}
 }
 
+/**
+ * Adjust the sub space memory by applying the pending nursery resize decision of the pause time controller.
+ * Contraction shortens scavenges that push the percentile pause over the goal; expansion reduces scavenge
+ * frequency when the time spent in GC is over the throughput floor.
+ */
+void
+MM_MemorySubSpaceSemiSpace::checkSubSpaceMemoryPauseTimeResize(MM_EnvironmentBase *env)
+{
+	MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(env->getOmrVM());
+	uintptr_t regionSize = extensions->getHeap()->getHeapRegionManager()->getRegionSize();
+	double resizeFactor = extensions->pauseTimeController->consumeNurseryResizeFactor();
+
+	if ((resizeFactor > 0.0)
+			&& (NULL != _physicalSubArena) && _physicalSubArena->canExpand(env) && (maxExpansionInSpace(env) != 0)) {
+		_expansionSize = MM_Math::roundToCeiling(extensions->heapAlignment, (uintptr_t)(getCurrentSize() * resizeFactor));
+		_expansionSize = MM_Math::roundToCeiling(2 * regionSize, _expansionSize);
+		extensions->heap->getResizeStats()->setLastExpandReason(PAUSE_TIME_THROUGHPUT_FLOOR);
+	} else if ((resizeFactor < 0.0)
+			&& (NULL != _physicalSubArena) && _physicalSubArena->canContract(env) && (maxContractionInSpace(env) != 0)) {
+		_contractionSize = MM_Math::roundToCeiling(extensions->heapAlignment, (uintptr_t)(getCurrentSize() * -resizeFactor));
+		_contractionSize = MM_Math::roundToCeiling(regionSize, _contractionSize);
+		extensions->heap->getResizeStats()->setLastContractReason(PAUSE_TIME_TARGET_EXCEEDED);
+	}
+}
+
 /**
  * Adjust the sub space memory consumed after a collect.
  * Adjusting semi space memory consumed after a collect includes changing the tilt and/or
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+
+#include "ObjectAllocationSampler.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+
+MM_ObjectAllocationSampler *
+MM_ObjectAllocationSampler::newInstance(MM_EnvironmentBase *env)
+{
+	MM_ObjectAllocationSampler *sampler = (MM_ObjectAllocationSampler *)env->getForge()->allocate(sizeof(MM_ObjectAllocationSampler), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != sampler) {
+		new(sampler) MM_ObjectAllocationSampler(env);
+		if (!sampler->initialize(env)) {
+			sampler->kill(env);
+			sampler = NULL;
+		}
+	}
+	return sampler;
+}
+
+MM_ObjectAllocationSampler::MM_ObjectAllocationSampler(MM_EnvironmentBase *env)
+	: MM_BaseVirtual()
+	, _topSites(NULL)
+	, _mutex(NULL)
+	, _sampleCount(0)
+	, _samplingInterval(env->getExtensions()->allocationSamplingInterval)
+{
+	_typeId = __FUNCTION__;
+}
+
+bool
+MM_ObjectAllocationSampler::initialize(MM_EnvironmentBase *env)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	if ((0 == _samplingInterval) || (0 == extensions->allocationSamplingTopK)) {
+		return false;
+	}
+
+	if (0 != omrthread_monitor_init_with_name(&_mutex, 0, "MM_ObjectAllocationSampler::_mutex")) {
+		return false;
+	}
+
+	_topSites = spaceSavingNew(env->getPortLibrary(), (uint32_t)extensions->allocationSamplingTopK);
+	if (NULL == _topSites) {
+		return false;
+	}
+
+	return true;
+}
+
+void
+MM_ObjectAllocationSampler::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _topSites) {
+		spaceSavingFree(_topSites);
+		_topSites = NULL;
+	}
+	if (NULL != _mutex) {
+		omrthread_monitor_destroy(_mutex);
+		_mutex = NULL;
+	}
+}
+
+void
+MM_ObjectAllocationSampler::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+void
+MM_ObjectAllocationSampler::sample(MM_EnvironmentBase *env, omrobjectptr_t object, uintptr_t sizeInBytes)
+{
+	uintptr_t site = env->objectAllocationSampled(object, sizeInBytes);
+
+	/* A zero site means the language chose not to attribute this sample */
+	if (0 != site) {
+		omrthread_monitor_enter(_mutex);
+		spaceSavingUpdate(_topSites, (void *)site, 1);
+		_sampleCount += 1;
+		omrthread_monitor_exit(_mutex);
+	}
+}
+
+uintptr_t
+MM_ObjectAllocationSampler::exportSamples(OMR_GC_AllocationSample *samples, uintptr_t maxSamples, bool reset)
+{
+	omrthread_monitor_enter(_mutex);
+	uintptr_t count = OMR_MIN(maxSamples, spaceSavingGetCurSize(_topSites));
+	for (uintptr_t i = 0; i < count; i++) {
+		/* space saving ranks are 1-based */
+		samples[i].site = (uintptr_t)spaceSavingGetKthMostFreq(_topSites, i + 1);
+		samples[i].count = spaceSavingGetKthMostFreqCount(_topSites, i + 1);
+		samples[i].estimatedBytes = samples[i].count * _samplingInterval;
+	}
+	if (reset) {
+		spaceSavingClear(_topSites);
+		_sampleCount = 0;
+	}
+	omrthread_monitor_exit(_mutex);
+
+	return count;
+}
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#if !defined(OBJECTALLOCATIONSAMPLER_HPP_)
+#define OBJECTALLOCATIONSAMPLER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrgc.h"
+#include "omrthread.h"
+#include "modronbase.h"
+#include "spacesaving.h"
+
+#include "BaseVirtual.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Aggregates allocation samples into a top-K table of language-defined allocation sites.
+ *
+ * Samples are taken at TLH retirement, once for every extensions->allocationSamplingInterval bytes
+ * allocated by a thread, so the inline allocation path is not affected. Each sampled object is passed
+ * to the environment delegate (objectAllocationSampled()) which answers the allocation site to charge
+ * it to. Sites are tracked with the space saving algorithm (OMRSpaceSaving) so the memory used is
+ * bounded by extensions->allocationSamplingTopK regardless of the number of distinct sites.
+ *
+ * @ingroup GC_Base_Core
+ */
+class MM_ObjectAllocationSampler : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	OMRSpaceSaving *_topSites; /**< top-K allocation sites, keyed by the site answered by the environment delegate */
+	omrthread_monitor_t _mutex; /**< serializes updates and exports of _topSites */
+	uintptr_t _sampleCount; /**< total samples charged to a site since startup or the last reset */
+	uintptr_t _samplingInterval; /**< bytes allocated per thread between two samples */
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_ObjectAllocationSampler *newInstance(MM_EnvironmentBase *env);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Charge a sampled object to its allocation site.
+	 * @param env the environment of the thread that allocated the object
+	 * @param object the sampled object (fully initialized)
+	 * @param sizeInBytes the consumed size of the object
+	 */
+	void sample(MM_EnvironmentBase *env, omrobjectptr_t object, uintptr_t sizeInBytes);
+
+	/**
+	 * Copy the most frequently sampled allocation sites, hottest first.
+	 * @param samples caller-provided array receiving the sites
+	 * @param maxSamples number of entries available in samples
+	 * @param reset if true, clear the table after the copy
+	 * @return the number of entries written
+	 */
+	uintptr_t exportSamples(OMR_GC_AllocationSample *samples, uintptr_t maxSamples, bool reset);
+
+	MMINLINE uintptr_t getSamplingInterval() { return _samplingInterval; }
+	MMINLINE uintptr_t getSampleCount() { return _sampleCount; }
+
+	MM_ObjectAllocationSampler(MM_EnvironmentBase *env);
+};
+
+#endif /* OBJECTALLOCATIONSAMPLER_HPP_ */
@@ -36,6 +36,7 @@
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
 #include "Heap.hpp"
+#include "PauseTimeController.hpp"
 #include "Task.hpp"
 
 #include "ParallelDispatcher.hpp"
@@ -458,6 +459,11 @@ MM_ParallelDispatcher::adjustThreadCount(uintptr_t maxThreadCount)
 			Trc_MM_ParallelDispatcher_adjustThreadCount_ReducedCPU(activeCPUs);
 			toReturn = activeCPUs;
 		}
+
+		/* Let the pause time controller trim helpers while pauses are comfortably within the goal */
+		if (NULL != _extensions->pauseTimeController) {
+			toReturn = _extensions->pauseTimeController->adjustThreadCount(toReturn);
+		}
 	}
 	
 	return toReturn;
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "ModronAssertions.h"
+
+#include "ParallelRootScanner.hpp"
+
+#include "Dispatcher.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "HashTableIterator.hpp"
+#include "OMRVMThreadListIterator.hpp"
+#include "SublistIterator.hpp"
+#include "SublistPool.hpp"
+#include "SublistPuddle.hpp"
+#include "SublistSlotIterator.hpp"
+#include "Task.hpp"
+
+MM_ParallelRootScanner::MM_ParallelRootScanner(MM_EnvironmentBase *env, bool singleThread)
+	: MM_BaseVirtual()
+	, _scanningEntity(RootScannerEntity_None)
+	, _entityStartScanTime(0)
+	, _extensions(env->getExtensions())
+	/* a thread outside a task (e.g. a mutator paying concurrent mark tax) has no work units to claim */
+	, _singleThread(singleThread || (NULL == env->_currentTask))
+	, _threadsPerChunk(env->getExtensions()->rootScanThreadsPerChunk)
+	, _slotsPerChunk(env->getExtensions()->rootScanSlotsPerChunk)
+{
+	_typeId = __FUNCTION__;
+}
+
+bool
+MM_ParallelRootScanner::claimChunk(MM_EnvironmentBase *env)
+{
+	return _singleThread || J9MODRON_HANDLE_NEXT_WORK_UNIT(env);
+}
+
+void
+MM_ParallelRootScanner::reportScanningStarted(MM_EnvironmentBase *env, RootScannerEntity entity)
+{
+	_scanningEntity = entity;
+	if (_extensions->rootScannerStatsEnabled) {
+		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+		_entityStartScanTime = omrtime_hires_clock();
+	}
+}
+
+void
+MM_ParallelRootScanner::reportScanningEnded(MM_EnvironmentBase *env)
+{
+	if (_extensions->rootScannerStatsEnabled) {
+		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+		uint64_t scanTime = omrtime_hires_delta(_entityStartScanTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		MM_RootScannerStats *stats = &env->_rootScannerStats;
+
+		stats->_statsUsed = true;
+		stats->_entityScanTime[_scanningEntity] += OMR_MAX(scanTime, 1);
+		if (scanTime > stats->_maxIncrementTime) {
+			stats->_maxIncrementTime = scanTime;
+			stats->_maxIncrementEntity = _scanningEntity;
+		}
+	}
+	_scanningEntity = RootScannerEntity_None;
+}
+
+void
+MM_ParallelRootScanner::doThread(MM_EnvironmentBase *env, OMR_VMThread *walkThread)
+{
+	Assert_MM_unreachable();
+}
+
+void
+MM_ParallelRootScanner::doHashTableEntry(MM_EnvironmentBase *env, J9HashTable *hashTable, void *entry)
+{
+	Assert_MM_unreachable();
+}
+
+void
+MM_ParallelRootScanner::doSublistSlot(MM_EnvironmentBase *env, MM_SublistPool *sublistPool, uintptr_t *slot)
+{
+	Assert_MM_unreachable();
+}
+
+void
+MM_ParallelRootScanner::scanThreads(MM_EnvironmentBase *env, RootScannerEntity entity)
+{
+	reportScanningStarted(env, entity);
+
+	GC_OMRVMThreadListIterator threadListIterator(env->getOmrVM());
+	OMR_VMThread *walkThread = NULL;
+	uintptr_t position = 0;
+	bool claimed = false;
+	while (NULL != (walkThread = threadListIterator.nextOMRVMThread())) {
+		if (0 == (position % _threadsPerChunk)) {
+			claimed = claimChunk(env);
+		}
+		if (claimed) {
+			doThread(env, walkThread);
+		}
+		position += 1;
+	}
+
+	reportScanningEnded(env);
+}
+
+void
+MM_ParallelRootScanner::scanHashTable(MM_EnvironmentBase *env, J9HashTable *hashTable, RootScannerEntity entity)
+{
+	reportScanningStarted(env, entity);
+
+	GC_HashTableIterator hashTableIterator(hashTable);
+	void **entry = NULL;
+	uintptr_t position = 0;
+	bool claimed = false;
+	while (NULL != (entry = hashTableIterator.nextSlot())) {
+		if (0 == (position % _slotsPerChunk)) {
+			claimed = claimChunk(env);
+		}
+		if (claimed) {
+			doHashTableEntry(env, hashTable, (void *)entry);
+		}
+		position += 1;
+	}
+
+	reportScanningEnded(env);
+}
+
+void
+MM_ParallelRootScanner::scanSublist(MM_EnvironmentBase *env, MM_SublistPool *sublistPool, RootScannerEntity entity)
+{
+	reportScanningStarted(env, entity);
+
+	GC_SublistIterator sublistIterator(sublistPool);
+	MM_SublistPuddle *puddle = NULL;
+	while (NULL != (puddle = sublistIterator.nextList())) {
+		/* the chunk boundaries only depend on the puddle size, so every thread claims the same chunks */
+		uintptr_t slotCount = puddle->consumedCount();
+		for (uintptr_t startIndex = 0; startIndex < slotCount; startIndex += _slotsPerChunk) {
+			if (claimChunk(env)) {
+				GC_SublistSlotIterator slotIterator(puddle, startIndex, startIndex + _slotsPerChunk);
+				uintptr_t *slot = NULL;
+				while (NULL != (slot = (uintptr_t *)slotIterator.nextSlot())) {
+					doSublistSlot(env, sublistPool, slot);
+				}
+			}
+		}
+	}
+
+	reportScanningEnded(env);
+}
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#if !defined(PARALLELROOTSCANNER_HPP_)
+#define PARALLELROOTSCANNER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrhashtable.h"
+#include "modronbase.h"
+
+#include "BaseVirtual.hpp"
+#include "RootScannerTypes.h"
+
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+class MM_SublistPool;
+struct OMR_VMThread;
+
+/**
+ * Scan large root sets in parallel by splitting them into chunks that GC threads claim dynamically.
+ *
+ * Every GC thread participating in the current task walks the same root set and claims chunks of it
+ * through the task's work units (J9MODRON_HANDLE_NEXT_WORK_UNIT), so no thread is bound to a fixed
+ * share of the roots and a thread that finishes early keeps claiming chunks. Thread lists are split
+ * every extensions->rootScanThreadsPerChunk threads, hash tables and sublists every
+ * extensions->rootScanSlotsPerChunk entries (sublist chunks never span puddles).
+ *
+ * A thread that is not running a task, such as a mutator paying concurrent mark tax, scans every chunk itself.
+ *
+ * Every thread of the task must call the same scan functions in the same order, and the root sets
+ * must not change while they are scanned. Subclasses implement the visitors for the root sets they scan.
+ * Time spent per root scanner entity is recorded in the thread's MM_RootScannerStats when
+ * extensions->rootScannerStatsEnabled is set.
+ *
+ * @ingroup GC_Base_Core
+ */
+class MM_ParallelRootScanner : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	RootScannerEntity _scanningEntity; /**< entity being scanned by this thread, for stats */
+	uint64_t _entityStartScanTime; /**< start time of the current entity scan, for stats */
+
+protected:
+	MM_GCExtensionsBase *_extensions;
+	bool _singleThread; /**< true if the calling thread scans every chunk (always when not running in a task) */
+	uintptr_t _threadsPerChunk; /**< threads per claimable chunk of the thread list */
+	uintptr_t _slotsPerChunk; /**< entries per claimable chunk of a hash table or sublist */
+
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	void reportScanningStarted(MM_EnvironmentBase *env, RootScannerEntity entity);
+	void reportScanningEnded(MM_EnvironmentBase *env);
+
+protected:
+	/**
+	 * Claim the next chunk of the root set being scanned.
+	 * @return true if the calling thread must scan the chunk
+	 */
+	bool claimChunk(MM_EnvironmentBase *env);
+
+	/**
+	 * Scan the roots held by a VM thread (called by scanThreads()).
+	 */
+	virtual void doThread(MM_EnvironmentBase *env, OMR_VMThread *walkThread);
+
+	/**
+	 * Scan the roots held by a hash table entry (called by scanHashTable()).
+	 */
+	virtual void doHashTableEntry(MM_EnvironmentBase *env, J9HashTable *hashTable, void *entry);
+
+	/**
+	 * Scan a sublist slot (called by scanSublist()). The slot may be NULL (removed entry).
+	 */
+	virtual void doSublistSlot(MM_EnvironmentBase *env, MM_SublistPool *sublistPool, uintptr_t *slot);
+
+public:
+	/**
+	 * Scan the VM thread list in chunks of _threadsPerChunk threads.
+	 */
+	void scanThreads(MM_EnvironmentBase *env, RootScannerEntity entity = RootScannerEntity_Threads);
+
+	/**
+	 * Scan the entries of a hash table in chunks of _slotsPerChunk entries.
+	 */
+	void scanHashTable(MM_EnvironmentBase *env, J9HashTable *hashTable, RootScannerEntity entity);
+
+	/**
+	 * Scan the slots of a sublist in chunks of at most _slotsPerChunk slots.
+	 */
+	void scanSublist(MM_EnvironmentBase *env, MM_SublistPool *sublistPool, RootScannerEntity entity);
+
+	MM_ParallelRootScanner(MM_EnvironmentBase *env, bool singleThread = false);
+};
+
+#endif /* PARALLELROOTSCANNER_HPP_ */
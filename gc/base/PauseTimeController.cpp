@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "mmprivatehook.h"
+#include "mmprivatehook_internal.h"
+
+#include "PauseTimeController.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Math.hpp"
+
+/* Weight given to the most recent collection when averaging the GC time ratio */
+#define PAUSE_TIME_CONTROLLER_GC_RATIO_WEIGHT ((float)0.3)
+/* Percentile pauses below this fraction of the target leave room to trade pause time for throughput */
+#define PAUSE_TIME_CONTROLLER_EXPAND_HEADROOM 0.8
+/* Percentile pauses below this fraction of the target leave room to run with fewer GC threads */
+#define PAUSE_TIME_CONTROLLER_THREAD_HEADROOM 0.5
+/* Decay applied to the concurrent kickoff boost when global pauses are within target */
+#define PAUSE_TIME_CONTROLLER_KICKOFF_BOOST_DECAY ((float)0.9)
+
+MM_PauseTimeController *
+MM_PauseTimeController::newInstance(MM_EnvironmentBase *env)
+{
+	MM_PauseTimeController *controller = (MM_PauseTimeController *)env->getForge()->allocate(sizeof(MM_PauseTimeController), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != controller) {
+		new(controller) MM_PauseTimeController(env);
+		if (!controller->initialize(env)) {
+			controller->kill(env);
+			controller = NULL;
+		}
+	}
+	return controller;
+}
+
+MM_PauseTimeController::MM_PauseTimeController(MM_EnvironmentBase *env)
+	: MM_BaseVirtual()
+	, _extensions(env->getExtensions())
+	, _pauseHistoryCount(0)
+	, _pauseHistoryNext(0)
+	, _collectionStartTime(0)
+	, _lastCollectionEndTime(0)
+	, _lastPauseTime(0)
+	, _percentilePauseTime(0)
+	, _gcTimeRatio(0.0f)
+	, _nurseryResizeFactor(0.0)
+	, _concurrentKickoffBoost(1.0f)
+	, _gcThreadCountLimit(UDATA_MAX)
+{
+	_typeId = __FUNCTION__;
+}
+
+bool
+MM_PauseTimeController::initialize(MM_EnvironmentBase *env)
+{
+	if ((0 == _extensions->pauseTimeTargetPercentile) || (100 < _extensions->pauseTimeTargetPercentile)) {
+		return false;
+	}
+	if (100 <= _extensions->pauseTimeThroughputFloor) {
+		return false;
+	}
+
+	memset(_pauseHistory, 0, sizeof(_pauseHistory));
+	if (0 != _extensions->gcThreadCount) {
+		_gcThreadCountLimit = _extensions->gcThreadCount;
+	}
+
+	return true;
+}
+
+void
+MM_PauseTimeController::tearDown(MM_EnvironmentBase *env)
+{
+}
+
+void
+MM_PauseTimeController::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+void
+MM_PauseTimeController::collectionStarted(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	_collectionStartTime = omrtime_hires_clock();
+}
+
+void
+MM_PauseTimeController::collectionCompleted(MM_EnvironmentBase *env, bool globalCollection)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uint64_t endTime = omrtime_hires_clock();
+
+	/* (protect from malicious clock jitters) */
+	if (endTime <= _collectionStartTime) {
+		return;
+	}
+
+	_lastPauseTime = omrtime_hires_delta(_collectionStartTime, endTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+	_pauseHistory[_pauseHistoryNext] = _lastPauseTime;
+	_pauseHistoryNext = (_pauseHistoryNext + 1) % PAUSE_TIME_CONTROLLER_HISTORY_SIZE;
+	if (_pauseHistoryCount < PAUSE_TIME_CONTROLLER_HISTORY_SIZE) {
+		_pauseHistoryCount += 1;
+	}
+	_percentilePauseTime = calculatePercentilePauseTime();
+
+	/* The ratio is measured from the end of the previous pause, so the first collection only seeds the timestamp */
+	if ((0 != _lastCollectionEndTime) && (_lastCollectionEndTime < _collectionStartTime)) {
+		uint64_t intervalTime = omrtime_hires_delta(_lastCollectionEndTime, endTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		if (0 != intervalTime) {
+			float newRatio = (float)((double)_lastPauseTime / (double)intervalTime);
+			_gcTimeRatio = MM_Math::weightedAverage(_gcTimeRatio, newRatio, PAUSE_TIME_CONTROLLER_GC_RATIO_WEIGHT);
+		}
+	}
+	_lastCollectionEndTime = endTime;
+
+	updateActuators(env, globalCollection);
+	reportUpdate(env, globalCollection);
+}
+
+/**
+ * Compute the pause time at the configured percentile over the pause history (nearest-rank method).
+ * @return the percentile pause time in microseconds
+ */
+uint64_t
+MM_PauseTimeController::calculatePercentilePauseTime()
+{
+	uint64_t sorted[PAUSE_TIME_CONTROLLER_HISTORY_SIZE];
+	uintptr_t count = _pauseHistoryCount;
+
+	/* insertion sort into a copy - the history is small */
+	for (uintptr_t i = 0; i < count; i++) {
+		uint64_t value = _pauseHistory[i];
+		uintptr_t j = i;
+		while ((j > 0) && (sorted[j - 1] > value)) {
+			sorted[j] = sorted[j - 1];
+			j -= 1;
+		}
+		sorted[j] = value;
+	}
+
+	uintptr_t rank = (count * _extensions->pauseTimeTargetPercentile + 99) / 100;
+	if (0 == rank) {
+		rank = 1;
+	}
+	return sorted[rank - 1];
+}
+
+/**
+ * Derive new nursery, concurrent kickoff and thread count decisions from the current pause and throughput measurements.
+ */
+void
+MM_PauseTimeController::updateActuators(MM_EnvironmentBase *env, bool globalCollection)
+{
+	double pauseError = (double)_percentilePauseTime / (double)(_extensions->pauseTimeTarget * 1000);
+	double gcTimeBudget = (double)(100 - _extensions->pauseTimeThroughputFloor) / 100.0;
+	uintptr_t gcThreadCount = OMR_MAX(_extensions->gcThreadCount, 1);
+
+	if (pauseError > 1.0) {
+		/* Percentile pause over target: shrink the nursery after long scavenges, start concurrent mark earlier after
+		 * long global collections, and bring back any GC threads that were trimmed.
+		 */
+		if (globalCollection) {
+			float boost = _concurrentKickoffBoost * (float)(1.0 + OMR_MIN(0.5, pauseError - 1.0));
+			_concurrentKickoffBoost = OMR_MIN(boost, PAUSE_TIME_CONTROLLER_MAXIMUM_KICKOFF_BOOST);
+		} else {
+			_nurseryResizeFactor = -OMR_MIN(PAUSE_TIME_CONTROLLER_MAXIMUM_NURSERY_CONTRACTION, (pauseError - 1.0) / 2.0);
+		}
+		if (_gcThreadCountLimit < gcThreadCount) {
+			_gcThreadCountLimit += 1;
+		}
+	} else {
+		if (globalCollection) {
+			_concurrentKickoffBoost = OMR_MAX(_concurrentKickoffBoost * PAUSE_TIME_CONTROLLER_KICKOFF_BOOST_DECAY, 1.0f);
+		}
+
+		if (((double)_gcTimeRatio > gcTimeBudget) && (pauseError < PAUSE_TIME_CONTROLLER_EXPAND_HEADROOM)) {
+			/* Throughput below the floor with pause headroom: a larger nursery reduces scavenge frequency */
+			double desiredExpansion = ((double)_gcTimeRatio - gcTimeBudget) / gcTimeBudget;
+			_nurseryResizeFactor = OMR_MIN(PAUSE_TIME_CONTROLLER_MAXIMUM_NURSERY_EXPANSION, desiredExpansion);
+		} else if ((pauseError < PAUSE_TIME_CONTROLLER_THREAD_HEADROOM) && ((double)_gcTimeRatio < (gcTimeBudget / 2.0))) {
+			/* Well within both goals: give a GC thread back to the application */
+			if (_gcThreadCountLimit > 1) {
+				_gcThreadCountLimit = OMR_MIN(_gcThreadCountLimit, gcThreadCount) - 1;
+			}
+		}
+	}
+}
+
+void
+MM_PauseTimeController::reportUpdate(MM_EnvironmentBase *env, bool globalCollection)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	TRIGGER_J9HOOK_MM_PRIVATE_PAUSE_TIME_CONTROLLER_UPDATE(
+		_extensions->privateHookInterface,
+		env->getOmrVMThread(),
+		omrtime_hires_clock(),
+		J9HOOK_MM_PRIVATE_PAUSE_TIME_CONTROLLER_UPDATE,
+		globalCollection ? TRUE : FALSE,
+		_extensions->pauseTimeTarget,
+		_extensions->pauseTimeTargetPercentile,
+		_percentilePauseTime,
+		_lastPauseTime,
+		_gcTimeRatio,
+		_extensions->pauseTimeThroughputFloor,
+		_nurseryResizeFactor,
+		_gcThreadCountLimit,
+		_concurrentKickoffBoost);
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#if !defined(PAUSETIMECONTROLLER_HPP_)
+#define PAUSETIMECONTROLLER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "modronbase.h"
+
+#include "BaseVirtual.hpp"
+
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+
+/* Number of most recent pauses used to compute the pause time percentile */
+#define PAUSE_TIME_CONTROLLER_HISTORY_SIZE 32
+
+/* Bounds on the adjustments a single collection may request */
+#define PAUSE_TIME_CONTROLLER_MAXIMUM_NURSERY_CONTRACTION 0.25
+#define PAUSE_TIME_CONTROLLER_MAXIMUM_NURSERY_EXPANSION 0.25
+#define PAUSE_TIME_CONTROLLER_MAXIMUM_KICKOFF_BOOST ((float)4.0)
+
+/**
+ * Feedback controller that derives GC tuning from a single pause time goal.
+ *
+ * After every (non-explicit, outermost) collection the controller records the pause, recomputes
+ * the pause time at the configured percentile over the recent history and the fraction of wall
+ * time spent in stop-the-world collection, and updates three actuators consumed by the collectors:
+ *  - a nursery resize factor (MM_MemorySubSpaceSemiSpace), replacing the dynamic new space sizing time ratio heuristic
+ *  - a concurrent kickoff boost (MM_ConcurrentGC::tuneToHeap), to start concurrent mark earlier when global pauses run long
+ *  - a GC thread count limit (MM_ParallelDispatcher::adjustThreadCount), to trim helper threads when pauses are comfortably short
+ *
+ * The controller is created only when extensions->pauseTimeTarget is non-zero.
+ *
+ * @ingroup GC_Base_Core
+ */
+class MM_PauseTimeController : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	MM_GCExtensionsBase *_extensions;
+	uint64_t _pauseHistory[PAUSE_TIME_CONTROLLER_HISTORY_SIZE]; /**< circular buffer of the most recent pause times (microseconds) */
+	uintptr_t _pauseHistoryCount; /**< number of valid entries in _pauseHistory */
+	uintptr_t _pauseHistoryNext; /**< index of the next slot to be written in _pauseHistory */
+	uint64_t _collectionStartTime; /**< hires timestamp taken at the start of the current collection */
+	uint64_t _lastCollectionEndTime; /**< hires timestamp taken at the end of the previous collection */
+	uint64_t _lastPauseTime; /**< duration of the most recent pause (microseconds) */
+	uint64_t _percentilePauseTime; /**< pause time at the target percentile over the history (microseconds) */
+	float _gcTimeRatio; /**< weighted average of the fraction of wall time spent in stop-the-world collection */
+	double _nurseryResizeFactor; /**< pending nursery resize request: positive to expand, negative to contract, as a fraction of the current size */
+	float _concurrentKickoffBoost; /**< multiplier (>= 1.0) applied to the concurrent kickoff threshold */
+	uintptr_t _gcThreadCountLimit; /**< upper bound on active GC threads recommended by the controller */
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	uint64_t calculatePercentilePauseTime();
+	void updateActuators(MM_EnvironmentBase *env, bool globalCollection);
+	void reportUpdate(MM_EnvironmentBase *env, bool globalCollection);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_PauseTimeController *newInstance(MM_EnvironmentBase *env);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Record the start of a stop-the-world collection.
+	 */
+	void collectionStarted(MM_EnvironmentBase *env);
+
+	/**
+	 * Record the end of a stop-the-world collection and recompute the controller outputs.
+	 * @param globalCollection true if the pause included a global collection
+	 */
+	void collectionCompleted(MM_EnvironmentBase *env, bool globalCollection);
+
+	/**
+	 * Answer the pending nursery resize request and clear it, so that each decision is applied once.
+	 * @return fraction of the current nursery size to expand (positive) or contract (negative) by
+	 */
+	MMINLINE double
+	consumeNurseryResizeFactor()
+	{
+		double factor = _nurseryResizeFactor;
+		_nurseryResizeFactor = 0.0;
+		return factor;
+	}
+
+	/**
+	 * Limit a proposed GC thread count by the controller recommendation.
+	 * @param threadCount the thread count proposed by the dispatcher
+	 * @return the thread count to use
+	 */
+	MMINLINE uintptr_t
+	adjustThreadCount(uintptr_t threadCount)
+	{
+		return OMR_MIN(threadCount, _gcThreadCountLimit);
+	}
+
+	MMINLINE float getConcurrentKickoffBoost() { return _concurrentKickoffBoost; }
+	MMINLINE uint64_t getLastPauseTime() { return _lastPauseTime; }
+	MMINLINE uint64_t getPercentilePauseTime() { return _percentilePauseTime; }
+	MMINLINE float getGCTimeRatio() { return _gcTimeRatio; }
+	MMINLINE double getNurseryResizeFactor() { return _nurseryResizeFactor; }
+	MMINLINE uintptr_t getGCThreadCountLimit() { return _gcThreadCountLimit; }
+
+	MM_PauseTimeController(MM_EnvironmentBase *env);
+};
+
+#endif /* PAUSETIMECONTROLLER_HPP_ */
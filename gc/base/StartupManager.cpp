@@ -50,6 +50,26 @@
 #define OMR_XGCBUFFERED_LOGGING_LENGTH 20
 #define OMR_XGCTHREADS "-Xgcthreads"
 #define OMR_XGCTHREADS_LENGTH 11
+#define OMR_XGCPAUSETIMETARGET "-Xgc:pauseTimeTarget="
+#define OMR_XGCPAUSETIMETARGET_LENGTH 21
+#define OMR_XGCPAUSETIMEPERCENTILE "-Xgc:pauseTimePercentile="
+#define OMR_XGCPAUSETIMEPERCENTILE_LENGTH 25
+#define OMR_XGCPAUSETIMETHROUGHPUTFLOOR "-Xgc:pauseTimeThroughputFloor="
+#define OMR_XGCPAUSETIMETHROUGHPUTFLOOR_LENGTH 30
+#define OMR_XGCALLOCATIONSAMPLINGINTERVAL "-Xgc:allocationSamplingInterval="
+#define OMR_XGCALLOCATIONSAMPLINGINTERVAL_LENGTH 32
+#define OMR_XGCALLOCATIONSAMPLINGTOPK "-Xgc:allocationSamplingTopK="
+#define OMR_XGCALLOCATIONSAMPLINGTOPK_LENGTH 28
+#define OMR_XGCHEAPTELEMETRYSAMPLES "-Xgc:heapTelemetrySamples="
+#define OMR_XGCHEAPTELEMETRYSAMPLES_LENGTH 26
+#define OMR_XGCROOTSCANTHREADSPERCHUNK "-Xgc:rootScanThreadsPerChunk="
+#define OMR_XGCROOTSCANTHREADSPERCHUNK_LENGTH 29
+#define OMR_XGCROOTSCANSLOTSPERCHUNK "-Xgc:rootScanSlotsPerChunk="
+#define OMR_XGCROOTSCANSLOTSPERCHUNK_LENGTH 27
+#if defined(OMR_GC_MODRON_SCAVENGER)
+#define OMR_XGCREMEMBEREDSETSCANCHUNKSIZE "-Xgc:rememberedSetScanChunkSize="
+#define OMR_XGCREMEMBEREDSETSCANCHUNKSIZE_LENGTH 32
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 
 uintptr_t
 MM_StartupManager::getUDATAValue(char *option, uintptr_t *outputValue)
@@ -295,7 +315,82 @@ MM_StartupManager::handleOption(MM_GCExtensionsBase *extensions, char *option)
 			extensions->gcThreadCount = forcedThreadCount;
 			extensions->gcThreadCountForced = true;
 		}
-	} else {
+	}
+	else if (0 == strncmp(option, OMR_XGCPAUSETIMETARGET, OMR_XGCPAUSETIMETARGET_LENGTH)) {
+		uintptr_t pauseTimeTarget = 0;
+		if (0 >= getUDATAValue(option + OMR_XGCPAUSETIMETARGET_LENGTH, &pauseTimeTarget)) {
+			result = false;
+		} else {
+			extensions->pauseTimeTarget = pauseTimeTarget;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCPAUSETIMEPERCENTILE, OMR_XGCPAUSETIMEPERCENTILE_LENGTH)) {
+		uintptr_t percentile = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCPAUSETIMEPERCENTILE_LENGTH, &percentile)) || (0 == percentile) || (100 < percentile)) {
+			result = false;
+		} else {
+			extensions->pauseTimeTargetPercentile = percentile;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCPAUSETIMETHROUGHPUTFLOOR, OMR_XGCPAUSETIMETHROUGHPUTFLOOR_LENGTH)) {
+		uintptr_t throughputFloor = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCPAUSETIMETHROUGHPUTFLOOR_LENGTH, &throughputFloor)) || (100 <= throughputFloor)) {
+			result = false;
+		} else {
+			extensions->pauseTimeThroughputFloor = throughputFloor;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCALLOCATIONSAMPLINGINTERVAL, OMR_XGCALLOCATIONSAMPLINGINTERVAL_LENGTH)) {
+		uintptr_t samplingInterval = 0;
+		if (0 >= getUDATAValue(option + OMR_XGCALLOCATIONSAMPLINGINTERVAL_LENGTH, &samplingInterval)) {
+			result = false;
+		} else {
+			extensions->allocationSamplingInterval = samplingInterval;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCALLOCATIONSAMPLINGTOPK, OMR_XGCALLOCATIONSAMPLINGTOPK_LENGTH)) {
+		uintptr_t topK = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCALLOCATIONSAMPLINGTOPK_LENGTH, &topK)) || (0 == topK) || (UINT32_MAX < topK)) {
+			result = false;
+		} else {
+			extensions->allocationSamplingTopK = topK;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCHEAPTELEMETRYSAMPLES, OMR_XGCHEAPTELEMETRYSAMPLES_LENGTH)) {
+		uintptr_t samples = 0;
+		if (0 >= getUDATAValue(option + OMR_XGCHEAPTELEMETRYSAMPLES_LENGTH, &samples)) {
+			result = false;
+		} else {
+			extensions->heapTelemetrySamples = samples;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCROOTSCANTHREADSPERCHUNK, OMR_XGCROOTSCANTHREADSPERCHUNK_LENGTH)) {
+		uintptr_t threadsPerChunk = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCROOTSCANTHREADSPERCHUNK_LENGTH, &threadsPerChunk)) || (0 == threadsPerChunk)) {
+			result = false;
+		} else {
+			extensions->rootScanThreadsPerChunk = threadsPerChunk;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCROOTSCANSLOTSPERCHUNK, OMR_XGCROOTSCANSLOTSPERCHUNK_LENGTH)) {
+		uintptr_t slotsPerChunk = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCROOTSCANSLOTSPERCHUNK_LENGTH, &slotsPerChunk)) || (0 == slotsPerChunk)) {
+			result = false;
+		} else {
+			extensions->rootScanSlotsPerChunk = slotsPerChunk;
+		}
+	}
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	else if (0 == strncmp(option, OMR_XGCREMEMBEREDSETSCANCHUNKSIZE, OMR_XGCREMEMBEREDSETSCANCHUNKSIZE_LENGTH)) {
+		uintptr_t chunkSize = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCREMEMBEREDSETSCANCHUNKSIZE_LENGTH, &chunkSize)) || (0 == chunkSize)) {
+			result = false;
+		} else {
+			extensions->rememberedSetScanChunkSize = chunkSize;
+		}
+	}
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+	else {
 		/* unknown option */
 		result = false;
 	}
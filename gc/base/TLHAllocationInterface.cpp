@@ -40,8 +40,10 @@
 #include "Forge.hpp"
 #include "FrequentObjectsStats.hpp"
 #include "GCExtensionsBase.hpp"
+#include "HeapTelemetry.hpp"
 #include "MemorySpace.hpp"
 #include "MemorySubSpace.hpp"
+#include "ObjectAllocationSampler.hpp"
 
 #if defined(OMR_GC_THREAD_LOCAL_HEAP)
 /**
@@ -207,6 +209,17 @@ MM_TLHAllocationInterface::allocateObject(MM_EnvironmentBase *env, MM_AllocateDe
 		_stats._allocationBytes += allocDescription->getContiguousBytes();
 		_stats._allocationCount += 1;
 
+		if (NULL != env->getExtensions()->allocationSampler) {
+			/* Objects allocated outside a TLH are not initialized yet and cannot be sampled here; they are
+			 * counted so that sampling points in later TLHs stay spaced by the sampling interval.
+			 */
+			uintptr_t interval = env->getExtensions()->allocationSampler->getSamplingInterval();
+			env->_allocationSamplingBytes = (env->_allocationSamplingBytes + allocDescription->getContiguousBytes()) % interval;
+		}
+
+		if (NULL != env->getExtensions()->heapTelemetry) {
+			env->getExtensions()->heapTelemetry->bytesAllocated(allocDescription->getContiguousBytes());
+		}
 	}
 
 	env->_oolTraceAllocationBytes += (_stats.bytesAllocated() - _bytesAllocatedBase); /* Increment by bytes allocated */
@@ -42,11 +42,13 @@
 #include "EnvironmentBase.hpp"
 #include "FrequentObjectsStats.hpp"
 #include "GCExtensionsBase.hpp"
+#include "HeapTelemetry.hpp"
 #include "Math.hpp"
 #include "MemoryPool.hpp"
 #include "MemorySpace.hpp"
 #include "MemorySubSpace.hpp"
 #include "ObjectAllocationInterface.hpp"
+#include "ObjectAllocationSampler.hpp"
 #include "ObjectHeapIteratorAddressOrderedList.hpp"
 
 #if defined(OMR_VALGRIND_MEMCHECK)
@@ -173,6 +175,8 @@ MM_TLHAllocationSupport::refresh(MM_EnvironmentBase *env, MM_AllocateDescription
 	MM_AllocationStats *stats = _objectAllocationInterface->getAllocationStats();
 
 	stats->_tlhDiscardedBytes += getSize();
+	intptr_t discardedBytes = (intptr_t)getSize();
+	uintptr_t freshBytes = 0;
 
 	/* Try to cache the current TLH */
 	if (NULL != getRealAlloc() && getSize() >= tlhMinimumSize) {
@@ -220,6 +224,7 @@ MM_TLHAllocationSupport::refresh(MM_EnvironmentBase *env, MM_AllocateDescription
 		stats->_tlhRefreshCountReused += 1;
 		stats->_tlhAllocatedReused += getSize();
 		stats->_tlhDiscardedBytes -= getSize();
+		discardedBytes -= (intptr_t)getSize();
 
 		didRefresh = true;
 	} else {
@@ -258,10 +263,21 @@ MM_TLHAllocationSupport::refresh(MM_EnvironmentBase *env, MM_AllocateDescription
 			if (0 < getSize()) {
 				stats->_tlhRefreshCountFresh += 1;
 				stats->_tlhAllocatedFresh += getSize();
+				freshBytes = getSize();
 			}
 		}
 	}
 
+	MM_HeapTelemetry *telemetry = extensions->heapTelemetry;
+	if (NULL != telemetry) {
+		if (0 != discardedBytes) {
+			telemetry->tlhBytesDiscarded(discardedBytes);
+		}
+		if (0 != freshBytes) {
+			telemetry->bytesAllocated(freshBytes);
+		}
+	}
+
 	if (didRefresh) {
 		/*
 		 * THL was refreshed however it might be already flushed in GC
@@ -361,6 +377,10 @@ MM_TLHAllocationSupport::setupTLH(MM_EnvironmentBase *env, void *addrBase, void
 		updateFrequentObjectsStats(env);
 	}
 
+	if (NULL != extensions->allocationSampler) {
+		sampleRetiredTLH(env);
+	}
+
 	/* Set the new TLH values */
 	setBase(addrBase);
 	setAlloc(addrBase);
@@ -396,6 +416,46 @@ MM_TLHAllocationSupport::updateFrequentObjectsStats(MM_EnvironmentBase *env)
 	}
 }
 
+/**
+ * Account for the bytes allocated from the TLH being retired and pass the allocation sampler every object
+ * that crosses a sampling point (a multiple of the sampling interval in the thread's allocation stream).
+ * The TLH is only walked when a sampling point falls inside it, so the cost is proportional to the ratio
+ * of the TLH size to the sampling interval.
+ */
+void
+MM_TLHAllocationSupport::sampleRetiredTLH(MM_EnvironmentBase *env)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	MM_ObjectAllocationSampler *sampler = extensions->allocationSampler;
+	uintptr_t base = (uintptr_t)getBase();
+	uintptr_t top = (uintptr_t)getRealAlloc();
+
+	if (top > base) {
+		uintptr_t interval = sampler->getSamplingInterval();
+		uintptr_t allocatedBytes = top - base;
+		/* address of the byte that completes the next sampling interval */
+		uintptr_t samplePoint = base + (interval - env->_allocationSamplingBytes) - 1;
+
+		if (samplePoint < top) {
+			GC_ObjectHeapIteratorAddressOrderedList objectHeapIterator(extensions, (omrobjectptr_t)base, (omrobjectptr_t)top, false, false);
+			omrobjectptr_t object = NULL;
+			while ((samplePoint < top) && (NULL != (object = objectHeapIterator.nextObject()))) {
+				uintptr_t objectSize = extensions->objectModel.getConsumedSizeInBytesWithHeader(object);
+				uintptr_t objectEnd = (uintptr_t)object + objectSize;
+				if (objectEnd > samplePoint) {
+					sampler->sample(env, object, objectSize);
+					/* an object covering several sampling points is sampled once */
+					while (samplePoint < objectEnd) {
+						samplePoint += interval;
+					}
+				}
+			}
+		}
+
+		env->_allocationSamplingBytes = (env->_allocationSamplingBytes + allocatedBytes) % interval;
+	}
+}
+
 #if defined(OMR_GC_OBJECT_ALLOCATION_NOTIFY)
 void
 MM_TLHAllocationSupport::objectAllocationNotify(MM_EnvironmentBase *env, void *heapBase, void *heapTop)
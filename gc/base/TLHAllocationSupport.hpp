@@ -171,6 +171,7 @@ private:
 #endif
 
 	void updateFrequentObjectsStats(MM_EnvironmentBase *env);
+	void sampleRetiredTLH(MM_EnvironmentBase *env);
 
 	/**
 	 * Create a ThreadLocalHeap object.
@@ -190,6 +190,8 @@ getContractReasonAsString(ContractReason reason)
 		return "heap reconfiguration";
 	case FORCED_NURSERY_CONTRACT:
 		return "forced nursery contract";
+	case PAUSE_TIME_TARGET_EXCEEDED:
+		return "pause time target exceeded";
 	default:
 		return "unknown";
 	}
@@ -217,6 +219,8 @@ getExpandReasonAsString(ExpandReason reason)
 		return "forced nursery expand";
 	case HINT_PREVIOUS_RUNS:
 		return "hint from previous runs";
+	case PAUSE_TIME_THROUGHPUT_FLOOR:
+		return "throughput below pause time controller floor";
 	default:
 		return "unknown";
 	}
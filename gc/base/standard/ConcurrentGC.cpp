@@ -71,6 +71,7 @@
 #include "MemorySubSpaceFlat.hpp"
 #include "MemorySubSpaceSemiSpace.hpp"
 #include "ObjectModel.hpp"
+#include "PauseTimeController.hpp"
 #include "SpinLimiter.hpp"
 #include "SublistIterator.hpp"
 #include "SublistPuddle.hpp"
@@ -1449,6 +1450,10 @@ MM_ConcurrentGC::tuneToHeap(MM_EnvironmentBase *env)
 	 *  resulting in a final kickoffThreshold = 111M and a cardCleaningThreshold = 23M
 	 */
 	float boost = ((float)kickoffThreshold * CONCURRENT_KICKOFF_THRESHOLD_BOOST) - (float)kickoffThreshold;
+	if (NULL != _extensions->pauseTimeController) {
+		/* Global pauses over the pause time goal bring the kickoff point further forward, so more of the marking is done concurrently */
+		boost += (float)kickoffThreshold * (_extensions->pauseTimeController->getConcurrentKickoffBoost() - 1.0f);
+	}
 	float kickoffProportion = 1.0;
 	float cardCleaningProportion = (float)cardCleaningThreshold / (float)kickoffThreshold;
 
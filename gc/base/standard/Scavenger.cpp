@@ -2647,16 +2647,18 @@ MM_Scavenger::scavengeRememberedSetListDirect(MM_EnvironmentStandard *env)
 	Trc_MM_ParallelScavenger_scavengeRememberedSetList_Entry(env->getLanguageVMThread());
 
 	MM_SublistPuddle *puddle = NULL;
-	while (NULL != (puddle = _extensions->rememberedSet.popPreviousPuddle(puddle))) {
+	uintptr_t startIndex = 0;
+	uintptr_t endIndex = 0;
+	while (NULL != (puddle = _extensions->rememberedSet.popPreviousChunk(_extensions->rememberedSetScanChunkSize, &startIndex, &endIndex))) {
 		Trc_MM_ParallelScavenger_scavengeRememberedSetList_startPuddle(env->getLanguageVMThread(), puddle);
 		uintptr_t numElements = 0;
-		GC_SublistSlotIterator remSetSlotIterator(puddle);
+		GC_SublistSlotIterator remSetSlotIterator(puddle, startIndex, endIndex);
 		omrobjectptr_t *slotPtr;
 		while((slotPtr = (omrobjectptr_t *)remSetSlotIterator.nextSlot()) != NULL) {
 			omrobjectptr_t objectPtr = *slotPtr;
 
-			/* Ignore flaged for removal by the indirect refs pass */
-			if (0 == ((uintptr_t)objectPtr & DEFERRED_RS_REMOVE_FLAG)) {
+			/* Ignore flaged for removal by the indirect refs pass (and empty slots, left for the pruning pass) */
+			if ((NULL != objectPtr) && (0 == ((uintptr_t)objectPtr & DEFERRED_RS_REMOVE_FLAG))) {
 				if (!_extensions->objectModel.hasIndirectObjectReferents((CLI_THREAD_TYPE*)env->getLanguageVMThread(), objectPtr)) {
 					Assert_MM_true(_extensions->objectModel.isRemembered(objectPtr));
 					numElements += 1;
@@ -2682,14 +2684,17 @@ MM_Scavenger::scavengeRememberedSetListIndirect(MM_EnvironmentStandard *env)
 	Trc_MM_ParallelScavenger_scavengeRememberedSetList_Entry(env->getLanguageVMThread());
 
 	MM_SublistPuddle *puddle = NULL;
-	while (NULL != (puddle = _extensions->rememberedSet.popPreviousPuddle(puddle))) {
+	uintptr_t startIndex = 0;
+	uintptr_t endIndex = 0;
+	while (NULL != (puddle = _extensions->rememberedSet.popPreviousChunk(_extensions->rememberedSetScanChunkSize, &startIndex, &endIndex))) {
 		Trc_MM_ParallelScavenger_scavengeRememberedSetList_startPuddle(env->getLanguageVMThread(), puddle);
 		uintptr_t numElements = 0;
-		GC_SublistSlotIterator remSetSlotIterator(puddle);
+		GC_SublistSlotIterator remSetSlotIterator(puddle, startIndex, endIndex);
 		omrobjectptr_t *slotPtr;
 		while((slotPtr = (omrobjectptr_t *)remSetSlotIterator.nextSlot()) != NULL) {
 			omrobjectptr_t objectPtr = *slotPtr;
 
+			/* Empty slots are left for the pruning pass, since other threads may be scanning the same puddle */
 			if(NULL != objectPtr) {
 				if (_extensions->objectModel.hasIndirectObjectReferents((CLI_THREAD_TYPE*)env->getLanguageVMThread(), objectPtr)) {
 					numElements += 1;
@@ -2702,8 +2707,6 @@ MM_Scavenger::scavengeRememberedSetListIndirect(MM_EnvironmentStandard *env)
 						*slotPtr = objectPtr;
 					}
 				}
-			} else {
-				remSetSlotIterator.removeSlot();
 			}
 		}
 
@@ -2722,16 +2725,19 @@ MM_Scavenger::scavengeRememberedSetList(MM_EnvironmentStandard *env)
 
 	Trc_MM_ParallelScavenger_scavengeRememberedSetList_Entry(env->getLanguageVMThread());
 
-	/* Remembered set walk */
+	/* Remembered set walk, split in chunks of rememberedSetScanChunkSize slots so that large puddles are shared between threads */
 	MM_SublistPuddle *puddle = NULL;
-	while (NULL != (puddle = _extensions->rememberedSet.popPreviousPuddle(puddle))) {
+	uintptr_t startIndex = 0;
+	uintptr_t endIndex = 0;
+	while (NULL != (puddle = _extensions->rememberedSet.popPreviousChunk(_extensions->rememberedSetScanChunkSize, &startIndex, &endIndex))) {
 		Trc_MM_ParallelScavenger_scavengeRememberedSetList_startPuddle(env->getLanguageVMThread(), puddle);
 		uintptr_t numElements = 0;
-		GC_SublistSlotIterator remSetSlotIterator(puddle);
+		GC_SublistSlotIterator remSetSlotIterator(puddle, startIndex, endIndex);
 		omrobjectptr_t *slotPtr;
 		while((slotPtr = (omrobjectptr_t *)remSetSlotIterator.nextSlot()) != NULL) {
 			omrobjectptr_t objectPtr = *slotPtr;
 
+			/* Empty slots are left for the pruning pass, since other threads may be scanning the same puddle */
 			if(NULL != objectPtr) {
 				Assert_MM_true(_extensions->objectModel.isRemembered(objectPtr));
 				numElements += 1;
@@ -2752,8 +2758,6 @@ MM_Scavenger::scavengeRememberedSetList(MM_EnvironmentStandard *env)
 					/* We want to remember this object after all; clear the flag for removal. */
 					*slotPtr = (omrobjectptr_t)((uintptr_t)*slotPtr & ~(uintptr_t)DEFERRED_RS_REMOVE_FLAG);
 				}
-			} else {
-				remSetSlotIterator.removeSlot();
 			}
 		}
 
@@ -3864,10 +3868,12 @@ MM_Scavenger::masterThreadGarbageCollect(MM_EnvironmentBase *envBase, MM_Allocat
 
 		_extensions->scavengerStats._endTime = omrtime_hires_clock();
 
-		if(scavengeCompletedSuccessfully(env)) {
-			/* Merge sublists in the remembered set (if necessary) */
-			_extensions->rememberedSet.compact(env);
+		/* Merge sublists in the remembered set (if necessary). Pruning and back out leave partially filled
+		 * puddles behind, so shrink the puddle chain after every scavenge.
+		 */
+		_extensions->rememberedSet.compact(env);
 
+		if(scavengeCompletedSuccessfully(env)) {
 			/* If -Xgc:fvtest=forcePoisonEvacuate has been specified, poison(fill poison pattern) evacuate space */
 			if(_extensions->fvtest_forcePoisonEvacuate) {
 				_activeSubSpace->poisonEvacuateSpace();
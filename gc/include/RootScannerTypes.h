@@ -62,6 +62,7 @@ typedef enum RootScannerEntity {
 	RootScannerEntity_MonitorLookupCaches,
 	RootScannerEntity_MonitorLookupCachesComplete,
 	RootScannerEntity_MonitorReferenceObjectsComplete,
+	RootScannerEntity_GlobalRoots,
 
 	/* Must be last, do not use this entity! */
 	RootScannerEntity_Count
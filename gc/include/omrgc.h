@@ -42,6 +42,46 @@ omrobjectptr_t OMR_GC_AllocateObject(OMR_VMThread * omrVMThread, uintptr_t alloc
 
 omr_error_t OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode);
 
+/* An allocation site ranked by the allocation sampler (see -Xgc:allocationSamplingInterval=) */
+typedef struct OMR_GC_AllocationSample {
+	uintptr_t site; /* language-defined site answered by the environment delegate for the sampled objects */
+	uintptr_t count; /* number of samples charged to the site (may overestimate sites that entered the table late) */
+	uintptr_t estimatedBytes; /* count multiplied by the sampling interval */
+} OMR_GC_AllocationSample;
+
+/* Copy up to maxSamples of the hottest sampled allocation sites, hottest first, optionally clearing the table.
+ * Answers the number of entries written (0 if allocation sampling is disabled). */
+uintptr_t OMR_GC_GetAllocationSamples(OMR_VMThread* omrVMThread, OMR_GC_AllocationSample *samples, uintptr_t maxSamples, BOOLEAN reset);
+
+/* A point-in-time view of the heap taken by the heap telemetry sampler (see -Xgc:heapTelemetrySamples=) */
+typedef struct OMR_GC_HeapTelemetrySample {
+	uint64_t timestamp; /* microseconds, from the port library high resolution clock */
+	uintptr_t heapTotal; /* active heap size in bytes */
+	uintptr_t heapFree; /* approximate free heap size in bytes */
+	uintptr_t tenureTotal; /* active tenure size in bytes */
+	uintptr_t tenureFree; /* approximate free tenure size in bytes */
+	uintptr_t nurseryTotal; /* active nursery size in bytes (0 if there is no nursery) */
+	uintptr_t nurseryFree; /* approximate free nursery size in bytes */
+	uintptr_t bytesAllocated; /* bytes handed out to TLHs and out-of-line allocations since startup */
+	uintptr_t allocationRate; /* bytes allocated per second since the previous sample (0 for the first sample) */
+	uintptr_t tlhDiscardedBytes; /* bytes left unused in retired TLHs since startup */
+	uintptr_t tenureFreeEntryCount; /* free list entries in the tenure memory pool */
+	uintptr_t tenureLargestFreeEntry; /* largest tenure free entry found by the last global collection */
+	uintptr_t tenureFragmentation; /* percentage of tenure free memory not in the largest free entry */
+	uintptr_t concurrentMarkMode; /* concurrent mark execution mode (0 if concurrent mark is off or not supported) */
+	uintptr_t concurrentMarkTraced; /* bytes traced by the current concurrent mark cycle */
+	uintptr_t concurrentMarkTarget; /* bytes the current concurrent mark cycle expects to trace */
+} OMR_GC_HeapTelemetrySample;
+
+/* Take a heap telemetry sample and record it in the telemetry ring. Safe to call at any time from an attached thread,
+ * without exclusive VM access. If sample is not NULL it receives a copy of the recorded sample.
+ * Answers OMR_ERROR_NOT_AVAILABLE if heap telemetry is disabled. */
+omr_error_t OMR_GC_SampleHeapTelemetry(OMR_VMThread* omrVMThread, OMR_GC_HeapTelemetrySample *sample);
+
+/* Copy up to maxSamples of the most recent heap telemetry samples, oldest first.
+ * Answers the number of entries written (0 if heap telemetry is disabled). */
+uintptr_t OMR_GC_GetHeapTelemetry(OMR_VMThread* omrVMThread, OMR_GC_HeapTelemetrySample *samples, uintptr_t maxSamples);
+
 #ifdef __cplusplus
 } /* extern "C" { */
 #endif
@@ -28,6 +28,8 @@
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
 #include "Heap.hpp"
+#include "HeapTelemetry.hpp"
+#include "ObjectAllocationSampler.hpp"
 #include "omrgcstartup.hpp"
 #include "ModronAssertions.h"
 
@@ -60,3 +62,38 @@ OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode)
 	}
 	return result;
 }
+
+uintptr_t
+OMR_GC_GetAllocationSamples(OMR_VMThread* omrVMThread, OMR_GC_AllocationSample *samples, uintptr_t maxSamples, BOOLEAN reset)
+{
+	uintptr_t result = 0;
+	MM_ObjectAllocationSampler *sampler = MM_EnvironmentBase::getEnvironment(omrVMThread)->getExtensions()->allocationSampler;
+	if (NULL != sampler) {
+		result = sampler->exportSamples(samples, maxSamples, FALSE != reset);
+	}
+	return result;
+}
+
+omr_error_t
+OMR_GC_SampleHeapTelemetry(OMR_VMThread* omrVMThread, OMR_GC_HeapTelemetrySample *sample)
+{
+	omr_error_t result = OMR_ERROR_NOT_AVAILABLE;
+	MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrVMThread);
+	MM_HeapTelemetry *telemetry = env->getExtensions()->heapTelemetry;
+	if (NULL != telemetry) {
+		telemetry->sample(env, sample);
+		result = OMR_ERROR_NONE;
+	}
+	return result;
+}
+
+uintptr_t
+OMR_GC_GetHeapTelemetry(OMR_VMThread* omrVMThread, OMR_GC_HeapTelemetrySample *samples, uintptr_t maxSamples)
+{
+	uintptr_t result = 0;
+	MM_HeapTelemetry *telemetry = MM_EnvironmentBase::getEnvironment(omrVMThread)->getExtensions()->heapTelemetry;
+	if (NULL != telemetry) {
+		result = telemetry->exportSamples(samples, maxSamples);
+	}
+	return result;
+}
@@ -285,6 +285,7 @@ MM_SublistPool::compact(MM_EnvironmentBase *env)
 
 		if(currentPuddle->isEmpty()) {
 			/* The puddle is empty, free it and move to the next one */
+			_currentSize -= currentPuddle->totalSize();
 			MM_SublistPuddle::kill(env, currentPuddle);
 			currentPuddle = nextPuddle;
 			continue;
@@ -387,6 +388,7 @@ MM_SublistPool::clear(MM_EnvironmentBase *env)
 	_list = NULL;
 	_allocPuddle = NULL;
 	_previousList = NULL;
+	_previousListCursor = 0;
 	_count = 0;
 }
 
@@ -406,6 +408,7 @@ MM_SublistPool::startProcessingSublist()
 {
 	Assert_MM_true(NULL == _previousList);
 	_previousList = _list;
+	_previousListCursor = 0;
 
 	MM_SublistPuddle* tail = _allocPuddle;
 	if (NULL == tail) {
@@ -452,3 +455,37 @@ MM_SublistPool::popPreviousPuddle(MM_SublistPuddle * returnedPuddle)
 	
 	return result;
 }
+
+MM_SublistPuddle *
+MM_SublistPool::popPreviousChunk(uintptr_t maxSlots, uintptr_t *startIndex, uintptr_t *endIndex)
+{
+	omrthread_monitor_enter(_mutex);
+
+	MM_SublistPuddle *result = _previousList;
+	if (NULL != result) {
+		uintptr_t slotCount = result->consumedCount();
+		*startIndex = _previousListCursor;
+		*endIndex = OMR_MIN(slotCount, _previousListCursor + maxSlots);
+
+		if (*endIndex < slotCount) {
+			_previousListCursor = *endIndex;
+		} else {
+			/* All slots of the puddle have been handed out - return it to the list of used puddles */
+			_previousList = result->getNext();
+			_previousListCursor = 0;
+			result->setNext(_list);
+			_list = result;
+
+			/* It's illegal to have a non-empty list without an _allocPuddle. If
+			 * this is the only puddle in the pool, make it the _allocPuddle.
+			 */
+			if (NULL == _allocPuddle) {
+				_allocPuddle = result;
+			}
+		}
+	}
+
+	omrthread_monitor_exit(_mutex);
+
+	return result;
+}
@@ -65,6 +65,7 @@ private:
 	OMR::GC::AllocationCategory::Enum _allocCategory;
 	
 	MM_SublistPuddle *_previousList; /**< A list of the non-empty puddles when #startProcessingSublist() was called */
+	uintptr_t _previousListCursor; /**< Index of the first slot of the head of _previousList not yet handed out by #popPreviousChunk() */
 	
 protected:
 public:
@@ -125,6 +126,20 @@ public:
 	 * @return a puddle to process, or NULL if the list is empty
 	 */
 	MM_SublistPuddle *popPreviousPuddle(MM_SublistPuddle * returnedPuddle);
+
+	/**
+	 * Pop a range of at most maxSlots slots from the puddles which were active when #startProcessingSublist() was called,
+	 * so that the slots of a single puddle can be processed by several threads.
+	 * A puddle is returned to the list of puddles once all of its slots have been handed out. Its slots may still be
+	 * processed at that point, so a range must not be processed with GC_SublistSlotIterator::removeSlot().
+	 * This is protected by a lock, so may safely be called by multiple threads.
+	 *
+	 * @param maxSlots[in] the maximum number of slots to return
+	 * @param startIndex[out] index of the first slot of the range in the returned puddle
+	 * @param endIndex[out] index following the last slot of the range in the returned puddle
+	 * @return the puddle containing the range, or NULL if all ranges have been handed out
+	 */
+	MM_SublistPuddle *popPreviousChunk(uintptr_t maxSlots, uintptr_t *startIndex, uintptr_t *endIndex);
 	
 	MM_SublistPool() 
 		: _list(NULL)
@@ -136,6 +151,7 @@ public:
 		, _count(0)
 		, _allocCategory(OMR::GC::AllocationCategory::OTHER)
 		, _previousList(NULL)
+		, _previousListCursor(0)
 	{}
 
 	friend class GC_SublistIterator;
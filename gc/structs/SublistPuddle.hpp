@@ -84,6 +84,7 @@ public:
 	MMINLINE bool isFull() { return _listCurrent == _listTop; }
 	MMINLINE bool isEmpty() { return _listCurrent == _listBase; }
 	MMINLINE uintptr_t consumedSize() { return ((uintptr_t)_listCurrent) - ((uintptr_t)_listBase); }
+	MMINLINE uintptr_t consumedCount() { return (uintptr_t)(_listCurrent - _listBase); }
 	MMINLINE uintptr_t freeSize() { return ((uintptr_t)_listTop) - ((uintptr_t)_listCurrent); }
 	MMINLINE uintptr_t totalSize() { return ((uintptr_t)_listTop) - ((uintptr_t)_listBase); }
 
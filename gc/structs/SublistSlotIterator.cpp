@@ -54,7 +54,12 @@ GC_SublistSlotIterator::nextSlot()
 		}
 	}	
 	
-	if(_scanPtr < _puddle->_listCurrent) {		
+	uintptr_t *scanTop = _puddle->_listCurrent;
+	if ((NULL != _scanTop) && (_scanTop < scanTop)) {
+		scanTop = _scanTop;
+	}
+
+	if(_scanPtr < scanTop) {		
 		if(0 == *_scanPtr) {
 			_returnedFilledSlot = false;
 		} else {			
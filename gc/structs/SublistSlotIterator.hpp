@@ -43,6 +43,7 @@ class GC_SublistSlotIterator
 {
 	MM_SublistPuddle *_puddle;
 	uintptr_t *_scanPtr;
+	uintptr_t *_scanTop; /**< end of the range to iterate (NULL to iterate up to the current end of the puddle) */
 	uintptr_t _removedCount; /**< keep a running count of elements removed from puddle */
 	
 	bool _returnedFilledSlot; /**< if last slot returned was filled or null */
@@ -51,6 +52,19 @@ public:
 	GC_SublistSlotIterator(MM_SublistPuddle *sublist) :
 		_puddle(sublist),
 		_scanPtr(sublist->_listBase),
+		_scanTop(NULL),
+		_removedCount(0),
+		_returnedFilledSlot(false)
+	{};
+
+	/**
+	 * Create an iterator over the slots [startIndex, endIndex) of the puddle, clipped to its consumed slots.
+	 * Ranges of the same puddle may be iterated by different threads, so removeSlot() must not be used.
+	 */
+	GC_SublistSlotIterator(MM_SublistPuddle *sublist, uintptr_t startIndex, uintptr_t endIndex) :
+		_puddle(sublist),
+		_scanPtr(sublist->_listBase + startIndex),
+		_scanTop(sublist->_listBase + endIndex),
 		_removedCount(0),
 		_returnedFilledSlot(false)
 	{};
@@ -37,6 +37,7 @@
 
 static void verboseHandlerInitialized(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 static void verboseHandlerHeapResize(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
+static void verboseHandlerPauseTimeControllerUpdate(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 
 MM_VerboseHandlerOutput *
 MM_VerboseHandlerOutput::newInstance(MM_EnvironmentBase *env, MM_VerboseManager *manager)
@@ -100,6 +101,7 @@ MM_VerboseHandlerOutput::enableVerbose()
 	/* Initialized */
 	(*_mmOmrHooks)->J9HookRegisterWithCallSite(_mmOmrHooks, J9HOOK_MM_OMR_INITIALIZED, verboseHandlerInitialized, OMR_GET_CALLSITE(), (void *)this);
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_HEAP_RESIZE, verboseHandlerHeapResize, OMR_GET_CALLSITE(), (void *)this);
+	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_PAUSE_TIME_CONTROLLER_UPDATE, verboseHandlerPauseTimeControllerUpdate, OMR_GET_CALLSITE(), (void *)this);
 
 	return ;
 }
@@ -110,6 +112,7 @@ MM_VerboseHandlerOutput::disableVerbose()
 	/* Initialized */
 	(*_mmOmrHooks)->J9HookUnregister(_mmOmrHooks, J9HOOK_MM_OMR_INITIALIZED, verboseHandlerInitialized, NULL);
 	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_HEAP_RESIZE, verboseHandlerHeapResize, NULL);
+	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_PAUSE_TIME_CONTROLLER_UPDATE, verboseHandlerPauseTimeControllerUpdate, NULL);
 
 	return ;
 }
@@ -1038,6 +1041,34 @@ MM_VerboseHandlerOutput::handleExcessiveGCRaised(J9HookInterface** hook, uintptr
 	exitAtomicReportingBlock();
 }
 
+void
+MM_VerboseHandlerOutput::handlePauseTimeControllerUpdate(J9HookInterface** hook, uintptr_t eventNum, void* eventData)
+{
+	MM_PauseTimeControllerUpdateEvent * event = (MM_PauseTimeControllerUpdateEvent *)eventData;
+	MM_VerboseWriterChain* writer = _manager->getWriterChain();
+	MM_EnvironmentBase* env = MM_EnvironmentBase::getEnvironment(event->currentThread);
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	char tagTemplate[200];
+	getTagTemplate(tagTemplate, sizeof(tagTemplate), _manager->getIdAndIncrement(), omrtime_current_time_millis());
+	enterAtomicReportingBlock();
+	writer->formatAndOutput(env, _manager->getIndentLevel(),
+		"<pause-time-controller %s type=\"%s\" targetms=\"%zu\" percentile=\"%zu\" percentilems=\"%llu.%03.3llu\" lastms=\"%llu.%03.3llu\" gcratio=\"%.3f\" throughputfloor=\"%zu\" nurseryfactor=\"%.3f\" gcthreads=\"%zu\" kickoffboost=\"%.3f\" />",
+		tagTemplate,
+		event->globalCollection ? "global" : "local",
+		event->pauseTimeTarget,
+		event->percentile,
+		event->percentilePauseTime / 1000, event->percentilePauseTime % 1000,
+		event->lastPauseTime / 1000, event->lastPauseTime % 1000,
+		event->gcTimeRatio,
+		event->throughputFloor,
+		event->nurseryResizeFactor,
+		event->gcThreadCountLimit,
+		event->concurrentKickoffBoost);
+	writer->flush(env);
+	exitAtomicReportingBlock();
+}
+
 void
 MM_VerboseHandlerOutput::outputStringConstantInfo(MM_EnvironmentBase *env, uintptr_t ident, uintptr_t candidates, uintptr_t cleared)
 {
@@ -1059,3 +1090,9 @@ verboseHandlerHeapResize(J9HookInterface** hook, uintptr_t eventNum, void* event
 {
 	((MM_VerboseHandlerOutput*)userData)->handleHeapResize(hook, eventNum, eventData);
 }
+
+void
+verboseHandlerPauseTimeControllerUpdate(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData)
+{
+	((MM_VerboseHandlerOutput*)userData)->handlePauseTimeControllerUpdate(hook, eventNum, eventData);
+}
@@ -401,7 +401,8 @@ typedef enum {
 	SCAV_RATIO_TOO_LOW,
 	HEAP_RESIZE,
 	SATISFY_EXPAND,
-	FORCED_NURSERY_CONTRACT
+	FORCED_NURSERY_CONTRACT,
+	PAUSE_TIME_TARGET_EXCEEDED
 } ContractReason;
 
 typedef enum {
@@ -412,7 +413,8 @@ typedef enum {
 	SATISFY_COLLECTOR,
 	EXPAND_DESPERATE,
 	FORCED_NURSERY_EXPAND,
-	HINT_PREVIOUS_RUNS
+	HINT_PREVIOUS_RUNS,
+	PAUSE_TIME_THROUGHPUT_FLOOR
 } ExpandReason;
 
 typedef enum {
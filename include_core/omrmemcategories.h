@@ -31,6 +31,24 @@
 
 #include "omrcfg.h"
 
+/* Number of counter stripes per category. Must be a power of two. */
+#define OMRMEM_CATEGORY_STRIPE_COUNT 8
+/* Size each stripe is padded to, so that stripes do not share a cache line */
+#define OMRMEM_CATEGORY_STRIPE_SIZE 64
+
+/*
+ * Per-thread slice of a category's counters. Allocating threads update the
+ * stripe they hash to rather than the shared liveBytes/liveAllocations pair,
+ * and omrmem_walk_categories sums the stripes when the category is reported.
+ * A block may be freed on a different stripe from the one it was allocated on,
+ * so an individual stripe may wrap below zero; only the sum is meaningful.
+ */
+typedef struct OMRMemCategoryStripe {
+	uintptr_t liveBytes;
+	uintptr_t liveAllocations;
+	uint8_t padding[OMRMEM_CATEGORY_STRIPE_SIZE - (2 * sizeof(uintptr_t))];
+} OMRMemCategoryStripe;
+
 typedef struct OMRMemCategory {
 	const char *const name;
 	const uint32_t categoryCode;
@@ -38,6 +56,8 @@ typedef struct OMRMemCategory {
 	uintptr_t liveAllocations;
 	const uint32_t numberOfChildren;
 	const uint32_t *const children;
+	/* Left zero by the static initializers below */
+	OMRMemCategoryStripe stripes[OMRMEM_CATEGORY_STRIPE_COUNT];
 } OMRMemCategory;
 
 typedef struct OMRMemCategorySet {
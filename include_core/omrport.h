@@ -467,6 +467,8 @@ typedef struct OMRCgroupMetricIteratorState {
 #define J9MEMTAG_EYECATCHER_ALLOC_FOOTER			0xB7654321
 #define J9MEMTAG_EYECATCHER_FREED_HEADER			0xBADBAD67
 #define J9MEMTAG_EYECATCHER_FREED_FOOTER			0xBADBAD21
+/* Header of a block which was not sampled for full tagging, see OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL */
+#define J9MEMTAG_EYECATCHER_LIGHT_HEADER			0xB123456C
 #define J9MEMTAG_PADDING_BYTE						0xDD
 
 typedef struct J9MemTag {
@@ -657,6 +659,62 @@ typedef struct J9ProcessorInfos {
 #define OMRPORT_PROCINFO_PROC_OFFLINE ((int32_t)0)
 #define OMRPORT_PROCINFO_PROC_ONLINE ((int32_t)1)
 
+/* Cache slots in OMRCPUTopologyEntry.caches. */
+#define OMRPORT_CACHE_L1D 0
+#define OMRPORT_CACHE_L1I 1
+#define OMRPORT_CACHE_L2 2
+#define OMRPORT_CACHE_L3 3
+#define OMRPORT_CACHE_SLOTS 4
+
+#define OMRPORT_TOPOLOGY_NOT_AVAILABLE ((int32_t)-1)
+
+/**
+ * Describes one cache as seen from a logical processor. Processors that report the same id in the
+ * same slot share that cache instance. A size of 0 means the cache does not exist or could not be
+ * determined, in which case id is OMRPORT_TOPOLOGY_NOT_AVAILABLE.
+ */
+typedef struct OMRCacheInfo {
+	uint64_t size;				/* Capacity in bytes. */
+	uint32_t lineSize;			/* Coherency line size in bytes. */
+	uint32_t associativity;		/* Number of ways, 0 if unknown or fully associative. */
+	int32_t id;					/* Lowest logical processor sharing this cache. */
+	int32_t sharingCount;		/* Number of logical processors sharing this cache. */
+} OMRCacheInfo;
+
+/**
+ * Placement of one logical processor. Identifiers that cannot be determined on a platform are set
+ * to OMRPORT_TOPOLOGY_NOT_AVAILABLE.
+ */
+typedef struct OMRCPUTopologyEntry {
+	int32_t cpu;				/* Logical processor number. */
+	int32_t core;				/* Lowest logical processor on the same core, so unique across packages. */
+	int32_t package;			/* Physical package (socket) id. */
+	int32_t node;				/* NUMA node. */
+	int32_t online;				/* OMRPORT_PROCINFO_PROC_ONLINE or OMRPORT_PROCINFO_PROC_OFFLINE. */
+	/* TRUE if the process may run on this processor, i.e. it is in the list returned by
+	 * omrsysinfo_get_cpu_list(): the affinity mask restricted by the cgroup cpuset.
+	 */
+	BOOLEAN bound;
+	OMRCacheInfo caches[OMRPORT_CACHE_SLOTS];
+} OMRCPUTopologyEntry;
+
+/**
+ * Processor and cache topology of the machine.
+ *
+ * @see omrsysinfo_get_cpu_topology, omrsysinfo_destroy_cpu_topology
+ *
+ * The array holds an entry for each logical processor, indexed by processor number. The counts
+ * only consider bound processors, so they describe the resources available to the process.
+ */
+typedef struct OMRCPUTopology {
+	int32_t cpuCount;				/* Number of entries in cpus. */
+	int32_t boundCount;				/* Number of bound processors. */
+	int32_t coreCount;				/* Number of distinct cores with a bound processor. */
+	int32_t packageCount;			/* Number of distinct packages with a bound processor. */
+	int32_t nodeCount;				/* Number of distinct NUMA nodes with a bound processor. */
+	OMRCPUTopologyEntry *cpus;		/* Array of 'cpuCount' processors. */
+} OMRCPUTopology;
+
 #define NANOSECS_PER_USEC 1000
 
 #define OMRPORT_ENABLE_ENSURE_CAP32 0
@@ -729,18 +787,70 @@ typedef struct J9ProcessorInfos {
 #define OMRPORT_CTLDATA_NLS_DISABLE "NLS_DISABLE"
 #define OMRPORT_CTLDATA_VMEM_ADVISE_HUGEPAGE  "VMEM_ADVISE_HUGEPAGE"
 #define OMRPORT_CTLDATA_VMEM_PERFORM_FULL_MEMORY_SEARCH  "VMEM_PERFORM_FULL_SEARCH"
+#define OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR  "MEM_SMALL_BLOCK_ALLOCATOR"
+#define OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL  "MEM_TAG_SAMPLE_INTERVAL"
+#define OMRPORT_CTLDATA_MEM_TAG_VERIFY_PERIOD  "MEM_TAG_VERIFY_PERIOD"
+#define OMRPORT_CTLDATA_MEM_TAG_VERIFY  "MEM_TAG_VERIFY"
 
 #define OMRPORT_FILE_READ_LOCK  1
 #define OMRPORT_FILE_WRITE_LOCK  2
 #define OMRPORT_FILE_WAIT_FOR_LOCK  4
 #define OMRPORT_FILE_NOWAIT_FOR_LOCK  8
 
+/* Operations for OMRFileAsyncRequest */
+#define OMRPORT_FILE_ASYNC_READV  1
+#define OMRPORT_FILE_ASYNC_WRITEV  2
+#define OMRPORT_FILE_ASYNC_FSYNC  3
+/* OMRFileAsyncRequest flags. A linked request is followed by the next request of the same
+ * batch only if it transfers every byte (or syncs), otherwise the rest of the chain is cancelled. */
+#define OMRPORT_FILE_ASYNC_LINK  1
+/* omrfile_async_create flags */
+#define OMRPORT_FILE_ASYNC_USE_THREADS  1
+/* omrfile_async_backend values */
+#define OMRPORT_FILE_ASYNC_BACKEND_THREADS  1
+#define OMRPORT_FILE_ASYNC_BACKEND_IO_URING  2
+
+/**
+ * A buffer for vectored file and socket I/O.
+ */
+typedef struct OMRIOVec {
+	void *base;
+	uintptr_t length;
+} OMRIOVec;
+
+/**
+ * An asynchronous file operation for omrfile_async_submit.
+ * The iov array and buffers must remain valid until the operation is completed.
+ */
+typedef struct OMRFileAsyncRequest {
+	uint32_t operation; /* One of OMRPORT_FILE_ASYNC_READV, OMRPORT_FILE_ASYNC_WRITEV or OMRPORT_FILE_ASYNC_FSYNC */
+	uint32_t flags;
+	intptr_t fd;
+	int64_t offset; /* File offset for reads and writes, the file position is not used or changed */
+	OMRIOVec *iov;
+	uint32_t iovCount;
+	void *userData; /* Returned in the matching OMRFileAsyncCompletion */
+} OMRFileAsyncRequest;
+
+/**
+ * The outcome of an asynchronous file operation, see omrfile_async_complete.
+ */
+typedef struct OMRFileAsyncCompletion {
+	void *userData;
+	intptr_t result; /* Bytes transferred, 0 for a sync, or a negative portable error code */
+} OMRFileAsyncCompletion;
+
+struct OMRFileAsyncQueue;
+
 #define OMRPORT_MMAP_CAPABILITY_COPYONWRITE  1
 #define OMRPORT_MMAP_CAPABILITY_READ  2
 #define OMRPORT_MMAP_CAPABILITY_WRITE  4
 #define OMRPORT_MMAP_CAPABILITY_UMAP_REQUIRES_SIZE  8
 #define OMRPORT_MMAP_CAPABILITY_MSYNC  16
 #define OMRPORT_MMAP_CAPABILITY_PROTECT  32
+#define OMRPORT_MMAP_CAPABILITY_POPULATE  64
+#define OMRPORT_MMAP_CAPABILITY_ADVISE  128
+#define OMRPORT_MMAP_CAPABILITY_HUGEPAGE  256
 #define OMRPORT_MMAP_FLAG_CREATE_FILE  1
 #define OMRPORT_MMAP_FLAG_READ  2
 #define OMRPORT_MMAP_FLAG_WRITE  4
@@ -751,6 +861,15 @@ typedef struct J9ProcessorInfos {
 #define OMRPORT_MMAP_SYNC_WAIT  0x80
 #define OMRPORT_MMAP_SYNC_ASYNC  0x100
 #define OMRPORT_MMAP_SYNC_INVALIDATE  0x200
+#define OMRPORT_MMAP_FLAG_POPULATE  0x400
+#define OMRPORT_MMAP_FLAG_HUGEPAGE  0x800
+
+/* Access pattern hints for omrmmap_advise. */
+#define OMRPORT_MMAP_ADVICE_NORMAL  0
+#define OMRPORT_MMAP_ADVICE_SEQUENTIAL  1
+#define OMRPORT_MMAP_ADVICE_RANDOM  2
+#define OMRPORT_MMAP_ADVICE_WILLNEED  3
+#define OMRPORT_MMAP_ADVICE_HUGEPAGE  4
 
 /* Signal classification bits. */
 #define OMRPORT_SIG_FLAG_MAY_RETURN             ((uint32_t)0x01)
@@ -1132,6 +1251,45 @@ typedef struct J9ThreadWalkState {
 	const char *error_string;
 } J9ThreadWalkState;
 
+/* OMRProfilerSample flags */
+#define OMRPORT_PROFILER_SAMPLE_TRUNCATED 1 /* The stack was deeper than the profiler's maximum frame count */
+
+/**
+ * A stack sample taken by the sampling profiler, see omrprofiler_drain.
+ */
+typedef struct OMRProfilerSample {
+	uint64_t timestamp; /* CLOCK_MONOTONIC time of the sample in nanoseconds */
+	uintptr_t threadId; /* OS thread id of the sampled thread */
+	const uintptr_t *frames; /* Instruction pointers, innermost first; only valid during the callback */
+	uint32_t frameCount;
+	uint32_t flags;
+} OMRProfilerSample;
+
+/**
+ * Counters of a sampling profiler, see omrprofiler_get_stats.
+ */
+typedef struct OMRProfilerStats {
+	uint64_t recorded; /* Samples written to the per-thread buffers */
+	uint64_t dropped; /* Samples lost because a buffer was full */
+	uint64_t drained; /* Samples passed to omrprofiler_drain callbacks */
+	uint32_t threads; /* Threads currently registered */
+} OMRProfilerStats;
+
+/**
+ * The symbol information for an address, see omrprofiler_symbolize.
+ * The strings remain valid while the module containing the address is loaded.
+ */
+typedef struct OMRProfilerSymbol {
+	const char *moduleName; /* Path of the containing module, NULL if unknown */
+	uintptr_t moduleOffset;
+	const char *symbolName; /* Nearest exported symbol, NULL if unknown */
+	uintptr_t symbolOffset;
+} OMRProfilerSymbol;
+
+typedef void (*omrprofiler_sample_fn)(struct OMRPortLibrary *portLibrary, const OMRProfilerSample *sample, void *userData);
+
+struct OMRProfiler;
+
 typedef struct J9PortSysInfoLoadData {
 	double oneMinuteAverage;
 	double fiveMinuteAverage;
@@ -1471,6 +1629,11 @@ typedef struct OMRProcessorDesc {
 #define OMR_FEATURE_X86_F16C         32 + 29 /* 16-bit floating-point conversion instructions. */
 #define OMR_FEATURE_X86_RDRAND       32 + 30 /* Processor supports RDRAND instruction. */
 
+/* x86 advanced power management features
+ * CPUID.80000007H:EDX
+ */
+#define OMR_FEATURE_X86_INVARIANT_TSC 64 + 8 /* Time Stamp Counter runs at a constant rate in all ACPI P-, C- and T-states. */
+
 struct OMRPortLibrary;
 typedef struct J9Heap J9Heap;
 
@@ -1520,6 +1683,12 @@ typedef struct OMRPortLibrary {
 	uint64_t (*time_hires_frequency)(struct OMRPortLibrary *portLibrary) ;
 	/** see @ref omrtime.c::omrtime_hires_delta "omrtime_hires_delta"*/
 	uint64_t (*time_hires_delta)(struct OMRPortLibrary *portLibrary, uint64_t startTime, uint64_t endTime, uint64_t requiredResolution) ;
+	/** see @ref omrtime.c::omrtime_cycle_clock "omrtime_cycle_clock"*/
+	uint64_t (*time_cycle_clock)(struct OMRPortLibrary *portLibrary) ;
+	/** see @ref omrtime.c::omrtime_cycle_frequency "omrtime_cycle_frequency"*/
+	uint64_t (*time_cycle_frequency)(struct OMRPortLibrary *portLibrary) ;
+	/** see @ref omrtime.c::omrtime_cycles_to_nanos "omrtime_cycles_to_nanos"*/
+	uint64_t (*time_cycles_to_nanos)(struct OMRPortLibrary *portLibrary, uint64_t cycles) ;
 	/** see @ref omrsysinfo.c::omrsysinfo_startup "omrsysinfo_startup"*/
 	int32_t (*sysinfo_startup)(struct OMRPortLibrary *portLibrary) ;
 	/** see @ref omrsysinfo.c::omrsysinfo_shutdown "omrsysinfo_shutdown"*/
@@ -1890,6 +2059,22 @@ typedef struct OMRPortLibrary {
 	int32_t (*file_blockingasync_unlock_bytes)(struct OMRPortLibrary *portLibrary, intptr_t fd, uint64_t offset, uint64_t length) ;
 	/** see @ref omrfile_blockingasync.c::omrfile_blockingasync_lock_bytes "omrfile_blockingasync_lock_bytes"*/
 	int32_t (*file_blockingasync_lock_bytes)(struct OMRPortLibrary *portLibrary, intptr_t fd, int32_t lockFlags, uint64_t offset, uint64_t length) ;
+	/** see @ref omrfileasync.c::omrfile_async_create "omrfile_async_create"*/
+	int32_t (*file_async_create)(struct OMRPortLibrary *portLibrary, uint32_t depth, uint32_t flags, struct OMRFileAsyncQueue **queue) ;
+	/** see @ref omrfileasync.c::omrfile_async_destroy "omrfile_async_destroy"*/
+	void (*file_async_destroy)(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue) ;
+	/** see @ref omrfileasync.c::omrfile_async_submit "omrfile_async_submit"*/
+	intptr_t (*file_async_submit)(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncRequest *requests, uintptr_t count) ;
+	/** see @ref omrfileasync.c::omrfile_async_complete "omrfile_async_complete"*/
+	intptr_t (*file_async_complete)(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions) ;
+	/** see @ref omrfileasync.c::omrfile_async_backend "omrfile_async_backend"*/
+	uint32_t (*file_async_backend)(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue) ;
+	/** see @ref omrfile.c::omrfile_writev "omrfile_writev"*/
+	intptr_t (*file_writev)(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRIOVec *iov, uint32_t iovCount) ;
+	/** see @ref omrfile.c::omrfile_copy_range "omrfile_copy_range"*/
+	int64_t (*file_copy_range)(struct OMRPortLibrary *portLibrary, intptr_t inFD, int64_t inOffset, intptr_t outFD, int64_t outOffset, int64_t length) ;
+	/** see @ref omrfile.c::omrfile_sendfile "omrfile_sendfile"*/
+	int64_t (*file_sendfile)(struct OMRPortLibrary *portLibrary, intptr_t outFD, intptr_t inFD, int64_t inOffset, int64_t length) ;
 	/** see @ref omrstr.c::omrstr_ftime "omrstr_ftime"*/
 	uintptr_t (*str_ftime)(struct OMRPortLibrary *portLibrary, char *buf, uintptr_t bufLen, const char *format, int64_t timeMillis) ;
 	/** see @ref omrmmap.c::omrmmap_startup "omrmmap_startup"*/
@@ -1910,6 +2095,10 @@ typedef struct OMRPortLibrary {
 	uintptr_t (*mmap_get_region_granularity)(struct OMRPortLibrary *portLibrary, void *address) ;
 	/** see @ref omrmmap.c::omrmmap_dont_need "omrmmap_dont_need"*/
 	void (*mmap_dont_need)(struct OMRPortLibrary *portLibrary, const void *startAddress, size_t length) ;
+	/** see @ref omrmmap.c::omrmmap_advise "omrmmap_advise"*/
+	intptr_t (*mmap_advise)(struct OMRPortLibrary *portLibrary, void *start, uintptr_t length, uint32_t advice) ;
+	/** see @ref omrmmap.c::omrmmap_prefetch "omrmmap_prefetch"*/
+	intptr_t (*mmap_prefetch)(struct OMRPortLibrary *portLibrary, J9MmapHandle *handle, uintptr_t offset, uintptr_t length) ;
 	/** see @ref omrsysinfo.c::omrsysinfo_get_limit "omrsysinfo_get_limit"*/
 	uint32_t (*sysinfo_get_limit)(struct OMRPortLibrary *portLibrary, uint32_t resourceID, uint64_t *limit) ;
 	/** see @ref omrsysinfo.c::omrsysinfo_set_limit "omrsysinfo_set_limit"*/
@@ -1960,6 +2149,12 @@ typedef struct OMRPortLibrary {
 	int32_t (*sysinfo_cgroup_subsystem_iterator_next)(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state, struct OMRCgroupMetricElement *metricElement);
 	/** see @ref omrsysinfo.c::omrsysinfo_cgroup_subsystem_iterator_destroy "omrsysinfo_cgroup_subsystem_iterator_destroy"*/
 	void (*sysinfo_cgroup_subsystem_iterator_destroy)(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state);
+	/** see @ref omrsysinfo.c::omrsysinfo_get_cpu_list "omrsysinfo_get_cpu_list"*/
+	int32_t (*sysinfo_get_cpu_list)(struct OMRPortLibrary *portLibrary, uint32_t *cpuList, uintptr_t *cpuCount);
+	/** see @ref omrsysinfo.c::omrsysinfo_get_cpu_topology "omrsysinfo_get_cpu_topology"*/
+	int32_t (*sysinfo_get_cpu_topology)(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology);
+	/** see @ref omrsysinfo.c::omrsysinfo_destroy_cpu_topology "omrsysinfo_destroy_cpu_topology"*/
+	void (*sysinfo_destroy_cpu_topology)(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology);
 	/** see @ref omrport.c::omrport_init_library "omrport_init_library"*/
 	int32_t (*port_init_library)(struct OMRPortLibrary *portLibrary, uintptr_t size) ;
 	/** see @ref omrport.c::omrport_startup_library "omrport_startup_library"*/
@@ -1984,6 +2179,24 @@ typedef struct OMRPortLibrary {
 	uintptr_t (*introspect_backtrace_thread)(struct OMRPortLibrary *portLibrary, J9PlatformThread *thread, J9Heap *heap, void *signalInfo) ;
 	/** see @ref omrintrospect.c::omrintrospect_backtrace_symbols "omrintrospect_backtrace_symbols"*/
 	uintptr_t (*introspect_backtrace_symbols)(struct OMRPortLibrary *portLibrary, J9PlatformThread *thread, J9Heap *heap) ;
+	/** see @ref omrprofiler.c::omrprofiler_create "omrprofiler_create"*/
+	int32_t (*profiler_create)(struct OMRPortLibrary *portLibrary, uint64_t intervalNanos, uint32_t maxFrames, uint32_t bufferSamples, struct OMRProfiler **profiler) ;
+	/** see @ref omrprofiler.c::omrprofiler_destroy "omrprofiler_destroy"*/
+	void (*profiler_destroy)(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler) ;
+	/** see @ref omrprofiler.c::omrprofiler_register_thread "omrprofiler_register_thread"*/
+	int32_t (*profiler_register_thread)(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler) ;
+	/** see @ref omrprofiler.c::omrprofiler_unregister_thread "omrprofiler_unregister_thread"*/
+	int32_t (*profiler_unregister_thread)(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler) ;
+	/** see @ref omrprofiler.c::omrprofiler_start "omrprofiler_start"*/
+	int32_t (*profiler_start)(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler) ;
+	/** see @ref omrprofiler.c::omrprofiler_stop "omrprofiler_stop"*/
+	int32_t (*profiler_stop)(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler) ;
+	/** see @ref omrprofiler.c::omrprofiler_drain "omrprofiler_drain"*/
+	intptr_t (*profiler_drain)(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, omrprofiler_sample_fn callback, void *userData) ;
+	/** see @ref omrprofiler.c::omrprofiler_get_stats "omrprofiler_get_stats"*/
+	void (*profiler_get_stats)(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, OMRProfilerStats *stats) ;
+	/** see @ref omrprofiler.c::omrprofiler_symbolize "omrprofiler_symbolize"*/
+	int32_t (*profiler_symbolize)(struct OMRPortLibrary *portLibrary, uintptr_t address, OMRProfilerSymbol *symbol) ;
 	/** see @ref omrsyslog.c::omrsyslog_query "omrsyslog_query"*/
 	uintptr_t (*syslog_query)(struct OMRPortLibrary *portLibrary) ;
 	/** see @ref omrsyslog.c::omrsyslog_set "omrsyslog_set"*/
@@ -2035,6 +2248,26 @@ typedef struct OMRPortLibrary {
 	int32_t (*sock_recvfrom)(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint8_t *buf, int32_t nbyte, int32_t flags, omrsock_sockaddr_t addrHandle) ;
 	/** see @ref omrsock.c::omrsock_close "omrsock_close"*/
 	int32_t (*sock_close)(struct OMRPortLibrary *portLibrary, omrsock_socket_t *sock) ;
+	/** see @ref omrsock.c::omrsock_sendmsg "omrsock_sendmsg"*/
+	int32_t (*sock_sendmsg)(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, OMRIOVec *iov, uint32_t iovCount, int32_t flags) ;
+	/** see @ref omrsock.c::omrsock_getaddrinfo_address "omrsock_getaddrinfo_address"*/
+	int32_t (*sock_getaddrinfo_address)(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle, omrsock_sockaddr_t addr, int32_t index) ;
+	/** see @ref omrsock.c::omrsock_getsockname "omrsock_getsockname"*/
+	int32_t (*sock_getsockname)(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, omrsock_sockaddr_t addr) ;
+	/** see @ref omrsock.c::omrsock_fcntl "omrsock_fcntl"*/
+	int32_t (*sock_fcntl)(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, int32_t arg) ;
+	/** see @ref omrsock.c::omrsock_poll_create "omrsock_poll_create"*/
+	int32_t (*sock_poll_create)(struct OMRPortLibrary *portLibrary, omrsock_poll_t *pollSet, uint32_t flags) ;
+	/** see @ref omrsock.c::omrsock_poll_destroy "omrsock_poll_destroy"*/
+	int32_t (*sock_poll_destroy)(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet) ;
+	/** see @ref omrsock.c::omrsock_poll_ctl "omrsock_poll_ctl"*/
+	int32_t (*sock_poll_ctl)(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int32_t operation, omrsock_socket_t sock, uint32_t events, void *userData) ;
+	/** see @ref omrsock.c::omrsock_poll_wait "omrsock_poll_wait"*/
+	int32_t (*sock_poll_wait)(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, OMRSockPollEvent *events, uint32_t maxEvents, int64_t timeoutNanos) ;
+	/** see @ref omrsock.c::omrsock_poll_timer_start "omrsock_poll_timer_start"*/
+	int32_t (*sock_poll_timer_start)(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int64_t delayNanos, int64_t intervalNanos, void *userData, omrsock_timer_t *timer) ;
+	/** see @ref omrsock.c::omrsock_poll_timer_cancel "omrsock_poll_timer_cancel"*/
+	int32_t (*sock_poll_timer_cancel)(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, omrsock_timer_t timer) ;
 #endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
 #if defined(OMR_OPT_CUDA)
 	/** CUDA configuration data */
@@ -2244,6 +2477,9 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrtime_hires_clock() privateOmrPortLibrary->time_hires_clock(privateOmrPortLibrary)
 #define omrtime_hires_frequency() privateOmrPortLibrary->time_hires_frequency(privateOmrPortLibrary)
 #define omrtime_hires_delta(param1,param2,param3) privateOmrPortLibrary->time_hires_delta(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrtime_cycle_clock() privateOmrPortLibrary->time_cycle_clock(privateOmrPortLibrary)
+#define omrtime_cycle_frequency() privateOmrPortLibrary->time_cycle_frequency(privateOmrPortLibrary)
+#define omrtime_cycles_to_nanos(param1) privateOmrPortLibrary->time_cycles_to_nanos(privateOmrPortLibrary, (param1))
 #define omrsysinfo_startup() privateOmrPortLibrary->sysinfo_startup(privateOmrPortLibrary)
 #define omrsysinfo_shutdown() privateOmrPortLibrary->sysinfo_shutdown(privateOmrPortLibrary)
 #define omrsysinfo_process_exists(param1) privateOmrPortLibrary->sysinfo_process_exists(privateOmrPortLibrary, (param1))
@@ -2305,6 +2541,14 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrfile_blockingasync_read(param1,param2,param3) privateOmrPortLibrary->file_blockingasync_read(privateOmrPortLibrary, (param1), (param2), (param3))
 #define omrfile_blockingasync_write(param1,param2,param3) privateOmrPortLibrary->file_blockingasync_write(privateOmrPortLibrary, (param1), (param2), (param3))
 #define omrfile_blockingasync_unlock_bytes(param1,param2,param3) privateOmrPortLibrary->file_blockingasync_unlock_bytes(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrfile_async_create(param1,param2,param3) privateOmrPortLibrary->file_async_create(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrfile_async_destroy(param1) privateOmrPortLibrary->file_async_destroy(privateOmrPortLibrary, (param1))
+#define omrfile_async_submit(param1,param2,param3) privateOmrPortLibrary->file_async_submit(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrfile_async_complete(param1,param2,param3,param4) privateOmrPortLibrary->file_async_complete(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrfile_async_backend(param1) privateOmrPortLibrary->file_async_backend(privateOmrPortLibrary, (param1))
+#define omrfile_writev(param1,param2,param3) privateOmrPortLibrary->file_writev(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrfile_copy_range(param1,param2,param3,param4,param5) privateOmrPortLibrary->file_copy_range(privateOmrPortLibrary, (param1), (param2), (param3), (param4), (param5))
+#define omrfile_sendfile(param1,param2,param3,param4) privateOmrPortLibrary->file_sendfile(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
 #define omrfile_blockingasync_lock_bytes(param1,param2,param3,param4) privateOmrPortLibrary->file_blockingasync_lock_bytes(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
 #define omrfile_blockingasync_set_length(param1,param2) privateOmrPortLibrary->file_blockingasync_set_length(privateOmrPortLibrary, (param1), (param2))
 #define omrfile_blockingasync_flength(param1) privateOmrPortLibrary->file_blockingasync_flength(privateOmrPortLibrary, (param1))
@@ -2438,6 +2682,8 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrmmap_protect(param1,param2,param3) privateOmrPortLibrary->mmap_protect(privateOmrPortLibrary, (param1), (param2), (param3))
 #define omrmmap_get_region_granularity(param1) privateOmrPortLibrary->mmap_get_region_granularity(privateOmrPortLibrary, (param1))
 #define omrmmap_dont_need(param1, param2) privateOmrPortLibrary->mmap_dont_need(privateOmrPortLibrary, (param1), param2)
+#define omrmmap_advise(param1,param2,param3) privateOmrPortLibrary->mmap_advise(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrmmap_prefetch(param1,param2,param3) privateOmrPortLibrary->mmap_prefetch(privateOmrPortLibrary, (param1), (param2), (param3))
 #define omrsysinfo_get_limit(param1,param2) privateOmrPortLibrary->sysinfo_get_limit(privateOmrPortLibrary, (param1), (param2))
 #define omrsysinfo_set_limit(param1,param2) privateOmrPortLibrary->sysinfo_set_limit(privateOmrPortLibrary, (param1), (param2))
 #define omrsysinfo_get_number_CPUs_by_type(param1) privateOmrPortLibrary->sysinfo_get_number_CPUs_by_type(privateOmrPortLibrary, (param1))
@@ -2462,6 +2708,9 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrsysinfo_cgroup_subsystem_iterator_metricKey(param1, param2) privateOmrPortLibrary->sysinfo_cgroup_subsystem_iterator_metricKey(privateOmrPortLibrary, param1, param2)
 #define omrsysinfo_cgroup_subsystem_iterator_next(param1, param2) privateOmrPortLibrary->sysinfo_cgroup_subsystem_iterator_next(privateOmrPortLibrary, param1, param2)
 #define omrsysinfo_cgroup_subsystem_iterator_destroy(param1) privateOmrPortLibrary->sysinfo_cgroup_subsystem_iterator_destroy(privateOmrPortLibrary, param1)
+#define omrsysinfo_get_cpu_list(param1, param2) privateOmrPortLibrary->sysinfo_get_cpu_list(privateOmrPortLibrary, param1, param2)
+#define omrsysinfo_get_cpu_topology(param1) privateOmrPortLibrary->sysinfo_get_cpu_topology(privateOmrPortLibrary, param1)
+#define omrsysinfo_destroy_cpu_topology(param1) privateOmrPortLibrary->sysinfo_destroy_cpu_topology(privateOmrPortLibrary, param1)
 #define omrintrospect_startup() privateOmrPortLibrary->introspect_startup(privateOmrPortLibrary)
 #define omrintrospect_shutdown() privateOmrPortLibrary->introspect_shutdown(privateOmrPortLibrary)
 #define omrintrospect_set_suspend_signal_offset(param1) privateOmrPortLibrary->introspect_set_suspend_signal_offset(privateOmrPortLibrary, param1)
@@ -2470,6 +2719,15 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrintrospect_threads_nextDo() privateOmrPortLibrary->introspect_threads_nextDo(privateOmrPortLibrary)
 #define omrintrospect_backtrace_thread(param1,param2,param3) privateOmrPortLibrary->introspect_backtrace_thread(privateOmrPortLibrary, (param1), (param2), (param3))
 #define omrintrospect_backtrace_symbols(param1,param2) privateOmrPortLibrary->introspect_backtrace_symbols(privateOmrPortLibrary, (param1), (param2))
+#define omrprofiler_create(param1,param2,param3,param4) privateOmrPortLibrary->profiler_create(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrprofiler_destroy(param1) privateOmrPortLibrary->profiler_destroy(privateOmrPortLibrary, (param1))
+#define omrprofiler_register_thread(param1) privateOmrPortLibrary->profiler_register_thread(privateOmrPortLibrary, (param1))
+#define omrprofiler_unregister_thread(param1) privateOmrPortLibrary->profiler_unregister_thread(privateOmrPortLibrary, (param1))
+#define omrprofiler_start(param1) privateOmrPortLibrary->profiler_start(privateOmrPortLibrary, (param1))
+#define omrprofiler_stop(param1) privateOmrPortLibrary->profiler_stop(privateOmrPortLibrary, (param1))
+#define omrprofiler_drain(param1,param2,param3) privateOmrPortLibrary->profiler_drain(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrprofiler_get_stats(param1,param2) privateOmrPortLibrary->profiler_get_stats(privateOmrPortLibrary, (param1), (param2))
+#define omrprofiler_symbolize(param1,param2) privateOmrPortLibrary->profiler_symbolize(privateOmrPortLibrary, (param1), (param2))
 #define omrsyslog_query() privateOmrPortLibrary->syslog_query(privateOmrPortLibrary)
 #define omrsyslog_set(param1) privateOmrPortLibrary->syslog_set(privateOmrPortLibrary, (param1))
 #define omrmem_walk_categories(param1) privateOmrPortLibrary->mem_walk_categories(privateOmrPortLibrary, (param1))
@@ -2496,6 +2754,16 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrsock_recv(param1,param2,param3,param4) privateOmrPortLibrary->sock_recv(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
 #define omrsock_recvfrom(param1,param2,param3,param4,param5) privateOmrPortLibrary->sock_recvfrom(privateOmrPortLibrary, (param1), (param2), (param3), (param4), (param5))
 #define omrsock_close(param1) privateOmrPortLibrary->sock_close(privateOmrPortLibrary, (param1))
+#define omrsock_sendmsg(param1,param2,param3,param4) privateOmrPortLibrary->sock_sendmsg(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrsock_getaddrinfo_address(param1,param2,param3) privateOmrPortLibrary->sock_getaddrinfo_address(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrsock_getsockname(param1,param2) privateOmrPortLibrary->sock_getsockname(privateOmrPortLibrary, (param1), (param2))
+#define omrsock_fcntl(param1,param2) privateOmrPortLibrary->sock_fcntl(privateOmrPortLibrary, (param1), (param2))
+#define omrsock_poll_create(param1,param2) privateOmrPortLibrary->sock_poll_create(privateOmrPortLibrary, (param1), (param2))
+#define omrsock_poll_destroy(param1) privateOmrPortLibrary->sock_poll_destroy(privateOmrPortLibrary, (param1))
+#define omrsock_poll_ctl(param1,param2,param3,param4,param5) privateOmrPortLibrary->sock_poll_ctl(privateOmrPortLibrary, (param1), (param2), (param3), (param4), (param5))
+#define omrsock_poll_wait(param1,param2,param3,param4) privateOmrPortLibrary->sock_poll_wait(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrsock_poll_timer_start(param1,param2,param3,param4,param5) privateOmrPortLibrary->sock_poll_timer_start(privateOmrPortLibrary, (param1), (param2), (param3), (param4), (param5))
+#define omrsock_poll_timer_cancel(param1,param2) privateOmrPortLibrary->sock_poll_timer_cancel(privateOmrPortLibrary, (param1), (param2))
 #endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
 
 #if defined(OMR_OPT_CUDA)
@@ -170,6 +170,7 @@
 #define OMRPORT_ERROR_FILE_READ_NO_BYTES_READ (OMRPORT_ERROR_FILE_BASE-39)
 #define OMRPORT_ERROR_FILE_FAILED_TO_ALLOCATE_TLS (OMRPORT_ERROR_FILE_BASE-40)
 #define OMRPORT_ERROR_FILE_TOO_MANY_OPEN_FILES (OMRPORT_ERROR_FILE_BASE-41)
+#define OMRPORT_ERROR_FILE_ASYNC_CANCELED (OMRPORT_ERROR_FILE_BASE-42)
 
 
 /** @} */
@@ -191,6 +192,9 @@
 #define OMRPORT_ERROR_MMAP_MSYNC_INVALIDFLAGS (OMRPORT_ERROR_MMAP_BASE-6)
 #define OMRPORT_ERROR_MMAP_MSYNC_FAILED (OMRPORT_ERROR_MMAP_BASE-7)
 #define OMRPORT_ERROR_MMAP_MAP_FILE_STATFAILED (OMRPORT_ERROR_MMAP_BASE-8)
+#define OMRPORT_ERROR_MMAP_ADVISE_INVALIDADVICE (OMRPORT_ERROR_MMAP_BASE-9)
+#define OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED (OMRPORT_ERROR_MMAP_BASE-10)
+#define OMRPORT_ERROR_MMAP_ADVISE_FAILED (OMRPORT_ERROR_MMAP_BASE-11)
 /** @} */
 
 /**
@@ -314,4 +318,37 @@
  * @}
  */
 
+/**
+ * @name omrsock Errors
+ * Error codes returned by the socket API
+ *
+ * @internal OMRPORT_ERROR_SOCKET_* range from -500 to -549 avoid overlap
+ * @{
+ */
+#define OMRPORT_ERROR_SOCKET_BASE -500
+#define OMRPORT_ERROR_SOCKET_UNKNOWN_ERROR (OMRPORT_ERROR_SOCKET_BASE - 0)
+#define OMRPORT_ERROR_SOCKET_BAD_DESCRIPTOR (OMRPORT_ERROR_SOCKET_BASE - 1)
+#define OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT (OMRPORT_ERROR_SOCKET_BASE - 2)
+#define OMRPORT_ERROR_SOCKET_NO_BUFFERS (OMRPORT_ERROR_SOCKET_BASE - 3)
+#define OMRPORT_ERROR_SOCKET_SYSTEM_FULL (OMRPORT_ERROR_SOCKET_BASE - 4)
+#define OMRPORT_ERROR_SOCKET_ADDRESS_IN_USE (OMRPORT_ERROR_SOCKET_BASE - 5)
+#define OMRPORT_ERROR_SOCKET_ADDRESS_NOT_AVAILABLE (OMRPORT_ERROR_SOCKET_BASE - 6)
+#define OMRPORT_ERROR_SOCKET_CONNECTION_REFUSED (OMRPORT_ERROR_SOCKET_BASE - 7)
+#define OMRPORT_ERROR_SOCKET_CONNECTION_RESET (OMRPORT_ERROR_SOCKET_BASE - 8)
+#define OMRPORT_ERROR_SOCKET_NOT_CONNECTED (OMRPORT_ERROR_SOCKET_BASE - 9)
+#define OMRPORT_ERROR_SOCKET_TIMEOUT (OMRPORT_ERROR_SOCKET_BASE - 10)
+#define OMRPORT_ERROR_SOCKET_WOULDBLOCK (OMRPORT_ERROR_SOCKET_BASE - 11)
+#define OMRPORT_ERROR_SOCKET_IN_PROGRESS (OMRPORT_ERROR_SOCKET_BASE - 12)
+#define OMRPORT_ERROR_SOCKET_INTERRUPTED (OMRPORT_ERROR_SOCKET_BASE - 13)
+#define OMRPORT_ERROR_SOCKET_ADDRINFO_FAILED (OMRPORT_ERROR_SOCKET_BASE - 14)
+#define OMRPORT_ERROR_SOCKET_FAMILY_NOT_SUPPORTED (OMRPORT_ERROR_SOCKET_BASE - 15)
+#define OMRPORT_ERROR_SOCKET_OPERATION_NOT_SUPPORTED (OMRPORT_ERROR_SOCKET_BASE - 16)
+#define OMRPORT_ERROR_SOCKET_NOT_SOCKET (OMRPORT_ERROR_SOCKET_BASE - 17)
+#define OMRPORT_ERROR_SOCKET_NO_PERMISSION (OMRPORT_ERROR_SOCKET_BASE - 18)
+#define OMRPORT_ERROR_SOCKET_ALREADY_REGISTERED (OMRPORT_ERROR_SOCKET_BASE - 19)
+#define OMRPORT_ERROR_SOCKET_NOT_REGISTERED (OMRPORT_ERROR_SOCKET_BASE - 20)
+/**
+ * @}
+ */
+
 #endif /* omrporterror_h */
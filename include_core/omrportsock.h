@@ -23,6 +23,17 @@
 #if !defined(OMRPORTSOCK_H_)
 #define OMRPORTSOCK_H_
 
+/* Holds the results of omrsock_getaddrinfo, or hints for it. Callers may allocate it, but not interpret it. */
+typedef struct OMRAddrInfoNode {
+	void *addrInfo; /* first entry of the native list */
+	uint32_t length; /* number of entries in the list */
+} OMRAddrInfoNode;
+
+/* Storage for a socket address. It has enough space for IPv4 or IPv6 addresses. */
+typedef struct OMRSockAddrStorage {
+	uint64_t data[16];
+} OMRSockAddrStorage;
+
 /* Pointer to OMRAddInfoNode, a struct that contains addrinfo information. */
 typedef struct OMRAddrInfoNode *omrsock_addrinfo_t;
 
@@ -32,4 +43,57 @@ typedef struct OMRSockAddrStorage *omrsock_sockaddr_t;
 /* Pointer to a socket descriptor */
 typedef struct OMRSocket *omrsock_socket_t;
 
+/* Pointer to a set of sockets polled for readiness, see omrsock_poll_create */
+typedef struct OMRSockPoll *omrsock_poll_t;
+
+/* Pointer to a timer delivered through a poll set, see omrsock_poll_timer_start */
+typedef struct OMRSockPollTimer *omrsock_timer_t;
+
+/* Address families */
+#define OMRSOCK_AF_UNSPEC 0
+#define OMRSOCK_AF_INET 1
+#define OMRSOCK_AF_INET6 2
+
+/* Socket types, 0 matches any type in getaddrinfo hints */
+#define OMRSOCK_STREAM 1
+#define OMRSOCK_DGRAM 2
+
+/* Protocols */
+#define OMRSOCK_IPPROTO_DEFAULT 0
+#define OMRSOCK_IPPROTO_TCP 1
+#define OMRSOCK_IPPROTO_UDP 2
+
+/* omrsock_getaddrinfo_create_hints flags */
+#define OMRSOCK_AI_PASSIVE 0x1
+#define OMRSOCK_AI_NUMERICHOST 0x2
+#define OMRSOCK_AI_NUMERICSERV 0x4
+
+/* omrsock_fcntl flags */
+#define OMRSOCK_O_NONBLOCK 0x1
+
+/* omrsock_sendmsg flag: transmit from the caller's buffers without copying them, where supported. */
+#define OMRSOCK_MSG_ZEROCOPY 0x1
+
+/* omrsock_poll_ctl operations */
+#define OMRSOCK_POLL_ADD 1
+#define OMRSOCK_POLL_MODIFY 2
+#define OMRSOCK_POLL_REMOVE 3
+
+/* Readiness events, requested with omrsock_poll_ctl and reported by omrsock_poll_wait */
+#define OMRSOCK_POLLIN 0x1
+#define OMRSOCK_POLLOUT 0x2
+/* Reported whether requested or not */
+#define OMRSOCK_POLLERR 0x4
+#define OMRSOCK_POLLHUP 0x8
+/* Reported for an expired timer */
+#define OMRSOCK_POLLTIMER 0x10
+/* Request flag: report readiness only when it changes, see omrsock_poll_ctl */
+#define OMRSOCK_POLLET 0x100
+
+/* One event returned by omrsock_poll_wait */
+typedef struct OMRSockPollEvent {
+	void *userData; /* as passed to omrsock_poll_ctl or omrsock_poll_timer_start */
+	uint32_t events; /* OMRSOCK_POLL* bits */
+} OMRSockPollEvent;
+
 #endif /* !defined(OMRPORTSOCK_H_) */
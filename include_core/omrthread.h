@@ -103,6 +103,8 @@ or omrthread priority value.
 #define J9THREAD_LIB_FLAG_DESTROY_MUTEX_ON_MONITOR_FREE  0x400000
 #define J9THREAD_LIB_FLAG_ENABLE_CPU_MONITOR  0x800000
 #define J9THREAD_LIB_FLAG_NO_DEFAULT_AFFINITY  0x1000000
+#define J9THREAD_LIB_FLAG_CONTENTION_PROFILE_ENABLED  0x2000000
+#define J9THREAD_LIB_FLAG_LOCK_ORDER_ENABLED  0x4000000
 
 #define J9THREAD_LIB_YIELD_ALGORITHM_SCHED_YIELD  0
 #define J9THREAD_LIB_YIELD_ALGORITHM_CONSTANT_USLEEP  2
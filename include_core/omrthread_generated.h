@@ -193,6 +193,11 @@ typedef struct J9ThreadMonitorTracing {
 	uintptr_t recursive_count;
 	uintptr_t spin2_count;
 	uintptr_t yield_count;
+	uintptr_t spin_acquire_count;
+	uintptr_t spin_fail_count;
+	uintptr_t spin_skip_count;
+	uintptr_t spin_budget;
+	uintptr_t spin_success_percent;
 #if defined(OMR_THR_JLM_HOLD_TIMES)
 	uint64_t enter_time;
 	uint64_t holdtime_sum;
@@ -259,6 +264,16 @@ typedef struct J9ThreadMonitorTracing {
 #define J9_ABSTRACT_MONITOR_FIELDS_8
 #endif /* defined(OMR_THR_MCS_LOCKS) */
 
+#if defined(OMR_THR_ADAPTIVE_SPIN) && defined(OMR_THR_THREE_TIER_LOCKING)
+#define J9_ABSTRACT_MONITOR_FIELDS_9 \
+	uintptr_t spinBudget; \
+	uintptr_t spinHoldEstimate; \
+	uintptr_t spinSuccessRate; \
+	uintptr_t spinProbeCounter;
+#else /* defined(OMR_THR_ADAPTIVE_SPIN) && defined(OMR_THR_THREE_TIER_LOCKING) */
+#define J9_ABSTRACT_MONITOR_FIELDS_9
+#endif /* defined(OMR_THR_ADAPTIVE_SPIN) && defined(OMR_THR_THREE_TIER_LOCKING) */
+
 #define J9_ABSTRACT_MONITOR_FIELDS \
 	J9_ABSTRACT_MONITOR_FIELDS_1 \
 	J9_ABSTRACT_MONITOR_FIELDS_2 \
@@ -267,7 +282,8 @@ typedef struct J9ThreadMonitorTracing {
 	J9_ABSTRACT_MONITOR_FIELDS_5 \
 	J9_ABSTRACT_MONITOR_FIELDS_6 \
 	J9_ABSTRACT_MONITOR_FIELDS_7 \
-	J9_ABSTRACT_MONITOR_FIELDS_8
+	J9_ABSTRACT_MONITOR_FIELDS_8 \
+	J9_ABSTRACT_MONITOR_FIELDS_9
 
 /*
  * @ddr_namespace: map_to_type=J9ThreadAbstractMonitor
@@ -48,6 +48,9 @@ extern "C" {
 #define J9THREAD_RWMUTEX_FAIL	 	 1
 #define J9THREAD_RWMUTEX_WOULDBLOCK -1
 
+/* Flags for omrthread_rwmutex_init */
+#define J9THREAD_RWMUTEX_NO_READ_BIAS	0x1
+
 /* Define conversions for units of time used in thrprof.c */
 #define SEC_TO_NANO_CONVERSION_CONSTANT		1000 * 1000 * 1000
 #define MICRO_TO_NANO_CONVERSION_CONSTANT	1000
@@ -87,6 +90,21 @@ typedef enum omrthread_schedpolicy_t {
 	omrthread_schedpolicy_EnsureWideEnum = 0x1000000
 } omrthread_schedpolicy_t;
 
+typedef enum omrthread_numa_placement_t {
+	/* leave the thread on the node set it inherits */
+	J9THREAD_NUMA_PLACEMENT_NONE,
+	/* spread successive threads round-robin across the NUMA nodes */
+	J9THREAD_NUMA_PLACEMENT_INTERLEAVE,
+	/* place threads on the lowest node which still has a usable CPU for each of them */
+	J9THREAD_NUMA_PLACEMENT_FILL_FIRST,
+	/* place the thread on the node(s) of another thread */
+	J9THREAD_NUMA_PLACEMENT_COLOCATE,
+	/* dummy value marking end of list */
+	omrthread_numa_placement_LastEnum,
+	/* ensure 4-byte enum */
+	omrthread_numa_placement_EnsureWideEnum = 0x1000000
+} omrthread_numa_placement_t;
+
 typedef uintptr_t omrthread_prio_t;
 
 typedef struct omrthread_monitor_walk_state_t {
@@ -95,6 +113,150 @@ typedef struct omrthread_monitor_walk_state_t {
 	BOOLEAN lockTaken;
 } omrthread_monitor_walk_state_t;
 
+/* Number of log2 buckets in a monitor contention histogram */
+#define J9THREAD_CONTENTION_HISTOGRAM_BUCKETS 32
+/* Maximum number of frames kept for a sampled acquisition call site */
+#define J9THREAD_CONTENTION_CALLSITE_FRAMES 16
+
+/**
+ * Capture the current call stack for the contention profiler or lock-order tracker.
+ * @param[in] userData the value passed to omrthread_contention_profile_enable or omrthread_lock_order_enable
+ * @param[out] frames instruction pointers, innermost first
+ * @param[in] maxFrames capacity of frames
+ * @return the number of frames stored
+ */
+typedef uintptr_t (*omrthread_contention_sampler_t)(void *userData, void **frames, uintptr_t maxFrames);
+
+/**
+ * Contention observed on one monitor by the contention profiler.
+ * Times are in nanoseconds. Bucket 0 of a histogram counts intervals under 1us
+ * and bucket i counts [2^(i-1), 2^i) us.
+ */
+typedef struct J9ThreadMonitorContention {
+	uintptr_t blockedEnterCount;
+	uint64_t blockedEnterTime;
+	uint64_t maxBlockedEnterTime;
+	uintptr_t blockedEnterHistogram[J9THREAD_CONTENTION_HISTOGRAM_BUCKETS];
+	uintptr_t waitCount;
+	uint64_t waitTime;
+	uintptr_t waitHistogram[J9THREAD_CONTENTION_HISTOGRAM_BUCKETS];
+	uintptr_t callSiteFrameCount;
+	void *callSite[J9THREAD_CONTENTION_CALLSITE_FRAMES];
+} J9ThreadMonitorContention;
+
+typedef struct J9ThreadMonitorContentionInfo {
+	omrthread_monitor_t monitor;
+	const char *name;
+	J9ThreadMonitorContention contention;
+} J9ThreadMonitorContentionInfo;
+
+/* Maximum number of frames kept for an acquisition recorded by the lock-order tracker */
+#define J9THREAD_LOCK_ORDER_FRAMES 16
+
+/**
+ * A lock-order inversion: a thread entered enteringName while holding heldName, but
+ * enteringName has been held (directly or through other monitors) while entering heldName.
+ */
+typedef struct J9ThreadLockOrderInversion {
+	omrthread_t thread;
+	const char *heldName;
+	const char *enteringName;
+	void **frames; /* call stack of thread, entering enteringName */
+	uintptr_t frameCount;
+	const char *conflictHeldName; /* first acquisition on the path back from enteringName to heldName */
+	const char *conflictEnteredName;
+	void **conflictFrames; /* call stack recorded when that acquisition was first seen */
+	uintptr_t conflictFrameCount;
+} J9ThreadLockOrderInversion;
+
+/**
+ * Report a lock-order inversion. Called once per inverted pair, on the thread that
+ * is about to enter the monitor, before it can block.
+ */
+typedef void (*omrthread_lock_order_report_t)(void *userData, const J9ThreadLockOrderInversion *inversion);
+
+/**
+ * One edge of the lock-order graph: enteredName was entered while heldName was held.
+ */
+typedef struct J9ThreadLockOrderEdge {
+	const char *heldName;
+	const char *enteredName;
+	uintptr_t inverted; /* non-zero if this edge closed a cycle when first seen */
+	uintptr_t frameCount;
+	void *frames[J9THREAD_LOCK_ORDER_FRAMES]; /* call stack of the first acquisition seen */
+} J9ThreadLockOrderEdge;
+
+typedef struct J9ThreadTaskPool *omrthread_taskpool_t;
+
+/**
+ * The body of a task pool task.
+ * @param[in] pool the pool running the task, into which it may fork further tasks
+ * @param[in] arg the argument given to omrthread_task_init
+ */
+typedef void (*omrthread_task_function_t)(omrthread_taskpool_t pool, void *arg);
+
+/**
+ * The body of a parallel-for loop, called with disjoint sub-ranges [begin, end).
+ */
+typedef void (*omrthread_parallel_for_function_t)(void *userData, uintptr_t begin, uintptr_t end);
+
+/**
+ * A fork/join task. Tasks are owned by the caller, usually on the forking thread's
+ * stack, so forking never allocates; the task must stay valid until it is joined.
+ */
+typedef struct J9ThreadTask {
+	omrthread_task_function_t function;
+	void *arg;
+	volatile uintptr_t state;
+	struct J9ThreadTask *next; /* link in the pool's queue of tasks forked by non-worker threads */
+} J9ThreadTask;
+
+/**
+ * Called by omrthread_parking_lot_park with the address's queue locked.
+ * @return non-zero to park, 0 to return J9THREAD_WOULD_BLOCK without parking
+ */
+typedef uintptr_t (*omrthread_parking_lot_validate_t)(void *userData);
+
+/**
+ * Called by omrthread_parking_lot_park after the caller is queued, before it blocks.
+ */
+typedef void (*omrthread_parking_lot_before_sleep_t)(void *userData);
+
+/**
+ * Called by omrthread_parking_lot_unpark_one with the address's queue still locked.
+ * @param[in] unparked non-zero if a thread was dequeued
+ * @param[in] moreWaiters non-zero if other threads remain parked on the address
+ */
+typedef void (*omrthread_parking_lot_unpark_callback_t)(void *userData, uintptr_t unparked, uintptr_t moreWaiters);
+
+/**
+ * A one-word lock with wait/notify, whose waiters live in the parking lot.
+ * Initialize to J9THREAD_WORDLOCK_INITIALIZER. Word locks have no owner and are not reentrant.
+ */
+typedef volatile uintptr_t omrthread_wordlock_t;
+#define J9THREAD_WORDLOCK_INITIALIZER 0
+
+/* Fields requested from omrthread_get_sched_stats */
+#define J9THREAD_SCHED_STATS_CPU_TIME 0x1
+#define J9THREAD_SCHED_STATS_CONTEXT_SWITCHES 0x2
+#define J9THREAD_SCHED_STATS_LAST_CPU 0x4
+#define J9THREAD_SCHED_STATS_ALL (J9THREAD_SCHED_STATS_CPU_TIME | J9THREAD_SCHED_STATS_CONTEXT_SWITCHES | J9THREAD_SCHED_STATS_LAST_CPU)
+
+/**
+ * Scheduling telemetry for one thread, as sampled by omrthread_get_sched_stats.
+ * Fields which were not requested, are not supported on the platform, or could not
+ * be read because the thread exited during the sample are -1.
+ */
+typedef struct J9ThreadSchedStats {
+	omrthread_t thread; /* identifies the thread only; it may have exited by the time the sample is read */
+	uintptr_t tid;
+	int64_t cpuTime; /* nanoseconds spent on a CPU */
+	int64_t runDelay; /* nanoseconds spent runnable while waiting for a CPU */
+	int64_t voluntaryContextSwitches;
+	int64_t involuntaryContextSwitches;
+	intptr_t lastCpu;
+} J9ThreadSchedStats;
+
 /* ---------------- omrthreadinspect.c ---------------- */
 
 /**
@@ -1073,6 +1235,25 @@ intptr_t
 omrthread_tls_set(omrthread_t thread, omrthread_tls_key_t key, void *value);
 
 
+/**
+* @brief
+* @param key
+* @return void*
+*/
+void *
+omrthread_tls_get_current(omrthread_tls_key_t key);
+
+
+/**
+* @brief
+* @param key
+* @param value
+* @return intptr_t
+*/
+intptr_t
+omrthread_tls_set_current(omrthread_tls_key_t key, void *value);
+
+
 /**
 * @brief
 * @param thread
@@ -1248,6 +1429,22 @@ omrthread_get_jvm_cpu_usage_info(J9ThreadsCpuUsage *cpuUsage);
 void
 omrthread_get_jvm_cpu_usage_info_error_recovery(void);
 
+/**
+ * @brief Sample CPU and scheduling statistics for every live thread in one pass
+ *
+ * The thread list is copied under the library lock, which is then released before
+ * any per-thread data is read, so the lock hold time does not grow with the cost of
+ * the OS queries. Nothing is allocated; results go into the caller's array.
+ *
+ * @param[out] stats array receiving one entry per thread
+ * @param[in,out] count capacity of stats on input, number of live threads on output.
+ * Only the first min(capacity, live threads) entries are filled in.
+ * @param[in] fields bitwise-OR of J9THREAD_SCHED_STATS_* selecting what to sample
+ * @return J9THREAD_SUCCESS
+ */
+intptr_t
+omrthread_get_sched_stats(J9ThreadSchedStats *stats, uintptr_t *count, uintptr_t fields);
+
 /* ---------------- omrthreadattr.c ---------------- */
 
 /**
@@ -1327,6 +1524,19 @@ omrthread_attr_set_stacksize(omrthread_attr_t *attr, uintptr_t stacksize);
 intptr_t
 omrthread_attr_set_category(omrthread_attr_t *attr, uint32_t category);
 
+/**
+ * Set the NUMA placement policy
+ *
+ * @param[in] attr
+ * @param[in] placement the policy used to choose a NUMA node for the new thread
+ * @param[in] colocateWith the thread to co-locate with for J9THREAD_NUMA_PLACEMENT_COLOCATE (NULL means the creating thread)
+ * @retval J9THREAD_SUCCESS on success
+ * @retval J9THREAD_ERR_INVALID_ATTR attr is an invalid attribute
+ * @retval J9THREAD_ERR_INVALID_VALUE placement is invalid
+ */
+intptr_t
+omrthread_attr_set_numa_placement(omrthread_attr_t *attr, omrthread_numa_placement_t placement, omrthread_t colocateWith);
+
 /* ---------------- omrthreaderror.c ---------------- */
 /**
  * @brief
@@ -1353,6 +1563,34 @@ omrthread_get_os_errno2(void);
 #endif /* J9ZOS390 */
 
 
+/* -------------- omrthreadlockorder.c ------------------- */
+
+/**
+ * @brief Start tracking the order in which named monitors are entered
+ * @param[in] sampler call stack sampler for new edges and inversions, or NULL
+ * @param[in] report called for each newly found inversion, or NULL
+ * @param[in] userData passed to sampler and report
+ * @return 0 on success, or J9THREAD_ERR_NOMEMORY
+ */
+intptr_t
+omrthread_lock_order_enable(omrthread_contention_sampler_t sampler, omrthread_lock_order_report_t report, void *userData);
+
+/**
+ * @brief Stop tracking monitor order. The graph recorded so far is kept.
+ * @return void
+ */
+void
+omrthread_lock_order_disable(void);
+
+/**
+ * @brief Copy out the lock-order graph
+ * @param[out] edges array to receive the edges
+ * @param[in] maxEdges capacity of edges
+ * @return the number of edges in the graph, which may exceed maxEdges
+ */
+uintptr_t
+omrthread_lock_order_export(J9ThreadLockOrderEdge *edges, uintptr_t maxEdges);
+
 /* -------------- omrthreadnuma.c ------------------- */
 /* success code for trheadnuma API */
 #define J9THREAD_NUMA_OK 					0
@@ -1404,6 +1642,232 @@ omrthread_numa_set_enabled(BOOLEAN enabled);
 uintptr_t
 omrthread_numa_get_current_node();
 
+/**
+ * Gets the NUMA node the specified thread was last executed on
+ * @param[in] thread the thread to be queried (must have started)
+ * @return the node, where 1 is the first node, or 0 if it cannot be determined or NUMA is not available
+ */
+uintptr_t
+omrthread_numa_get_thread_node(omrthread_t thread);
+
+/* -------------- omrthreadcontention.c ------------------- */
+
+/**
+ * @brief Start recording blocked monitor enters and waits
+ * @param callSiteSampleInterval sample the call site of every Nth blocked enter on a monitor, 0 for never
+ * @param sampler call stack sampler, or NULL not to sample call sites
+ * @param userData passed to sampler
+ * @return 0 on success
+ */
+intptr_t
+omrthread_contention_profile_enable(uintptr_t callSiteSampleInterval, omrthread_contention_sampler_t sampler, void *userData);
+
+/**
+ * @brief Stop recording blocked monitor enters and waits. Recorded data is kept.
+ * @return void
+ */
+void
+omrthread_contention_profile_disable(void);
+
+/**
+ * @brief Discard the contention recorded for every monitor
+ * @return void
+ */
+void
+omrthread_contention_profile_reset(void);
+
+/**
+ * @brief Copy out the most contended monitors, by total time blocked entering them
+ * @param records array to receive the monitors, most contended first
+ * @param maxRecords capacity of records
+ * @return the number of records filled in
+ */
+uintptr_t
+omrthread_contention_profile_dump(J9ThreadMonitorContentionInfo *records, uintptr_t maxRecords);
+
+/* -------------- omrthreadtaskpool.c ------------------- */
+
+/**
+ * @brief Create a work-stealing task pool
+ * @param[out] pool the new pool
+ * @param[in] workerCount number of worker threads, at least 1
+ * @param[in] category thread category of the workers
+ * @param[in] placement NUMA placement policy of the workers
+ * @return J9THREAD_SUCCESS, or J9THREAD_ERR_INVALID_VALUE, J9THREAD_ERR_NOMEMORY or a thread creation error
+ */
+intptr_t
+omrthread_taskpool_create(omrthread_taskpool_t *pool, uintptr_t workerCount, uint32_t category, omrthread_numa_placement_t placement);
+
+/**
+ * @brief Stop the workers and free the pool. Every forked task must have been joined.
+ * @param[in] pool
+ * @return void
+ */
+void
+omrthread_taskpool_destroy(omrthread_taskpool_t pool);
+
+/**
+ * @brief Number of worker threads in the pool
+ * @param[in] pool
+ * @return uintptr_t
+ */
+uintptr_t
+omrthread_taskpool_worker_count(omrthread_taskpool_t pool);
+
+/**
+ * @brief Index of the calling thread among the pool's workers
+ * @param[in] pool
+ * @return the index in [0, worker count), or -1 if the caller is not a worker of pool
+ */
+intptr_t
+omrthread_taskpool_worker_index(omrthread_taskpool_t pool);
+
+/**
+ * @brief Prepare a task for omrthread_taskpool_fork
+ * @param[out] task
+ * @param[in] function
+ * @param[in] arg
+ * @return void
+ */
+void
+omrthread_task_init(J9ThreadTask *task, omrthread_task_function_t function, void *arg);
+
+/**
+ * @brief Make a task available to the pool
+ *
+ * A worker pushes the task onto its own deque, from which idle workers steal;
+ * other threads queue it on the pool. If the worker's deque is full the task runs
+ * immediately on the caller.
+ *
+ * @param[in] pool
+ * @param[in] task initialized with omrthread_task_init
+ * @return void
+ */
+void
+omrthread_taskpool_fork(omrthread_taskpool_t pool, J9ThreadTask *task);
+
+/**
+ * @brief Wait for a forked task to complete
+ *
+ * The caller runs other queued tasks while it waits, including the task itself
+ * if no other thread has taken it yet, so joining from inside a task cannot
+ * starve the pool. A thread which is not a worker of the pool blocks on the
+ * pool monitor once there is nothing left to help with.
+ *
+ * @param[in] pool
+ * @param[in] task
+ * @return void
+ */
+void
+omrthread_taskpool_join(omrthread_taskpool_t pool, J9ThreadTask *task);
+
+/**
+ * @brief Run function over [begin, end) in parallel
+ *
+ * The range is split in halves, forking one half, until pieces are no larger than
+ * grain. Returns when every piece has completed.
+ *
+ * @param[in] pool
+ * @param[in] begin
+ * @param[in] end
+ * @param[in] grain the largest range passed to one call of function (0 is treated as 1)
+ * @param[in] function
+ * @param[in] userData passed to function
+ * @return void
+ */
+void
+omrthread_taskpool_parallel_for(omrthread_taskpool_t pool, uintptr_t begin, uintptr_t end, uintptr_t grain, omrthread_parallel_for_function_t function, void *userData);
+
+/* -------------- omrthreadparkinglot.c ------------------- */
+
+/**
+ * @brief Block the current thread on an address until unparked
+ *
+ * Threads parked on any address share a global table of wait queues, so the
+ * address needs no blocking structures of its own.
+ *
+ * @param[in] address the key to park on. It is never dereferenced.
+ * @param[in] validate decides under the queue lock whether to park, or NULL to always park
+ * @param[in] beforeSleep called once queued, before blocking, or NULL
+ * @param[in] userData passed to validate and beforeSleep
+ * @param[in] millis
+ * @param[in] nanos
+ * @return J9THREAD_SUCCESS if unparked, J9THREAD_TIMED_OUT, or J9THREAD_WOULD_BLOCK if validate failed
+ */
+intptr_t
+omrthread_parking_lot_park(void *address, omrthread_parking_lot_validate_t validate, omrthread_parking_lot_before_sleep_t beforeSleep, void *userData, int64_t millis, intptr_t nanos);
+
+/**
+ * @brief Wake the longest-parked thread on an address
+ * @param[in] address
+ * @param[in] callback called with the queue locked, or NULL
+ * @param[in] userData passed to callback
+ * @return 1 if a thread was unparked, otherwise 0
+ */
+uintptr_t
+omrthread_parking_lot_unpark_one(void *address, omrthread_parking_lot_unpark_callback_t callback, void *userData);
+
+/**
+ * @brief Wake every thread parked on an address
+ * @param[in] address
+ * @return the number of threads unparked
+ */
+uintptr_t
+omrthread_parking_lot_unpark_all(void *address);
+
+/**
+ * @brief Acquire a word lock, parking if it stays contended
+ * @param[in] lock
+ * @return void
+ */
+void
+omrthread_wordlock_enter(omrthread_wordlock_t *lock);
+
+/**
+ * @brief Acquire a word lock if it is free
+ * @param[in] lock
+ * @return 0 on success, non-zero if the lock is held
+ */
+intptr_t
+omrthread_wordlock_try_enter(omrthread_wordlock_t *lock);
+
+/**
+ * @brief Release a word lock held by the caller
+ * @param[in] lock
+ * @return void
+ */
+void
+omrthread_wordlock_exit(omrthread_wordlock_t *lock);
+
+/**
+ * @brief Release a held word lock, wait to be notified, then reacquire it
+ *
+ * As with monitors, waits may return without a notify; callers re-check their condition.
+ *
+ * @param[in] lock
+ * @param[in] millis 0 (with nanos 0) to wait forever
+ * @param[in] nanos
+ * @return J9THREAD_SUCCESS if notified, or J9THREAD_TIMED_OUT
+ */
+intptr_t
+omrthread_wordlock_wait(omrthread_wordlock_t *lock, int64_t millis, intptr_t nanos);
+
+/**
+ * @brief Wake one thread waiting on a word lock. The caller must hold the lock.
+ * @param[in] lock
+ * @return void
+ */
+void
+omrthread_wordlock_notify(omrthread_wordlock_t *lock);
+
+/**
+ * @brief Wake every thread waiting on a word lock. The caller must hold the lock.
+ * @param[in] lock
+ * @return void
+ */
+void
+omrthread_wordlock_notify_all(omrthread_wordlock_t *lock);
+
 /* -------------- rasthrsup.c ------------------- */
 /**
  * @brief
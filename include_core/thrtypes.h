@@ -31,6 +31,9 @@ extern "C" {
 #include "omrmemcategories.h"
 #include "thrdsup.h"
 
+/* Monitors a thread can hold at once and still have its lock order tracked */
+#define J9THREAD_LOCK_ORDER_MAX_HELD 16
+
 typedef struct J9Thread {
 	J9_ABSTRACT_THREAD_FIELDS
 	OSTHREAD handle;
@@ -45,6 +48,7 @@ typedef struct J9Thread {
 #endif /* LINUX */
 #if defined(OMR_PORT_NUMA_SUPPORT)
 	uint8_t numaAffinity[128];
+	uintptr_t numaPlacementNode;
 #endif /* OMR_PORT_NUMA_SUPPORT */
 	struct J9ThreadMonitor *destroyed_monitor_head;
 	struct J9ThreadMonitor *destroyed_monitor_tail;
@@ -54,6 +58,11 @@ typedef struct J9Thread {
 #if !defined(OMR_OS_WINDOWS)
 	uintptr_t key_deletion_attempts;
 #endif /* !OMR_OS_WINDOWS */
+	volatile uintptr_t *rwmutexReaderSlots;
+	struct J9ThreadTaskPoolWorker *taskPoolWorker;
+	uintptr_t lockOrderHeldCount;
+	uintptr_t lockOrderBusy; /* set while the lock-order tracker calls out, so its callbacks are not tracked */
+	struct J9ThreadMonitor *lockOrderHeld[J9THREAD_LOCK_ORDER_MAX_HELD];
 } J9Thread;
 
 /*
@@ -64,6 +73,8 @@ typedef struct J9ThreadMonitor {
 	J9_ABSTRACT_MONITOR_FIELDS
 	J9OSMutex mutex;
 	struct J9Thread *notifyAllWaiting;
+	struct J9ThreadMonitorContention *contention;
+	uintptr_t lockOrderClass; /* lock-order tracker class of the monitor's name, 0 if not yet looked up */
 } J9ThreadMonitor;
 
 
@@ -89,6 +100,11 @@ typedef struct J9ThreadGlobal {
 	uintptr_t data;
 } J9ThreadGlobal;
 
+/* Each thread owns one cache line of read-biased rwmutex reader slots */
+#define J9THREAD_RWMUTEX_READER_LINES 256
+#define J9THREAD_RWMUTEX_READER_LINE_SIZE 64
+#define J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE (J9THREAD_RWMUTEX_READER_LINE_SIZE / sizeof(uintptr_t))
+
 typedef struct J9ThreadLibrary {
 	uintptr_t spinlock;
 	struct J9ThreadMonitorPool *monitor_pool;
@@ -129,6 +145,7 @@ typedef struct J9ThreadLibrary {
 	uintptr_t adaptSpinSlowPercent;
 	uintptr_t adaptSpinSampleStopCount;
 	uintptr_t adaptSpinSampleCountStopRatio;
+	uintptr_t adaptSpinBudget;
 #endif /* OMR_THR_ADAPTIVE_SPIN */
 	OMRMemCategory threadLibraryCategory;
 	OMRMemCategory nativeStackCategory;
@@ -147,6 +164,16 @@ typedef struct J9ThreadLibrary {
 #if defined(OMR_THR_FORK_SUPPORT)
 	struct J9Pool *rwmutexPool;
 #endif /* defined(OMR_THR_FORK_SUPPORT) */
+	omrthread_contention_sampler_t contentionSampler;
+	void *contentionSamplerUserData;
+	uintptr_t contentionSampleInterval;
+	struct J9ThreadLockOrderGraph *lockOrderGraph;
+	omrthread_contention_sampler_t lockOrderSampler;
+	omrthread_lock_order_report_t lockOrderReport;
+	void *lockOrderUserData;
+	void *rwmutexReaderSlotMemory;
+	volatile uintptr_t *rwmutexReaderSlots;
+	uint8_t rwmutexReaderLineInUse[J9THREAD_RWMUTEX_READER_LINES];
 	omrthread_attr_t systemThreadAttr;
 #if defined(OSX)
 	clock_serv_t clockService;
@@ -57,9 +57,34 @@ typedef pthread_key_t TLSKEY;
 typedef pthread_cond_t COND;
 
 #if defined(OMR_THR_FORK_SUPPORT)
+#if defined(OMR_THR_FUTEX)
+#error 'OMR_THR_FUTEX' cannot be combined with 'OMR_THR_FORK_SUPPORT'
+#endif /* defined(OMR_THR_FUTEX) */
 typedef pthread_mutex_t* J9OSMutex;
 typedef pthread_cond_t* J9OSCond;
-#else /* defined(OMR_THR_FORK_SUPPORT) */
+#elif defined(OMR_THR_FUTEX) /* defined(OMR_THR_FORK_SUPPORT) */
+#if !defined(LINUX)
+#error 'OMR_THR_FUTEX' is not supported on this platform
+#endif /* !defined(LINUX) */
+/**
+ * A mutex built directly on a futex word.
+ * state is 0 when free, 1 when held with no waiters and 2 when held with
+ * (possibly) waiters sleeping in the kernel.
+ */
+typedef struct J9OSFutexMutex {
+	volatile uint32_t state;
+} J9OSFutexMutex;
+/**
+ * A condition variable built directly on a futex word.
+ * Every notify advances seq, so a waiter that has released the mutex but
+ * not yet slept in the kernel cannot miss it.
+ */
+typedef struct J9OSFutexCond {
+	volatile uint32_t seq;
+} J9OSFutexCond;
+typedef J9OSFutexCond J9OSCond;
+typedef J9OSFutexMutex J9OSMutex;
+#else /* defined(OMR_THR_FUTEX) */
 typedef COND J9OSCond;
 typedef MUTEX J9OSMutex;
 #endif /* defined(OMR_THR_FORK_SUPPORT) */
@@ -409,7 +434,45 @@ intptr_t j9OSCond_notifyAll(J9OSCond cond);
 #define OMROSCOND_NOTIFY(cond) j9OSCond_notify((cond))
 #define OMROSCOND_NOTIFY_ALL(cond) j9OSCond_notifyAll((cond))
 
-#else /* defined(OMR_THR_FORK_SUPPORT) */
+#elif defined(OMR_THR_FUTEX) /* defined(OMR_THR_FORK_SUPPORT) */
+
+intptr_t j9OSFutexMutex_init(J9OSFutexMutex *mutex);
+intptr_t j9OSFutexMutex_destroy(J9OSFutexMutex *mutex);
+intptr_t j9OSFutexMutex_enter(J9OSFutexMutex *mutex);
+intptr_t j9OSFutexMutex_exit(J9OSFutexMutex *mutex);
+intptr_t j9OSFutexCond_init(J9OSFutexCond *cond);
+intptr_t j9OSFutexCond_destroy(J9OSFutexCond *cond);
+intptr_t j9OSFutexCond_wait(J9OSFutexCond *cond, J9OSFutexMutex *mutex, const struct timespec *abstime);
+intptr_t j9OSFutexCond_notify(J9OSFutexCond *cond);
+intptr_t j9OSFutexCond_notifyAll(J9OSFutexCond *cond);
+intptr_t j9OSFutexCond_notifyRequeue(J9OSFutexCond *cond, J9OSFutexMutex *mutex);
+
+#define OMROSCOND_WAIT_IF_TIMEDOUT(cond, mutex, millis, nanos) 							\
+	do {																				\
+		struct timespec ts_;															\
+		SETUP_TIMEOUT(ts_, millis, nanos);												\
+		while (1) {																		\
+			if (j9OSFutexCond_wait(&(cond), &(mutex), &ts_) == COND_WAIT_RC_TIMEDOUT)
+#define OMROSCOND_WAIT_TIMED_LOOP()		}	} while(0)
+
+#define OMROSCOND_WAIT(cond, mutex) \
+	do {	\
+		j9OSFutexCond_wait(&(cond), &(mutex), NULL)
+#define OMROSCOND_WAIT_LOOP()	} while(1)
+
+#define OMROSMUTEX_INIT(mutex) j9OSFutexMutex_init(&(mutex))
+#define OMROSMUTEX_DESTROY(mutex) j9OSFutexMutex_destroy(&(mutex))
+#define OMROSMUTEX_ENTER(mutex) j9OSFutexMutex_enter(&(mutex))
+#define OMROSMUTEX_EXIT(mutex) j9OSFutexMutex_exit(&(mutex))
+#define OMROSMUTEX_TRY_ENTER(mutex) ((0 == compareAndSwapU32((uint32_t *)&(mutex).state, 0, 1)) ? 0 : EBUSY)
+#define OMROSCOND_INIT(cond) j9OSFutexCond_init(&(cond))
+#define OMROSCOND_DESTROY(cond) j9OSFutexCond_destroy(&(cond))
+#define OMROSCOND_NOTIFY(cond) j9OSFutexCond_notify(&(cond))
+#define OMROSCOND_NOTIFY_ALL(cond) j9OSFutexCond_notifyAll(&(cond))
+/* NOTE: the calling thread must own mutex, and the waiters on cond must be waiting with mutex */
+#define OMROSCOND_NOTIFY_REQUEUE(cond, mutex) j9OSFutexCond_notifyRequeue(&(cond), &(mutex))
+
+#else /* defined(OMR_THR_FUTEX) */
 
 #define OMROSMUTEX_INIT(mutex) MUTEX_INIT((mutex))
 #define OMROSMUTEX_DESTROY(mutex) MUTEX_DESTROY((mutex))
@@ -561,6 +561,89 @@ omrfile_write(struct OMRPortLibrary *portLibrary, intptr_t fd, const void *buf,
 	return rc;
 }
 
+/**
+ * Write the contents of several buffers to a file.
+ *
+ * Writes the buffers in order, as if they had been concatenated into one buffer
+ * and passed to @ref omrfile_write, but without the copy.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] fd File descriptor to write.
+ * @param[in] iov The buffers to be written.
+ * @param[in] iovCount The number of buffers.
+ *
+ * @return Number of bytes written on success, which is less than the total length of
+ * the buffers only if the file could not take more, negative portable error code on failure.
+ */
+intptr_t
+omrfile_writev(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRIOVec *iov, uint32_t iovCount)
+{
+	intptr_t total = 0;
+	uint32_t i = 0;
+
+	for (i = 0; i < iovCount; i++) {
+		intptr_t rc = portLibrary->file_write(portLibrary, fd, iov[i].base, (intptr_t)iov[i].length);
+		if (rc < 0) {
+			return (0 == total) ? rc : total;
+		}
+		total += rc;
+		if ((uintptr_t)rc != iov[i].length) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+/**
+ * Copy a range of one file into another.
+ *
+ * Where the operating system can copy between files without passing the data
+ * through user space (copy_file_range on Linux, which may also share the
+ * blocks on file systems that support reflinks) that is used.
+ *
+ * Neither file position is used or changed.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] inFD File descriptor to copy from.
+ * @param[in] inOffset Offset in inFD of the first byte to copy.
+ * @param[in] outFD File descriptor to copy to.
+ * @param[in] outOffset Offset in outFD at which to store the first byte.
+ * @param[in] length Number of bytes to copy.
+ *
+ * @return Number of bytes copied, which is less than length only if the end of inFD
+ * was reached, negative portable error code on failure.
+ */
+int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t inFD, int64_t inOffset, intptr_t outFD, int64_t outOffset, int64_t length)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Write a range of one file to another file descriptor, which may refer to a socket or pipe.
+ *
+ * Where the operating system can send file data without passing it through user
+ * space (sendfile on Linux) that is used.
+ *
+ * The data is written at the current position of outFD, which is advanced. The
+ * file position of inFD is not used or changed.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] outFD File descriptor to write to.
+ * @param[in] inFD File descriptor to read from.
+ * @param[in] inOffset Offset in inFD of the first byte to send.
+ * @param[in] length Number of bytes to send.
+ *
+ * @return Number of bytes sent, which is less than length only if the end of inFD
+ * was reached, negative portable error code on failure.
+ */
+int64_t
+omrfile_sendfile(struct OMRPortLibrary *portLibrary, intptr_t outFD, intptr_t inFD, int64_t inOffset, int64_t length)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
 static int32_t
 EsTranslateOpenFlags(int32_t flags)
 {
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Asynchronous file I/O
+ */
+
+#include "omrport.h"
+#include "omrportpriv.h"
+
+/**
+ * Create a queue for asynchronous file operations.
+ *
+ * Operations are submitted in batches with @ref omrfile_async_submit and their
+ * outcomes collected with @ref omrfile_async_complete. Where the platform
+ * provides a kernel submission interface (io_uring on Linux) it is used, otherwise
+ * the operations are performed by a small pool of threads owned by the queue.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] depth The maximum number of operations submitted but not yet completed
+ * @param[in] flags 0, or OMRPORT_FILE_ASYNC_USE_THREADS to use the thread pool even if a kernel interface is available
+ * @param[out] queue The new queue
+ *
+ * @return 0 on success, a negative portable error code on failure.
+ */
+int32_t
+omrfile_async_create(struct OMRPortLibrary *portLibrary, uint32_t depth, uint32_t flags, struct OMRFileAsyncQueue **queue)
+{
+	*queue = NULL;
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Destroy a queue created by @ref omrfile_async_create.
+ *
+ * Waits for all outstanding operations to finish; their completions are discarded.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue, may be NULL
+ */
+void
+omrfile_async_destroy(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue)
+{
+}
+
+/**
+ * Submit a batch of asynchronous file operations.
+ *
+ * Requests are started in order. A request flagged OMRPORT_FILE_ASYNC_LINK is
+ * followed by the next request of the batch only once it has transferred all of
+ * its bytes; if it does not, the remaining requests of its chain complete with
+ * OMRPORT_ERROR_FILE_ASYNC_CANCELED. The flag is ignored on the last request
+ * of a batch.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue
+ * @param[in] requests The requests, which are copied
+ * @param[in] count The number of requests
+ *
+ * @return the number of leading requests accepted, which may be fewer than count
+ * (a chain is never split) if the queue is full, or a negative portable error code.
+ */
+intptr_t
+omrfile_async_submit(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Collect the outcomes of finished asynchronous file operations.
+ *
+ * Operations may finish in any order, except that the members of a chain finish in order.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue
+ * @param[out] completions Filled in with the outcomes
+ * @param[in] maxCompletions The number of entries in completions
+ * @param[in] minCompletions The number of completions to wait for; 0 only collects what has already finished.
+ * This is reduced to the number of outstanding operations.
+ *
+ * @return the number of completions filled in, or a negative portable error code.
+ */
+intptr_t
+omrfile_async_complete(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Report how a queue performs its operations.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue
+ *
+ * @return OMRPORT_FILE_ASYNC_BACKEND_IO_URING or OMRPORT_FILE_ASYNC_BACKEND_THREADS
+ */
+uint32_t
+omrfile_async_backend(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue)
+{
+	return OMRPORT_FILE_ASYNC_BACKEND_THREADS;
+}
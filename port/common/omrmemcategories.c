@@ -59,6 +59,89 @@ OMRMEM_CATEGORY_1_CHILD("Port Library", OMRMEM_CATEGORY_PORT_LIBRARY, OMRMEM_CAT
 OMRMEM_CATEGORY_NO_CHILDREN("Port Library", OMRMEM_CATEGORY_PORT_LIBRARY);
 #endif /* OMR_ENV_DATA64 */
 
+#if defined(OMRPORT_NATIVE_TLS)
+/* Stripe index + 1 for the current thread, or 0 if not yet assigned */
+static OMRPORT_NATIVE_TLS uintptr_t currentThreadStripe;
+/* Source of round-robin stripe assignments */
+static uintptr_t nextStripe;
+#endif /* defined(OMRPORT_NATIVE_TLS) */
+
+/**
+ * Select the counter stripe for the calling thread.
+ *
+ * Where native thread locals are available each thread is assigned a stripe
+ * round-robin on its first counter update, so up to OMRMEM_CATEGORY_STRIPE_COUNT
+ * threads update disjoint cache lines. Otherwise the stripe is derived from the
+ * address of the caller's stack, which is distinct for each thread.
+ */
+static OMRMemCategoryStripe *
+getStripe(OMRMemCategory *category)
+{
+	uintptr_t index = 0;
+#if defined(OMRPORT_NATIVE_TLS)
+	index = currentThreadStripe;
+	if (0 == index) {
+		uintptr_t oldValue = 0;
+		do {
+			oldValue = nextStripe;
+		} while (compareAndSwapUDATA(&nextStripe, oldValue, oldValue + 1) != oldValue);
+		index = (oldValue & (OMRMEM_CATEGORY_STRIPE_COUNT - 1)) + 1;
+		currentThreadStripe = index;
+	}
+	index -= 1;
+#else /* defined(OMRPORT_NATIVE_TLS) */
+	/* Thread stacks are at least a page apart; fold the bits above the page offset */
+	uintptr_t stackAddress = ((uintptr_t)&index) >> 12;
+	index = (stackAddress ^ (stackAddress >> 3) ^ (stackAddress >> 7)) & (OMRMEM_CATEGORY_STRIPE_COUNT - 1);
+#endif /* defined(OMRPORT_NATIVE_TLS) */
+	return &category->stripes[index];
+}
+
+/**
+ * Atomically adds delta to a stripe counter. Stripes are rarely shared,
+ * so the compare and swap is almost always uncontended.
+ */
+static void
+addToCounter(uintptr_t *location, uintptr_t delta)
+{
+	uintptr_t oldValue;
+
+	do {
+		oldValue = *location;
+	} while (compareAndSwapUDATA(location, oldValue, oldValue + delta) != oldValue);
+}
+
+/**
+ * Returns the live byte count for a category: the shared counter (still
+ * updated directly by the thread library) plus every stripe.
+ */
+static uintptr_t
+sumLiveBytes(OMRMemCategory *category)
+{
+	uintptr_t total = category->liveBytes;
+	uintptr_t i = 0;
+
+	for (i = 0; i < OMRMEM_CATEGORY_STRIPE_COUNT; i++) {
+		total += category->stripes[i].liveBytes;
+	}
+	return total;
+}
+
+/**
+ * Returns the live allocation count for a category. See sumLiveBytes().
+ */
+static uintptr_t
+sumLiveAllocations(OMRMemCategory *category)
+{
+	uintptr_t total = category->liveAllocations;
+	uintptr_t i = 0;
+
+	for (i = 0; i < OMRMEM_CATEGORY_STRIPE_COUNT; i++) {
+		total += category->stripes[i].liveAllocations;
+	}
+	return total;
+}
+
 /**
  * Increments the counters for a memory category.
  *
@@ -67,16 +150,13 @@ OMRMEM_CATEGORY_NO_CHILDREN("Port Library", OMRMEM_CATEGORY_PORT_LIBRARY);
 void
 omrmem_categories_increment_counters(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
+	OMRMemCategoryStripe *stripe = NULL;
 
 	Trc_Assert_PTR_mem_categories_increment_counters_NULL_category(NULL != category);
 
-	/* Increment block count */
-	do {
-		oldValue = category->liveAllocations;
-	} while (compareAndSwapUDATA(&category->liveAllocations, oldValue, oldValue + 1) != oldValue);
-
-	omrmem_categories_increment_bytes(category, size);
+	stripe = getStripe(category);
+	addToCounter(&stripe->liveAllocations, 1);
+	addToCounter(&stripe->liveBytes, size);
 }
 
 /**
@@ -87,14 +167,9 @@ omrmem_categories_increment_counters(OMRMemCategory *category, uintptr_t size)
 void
 omrmem_categories_increment_bytes(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
-
 	Trc_Assert_PTR_mem_categories_increment_bytes_NULL_category(NULL != category);
 
-	/* Increment bytes */
-	do {
-		oldValue = category->liveBytes;
-	} while (compareAndSwapUDATA(&category->liveBytes, oldValue, oldValue + size) != oldValue);
+	addToCounter(&getStripe(category)->liveBytes, size);
 }
 
 /**
@@ -105,16 +180,13 @@ omrmem_categories_increment_bytes(OMRMemCategory *category, uintptr_t size)
 void
 omrmem_categories_decrement_counters(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
+	OMRMemCategoryStripe *stripe = NULL;
 
 	Trc_Assert_PTR_mem_categories_decrement_counters_NULL_category(NULL != category);
 
-	/* Decrement block count */
-	do {
-		oldValue = category->liveAllocations;
-	} while (compareAndSwapUDATA(&category->liveAllocations, oldValue, oldValue - 1) != oldValue);
-
-	omrmem_categories_decrement_bytes(category, size);
+	stripe = getStripe(category);
+	addToCounter(&stripe->liveAllocations, (uintptr_t)-1);
+	addToCounter(&stripe->liveBytes, (uintptr_t)0 - size);
 }
 
 /**
@@ -125,14 +197,9 @@ omrmem_categories_decrement_counters(OMRMemCategory *category, uintptr_t size)
 void
 omrmem_categories_decrement_bytes(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
-
 	Trc_Assert_PTR_mem_categories_decrement_bytes_NULL_category(NULL != category);
 
-	/* Decrement size */
-	do {
-		oldValue = category->liveBytes;
-	} while (compareAndSwapUDATA(&category->liveBytes, oldValue, oldValue - size) != oldValue);
+	addToCounter(&getStripe(category)->liveBytes, (uintptr_t)0 - size);
 }
 
 /**
@@ -190,7 +257,7 @@ _recursive_category_walk_children(struct OMRPortLibrary *portLibrary, OMRMemCate
 	for (i = 0; i < parent->numberOfChildren; i++) {
 		uint32_t childCode = parent->children[i];
 		OMRMemCategory *child = omrmem_get_category(portLibrary, childCode);
-		result = state->walkFunction(child->categoryCode, child->name, child->liveBytes, child->liveAllocations, FALSE, parent->categoryCode, state);
+		result = state->walkFunction(child->categoryCode, child->name, sumLiveBytes(child), sumLiveAllocations(child), FALSE, parent->categoryCode, state);
 
 		if (result == J9MEM_CATEGORIES_KEEP_ITERATING) {
 			result = _recursive_category_walk_children(portLibrary, state, child);
@@ -211,7 +278,7 @@ _recursive_category_walk_root(struct OMRPortLibrary *portLibrary, OMRMemCategory
 {
 	uintptr_t result;
 
-	result = state->walkFunction(walkPoint->categoryCode, walkPoint->name, walkPoint->liveBytes, walkPoint->liveAllocations, TRUE, 0, state);
+	result = state->walkFunction(walkPoint->categoryCode, walkPoint->name, sumLiveBytes(walkPoint), sumLiveAllocations(walkPoint), TRUE, 0, state);
 
 	if (result == J9MEM_CATEGORIES_KEEP_ITERATING) {
 		return _recursive_category_walk_children(portLibrary, state, walkPoint);
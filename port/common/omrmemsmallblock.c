@@ -0,0 +1,547 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Thread-caching small block allocator
+ */
+
+/*
+ * This file contains an optional allocator tier used by omrmem_allocate_memory
+ * for small blocks. It sits below the tagging in omrmemtag.c, so callsites,
+ * categories and corruption checks are unchanged; only the source of the raw
+ * memory differs.
+ *
+ * A single region of address space is reserved with omrvmem when the allocator
+ * is enabled and committed one slab at a time. Every slab holds blocks of one
+ * size class and is owned by one thread cache. A thread allocates from its own
+ * cache without synchronization and frees blocks of its own slabs the same way.
+ * A block freed by any other thread is pushed onto the owning cache's remote
+ * free stack, which the owner drains when a size class runs dry. When a thread
+ * exits its cache is parked, slabs and all, and adopted by the next new thread.
+ *
+ * Requests larger than the largest size class, requests made while the region
+ * is exhausted and all requests on platforms without native thread locals
+ * fall through to omrmem_allocate_memory_basic.
+ */
+#include <string.h>
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "omrutilbase.h"
+#include "ut_omrport.h"
+
+#if (defined(LINUX) || defined(OSX)) && defined(OMRPORT_NATIVE_TLS)
+#define OMRMEM_SMALL_BLOCK_SUPPORTED
+#include <pthread.h>
+#endif /* (defined(LINUX) || defined(OSX)) && defined(OMRPORT_NATIVE_TLS) */
+
+#define SMALL_BLOCK_SLAB_SIZE ((uintptr_t)64 * 1024)
+#define SMALL_BLOCK_CLASS_COUNT 20
+#define SMALL_BLOCK_MAX_SIZE 1024
+#define SMALL_BLOCK_CACHE_LINE_SIZE 64
+
+#if defined(OMR_ENV_DATA64)
+#define SMALL_BLOCK_DEFAULT_REGION_SIZE ((uintptr_t)1024 * 1024 * 1024)
+#else /* defined(OMR_ENV_DATA64) */
+#define SMALL_BLOCK_DEFAULT_REGION_SIZE ((uintptr_t)64 * 1024 * 1024)
+#endif /* defined(OMR_ENV_DATA64) */
+
+#if defined(OMRMEM_SMALL_BLOCK_SUPPORTED)
+
+static const uintptr_t classSizes[SMALL_BLOCK_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+/* One entry per slab of the region, describing how the slab is carved */
+typedef struct J9SmallBlockSlab {
+	struct J9SmallBlockCache *owner;
+	uintptr_t sizeClass;
+} J9SmallBlockSlab;
+
+typedef struct J9SmallBlockClassCache {
+	void *freeList;
+	uint8_t *bumpCursor;
+	uint8_t *bumpEnd;
+} J9SmallBlockClassCache;
+
+typedef struct J9SmallBlockCache {
+	/* Written by other threads; kept off the cache line of the owner's free lists */
+	volatile uintptr_t remoteFrees;
+	uint8_t padding[SMALL_BLOCK_CACHE_LINE_SIZE - sizeof(uintptr_t)];
+	J9SmallBlockClassCache classes[SMALL_BLOCK_CLASS_COUNT];
+	struct J9SmallBlockAllocator *allocator;
+	struct J9SmallBlockCache *next;
+	struct J9SmallBlockCache *nextAbandoned;
+} J9SmallBlockCache;
+
+typedef struct J9SmallBlockAllocator {
+	J9PortVmemIdentifier vmemID;
+	uint8_t *regionBase;
+	uint8_t *regionTop;
+	uintptr_t slabCount;
+	uintptr_t nextSlab;
+	J9SmallBlockSlab *slabs;
+	J9SmallBlockCache *caches;
+	J9SmallBlockCache *abandonedCaches;
+	volatile uintptr_t lock;
+	volatile uintptr_t enabled;
+	uintptr_t epoch;
+	pthread_key_t cacheKey;
+} J9SmallBlockAllocator;
+
+/* The cache of the current thread, valid only while currentCacheEpoch matches the allocator */
+static OMRPORT_NATIVE_TLS J9SmallBlockCache *currentCache;
+static OMRPORT_NATIVE_TLS uintptr_t currentCacheEpoch;
+/* Set while the current thread allocates its cache, and once it has abandoned it at exit,
+ * so that allocation falls through to malloc
+ */
+static OMRPORT_NATIVE_TLS uintptr_t creatingCache;
+
+/* Only one port library at a time may run the allocator, as the thread locals above are process wide */
+static J9SmallBlockAllocator *activeAllocator;
+static uintptr_t lastEpoch;
+
+static void
+lockAllocator(J9SmallBlockAllocator *allocator)
+{
+	while (0 != compareAndSwapUDATA((uintptr_t *)&allocator->lock, 0, 1)) {
+		omrthread_yield();
+	}
+}
+
+static void
+unlockAllocator(J9SmallBlockAllocator *allocator)
+{
+	issueWriteBarrier();
+	allocator->lock = 0;
+}
+
+/**
+ * Map a rounded request size to its size class. Classes are 16 bytes apart up
+ * to 128 bytes and then four to each power of two.
+ */
+static uintptr_t
+sizeClassIndex(uintptr_t byteAmount)
+{
+	uintptr_t granules = (byteAmount + 15) >> 4;
+
+	if (granules <= 8) {
+		return (0 == granules) ? 0 : (granules - 1);
+	} else if (granules <= 16) {
+		return 8 + ((granules - 9) >> 1);
+	} else if (granules <= 32) {
+		return 12 + ((granules - 17) >> 2);
+	}
+	return 16 + ((granules - 33) >> 3);
+}
+
+/**
+ * Called by pthreads when a thread with a cache exits. The cache keeps its
+ * slabs and its remote free stack, and is handed to the next thread which
+ * needs a cache.
+ */
+static void
+abandonCache(void *value)
+{
+	J9SmallBlockCache *cache = (J9SmallBlockCache *)value;
+	J9SmallBlockAllocator *allocator = cache->allocator;
+
+	/* Destructors which run after this one may still allocate and free on this
+	 * thread; once the cache is published they must use the shared paths.
+	 * Epochs start at 1, so a zero epoch never matches an allocator.
+	 */
+	currentCache = NULL;
+	currentCacheEpoch = 0;
+	creatingCache = 1;
+
+	lockAllocator(allocator);
+	cache->nextAbandoned = allocator->abandonedCaches;
+	allocator->abandonedCaches = cache;
+	unlockAllocator(allocator);
+}
+
+static J9SmallBlockCache *
+getCache(struct OMRPortLibrary *portLibrary, J9SmallBlockAllocator *allocator)
+{
+	J9SmallBlockCache *cache = NULL;
+
+	if (currentCacheEpoch == allocator->epoch) {
+		return currentCache;
+	}
+	if (0 != creatingCache) {
+		return NULL;
+	}
+
+	lockAllocator(allocator);
+	cache = allocator->abandonedCaches;
+	if (NULL != cache) {
+		allocator->abandonedCaches = cache->nextAbandoned;
+		cache->nextAbandoned = NULL;
+	}
+	unlockAllocator(allocator);
+
+	if (NULL == cache) {
+		creatingCache = 1;
+		cache = portLibrary->mem_allocate_memory(portLibrary, sizeof(J9SmallBlockCache), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		creatingCache = 0;
+		if (NULL == cache) {
+			return NULL;
+		}
+		memset(cache, 0, sizeof(J9SmallBlockCache));
+		cache->allocator = allocator;
+
+		lockAllocator(allocator);
+		cache->next = allocator->caches;
+		allocator->caches = cache;
+		unlockAllocator(allocator);
+	}
+
+	pthread_setspecific(allocator->cacheKey, cache);
+	currentCache = cache;
+	currentCacheEpoch = allocator->epoch;
+	return cache;
+}
+
+/**
+ * Push the blocks other threads have freed back onto this cache's free lists.
+ * Only the owning thread takes the stack, and it takes it whole, so the
+ * exchange cannot suffer from ABA.
+ */
+static void
+drainRemoteFrees(J9SmallBlockAllocator *allocator, J9SmallBlockCache *cache)
+{
+	uintptr_t head = 0;
+
+	do {
+		head = cache->remoteFrees;
+	} while (compareAndSwapUDATA((uintptr_t *)&cache->remoteFrees, head, 0) != head);
+
+	while (0 != head) {
+		void *block = (void *)head;
+		J9SmallBlockSlab *slab = &allocator->slabs[((uint8_t *)block - allocator->regionBase) / SMALL_BLOCK_SLAB_SIZE];
+		J9SmallBlockClassCache *classCache = &cache->classes[slab->sizeClass];
+
+		head = *(uintptr_t *)block;
+		*(void **)block = classCache->freeList;
+		classCache->freeList = block;
+	}
+}
+
+/**
+ * Commit the next unused slab of the region and give it to cache for sizeClass.
+ *
+ * @return TRUE if a slab was committed, FALSE if the region is exhausted
+ */
+static BOOLEAN
+takeSlab(struct OMRPortLibrary *portLibrary, J9SmallBlockAllocator *allocator, J9SmallBlockCache *cache, uintptr_t sizeClass)
+{
+	uintptr_t slabIndex = 0;
+	uint8_t *slabBase = NULL;
+	J9SmallBlockClassCache *classCache = &cache->classes[sizeClass];
+
+	lockAllocator(allocator);
+	slabIndex = allocator->nextSlab;
+	if (slabIndex >= allocator->slabCount) {
+		unlockAllocator(allocator);
+		return FALSE;
+	}
+	slabBase = allocator->regionBase + (slabIndex * SMALL_BLOCK_SLAB_SIZE);
+	if (NULL == portLibrary->vmem_commit_memory(portLibrary, slabBase, SMALL_BLOCK_SLAB_SIZE, &allocator->vmemID)) {
+		unlockAllocator(allocator);
+		return FALSE;
+	}
+	allocator->slabs[slabIndex].owner = cache;
+	allocator->slabs[slabIndex].sizeClass = sizeClass;
+	allocator->nextSlab = slabIndex + 1;
+	unlockAllocator(allocator);
+
+	classCache->bumpCursor = slabBase;
+	classCache->bumpEnd = slabBase + (SMALL_BLOCK_SLAB_SIZE - (SMALL_BLOCK_SLAB_SIZE % classSizes[sizeClass]));
+	return TRUE;
+}
+
+#endif /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+
+/**
+ * Allocate a raw block from the small block allocator.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] byteAmount Number of bytes, including the memory tags
+ *
+ * @return a block of at least byteAmount bytes, or NULL if the allocator is not
+ * enabled, byteAmount is too large for it or it has run out of slabs. The caller
+ * falls back to omrmem_allocate_memory_basic when NULL is returned.
+ */
+void *
+omrmem_small_block_allocate(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount)
+{
+#if defined(OMRMEM_SMALL_BLOCK_SUPPORTED)
+	J9SmallBlockAllocator *allocator = NULL;
+	J9SmallBlockCache *cache = NULL;
+	J9SmallBlockClassCache *classCache = NULL;
+	uintptr_t sizeClass = 0;
+	void *block = NULL;
+
+	if ((NULL == portLibrary->portGlobals) || (byteAmount > SMALL_BLOCK_MAX_SIZE)) {
+		return NULL;
+	}
+	allocator = portLibrary->portGlobals->smallBlockAllocator;
+	if ((NULL == allocator) || (0 == allocator->enabled)) {
+		return NULL;
+	}
+	cache = getCache(portLibrary, allocator);
+	if (NULL == cache) {
+		return NULL;
+	}
+
+	sizeClass = sizeClassIndex(byteAmount);
+	classCache = &cache->classes[sizeClass];
+	block = classCache->freeList;
+	if (NULL == block) {
+		if (0 != cache->remoteFrees) {
+			drainRemoteFrees(allocator, cache);
+			block = classCache->freeList;
+		}
+		if ((NULL == block) && (classCache->bumpCursor == classCache->bumpEnd)) {
+			if (!takeSlab(portLibrary, allocator, cache, sizeClass)) {
+				return NULL;
+			}
+		}
+		if (NULL == block) {
+			block = classCache->bumpCursor;
+			classCache->bumpCursor += classSizes[sizeClass];
+			return block;
+		}
+	}
+	classCache->freeList = *(void **)block;
+	return block;
+#else /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+	return NULL;
+#endif /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+}
+
+/**
+ * Return a raw block to the small block allocator if it came from there.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] memoryPointer The raw block, i.e. the address of its header tag
+ *
+ * @return TRUE if the block belonged to the small block allocator and has been
+ * freed, FALSE if it must be released with omrmem_free_memory_basic
+ */
+BOOLEAN
+omrmem_small_block_free(struct OMRPortLibrary *portLibrary, void *memoryPointer)
+{
+#if defined(OMRMEM_SMALL_BLOCK_SUPPORTED)
+	J9SmallBlockAllocator *allocator = NULL;
+	J9SmallBlockSlab *slab = NULL;
+	J9SmallBlockCache *owner = NULL;
+
+	if (NULL == portLibrary->portGlobals) {
+		return FALSE;
+	}
+	allocator = portLibrary->portGlobals->smallBlockAllocator;
+	if ((NULL == allocator)
+		|| ((uint8_t *)memoryPointer < allocator->regionBase)
+		|| ((uint8_t *)memoryPointer >= allocator->regionTop)
+	) {
+		return FALSE;
+	}
+
+	slab = &allocator->slabs[((uint8_t *)memoryPointer - allocator->regionBase) / SMALL_BLOCK_SLAB_SIZE];
+	owner = slab->owner;
+	if ((currentCacheEpoch == allocator->epoch) && (owner == currentCache)) {
+		J9SmallBlockClassCache *classCache = &owner->classes[slab->sizeClass];
+		*(void **)memoryPointer = classCache->freeList;
+		classCache->freeList = memoryPointer;
+	} else {
+		uintptr_t oldHead = 0;
+		do {
+			oldHead = owner->remoteFrees;
+			*(uintptr_t *)memoryPointer = oldHead;
+		} while (compareAndSwapUDATA((uintptr_t *)&owner->remoteFrees, oldHead, (uintptr_t)memoryPointer) != oldHead);
+	}
+	return TRUE;
+#else /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+	return FALSE;
+#endif /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+}
+
+/**
+ * Query the usable size of a raw block.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] memoryPointer The raw block, i.e. the address of its header tag
+ *
+ * @return the size class of the block if it belongs to the small block
+ * allocator, or 0 if it was allocated with omrmem_allocate_memory_basic
+ */
+uintptr_t
+omrmem_small_block_size(struct OMRPortLibrary *portLibrary, void *memoryPointer)
+{
+#if defined(OMRMEM_SMALL_BLOCK_SUPPORTED)
+	J9SmallBlockAllocator *allocator = NULL;
+
+	if (NULL == portLibrary->portGlobals) {
+		return 0;
+	}
+	allocator = portLibrary->portGlobals->smallBlockAllocator;
+	if ((NULL == allocator)
+		|| ((uint8_t *)memoryPointer < allocator->regionBase)
+		|| ((uint8_t *)memoryPointer >= allocator->regionTop)
+	) {
+		return 0;
+	}
+	return classSizes[allocator->slabs[((uint8_t *)memoryPointer - allocator->regionBase) / SMALL_BLOCK_SLAB_SIZE].sizeClass];
+#else /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+	return 0;
+#endif /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+}
+
+/**
+ * Enable or disable the small block allocator. Handles OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR.
+ *
+ * The first time it is enabled the allocator reserves its region, which is
+ * value bytes, or a platform default if value is 1. Disabling the allocator
+ * only stops new allocations from using it; blocks it has already handed out
+ * remain valid and may be freed or reallocated as usual, and enabling it again
+ * resumes with the same region.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] value 0 to disable, 1 to enable with the default region size, or the region size in bytes
+ *
+ * @return 0 on success, 1 if the allocator is not supported on this platform,
+ * is already running for another port library or the region cannot be reserved
+ */
+int32_t
+omrmem_small_block_control(struct OMRPortLibrary *portLibrary, uintptr_t value)
+{
+#if defined(OMRMEM_SMALL_BLOCK_SUPPORTED)
+	J9SmallBlockAllocator *allocator = portLibrary->portGlobals->smallBlockAllocator;
+	J9PortVmemParams params;
+	uintptr_t regionSize = (1 == value) ? SMALL_BLOCK_DEFAULT_REGION_SIZE : value;
+	uint8_t *region = NULL;
+
+	if (0 == value) {
+		if (NULL != allocator) {
+			allocator->enabled = 0;
+		}
+		return 0;
+	}
+	if (NULL != allocator) {
+		allocator->enabled = 1;
+		return 0;
+	}
+	if ((NULL != activeAllocator) || (regionSize < (2 * SMALL_BLOCK_SLAB_SIZE))) {
+		return 1;
+	}
+
+	allocator = portLibrary->mem_allocate_memory(portLibrary, sizeof(J9SmallBlockAllocator), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == allocator) {
+		return 1;
+	}
+	memset(allocator, 0, sizeof(J9SmallBlockAllocator));
+
+	portLibrary->vmem_vmem_params_init(portLibrary, &params);
+	params.byteAmount = regionSize;
+	params.mode = OMRPORT_VMEM_MEMORY_MODE_READ | OMRPORT_VMEM_MEMORY_MODE_WRITE;
+	params.category = OMRMEM_CATEGORY_PORT_LIBRARY;
+	region = portLibrary->vmem_reserve_memory_ex(portLibrary, &allocator->vmemID, &params);
+	if (NULL == region) {
+		Trc_PRT_mem_small_block_reserve_failed(regionSize);
+		goto free_allocator;
+	}
+	/* omrmem_category double-accounting prevention: the blocks are counted as they are handed out */
+	omrmem_categories_decrement_counters(allocator->vmemID.category, allocator->vmemID.size);
+
+	allocator->regionBase = (uint8_t *)(((uintptr_t)region + SMALL_BLOCK_SLAB_SIZE - 1) & ~(SMALL_BLOCK_SLAB_SIZE - 1));
+	allocator->slabCount = (uintptr_t)(region + allocator->vmemID.size - allocator->regionBase) / SMALL_BLOCK_SLAB_SIZE;
+	allocator->regionTop = allocator->regionBase + (allocator->slabCount * SMALL_BLOCK_SLAB_SIZE);
+	allocator->slabs = portLibrary->mem_allocate_memory(portLibrary, allocator->slabCount * sizeof(J9SmallBlockSlab), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == allocator->slabs) {
+		goto free_region;
+	}
+	if (0 != pthread_key_create(&allocator->cacheKey, abandonCache)) {
+		goto free_slabs;
+	}
+
+	lastEpoch += 1;
+	allocator->epoch = lastEpoch;
+	allocator->enabled = 1;
+	activeAllocator = allocator;
+	issueWriteBarrier();
+	portLibrary->portGlobals->smallBlockAllocator = allocator;
+	Trc_PRT_mem_small_block_enabled(allocator->regionBase, allocator->slabCount, SMALL_BLOCK_SLAB_SIZE);
+	return 0;
+
+free_slabs:
+	portLibrary->mem_free_memory(portLibrary, allocator->slabs);
+free_region:
+	omrmem_categories_increment_counters(allocator->vmemID.category, allocator->vmemID.size);
+	portLibrary->vmem_free_memory(portLibrary, allocator->vmemID.address, allocator->vmemID.size, &allocator->vmemID);
+free_allocator:
+	portLibrary->mem_free_memory(portLibrary, allocator);
+	return 1;
+#else /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+	return (0 == value) ? 0 : 1;
+#endif /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+}
+
+/**
+ * Release the small block allocator, if it was ever enabled. Any blocks still
+ * allocated from it become invalid.
+ *
+ * @param[in] portLibrary The port library
+ */
+void
+omrmem_small_block_shutdown(struct OMRPortLibrary *portLibrary)
+{
+#if defined(OMRMEM_SMALL_BLOCK_SUPPORTED)
+	J9SmallBlockAllocator *allocator = portLibrary->portGlobals->smallBlockAllocator;
+	J9SmallBlockCache *cache = NULL;
+
+	if (NULL == allocator) {
+		return;
+	}
+	/* Everything freed from here on goes straight to omrmem_free_memory_basic */
+	portLibrary->portGlobals->smallBlockAllocator = NULL;
+	pthread_key_delete(allocator->cacheKey);
+	activeAllocator = NULL;
+
+	cache = allocator->caches;
+	while (NULL != cache) {
+		J9SmallBlockCache *next = cache->next;
+		portLibrary->mem_free_memory(portLibrary, cache);
+		cache = next;
+	}
+	portLibrary->mem_free_memory(portLibrary, allocator->slabs);
+	/* omrmem_category double-accounting prevention: increment the counters so vmem_free_memory can decrement them */
+	omrmem_categories_increment_counters(allocator->vmemID.category, allocator->vmemID.size);
+	portLibrary->vmem_free_memory(portLibrary, allocator->vmemID.address, allocator->vmemID.size, &allocator->vmemID);
+	portLibrary->mem_free_memory(portLibrary, allocator);
+#endif /* defined(OMRMEM_SMALL_BLOCK_SUPPORTED) */
+}
@@ -57,6 +57,8 @@
 
 static void setTagSumCheck(J9MemTag *tag, uint32_t eyeCatcher);
 static void *wrapBlockAndSetTags(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount, const char *callSite, const uint32_t category);
+static void *wrapBlockWithLightTag(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount, const uint32_t categoryCode);
+static BOOLEAN sampleNextAllocation(struct OMRPortLibrary *portLibrary);
 static void *unwrapBlockAndCheckTags(struct OMRPortLibrary *portLibrary, void *memoryPointer);
 
 /* Typedefs for basic allocators */
@@ -65,6 +67,17 @@ typedef void (*free_memory_func_t)(struct OMRPortLibrary *portLibrary, void *mem
 typedef void (*advise_and_free_memory_func_t)(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t memorySize);
 typedef void *(*reallocate_memory_func_t)(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount);
 
+#if defined(OMRPORT_NATIVE_TLS)
+#define SAMPLE_STATE_TLS OMRPORT_NATIVE_TLS
+#else /* defined(OMRPORT_NATIVE_TLS) */
+/* Without native TLS the sampling state is shared; races only perturb the sampling rate */
+#define SAMPLE_STATE_TLS
+#endif /* defined(OMRPORT_NATIVE_TLS) */
+
+/* Allocations left before the next fully tagged block, see sampleNextAllocation */
+static SAMPLE_STATE_TLS uintptr_t allocationsUntilSample;
+static SAMPLE_STATE_TLS uint32_t sampleSeed;
+
 static void
 setTagSumCheck(J9MemTag *tag, uint32_t eyeCatcher)
 {
@@ -117,6 +130,56 @@ wrapBlockAndSetTags(struct OMRPortLibrary *portLibrary, void *memoryPointer, uin
 	return memoryPointer;
 }
 
+/*
+ * A light header only records what freeing the block needs: its size and category.
+ * It has no sumcheck, no footer and no padding.
+ */
+static void *
+wrapBlockWithLightTag(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount, const uint32_t categoryCode)
+{
+	J9MemTag *headerTag = (J9MemTag *) memoryPointer;
+	OMRMemCategory *category = omrmem_get_category(portLibrary, categoryCode);
+
+	omrmem_categories_increment_counters(category, ROUNDED_LIGHT_BYTE_AMOUNT(byteAmount));
+
+	headerTag->eyeCatcher = J9MEMTAG_EYECATCHER_LIGHT_HEADER;
+	headerTag->sumCheck = 0;
+	headerTag->allocSize = byteAmount;
+	headerTag->callSite = NULL;
+	headerTag->category = category;
+
+	return (void *)((uint8_t *) memoryPointer + sizeof(J9MemTag));
+}
+
+/*
+ * Decide whether the next omrmem_allocate_memory block gets full tags. Unless
+ * OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL is set every block does. Otherwise
+ * the gaps between sampled blocks are drawn uniformly from [1, 2 * interval - 1]
+ * so that regular allocation patterns cannot hide from the sampling.
+ */
+static BOOLEAN
+sampleNextAllocation(struct OMRPortLibrary *portLibrary)
+{
+	uintptr_t interval = 0;
+
+	if (NULL != portLibrary->portGlobals) {
+		interval = portLibrary->portGlobals->memTagSampleInterval;
+	}
+	if (interval <= 1) {
+		return TRUE;
+	}
+	if (0 != allocationsUntilSample) {
+		allocationsUntilSample -= 1;
+		return FALSE;
+	}
+	if (0 == sampleSeed) {
+		sampleSeed = (uint32_t)(uintptr_t)&allocationsUntilSample | 1;
+	}
+	sampleSeed = (sampleSeed * 1103515245) + 12345;
+	allocationsUntilSample = (uintptr_t)(sampleSeed >> 8) % ((2 * interval) - 1);
+	return TRUE;
+}
+
 static void *
 unwrapBlockAndCheckTags(struct OMRPortLibrary *portLibrary, void *memoryPointer)
 {
@@ -124,6 +187,17 @@ unwrapBlockAndCheckTags(struct OMRPortLibrary *portLibrary, void *memoryPointer)
 
 	/* get the tags */
 	headerTag = omrmem_get_header_tag(memoryPointer);
+
+	if (J9MEMTAG_EYECATCHER_LIGHT_HEADER == headerTag->eyeCatcher) {
+		omrmem_categories_decrement_counters(headerTag->category, ROUNDED_LIGHT_BYTE_AMOUNT(headerTag->allocSize));
+		/* A second free of this block now fails the full tag checks below */
+		headerTag->eyeCatcher = J9MEMTAG_EYECATCHER_FREED_HEADER;
+		return headerTag;
+	}
+
+	if (NULL != portLibrary->portGlobals->memTagSamples) {
+		omrmem_tag_sample_remove(portLibrary, headerTag);
+	}
 	footerTag = omrmem_get_footer_tag(headerTag);
 
 	/* Check the tags and update only if not corrupted*/
@@ -172,16 +246,26 @@ omrmem_allocate_memory(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount,
 	void *pointer = NULL;
 	uintptr_t allocationByteAmount;
 	allocate_memory_func_t allocateFunction = omrmem_allocate_memory_basic;
+	BOOLEAN fullTags = TRUE;
 
 	/* note that this monitor is protecting a larger area than strictly required but this will make the trace points sane */
 	Trc_PRT_mem_omrmem_allocate_memory_Entry(byteAmount, callSite);
-	allocationByteAmount = ROUNDED_BYTE_AMOUNT(byteAmount);
+	fullTags = sampleNextAllocation(portLibrary);
+	allocationByteAmount = fullTags ? ROUNDED_BYTE_AMOUNT(byteAmount) : ROUNDED_LIGHT_BYTE_AMOUNT(byteAmount);
 
-	pointer = allocateFunction(portLibrary, allocationByteAmount);
+	pointer = omrmem_small_block_allocate(portLibrary, allocationByteAmount);
+	if (NULL == pointer) {
+		pointer = allocateFunction(portLibrary, allocationByteAmount);
+	}
 	if (NULL == pointer) {
 		Trc_PRT_memory_alloc_returned_null_2(callSite, allocationByteAmount);
-	} else {
+	} else if (fullTags) {
 		pointer = wrapBlockAndSetTags(portLibrary, pointer, byteAmount, callSite, category);
+		if (0 != portLibrary->portGlobals->memTagSampleInterval) {
+			omrmem_tag_sample_add(portLibrary, omrmem_get_header_tag(pointer));
+		}
+	} else {
+		pointer = wrapBlockWithLightTag(portLibrary, pointer, byteAmount, category);
 	}
 	Trc_PRT_mem_omrmem_allocate_memory_Exit(pointer);
 	return pointer;
@@ -203,7 +287,9 @@ omrmem_free_memory(struct OMRPortLibrary *portLibrary, void *memoryPointer)
 
 	if (memoryPointer != NULL) {
 		memoryPointer = unwrapBlockAndCheckTags(portLibrary, memoryPointer);
-		freeFunction(portLibrary, memoryPointer);
+		if (!omrmem_small_block_free(portLibrary, memoryPointer)) {
+			freeFunction(portLibrary, memoryPointer);
+		}
 	}
 	Trc_PRT_mem_omrmem_free_memory_Exit();
 }
@@ -232,14 +318,18 @@ omrmem_advise_and_free_memory(struct OMRPortLibrary *portLibrary, void *memoryPo
 		 * No error is raised here b/c one will be raised in 'unwrapBlockAndCheckTags'
 		 * below.
 		 */
-		if ((checkTagSumCheck(headerTag, J9MEMTAG_EYECATCHER_ALLOC_HEADER) == 0) && (checkPadding(headerTag) == 0)) {
+		if (J9MEMTAG_EYECATCHER_LIGHT_HEADER == headerTag->eyeCatcher) {
+			memorySize = ROUNDED_LIGHT_BYTE_AMOUNT(headerTag->allocSize);
+		} else if ((checkTagSumCheck(headerTag, J9MEMTAG_EYECATCHER_ALLOC_HEADER) == 0) && (checkPadding(headerTag) == 0)) {
 			memorySize = ROUNDED_BYTE_AMOUNT(headerTag->allocSize);
 		} else {
 			memorySize = 0;
 		}
 #endif /* (defined(LINUX) || defined (AIXPPC) || defined(J9ZOS390) || defined(OSX)) */
 		memoryPointer = unwrapBlockAndCheckTags(portLibrary, memoryPointer);
-		adviseAndFreeFunction(portLibrary, memoryPointer, memorySize);
+		if (!omrmem_small_block_free(portLibrary, memoryPointer)) {
+			adviseAndFreeFunction(portLibrary, memoryPointer, memorySize);
+		}
 	}
 	Trc_PRT_mem_omrmem_advise_and_free_memory_Exit();
 }
@@ -275,6 +365,8 @@ omrmem_reallocate_memory(struct OMRPortLibrary *portLibrary, void *memoryPointer
 {
 	void *pointer = NULL;
 	uintptr_t allocationByteAmount;
+	uintptr_t smallBlockSize = 0;
+	BOOLEAN fullTags = TRUE;
 	reallocate_memory_func_t reallocateFunction = omrmem_reallocate_memory_basic;
 
 	Trc_PRT_mem_omrmem_reallocate_memory_Entry(memoryPointer, byteAmount, callSite, category);
@@ -288,15 +380,39 @@ omrmem_reallocate_memory(struct OMRPortLibrary *portLibrary, void *memoryPointer
 		if (NULL == callSite) {
 			/* Inherit the callsite from the original allocation */
 			callSite = ((J9MemTag *) memoryPointer)->callSite;
+			if (NULL == callSite) {
+				/* light headers do not record the callsite */
+				callSite = OMR_GET_CALLSITE();
+			}
 		}
-		allocationByteAmount = ROUNDED_BYTE_AMOUNT(byteAmount);
-
-		pointer = reallocateFunction(portLibrary, memoryPointer, allocationByteAmount);
-		if (NULL != pointer) {
-			pointer = wrapBlockAndSetTags(portLibrary, pointer, byteAmount, callSite, category);
+		fullTags = sampleNextAllocation(portLibrary);
+		allocationByteAmount = fullTags ? ROUNDED_BYTE_AMOUNT(byteAmount) : ROUNDED_LIGHT_BYTE_AMOUNT(byteAmount);
+
+		smallBlockSize = omrmem_small_block_size(portLibrary, memoryPointer);
+		if (0 == smallBlockSize) {
+			pointer = reallocateFunction(portLibrary, memoryPointer, allocationByteAmount);
+		} else if ((allocationByteAmount <= smallBlockSize) && (allocationByteAmount > (smallBlockSize / 2))) {
+			/* still a good fit for the existing small block */
+			pointer = memoryPointer;
+		} else {
+			pointer = omrmem_small_block_allocate(portLibrary, allocationByteAmount);
+			if (NULL == pointer) {
+				pointer = omrmem_allocate_memory_basic(portLibrary, allocationByteAmount);
+			}
+			if (NULL != pointer) {
+				memcpy(pointer, memoryPointer, OMR_MIN(smallBlockSize, allocationByteAmount));
+				omrmem_small_block_free(portLibrary, memoryPointer);
+			}
 		}
 		if (NULL == pointer) {
 			Trc_PRT_mem_omrmem_reallocate_memory_failed_2(callSite, memoryPointer, allocationByteAmount);
+		} else if (fullTags) {
+			pointer = wrapBlockAndSetTags(portLibrary, pointer, byteAmount, callSite, category);
+			if (0 != portLibrary->portGlobals->memTagSampleInterval) {
+				omrmem_tag_sample_add(portLibrary, omrmem_get_header_tag(pointer));
+			}
+		} else {
+			pointer = wrapBlockWithLightTag(portLibrary, pointer, byteAmount, category);
 		}
 	}
 
@@ -319,6 +435,10 @@ omrmem_reallocate_memory(struct OMRPortLibrary *portLibrary, void *memoryPointer
 void
 omrmem_shutdown(struct OMRPortLibrary *portLibrary)
 {
+	if (NULL != portLibrary->portGlobals) {
+		omrmem_tag_sampling_shutdown(portLibrary);
+		omrmem_small_block_shutdown(portLibrary);
+	}
 	omrmem_shutdown_categories(portLibrary);
 
 #if defined(OMR_ENV_DATA64)
@@ -26,6 +26,8 @@
 #define ROUNDING_GRANULARITY	8
 #define ROUNDED_FOOTER_OFFSET(number)	(((number) + (ROUNDING_GRANULARITY - 1) + sizeof(J9MemTag)) & ~(uintptr_t)(ROUNDING_GRANULARITY - 1))
 #define ROUNDED_BYTE_AMOUNT(number)		(ROUNDED_FOOTER_OFFSET(number) + sizeof(J9MemTag))
+/* Size of a block carrying only a light header: no footer tag and no padding check */
+#define ROUNDED_LIGHT_BYTE_AMOUNT(number)	(ROUNDED_FOOTER_OFFSET(number))
 
 uint32_t checkPadding(J9MemTag *tagAddress);
 uint32_t checkTagSumCheck(J9MemTag *tagAddress, uint32_t eyeCatcher);
@@ -0,0 +1,385 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Sampled memory tagging
+ */
+
+/*
+ * By default every omrmem_allocate_memory block carries a checksummed header
+ * and footer tag and padding, all of which are verified when the block is
+ * freed. With OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL set to N, only about one
+ * block in N is tagged that way; the rest get a header holding just the
+ * size and category (see wrapBlockWithLightTag in omrmemtag.c).
+ *
+ * The fully tagged blocks taken while sampling is on are recorded here, in an
+ * open-addressed set of header tag addresses, so that they can be verified
+ * while they are still live: on demand through OMRPORT_CTLDATA_MEM_TAG_VERIFY,
+ * or periodically by a verifier thread started with
+ * OMRPORT_CTLDATA_MEM_TAG_VERIFY_PERIOD.
+ */
+#include <string.h>
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "omrutil.h"
+#include "ut_omrport.h"
+
+#include "omrmemtag_checks.h"
+
+#define SAMPLE_TABLE_INITIAL_CAPACITY 1024
+
+typedef struct J9MemTagSamples {
+	struct OMRPortLibrary *portLibrary;
+	MUTEX mutex; /* guards the table */
+	J9MemTag **table;
+	uintptr_t capacity; /* a power of two */
+	uintptr_t count;
+	omrthread_monitor_t verifierMonitor;
+	omrthread_t verifierThread;
+	uintptr_t verifyPeriod; /* milliseconds, 0 to stop the verifier thread */
+} J9MemTagSamples;
+
+static uintptr_t
+hashTag(J9MemTagSamples *samples, J9MemTag *headerTag)
+{
+	return (((uintptr_t)headerTag >> 3) * (uintptr_t)0x9E3779B9) & (samples->capacity - 1);
+}
+
+/**
+ * Allocate a table of capacity slots. The table is taken straight from
+ * omrmem_allocate_memory_basic, because it is grown while an allocation is
+ * already in progress, and is accounted to the port library category by hand.
+ */
+static J9MemTag **
+allocateTable(struct OMRPortLibrary *portLibrary, uintptr_t capacity)
+{
+	J9MemTag **table = omrmem_allocate_memory_basic(portLibrary, capacity * sizeof(J9MemTag *));
+
+	if (NULL != table) {
+		memset(table, 0, capacity * sizeof(J9MemTag *));
+		omrmem_categories_increment_counters(omrmem_get_category(portLibrary, OMRMEM_CATEGORY_PORT_LIBRARY), capacity * sizeof(J9MemTag *));
+	}
+	return table;
+}
+
+static void
+freeTable(struct OMRPortLibrary *portLibrary, J9MemTag **table, uintptr_t capacity)
+{
+	omrmem_categories_decrement_counters(omrmem_get_category(portLibrary, OMRMEM_CATEGORY_PORT_LIBRARY), capacity * sizeof(J9MemTag *));
+	omrmem_free_memory_basic(portLibrary, table);
+}
+
+static void
+insertTag(J9MemTagSamples *samples, J9MemTag *headerTag)
+{
+	uintptr_t mask = samples->capacity - 1;
+	uintptr_t slot = hashTag(samples, headerTag);
+
+	while (NULL != samples->table[slot]) {
+		slot = (slot + 1) & mask;
+	}
+	samples->table[slot] = headerTag;
+	samples->count += 1;
+}
+
+/**
+ * Check the tags and padding of one sampled block, exactly as freeing it would.
+ *
+ * @return TRUE if the block is intact
+ */
+static BOOLEAN
+verifyTag(J9MemTag *headerTag)
+{
+	return (0 == checkTagSumCheck(headerTag, J9MEMTAG_EYECATCHER_ALLOC_HEADER))
+		&& (0 == checkTagSumCheck(omrmem_get_footer_tag(headerTag), J9MEMTAG_EYECATCHER_ALLOC_FOOTER))
+		&& (0 == checkPadding(headerTag));
+}
+
+static uintptr_t
+verifySamples(J9MemTagSamples *samples)
+{
+	struct OMRPortLibrary *portLibrary = samples->portLibrary;
+	uintptr_t corrupted = 0;
+	uintptr_t checked = 0;
+	void *corruptedBlock = NULL;
+	const char *corruptedCallSite = NULL;
+	uintptr_t i = 0;
+
+	MUTEX_ENTER(samples->mutex);
+	for (i = 0; i < samples->capacity; i++) {
+		J9MemTag *headerTag = samples->table[i];
+		if (NULL != headerTag) {
+			checked += 1;
+			if (!verifyTag(headerTag)) {
+				if (0 == corrupted) {
+					corruptedBlock = omrmem_get_memory_base(headerTag);
+					corruptedCallSite = headerTag->callSite;
+				}
+				corrupted += 1;
+			}
+		}
+	}
+	MUTEX_EXIT(samples->mutex);
+
+	/* Trace only once the table is released: tracing may itself allocate */
+	Trc_PRT_mem_tag_samples_verified(checked, corrupted);
+	if (0 != corrupted) {
+		BOOLEAN memoryCorruptionDetected = FALSE;
+
+		portLibrary->portGlobals->corruptedMemoryBlock = corruptedBlock;
+		Trc_PRT_mem_tag_sample_corrupted(corruptedBlock, corrupted, (NULL == corruptedCallSite) ? "" : corruptedCallSite);
+		Trc_Assert_PRT_memory_corruption_detected(memoryCorruptionDetected);
+	}
+	return corrupted;
+}
+
+static int J9THREAD_PROC
+sampleVerifier(void *userData)
+{
+	J9MemTagSamples *samples = (J9MemTagSamples *)userData;
+
+	omrthread_set_name(omrthread_self(), "Memory Tag Verifier");
+
+	omrthread_monitor_enter(samples->verifierMonitor);
+	while (0 != samples->verifyPeriod) {
+		if (J9THREAD_TIMED_OUT == omrthread_monitor_wait_timed(samples->verifierMonitor, (int64_t)samples->verifyPeriod, 0)) {
+			if (0 != samples->verifyPeriod) {
+				verifySamples(samples);
+			}
+		}
+	}
+	samples->verifierThread = NULL;
+	omrthread_monitor_notify_all(samples->verifierMonitor);
+	omrthread_exit(samples->verifierMonitor);
+
+	/* unreachable */
+	return 0;
+}
+
+/**
+ * Record a fully tagged block taken while sampling. If the table cannot grow
+ * the block is simply not recorded; its tags are still checked when it is freed.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] headerTag The header tag of the block
+ */
+void
+omrmem_tag_sample_add(struct OMRPortLibrary *portLibrary, J9MemTag *headerTag)
+{
+	J9MemTagSamples *samples = portLibrary->portGlobals->memTagSamples;
+
+	MUTEX_ENTER(samples->mutex);
+	if (((samples->count + 1) * 2) > samples->capacity) {
+		uintptr_t oldCapacity = samples->capacity;
+		J9MemTag **oldTable = samples->table;
+		J9MemTag **newTable = allocateTable(portLibrary, oldCapacity * 2);
+
+		if (NULL == newTable) {
+			MUTEX_EXIT(samples->mutex);
+			return;
+		} else {
+			uintptr_t i = 0;
+
+			samples->table = newTable;
+			samples->capacity = oldCapacity * 2;
+			samples->count = 0;
+			for (i = 0; i < oldCapacity; i++) {
+				if (NULL != oldTable[i]) {
+					insertTag(samples, oldTable[i]);
+				}
+			}
+			freeTable(portLibrary, oldTable, oldCapacity);
+		}
+	}
+	insertTag(samples, headerTag);
+	MUTEX_EXIT(samples->mutex);
+}
+
+/**
+ * Forget a fully tagged block which is about to be freed or reallocated.
+ * Blocks which were never recorded are ignored.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] headerTag The header tag of the block
+ */
+void
+omrmem_tag_sample_remove(struct OMRPortLibrary *portLibrary, J9MemTag *headerTag)
+{
+	J9MemTagSamples *samples = portLibrary->portGlobals->memTagSamples;
+	uintptr_t mask = 0;
+	uintptr_t slot = 0;
+
+	MUTEX_ENTER(samples->mutex);
+	mask = samples->capacity - 1;
+	slot = hashTag(samples, headerTag);
+	while ((NULL != samples->table[slot]) && (headerTag != samples->table[slot])) {
+		slot = (slot + 1) & mask;
+	}
+	if (NULL != samples->table[slot]) {
+		/* Backward shift deletion: move later entries of the probe run into the hole */
+		uintptr_t hole = slot;
+		uintptr_t next = (slot + 1) & mask;
+
+		while (NULL != samples->table[next]) {
+			uintptr_t home = hashTag(samples, samples->table[next]);
+			if (((next - home) & mask) >= ((next - hole) & mask)) {
+				samples->table[hole] = samples->table[next];
+				hole = next;
+			}
+			next = (next + 1) & mask;
+		}
+		samples->table[hole] = NULL;
+		samples->count -= 1;
+	}
+	MUTEX_EXIT(samples->mutex);
+}
+
+/**
+ * Set the sampling interval. Handles OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] interval Fully tag about one block in interval, or 0 to fully tag every block
+ *
+ * @return 0 on success, 1 if the sample table could not be created
+ */
+int32_t
+omrmem_tag_set_sample_interval(struct OMRPortLibrary *portLibrary, uintptr_t interval)
+{
+	if ((0 != interval) && (NULL == portLibrary->portGlobals->memTagSamples)) {
+		J9MemTagSamples *samples = portLibrary->mem_allocate_memory(portLibrary, sizeof(J9MemTagSamples), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+
+		if (NULL == samples) {
+			return 1;
+		}
+		memset(samples, 0, sizeof(J9MemTagSamples));
+		samples->portLibrary = portLibrary;
+		samples->capacity = SAMPLE_TABLE_INITIAL_CAPACITY;
+		samples->table = allocateTable(portLibrary, samples->capacity);
+		if (NULL == samples->table) {
+			goto free_samples;
+		}
+		if (!MUTEX_INIT(samples->mutex)) {
+			goto free_table;
+		}
+		if (0 != omrthread_monitor_init_with_name(&samples->verifierMonitor, 0, "omrmem tag verifier")) {
+			goto destroy_mutex;
+		}
+		portLibrary->portGlobals->memTagSamples = samples;
+		goto done;
+
+destroy_mutex:
+		MUTEX_DESTROY(samples->mutex);
+free_table:
+		freeTable(portLibrary, samples->table, samples->capacity);
+free_samples:
+		portLibrary->mem_free_memory(portLibrary, samples);
+		return 1;
+	}
+done:
+	portLibrary->portGlobals->memTagSampleInterval = interval;
+	return 0;
+}
+
+/**
+ * Start, retime or stop the background verifier. Handles OMRPORT_CTLDATA_MEM_TAG_VERIFY_PERIOD.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] millis Milliseconds between walks of the sampled blocks, or 0 to stop the verifier
+ *
+ * @return 0 on success, 1 if sampling has never been enabled or the thread could not be started
+ */
+int32_t
+omrmem_tag_set_verify_period(struct OMRPortLibrary *portLibrary, uintptr_t millis)
+{
+	J9MemTagSamples *samples = portLibrary->portGlobals->memTagSamples;
+	int32_t rc = 0;
+
+	if (NULL == samples) {
+		return (0 == millis) ? 0 : 1;
+	}
+
+	omrthread_monitor_enter(samples->verifierMonitor);
+	samples->verifyPeriod = millis;
+	if (NULL != samples->verifierThread) {
+		omrthread_monitor_notify_all(samples->verifierMonitor);
+		if (0 == millis) {
+			while (NULL != samples->verifierThread) {
+				omrthread_monitor_wait(samples->verifierMonitor);
+			}
+		}
+	} else if (0 != millis) {
+		if (J9THREAD_SUCCESS != createThreadWithCategory(
+				&samples->verifierThread,
+				256 * 1024,
+				J9THREAD_PRIORITY_NORMAL,
+				0,
+				&sampleVerifier,
+				samples,
+				J9THREAD_CATEGORY_SYSTEM_THREAD)
+		) {
+			samples->verifierThread = NULL;
+			samples->verifyPeriod = 0;
+			rc = 1;
+		}
+	}
+	omrthread_monitor_exit(samples->verifierMonitor);
+	return rc;
+}
+
+/**
+ * Verify every live sampled block now. Handles OMRPORT_CTLDATA_MEM_TAG_VERIFY.
+ *
+ * @param[in] portLibrary The port library
+ *
+ * @return the number of corrupted blocks found
+ */
+uintptr_t
+omrmem_tag_verify_samples(struct OMRPortLibrary *portLibrary)
+{
+	J9MemTagSamples *samples = portLibrary->portGlobals->memTagSamples;
+
+	return (NULL == samples) ? 0 : verifySamples(samples);
+}
+
+/**
+ * Stop the verifier and release the sample table.
+ *
+ * @param[in] portLibrary The port library
+ */
+void
+omrmem_tag_sampling_shutdown(struct OMRPortLibrary *portLibrary)
+{
+	J9MemTagSamples *samples = portLibrary->portGlobals->memTagSamples;
+
+	if (NULL != samples) {
+		omrmem_tag_set_verify_period(portLibrary, 0);
+		portLibrary->portGlobals->memTagSampleInterval = 0;
+		portLibrary->portGlobals->memTagSamples = NULL;
+		omrthread_monitor_destroy(samples->verifierMonitor);
+		MUTEX_DESTROY(samples->mutex);
+		freeTable(portLibrary, samples->table, samples->capacity);
+		portLibrary->mem_free_memory(portLibrary, samples);
+	}
+}
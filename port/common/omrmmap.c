@@ -57,6 +57,8 @@
  * @args                            OMRPORT_MMAP_FLAG_COPYONWRITE 	copy on write map
  * @args                            OMRPORT_MMAP_FLAG_SHARED         share memory mapping with other processes
  * @args                            OMRPORT_MMAP_FLAG_PRIVATE        private memory mapping, do not share with other processes (implied by OMRPORT_MMAP_FLAG_COPYONWRITE)
+ * @args                            OMRPORT_MMAP_FLAG_POPULATE       fault the whole mapping in before returning
+ * @args                            OMRPORT_MMAP_FLAG_HUGEPAGE       back the mapping with huge pages where the filesystem supports them, otherwise ignored
  * @param [in]  category        Memory allocation category code
  *
  * @return                      A J9MmapHandle struct or NULL is an error has occurred
@@ -266,3 +268,50 @@ omrmmap_dont_need(struct OMRPortLibrary *portLibrary, const void *startAddress,
 	return;
 }
 
+
+/**
+ * Give the operating system a hint about how a range of mapped memory will be accessed.
+ * The start address is rounded down and the end rounded up to page boundaries.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] start Start of the memory range, normally within a region returned by omrmmap_map_file
+ * @param[in] length Number of bytes in the range
+ * @param[in] advice The expected access pattern:
+ * \arg OMRPORT_MMAP_ADVICE_NORMAL no special treatment, undoes earlier advice
+ * \arg OMRPORT_MMAP_ADVICE_SEQUENTIAL pages will be read in order, read ahead aggressively and drop them early
+ * \arg OMRPORT_MMAP_ADVICE_RANDOM pages will be read in no particular order, do not read ahead
+ * \arg OMRPORT_MMAP_ADVICE_WILLNEED pages will be needed soon, start reading them in
+ * \arg OMRPORT_MMAP_ADVICE_HUGEPAGE back the range with huge pages where the kernel and filesystem allow it
+ *
+ * @return 0 on success, or a negative error code:
+ * \arg OMRPORT_ERROR_MMAP_ADVISE_INVALIDADVICE advice is not one of the values above
+ * \arg OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED the platform, or the mapping, does not support the advice
+ * \arg OMRPORT_ERROR_MMAP_ADVISE_FAILED the operating system rejected the advice
+ *
+ * @note The advice is only a hint. Support for it is reported by OMRPORT_MMAP_CAPABILITY_ADVISE and,
+ * for OMRPORT_MMAP_ADVICE_HUGEPAGE, OMRPORT_MMAP_CAPABILITY_HUGEPAGE.
+ */
+intptr_t
+omrmmap_advise(struct OMRPortLibrary *portLibrary, void *start, uintptr_t length, uint32_t advice)
+{
+	return OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+}
+
+/**
+ * Start reading part of a mapped file into memory without waiting for the reads to finish.
+ * A later access to the range then finds the pages resident instead of faulting them in one at a time.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] handle A mapping returned by omrmmap_map_file
+ * @param[in] offset Offset of the range from the start of the mapping
+ * @param[in] length Number of bytes to prefetch, 0 means to the end of the mapping.  The range is clipped to the mapping.
+ *
+ * @return 0 once the reads have been scheduled, or a negative error code:
+ * \arg OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED the platform cannot prefetch mapped files
+ * \arg OMRPORT_ERROR_MMAP_ADVISE_FAILED the operating system rejected the request
+ */
+intptr_t
+omrmmap_prefetch(struct OMRPortLibrary *portLibrary, J9MmapHandle *handle, uintptr_t offset, uintptr_t length)
+{
+	return OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+}
@@ -56,6 +56,9 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrtime_hires_clock, /* time_hires_clock */
 	omrtime_hires_frequency, /* time_hires_frequency */
 	omrtime_hires_delta, /* time_hires_delta */
+	omrtime_cycle_clock, /* time_cycle_clock */
+	omrtime_cycle_frequency, /* time_cycle_frequency */
+	omrtime_cycles_to_nanos, /* time_cycles_to_nanos */
 	omrsysinfo_startup, /* sysinfo_startup */
 	omrsysinfo_shutdown, /* sysinfo_shutdown */
 	omrsysinfo_process_exists, /* sysinfo_process_exists */
@@ -246,6 +249,14 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrfile_convert_omrfile_fd_to_native_fd,
 	omrfile_blockingasync_unlock_bytes, /* file_blockingasync_unlock_bytes */
 	omrfile_blockingasync_lock_bytes, /* file_blockingasync_lock_bytes */
+	omrfile_async_create, /* file_async_create */
+	omrfile_async_destroy, /* file_async_destroy */
+	omrfile_async_submit, /* file_async_submit */
+	omrfile_async_complete, /* file_async_complete */
+	omrfile_async_backend, /* file_async_backend */
+	omrfile_writev, /* file_writev */
+	omrfile_copy_range, /* file_copy_range */
+	omrfile_sendfile, /* file_sendfile */
 	omrstr_ftime, /* str_ftime */
 	omrmmap_startup, /* mmap_startup */
 	omrmmap_shutdown, /* mmap_shutdown */
@@ -256,6 +267,8 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrmmap_protect, /* mmap_protect */
 	omrmmap_get_region_granularity, /* mmap_get_region_granularity */
 	omrmmap_dont_need, /* mmap_dont_need */
+	omrmmap_advise, /* mmap_advise */
+	omrmmap_prefetch, /* mmap_prefetch */
 	omrsysinfo_get_limit, /* sysinfo_get_limit */
 	omrsysinfo_set_limit, /* sysinfo_set_limit */
 	omrsysinfo_get_number_CPUs_by_type, /* sysinfo_get_number_CPUs_by_type */
@@ -281,6 +294,9 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrsysinfo_cgroup_subsystem_iterator_metricKey, /* sysinfo_cgroup_subsystem_iterator_metricKey */
 	omrsysinfo_cgroup_subsystem_iterator_next, /* sysinfo_cgroup_subsystem_iterator_next */
 	omrsysinfo_cgroup_subsystem_iterator_destroy, /* sysinfo_cgroup_subsystem_iterator_destroy */
+	omrsysinfo_get_cpu_list, /* sysinfo_get_cpu_list */
+	omrsysinfo_get_cpu_topology, /* sysinfo_get_cpu_topology */
+	omrsysinfo_destroy_cpu_topology, /* sysinfo_destroy_cpu_topology */
 	omrport_init_library, /* port_init_library */
 	omrport_startup_library, /* port_startup_library */
 	omrport_create_library, /* port_create_library */
@@ -293,6 +309,15 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrintrospect_threads_nextDo, /* introspect_threads_nextDo */
 	omrintrospect_backtrace_thread, /* introspect_backtrace_thread */
 	omrintrospect_backtrace_symbols, /* introspect_backtrace_symbols */
+	omrprofiler_create, /* profiler_create */
+	omrprofiler_destroy, /* profiler_destroy */
+	omrprofiler_register_thread, /* profiler_register_thread */
+	omrprofiler_unregister_thread, /* profiler_unregister_thread */
+	omrprofiler_start, /* profiler_start */
+	omrprofiler_stop, /* profiler_stop */
+	omrprofiler_drain, /* profiler_drain */
+	omrprofiler_get_stats, /* profiler_get_stats */
+	omrprofiler_symbolize, /* profiler_symbolize */
 	omrsyslog_query, /* syslog_query */
 	omrsyslog_set, /* syslog_set */
 	omrmem_walk_categories, /* mem_walk_categories */
@@ -319,6 +344,16 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrsock_recv, /* sock_recv */
 	omrsock_recvfrom, /* sock_recvfrom */
 	omrsock_close, /* sock_close */
+	omrsock_sendmsg, /* sock_sendmsg */
+	omrsock_getaddrinfo_address, /* sock_getaddrinfo_address */
+	omrsock_getsockname, /* sock_getsockname */
+	omrsock_fcntl, /* sock_fcntl */
+	omrsock_poll_create, /* sock_poll_create */
+	omrsock_poll_destroy, /* sock_poll_destroy */
+	omrsock_poll_ctl, /* sock_poll_ctl */
+	omrsock_poll_wait, /* sock_poll_wait */
+	omrsock_poll_timer_start, /* sock_poll_timer_start */
+	omrsock_poll_timer_cancel, /* sock_poll_timer_cancel */
 #endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
 #if defined(OMR_OPT_CUDA)
 	NULL, /* cuda_configData */
@@ -302,6 +302,22 @@ omrport_control(struct OMRPortLibrary *portLibrary, const char *key, uintptr_t v
 		return 0;
 	}
 
+	if (0 == strcmp(OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR, key)) {
+		return omrmem_small_block_control(portLibrary, value);
+	}
+
+	if (0 == strcmp(OMRPORT_CTLDATA_MEM_TAG_SAMPLE_INTERVAL, key)) {
+		return omrmem_tag_set_sample_interval(portLibrary, value);
+	}
+
+	if (0 == strcmp(OMRPORT_CTLDATA_MEM_TAG_VERIFY_PERIOD, key)) {
+		return omrmem_tag_set_verify_period(portLibrary, value);
+	}
+
+	if (0 == strcmp(OMRPORT_CTLDATA_MEM_TAG_VERIFY, key)) {
+		return (int32_t)omrmem_tag_verify_samples(portLibrary);
+	}
+
 	/* work around for case if smart address feature still be not reliable enough */
 	if (0 == strcmp(OMRPORT_CTLDATA_VMEM_PERFORM_FULL_MEMORY_SEARCH, key)) {
 #if defined(PPG_performFullMemorySearch)
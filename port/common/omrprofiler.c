@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Sampling profiler
+ */
+
+#include <string.h>
+
+#include "omrport.h"
+#include "omrportpriv.h"
+
+/**
+ * Create a sampling profiler.
+ *
+ * Each registered thread gets a timer that measures its CPU time and interrupts it every
+ * intervalNanos of CPU time consumed. The signal handler walks the stack through the frame
+ * pointer chain and appends the sample to a buffer owned by that thread, without taking locks
+ * or allocating memory. The samples are collected with @ref omrprofiler_drain and their
+ * addresses resolved on demand with @ref omrprofiler_symbolize.
+ *
+ * Only code compiled with frame pointers can be unwound past; the innermost frame is always
+ * the interrupted instruction. The operating system may deliver samples no more often than
+ * its scheduler tick, whatever the interval. Only one profiler can exist in a process at a time.
+ * Profiling is supported on Linux on x86, x86-64 and AArch64.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] intervalNanos The CPU time between samples of a thread, in nanoseconds
+ * @param[in] maxFrames The maximum number of frames recorded per sample
+ * @param[in] bufferSamples The number of samples each thread's buffer holds until drained
+ * @param[out] profiler The new profiler, which is not started
+ *
+ * @return 0 on success, OMRPORT_ERROR_EXIST if another profiler exists, OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM
+ * where profiling is not supported, or a negative portable error code.
+ */
+int32_t
+omrprofiler_create(struct OMRPortLibrary *portLibrary, uint64_t intervalNanos, uint32_t maxFrames, uint32_t bufferSamples, struct OMRProfiler **profiler)
+{
+	*profiler = NULL;
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Destroy a profiler created by @ref omrprofiler_create.
+ *
+ * Sampling stops and the buffers of all threads, registered or not, are released along
+ * with any samples that were not drained. SIGPROF goes back to the handler it had before
+ * the profiler was created, except that the default action is replaced by ignoring the
+ * signal, as a signal already queued by a deleted timer may still arrive.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] profiler The profiler, may be NULL
+ */
+void
+omrprofiler_destroy(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+}
+
+/**
+ * Start sampling the calling thread.
+ *
+ * A thread must unregister before it exits.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] profiler The profiler
+ *
+ * @return 0 on success, OMRPORT_ERROR_EXIST if the thread is already registered, or a negative portable error code.
+ */
+int32_t
+omrprofiler_register_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Stop sampling the calling thread. Samples already taken remain available to @ref omrprofiler_drain.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] profiler The profiler
+ *
+ * @return 0 on success, OMRPORT_ERROR_NOTFOUND if the thread is not registered, or a negative portable error code.
+ */
+int32_t
+omrprofiler_unregister_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Arm the timers of all registered threads, and of threads registered later.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] profiler The profiler
+ *
+ * @return 0 on success, or a negative portable error code.
+ */
+int32_t
+omrprofiler_start(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Disarm the timers of all registered threads.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] profiler The profiler
+ *
+ * @return 0 on success, or a negative portable error code.
+ */
+int32_t
+omrprofiler_stop(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Pass the samples recorded since the previous drain to callback, thread by thread and in
+ * the order they were taken within a thread. Sampling continues while the buffers are drained,
+ * and calls from several threads are serialized.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] profiler The profiler
+ * @param[in] callback The function called for each sample
+ * @param[in] userData Passed to callback
+ *
+ * @return the number of samples drained, or a negative portable error code.
+ */
+intptr_t
+omrprofiler_drain(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, omrprofiler_sample_fn callback, void *userData)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Report the counters of a profiler.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] profiler The profiler
+ * @param[out] stats The counters
+ */
+void
+omrprofiler_get_stats(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, OMRProfilerStats *stats)
+{
+	memset(stats, 0, sizeof(OMRProfilerStats));
+}
+
+/**
+ * Find the module and nearest exported symbol containing an address, such as a frame of a sample.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] address The address to resolve
+ * @param[out] symbol The module and symbol; fields that cannot be determined are NULL
+ *
+ * @return 0 if the module was found, OMRPORT_ERROR_NOTFOUND if not, or a negative portable error code.
+ */
+int32_t
+omrprofiler_symbolize(struct OMRPortLibrary *portLibrary, uintptr_t address, OMRProfilerSymbol *symbol)
+{
+	memset(symbol, 0, sizeof(OMRProfilerSymbol));
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
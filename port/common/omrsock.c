@@ -225,7 +225,7 @@ omrsock_listen(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, int32_
  * connection is made. Subsequent calls to connect can be made to change destination address.
  *
  * It is not recommended that users call this function multiple times to determine when the 
- * connection attempt has succeeded. Instead, the @ref omrsock_select function can be used to 
+ * connection attempt has succeeded. Instead, a poll set, see @ref omrsock_poll_create, can be used to 
  * determine when the socket is ready for reading or writing.
  * 
  * @param[in] portLibrary The port library.
@@ -312,7 +312,7 @@ omrsock_sendto(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint8_
  * 
  * Its behavior will depend on the blocking characteristic of the socket.
  * Blocking socket: If no incoming data is available, the call blocks and waits for data to arrive. 
- * Non-blocking socket: TODO.
+ * Non-blocking socket: If no incoming data is available, the call fails with OMRPORT_ERROR_SOCKET_WOULDBLOCK.
  * 
  * @param[in] portLibrary The port library.
  * @param[in] sock Pointer to the socket to read on.
@@ -369,4 +369,205 @@ omrsock_close(struct OMRPortLibrary *portLibrary, omrsock_socket_t *sock)
 	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
 }
 
+/**
+ * Sends data gathered from several buffers on a connected socket, in one call.
+ * 
+ * With OMRSOCK_MSG_ZEROCOPY the kernel may transmit straight from the caller's
+ * pages instead of copying them into socket buffers. This only pays off for
+ * large sends, and the call then returns once the kernel no longer references
+ * the buffers, so they may be reused immediately. That can take until the peer
+ * acknowledges the data, so the flag is ignored on non-blocking sockets, as it
+ * is where zero-copy transmission is not available, and the data is copied as usual.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket to send on.
+ * @param[in] iov The buffers to send, in order.
+ * @param[in] iovCount The number of buffers.
+ * @param[in] flags 0 or OMRSOCK_MSG_ZEROCOPY.
+ *
+ * @return the total number of bytes sent if no error occurred, which may be less
+ * than the total length of the buffers. Otherwise, return an error.
+ */
+int32_t
+omrsock_sendmsg(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, OMRIOVec *iov, uint32_t iovCount, int32_t flags)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Copies the socket address at "index" in the structure returned from
+ * @ref omrsock_getaddrinfo, indexed starting at 0, so it can be passed to
+ * @ref omrsock_bind or @ref omrsock_connect.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handle The result structure returned by @ref omrsock_getaddrinfo.
+ * @param[out] addr The socket address at "index".
+ * @param[in] index The index into the structure returned by @ref omrsock_getaddrinfo.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getaddrinfo_address(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle, omrsock_sockaddr_t addr, int32_t index)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Answers the local address a socket is bound to. This is how to find the port
+ * chosen by the system after binding to port 0.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket.
+ * @param[out] addr The local address of the socket.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getsockname(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, omrsock_sockaddr_t addr)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Sets the flags of a socket.
+ *
+ * With OMRSOCK_O_NONBLOCK, calls on the socket which would otherwise block fail with
+ * OMRPORT_ERROR_SOCKET_WOULDBLOCK instead, and @ref omrsock_connect fails with
+ * OMRPORT_ERROR_SOCKET_IN_PROGRESS while the connection is being established.
+ * Passing 0 makes the socket blocking again.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket.
+ * @param[in] arg The flags to set, 0 or OMRSOCK_O_NONBLOCK.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_fcntl(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, int32_t arg)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Creates a poll set, which waits for any number of sockets to become ready and
+ * for timers to expire, in a single call. One thread can serve many connections
+ * this way, instead of dedicating a thread to each blocking socket.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] pollSet The new poll set.
+ * @param[in] flags Reserved, must be 0.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ *
+ * @note Must free the poll set with @ref omrsock_poll_destroy.
+ */
+int32_t
+omrsock_poll_create(struct OMRPortLibrary *portLibrary, omrsock_poll_t *pollSet, uint32_t flags)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Frees a poll set and any timers still started on it. The sockets that were
+ * registered are not closed.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set created by @ref omrsock_poll_create.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_destroy(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Registers a socket with a poll set, changes the events it is polled for, or
+ * removes it. A socket must be removed before it is closed.
+ *
+ * The events are OMRSOCK_POLLIN and/or OMRSOCK_POLLOUT. OMRSOCK_POLLERR and
+ * OMRSOCK_POLLHUP are always reported. By default a socket is reported by every
+ * @ref omrsock_poll_wait while it stays ready. With OMRSOCK_POLLET it is only
+ * reported when it becomes ready again, so the caller must then read or write
+ * the non-blocking socket until it fails with OMRPORT_ERROR_SOCKET_WOULDBLOCK.
+ * This saves a system call per event when serving many busy connections. Where
+ * the platform cannot poll edge-triggered, such sockets are reported as if they
+ * were level-triggered, which callers that drain them behave correctly with.
+ *
+ * This may be called while another thread waits in @ref omrsock_poll_wait.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[in] operation OMRSOCK_POLL_ADD, OMRSOCK_POLL_MODIFY or OMRSOCK_POLL_REMOVE.
+ * @param[in] sock The socket.
+ * @param[in] events The events to poll for, ignored by OMRSOCK_POLL_REMOVE.
+ * @param[in] userData Returned with each event for the socket, ignored by OMRSOCK_POLL_REMOVE.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_ctl(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int32_t operation, omrsock_socket_t sock, uint32_t events, void *userData)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Waits until registered sockets are ready or timers expire, and answers a batch
+ * of events. Expired timers are reported with OMRSOCK_POLLTIMER.
+ *
+ * Only one thread may wait on, or start and cancel timers on, a poll set at a time.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[out] events The events.
+ * @param[in] maxEvents The number of entries in events.
+ * @param[in] timeoutNanos How long to wait if nothing is ready, 0 to return
+ * immediately, or -1 to wait until something is.
+ *
+ * @return the number of events, 0 if the timeout expired, otherwise return an error.
+ */
+int32_t
+omrsock_poll_wait(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, OMRSockPollEvent *events, uint32_t maxEvents, int64_t timeoutNanos)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Starts a timer, which @ref omrsock_poll_wait reports once delayNanos have
+ * passed, measured by @ref omrtime_nano_time. A timer with a non-zero
+ * intervalNanos is then reported every intervalNanos until it is canceled.
+ * A one-shot timer is freed once it has been reported, and must not be
+ * canceled after that.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[in] delayNanos Time until the first expiry.
+ * @param[in] intervalNanos Time between later expiries, or 0 for a one-shot timer.
+ * @param[in] userData Returned with each event for the timer.
+ * @param[out] timer The timer, may be NULL for one-shot timers.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_timer_start(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int64_t delayNanos, int64_t intervalNanos, void *userData, omrsock_timer_t *timer)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+/**
+ * Stops and frees a timer started by @ref omrsock_poll_timer_start.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[in] timer The timer.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_timer_cancel(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, omrsock_timer_t timer)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
 #endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
@@ -1101,3 +1101,66 @@ omrsysinfo_cgroup_subsystem_iterator_destroy(struct OMRPortLibrary *portLibrary,
 {
 	return;
 }
+
+/**
+ * Lists the processors the process may run on. On Linux this is the process affinity
+ * mask intersected with the cpuset of the process's cgroup (when the cpuset subsystem
+ * has been enabled with omrsysinfo_cgroup_enable_subsystems()), so the list matches the
+ * CPUs actually granted to a container rather than those installed in the machine.
+ *
+ * The IDs are written in ascending order. At most the incoming value of *cpuCount IDs are
+ * written; on return *cpuCount holds the total number of usable processors, so a caller
+ * can pass a NULL list and a count of 0 to size its buffer.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[out] cpuList array which receives the processor IDs; may be NULL if *cpuCount is 0
+ * @param[in/out] cpuCount capacity of cpuList on input, number of usable processors on output
+ *
+ * @return 0 on success, otherwise negative error code
+ */
+int32_t
+omrsysinfo_get_cpu_list(struct OMRPortLibrary *portLibrary, uint32_t *cpuList, uintptr_t *cpuCount)
+{
+	*cpuCount = 0;
+	return OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED;
+}
+
+/**
+ * Describes the placement of every logical processor: its core, package and NUMA node, whether the
+ * process may run on it, and the size, line size, associativity and sharing of its L1, L2 and L3
+ * caches. This is intended for sizing structures such as work packets or thread local heaps to the
+ * caches the process can actually use. The function allocates topology->cpus, which is released
+ * with omrsysinfo_destroy_cpu_topology().
+ *
+ * On Linux the information comes from /sys/devices/system/cpu, with the x86 CPUID cache leaves
+ * used when the kernel does not export cache details. Processors are bound when they appear in
+ * omrsysinfo_get_cpu_list(), so the counts in the topology honour the cgroup cpuset.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] topology the topology to populate
+ *
+ * @return 0 on success; on failure, one of these values is returned:
+ *    OMRPORT_ERROR_SYSINFO_NULL_OBJECT_RECEIVED - a NULL 'topology' was received by the function
+ *    OMRPORT_ERROR_SYSINFO_MEMORY_ALLOC_FAILED - memory allocation failed
+ *    OMRPORT_ERROR_SYSINFO_ERROR_READING_PROCESSOR_INFO - the processors could not be enumerated
+ *    OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED - the platform does not support the query
+ *
+ * On failure, values in topology are not valid.
+ */
+int32_t
+omrsysinfo_get_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	return OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED;
+}
+
+/**
+ * Releases the array allocated by omrsysinfo_get_cpu_topology() and sets topology->cpus to NULL.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in/out] topology the topology to destroy
+ */
+void
+omrsysinfo_destroy_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	return;
+}
@@ -39,6 +39,11 @@
 /* defines for the CPUID instruction */
 #define CPUID_VENDOR_INFO                   0
 #define CPUID_FAMILY_INFO                   1
+#define CPUID_DETERMINISTIC_CACHE_PARAMS    4
+#define CPUID_EXTENDED_MAX_LEAF             0x80000000
+#define CPUID_EXTENDED_FEATURES             0x80000001
+#define CPUID_EXTENDED_CACHE_PARAMS         0x8000001D
+#define CPUID_EXTENDED_POWER_MANAGEMENT     0x80000007
 
 #define CPUID_VENDOR_INTEL                  "GenuineIntel"
 #define CPUID_VENDOR_AMD                    "AuthenticAMD"
@@ -68,7 +73,28 @@
 
 #define CPUID_MODELCODE_AMDK5               0x04
 
+#define CPUID_AMD_TOPOLOGY_EXTENSIONS       0x00400000
+
+/* fields of the deterministic cache parameter leaves (4 on Intel, 0x8000001D on AMD) */
+#define CPUID_CACHE_TYPE_MASK               0x1F
+#define CPUID_CACHE_TYPE_NULL               0
+#define CPUID_CACHE_TYPE_DATA               1
+#define CPUID_CACHE_TYPE_INSTRUCTION        2
+#define CPUID_CACHE_TYPE_UNIFIED            3
+#define CPUID_CACHE_LEVEL_SHIFT             5
+#define CPUID_CACHE_LEVEL_MASK              0x7
+#define CPUID_CACHE_SHARING_SHIFT           14
+#define CPUID_CACHE_SHARING_MASK            0xFFF
+#define CPUID_CACHE_FULLY_ASSOCIATIVE       0x200
+#define CPUID_CACHE_LINE_MASK               0xFFF
+#define CPUID_CACHE_PARTITIONS_SHIFT        12
+#define CPUID_CACHE_PARTITIONS_MASK         0x3FF
+#define CPUID_CACHE_WAYS_SHIFT              22
+#define CPUID_CACHE_WAYS_MASK               0x3FF
+#define CPUID_CACHE_MAX_SUBLEAF             16
+
 static void omrsysinfo_get_x86_cpuid(uint32_t leaf, uint32_t *cpuInfo);
+static void omrsysinfo_get_x86_cpuid_subleaf(uint32_t leaf, uint32_t subleaf, uint32_t *cpuInfo);
 
 /**
  * @internal
@@ -153,11 +179,158 @@ omrsysinfo_get_x86_description(struct OMRPortLibrary *portLibrary, OMRProcessorD
 	/* features */
 	desc->features[0] = CPUInfo[3];
 	desc->features[1] = CPUInfo[2];
-	desc->features[2] = 0; /* reserved for future expansion */
+	desc->features[2] = 0;
+
+	/* advanced power management features, including the invariant TSC */
+	omrsysinfo_get_x86_cpuid(CPUID_EXTENDED_MAX_LEAF, CPUInfo);
+	if (CPUInfo[0] >= CPUID_EXTENDED_POWER_MANAGEMENT) {
+		omrsysinfo_get_x86_cpuid(CPUID_EXTENDED_POWER_MANAGEMENT, CPUInfo);
+		desc->features[2] = CPUInfo[3];
+	}
 
 	return 0;
 }
 
+/**
+ * @internal
+ * Fills caches, indexed by the OMRPORT_CACHE_* slots, from the deterministic cache parameter
+ * leaf of the processor executing the call: leaf 4 on Intel and leaf 0x8000001D on AMD
+ * processors with topology extensions. The sharing count is the number of logical processor
+ * IDs reserved for the cache, which may be rounded up to a power of two. Slots for caches that
+ * are not reported are left untouched.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] caches array of OMRPORT_CACHE_SLOTS entries
+ *
+ * @return 0 if at least one cache was reported, OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED otherwise
+ */
+intptr_t
+omrsysinfo_get_x86_cache_info(struct OMRPortLibrary *portLibrary, OMRCacheInfo *caches)
+{
+	intptr_t rc = OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED;
+	uint32_t CPUInfo[4] = {0};
+	uint32_t cacheLeaf = 0;
+	uint32_t maxLeaf = 0;
+	uint32_t subleaf = 0;
+	char vendor[12];
+
+	omrsysinfo_get_x86_cpuid(CPUID_VENDOR_INFO, CPUInfo);
+	maxLeaf = CPUInfo[0];
+	memcpy(vendor + 0, &CPUInfo[1], sizeof(uint32_t));
+	memcpy(vendor + 4, &CPUInfo[3], sizeof(uint32_t));
+	memcpy(vendor + 8, &CPUInfo[2], sizeof(uint32_t));
+
+	if (0 == strncmp(vendor, CPUID_VENDOR_INTEL, CPUID_VENDOR_LENGTH)) {
+		if (maxLeaf >= CPUID_DETERMINISTIC_CACHE_PARAMS) {
+			cacheLeaf = CPUID_DETERMINISTIC_CACHE_PARAMS;
+		}
+	} else if (0 == strncmp(vendor, CPUID_VENDOR_AMD, CPUID_VENDOR_LENGTH)) {
+		omrsysinfo_get_x86_cpuid(CPUID_EXTENDED_MAX_LEAF, CPUInfo);
+		if (CPUInfo[0] >= CPUID_EXTENDED_CACHE_PARAMS) {
+			omrsysinfo_get_x86_cpuid(CPUID_EXTENDED_FEATURES, CPUInfo);
+			if (OMR_ARE_ALL_BITS_SET(CPUInfo[2], CPUID_AMD_TOPOLOGY_EXTENSIONS)) {
+				cacheLeaf = CPUID_EXTENDED_CACHE_PARAMS;
+			}
+		}
+	}
+
+	if (0 == cacheLeaf) {
+		return rc;
+	}
+
+	for (subleaf = 0; subleaf < CPUID_CACHE_MAX_SUBLEAF; subleaf++) {
+		uint32_t type = 0;
+		uint32_t level = 0;
+		intptr_t slot = -1;
+
+		omrsysinfo_get_x86_cpuid_subleaf(cacheLeaf, subleaf, CPUInfo);
+		type = CPUInfo[0] & CPUID_CACHE_TYPE_MASK;
+		if (CPUID_CACHE_TYPE_NULL == type) {
+			break;
+		}
+		level = (CPUInfo[0] >> CPUID_CACHE_LEVEL_SHIFT) & CPUID_CACHE_LEVEL_MASK;
+		if (1 == level) {
+			if (CPUID_CACHE_TYPE_DATA == type) {
+				slot = OMRPORT_CACHE_L1D;
+			} else if (CPUID_CACHE_TYPE_INSTRUCTION == type) {
+				slot = OMRPORT_CACHE_L1I;
+			}
+		} else if ((2 == level) && (CPUID_CACHE_TYPE_INSTRUCTION != type)) {
+			slot = OMRPORT_CACHE_L2;
+		} else if ((3 == level) && (CPUID_CACHE_TYPE_INSTRUCTION != type)) {
+			slot = OMRPORT_CACHE_L3;
+		}
+		if (slot >= 0) {
+			uint32_t lineSize = (CPUInfo[1] & CPUID_CACHE_LINE_MASK) + 1;
+			uint32_t partitions = ((CPUInfo[1] >> CPUID_CACHE_PARTITIONS_SHIFT) & CPUID_CACHE_PARTITIONS_MASK) + 1;
+			uint32_t ways = ((CPUInfo[1] >> CPUID_CACHE_WAYS_SHIFT) & CPUID_CACHE_WAYS_MASK) + 1;
+			uint32_t sets = CPUInfo[2] + 1;
+
+			caches[slot].size = (uint64_t)ways * partitions * lineSize * sets;
+			caches[slot].lineSize = lineSize;
+			caches[slot].associativity = OMR_ARE_ANY_BITS_SET(CPUInfo[0], CPUID_CACHE_FULLY_ASSOCIATIVE) ? 0 : ways;
+			caches[slot].sharingCount = (int32_t)((CPUInfo[0] >> CPUID_CACHE_SHARING_SHIFT) & CPUID_CACHE_SHARING_MASK) + 1;
+			rc = 0;
+		}
+	}
+
+	return rc;
+}
+
+/**
+ * @internal
+ * Counts the bound processors of a topology and the distinct cores, packages and NUMA nodes
+ * they occupy, filling in the counts of OMRCPUTopology.
+ *
+ * @param[in/out] topology a topology whose cpus array has been populated
+ */
+void
+omrsysinfo_count_cpu_topology(OMRCPUTopology *topology)
+{
+	int32_t i = 0;
+
+	topology->boundCount = 0;
+	topology->coreCount = 0;
+	topology->packageCount = 0;
+	topology->nodeCount = 0;
+
+	for (i = 0; i < topology->cpuCount; i++) {
+		OMRCPUTopologyEntry *entry = &topology->cpus[i];
+		BOOLEAN newCore = TRUE;
+		BOOLEAN newPackage = TRUE;
+		BOOLEAN newNode = TRUE;
+		int32_t j = 0;
+
+		if (!entry->bound) {
+			continue;
+		}
+		topology->boundCount += 1;
+		for (j = 0; j < i; j++) {
+			OMRCPUTopologyEntry *previous = &topology->cpus[j];
+			if (previous->bound) {
+				if (previous->core == entry->core) {
+					newCore = FALSE;
+				}
+				if (previous->package == entry->package) {
+					newPackage = FALSE;
+				}
+				if (previous->node == entry->node) {
+					newNode = FALSE;
+				}
+			}
+		}
+		if (newCore) {
+			topology->coreCount += 1;
+		}
+		if (newPackage && (OMRPORT_TOPOLOGY_NOT_AVAILABLE != entry->package)) {
+			topology->packageCount += 1;
+		}
+		if (newNode && (OMRPORT_TOPOLOGY_NOT_AVAILABLE != entry->node)) {
+			topology->nodeCount += 1;
+		}
+	}
+}
+
 /**
  * Assembly code to get the register data from CPUID instruction
  * This function executes the CPUID instruction based on which we can detect
@@ -186,13 +359,29 @@ omrsysinfo_get_x86_description(struct OMRPortLibrary *portLibrary, OMRProcessorD
 
 static void
 omrsysinfo_get_x86_cpuid(uint32_t leaf, uint32_t *cpuInfo)
+{
+	omrsysinfo_get_x86_cpuid_subleaf(leaf, 0, cpuInfo);
+}
+
+/**
+ * @internal
+ * Executes the CPUID instruction with ECX set to subleaf, for the leaves that enumerate
+ * several records such as the deterministic cache parameters.
+ *
+ * @param[in] 	leaf The leaf value to the CPUID instruction.
+ * @param[in] 	subleaf The subleaf value, passed in ECX.
+ * @param[out]	cpuInfo Receives the EAX, EBX, ECX and EDX registers.
+ */
+static void
+omrsysinfo_get_x86_cpuid_subleaf(uint32_t leaf, uint32_t subleaf, uint32_t *cpuInfo)
 {
 	cpuInfo[0] = leaf;
+	cpuInfo[2] = subleaf;
 
 /* Implemented for x86 & x86_64 bit platforms */
 #if defined(WIN32)
 	/* Specific CPUID instruction available in Windows */
-	__cpuid(cpuInfo, cpuInfo[0]);
+	__cpuidex((int *)cpuInfo, (int)leaf, (int)subleaf);
 
 #elif defined(LINUX) || defined(OSX)
 #if defined(J9X86)
@@ -201,13 +390,13 @@ omrsysinfo_get_x86_cpuid(uint32_t leaf, uint32_t *cpuInfo)
 			"cpuid;"
 			"mov %%ebx, %%esi;"
 			"mov %%edi, %%ebx;"
-			:"+a" (cpuInfo[0]), "=S" (cpuInfo[1]), "=c" (cpuInfo[2]), "=d" (cpuInfo[3])
+			:"+a" (cpuInfo[0]), "=S" (cpuInfo[1]), "+c" (cpuInfo[2]), "=d" (cpuInfo[3])
 			 : :"edi");
 
 #elif defined(J9HAMMER)
   __asm volatile(
      "cpuid;"
-     :"+a" (cpuInfo[0]), "=b" (cpuInfo[1]), "=c" (cpuInfo[2]), "=d" (cpuInfo[3])
+     :"+a" (cpuInfo[0]), "=b" (cpuInfo[1]), "+c" (cpuInfo[2]), "=d" (cpuInfo[3])
         );
 #endif
 #endif
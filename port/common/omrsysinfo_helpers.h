@@ -33,4 +33,10 @@
 extern intptr_t
 omrsysinfo_get_x86_description(struct OMRPortLibrary *portLibrary, OMRProcessorDesc *desc);
 
+extern intptr_t
+omrsysinfo_get_x86_cache_info(struct OMRPortLibrary *portLibrary, OMRCacheInfo *caches);
+
+extern void
+omrsysinfo_count_cpu_topology(OMRCPUTopology *topology);
+
 #endif /* SYSINFOHELPERS_H_ */
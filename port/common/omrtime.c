@@ -191,3 +191,50 @@ omrtime_startup(struct OMRPortLibrary *portLibrary)
 }
 
 
+/**
+ * Read the cycle clock.
+ *
+ * The cycle clock is the cheapest monotonic tick counter the platform offers, intended for
+ * timestamping very frequent events such as trace points and GC phases.  On x86-64 Linux with
+ * an invariant TSC this is the TSC itself.  Elsewhere it is the high-resolution clock, or
+ * @ref omrtime_nano_time when that is cheaper.  Only differences between two readings are
+ * meaningful: convert them with @ref omrtime_cycles_to_nanos.
+ *
+ * @param[in] portLibrary The port library.
+ *
+ * @return the current cycle count.
+ */
+uint64_t
+omrtime_cycle_clock(struct OMRPortLibrary *portLibrary)
+{
+	return portLibrary->time_hires_clock(portLibrary);
+}
+/**
+ * Query the cycle clock frequency.
+ *
+ * For a TSC this is measured against the system monotonic clock at startup and refined as the
+ * process runs, so successive calls may return slightly different values.
+ *
+ * @param[in] portLibrary The port library.
+ *
+ * @return the number of cycle clock ticks per second.
+ */
+uint64_t
+omrtime_cycle_frequency(struct OMRPortLibrary *portLibrary)
+{
+	return portLibrary->time_hires_frequency(portLibrary);
+}
+/**
+ * Convert a number of cycle clock ticks, normally the difference between two
+ * @ref omrtime_cycle_clock readings, into nanoseconds.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] cycles The number of ticks.
+ *
+ * @return the equivalent number of nanoseconds.
+ */
+uint64_t
+omrtime_cycles_to_nanos(struct OMRPortLibrary *portLibrary, uint64_t cycles)
+{
+	return portLibrary->time_hires_delta(portLibrary, 0, cycles, OMRPORT_TIME_DELTA_IN_NANOSECONDS);
+}
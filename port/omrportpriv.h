@@ -49,6 +49,13 @@
 #define FD_BIAS 0
 #endif
 
+/* Storage class for native thread locals, where the compiler supports them */
+#if defined(OMR_OS_WINDOWS) && defined(_MSC_VER)
+#define OMRPORT_NATIVE_TLS __declspec(thread)
+#elif (defined(LINUX) || defined(OSX)) && defined(__GNUC__) && !defined(OMRZTPF)
+#define OMRPORT_NATIVE_TLS __thread
+#endif /* defined(OMR_OS_WINDOWS) && defined(_MSC_VER) */
+
 typedef struct J9PortControlData {
 	uintptr_t sig_flags;
 	OMRMemCategorySet language_memory_categories;
@@ -131,6 +138,9 @@ typedef struct OMRPortLibraryGlobalData {
 	J9CudaGlobalData cudaGlobals;
 #endif /* OMR_OPT_CUDA */
 	uintptr_t vmemEnableMadvise;					/* madvise to use Transparent HugePage (THP) for Virtual memory allocated by mmap */
+	struct J9SmallBlockAllocator *smallBlockAllocator;	/* Thread-caching allocator for small blocks, NULL unless enabled with OMRPORT_CTLDATA_MEM_SMALL_BLOCK_ALLOCATOR */
+	uintptr_t memTagSampleInterval;	/* Fully tag about one omrmem block in this many, 0 to fully tag every block */
+	struct J9MemTagSamples *memTagSamples;	/* Live sampled blocks, NULL until sampling is first enabled */
 } OMRPortLibraryGlobalData;
 
 /* J9SourceJ9CPUControl*/
@@ -220,6 +230,12 @@ extern J9_CFUNC intptr_t
 omrfile_read(struct OMRPortLibrary *portLibrary, intptr_t fd, void *buf, intptr_t nbytes);
 extern J9_CFUNC intptr_t
 omrfile_write(struct OMRPortLibrary *portLibrary, intptr_t fd, const void *buf, intptr_t nbytes);
+extern J9_CFUNC intptr_t
+omrfile_writev(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRIOVec *iov, uint32_t iovCount);
+extern J9_CFUNC int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t inFD, int64_t inOffset, intptr_t outFD, int64_t outOffset, int64_t length);
+extern J9_CFUNC int64_t
+omrfile_sendfile(struct OMRPortLibrary *portLibrary, intptr_t outFD, intptr_t inFD, int64_t inOffset, int64_t length);
 extern J9_CFUNC const char *
 omrfile_error_message(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC int64_t
@@ -261,6 +277,18 @@ omrfile_blockingasync_startup(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC void
 omrfile_blockingasync_shutdown(struct OMRPortLibrary *portLibrary);
 
+/* J9SourceJ9FileAsync*/
+extern J9_CFUNC int32_t
+omrfile_async_create(struct OMRPortLibrary *portLibrary, uint32_t depth, uint32_t flags, struct OMRFileAsyncQueue **queue);
+extern J9_CFUNC void
+omrfile_async_destroy(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue);
+extern J9_CFUNC intptr_t
+omrfile_async_submit(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncRequest *requests, uintptr_t count);
+extern J9_CFUNC intptr_t
+omrfile_async_complete(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions);
+extern J9_CFUNC uint32_t
+omrfile_async_backend(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue);
+
 /* J9SourceJ9FileStream */
 extern J9_CFUNC int32_t
 omrfilestream_startup(struct OMRPortLibrary *portLibrary);
@@ -370,6 +398,32 @@ omrmem_categories_increment_bytes(OMRMemCategory *category, uintptr_t size);
 extern J9_CFUNC void
 omrmem_categories_decrement_bytes(OMRMemCategory *category, uintptr_t size);
 
+/* J9SourceJ9MemSmallBlock*/
+extern J9_CFUNC void *
+omrmem_small_block_allocate(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount);
+extern J9_CFUNC BOOLEAN
+omrmem_small_block_free(struct OMRPortLibrary *portLibrary, void *memoryPointer);
+extern J9_CFUNC uintptr_t
+omrmem_small_block_size(struct OMRPortLibrary *portLibrary, void *memoryPointer);
+extern J9_CFUNC int32_t
+omrmem_small_block_control(struct OMRPortLibrary *portLibrary, uintptr_t value);
+extern J9_CFUNC void
+omrmem_small_block_shutdown(struct OMRPortLibrary *portLibrary);
+
+/* J9SourceJ9MemTagSampling*/
+extern J9_CFUNC int32_t
+omrmem_tag_set_sample_interval(struct OMRPortLibrary *portLibrary, uintptr_t interval);
+extern J9_CFUNC int32_t
+omrmem_tag_set_verify_period(struct OMRPortLibrary *portLibrary, uintptr_t millis);
+extern J9_CFUNC uintptr_t
+omrmem_tag_verify_samples(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC void
+omrmem_tag_sample_add(struct OMRPortLibrary *portLibrary, J9MemTag *headerTag);
+extern J9_CFUNC void
+omrmem_tag_sample_remove(struct OMRPortLibrary *portLibrary, J9MemTag *headerTag);
+extern J9_CFUNC void
+omrmem_tag_sampling_shutdown(struct OMRPortLibrary *portLibrary);
+
 /* J9SourceJ9MemoryMap*/
 extern J9_CFUNC void
 omrmmap_unmap_file(struct OMRPortLibrary *portLibrary, J9MmapHandle *handle);
@@ -389,6 +443,10 @@ extern J9_CFUNC uintptr_t
 omrmmap_get_region_granularity(struct OMRPortLibrary *portLibrary, void *address);
 extern J9_CFUNC void
 omrmmap_dont_need(struct OMRPortLibrary *portLibrary, const void *startAddress, size_t length);
+extern J9_CFUNC intptr_t
+omrmmap_advise(struct OMRPortLibrary *portLibrary, void *start, uintptr_t length, uint32_t advice);
+extern J9_CFUNC intptr_t
+omrmmap_prefetch(struct OMRPortLibrary *portLibrary, J9MmapHandle *handle, uintptr_t offset, uintptr_t length);
 
 /* J9SourceJ9NLS*/
 extern J9_CFUNC const char *
@@ -555,6 +613,12 @@ extern J9_CFUNC int32_t
 omrsysinfo_cgroup_subsystem_iterator_next(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state, struct OMRCgroupMetricElement *metricElement);
 extern J9_CFUNC void
 omrsysinfo_cgroup_subsystem_iterator_destroy(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state);
+extern J9_CFUNC int32_t
+omrsysinfo_get_cpu_list(struct OMRPortLibrary *portLibrary, uint32_t *cpuList, uintptr_t *cpuCount);
+extern J9_CFUNC int32_t
+omrsysinfo_get_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology);
+extern J9_CFUNC void
+omrsysinfo_destroy_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology);
 
 /* J9SourceJ9Signal*/
 extern J9_CFUNC int32_t
@@ -640,6 +704,26 @@ extern J9_CFUNC int32_t
 omrsock_recvfrom(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint8_t *buf, int32_t nbyte, int32_t flags, omrsock_sockaddr_t addrHandle);
 extern J9_CFUNC int32_t
 omrsock_close(struct OMRPortLibrary *portLibrary, omrsock_socket_t *sock);
+extern J9_CFUNC int32_t
+omrsock_sendmsg(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, OMRIOVec *iov, uint32_t iovCount, int32_t flags);
+extern J9_CFUNC int32_t
+omrsock_getaddrinfo_address(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle, omrsock_sockaddr_t addr, int32_t index);
+extern J9_CFUNC int32_t
+omrsock_getsockname(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, omrsock_sockaddr_t addr);
+extern J9_CFUNC int32_t
+omrsock_fcntl(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, int32_t arg);
+extern J9_CFUNC int32_t
+omrsock_poll_create(struct OMRPortLibrary *portLibrary, omrsock_poll_t *pollSet, uint32_t flags);
+extern J9_CFUNC int32_t
+omrsock_poll_destroy(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet);
+extern J9_CFUNC int32_t
+omrsock_poll_ctl(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int32_t operation, omrsock_socket_t sock, uint32_t events, void *userData);
+extern J9_CFUNC int32_t
+omrsock_poll_wait(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, OMRSockPollEvent *events, uint32_t maxEvents, int64_t timeoutNanos);
+extern J9_CFUNC int32_t
+omrsock_poll_timer_start(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int64_t delayNanos, int64_t intervalNanos, void *userData, omrsock_timer_t *timer);
+extern J9_CFUNC int32_t
+omrsock_poll_timer_cancel(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, omrsock_timer_t timer);
 #endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
 
 /* J9SourceJ9Str*/
@@ -676,6 +760,12 @@ omrtime_hires_clock(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC uint64_t
 omrtime_hires_delta(struct OMRPortLibrary *portLibrary, uint64_t startTime, uint64_t endTime, uint64_t requiredResolution);
 extern J9_CFUNC uint64_t
+omrtime_cycle_clock(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC uint64_t
+omrtime_cycle_frequency(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC uint64_t
+omrtime_cycles_to_nanos(struct OMRPortLibrary *portLibrary, uint64_t cycles);
+extern J9_CFUNC uint64_t
 omrtime_hires_frequency(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC int32_t
 omrtime_startup(struct OMRPortLibrary *portLibrary);
@@ -794,6 +884,26 @@ omrintrospect_backtrace_thread(struct OMRPortLibrary *portLibrary, J9PlatformThr
 extern J9_CFUNC uintptr_t
 omrintrospect_backtrace_symbols(struct OMRPortLibrary *portLibrary, J9PlatformThread *threadInfo, J9Heap *heap);
 
+/* omrprofiler */
+extern J9_CFUNC int32_t
+omrprofiler_create(struct OMRPortLibrary *portLibrary, uint64_t intervalNanos, uint32_t maxFrames, uint32_t bufferSamples, struct OMRProfiler **profiler);
+extern J9_CFUNC void
+omrprofiler_destroy(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler);
+extern J9_CFUNC int32_t
+omrprofiler_register_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler);
+extern J9_CFUNC int32_t
+omrprofiler_unregister_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler);
+extern J9_CFUNC int32_t
+omrprofiler_start(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler);
+extern J9_CFUNC int32_t
+omrprofiler_stop(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler);
+extern J9_CFUNC intptr_t
+omrprofiler_drain(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, omrprofiler_sample_fn callback, void *userData);
+extern J9_CFUNC void
+omrprofiler_get_stats(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, OMRProfilerStats *stats);
+extern J9_CFUNC int32_t
+omrprofiler_symbolize(struct OMRPortLibrary *portLibrary, uintptr_t address, OMRProfilerSymbol *symbol);
+
 /* omrcuda */
 #if defined(OMR_OPT_CUDA)
 extern J9_CFUNC int32_t
@@ -117,6 +117,7 @@ ifneq (win,$(OMR_HOST_OS))
 endif
 
 OBJECTS += omrfile_blockingasync
+OBJECTS += omrfileasync
 
 ifeq (win,$(OMR_HOST_OS))
   OBJECTS += omrfilehelpers
@@ -130,6 +131,8 @@ OBJECTS += omrheap
 OBJECTS += omrmem
 OBJECTS += omrmemtag
 OBJECTS += omrmemcategories
+OBJECTS += omrmemsmallblock
+OBJECTS += omrmemtag_sampling
 OBJECTS += omrport
 OBJECTS += omrmmap
 OBJECTS += j9nls
@@ -138,6 +141,7 @@ OBJECTS += omrosbacktrace
 OBJECTS += omrosbacktrace_impl
 OBJECTS += omrintrospect
 OBJECTS += omrintrospect_common
+OBJECTS += omrprofiler
 OBJECTS += omrosdump
 OBJECTS += omrportcontrol
 OBJECTS += omrportptb
@@ -27,11 +27,15 @@
  */
 
 
+#include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #if defined(LINUX) && !defined(OMRZTPF)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
 #include <sys/vfs.h>
 #elif defined(OSX)
 #include <sys/param.h>
@@ -49,6 +53,7 @@
 #include "omrstdarg.h"
 #include "portnls.h"
 #include "ut_omrport.h"
+#include "omrfilehelpers.h"
 #include <sys/stat.h>
 
 #ifdef J9ZOS390
@@ -64,6 +69,18 @@ typedef struct statvfs PlatformStatfs;
 #endif /* defined(LINUX) || defined(OSX) */
 
 
+/* Buffers passed to one writev call by omrfile_writev */
+#if defined(IOV_MAX) && (IOV_MAX < 64)
+#define WRITEV_BATCH IOV_MAX
+#else /* defined(IOV_MAX) && (IOV_MAX < 64) */
+#define WRITEV_BATCH 64
+#endif /* defined(IOV_MAX) && (IOV_MAX < 64) */
+
+/* Size of the buffer used to copy file data when the kernel cannot do it directly */
+#define FILE_COPY_BUFFER_SIZE (64 * 1024)
+/* Largest single request to copy_file_range or sendfile */
+#define FILE_COPY_KERNEL_CHUNK ((int64_t)1 << 30)
+
 static const char *const fileFStatErrorMsgPrefix = "fstat : ";
 static const char *const fileFStatFSErrorMsgPrefix = "fstatfs : ";
 #if defined(AIXPPC) && !defined(J9OS_I5)
@@ -71,8 +88,8 @@ static const char *const fileFStatVFSErrorMsgPrefix = "fstatvfs : ";
 #endif /* defined(AIXPPC) && !defined(J9OS_I5) */
 
 static int32_t EsTranslateOpenFlags(int32_t flags);
+static int64_t copyThroughBuffer(struct OMRPortLibrary *portLibrary, int inFD, int64_t inOffset, int outFD, int64_t outOffset, int64_t length);
 static void setPortableError(OMRPortLibrary *portLibrary, const char *funcName, int32_t portlibErrno, int systemErrno);
-static int32_t findError(int32_t errorCode);
 #if (defined(LINUX) && !defined(OMRZTPF)) || defined(OSX) || (defined(AIXPPC) && !defined(J9OS_I5))
 static void updateJ9FileStat(struct OMRPortLibrary *portLibrary, J9FileStat *j9statBuf, struct stat *statBuf, PlatformStatfs *statfsBuf);
 #else /* (defined(LINUX) && !defined(OMRZTPF)) || defined(OSX) || (defined(AIXPPC) && !defined(J9OS_I5)) */
@@ -157,7 +174,7 @@ setPortableError(OMRPortLibrary *portLibrary, const char *funcName, int32_t port
  *
  * @return	the (negative) portable error code
  */
-static int32_t
+int32_t
 findError(int32_t errorCode)
 {
 	switch (errorCode) {
@@ -447,6 +464,286 @@ omrfile_write(struct OMRPortLibrary *portLibrary, intptr_t inFD, const void *buf
 	return rc;
 }
 
+/**
+ * Write the contents of several buffers to a file.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] fd File descriptor to write.
+ * @param[in] iov The buffers to be written.
+ * @param[in] iovCount The number of buffers.
+ *
+ * @return Number of bytes written on success, portable error return code (which is negative) on failure.
+ */
+intptr_t
+omrfile_writev(struct OMRPortLibrary *portLibrary, intptr_t inFD, const OMRIOVec *iov, uint32_t iovCount)
+{
+	int fd = (int)inFD;
+	intptr_t total = 0;
+	uint32_t done = 0;
+
+	Trc_PRT_file_writev_Entry(fd, iov, iovCount);
+
+#if defined(J9ZOS390)
+	if (fd < FD_BIAS) {
+		/* omrfile_write handles the standard streams specially */
+		for (done = 0; done < iovCount; done++) {
+			intptr_t rc = portLibrary->file_write(portLibrary, inFD, iov[done].base, (intptr_t)iov[done].length);
+			if (rc < 0) {
+				total = (0 == total) ? rc : total;
+				break;
+			}
+			total += rc;
+			if ((uintptr_t)rc != iov[done].length) {
+				break;
+			}
+		}
+		Trc_PRT_file_writev_Exit(total);
+		return total;
+	}
+#endif /* defined(J9ZOS390) */
+
+	while (done < iovCount) {
+		struct iovec vector[WRITEV_BATCH];
+		uint32_t count = OMR_MIN(iovCount - done, WRITEV_BATCH);
+		uintptr_t batchBytes = 0;
+		ssize_t rc = 0;
+		uint32_t i = 0;
+
+		for (i = 0; i < count; i++) {
+			vector[i].iov_base = iov[done + i].base;
+			vector[i].iov_len = iov[done + i].length;
+			batchBytes += iov[done + i].length;
+		}
+		/* Restart system calls interrupted by EINTR */
+		do {
+			rc = writev(fd - FD_BIAS, vector, (int)count);
+		} while ((-1 == rc) && (EINTR == errno));
+
+		if (-1 == rc) {
+			if (0 == total) {
+				total = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+			}
+			break;
+		}
+		total += rc;
+		done += count;
+		if ((uintptr_t)rc != batchBytes) {
+			break;
+		}
+	}
+
+	Trc_PRT_file_writev_Exit(total);
+	return total;
+}
+
+/**
+ * @internal
+ * Copy file data through a user space buffer, for when the kernel cannot copy
+ * between the two descriptors itself.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] inFD Native descriptor to read from with pread.
+ * @param[in] inOffset Offset of the first byte to read.
+ * @param[in] outFD Native descriptor to write to.
+ * @param[in] outOffset Offset at which to write the first byte, or -1 to write at the current position.
+ * @param[in] length Number of bytes to copy.
+ *
+ * @return Number of bytes copied, negative portable error code if nothing could be copied.
+ */
+static int64_t
+copyThroughBuffer(struct OMRPortLibrary *portLibrary, int inFD, int64_t inOffset, int outFD, int64_t outOffset, int64_t length)
+{
+	char localBuffer[512];
+	char *buffer = portLibrary->mem_allocate_memory(portLibrary, FILE_COPY_BUFFER_SIZE, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	size_t bufferSize = FILE_COPY_BUFFER_SIZE;
+	int64_t total = 0;
+
+	if (NULL == buffer) {
+		buffer = localBuffer;
+		bufferSize = sizeof(localBuffer);
+	}
+
+	while (total < length) {
+		size_t chunk = (size_t)OMR_MIN(length - total, (int64_t)bufferSize);
+		ssize_t readBytes = 0;
+		ssize_t written = 0;
+
+		do {
+			readBytes = pread(inFD, buffer, chunk, (off_t)(inOffset + total));
+		} while ((-1 == readBytes) && (EINTR == errno));
+		if (readBytes <= 0) {
+			if ((-1 == readBytes) && (0 == total)) {
+				total = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+			}
+			break;
+		}
+
+		while (written < readBytes) {
+			ssize_t rc = 0;
+			if (outOffset < 0) {
+				rc = write(outFD, buffer + written, readBytes - written);
+			} else {
+				rc = pwrite(outFD, buffer + written, readBytes - written, (off_t)(outOffset + total + written));
+			}
+			if (-1 == rc) {
+				if (EINTR == errno) {
+					continue;
+				}
+				if (0 == (total + written)) {
+					total = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+				} else {
+					total += written;
+				}
+				goto done;
+			}
+			written += rc;
+		}
+		total += readBytes;
+	}
+
+done:
+	if (localBuffer != buffer) {
+		portLibrary->mem_free_memory(portLibrary, buffer);
+	}
+	return total;
+}
+
+/**
+ * Copy a range of one file into another.
+ *
+ * On Linux copy_file_range is used, falling back to copying through a buffer
+ * when the kernel or file systems cannot do the copy.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] inFD File descriptor to copy from.
+ * @param[in] inOffset Offset in inFD of the first byte to copy.
+ * @param[in] outFD File descriptor to copy to.
+ * @param[in] outOffset Offset in outFD at which to store the first byte.
+ * @param[in] length Number of bytes to copy.
+ *
+ * @return Number of bytes copied, negative portable error code on failure.
+ */
+int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t inFD, int64_t inOffset, intptr_t outFD, int64_t outOffset, int64_t length)
+{
+	int in = (int)(inFD - FD_BIAS);
+	int out = (int)(outFD - FD_BIAS);
+	int64_t total = 0;
+	int64_t rc = 0;
+
+	Trc_PRT_file_copy_range_Entry(in, inOffset, out, outOffset, length);
+
+	if ((inOffset < 0) || (outOffset < 0) || (length < 0)) {
+		total = portLibrary->error_set_last_error(portLibrary, EINVAL, findError(EINVAL));
+		goto done;
+	}
+
+#if defined(LINUX) && defined(__NR_copy_file_range)
+	while (total < length) {
+		loff_t inPosition = (loff_t)(inOffset + total);
+		loff_t outPosition = (loff_t)(outOffset + total);
+
+		rc = (int64_t)syscall(__NR_copy_file_range, in, &inPosition, out, &outPosition, (size_t)OMR_MIN(length - total, FILE_COPY_KERNEL_CHUNK), 0);
+		if (rc > 0) {
+			total += rc;
+		} else if (0 == rc) {
+			/* end of file */
+			goto done;
+		} else if (EINTR == errno) {
+			continue;
+		} else if ((EXDEV == errno) || (EINVAL == errno) || (ENOSYS == errno) || (EOPNOTSUPP == errno)) {
+			/* the kernel cannot copy between these files, do it by hand */
+			break;
+		} else {
+			if (0 == total) {
+				total = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+			}
+			goto done;
+		}
+	}
+#endif /* defined(LINUX) && defined(__NR_copy_file_range) */
+
+	if (total < length) {
+		rc = copyThroughBuffer(portLibrary, in, inOffset + total, out, outOffset + total, length - total);
+		if (rc >= 0) {
+			total += rc;
+		} else if (0 == total) {
+			total = rc;
+		}
+	}
+
+done:
+	Trc_PRT_file_copy_range_Exit(total);
+	return total;
+}
+
+/**
+ * Write a range of one file to another file descriptor, which may refer to a socket or pipe.
+ *
+ * On Linux sendfile is used, falling back to copying through a buffer when the
+ * kernel cannot send from inFD.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] outFD File descriptor to write to, at its current position.
+ * @param[in] inFD File descriptor to read from.
+ * @param[in] inOffset Offset in inFD of the first byte to send.
+ * @param[in] length Number of bytes to send.
+ *
+ * @return Number of bytes sent, negative portable error code on failure.
+ */
+int64_t
+omrfile_sendfile(struct OMRPortLibrary *portLibrary, intptr_t outFD, intptr_t inFD, int64_t inOffset, int64_t length)
+{
+	int in = (int)(inFD - FD_BIAS);
+	int out = (int)(outFD - FD_BIAS);
+	int64_t total = 0;
+	int64_t rc = 0;
+
+	Trc_PRT_file_sendfile_Entry(out, in, inOffset, length);
+
+	if ((inOffset < 0) || (length < 0)) {
+		total = portLibrary->error_set_last_error(portLibrary, EINVAL, findError(EINVAL));
+		goto done;
+	}
+
+#if defined(LINUX) && !defined(OMRZTPF)
+	while (total < length) {
+		off_t position = (off_t)(inOffset + total);
+
+		rc = (int64_t)sendfile(out, in, &position, (size_t)OMR_MIN(length - total, FILE_COPY_KERNEL_CHUNK));
+		if (rc > 0) {
+			total += rc;
+		} else if (0 == rc) {
+			/* end of file */
+			goto done;
+		} else if (EINTR == errno) {
+			continue;
+		} else if ((EINVAL == errno) || (ENOSYS == errno)) {
+			/* inFD cannot be mapped, e.g. it is a pipe */
+			break;
+		} else {
+			if (0 == total) {
+				total = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+			}
+			goto done;
+		}
+	}
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+	if (total < length) {
+		rc = copyThroughBuffer(portLibrary, in, inOffset + total, out, -1, length - total);
+		if (rc >= 0) {
+			total += rc;
+		} else if (0 == total) {
+			total = rc;
+		}
+	}
+
+done:
+	Trc_PRT_file_sendfile_Exit(total);
+	return total;
+}
+
 
 
 /**
@@ -0,0 +1,769 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Asynchronous file I/O
+ */
+
+/*
+ * A queue is backed either by an io_uring instance, used through the raw system
+ * calls so that there is no dependency on liburing, or by a few worker threads
+ * doing positioned reads and writes. The thread pool is used where io_uring is
+ * not built in, where the kernel refuses to create a ring (older kernels,
+ * seccomp filters in containers), or when asked for with OMRPORT_FILE_ASYNC_USE_THREADS.
+ *
+ * Neither backend is thread safe on the submission and completion side: a queue
+ * is driven by one thread at a time.
+ */
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#if defined(LINUX) && !defined(OMRZTPF)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#if defined(IOSQE_IO_LINK)
+#define OMR_FILE_ASYNC_IO_URING
+#endif /* defined(IOSQE_IO_LINK) */
+#endif /* defined(__NR_io_uring_setup) */
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "omrutil.h"
+#include "omrutilbase.h"
+#include "ut_omrport.h"
+#include "omrfilehelpers.h"
+
+/* Upper bound on the number of worker threads of one queue */
+#define MAX_ASYNC_WORKERS 4
+
+#if defined(OMR_FILE_ASYNC_IO_URING)
+/* OMRIOVec arrays are handed to the kernel as struct iovec arrays */
+typedef char OMRIOVecMatchesIovec[((sizeof(OMRIOVec) == sizeof(struct iovec)) && (offsetof(OMRIOVec, length) == offsetof(struct iovec, iov_len))) ? 1 : -1];
+#endif /* defined(OMR_FILE_ASYNC_IO_URING) */
+
+typedef struct J9FileAsyncOp {
+	OMRFileAsyncRequest request;
+	BOOLEAN linked; /* the next op of the chain waits for this one */
+	intptr_t result;
+	struct J9FileAsyncOp *next; /* next op of the pending list, or of the free list */
+} J9FileAsyncOp;
+
+typedef struct OMRFileAsyncQueue {
+	struct OMRPortLibrary *portLibrary;
+	uint32_t backend;
+	uintptr_t depth;
+	uintptr_t outstanding; /* submitted but not yet returned by omrfile_async_complete */
+
+	/* Thread pool backend, all guarded by monitor */
+	omrthread_monitor_t monitor;
+	J9FileAsyncOp *ops;
+	J9FileAsyncOp *freeOps;
+	J9FileAsyncOp *pendingHead;
+	J9FileAsyncOp *pendingTail;
+	OMRFileAsyncCompletion *done; /* ring of depth finished operations */
+	uintptr_t doneHead;
+	uintptr_t doneCount;
+	uintptr_t liveWorkers;
+	BOOLEAN shutdown;
+
+#if defined(OMR_FILE_ASYNC_IO_URING)
+	/* io_uring backend */
+	int ringFD;
+	void *sqRing;
+	size_t sqRingSize;
+	void *cqRing;
+	size_t cqRingSize;
+	struct io_uring_sqe *sqes;
+	size_t sqesSize;
+	volatile uint32_t *sqHead;
+	volatile uint32_t *sqTail;
+	uint32_t sqMask;
+	uint32_t *sqArray;
+	volatile uint32_t *cqHead;
+	volatile uint32_t *cqTail;
+	uint32_t cqMask;
+	struct io_uring_cqe *cqes;
+#endif /* defined(OMR_FILE_ASYNC_IO_URING) */
+} OMRFileAsyncQueue;
+
+static intptr_t
+portableResult(int errorCode)
+{
+	if (ECANCELED == errorCode) {
+		return OMRPORT_ERROR_FILE_ASYNC_CANCELED;
+	}
+	return findError(errorCode);
+}
+
+/**
+ * @return TRUE if the op moved every byte it asked for, which is what lets a chain continue
+ */
+static BOOLEAN
+isComplete(OMRFileAsyncRequest *request, intptr_t result)
+{
+	if (OMRPORT_FILE_ASYNC_FSYNC == request->operation) {
+		return 0 == result;
+	} else {
+		uintptr_t expected = 0;
+		uint32_t i = 0;
+
+		for (i = 0; i < request->iovCount; i++) {
+			expected += request->iov[i].length;
+		}
+		return (result >= 0) && ((uintptr_t)result == expected);
+	}
+}
+
+/**
+ * Count the requests of the chain starting at requests[0], i.e. up to and
+ * including the first request which is not linked or the last one of the batch.
+ */
+static uintptr_t
+chainLength(OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	uintptr_t length = 1;
+
+	while ((length < count) && OMR_ARE_ANY_BITS_SET(requests[length - 1].flags, OMRPORT_FILE_ASYNC_LINK)) {
+		length += 1;
+	}
+	return length;
+}
+
+static BOOLEAN
+isValidRequest(OMRFileAsyncRequest *request)
+{
+	switch (request->operation) {
+	case OMRPORT_FILE_ASYNC_READV:
+		/* FALLTHROUGH */
+	case OMRPORT_FILE_ASYNC_WRITEV:
+		return (request->offset >= 0) && ((NULL != request->iov) || (0 == request->iovCount));
+	case OMRPORT_FILE_ASYNC_FSYNC:
+		return TRUE;
+	default:
+		return FALSE;
+	}
+}
+
+/**
+ * Perform a vectored read or write at the request offset one buffer at a time.
+ *
+ * @return the bytes transferred, which is short only at end of file or on an
+ * error after some bytes were transferred, or a negative portable error code.
+ */
+static intptr_t
+transferVector(OMRFileAsyncRequest *request)
+{
+	int fd = (int)(request->fd - FD_BIAS);
+	off_t offset = (off_t)request->offset;
+	intptr_t total = 0;
+	uint32_t i = 0;
+
+	for (i = 0; i < request->iovCount; i++) {
+		uint8_t *cursor = (uint8_t *)request->iov[i].base;
+		uintptr_t remaining = request->iov[i].length;
+
+		while (0 != remaining) {
+			ssize_t rc = 0;
+			if (OMRPORT_FILE_ASYNC_READV == request->operation) {
+				rc = pread(fd, cursor, remaining, offset);
+			} else {
+				rc = pwrite(fd, cursor, remaining, offset);
+			}
+			if (rc > 0) {
+				cursor += rc;
+				remaining -= rc;
+				offset += rc;
+				total += rc;
+			} else if (0 == rc) {
+				/* end of file */
+				return total;
+			} else if (EINTR != errno) {
+				return (0 == total) ? portableResult(errno) : total;
+			}
+		}
+	}
+	return total;
+}
+
+static intptr_t
+performOperation(OMRFileAsyncRequest *request)
+{
+	if (OMRPORT_FILE_ASYNC_FSYNC == request->operation) {
+		int rc = 0;
+		do {
+			rc = fsync((int)(request->fd - FD_BIAS));
+		} while ((-1 == rc) && (EINTR == errno));
+		return (0 == rc) ? 0 : portableResult(errno);
+	}
+	return transferVector(request);
+}
+
+static int J9THREAD_PROC
+asyncWorker(void *userData)
+{
+	OMRFileAsyncQueue *queue = (OMRFileAsyncQueue *)userData;
+
+	omrthread_set_name(omrthread_self(), "File Async Worker");
+
+	omrthread_monitor_enter(queue->monitor);
+	for (;;) {
+		J9FileAsyncOp *first = NULL;
+		J9FileAsyncOp *last = NULL;
+		J9FileAsyncOp *op = NULL;
+		BOOLEAN cancel = FALSE;
+
+		while ((NULL == queue->pendingHead) && !queue->shutdown) {
+			omrthread_monitor_wait(queue->monitor);
+		}
+		if (NULL == queue->pendingHead) {
+			/* shutting down and nothing left to do */
+			break;
+		}
+
+		/* A chain is run start to finish by one worker so that its ops stay ordered */
+		first = queue->pendingHead;
+		last = first;
+		while (last->linked) {
+			last = last->next;
+		}
+		queue->pendingHead = last->next;
+		if (NULL == queue->pendingHead) {
+			queue->pendingTail = NULL;
+		}
+		last->next = NULL;
+		omrthread_monitor_exit(queue->monitor);
+
+		for (op = first; NULL != op; op = op->next) {
+			if (cancel) {
+				op->result = OMRPORT_ERROR_FILE_ASYNC_CANCELED;
+			} else {
+				op->result = performOperation(&op->request);
+				if (op->linked && !isComplete(&op->request, op->result)) {
+					cancel = TRUE;
+				}
+			}
+		}
+
+		omrthread_monitor_enter(queue->monitor);
+		op = first;
+		while (NULL != op) {
+			J9FileAsyncOp *next = op->next;
+			OMRFileAsyncCompletion *completion = &queue->done[(queue->doneHead + queue->doneCount) % queue->depth];
+
+			completion->userData = op->request.userData;
+			completion->result = op->result;
+			queue->doneCount += 1;
+			op->next = queue->freeOps;
+			queue->freeOps = op;
+			op = next;
+		}
+		omrthread_monitor_notify_all(queue->monitor);
+	}
+	queue->liveWorkers -= 1;
+	omrthread_monitor_notify_all(queue->monitor);
+	omrthread_exit(queue->monitor);
+
+	/* unreachable */
+	return 0;
+}
+
+static void
+stopWorkers(OMRFileAsyncQueue *queue)
+{
+	omrthread_monitor_enter(queue->monitor);
+	queue->shutdown = TRUE;
+	omrthread_monitor_notify_all(queue->monitor);
+	while (0 != queue->liveWorkers) {
+		omrthread_monitor_wait(queue->monitor);
+	}
+	omrthread_monitor_exit(queue->monitor);
+}
+
+static int32_t
+startThreadPool(struct OMRPortLibrary *portLibrary, OMRFileAsyncQueue *queue)
+{
+	uintptr_t workers = OMR_MIN(queue->depth, MAX_ASYNC_WORKERS);
+	uintptr_t i = 0;
+
+	queue->ops = portLibrary->mem_allocate_memory(portLibrary, queue->depth * sizeof(J9FileAsyncOp), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	queue->done = portLibrary->mem_allocate_memory(portLibrary, queue->depth * sizeof(OMRFileAsyncCompletion), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if ((NULL == queue->ops) || (NULL == queue->done)) {
+		return OMRPORT_ERROR_FILE_OPFAILED;
+	}
+	for (i = 0; i < queue->depth; i++) {
+		queue->ops[i].next = queue->freeOps;
+		queue->freeOps = &queue->ops[i];
+	}
+	if (0 != omrthread_monitor_init_with_name(&queue->monitor, 0, "omrfile async queue")) {
+		return OMRPORT_ERROR_FILE_OPFAILED;
+	}
+	queue->backend = OMRPORT_FILE_ASYNC_BACKEND_THREADS;
+
+	for (i = 0; i < workers; i++) {
+		omrthread_t thread = NULL;
+		omrthread_monitor_enter(queue->monitor);
+		if (J9THREAD_SUCCESS != createThreadWithCategory(&thread, 256 * 1024, J9THREAD_PRIORITY_NORMAL, 0, &asyncWorker, queue, J9THREAD_CATEGORY_SYSTEM_THREAD)) {
+			omrthread_monitor_exit(queue->monitor);
+			break;
+		}
+		queue->liveWorkers += 1;
+		omrthread_monitor_exit(queue->monitor);
+	}
+	if (0 == i) {
+		return OMRPORT_ERROR_FILE_OPFAILED;
+	}
+	return 0;
+}
+
+static intptr_t
+submitToThreadPool(OMRFileAsyncQueue *queue, OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	uintptr_t accepted = 0;
+
+	omrthread_monitor_enter(queue->monitor);
+	while (accepted < count) {
+		uintptr_t length = chainLength(&requests[accepted], count - accepted);
+		uintptr_t i = 0;
+
+		if ((queue->outstanding + length) > queue->depth) {
+			break;
+		}
+		for (i = 0; i < length; i++) {
+			J9FileAsyncOp *op = queue->freeOps;
+
+			queue->freeOps = op->next;
+			op->request = requests[accepted + i];
+			op->linked = (i + 1) < length;
+			op->next = NULL;
+			if (NULL == queue->pendingTail) {
+				queue->pendingHead = op;
+			} else {
+				queue->pendingTail->next = op;
+			}
+			queue->pendingTail = op;
+		}
+		queue->outstanding += length;
+		accepted += length;
+	}
+	omrthread_monitor_notify_all(queue->monitor);
+	omrthread_monitor_exit(queue->monitor);
+
+	return accepted;
+}
+
+static intptr_t
+completeFromThreadPool(OMRFileAsyncQueue *queue, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	uintptr_t count = 0;
+	uintptr_t i = 0;
+
+	omrthread_monitor_enter(queue->monitor);
+	while (queue->doneCount < minCompletions) {
+		omrthread_monitor_wait(queue->monitor);
+	}
+	count = OMR_MIN(queue->doneCount, maxCompletions);
+	for (i = 0; i < count; i++) {
+		completions[i] = queue->done[queue->doneHead];
+		queue->doneHead = (queue->doneHead + 1) % queue->depth;
+	}
+	queue->doneCount -= count;
+	queue->outstanding -= count;
+	omrthread_monitor_exit(queue->monitor);
+
+	return count;
+}
+
+#if defined(OMR_FILE_ASYNC_IO_URING)
+static intptr_t completeFromRing(OMRFileAsyncQueue *queue, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions);
+
+static int
+ringEnter(OMRFileAsyncQueue *queue, uint32_t toSubmit, uint32_t minComplete, uint32_t flags)
+{
+	return (int)syscall(__NR_io_uring_enter, queue->ringFD, toSubmit, minComplete, flags, NULL, 0);
+}
+
+/**
+ * Create the io_uring instance for a queue and map its rings.
+ *
+ * @return TRUE on success, FALSE if io_uring cannot be used and the thread pool should be
+ */
+static BOOLEAN
+startRing(struct OMRPortLibrary *portLibrary, OMRFileAsyncQueue *queue)
+{
+	struct io_uring_params params;
+	uint8_t *sqRing = NULL;
+	uint8_t *cqRing = NULL;
+
+	memset(&params, 0, sizeof(params));
+	queue->ringFD = (int)syscall(__NR_io_uring_setup, (uint32_t)queue->depth, &params);
+	if (queue->ringFD < 0) {
+		Trc_PRT_file_async_io_uring_unavailable(errno);
+		return FALSE;
+	}
+
+	queue->sqRingSize = params.sq_off.array + (params.sq_entries * sizeof(uint32_t));
+	queue->cqRingSize = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+#if defined(IORING_FEAT_SINGLE_MMAP)
+	if (OMR_ARE_ANY_BITS_SET(params.features, IORING_FEAT_SINGLE_MMAP)) {
+		queue->sqRingSize = OMR_MAX(queue->sqRingSize, queue->cqRingSize);
+		queue->cqRingSize = 0;
+	}
+#endif /* defined(IORING_FEAT_SINGLE_MMAP) */
+
+	queue->sqRing = mmap(NULL, queue->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, queue->ringFD, IORING_OFF_SQ_RING);
+	if (MAP_FAILED == queue->sqRing) {
+		goto fail;
+	}
+	if (0 == queue->cqRingSize) {
+		queue->cqRing = queue->sqRing;
+	} else {
+		queue->cqRing = mmap(NULL, queue->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, queue->ringFD, IORING_OFF_CQ_RING);
+		if (MAP_FAILED == queue->cqRing) {
+			goto unmapSQ;
+		}
+	}
+	queue->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	queue->sqes = (struct io_uring_sqe *)mmap(NULL, queue->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, queue->ringFD, IORING_OFF_SQES);
+	if (MAP_FAILED == (void *)queue->sqes) {
+		goto unmapCQ;
+	}
+
+	sqRing = (uint8_t *)queue->sqRing;
+	cqRing = (uint8_t *)queue->cqRing;
+	queue->sqHead = (volatile uint32_t *)(sqRing + params.sq_off.head);
+	queue->sqTail = (volatile uint32_t *)(sqRing + params.sq_off.tail);
+	queue->sqMask = *(uint32_t *)(sqRing + params.sq_off.ring_mask);
+	queue->sqArray = (uint32_t *)(sqRing + params.sq_off.array);
+	queue->cqHead = (volatile uint32_t *)(cqRing + params.cq_off.head);
+	queue->cqTail = (volatile uint32_t *)(cqRing + params.cq_off.tail);
+	queue->cqMask = *(uint32_t *)(cqRing + params.cq_off.ring_mask);
+	queue->cqes = (struct io_uring_cqe *)(cqRing + params.cq_off.cqes);
+	queue->backend = OMRPORT_FILE_ASYNC_BACKEND_IO_URING;
+	return TRUE;
+
+unmapCQ:
+	if (queue->cqRing != queue->sqRing) {
+		munmap(queue->cqRing, queue->cqRingSize);
+	}
+unmapSQ:
+	munmap(queue->sqRing, queue->sqRingSize);
+fail:
+	Trc_PRT_file_async_io_uring_unavailable(errno);
+	close(queue->ringFD);
+	queue->ringFD = -1;
+	return FALSE;
+}
+
+static void
+stopRing(OMRFileAsyncQueue *queue)
+{
+	OMRFileAsyncCompletion discard[16];
+
+	/* The kernel still owns the buffers of outstanding operations */
+	while (0 != queue->outstanding) {
+		uintptr_t wanted = OMR_MIN(queue->outstanding, sizeof(discard) / sizeof(discard[0]));
+		if (completeFromRing(queue, discard, wanted, wanted) < 0) {
+			break;
+		}
+	}
+	munmap(queue->sqes, queue->sqesSize);
+	if (queue->cqRing != queue->sqRing) {
+		munmap(queue->cqRing, queue->cqRingSize);
+	}
+	munmap(queue->sqRing, queue->sqRingSize);
+	close(queue->ringFD);
+}
+
+static intptr_t
+submitToRing(OMRFileAsyncQueue *queue, OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	uint32_t tail = *queue->sqTail;
+	uintptr_t accepted = 0;
+
+	while (accepted < count) {
+		uintptr_t length = chainLength(&requests[accepted], count - accepted);
+		uintptr_t i = 0;
+
+		if ((queue->outstanding + length) > queue->depth) {
+			break;
+		}
+		for (i = 0; i < length; i++) {
+			OMRFileAsyncRequest *request = &requests[accepted + i];
+			uint32_t index = tail & queue->sqMask;
+			struct io_uring_sqe *sqe = &queue->sqes[index];
+
+			memset(sqe, 0, sizeof(*sqe));
+			switch (request->operation) {
+			case OMRPORT_FILE_ASYNC_READV:
+				sqe->opcode = IORING_OP_READV;
+				break;
+			case OMRPORT_FILE_ASYNC_WRITEV:
+				sqe->opcode = IORING_OP_WRITEV;
+				break;
+			default:
+				sqe->opcode = IORING_OP_FSYNC;
+				break;
+			}
+			sqe->fd = (int32_t)(request->fd - FD_BIAS);
+			if (IORING_OP_FSYNC != sqe->opcode) {
+				sqe->off = (uint64_t)request->offset;
+				sqe->addr = (uint64_t)(uintptr_t)request->iov;
+				sqe->len = request->iovCount;
+			}
+			sqe->user_data = (uint64_t)(uintptr_t)request->userData;
+			if ((i + 1) < length) {
+				sqe->flags = IOSQE_IO_LINK;
+			}
+			queue->sqArray[index] = index;
+			tail += 1;
+		}
+		queue->outstanding += length;
+		accepted += length;
+	}
+
+	/* Publish the entries before the tail, then let the kernel consume them. Anything
+	 * it cannot take right now stays in the ring and goes with the next enter.
+	 */
+	issueWriteBarrier();
+	*queue->sqTail = tail;
+	if (0 != accepted) {
+		ringEnter(queue, tail - *queue->sqHead, 0, 0);
+	}
+	return accepted;
+}
+
+static intptr_t
+completeFromRing(OMRFileAsyncQueue *queue, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	uintptr_t count = 0;
+
+	for (;;) {
+		uint32_t head = *queue->cqHead;
+		uint32_t tail = *queue->cqTail;
+
+		issueReadBarrier();
+		while ((head != tail) && (count < maxCompletions)) {
+			struct io_uring_cqe *cqe = &queue->cqes[head & queue->cqMask];
+
+			completions[count].userData = (void *)(uintptr_t)cqe->user_data;
+			completions[count].result = (cqe->res < 0) ? portableResult(-cqe->res) : (intptr_t)cqe->res;
+			count += 1;
+			head += 1;
+		}
+		/* Finish reading the entries before handing their slots back */
+		issueReadWriteBarrier();
+		*queue->cqHead = head;
+
+		if (count >= minCompletions) {
+			break;
+		}
+		if (ringEnter(queue, *queue->sqTail - *queue->sqHead, (uint32_t)(minCompletions - count), IORING_ENTER_GETEVENTS) < 0) {
+			if ((EINTR != errno) && (EAGAIN != errno) && (EBUSY != errno)) {
+				if (0 == count) {
+					return findError(errno);
+				}
+				break;
+			}
+		}
+	}
+	queue->outstanding -= count;
+	return count;
+}
+#endif /* defined(OMR_FILE_ASYNC_IO_URING) */
+
+static void
+freeQueue(struct OMRPortLibrary *portLibrary, OMRFileAsyncQueue *queue)
+{
+	if (NULL != queue->monitor) {
+		omrthread_monitor_destroy(queue->monitor);
+	}
+	portLibrary->mem_free_memory(portLibrary, queue->done);
+	portLibrary->mem_free_memory(portLibrary, queue->ops);
+	portLibrary->mem_free_memory(portLibrary, queue);
+}
+
+/**
+ * Create a queue for asynchronous file operations.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] depth The maximum number of operations submitted but not yet completed
+ * @param[in] flags 0, or OMRPORT_FILE_ASYNC_USE_THREADS to use the thread pool even if io_uring is available
+ * @param[out] queue The new queue
+ *
+ * @return 0 on success, a negative portable error code on failure.
+ */
+int32_t
+omrfile_async_create(struct OMRPortLibrary *portLibrary, uint32_t depth, uint32_t flags, struct OMRFileAsyncQueue **queue)
+{
+	OMRFileAsyncQueue *newQueue = NULL;
+	int32_t rc = 0;
+
+	Trc_PRT_file_async_create_Entry(depth, flags);
+
+	*queue = NULL;
+	if (0 == depth) {
+		rc = OMRPORT_ERROR_FILE_INVAL;
+		goto done;
+	}
+	newQueue = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRFileAsyncQueue), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == newQueue) {
+		rc = OMRPORT_ERROR_FILE_OPFAILED;
+		goto done;
+	}
+	memset(newQueue, 0, sizeof(OMRFileAsyncQueue));
+	newQueue->portLibrary = portLibrary;
+	newQueue->depth = depth;
+
+#if defined(OMR_FILE_ASYNC_IO_URING)
+	newQueue->ringFD = -1;
+	if (OMR_ARE_NO_BITS_SET(flags, OMRPORT_FILE_ASYNC_USE_THREADS) && startRing(portLibrary, newQueue)) {
+		*queue = newQueue;
+		goto done;
+	}
+#endif /* defined(OMR_FILE_ASYNC_IO_URING) */
+
+	rc = startThreadPool(portLibrary, newQueue);
+	if (0 == rc) {
+		*queue = newQueue;
+	} else {
+		if (0 != newQueue->liveWorkers) {
+			stopWorkers(newQueue);
+		}
+		freeQueue(portLibrary, newQueue);
+	}
+
+done:
+	Trc_PRT_file_async_create_Exit(rc, *queue, (NULL == *queue) ? 0 : (*queue)->backend);
+	return rc;
+}
+
+/**
+ * Destroy a queue, waiting for its outstanding operations to finish.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue, may be NULL
+ */
+void
+omrfile_async_destroy(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue)
+{
+	if (NULL != queue) {
+#if defined(OMR_FILE_ASYNC_IO_URING)
+		if (OMRPORT_FILE_ASYNC_BACKEND_IO_URING == queue->backend) {
+			stopRing(queue);
+		} else
+#endif /* defined(OMR_FILE_ASYNC_IO_URING) */
+		{
+			stopWorkers(queue);
+		}
+		freeQueue(portLibrary, queue);
+	}
+}
+
+/**
+ * Submit a batch of asynchronous file operations.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue
+ * @param[in] requests The requests, which are copied
+ * @param[in] count The number of requests
+ *
+ * @return the number of leading requests accepted, or a negative portable error code.
+ */
+intptr_t
+omrfile_async_submit(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	intptr_t rc = 0;
+	uintptr_t i = 0;
+
+	Trc_PRT_file_async_submit_Entry(queue, count);
+
+	for (i = 0; i < count; i++) {
+		if (!isValidRequest(&requests[i])) {
+			rc = OMRPORT_ERROR_FILE_INVAL;
+			goto done;
+		}
+	}
+	if ((0 != count) && (chainLength(requests, count) > queue->depth)) {
+		/* this chain could never be accepted */
+		rc = OMRPORT_ERROR_FILE_INVAL;
+		goto done;
+	}
+
+#if defined(OMR_FILE_ASYNC_IO_URING)
+	if (OMRPORT_FILE_ASYNC_BACKEND_IO_URING == queue->backend) {
+		rc = submitToRing(queue, requests, count);
+	} else
+#endif /* defined(OMR_FILE_ASYNC_IO_URING) */
+	{
+		rc = submitToThreadPool(queue, requests, count);
+	}
+
+done:
+	Trc_PRT_file_async_submit_Exit(rc);
+	return rc;
+}
+
+/**
+ * Collect the outcomes of finished asynchronous file operations.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue
+ * @param[out] completions Filled in with the outcomes
+ * @param[in] maxCompletions The number of entries in completions
+ * @param[in] minCompletions The number of completions to wait for, reduced to the number outstanding
+ *
+ * @return the number of completions filled in, or a negative portable error code.
+ */
+intptr_t
+omrfile_async_complete(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	minCompletions = OMR_MIN(minCompletions, OMR_MIN(maxCompletions, queue->outstanding));
+
+#if defined(OMR_FILE_ASYNC_IO_URING)
+	if (OMRPORT_FILE_ASYNC_BACKEND_IO_URING == queue->backend) {
+		return completeFromRing(queue, completions, maxCompletions, minCompletions);
+	}
+#endif /* defined(OMR_FILE_ASYNC_IO_URING) */
+	return completeFromThreadPool(queue, completions, maxCompletions, minCompletions);
+}
+
+/**
+ * Report how a queue performs its operations.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queue The queue
+ *
+ * @return OMRPORT_FILE_ASYNC_BACKEND_IO_URING or OMRPORT_FILE_ASYNC_BACKEND_THREADS
+ */
+uint32_t
+omrfile_async_backend(struct OMRPortLibrary *portLibrary, struct OMRFileAsyncQueue *queue)
+{
+	return queue->backend;
+}
@@ -41,7 +41,11 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
+#if defined(LINUX)
+#include <sys/vfs.h>
+#endif /* defined(LINUX) */
 
 #include "omrport.h"
 #include "omrportasserts.h"
@@ -55,6 +59,28 @@
 #include <sys/vminfo.h>
 #endif/*AIXPPC*/
 
+#if defined(LINUX)
+/* MADV_HUGEPAGE and MADV_POPULATE_READ are not defined in <sys/mman.h> on older distributions */
+#if !defined(MADV_HUGEPAGE)
+#define MADV_HUGEPAGE 14
+#endif /* !defined(MADV_HUGEPAGE) */
+#if !defined(MADV_POPULATE_READ)
+#define MADV_POPULATE_READ 22
+#endif /* !defined(MADV_POPULATE_READ) */
+#if !defined(HUGETLBFS_MAGIC)
+#define HUGETLBFS_MAGIC 0x958458f6
+#endif /* !defined(HUGETLBFS_MAGIC) */
+
+#define MMAP_THP_ENABLED_FNAME "/sys/kernel/mm/transparent_hugepage/enabled"
+#define MMAP_THP_SIZE_FNAME "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size"
+#define MMAP_THP_BUFFER_SIZE 128
+
+static uintptr_t readTransparentHugePageSize(struct OMRPortLibrary *portLibrary);
+static uintptr_t hugePageAlignment(struct OMRPortLibrary *portLibrary, intptr_t file, uintptr_t size);
+static void *mapAtHugePageBoundary(intptr_t file, uint64_t offset, uintptr_t size, int mmapProt, int mmapFlags, uintptr_t alignment);
+#endif /* defined(LINUX) */
+static void populateMapping(intptr_t file, uint64_t offset, void *address, uintptr_t size);
+
 /**
  * Map a part of file into memory.
  *
@@ -72,6 +98,10 @@
  * @args                                         OMRPORT_MMAP_FLAG_COPYONWRITE copy on write map
  * @args                                         OMRPORT_MMAP_FLAG_SHARED              share memory mapping with other processes
  * @args                                         OMRPORT_MMAP_FLAG_PRIVATE              private memory mapping, do not share with other processes (implied by OMRPORT_MMAP_FLAG_COPYONWRITE)
+ * @args                                         OMRPORT_MMAP_FLAG_POPULATE            fault the whole mapping in before returning
+ * @args                                         OMRPORT_MMAP_FLAG_HUGEPAGE            place the mapping on a huge page boundary and ask for it to be backed
+ *                                                         by huge pages.  This only takes effect where the filesystem supports huge pages
+ *                                                         for file data (hugetlbfs, or tmpfs and read-only file THP on Linux), and is otherwise ignored.
  * @param [in]  categoryCode     Memory allocation category code
  *
  * @return                       A J9MmapHandle struct or NULL is an error has occurred
@@ -87,6 +117,8 @@ omrmmap_map_file(struct OMRPortLibrary *portLibrary, intptr_t file, uint64_t off
 	char const *errMsg;
 	J9MmapHandle *returnVal;
 	OMRMemCategory *category = omrmem_get_category(portLibrary, categoryCode);
+	BOOLEAN populate = OMRPORT_MMAP_FLAG_POPULATE == (flags & OMRPORT_MMAP_FLAG_POPULATE);
+	uintptr_t alignment = 0;
 
 	Trc_PRT_mmap_map_file_unix_entered(file, offset, size, mappingName, flags);
 
@@ -152,14 +184,45 @@ omrmmap_map_file(struct OMRPortLibrary *portLibrary, intptr_t file, uint64_t off
 		return NULL;
 	}
 
+#if defined(LINUX)
+	if (OMRPORT_MMAP_FLAG_HUGEPAGE == (flags & OMRPORT_MMAP_FLAG_HUGEPAGE)) {
+		alignment = hugePageAlignment(portLibrary, file, size);
+	}
+#endif /* defined(LINUX) */
+#if defined(MAP_POPULATE)
+	/* Huge page advice must be given before the pages are faulted in, so those mappings are populated afterwards */
+	if (populate && (0 == alignment)) {
+		mmapFlags |= MAP_POPULATE;
+		populate = FALSE;
+	}
+#endif /* defined(MAP_POPULATE) */
+
 	/* Call mmap */
-	pointer = mmap(0, size, mmapProt, mmapFlags, file, offset);
+#if defined(LINUX)
+	if (0 != alignment) {
+		pointer = mapAtHugePageBoundary(file, offset, size, mmapProt, mmapFlags, alignment);
+	} else
+#endif /* defined(LINUX) */
+	{
+		pointer = mmap(0, size, mmapProt, mmapFlags, file, offset);
+	}
 	if (pointer == MAP_FAILED) {
 		portLibrary->mem_free_memory(portLibrary, returnVal);
 		Trc_PRT_mmap_map_file_unix_badMmap(errno);
 		portLibrary->error_set_last_error(portLibrary, errno, OMRPORT_ERROR_MMAP_MAP_FILE_MAPPINGFAILED);
 		return NULL;
 	}
+#if defined(LINUX)
+	if (0 != alignment) {
+		/* Only tmpfs and read-only file THP can back file data with transparent huge pages, elsewhere this is a no-op or EINVAL */
+		if (-1 == madvise(pointer, size, MADV_HUGEPAGE)) {
+			Trc_PRT_mmap_map_file_unix_hugepageAdviceFailed(pointer, size, errno);
+		}
+	}
+#endif /* defined(LINUX) */
+	if (populate) {
+		populateMapping(file, offset, pointer, size);
+	}
 
 	returnVal->category = category;
 	omrmem_categories_increment_counters(category, size);
@@ -279,6 +342,9 @@ omrmmap_shutdown(struct OMRPortLibrary *portLibrary)
 int32_t
 omrmmap_startup(struct OMRPortLibrary *portLibrary)
 {
+#if defined(LINUX)
+	PPG_mmap_hugePageSize = readTransparentHugePageSize(portLibrary);
+#endif /* defined(LINUX) */
 	return 0;
 }
 /**
@@ -290,14 +356,30 @@ omrmmap_startup(struct OMRPortLibrary *portLibrary)
  * @return a bit map containing the capabilites supported by the omrmmap sub component of the port library.
  * Possible bit values:
  *   OMRPORT_MMAP_CAPABILITY_COPYONWRITE - if not present, platform is not capable of "copy on write" memory mapping.
+ *   OMRPORT_MMAP_CAPABILITY_ADVISE - omrmmap_advise and omrmmap_prefetch are supported.
+ *   OMRPORT_MMAP_CAPABILITY_HUGEPAGE - transparent huge pages are enabled, so OMRPORT_MMAP_FLAG_HUGEPAGE and
+ *   OMRPORT_MMAP_ADVICE_HUGEPAGE can take effect.
  *
  */
 int32_t
 omrmmap_capabilities(struct OMRPortLibrary *portLibrary)
 {
-	return (OMRPORT_MMAP_CAPABILITY_COPYONWRITE
+	int32_t capabilities = 0;
+
+#if defined(LINUX)
+	if (0 != PPG_mmap_hugePageSize) {
+		capabilities |= OMRPORT_MMAP_CAPABILITY_HUGEPAGE;
+	}
+#endif /* defined(LINUX) */
+
+	return (capabilities
+			| OMRPORT_MMAP_CAPABILITY_COPYONWRITE
 			| OMRPORT_MMAP_CAPABILITY_READ
 			| OMRPORT_MMAP_CAPABILITY_PROTECT
+			| OMRPORT_MMAP_CAPABILITY_POPULATE
+#if defined(LINUX) || defined(OSX)
+			| OMRPORT_MMAP_CAPABILITY_ADVISE
+#endif /* defined(LINUX) || defined(OSX) */
 			/* If JSE platforms include WRITE and MSYNC - ZOS included, but currently has own omrmmap.c */
 #if ((defined(LINUX) && defined(J9X86)) \
   || (defined(LINUXPPC)) \
@@ -357,3 +439,234 @@ omrmmap_dont_need(struct OMRPortLibrary *portLibrary, const void *startAddress,
 		}
 	}
 }
+
+intptr_t
+omrmmap_advise(struct OMRPortLibrary *portLibrary, void *start, uintptr_t length, uint32_t advice)
+{
+	intptr_t rc = 0;
+#if defined(LINUX) || defined(OSX)
+	uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+	uintptr_t roundedStart = ROUND_DOWN_TO_POWEROF2((uintptr_t)start, pageSize);
+	uintptr_t roundedEnd = ROUND_UP_TO_POWEROF2((uintptr_t)start + length, pageSize);
+	int madviseAdvice = MADV_NORMAL;
+
+	Trc_PRT_mmap_advise_Entry(start, length, advice);
+
+	switch (advice) {
+	case OMRPORT_MMAP_ADVICE_NORMAL:
+		madviseAdvice = MADV_NORMAL;
+		break;
+	case OMRPORT_MMAP_ADVICE_SEQUENTIAL:
+		madviseAdvice = MADV_SEQUENTIAL;
+		break;
+	case OMRPORT_MMAP_ADVICE_RANDOM:
+		madviseAdvice = MADV_RANDOM;
+		break;
+	case OMRPORT_MMAP_ADVICE_WILLNEED:
+		madviseAdvice = MADV_WILLNEED;
+		break;
+	case OMRPORT_MMAP_ADVICE_HUGEPAGE:
+#if defined(LINUX)
+		madviseAdvice = MADV_HUGEPAGE;
+#else /* defined(LINUX) */
+		rc = OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+#endif /* defined(LINUX) */
+		break;
+	default:
+		rc = OMRPORT_ERROR_MMAP_ADVISE_INVALIDADVICE;
+		break;
+	}
+
+	if (0 != rc) {
+		portLibrary->error_set_last_error(portLibrary, -1, (int32_t)rc);
+	} else if (roundedEnd > roundedStart) {
+		if (-1 == madvise((void *)roundedStart, roundedEnd - roundedStart, madviseAdvice)) {
+			int savedErrno = errno;
+
+			/* EINVAL for MADV_HUGEPAGE means the kernel or the mapping cannot use transparent huge pages */
+			if ((OMRPORT_MMAP_ADVICE_HUGEPAGE == advice) && (EINVAL == savedErrno)) {
+				rc = OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+			} else {
+				rc = OMRPORT_ERROR_MMAP_ADVISE_FAILED;
+			}
+			portLibrary->error_set_last_error(portLibrary, savedErrno, (int32_t)rc);
+		}
+	}
+
+	Trc_PRT_mmap_advise_Exit(rc);
+#else /* defined(LINUX) || defined(OSX) */
+	/* madvise is not supported on AIX */
+	rc = OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+	portLibrary->error_set_last_error(portLibrary, -1, (int32_t)rc);
+#endif /* defined(LINUX) || defined(OSX) */
+	return rc;
+}
+
+/**
+ * The range is handed to the kernel as MADV_WILLNEED, which starts read ahead of the file
+ * data into the page cache and returns without waiting for the reads.
+ */
+intptr_t
+omrmmap_prefetch(struct OMRPortLibrary *portLibrary, J9MmapHandle *handle, uintptr_t offset, uintptr_t length)
+{
+	intptr_t rc = 0;
+
+	Trc_PRT_mmap_prefetch_Entry(handle, offset, length);
+
+	if ((NULL != handle) && (offset < handle->size)) {
+		uintptr_t available = handle->size - offset;
+
+		if ((0 == length) || (length > available)) {
+			length = available;
+		}
+		rc = portLibrary->mmap_advise(portLibrary, (uint8_t *)handle->pointer + offset, length, OMRPORT_MMAP_ADVICE_WILLNEED);
+	}
+
+	Trc_PRT_mmap_prefetch_Exit(rc);
+	return rc;
+}
+
+/**
+ * Fault in every page of a mapping, as MAP_POPULATE does when it is passed to mmap.
+ * Pages are touched by hand where MADV_POPULATE_READ is unavailable, stopping at the
+ * end of the file so that no SIGBUS is raised for a mapping that extends past it.
+ */
+static void
+populateMapping(intptr_t file, uint64_t offset, void *address, uintptr_t size)
+{
+	uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+	uintptr_t touchSize = size;
+	struct stat buf;
+
+#if defined(LINUX)
+	if (0 == madvise(address, size, MADV_POPULATE_READ)) {
+		return;
+	}
+#endif /* defined(LINUX) */
+
+	memset(&buf, 0, sizeof(struct stat));
+	if (0 == fstat(file - FD_BIAS, &buf)) {
+		uint64_t fileSize = (uint64_t)buf.st_size;
+
+		if (offset >= fileSize) {
+			touchSize = 0;
+		} else if ((fileSize - offset) < (uint64_t)touchSize) {
+			touchSize = (uintptr_t)(fileSize - offset);
+		}
+		{
+			volatile const uint8_t *cursor = (volatile const uint8_t *)address;
+			volatile const uint8_t *end = cursor + touchSize;
+
+			for (; cursor < end; cursor += pageSize) {
+				(void)*cursor;
+			}
+		}
+	}
+}
+
+#if defined(LINUX)
+/**
+ * Read the transparent huge page size, returning 0 if transparent huge pages are disabled.
+ */
+static uintptr_t
+readTransparentHugePageSize(struct OMRPortLibrary *portLibrary)
+{
+	char buffer[MMAP_THP_BUFFER_SIZE];
+	intptr_t fd = 0;
+	intptr_t bytesRead = 0;
+
+	fd = portLibrary->file_open(portLibrary, MMAP_THP_ENABLED_FNAME, EsOpenRead, 0);
+	if (fd < 0) {
+		return 0;
+	}
+	bytesRead = portLibrary->file_read(portLibrary, fd, buffer, sizeof(buffer) - 1);
+	portLibrary->file_close(portLibrary, fd);
+	if (bytesRead <= 0) {
+		return 0;
+	}
+	buffer[bytesRead] = '\0';
+	if (NULL != strstr(buffer, "[never]")) {
+		return 0;
+	}
+
+	fd = portLibrary->file_open(portLibrary, MMAP_THP_SIZE_FNAME, EsOpenRead, 0);
+	if (fd < 0) {
+		return 0;
+	}
+	bytesRead = portLibrary->file_read(portLibrary, fd, buffer, sizeof(buffer) - 1);
+	portLibrary->file_close(portLibrary, fd);
+	if (bytesRead <= 0) {
+		return 0;
+	}
+	buffer[bytesRead] = '\0';
+	return (uintptr_t)strtoul(buffer, NULL, 10);
+}
+
+/**
+ * Return the alignment an OMRPORT_MMAP_FLAG_HUGEPAGE mapping of file needs, or 0 if the mapping
+ * should be made normally: transparent huge pages are disabled, the mapping is smaller than a huge
+ * page, or the file is on hugetlbfs, where the kernel always uses huge pages and aligns the mapping itself.
+ */
+static uintptr_t
+hugePageAlignment(struct OMRPortLibrary *portLibrary, intptr_t file, uintptr_t size)
+{
+	uintptr_t alignment = PPG_mmap_hugePageSize;
+	struct statfs fsBuf;
+
+	if ((0 == alignment) || (size < alignment)) {
+		return 0;
+	}
+	memset(&fsBuf, 0, sizeof(struct statfs));
+	if ((0 == fstatfs(file, &fsBuf)) && (HUGETLBFS_MAGIC == (uint32_t)fsBuf.f_type)) {
+		return 0;
+	}
+	return alignment;
+}
+
+/**
+ * Map file so that the address and the file offset agree modulo alignment, which is needed for
+ * huge pages to back the file data.  An oversized PROT_NONE reservation is made first, the file
+ * is mapped over the aligned part of it and the unused head and tail are released.
+ */
+static void *
+mapAtHugePageBoundary(intptr_t file, uint64_t offset, uintptr_t size, int mmapProt, int mmapFlags, uintptr_t alignment)
+{
+	uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+	uintptr_t reserveSize = ROUND_UP_TO_POWEROF2(size + alignment, pageSize);
+	uintptr_t phase = (uintptr_t)(offset & (alignment - 1));
+	uintptr_t reserveStart = 0;
+	uintptr_t reserveEnd = 0;
+	uintptr_t start = 0;
+	uintptr_t end = 0;
+	void *reserved = mmap(NULL, reserveSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	void *pointer = NULL;
+
+	if (MAP_FAILED == reserved) {
+		return MAP_FAILED;
+	}
+	reserveStart = (uintptr_t)reserved;
+	reserveEnd = reserveStart + reserveSize;
+	start = ROUND_UP_TO_POWEROF2(reserveStart, alignment) + phase;
+	if ((start - alignment) >= reserveStart) {
+		start -= alignment;
+	}
+
+	pointer = mmap((void *)start, size, mmapProt, mmapFlags | MAP_FIXED, file, offset);
+	if (MAP_FAILED == pointer) {
+		int savedErrno = errno;
+
+		munmap(reserved, reserveSize);
+		errno = savedErrno;
+		return MAP_FAILED;
+	}
+
+	end = start + ROUND_UP_TO_POWEROF2(size, pageSize);
+	if (start > reserveStart) {
+		munmap(reserved, start - reserveStart);
+	}
+	if (reserveEnd > end) {
+		munmap((void *)end, reserveEnd - end);
+	}
+	return pointer;
+}
+#endif /* defined(LINUX) */
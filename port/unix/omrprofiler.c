@@ -0,0 +1,639 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Sampling profiler
+ *
+ * On Linux every registered thread owns a POSIX timer on its own CPU-time clock, delivered
+ * with SIGEV_THREAD_ID to that thread only. The timer's signal value carries the generation
+ * of the thread's registration, so the SIGPROF handler finds the thread's buffer without
+ * thread local storage, walks the frame pointer chain within the thread's stack bounds and
+ * appends a record. Each buffer is a single producer, single consumer ring: the handler
+ * only advances head and omrprofiler_drain only advances tail, so neither side takes a lock.
+ *
+ * Buffers are never unlinked while the profiler exists. A thread that unregisters leaves
+ * its buffer for the samples to be drained, and once empty it is reused by the next
+ * thread to register. Deleting a timer does not discard a signal it has already queued
+ * before Linux 6.13, so such a signal can arrive after its thread has unregistered. Every
+ * registration therefore gets a new generation, and unregistering clears the buffer's
+ * generation on the thread itself, so a late or stray SIGPROF matches no buffer and is
+ * ignored rather than written into a buffer that another thread has since taken over.
+ */
+
+#if defined(LINUX) && !defined(OMRZTPF)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif /* _GNU_SOURCE */
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#if defined(LINUX) || defined(OSX)
+#include <dlfcn.h>
+#endif /* defined(LINUX) || defined(OSX) */
+#if defined(LINUX) && !defined(OMRZTPF)
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "omrutilbase.h"
+#include "ut_omrport.h"
+
+/* Samples are only taken where walkFramePointers knows the interrupted registers */
+#if defined(LINUX) && !defined(OMRZTPF) && (defined(J9HAMMER) || defined(J9X86) || defined(AARCH64))
+#define OMRPROFILER_SAMPLING
+#endif /* defined(LINUX) && !defined(OMRZTPF) && (defined(J9HAMMER) || defined(J9X86) || defined(AARCH64)) */
+
+#if defined(OMRPROFILER_SAMPLING)
+
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif /* !defined(sigev_notify_thread_id) */
+
+/* Nested signals are dropped by the handler, but a shorter interval only adds overhead */
+#define OMRPROFILER_MIN_INTERVAL_NANOS 100000
+#define OMRPROFILER_MAX_FRAMES 1024
+
+typedef struct OMRProfilerRecord {
+	uint64_t timestamp;
+	uint32_t frameCount;
+	uint32_t flags;
+	uintptr_t frames[1];
+} OMRProfilerRecord;
+
+typedef struct OMRProfilerBuffer {
+	struct OMRProfilerBuffer *next;
+	volatile uintptr_t generation; /* Signal value of the registered thread's timer, 0 while unregistered */
+	uintptr_t threadId;
+	BOOLEAN registered;
+	timer_t timer;
+	uintptr_t stackLow;
+	uintptr_t stackHigh;
+	volatile uintptr_t head; /* Records written, advanced only by the signal handler */
+	volatile uintptr_t tail; /* Records consumed, advanced only by omrprofiler_drain */
+	volatile uintptr_t dropped; /* Written only by the signal handler */
+	volatile uintptr_t inHandler; /* Only accessed by the owning thread */
+	uint8_t *records;
+} OMRProfilerBuffer;
+
+typedef struct OMRProfiler {
+	struct OMRPortLibrary *portLibrary;
+	omrthread_monitor_t monitor;
+	OMRProfilerBuffer *volatile buffers; /* Only ever prepended to while the profiler exists */
+	void *previousHandler;
+	struct itimerspec interval;
+	uint32_t maxFrames;
+	uint32_t bufferSamples;
+	uintptr_t recordSize;
+	uint64_t drained;
+	uint32_t threads;
+	BOOLEAN running;
+} OMRProfiler;
+
+/* The profiler that owns SIGPROF, and the number of handler invocations in flight so that
+ * omrprofiler_destroy can wait for them before freeing the buffers.
+ */
+static OMRProfiler *volatile activeProfiler = NULL;
+static volatile uintptr_t handlersRunning = 0;
+/* The last generation given to a registration; never reused, so signals from old timers never match */
+static volatile uintptr_t lastGeneration = 0;
+
+/**
+ * @internal
+ * Walks the frame pointer chain of the interrupted context. Each frame record holds the
+ * caller's frame pointer followed by the return address, on x86 and on AArch64 alike.
+ * Frame pointers are only followed upwards within the thread's stack, so reading them
+ * cannot fault. When the stack bounds are unknown only the interrupted pc is recorded.
+ */
+static uint32_t
+walkFramePointers(OMRProfilerBuffer *buffer, ucontext_t *context, uintptr_t *frames, uint32_t maxFrames, uint32_t *flags)
+{
+	uintptr_t pc = 0;
+	uintptr_t fp = 0;
+	uintptr_t sp = 0;
+	uintptr_t low = buffer->stackLow;
+	uint32_t count = 0;
+#if defined(J9HAMMER)
+	struct sigcontext *registers = (struct sigcontext *)&context->uc_mcontext;
+	pc = (uintptr_t)registers->rip;
+	fp = (uintptr_t)registers->rbp;
+	sp = (uintptr_t)registers->rsp;
+#elif defined(J9X86)
+	struct sigcontext *registers = (struct sigcontext *)&context->uc_mcontext;
+	pc = (uintptr_t)registers->eip;
+	fp = (uintptr_t)registers->ebp;
+	sp = (uintptr_t)registers->esp;
+#elif defined(AARCH64)
+	struct sigcontext *registers = (struct sigcontext *)&context->uc_mcontext;
+	pc = (uintptr_t)registers->pc;
+	fp = (uintptr_t)registers->regs[29];
+	sp = (uintptr_t)registers->sp;
+#endif
+
+	*flags = 0;
+	if (0 == pc) {
+		return 0;
+	}
+	frames[count++] = pc;
+	if (0 == buffer->stackHigh) {
+		return count;
+	}
+
+	if ((sp > low) && (sp < buffer->stackHigh)) {
+		low = sp;
+	}
+	while ((fp >= low)
+		&& (fp <= (buffer->stackHigh - (2 * sizeof(uintptr_t))))
+		&& (0 == (fp & (sizeof(uintptr_t) - 1)))
+	) {
+		uintptr_t *record = (uintptr_t *)fp;
+		uintptr_t returnAddress = record[1];
+
+		if (0 == returnAddress) {
+			break;
+		}
+		if (count == maxFrames) {
+			*flags |= OMRPORT_PROFILER_SAMPLE_TRUNCATED;
+			break;
+		}
+		frames[count++] = returnAddress;
+		/* frames are strictly nested, which also guarantees the walk terminates */
+		if (record[0] <= fp) {
+			break;
+		}
+		fp = record[0];
+	}
+	return count;
+}
+
+/**
+ * @internal
+ * The SIGPROF handler. Only async-signal-safe operations are used: no locks, no allocation,
+ * and clock_gettime, which needs nothing from the port library.
+ */
+static void
+profilerSignalHandler(int signal, siginfo_t *sigInfo, void *contextInfo)
+{
+	int savedErrno = errno;
+	OMRProfiler *profiler = NULL;
+
+	addAtomic(&handlersRunning, 1);
+	profiler = activeProfiler;
+	if ((NULL != profiler) && (NULL != sigInfo) && (SI_TIMER == sigInfo->si_code)) {
+		OMRProfilerBuffer *buffer = profiler->buffers;
+		uintptr_t generation = (uintptr_t)sigInfo->si_value.sival_ptr;
+
+		while ((NULL != buffer) && ((0 == generation) || (generation != buffer->generation))) {
+			buffer = buffer->next;
+		}
+		if (NULL != buffer) {
+			uintptr_t head = buffer->head;
+
+			if ((0 != buffer->inHandler) || ((head - buffer->tail) >= profiler->bufferSamples)) {
+				buffer->dropped += 1;
+			} else {
+				OMRProfilerRecord *record = (OMRProfilerRecord *)(buffer->records + ((head % profiler->bufferSamples) * profiler->recordSize));
+				struct timespec now;
+
+				buffer->inHandler = 1;
+				clock_gettime(CLOCK_MONOTONIC, &now);
+				record->timestamp = ((uint64_t)now.tv_sec * 1000000000) + (uint64_t)now.tv_nsec;
+				record->frameCount = walkFramePointers(buffer, (ucontext_t *)contextInfo, record->frames, profiler->maxFrames, &record->flags);
+				/* publish the record before the new head */
+				issueWriteBarrier();
+				buffer->head = head + 1;
+				buffer->inHandler = 0;
+			}
+		}
+	}
+	subtractAtomic(&handlersRunning, 1);
+	errno = savedErrno;
+}
+
+/**
+ * @internal
+ * Arms or disarms a buffer's timer. Called with the profiler's monitor held.
+ */
+static int32_t
+setBufferTimer(OMRProfiler *profiler, OMRProfilerBuffer *buffer, BOOLEAN arm)
+{
+	struct itimerspec disarmed;
+	const struct itimerspec *value = &profiler->interval;
+
+	if (!arm) {
+		memset(&disarmed, 0, sizeof(disarmed));
+		value = &disarmed;
+	}
+	if (0 != timer_settime(buffer->timer, 0, value, NULL)) {
+		return OMRPORT_ERROR_OPFAILED;
+	}
+	return 0;
+}
+
+int32_t
+omrprofiler_create(struct OMRPortLibrary *portLibrary, uint64_t intervalNanos, uint32_t maxFrames, uint32_t bufferSamples, struct OMRProfiler **profiler)
+{
+	OMRProfiler *newProfiler = NULL;
+	int32_t rc = 0;
+
+	Trc_PRT_profiler_create_Entry(intervalNanos, maxFrames, bufferSamples);
+
+	*profiler = NULL;
+	if ((0 == maxFrames) || (0 == bufferSamples) || (maxFrames > OMRPROFILER_MAX_FRAMES)) {
+		rc = OMRPORT_ERROR_INVALID_ARGUMENTS;
+		goto done;
+	}
+	if (intervalNanos < OMRPROFILER_MIN_INTERVAL_NANOS) {
+		intervalNanos = OMRPROFILER_MIN_INTERVAL_NANOS;
+	}
+
+	newProfiler = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRProfiler), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == newProfiler) {
+		rc = OMRPORT_ERROR_SYSTEMFULL;
+		goto done;
+	}
+	memset(newProfiler, 0, sizeof(OMRProfiler));
+	newProfiler->portLibrary = portLibrary;
+	newProfiler->maxFrames = maxFrames;
+	newProfiler->bufferSamples = bufferSamples;
+	newProfiler->recordSize = offsetof(OMRProfilerRecord, frames) + (maxFrames * sizeof(uintptr_t));
+	newProfiler->recordSize = (newProfiler->recordSize + sizeof(uint64_t) - 1) & ~(uintptr_t)(sizeof(uint64_t) - 1);
+	newProfiler->interval.it_value.tv_sec = (time_t)(intervalNanos / 1000000000);
+	newProfiler->interval.it_value.tv_nsec = (long)(intervalNanos % 1000000000);
+	newProfiler->interval.it_interval = newProfiler->interval.it_value;
+
+	if (0 != omrthread_monitor_init_with_name(&newProfiler->monitor, 0, "omrprofiler")) {
+		portLibrary->mem_free_memory(portLibrary, newProfiler);
+		rc = OMRPORT_ERROR_SYSTEMFULL;
+		goto done;
+	}
+
+	/* SIGPROF has a single handler, so only one profiler may own it */
+	if (0 != compareAndSwapUDATA((uintptr_t *)&activeProfiler, 0, (uintptr_t)newProfiler)) {
+		rc = OMRPORT_ERROR_EXIST;
+	} else if (0 != portLibrary->sig_register_os_handler(portLibrary, OMRPORT_SIG_FLAG_SIGPROF, (void *)profilerSignalHandler, &newProfiler->previousHandler)) {
+		activeProfiler = NULL;
+		rc = OMRPORT_ERROR_OPFAILED;
+	}
+	if (0 != rc) {
+		omrthread_monitor_destroy(newProfiler->monitor);
+		portLibrary->mem_free_memory(portLibrary, newProfiler);
+		goto done;
+	}
+
+	*profiler = newProfiler;
+done:
+	Trc_PRT_profiler_create_Exit(rc, *profiler);
+	return rc;
+}
+
+void
+omrprofiler_destroy(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	OMRProfilerBuffer *buffer = NULL;
+
+	if (NULL == profiler) {
+		return;
+	}
+	Trc_PRT_profiler_destroy_Entry(profiler);
+
+	omrthread_monitor_enter(profiler->monitor);
+	for (buffer = profiler->buffers; NULL != buffer; buffer = buffer->next) {
+		if (buffer->registered) {
+			/* a signal the timer has already queued may still be delivered (before Linux 6.13) */
+			timer_delete(buffer->timer);
+			buffer->registered = FALSE;
+		}
+	}
+	profiler->running = FALSE;
+	omrthread_monitor_exit(profiler->monitor);
+
+	/* Stop new handler invocations from using the profiler, then wait for those already running */
+	activeProfiler = NULL;
+	issueReadWriteBarrier();
+	while (0 != handlersRunning) {
+		omrthread_yield();
+	}
+	if ((void *)SIG_DFL == profiler->previousHandler) {
+		/* the default action would terminate the process on a SIGPROF still queued by a deleted timer */
+		portLibrary->sig_register_os_handler(portLibrary, OMRPORT_SIG_FLAG_SIGPROF, (void *)SIG_IGN, NULL);
+	} else {
+		portLibrary->sig_register_os_handler(portLibrary, OMRPORT_SIG_FLAG_SIGPROF, profiler->previousHandler, NULL);
+	}
+
+	buffer = profiler->buffers;
+	while (NULL != buffer) {
+		OMRProfilerBuffer *next = buffer->next;
+		portLibrary->mem_free_memory(portLibrary, buffer->records);
+		portLibrary->mem_free_memory(portLibrary, buffer);
+		buffer = next;
+	}
+	omrthread_monitor_destroy(profiler->monitor);
+	portLibrary->mem_free_memory(portLibrary, profiler);
+
+	Trc_PRT_profiler_destroy_Exit();
+}
+
+int32_t
+omrprofiler_register_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	uintptr_t threadId = (uintptr_t)syscall(SYS_gettid);
+	OMRProfilerBuffer *buffer = NULL;
+	OMRProfilerBuffer *reusable = NULL;
+	uintptr_t generation = 0;
+	struct sigevent event;
+	pthread_attr_t attr;
+	int32_t rc = 0;
+
+	omrthread_monitor_enter(profiler->monitor);
+	for (buffer = profiler->buffers; NULL != buffer; buffer = buffer->next) {
+		if (buffer->registered && (threadId == buffer->threadId)) {
+			rc = OMRPORT_ERROR_EXIST;
+			goto done;
+		}
+		if (!buffer->registered && (buffer->head == buffer->tail) && (NULL == reusable)) {
+			reusable = buffer;
+		}
+	}
+
+	buffer = reusable;
+	if (NULL == buffer) {
+		buffer = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRProfilerBuffer), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == buffer) {
+			rc = OMRPORT_ERROR_SYSTEMFULL;
+			goto done;
+		}
+		memset(buffer, 0, sizeof(OMRProfilerBuffer));
+		buffer->records = portLibrary->mem_allocate_memory(portLibrary, profiler->bufferSamples * profiler->recordSize, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == buffer->records) {
+			portLibrary->mem_free_memory(portLibrary, buffer);
+			rc = OMRPORT_ERROR_SYSTEMFULL;
+			goto done;
+		}
+	}
+
+	buffer->threadId = threadId;
+	buffer->stackLow = 0;
+	buffer->stackHigh = 0;
+	if (0 == pthread_getattr_np(pthread_self(), &attr)) {
+		void *stackAddress = NULL;
+		size_t stackSize = 0;
+
+		if (0 == pthread_attr_getstack(&attr, &stackAddress, &stackSize)) {
+			buffer->stackLow = (uintptr_t)stackAddress;
+			buffer->stackHigh = (uintptr_t)stackAddress + stackSize;
+		}
+		pthread_attr_destroy(&attr);
+	}
+
+	/* The thread's own CPU-time clock, signalling only this thread */
+	generation = addAtomic(&lastGeneration, 1);
+	memset(&event, 0, sizeof(event));
+	event.sigev_notify = SIGEV_THREAD_ID;
+	event.sigev_signo = SIGPROF;
+	event.sigev_value.sival_ptr = (void *)generation;
+	event.sigev_notify_thread_id = (pid_t)threadId;
+	if (0 != timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &buffer->timer)) {
+		if (buffer != reusable) {
+			portLibrary->mem_free_memory(portLibrary, buffer->records);
+			portLibrary->mem_free_memory(portLibrary, buffer);
+		}
+		rc = portLibrary->error_set_last_error(portLibrary, errno, OMRPORT_ERROR_OPFAILED);
+		goto done;
+	}
+	buffer->generation = generation;
+	buffer->registered = TRUE;
+	profiler->threads += 1;
+
+	if (buffer != reusable) {
+		buffer->next = profiler->buffers;
+		/* the handler may walk the list at any time, so the buffer must be complete first */
+		issueWriteBarrier();
+		profiler->buffers = buffer;
+	}
+	if (profiler->running) {
+		rc = setBufferTimer(profiler, buffer, TRUE);
+	}
+
+done:
+	omrthread_monitor_exit(profiler->monitor);
+	Trc_PRT_profiler_register_thread(profiler, threadId, rc);
+	return rc;
+}
+
+int32_t
+omrprofiler_unregister_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	uintptr_t threadId = (uintptr_t)syscall(SYS_gettid);
+	OMRProfilerBuffer *buffer = NULL;
+	int32_t rc = OMRPORT_ERROR_NOTFOUND;
+
+	omrthread_monitor_enter(profiler->monitor);
+	for (buffer = profiler->buffers; NULL != buffer; buffer = buffer->next) {
+		if (buffer->registered && (threadId == buffer->threadId)) {
+			timer_delete(buffer->timer);
+			/* A signal the timer has already queued may still be delivered (before Linux 6.13). It can
+			 * only interrupt this thread, so once the generation is cleared here no such signal can reach
+			 * the buffer, even after another thread has reused it.
+			 */
+			buffer->generation = 0;
+			buffer->registered = FALSE;
+			profiler->threads -= 1;
+			rc = 0;
+			break;
+		}
+	}
+	omrthread_monitor_exit(profiler->monitor);
+
+	Trc_PRT_profiler_unregister_thread(profiler, threadId, rc);
+	return rc;
+}
+
+/**
+ * @internal
+ * Arms or disarms the timers of all registered threads.
+ */
+static int32_t
+setProfilerRunning(OMRProfiler *profiler, BOOLEAN running)
+{
+	OMRProfilerBuffer *buffer = NULL;
+	int32_t rc = 0;
+
+	omrthread_monitor_enter(profiler->monitor);
+	profiler->running = running;
+	for (buffer = profiler->buffers; NULL != buffer; buffer = buffer->next) {
+		if (buffer->registered) {
+			int32_t timerRC = setBufferTimer(profiler, buffer, running);
+			if (0 == rc) {
+				rc = timerRC;
+			}
+		}
+	}
+	omrthread_monitor_exit(profiler->monitor);
+	return rc;
+}
+
+int32_t
+omrprofiler_start(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return setProfilerRunning(profiler, TRUE);
+}
+
+int32_t
+omrprofiler_stop(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return setProfilerRunning(profiler, FALSE);
+}
+
+intptr_t
+omrprofiler_drain(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, omrprofiler_sample_fn callback, void *userData)
+{
+	OMRProfilerBuffer *buffer = NULL;
+	intptr_t count = 0;
+
+	omrthread_monitor_enter(profiler->monitor);
+	for (buffer = profiler->buffers; NULL != buffer; buffer = buffer->next) {
+		uintptr_t head = buffer->head;
+		uintptr_t tail = buffer->tail;
+
+		/* read the records only after the head that published them */
+		issueReadBarrier();
+		while (tail != head) {
+			OMRProfilerRecord *record = (OMRProfilerRecord *)(buffer->records + ((tail % profiler->bufferSamples) * profiler->recordSize));
+			OMRProfilerSample sample;
+
+			sample.timestamp = record->timestamp;
+			sample.threadId = buffer->threadId;
+			sample.frames = record->frames;
+			sample.frameCount = record->frameCount;
+			sample.flags = record->flags;
+			callback(portLibrary, &sample, userData);
+
+			tail += 1;
+			/* the record may be overwritten as soon as the handler sees the new tail */
+			issueReadWriteBarrier();
+			buffer->tail = tail;
+			count += 1;
+		}
+	}
+	profiler->drained += count;
+	omrthread_monitor_exit(profiler->monitor);
+
+	return count;
+}
+
+void
+omrprofiler_get_stats(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, OMRProfilerStats *stats)
+{
+	OMRProfilerBuffer *buffer = NULL;
+
+	memset(stats, 0, sizeof(OMRProfilerStats));
+	omrthread_monitor_enter(profiler->monitor);
+	for (buffer = profiler->buffers; NULL != buffer; buffer = buffer->next) {
+		stats->recorded += buffer->head;
+		stats->dropped += buffer->dropped;
+	}
+	stats->drained = profiler->drained;
+	stats->threads = profiler->threads;
+	omrthread_monitor_exit(profiler->monitor);
+}
+
+#else /* defined(OMRPROFILER_SAMPLING) */
+
+int32_t
+omrprofiler_create(struct OMRPortLibrary *portLibrary, uint64_t intervalNanos, uint32_t maxFrames, uint32_t bufferSamples, struct OMRProfiler **profiler)
+{
+	*profiler = NULL;
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+void
+omrprofiler_destroy(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+}
+
+int32_t
+omrprofiler_register_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+int32_t
+omrprofiler_unregister_thread(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+int32_t
+omrprofiler_start(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+int32_t
+omrprofiler_stop(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+intptr_t
+omrprofiler_drain(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, omrprofiler_sample_fn callback, void *userData)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+void
+omrprofiler_get_stats(struct OMRPortLibrary *portLibrary, struct OMRProfiler *profiler, OMRProfilerStats *stats)
+{
+	memset(stats, 0, sizeof(OMRProfilerStats));
+}
+
+#endif /* defined(OMRPROFILER_SAMPLING) */
+
+int32_t
+omrprofiler_symbolize(struct OMRPortLibrary *portLibrary, uintptr_t address, OMRProfilerSymbol *symbol)
+{
+	int32_t rc = OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+#if defined(LINUX) || defined(OSX)
+	Dl_info info;
+
+	memset(&info, 0, sizeof(info));
+	rc = OMRPORT_ERROR_NOTFOUND;
+	if (0 != dladdr((void *)address, &info)) {
+		symbol->moduleName = info.dli_fname;
+		symbol->moduleOffset = (NULL != info.dli_fbase) ? (address - (uintptr_t)info.dli_fbase) : 0;
+		symbol->symbolName = info.dli_sname;
+		symbol->symbolOffset = (NULL != info.dli_saddr) ? (address - (uintptr_t)info.dli_saddr) : 0;
+		return 0;
+	}
+#endif /* defined(LINUX) || defined(OSX) */
+	memset(symbol, 0, sizeof(OMRProfilerSymbol));
+	return rc;
+}
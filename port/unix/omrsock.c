@@ -0,0 +1,1671 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Sockets
+ */
+
+#include "omrcfg.h"
+#if defined(OMR_PORT_SOCKET_SUPPORT)
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#if defined(LINUX)
+#include <linux/errqueue.h>
+#include <sys/epoll.h>
+#endif /* defined(LINUX) */
+#include <poll.h>
+
+#include "omrport.h"
+#include "omrporterror.h"
+#include "omrportpriv.h"
+#include "omrportptb.h"
+#include "omrportsock.h"
+#include "omrsockptypes.h"
+#include "ut_omrport.h"
+
+#if defined(LINUX)
+#define OMRSOCK_USE_EPOLL
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define OMRSOCK_USE_ZEROCOPY
+#endif /* defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY) */
+#endif /* defined(LINUX) */
+
+#if defined(MSG_NOSIGNAL)
+#define OMRSOCK_SEND_FLAGS MSG_NOSIGNAL
+#else /* defined(MSG_NOSIGNAL) */
+#define OMRSOCK_SEND_FLAGS 0
+#endif /* defined(MSG_NOSIGNAL) */
+
+/* Buffers passed to one sendmsg call */
+#if defined(IOV_MAX) && (IOV_MAX < 64)
+#define OMRSOCK_SENDMSG_MAX_IOV IOV_MAX
+#else /* defined(IOV_MAX) && (IOV_MAX < 64) */
+#define OMRSOCK_SENDMSG_MAX_IOV 64
+#endif /* defined(IOV_MAX) && (IOV_MAX < 64) */
+
+/* Zero-copy sends smaller than this cost more in page pinning and completion handling than the copy they save */
+#define OMRSOCK_ZEROCOPY_THRESHOLD (10 * 1024)
+
+/**
+ * @internal
+ * A timer started by omrsock_poll_timer_start.
+ */
+typedef struct OMRSockPollTimer {
+	int64_t deadline; /**< omrtime_nano_time of the next expiry */
+	int64_t interval; /**< time between expiries, 0 for a one-shot timer */
+	void *userData; /**< returned with the event */
+	uint32_t heapIndex; /**< position in OMRSockPoll.timers */
+} OMRSockPollTimer;
+
+/**
+ * @internal
+ * A poll set created by omrsock_poll_create.
+ */
+typedef struct OMRSockPoll {
+#if defined(OMRSOCK_USE_EPOLL)
+	int epollFD; /**< the epoll instance */
+	struct epoll_event *osEvents; /**< buffer for epoll_wait */
+	uint32_t osEventCapacity; /**< entries in osEvents */
+#else /* defined(OMRSOCK_USE_EPOLL) */
+	MUTEX lock; /**< guards the registered sockets, which may be changed while another thread waits */
+	struct pollfd *fds; /**< registered sockets */
+	void **userData; /**< userData of each registered socket */
+	uint32_t count; /**< number of registered sockets */
+	uint32_t capacity; /**< entries in fds and userData */
+	struct pollfd *waitFDs; /**< copy of fds passed to poll */
+	void **waitUserData; /**< copy of userData matching waitFDs */
+	uint32_t waitCapacity; /**< entries in waitFDs and waitUserData */
+#endif /* defined(OMRSOCK_USE_EPOLL) */
+	OMRSockPollTimer **timers; /**< binary min-heap of started timers, ordered by deadline */
+	uint32_t timerCount; /**< number of started timers */
+	uint32_t timerCapacity; /**< entries in timers */
+} OMRSockPoll;
+
+static int32_t findSocketError(int32_t errorCode);
+static int32_t setSocketError(struct OMRPortLibrary *portLibrary, int32_t errorCode);
+static int mapFamilyToOS(int32_t family);
+static int32_t mapFamilyFromOS(int family);
+static int mapSocktypeToOS(int32_t socktype);
+static int32_t mapSocktypeFromOS(int socktype);
+static int mapProtocolToOS(int32_t protocol);
+static int32_t mapProtocolFromOS(int protocol);
+static omr_os_addrinfo *getAddrInfoAt(omrsock_addrinfo_t handle, int32_t index);
+static socklen_t getAddressLength(omrsock_sockaddr_t addr);
+static int32_t wrapSocket(struct OMRPortLibrary *portLibrary, int fd, omrsock_socket_t *sock);
+#if defined(OMRSOCK_USE_ZEROCOPY)
+static int32_t waitForZeroCopy(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint32_t sequence);
+#endif /* defined(OMRSOCK_USE_ZEROCOPY) */
+static void timerHeapSwap(omrsock_poll_t pollSet, uint32_t a, uint32_t b);
+static void timerHeapUp(omrsock_poll_t pollSet, uint32_t index);
+static void timerHeapDown(omrsock_poll_t pollSet, uint32_t index);
+static void timerHeapRemove(omrsock_poll_t pollSet, uint32_t index);
+static uint32_t collectExpiredTimers(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, OMRSockPollEvent *events, uint32_t maxEvents, int64_t now);
+static int computeWaitMillis(omrsock_poll_t pollSet, int64_t timeoutNanos, int64_t start, int64_t now);
+
+/**
+ * @internal
+ * Determines the proper portable error code to return given a native error code.
+ *
+ * @param[in] errorCode The errno set by a socket call.
+ *
+ * @return the (negative) portable error code.
+ */
+static int32_t
+findSocketError(int32_t errorCode)
+{
+	switch (errorCode) {
+	case EBADF:
+		return OMRPORT_ERROR_SOCKET_BAD_DESCRIPTOR;
+	case EINVAL:
+	case EFAULT:
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	case ENOBUFS:
+	case ENOMEM:
+		return OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+	case EMFILE:
+	case ENFILE:
+		return OMRPORT_ERROR_SOCKET_SYSTEM_FULL;
+	case EADDRINUSE:
+		return OMRPORT_ERROR_SOCKET_ADDRESS_IN_USE;
+	case EADDRNOTAVAIL:
+		return OMRPORT_ERROR_SOCKET_ADDRESS_NOT_AVAILABLE;
+	case ECONNREFUSED:
+		return OMRPORT_ERROR_SOCKET_CONNECTION_REFUSED;
+	case ECONNRESET:
+	case ECONNABORTED:
+	case EPIPE:
+		return OMRPORT_ERROR_SOCKET_CONNECTION_RESET;
+	case ENOTCONN:
+		return OMRPORT_ERROR_SOCKET_NOT_CONNECTED;
+	case ETIMEDOUT:
+		return OMRPORT_ERROR_SOCKET_TIMEOUT;
+#if defined(EWOULDBLOCK) && (EWOULDBLOCK != EAGAIN)
+	case EWOULDBLOCK:
+#endif /* defined(EWOULDBLOCK) && (EWOULDBLOCK != EAGAIN) */
+	case EAGAIN:
+		return OMRPORT_ERROR_SOCKET_WOULDBLOCK;
+	case EINPROGRESS:
+	case EALREADY:
+		return OMRPORT_ERROR_SOCKET_IN_PROGRESS;
+	case EINTR:
+		return OMRPORT_ERROR_SOCKET_INTERRUPTED;
+	case EAFNOSUPPORT:
+		return OMRPORT_ERROR_SOCKET_FAMILY_NOT_SUPPORTED;
+	case EOPNOTSUPP:
+	case EPROTONOSUPPORT:
+	case EPROTOTYPE:
+		return OMRPORT_ERROR_SOCKET_OPERATION_NOT_SUPPORTED;
+	case ENOTSOCK:
+		return OMRPORT_ERROR_SOCKET_NOT_SOCKET;
+	case EACCES:
+	case EPERM:
+		return OMRPORT_ERROR_SOCKET_NO_PERMISSION;
+	case EEXIST:
+		return OMRPORT_ERROR_SOCKET_ALREADY_REGISTERED;
+	case ENOENT:
+		return OMRPORT_ERROR_SOCKET_NOT_REGISTERED;
+	default:
+		return OMRPORT_ERROR_SOCKET_UNKNOWN_ERROR;
+	}
+}
+
+/**
+ * @internal
+ * Records a failed socket call as the last error.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] errorCode The errno set by the call.
+ *
+ * @return the (negative) portable error code.
+ */
+static int32_t
+setSocketError(struct OMRPortLibrary *portLibrary, int32_t errorCode)
+{
+	return portLibrary->error_set_last_error(portLibrary, errorCode, findSocketError(errorCode));
+}
+
+static int
+mapFamilyToOS(int32_t family)
+{
+	switch (family) {
+	case OMRSOCK_AF_UNSPEC:
+		return AF_UNSPEC;
+	case OMRSOCK_AF_INET:
+		return AF_INET;
+	case OMRSOCK_AF_INET6:
+		return AF_INET6;
+	default:
+		return -1;
+	}
+}
+
+static int32_t
+mapFamilyFromOS(int family)
+{
+	switch (family) {
+	case AF_INET:
+		return OMRSOCK_AF_INET;
+	case AF_INET6:
+		return OMRSOCK_AF_INET6;
+	default:
+		return OMRSOCK_AF_UNSPEC;
+	}
+}
+
+static int
+mapSocktypeToOS(int32_t socktype)
+{
+	switch (socktype) {
+	case 0:
+		return 0;
+	case OMRSOCK_STREAM:
+		return SOCK_STREAM;
+	case OMRSOCK_DGRAM:
+		return SOCK_DGRAM;
+	default:
+		return -1;
+	}
+}
+
+static int32_t
+mapSocktypeFromOS(int socktype)
+{
+	switch (socktype) {
+	case SOCK_STREAM:
+		return OMRSOCK_STREAM;
+	case SOCK_DGRAM:
+		return OMRSOCK_DGRAM;
+	default:
+		return 0;
+	}
+}
+
+static int
+mapProtocolToOS(int32_t protocol)
+{
+	switch (protocol) {
+	case OMRSOCK_IPPROTO_DEFAULT:
+		return 0;
+	case OMRSOCK_IPPROTO_TCP:
+		return IPPROTO_TCP;
+	case OMRSOCK_IPPROTO_UDP:
+		return IPPROTO_UDP;
+	default:
+		return -1;
+	}
+}
+
+static int32_t
+mapProtocolFromOS(int protocol)
+{
+	switch (protocol) {
+	case IPPROTO_TCP:
+		return OMRSOCK_IPPROTO_TCP;
+	case IPPROTO_UDP:
+		return OMRSOCK_IPPROTO_UDP;
+	default:
+		return OMRSOCK_IPPROTO_DEFAULT;
+	}
+}
+
+/**
+ * @internal
+ * Answers the entry at index in a getaddrinfo result, or NULL if there is none.
+ */
+static omr_os_addrinfo *
+getAddrInfoAt(omrsock_addrinfo_t handle, int32_t index)
+{
+	omr_os_addrinfo *info = NULL;
+
+	if ((NULL != handle) && (index >= 0) && ((uint32_t)index < handle->length)) {
+		info = (omr_os_addrinfo *)handle->addrInfo;
+		while ((index > 0) && (NULL != info)) {
+			info = info->ai_next;
+			index -= 1;
+		}
+	}
+	return info;
+}
+
+/**
+ * @internal
+ * Answers the length of the native address held in addr.
+ */
+static socklen_t
+getAddressLength(omrsock_sockaddr_t addr)
+{
+	switch (((omr_os_sockaddr_storage *)addr)->ss_family) {
+	case AF_INET:
+		return sizeof(struct sockaddr_in);
+	case AF_INET6:
+		return sizeof(struct sockaddr_in6);
+	default:
+		return sizeof(omr_os_sockaddr_storage);
+	}
+}
+
+/**
+ * @internal
+ * Allocates the handle for a new native socket, closing the socket on failure.
+ */
+static int32_t
+wrapSocket(struct OMRPortLibrary *portLibrary, int fd, omrsock_socket_t *sock)
+{
+	omrsock_socket_t newSocket = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRSocket), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+
+	if (NULL == newSocket) {
+		close(fd);
+		return OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+	}
+	fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+#if defined(SO_NOSIGPIPE)
+	{
+		/* platforms without MSG_NOSIGNAL suppress SIGPIPE per socket */
+		int on = 1;
+		setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+	}
+#endif /* defined(SO_NOSIGPIPE) */
+	memset(newSocket, 0, sizeof(OMRSocket));
+	newSocket->data = fd;
+	*sock = newSocket;
+	return 0;
+}
+
+#if defined(OMRSOCK_USE_ZEROCOPY)
+/**
+ * @internal
+ * Waits until the kernel reports that it has released the buffers of a zero-copy send.
+ *
+ * Completions arrive on the socket error queue as ranges of send sequence numbers.
+ * Since each zero-copy send waits for its own completion, the range reported next
+ * always covers it. Only blocking sockets wait here, see @ref omrsock_sendmsg.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket.
+ * @param[in] sequence The sequence number of the send.
+ *
+ * @return 0 on success, otherwise return an error.
+ */
+static int32_t
+waitForZeroCopy(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint32_t sequence)
+{
+	for (;;) {
+		char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(omr_os_sockaddr_storage))];
+		struct msghdr msg;
+		struct cmsghdr *cmsg = NULL;
+
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+		if (-1 == recvmsg(sock->data, &msg, MSG_ERRQUEUE | MSG_DONTWAIT)) {
+			if ((EAGAIN == errno) || (EWOULDBLOCK == errno)) {
+				/* POLLERR is reported once the error queue is not empty */
+				struct pollfd pollFD;
+				pollFD.fd = sock->data;
+				pollFD.events = 0;
+				pollFD.revents = 0;
+				poll(&pollFD, 1, -1);
+				continue;
+			}
+			if (EINTR == errno) {
+				continue;
+			}
+			return setSocketError(portLibrary, errno);
+		}
+
+		for (cmsg = CMSG_FIRSTHDR(&msg); NULL != cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+			if (((SOL_IP == cmsg->cmsg_level) && (IP_RECVERR == cmsg->cmsg_type))
+				|| ((SOL_IPV6 == cmsg->cmsg_level) && (IPV6_RECVERR == cmsg->cmsg_type))
+			) {
+				struct sock_extended_err *error = (struct sock_extended_err *)CMSG_DATA(cmsg);
+				/* ee_data is the last completed sequence number, compare with wrap-around */
+				if ((SO_EE_ORIGIN_ZEROCOPY == error->ee_origin) && ((int32_t)(error->ee_data - sequence) >= 0)) {
+					return 0;
+				}
+			}
+		}
+	}
+}
+#endif /* defined(OMRSOCK_USE_ZEROCOPY) */
+
+static void
+timerHeapSwap(omrsock_poll_t pollSet, uint32_t a, uint32_t b)
+{
+	OMRSockPollTimer *timer = pollSet->timers[a];
+
+	pollSet->timers[a] = pollSet->timers[b];
+	pollSet->timers[b] = timer;
+	pollSet->timers[a]->heapIndex = a;
+	pollSet->timers[b]->heapIndex = b;
+}
+
+static void
+timerHeapUp(omrsock_poll_t pollSet, uint32_t index)
+{
+	while (index > 0) {
+		uint32_t parent = (index - 1) / 2;
+		if (pollSet->timers[parent]->deadline <= pollSet->timers[index]->deadline) {
+			break;
+		}
+		timerHeapSwap(pollSet, parent, index);
+		index = parent;
+	}
+}
+
+static void
+timerHeapDown(omrsock_poll_t pollSet, uint32_t index)
+{
+	for (;;) {
+		uint32_t smallest = index;
+		uint32_t left = (2 * index) + 1;
+		uint32_t right = left + 1;
+
+		if ((left < pollSet->timerCount) && (pollSet->timers[left]->deadline < pollSet->timers[smallest]->deadline)) {
+			smallest = left;
+		}
+		if ((right < pollSet->timerCount) && (pollSet->timers[right]->deadline < pollSet->timers[smallest]->deadline)) {
+			smallest = right;
+		}
+		if (smallest == index) {
+			break;
+		}
+		timerHeapSwap(pollSet, smallest, index);
+		index = smallest;
+	}
+}
+
+static void
+timerHeapRemove(omrsock_poll_t pollSet, uint32_t index)
+{
+	pollSet->timerCount -= 1;
+	if (index != pollSet->timerCount) {
+		timerHeapSwap(pollSet, index, pollSet->timerCount);
+		timerHeapDown(pollSet, index);
+		timerHeapUp(pollSet, index);
+	}
+}
+
+/**
+ * @internal
+ * Reports expired timers, rescheduling periodic ones and freeing one-shot ones.
+ *
+ * @return the number of events stored.
+ */
+static uint32_t
+collectExpiredTimers(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, OMRSockPollEvent *events, uint32_t maxEvents, int64_t now)
+{
+	uint32_t count = 0;
+
+	while ((count < maxEvents) && (pollSet->timerCount > 0) && (pollSet->timers[0]->deadline <= now)) {
+		OMRSockPollTimer *timer = pollSet->timers[0];
+
+		events[count].userData = timer->userData;
+		events[count].events = OMRSOCK_POLLTIMER;
+		count += 1;
+
+		if (0 != timer->interval) {
+			timer->deadline += timer->interval;
+			if (timer->deadline <= now) {
+				/* expiries missed while nobody waited are not reported */
+				timer->deadline = now + timer->interval;
+			}
+			timerHeapDown(pollSet, 0);
+		} else {
+			timerHeapRemove(pollSet, 0);
+			portLibrary->mem_free_memory(portLibrary, timer);
+		}
+	}
+	return count;
+}
+
+/**
+ * @internal
+ * Answers the milliseconds to wait in the system call, rounded up so timers are never
+ * reported early, or -1 to wait indefinitely.
+ */
+static int
+computeWaitMillis(omrsock_poll_t pollSet, int64_t timeoutNanos, int64_t start, int64_t now)
+{
+	int64_t remaining = -1;
+
+	if (timeoutNanos >= 0) {
+		remaining = OMR_MAX(start + timeoutNanos - now, 0);
+	}
+	if (pollSet->timerCount > 0) {
+		int64_t untilTimer = OMR_MAX(pollSet->timers[0]->deadline - now, 0);
+		if ((remaining < 0) || (untilTimer < remaining)) {
+			remaining = untilTimer;
+		}
+	}
+	if (remaining < 0) {
+		return -1;
+	}
+	return (int)OMR_MIN((remaining + 999999) / 1000000, INT_MAX);
+}
+
+/**
+ * Returns hints as a double pointer to an OMRAddInfoNode structure.
+ * 
+ * This hints structure is used to modify the results returned by a call to 
+ * @ref omrsock_getaddrinfo. 
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] hints The filled-in hints structure.
+ * @param[in] family Address family type.
+ * @param[in] socktype Socket type.
+ * @param[in] protocol Protocol family.
+ * @param[in] flags Flags for modifying the result. Pass multiple flags using the 
+ * bitwise-OR operation.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getaddrinfo_create_hints(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t *hints, int32_t family, int32_t socktype, int32_t protocol, int32_t flags)
+{
+	PortlibPTBuffers_t ptBuffers = NULL;
+	omr_os_addrinfo *osHints = NULL;
+	int osFamily = mapFamilyToOS(family);
+	int osSocktype = mapSocktypeToOS(socktype);
+	int osProtocol = mapProtocolToOS(protocol);
+
+	if ((NULL == hints) || (osFamily < 0) || (osSocktype < 0) || (osProtocol < 0)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	ptBuffers = omrport_tls_get(portLibrary);
+	if (NULL == ptBuffers) {
+		return OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+	}
+
+	osHints = &ptBuffers->addrInfoHintsData;
+	memset(osHints, 0, sizeof(omr_os_addrinfo));
+	osHints->ai_family = osFamily;
+	osHints->ai_socktype = osSocktype;
+	osHints->ai_protocol = osProtocol;
+	if (OMR_ARE_ANY_BITS_SET(flags, OMRSOCK_AI_PASSIVE)) {
+		osHints->ai_flags |= AI_PASSIVE;
+	}
+	if (OMR_ARE_ANY_BITS_SET(flags, OMRSOCK_AI_NUMERICHOST)) {
+		osHints->ai_flags |= AI_NUMERICHOST;
+	}
+	if (OMR_ARE_ANY_BITS_SET(flags, OMRSOCK_AI_NUMERICSERV)) {
+		osHints->ai_flags |= AI_NUMERICSERV;
+	}
+
+	ptBuffers->addrInfoHints.addrInfo = osHints;
+	ptBuffers->addrInfoHints.length = 1;
+	*hints = &ptBuffers->addrInfoHints;
+	return 0;
+}
+
+/**
+ * Answers a list of addresses as an opaque struct in "result".
+ * 
+ * Use the following functions to extract the details:
+ * @arg @ref omrsock_getaddrinfo_length
+ * @arg @ref omrsock_getaddrinfo_family
+ * @arg @ref omrsock_getaddrinfo_socktype
+ * @arg @ref omrsock_getaddrinfo_protocol
+ * @param[in] portLibrary The port library.
+ * @param[in] node The name of the host in either host name format or in IPv4 or IPv6 accepted 
+ * notations.
+ * @param[in] service The port of the host in string form.
+ * @param[in] hints Hints on what results are returned (can be NULL for default action). Use 
+ * @ref omrsock_getaddrinfo_create_hints to create the hints.
+ * @param[out] result An opaque pointer to a list of results (OMRAddrInfoNode must be preallocated).
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ *
+ * @note Must free the "result" structure with @ref omrsock_freeaddrinfo to free up memory.
+ */
+int32_t
+omrsock_getaddrinfo(struct OMRPortLibrary *portLibrary, char *node, char *service, omrsock_addrinfo_t hints, omrsock_addrinfo_t result)
+{
+	omr_os_addrinfo *osHints = NULL;
+	omr_os_addrinfo *list = NULL;
+	omr_os_addrinfo *info = NULL;
+	uint32_t length = 0;
+	int rc = 0;
+
+	if (NULL == result) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	memset(result, 0, sizeof(OMRAddrInfoNode));
+	if (NULL != hints) {
+		osHints = (omr_os_addrinfo *)hints->addrInfo;
+	}
+
+	rc = getaddrinfo(node, service, osHints, &list);
+	if (0 != rc) {
+		if (EAI_SYSTEM == rc) {
+			return setSocketError(portLibrary, errno);
+		}
+		return portLibrary->error_set_last_error_with_message(portLibrary, OMRPORT_ERROR_SOCKET_ADDRINFO_FAILED, gai_strerror(rc));
+	}
+
+	for (info = list; NULL != info; info = info->ai_next) {
+		length += 1;
+	}
+	result->addrInfo = list;
+	result->length = length;
+	return 0;
+}
+
+/**
+ * Answers the number of results returned from @ref omrsock_getaddrinfo.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handle The result structure returned by @ref omrsock_getaddrinfo.
+ * @param[out] length The number of results.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getaddrinfo_length(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t hints, uint32_t *length)
+{
+	if ((NULL == hints) || (NULL == length)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	*length = hints->length;
+	return 0;
+}
+
+/**
+ * Answers the family type of the address at "index" in the structure returned from 
+ * @ref omrsock_getaddrinfo, indexed starting at 0.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handle The result structure returned by @ref omrsock_getaddrinfo.
+ * @param[out] family The family at "index".
+ * @param[in] index The index into the structure returned by @ref omrsock_getaddrinfo.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getaddrinfo_family(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle, int32_t *family, int32_t index)
+{
+	omr_os_addrinfo *info = getAddrInfoAt(handle, index);
+
+	if ((NULL == info) || (NULL == family)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	*family = mapFamilyFromOS(info->ai_family);
+	return 0;
+}
+
+/**
+ * Answers the socket type of the address at "index" in the structure returned from 
+ * @ref omrsock_getaddrinfo, indexed starting at 0.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handle The result structure returned by @ref omrsock_getaddrinfo.
+ * @param[out] socktype The socket type at "index".
+ * @param[in] index The index into the structure returned by @ref omrsock_getaddrinfo.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getaddrinfo_socktype(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle, int32_t *socktype, int32_t index)
+{
+	omr_os_addrinfo *info = getAddrInfoAt(handle, index);
+
+	if ((NULL == info) || (NULL == socktype)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	*socktype = mapSocktypeFromOS(info->ai_socktype);
+	return 0;
+}
+
+/**
+ * Answers the protocol of the address at "index" in the structure returned from 
+ * @ref omrsock_getaddrinfo, indexed starting at 0.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handle The result structure returned by @ref omrsock_getaddrinfo.
+ * @param[out] protocol The protocol family at "index".
+ * @param[in] index The index into the structure returned by @ref omrsock_getaddrinfo.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getaddrinfo_protocol(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle, int32_t *protocol, int32_t index)
+{
+	omr_os_addrinfo *info = getAddrInfoAt(handle, index);
+
+	if ((NULL == info) || (NULL == protocol)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	*protocol = mapProtocolFromOS(info->ai_protocol);
+	return 0;
+}
+
+/**
+ * Frees the memory created by the call to @ref omrsock_getaddrinfo.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handle Pointer to results returned by @ref omrsock_getaddrinfo.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_freeaddrinfo(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle)
+{
+	if (NULL == handle) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	if (NULL != handle->addrInfo) {
+		freeaddrinfo((omr_os_addrinfo *)handle->addrInfo);
+	}
+	handle->addrInfo = NULL;
+	handle->length = 0;
+	return 0;
+}
+
+/**
+ * Creates a new socket descriptor and any related resources.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] sock Pointer to the omrsocket, to be allocated.
+ * @param[in] family The address family.
+ * @param[in] socktype Specifies what type of socket is created, for example stream
+ * or datagram.
+ * @param[in] protocol The Protocol family.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_socket(struct OMRPortLibrary *portLibrary, omrsock_socket_t *sock, int32_t family, int32_t socktype, int32_t protocol)
+{
+	int osFamily = mapFamilyToOS(family);
+	int osSocktype = mapSocktypeToOS(socktype);
+	int osProtocol = mapProtocolToOS(protocol);
+	int fd = -1;
+
+	if ((NULL == sock) || (osFamily < 0) || (osSocktype <= 0) || (osProtocol < 0)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	fd = socket(osFamily, osSocktype, osProtocol);
+	if (-1 == fd) {
+		return setSocketError(portLibrary, errno);
+	}
+	return wrapSocket(portLibrary, fd, sock);
+}
+
+/**
+ * Used on an unconnected socket before subsequent calls to 
+ * the @ref omrsock_connect or @ref omrsock_listen functions. When a socket is created 
+ * with a call to @ref omrsock_socket, it exists in a name space (address family), but 
+ * it has no name assigned to it. Use omrsock_bind to establish the local association 
+ * of the socket by assigning a local name to an unnamed socket.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket that will be be associated with the specified name.
+ * @param[in] addr Address to bind to socket.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_bind(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, omrsock_sockaddr_t addr)
+{
+	if (-1 == bind(sock->data, (struct sockaddr *)addr, getAddressLength(addr))) {
+		return setSocketError(portLibrary, errno);
+	}
+	return 0;
+}
+
+/**
+ * Set the socket to listen for incoming connection requests. This call is made prior to 
+ * accepting requests, via the @ref omrsock_accept function. The backlog specifies the 
+ * maximum length of the queue of pending connections, after which further requests are 
+ * rejected.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock Pointer to the socket.
+ * @param[in] backlog The maximum number of queued requests.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_listen(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, int32_t backlog)
+{
+	if (-1 == listen(sock->data, backlog)) {
+		return setSocketError(portLibrary, errno);
+	}
+	return 0;
+}
+
+/**
+ * Establish a connection to a peer.
+ *
+ * For stream sockets, it first binds the socket if it hasn't already been done. Then, it
+ * tries to set up a connection.
+ * 
+ * For datagram sockets, omrsock_connect function will set up the peer information. No actual
+ * connection is made. Subsequent calls to connect can be made to change destination address.
+ *
+ * It is not recommended that users call this function multiple times to determine when the 
+ * connection attempt has succeeded. Instead, a poll set, see @ref omrsock_poll_create, can be used to 
+ * determine when the socket is ready for reading or writing.
+ * 
+ * @param[in] portLibrary The port library.
+ * @param[in] sock Pointer to the unconnected local socket.
+ * @param[in] addr Pointer to the sockaddr, specifying remote host/port.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_connect(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, omrsock_sockaddr_t addr)
+{
+	if (-1 == connect(sock->data, (struct sockaddr *)addr, getAddressLength(addr))) {
+		return setSocketError(portLibrary, errno);
+	}
+	return 0;
+}
+
+/**
+ * Extracts the first connection on the queue of pending connections on socket serverSock. 
+ * It then creates a new socket and returns a handle to the new socket. The newly created 
+ * socket is the socket that will handle the actual the connection and has the same 
+ * properties as the socket serverSock.  
+ *
+ * The omrsock_accept function can block the caller until a connection is present if no pending 
+ * connections are present on the queue.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] serverSock An omrsock_socket_t that tries to accept a connection.
+ * @param[in] addrHandle An optional pointer to a buffer that receives the address of the 
+ * connecting entity, as known to the communications layer. The exact format of the addr 
+ * parameter is determined by the address family established when the socket was created.
+ * @param[out] sockHandle A pointer to an omrsock_socket_t which will point to the newly created 
+ * socket once accept returns successfully.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_accept(struct OMRPortLibrary *portLibrary, omrsock_socket_t serverSock, omrsock_sockaddr_t addrHandle, omrsock_socket_t *sockHandle)
+{
+	socklen_t addrLength = sizeof(OMRSockAddrStorage);
+	int fd = -1;
+
+	if (NULL == sockHandle) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	do {
+		fd = accept(serverSock->data, (struct sockaddr *)addrHandle, (NULL == addrHandle) ? NULL : &addrLength);
+	} while ((-1 == fd) && (EINTR == errno));
+	if (-1 == fd) {
+		return setSocketError(portLibrary, errno);
+	}
+	return wrapSocket(portLibrary, fd, sockHandle);
+}
+
+/**
+ * Sends data to a connected socket. The successful completion of an omrsock_send does 
+ * not indicate that the data was successfully delivered. If no buffer space is available 
+ * within the transport system to hold the data to be transmitted, omrsock_send will block.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock Pointer to the socket to send on.
+ * @param[in] buf The bytes to be sent.
+ * @param[in] nbyte The number of bytes to send.
+ * @param[in] flags The flags to modify the send behavior.
+ *
+ * @return the total number of bytes sent if no error occured, which can be less than the 
+ * 'nbyte' for nonblocking sockets, otherwise return an error.
+ */
+int32_t
+omrsock_send(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint8_t *buf, int32_t nbyte, int32_t flags)
+{
+	ssize_t rc = 0;
+
+	do {
+		rc = send(sock->data, buf, (size_t)nbyte, OMRSOCK_SEND_FLAGS);
+	} while ((-1 == rc) && (EINTR == errno));
+	if (-1 == rc) {
+		return setSocketError(portLibrary, errno);
+	}
+	return (int32_t)rc;
+}
+
+/**
+ * Sends data to a datagram socket. The successful completion of an omrsock_sento does 
+ * not indicate that the data was successfully delivered. If no buffer space is available 
+ * within the transport system to hold the data to be transmitted, omrsock_sendto will block.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock Pointer to the socket to send on.
+ * @param[in] buf The bytes to be sent.
+ * @param[in] nbyte The number of bytes to send.
+ * @param[in] flags The flags to modify the send behavior.
+ * @param[in] addrHandle The network address to send the datagram to.
+ *
+ * @return the total number of bytes sent if no error occured, otherwise return an error.
+ */
+int32_t
+omrsock_sendto(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint8_t *buf, int32_t nbyte, int32_t flags, omrsock_sockaddr_t addrHandle)
+{
+	ssize_t rc = 0;
+
+	do {
+		rc = sendto(sock->data, buf, (size_t)nbyte, OMRSOCK_SEND_FLAGS, (struct sockaddr *)addrHandle, getAddressLength(addrHandle));
+	} while ((-1 == rc) && (EINTR == errno));
+	if (-1 == rc) {
+		return setSocketError(portLibrary, errno);
+	}
+	return (int32_t)rc;
+}
+
+/**
+ * Receives data from a connected socket.  
+ * 
+ * This will return available information up to the size of the buffer supplied. 
+ * 
+ * Its behavior will depend on the blocking characteristic of the socket.
+ * Blocking socket: If no incoming data is available, the call blocks and waits for data to arrive. 
+ * Non-blocking socket: If no incoming data is available, the call fails with OMRPORT_ERROR_SOCKET_WOULDBLOCK.
+ * 
+ * @param[in] portLibrary The port library.
+ * @param[in] sock Pointer to the socket to read on.
+ * @param[out] buf Pointer to the buffer where input bytes are written.
+ * @param[in] nbyte The length of buf.
+ * @param[in] flags The flags, to influence this read (in addition to the socket options).
+ *
+ * @return the number of bytes received if no error occured. If the connection has been 
+ * gracefully closed, return 0. Otherwise, return an error.
+ */
+int32_t
+omrsock_recv(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint8_t *buf, int32_t nbyte, int32_t flags)
+{
+	ssize_t rc = 0;
+
+	do {
+		rc = recv(sock->data, buf, (size_t)nbyte, 0);
+	} while ((-1 == rc) && (EINTR == errno));
+	if (-1 == rc) {
+		return setSocketError(portLibrary, errno);
+	}
+	return (int32_t)rc;
+}
+
+/**
+ * Receives data from a possibly connected socket. 
+ * 
+ * Calling omrsock_recvfrom will return available information up to the size of the buffer 
+ * supplied. If the information is too large for the buffer, the excess will be discarded. 
+ * If no incoming data is available at the socket, the omrsock_recvfrom call blocks and 
+ * waits for data to arrive. It the address argument is not null, the address will be updated 
+ * with address of the message sender.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock Pointer to the socket to read on.
+ * @param[out] buf Pointer to the buffer where input bytes are written.
+ * @param[in] nbyte The length of buf.
+ * @param[in] flags Tthe flags, to influence this read.
+ * @param[out] addrHandle If provided, the address to be updated with the sender information.
+ *
+ * @return the number of bytes received if no error occured. If the connection has been 
+ * gracefully closed, return 0. Otherwise, return an error.
+ */
+int32_t
+omrsock_recvfrom(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, uint8_t *buf, int32_t nbyte, int32_t flags, omrsock_sockaddr_t addrHandle)
+{
+	socklen_t addrLength = sizeof(OMRSockAddrStorage);
+	ssize_t rc = 0;
+
+	do {
+		rc = recvfrom(sock->data, buf, (size_t)nbyte, 0, (struct sockaddr *)addrHandle, (NULL == addrHandle) ? NULL : &addrLength);
+	} while ((-1 == rc) && (EINTR == errno));
+	if (-1 == rc) {
+		return setSocketError(portLibrary, errno);
+	}
+	return (int32_t)rc;
+}
+
+/**
+ * Closes a socket. Use it to release the socket so that further references 
+ * to socket will fail.
+ * 
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket that will be closed.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_close(struct OMRPortLibrary *portLibrary, omrsock_socket_t *sock)
+{
+	int32_t rc = 0;
+
+	if ((NULL == sock) || (NULL == *sock)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	/* the descriptor is released even if close reports an error, so it must not be retried */
+	if (-1 == close((*sock)->data)) {
+		rc = setSocketError(portLibrary, errno);
+	}
+	portLibrary->mem_free_memory(portLibrary, *sock);
+	*sock = NULL;
+	return rc;
+}
+
+/**
+ * Sends data gathered from several buffers on a connected socket, in one call.
+ * 
+ * With OMRSOCK_MSG_ZEROCOPY the kernel may transmit straight from the caller's
+ * pages instead of copying them into socket buffers. This only pays off for
+ * large sends, and the call then returns once the kernel no longer references
+ * the buffers, so they may be reused immediately. That can take until the peer
+ * acknowledges the data, so the flag is ignored on non-blocking sockets, as it
+ * is where zero-copy transmission is not available, and the data is copied as usual.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket to send on.
+ * @param[in] iov The buffers to send, in order.
+ * @param[in] iovCount The number of buffers.
+ * @param[in] flags 0 or OMRSOCK_MSG_ZEROCOPY.
+ *
+ * @return the total number of bytes sent if no error occurred, which may be less
+ * than the total length of the buffers. Otherwise, return an error.
+ */
+int32_t
+omrsock_sendmsg(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, OMRIOVec *iov, uint32_t iovCount, int32_t flags)
+{
+	struct iovec vector[OMRSOCK_SENDMSG_MAX_IOV];
+	struct msghdr msg;
+	uint32_t count = OMR_MIN(iovCount, OMRSOCK_SENDMSG_MAX_IOV);
+	uintptr_t totalLength = 0;
+	int osFlags = OMRSOCK_SEND_FLAGS;
+	ssize_t rc = 0;
+	uint32_t i = 0;
+
+	for (i = 0; i < count; i++) {
+		vector[i].iov_base = iov[i].base;
+		vector[i].iov_len = iov[i].length;
+		totalLength += iov[i].length;
+	}
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = vector;
+	msg.msg_iovlen = count;
+
+#if defined(OMRSOCK_USE_ZEROCOPY)
+	if (OMR_ARE_ANY_BITS_SET(flags, OMRSOCK_MSG_ZEROCOPY) && (totalLength >= OMRSOCK_ZEROCOPY_THRESHOLD) && (0 == sock->nonBlocking)) {
+		if (0 == sock->zeroCopyState) {
+			int on = 1;
+			if (0 == setsockopt(sock->data, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on))) {
+				sock->zeroCopyState = 1;
+			} else {
+				Trc_PRT_sock_zerocopy_unavailable(sock->data, errno);
+				sock->zeroCopyState = -1;
+			}
+		}
+		if (1 == sock->zeroCopyState) {
+			osFlags |= MSG_ZEROCOPY;
+		}
+	}
+#endif /* defined(OMRSOCK_USE_ZEROCOPY) */
+
+	do {
+		rc = sendmsg(sock->data, &msg, osFlags);
+	} while ((-1 == rc) && (EINTR == errno));
+
+#if defined(OMRSOCK_USE_ZEROCOPY)
+	if (OMR_ARE_ANY_BITS_SET(osFlags, MSG_ZEROCOPY)) {
+		if ((-1 == rc) && (ENOBUFS == errno)) {
+			/* the pages could not be pinned within the socket's option memory limit, copy instead */
+			osFlags &= ~MSG_ZEROCOPY;
+			do {
+				rc = sendmsg(sock->data, &msg, osFlags);
+			} while ((-1 == rc) && (EINTR == errno));
+		} else if (rc >= 0) {
+			int32_t waitRC = waitForZeroCopy(portLibrary, sock, sock->zeroCopySends);
+			sock->zeroCopySends += 1;
+			if (0 != waitRC) {
+				return waitRC;
+			}
+		}
+	}
+#endif /* defined(OMRSOCK_USE_ZEROCOPY) */
+
+	if (-1 == rc) {
+		return setSocketError(portLibrary, errno);
+	}
+	return (int32_t)rc;
+}
+
+/**
+ * Copies the socket address at "index" in the structure returned from
+ * @ref omrsock_getaddrinfo, indexed starting at 0, so it can be passed to
+ * @ref omrsock_bind or @ref omrsock_connect.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handle The result structure returned by @ref omrsock_getaddrinfo.
+ * @param[out] addr The socket address at "index".
+ * @param[in] index The index into the structure returned by @ref omrsock_getaddrinfo.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getaddrinfo_address(struct OMRPortLibrary *portLibrary, omrsock_addrinfo_t handle, omrsock_sockaddr_t addr, int32_t index)
+{
+	omr_os_addrinfo *info = getAddrInfoAt(handle, index);
+
+	if ((NULL == info) || (NULL == addr) || (info->ai_addrlen > sizeof(OMRSockAddrStorage))) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	memset(addr, 0, sizeof(OMRSockAddrStorage));
+	memcpy(addr, info->ai_addr, info->ai_addrlen);
+	return 0;
+}
+
+/**
+ * Answers the local address a socket is bound to. This is how to find the port
+ * chosen by the system after binding to port 0.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket.
+ * @param[out] addr The local address of the socket.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_getsockname(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, omrsock_sockaddr_t addr)
+{
+	socklen_t addrLength = sizeof(OMRSockAddrStorage);
+
+	if (NULL == addr) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	memset(addr, 0, sizeof(OMRSockAddrStorage));
+	if (-1 == getsockname(sock->data, (struct sockaddr *)addr, &addrLength)) {
+		return setSocketError(portLibrary, errno);
+	}
+	return 0;
+}
+
+/**
+ * Sets the flags of a socket.
+ *
+ * With OMRSOCK_O_NONBLOCK, calls on the socket which would otherwise block fail with
+ * OMRPORT_ERROR_SOCKET_WOULDBLOCK instead, and @ref omrsock_connect fails with
+ * OMRPORT_ERROR_SOCKET_IN_PROGRESS while the connection is being established.
+ * Passing 0 makes the socket blocking again.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sock The socket.
+ * @param[in] arg The flags to set, 0 or OMRSOCK_O_NONBLOCK.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_fcntl(struct OMRPortLibrary *portLibrary, omrsock_socket_t sock, int32_t arg)
+{
+	int flags = fcntl(sock->data, F_GETFL);
+
+	if (-1 == flags) {
+		return setSocketError(portLibrary, errno);
+	}
+	if (OMR_ARE_ANY_BITS_SET(arg, OMRSOCK_O_NONBLOCK)) {
+		flags |= O_NONBLOCK;
+	} else {
+		flags &= ~O_NONBLOCK;
+	}
+	if (-1 == fcntl(sock->data, F_SETFL, flags)) {
+		return setSocketError(portLibrary, errno);
+	}
+	sock->nonBlocking = OMR_ARE_ANY_BITS_SET(flags, O_NONBLOCK) ? 1 : 0;
+	return 0;
+}
+
+/**
+ * Creates a poll set, which waits for any number of sockets to become ready and
+ * for timers to expire, in a single call. One thread can serve many connections
+ * this way, instead of dedicating a thread to each blocking socket.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] pollSet The new poll set.
+ * @param[in] flags Reserved, must be 0.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ *
+ * @note Must free the poll set with @ref omrsock_poll_destroy.
+ */
+int32_t
+omrsock_poll_create(struct OMRPortLibrary *portLibrary, omrsock_poll_t *pollSet, uint32_t flags)
+{
+	omrsock_poll_t newPoll = NULL;
+	int32_t rc = 0;
+
+	Trc_PRT_sock_poll_create_Entry(flags);
+
+	if ((NULL == pollSet) || (0 != flags)) {
+		rc = OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+		goto done;
+	}
+	newPoll = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRSockPoll), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == newPoll) {
+		rc = OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+		goto done;
+	}
+	memset(newPoll, 0, sizeof(OMRSockPoll));
+
+#if defined(OMRSOCK_USE_EPOLL)
+	newPoll->epollFD = epoll_create1(EPOLL_CLOEXEC);
+	if (-1 == newPoll->epollFD) {
+		rc = setSocketError(portLibrary, errno);
+		portLibrary->mem_free_memory(portLibrary, newPoll);
+		newPoll = NULL;
+		goto done;
+	}
+#else /* defined(OMRSOCK_USE_EPOLL) */
+	if (0 == MUTEX_INIT(newPoll->lock)) {
+		rc = OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+		portLibrary->mem_free_memory(portLibrary, newPoll);
+		newPoll = NULL;
+		goto done;
+	}
+#endif /* defined(OMRSOCK_USE_EPOLL) */
+
+	*pollSet = newPoll;
+
+done:
+	Trc_PRT_sock_poll_create_Exit(rc, newPoll);
+	return rc;
+}
+
+/**
+ * Frees a poll set and any timers still started on it. The sockets that were
+ * registered are not closed.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set created by @ref omrsock_poll_create.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_destroy(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet)
+{
+	uint32_t i = 0;
+
+	if (NULL == pollSet) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	for (i = 0; i < pollSet->timerCount; i++) {
+		portLibrary->mem_free_memory(portLibrary, pollSet->timers[i]);
+	}
+	portLibrary->mem_free_memory(portLibrary, pollSet->timers);
+#if defined(OMRSOCK_USE_EPOLL)
+	close(pollSet->epollFD);
+	portLibrary->mem_free_memory(portLibrary, pollSet->osEvents);
+#else /* defined(OMRSOCK_USE_EPOLL) */
+	MUTEX_DESTROY(pollSet->lock);
+	portLibrary->mem_free_memory(portLibrary, pollSet->fds);
+	portLibrary->mem_free_memory(portLibrary, pollSet->userData);
+	portLibrary->mem_free_memory(portLibrary, pollSet->waitFDs);
+	portLibrary->mem_free_memory(portLibrary, pollSet->waitUserData);
+#endif /* defined(OMRSOCK_USE_EPOLL) */
+	portLibrary->mem_free_memory(portLibrary, pollSet);
+	return 0;
+}
+
+/**
+ * Registers a socket with a poll set, changes the events it is polled for, or
+ * removes it. A socket must be removed before it is closed.
+ *
+ * The events are OMRSOCK_POLLIN and/or OMRSOCK_POLLOUT. OMRSOCK_POLLERR and
+ * OMRSOCK_POLLHUP are always reported. By default a socket is reported by every
+ * @ref omrsock_poll_wait while it stays ready. With OMRSOCK_POLLET it is only
+ * reported when it becomes ready again, so the caller must then read or write
+ * the non-blocking socket until it fails with OMRPORT_ERROR_SOCKET_WOULDBLOCK.
+ * This saves a system call per event when serving many busy connections. Where
+ * the platform cannot poll edge-triggered, such sockets are reported as if they
+ * were level-triggered, which callers that drain them behave correctly with.
+ *
+ * This may be called while another thread waits in @ref omrsock_poll_wait.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[in] operation OMRSOCK_POLL_ADD, OMRSOCK_POLL_MODIFY or OMRSOCK_POLL_REMOVE.
+ * @param[in] sock The socket.
+ * @param[in] events The events to poll for, ignored by OMRSOCK_POLL_REMOVE.
+ * @param[in] userData Returned with each event for the socket, ignored by OMRSOCK_POLL_REMOVE.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_ctl(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int32_t operation, omrsock_socket_t sock, uint32_t events, void *userData)
+{
+#if defined(OMRSOCK_USE_EPOLL)
+	struct epoll_event osEvent;
+	int osOperation = 0;
+
+	if ((NULL == pollSet) || (NULL == sock)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	switch (operation) {
+	case OMRSOCK_POLL_ADD:
+		osOperation = EPOLL_CTL_ADD;
+		break;
+	case OMRSOCK_POLL_MODIFY:
+		osOperation = EPOLL_CTL_MOD;
+		break;
+	case OMRSOCK_POLL_REMOVE:
+		osOperation = EPOLL_CTL_DEL;
+		break;
+	default:
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+
+	memset(&osEvent, 0, sizeof(osEvent));
+	if (OMR_ARE_ANY_BITS_SET(events, OMRSOCK_POLLIN)) {
+		osEvent.events |= EPOLLIN;
+	}
+	if (OMR_ARE_ANY_BITS_SET(events, OMRSOCK_POLLOUT)) {
+		osEvent.events |= EPOLLOUT;
+	}
+	if (OMR_ARE_ANY_BITS_SET(events, OMRSOCK_POLLET)) {
+		osEvent.events |= EPOLLET;
+	}
+	osEvent.data.ptr = userData;
+
+	if (-1 == epoll_ctl(pollSet->epollFD, osOperation, sock->data, &osEvent)) {
+		return setSocketError(portLibrary, errno);
+	}
+	return 0;
+#else /* defined(OMRSOCK_USE_EPOLL) */
+	/* poll has no edge-triggered mode; reporting readiness on every wait is a superset of it */
+	short osEvents = 0;
+	uint32_t i = 0;
+	int32_t rc = 0;
+
+	if ((NULL == pollSet) || (NULL == sock)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	if (OMR_ARE_ANY_BITS_SET(events, OMRSOCK_POLLIN)) {
+		osEvents |= POLLIN;
+	}
+	if (OMR_ARE_ANY_BITS_SET(events, OMRSOCK_POLLOUT)) {
+		osEvents |= POLLOUT;
+	}
+
+	MUTEX_ENTER(pollSet->lock);
+	for (i = 0; i < pollSet->count; i++) {
+		if (pollSet->fds[i].fd == sock->data) {
+			break;
+		}
+	}
+	switch (operation) {
+	case OMRSOCK_POLL_ADD:
+		if (i < pollSet->count) {
+			rc = OMRPORT_ERROR_SOCKET_ALREADY_REGISTERED;
+			break;
+		}
+		if (pollSet->count == pollSet->capacity) {
+			uint32_t newCapacity = OMR_MAX(2 * pollSet->capacity, 16);
+			struct pollfd *newFDs = portLibrary->mem_reallocate_memory(portLibrary, pollSet->fds, newCapacity * sizeof(struct pollfd), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+			if (NULL != newFDs) {
+				pollSet->fds = newFDs;
+				newFDs = portLibrary->mem_reallocate_memory(portLibrary, pollSet->userData, newCapacity * sizeof(void *), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+				if (NULL != newFDs) {
+					pollSet->userData = (void **)newFDs;
+					pollSet->capacity = newCapacity;
+				}
+			}
+			if (pollSet->count == pollSet->capacity) {
+				rc = OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+				break;
+			}
+		}
+		pollSet->fds[pollSet->count].fd = sock->data;
+		pollSet->fds[pollSet->count].events = osEvents;
+		pollSet->fds[pollSet->count].revents = 0;
+		pollSet->userData[pollSet->count] = userData;
+		pollSet->count += 1;
+		break;
+	case OMRSOCK_POLL_MODIFY:
+		if (i == pollSet->count) {
+			rc = OMRPORT_ERROR_SOCKET_NOT_REGISTERED;
+			break;
+		}
+		pollSet->fds[i].events = osEvents;
+		pollSet->userData[i] = userData;
+		break;
+	case OMRSOCK_POLL_REMOVE:
+		if (i == pollSet->count) {
+			rc = OMRPORT_ERROR_SOCKET_NOT_REGISTERED;
+			break;
+		}
+		pollSet->count -= 1;
+		pollSet->fds[i] = pollSet->fds[pollSet->count];
+		pollSet->userData[i] = pollSet->userData[pollSet->count];
+		break;
+	default:
+		rc = OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+		break;
+	}
+	MUTEX_EXIT(pollSet->lock);
+	return rc;
+#endif /* defined(OMRSOCK_USE_EPOLL) */
+}
+
+/**
+ * Waits until registered sockets are ready or timers expire, and answers a batch
+ * of events. Expired timers are reported with OMRSOCK_POLLTIMER.
+ *
+ * Only one thread may wait on, or start and cancel timers on, a poll set at a time.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[out] events The events.
+ * @param[in] maxEvents The number of entries in events.
+ * @param[in] timeoutNanos How long to wait if nothing is ready, 0 to return
+ * immediately, or -1 to wait until something is.
+ *
+ * @return the number of events, 0 if the timeout expired, otherwise return an error.
+ */
+int32_t
+omrsock_poll_wait(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, OMRSockPollEvent *events, uint32_t maxEvents, int64_t timeoutNanos)
+{
+	int64_t start = 0;
+	int64_t now = 0;
+	uint32_t count = 0;
+	int waitMillis = 0;
+	int rc = 0;
+	int i = 0;
+
+	if ((NULL == pollSet) || (NULL == events) || (0 == maxEvents)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+
+	start = portLibrary->time_nano_time(portLibrary);
+	now = start;
+	/* report timers first, so busy sockets cannot starve them */
+	count = collectExpiredTimers(portLibrary, pollSet, events, maxEvents, now);
+	if (count == maxEvents) {
+		return (int32_t)count;
+	}
+	waitMillis = (count > 0) ? 0 : computeWaitMillis(pollSet, timeoutNanos, start, now);
+
+#if defined(OMRSOCK_USE_EPOLL)
+	if (pollSet->osEventCapacity < maxEvents) {
+		struct epoll_event *newEvents = portLibrary->mem_allocate_memory(portLibrary, maxEvents * sizeof(struct epoll_event), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == newEvents) {
+			return OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+		}
+		portLibrary->mem_free_memory(portLibrary, pollSet->osEvents);
+		pollSet->osEvents = newEvents;
+		pollSet->osEventCapacity = maxEvents;
+	}
+
+	for (;;) {
+		rc = epoll_wait(pollSet->epollFD, pollSet->osEvents, (int)(maxEvents - count), waitMillis);
+		if (0 != rc) {
+			break;
+		}
+		/* nothing was ready; stop unless a timer is due or the wait ended early */
+		now = portLibrary->time_nano_time(portLibrary);
+		/* timers reported before the wait are kept */
+		count += collectExpiredTimers(portLibrary, pollSet, events + count, maxEvents - count, now);
+		waitMillis = computeWaitMillis(pollSet, timeoutNanos, start, now);
+		if ((count > 0) || (0 == waitMillis)) {
+			return (int32_t)count;
+		}
+	}
+	if (-1 == rc) {
+		if (EINTR == errno) {
+			return (int32_t)count;
+		}
+		return setSocketError(portLibrary, errno);
+	}
+
+	for (i = 0; i < rc; i++) {
+		uint32_t osEvents = pollSet->osEvents[i].events;
+		uint32_t portEvents = 0;
+
+		if (OMR_ARE_ANY_BITS_SET(osEvents, EPOLLIN)) {
+			portEvents |= OMRSOCK_POLLIN;
+		}
+		if (OMR_ARE_ANY_BITS_SET(osEvents, EPOLLOUT)) {
+			portEvents |= OMRSOCK_POLLOUT;
+		}
+		if (OMR_ARE_ANY_BITS_SET(osEvents, EPOLLERR)) {
+			portEvents |= OMRSOCK_POLLERR;
+		}
+		if (OMR_ARE_ANY_BITS_SET(osEvents, EPOLLHUP)) {
+			portEvents |= OMRSOCK_POLLHUP;
+		}
+		events[count].userData = pollSet->osEvents[i].data.ptr;
+		events[count].events = portEvents;
+		count += 1;
+	}
+#else /* defined(OMRSOCK_USE_EPOLL) */
+	for (;;) {
+		uint32_t waitCount = 0;
+
+		/* poll a copy, so other threads may change the registered sockets meanwhile */
+		MUTEX_ENTER(pollSet->lock);
+		if (pollSet->waitCapacity < pollSet->count) {
+			struct pollfd *newFDs = portLibrary->mem_allocate_memory(portLibrary, pollSet->capacity * sizeof(struct pollfd), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+			void **newUserData = portLibrary->mem_allocate_memory(portLibrary, pollSet->capacity * sizeof(void *), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+			if ((NULL == newFDs) || (NULL == newUserData)) {
+				MUTEX_EXIT(pollSet->lock);
+				portLibrary->mem_free_memory(portLibrary, newFDs);
+				portLibrary->mem_free_memory(portLibrary, newUserData);
+				return OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+			}
+			portLibrary->mem_free_memory(portLibrary, pollSet->waitFDs);
+			portLibrary->mem_free_memory(portLibrary, pollSet->waitUserData);
+			pollSet->waitFDs = newFDs;
+			pollSet->waitUserData = newUserData;
+			pollSet->waitCapacity = pollSet->capacity;
+		}
+		waitCount = pollSet->count;
+		memcpy(pollSet->waitFDs, pollSet->fds, waitCount * sizeof(struct pollfd));
+		memcpy(pollSet->waitUserData, pollSet->userData, waitCount * sizeof(void *));
+		MUTEX_EXIT(pollSet->lock);
+
+		rc = poll(pollSet->waitFDs, waitCount, waitMillis);
+		if (-1 == rc) {
+			if (EINTR == errno) {
+				return (int32_t)count;
+			}
+			return setSocketError(portLibrary, errno);
+		}
+		if (0 != rc) {
+			for (i = 0; (i < (int)waitCount) && (count < maxEvents); i++) {
+				short osEvents = pollSet->waitFDs[i].revents;
+				uint32_t portEvents = 0;
+
+				if (0 == osEvents) {
+					continue;
+				}
+				if (OMR_ARE_ANY_BITS_SET(osEvents, POLLIN)) {
+					portEvents |= OMRSOCK_POLLIN;
+				}
+				if (OMR_ARE_ANY_BITS_SET(osEvents, POLLOUT)) {
+					portEvents |= OMRSOCK_POLLOUT;
+				}
+				if (OMR_ARE_ANY_BITS_SET(osEvents, POLLERR | POLLNVAL)) {
+					portEvents |= OMRSOCK_POLLERR;
+				}
+				if (OMR_ARE_ANY_BITS_SET(osEvents, POLLHUP)) {
+					portEvents |= OMRSOCK_POLLHUP;
+				}
+				events[count].userData = pollSet->waitUserData[i];
+				events[count].events = portEvents;
+				count += 1;
+			}
+			break;
+		}
+		/* nothing was ready; stop unless a timer is due or the wait ended early */
+		now = portLibrary->time_nano_time(portLibrary);
+		/* timers reported before the wait are kept */
+		count += collectExpiredTimers(portLibrary, pollSet, events + count, maxEvents - count, now);
+		waitMillis = computeWaitMillis(pollSet, timeoutNanos, start, now);
+		if ((count > 0) || (0 == waitMillis)) {
+			break;
+		}
+	}
+#endif /* defined(OMRSOCK_USE_EPOLL) */
+
+	return (int32_t)count;
+}
+
+/**
+ * Starts a timer, which @ref omrsock_poll_wait reports once delayNanos have
+ * passed, measured by @ref omrtime_nano_time. A timer with a non-zero
+ * intervalNanos is then reported every intervalNanos until it is canceled.
+ * A one-shot timer is freed once it has been reported, and must not be
+ * canceled after that.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[in] delayNanos Time until the first expiry.
+ * @param[in] intervalNanos Time between later expiries, or 0 for a one-shot timer.
+ * @param[in] userData Returned with each event for the timer.
+ * @param[out] timer The timer, may be NULL for one-shot timers.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_timer_start(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, int64_t delayNanos, int64_t intervalNanos, void *userData, omrsock_timer_t *timer)
+{
+	OMRSockPollTimer *newTimer = NULL;
+
+	if ((NULL == pollSet) || (delayNanos < 0) || (intervalNanos < 0)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	if (pollSet->timerCount == pollSet->timerCapacity) {
+		uint32_t newCapacity = OMR_MAX(2 * pollSet->timerCapacity, 8);
+		OMRSockPollTimer **newTimers = portLibrary->mem_reallocate_memory(portLibrary, pollSet->timers, newCapacity * sizeof(OMRSockPollTimer *), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == newTimers) {
+			return OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+		}
+		pollSet->timers = newTimers;
+		pollSet->timerCapacity = newCapacity;
+	}
+	newTimer = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRSockPollTimer), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == newTimer) {
+		return OMRPORT_ERROR_SOCKET_NO_BUFFERS;
+	}
+
+	newTimer->deadline = portLibrary->time_nano_time(portLibrary) + delayNanos;
+	newTimer->interval = intervalNanos;
+	newTimer->userData = userData;
+	newTimer->heapIndex = pollSet->timerCount;
+	pollSet->timers[pollSet->timerCount] = newTimer;
+	pollSet->timerCount += 1;
+	timerHeapUp(pollSet, newTimer->heapIndex);
+
+	if (NULL != timer) {
+		*timer = newTimer;
+	}
+	return 0;
+}
+
+/**
+ * Stops and frees a timer started by @ref omrsock_poll_timer_start.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] pollSet The poll set.
+ * @param[in] timer The timer.
+ *
+ * @return 0, if no errors occurred, otherwise return an error.
+ */
+int32_t
+omrsock_poll_timer_cancel(struct OMRPortLibrary *portLibrary, omrsock_poll_t pollSet, omrsock_timer_t timer)
+{
+	if ((NULL == pollSet) || (NULL == timer) || (timer->heapIndex >= pollSet->timerCount) || (pollSet->timers[timer->heapIndex] != timer)) {
+		return OMRPORT_ERROR_SOCKET_INVALID_ARGUMENT;
+	}
+	timerHeapRemove(pollSet, timer->heapIndex);
+	portLibrary->mem_free_memory(portLibrary, timer);
+	return 0;
+}
+
+#endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
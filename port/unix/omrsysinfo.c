@@ -48,6 +48,7 @@
 
 #endif /* defined(LINUX) && !defined(OMRZTPF) */
 
+#include <ctype.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -5636,6 +5637,603 @@ omrsysinfo_cgroup_subsystem_iterator_destroy(struct OMRPortLibrary *portLibrary,
 	}
 }
 
+#if defined(LINUX) && !defined(OMRZTPF)
+/**
+ * Parses the next range of a processor list such as "0-3,8,10-11", as found in the cpuset
+ * cgroup and in /sys/devices/system/cpu. A single processor is returned as a range of one.
+ *
+ * @param[in] cursor the current position in the list
+ * @param[out] first the first processor of the range
+ * @param[out] last the last processor of the range
+ *
+ * @return the position following the range, or NULL if the list holds no further ranges
+ */
+static const char *
+nextCPURange(const char *cursor, unsigned long *first, unsigned long *last)
+{
+	char *end = NULL;
+
+	if (',' == *cursor) {
+		cursor += 1;
+	}
+	if (!isdigit(*cursor)) {
+		return NULL;
+	}
+	*first = strtoul(cursor, &end, 10);
+	*last = *first;
+	if ('-' == *end) {
+		*last = strtoul(end + 1, &end, 10);
+	}
+	return end;
+}
+
+/**
+ * Reads a cpuset list such as "0-3,8,10-11" from the process's cpuset cgroup into cpuSet.
+ * cpuset.effective_cpus is preferred since it reflects the CPUs granted by the parent
+ * cgroups; older kernels only provide cpuset.cpus.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[out] cpuSet the set to fill
+ * @param[in] setSize size of cpuSet in bytes
+ *
+ * @return 0 on success, negative error code if neither file could be read
+ */
+static int32_t
+readCgroupCpusetCpus(struct OMRPortLibrary *portLibrary, cpu_set_t *cpuSet, size_t setSize)
+{
+	FILE *file = NULL;
+	const char *fileName = "cpuset.effective_cpus";
+	int32_t rc = getHandleOfCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPUSET, fileName, &file);
+
+	if (0 != rc) {
+		fileName = "cpuset.cpus";
+		rc = getHandleOfCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPUSET, fileName, &file);
+	}
+	if (0 == rc) {
+		char buffer[4096];
+
+		CPU_ZERO_S(setSize, cpuSet);
+		if (NULL == fgets(buffer, sizeof(buffer), file)) {
+			rc = portLibrary->error_set_last_error_with_message_format(portLibrary, OMRPORT_ERROR_SYSINFO_PROCESS_CGROUP_FILE_READ_FAILED, "unexpected format of file %s", fileName);
+		} else {
+			const char *cursor = buffer;
+			unsigned long first = 0;
+			unsigned long last = 0;
+
+			while (NULL != (cursor = nextCPURange(cursor, &first, &last))) {
+				unsigned long cpu = 0;
+
+				for (cpu = first; (cpu <= last) && (cpu < (setSize * 8)); cpu++) {
+					CPU_SET_S(cpu, setSize, cpuSet);
+				}
+			}
+		}
+		fclose(file);
+	}
+	return rc;
+}
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+/**
+ * Lists the processors the process may run on. On Linux this is the process affinity
+ * mask intersected with the cpuset of the process's cgroup (when the cpuset subsystem
+ * has been enabled with omrsysinfo_cgroup_enable_subsystems()), so the list matches the
+ * CPUs actually granted to a container rather than those installed in the machine.
+ *
+ * The IDs are written in ascending order. At most the incoming value of *cpuCount IDs are
+ * written; on return *cpuCount holds the total number of usable processors, so a caller
+ * can pass a NULL list and a count of 0 to size its buffer.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[out] cpuList array which receives the processor IDs; may be NULL if *cpuCount is 0
+ * @param[in/out] cpuCount capacity of cpuList on input, number of usable processors on output
+ *
+ * @return 0 on success, otherwise negative error code
+ */
+int32_t
+omrsysinfo_get_cpu_list(struct OMRPortLibrary *portLibrary, uint32_t *cpuList, uintptr_t *cpuCount)
+{
+	int32_t rc = 0;
+	uintptr_t capacity = *cpuCount;
+	uintptr_t found = 0;
+#if defined(LINUX) && !defined(OMRZTPF)
+	int32_t numCPUs = (int32_t)sysconf(_SC_NPROCESSORS_CONF);
+	cpu_set_t *affinity = NULL;
+	size_t size = 0;
+
+	if (numCPUs < CPU_SETSIZE) {
+		numCPUs = CPU_SETSIZE;
+	}
+	/* The kernel mask may be wider than the configured processor count; grow until it fits */
+	for (;;) {
+		affinity = CPU_ALLOC(numCPUs);
+		if (NULL == affinity) {
+			rc = OMRPORT_ERROR_SYSINFO_MEMORY_ALLOC_FAILED;
+			break;
+		}
+		size = CPU_ALLOC_SIZE(numCPUs);
+		CPU_ZERO_S(size, affinity);
+		if (0 == sched_getaffinity(getpid(), size, affinity)) {
+			break;
+		}
+		CPU_FREE(affinity);
+		affinity = NULL;
+		if ((EINVAL != errno) || (numCPUs >= (1 << 20))) {
+			rc = OMRPORT_ERROR_SYSINFO_ERROR_READING_PROCESSOR_INFO;
+			break;
+		}
+		numCPUs *= 2;
+	}
+
+	if (NULL != affinity) {
+		int32_t cpu = 0;
+
+		if (portLibrary->sysinfo_cgroup_are_subsystems_enabled(portLibrary, OMR_CGROUP_SUBSYSTEM_CPUSET)) {
+			cpu_set_t *cgroupCPUs = CPU_ALLOC(numCPUs);
+			if (NULL != cgroupCPUs) {
+				/* If the cpuset cannot be read, the affinity mask alone is used */
+				if (0 == readCgroupCpusetCpus(portLibrary, cgroupCPUs, size)) {
+					CPU_AND_S(size, affinity, affinity, cgroupCPUs);
+				}
+				CPU_FREE(cgroupCPUs);
+			}
+		}
+		for (cpu = 0; cpu < numCPUs; cpu++) {
+			if (CPU_ISSET_S(cpu, size, affinity)) {
+				if (found < capacity) {
+					cpuList[found] = (uint32_t)cpu;
+				}
+				found += 1;
+			}
+		}
+		CPU_FREE(affinity);
+	}
+#else /* defined(LINUX) && !defined(OMRZTPF) */
+	rc = OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED;
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+	*cpuCount = found;
+	return rc;
+}
+
+#if defined(LINUX) && !defined(OMRZTPF)
+#define SYSFS_CPU_DIRECTORY "/sys/devices/system/cpu"
+#define SYSFS_NODE_DIRECTORY "/sys/devices/system/node"
+#define SYSFS_VALUE_LENGTH 4096
+
+/**
+ * Reads the first line of a sysfs attribute, without the trailing newline.
+ *
+ * @param[in] path the attribute to read
+ * @param[out] buffer the buffer which receives the value
+ * @param[in] length size of buffer in bytes
+ *
+ * @return TRUE if a value was read, FALSE if the attribute does not exist or is empty
+ */
+static BOOLEAN
+readSysfsValue(const char *path, char *buffer, size_t length)
+{
+	BOOLEAN found = FALSE;
+	FILE *file = fopen(path, "r");
+
+	if (NULL != file) {
+		if (NULL != fgets(buffer, (int)length, file)) {
+			char *newline = strchr(buffer, '\n');
+			if (NULL != newline) {
+				*newline = '\0';
+			}
+			found = TRUE;
+		}
+		fclose(file);
+	}
+	return found;
+}
+
+/**
+ * Reads a sysfs attribute holding a decimal integer, optionally followed by a K, M or G
+ * suffix as used for cache sizes.
+ *
+ * @param[in] path the attribute to read
+ * @param[out] value the value read, scaled by its suffix
+ *
+ * @return TRUE if a value was read, FALSE otherwise
+ */
+static BOOLEAN
+readSysfsInteger(const char *path, uint64_t *value)
+{
+	char buffer[64];
+	BOOLEAN found = FALSE;
+
+	if (readSysfsValue(path, buffer, sizeof(buffer)) && isdigit(buffer[0])) {
+		char *end = NULL;
+
+		*value = strtoull(buffer, &end, 10);
+		switch (*end) {
+		case 'G':
+			*value <<= 10;
+			/* FALLTHROUGH */
+		case 'M':
+			*value <<= 10;
+			/* FALLTHROUGH */
+		case 'K':
+			*value <<= 10;
+			break;
+		default:
+			break;
+		}
+		found = TRUE;
+	}
+	return found;
+}
+
+/**
+ * Finds the lowest processor and the number of processors in a processor list.
+ *
+ * @param[in] list the processor list
+ * @param[out] lowest the lowest processor, unchanged if the list is empty
+ * @param[out] count the number of processors in the list
+ */
+static void
+describeCPUList(const char *list, int32_t *lowest, int32_t *count)
+{
+	const char *cursor = list;
+	unsigned long first = 0;
+	unsigned long last = 0;
+
+	*count = 0;
+	while (NULL != (cursor = nextCPURange(cursor, &first, &last))) {
+		if ((0 == *count) || ((int32_t)first < *lowest)) {
+			*lowest = (int32_t)first;
+		}
+		if (last >= first) {
+			*count += (int32_t)(last - first + 1);
+		}
+	}
+}
+
+/**
+ * Maps a sysfs cache index to its slot in OMRCPUTopologyEntry.caches.
+ *
+ * @param[in] level the cache level
+ * @param[in] type the cache type: Data, Instruction or Unified
+ *
+ * @return the slot, or -1 if the cache is not reported in the topology
+ */
+static intptr_t
+getCacheSlot(uint64_t level, const char *type)
+{
+	intptr_t slot = -1;
+	BOOLEAN instruction = (0 == strcmp(type, "Instruction"));
+
+	if (1 == level) {
+		if (instruction) {
+			slot = OMRPORT_CACHE_L1I;
+		} else if (0 == strcmp(type, "Data")) {
+			slot = OMRPORT_CACHE_L1D;
+		}
+	} else if ((2 == level) && !instruction) {
+		slot = OMRPORT_CACHE_L2;
+	} else if ((3 == level) && !instruction) {
+		slot = OMRPORT_CACHE_L3;
+	}
+	return slot;
+}
+
+/**
+ * Reads the package, core and caches of an online processor from /sys/devices/system/cpu/cpuN.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in/out] entry the processor to describe
+ *
+ * @return TRUE if any cache was described, FALSE otherwise
+ */
+static BOOLEAN
+readLinuxCPUTopologyEntry(struct OMRPortLibrary *portLibrary, OMRCPUTopologyEntry *entry)
+{
+	char path[PATH_MAX];
+	char value[SYSFS_VALUE_LENGTH];
+	uint64_t number = 0;
+	BOOLEAN cacheFound = FALSE;
+	uint32_t index = 0;
+
+	portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/topology/physical_package_id", entry->cpu);
+	if (readSysfsInteger(path, &number)) {
+		entry->package = (int32_t)number;
+	}
+	portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/topology/thread_siblings_list", entry->cpu);
+	if (readSysfsValue(path, value, sizeof(value))) {
+		int32_t siblings = 0;
+		describeCPUList(value, &entry->core, &siblings);
+	}
+
+	for (index = 0;; index++) {
+		OMRCacheInfo *cache = NULL;
+		intptr_t slot = -1;
+
+		portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/cache/index%u/level", entry->cpu, index);
+		if (!readSysfsInteger(path, &number)) {
+			break;
+		}
+		portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/cache/index%u/type", entry->cpu, index);
+		if (readSysfsValue(path, value, sizeof(value))) {
+			slot = getCacheSlot(number, value);
+		}
+		if (slot < 0) {
+			continue;
+		}
+
+		cache = &entry->caches[slot];
+		portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/cache/index%u/size", entry->cpu, index);
+		if (!readSysfsInteger(path, &cache->size) || (0 == cache->size)) {
+			cache->size = 0;
+			continue;
+		}
+		portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/cache/index%u/coherency_line_size", entry->cpu, index);
+		if (readSysfsInteger(path, &number)) {
+			cache->lineSize = (uint32_t)number;
+		}
+		portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/cache/index%u/ways_of_associativity", entry->cpu, index);
+		if (readSysfsInteger(path, &number)) {
+			cache->associativity = (uint32_t)number;
+		}
+		cache->id = entry->cpu;
+		cache->sharingCount = 1;
+		portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_CPU_DIRECTORY "/cpu%d/cache/index%u/shared_cpu_list", entry->cpu, index);
+		if (readSysfsValue(path, value, sizeof(value))) {
+			describeCPUList(value, &cache->id, &cache->sharingCount);
+		}
+		cacheFound = TRUE;
+	}
+	return cacheFound;
+}
+
+#if defined(J9X86) || defined(J9HAMMER)
+/**
+ * Describes the caches of processors that sysfs reports nothing for, using the CPUID cache
+ * leaves of the current processor. Processors are assumed to be identical, with the L1 and
+ * L2 caches private to a core and the L3 cache shared by the package.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in/out] topology the topology to complete
+ *
+ * @return TRUE if CPUID reported the caches, FALSE otherwise
+ */
+static BOOLEAN
+fillCPUTopologyCachesFromCPUID(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	OMRCacheInfo caches[OMRPORT_CACHE_SLOTS];
+	int32_t cpu = 0;
+
+	memset(caches, 0, sizeof(caches));
+	if (0 != omrsysinfo_get_x86_cache_info(portLibrary, caches)) {
+		return FALSE;
+	}
+
+	for (cpu = 0; cpu < topology->cpuCount; cpu++) {
+		OMRCPUTopologyEntry *entry = &topology->cpus[cpu];
+		intptr_t slot = 0;
+
+		if (OMRPORT_PROCINFO_PROC_ONLINE != entry->online) {
+			continue;
+		}
+		for (slot = 0; slot < OMRPORT_CACHE_SLOTS; slot++) {
+			OMRCacheInfo *cache = &entry->caches[slot];
+			int32_t other = 0;
+
+			if ((0 != cache->size) || (0 == caches[slot].size)) {
+				continue;
+			}
+			*cache = caches[slot];
+			cache->id = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+			cache->sharingCount = 0;
+			for (other = 0; other < topology->cpuCount; other++) {
+				OMRCPUTopologyEntry *candidate = &topology->cpus[other];
+				BOOLEAN shared = FALSE;
+
+				if (OMRPORT_PROCINFO_PROC_ONLINE != candidate->online) {
+					continue;
+				}
+				if (OMRPORT_CACHE_L3 == slot) {
+					shared = (candidate->package == entry->package);
+				} else {
+					shared = (candidate->core == entry->core);
+				}
+				if (shared) {
+					if (OMRPORT_TOPOLOGY_NOT_AVAILABLE == cache->id) {
+						cache->id = other;
+					}
+					cache->sharingCount += 1;
+				}
+			}
+		}
+	}
+	return TRUE;
+}
+#endif /* defined(J9X86) || defined(J9HAMMER) */
+
+/**
+ * Populates a topology from /sys/devices/system/cpu and /sys/devices/system/node.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] topology the topology to populate; on failure topology->cpus may need to be freed
+ *
+ * @return 0 on success, otherwise negative error code
+ */
+static int32_t
+retrieveLinuxCPUTopology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	char path[PATH_MAX];
+	char value[SYSFS_VALUE_LENGTH];
+	const char *cursor = NULL;
+	unsigned long first = 0;
+	unsigned long last = 0;
+	int32_t cpuCount = 0;
+	int32_t cpu = 0;
+	int32_t missingCaches = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+	uint32_t *boundList = NULL;
+	uintptr_t boundCapacity = 0;
+	uintptr_t boundCount = 0;
+	uintptr_t i = 0;
+	int32_t rc = 0;
+
+	/* Processor numbering may be sparse, so size the array by the highest present processor */
+	if (readSysfsValue(SYSFS_CPU_DIRECTORY "/present", value, sizeof(value))) {
+		cursor = value;
+		while (NULL != (cursor = nextCPURange(cursor, &first, &last))) {
+			if ((int32_t)last >= cpuCount) {
+				cpuCount = (int32_t)last + 1;
+			}
+		}
+	}
+	if (0 == cpuCount) {
+		cpuCount = (int32_t)sysconf(_SC_NPROCESSORS_CONF);
+		if (cpuCount <= 0) {
+			return OMRPORT_ERROR_SYSINFO_ERROR_READING_PROCESSOR_INFO;
+		}
+	}
+
+	topology->cpus = portLibrary->mem_allocate_memory(portLibrary, cpuCount * sizeof(OMRCPUTopologyEntry), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == topology->cpus) {
+		return OMRPORT_ERROR_SYSINFO_MEMORY_ALLOC_FAILED;
+	}
+	topology->cpuCount = cpuCount;
+	memset(topology->cpus, 0, cpuCount * sizeof(OMRCPUTopologyEntry));
+	for (cpu = 0; cpu < cpuCount; cpu++) {
+		OMRCPUTopologyEntry *entry = &topology->cpus[cpu];
+		intptr_t slot = 0;
+
+		entry->cpu = cpu;
+		entry->core = cpu;
+		entry->package = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+		entry->node = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+		entry->online = OMRPORT_PROCINFO_PROC_OFFLINE;
+		for (slot = 0; slot < OMRPORT_CACHE_SLOTS; slot++) {
+			entry->caches[slot].id = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+		}
+	}
+
+	if (readSysfsValue(SYSFS_CPU_DIRECTORY "/online", value, sizeof(value))) {
+		cursor = value;
+		while (NULL != (cursor = nextCPURange(cursor, &first, &last))) {
+			for (i = first; (i <= last) && (i < (uintptr_t)cpuCount); i++) {
+				topology->cpus[i].online = OMRPORT_PROCINFO_PROC_ONLINE;
+			}
+		}
+	} else {
+		for (cpu = 0; cpu < cpuCount; cpu++) {
+			topology->cpus[cpu].online = OMRPORT_PROCINFO_PROC_ONLINE;
+		}
+	}
+
+	/* The bound processors are the affinity mask, restricted by the cgroup cpuset */
+	rc = portLibrary->sysinfo_get_cpu_list(portLibrary, NULL, &boundCapacity);
+	if ((0 == rc) && (0 != boundCapacity)) {
+		boundList = portLibrary->mem_allocate_memory(portLibrary, boundCapacity * sizeof(uint32_t), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == boundList) {
+			return OMRPORT_ERROR_SYSINFO_MEMORY_ALLOC_FAILED;
+		}
+		boundCount = boundCapacity;
+		rc = portLibrary->sysinfo_get_cpu_list(portLibrary, boundList, &boundCount);
+		if (boundCount > boundCapacity) {
+			/* the mask grew between the calls; the processors beyond the capacity are not known */
+			boundCount = boundCapacity;
+		}
+		for (i = 0; i < boundCount; i++) {
+			if (boundList[i] < (uint32_t)cpuCount) {
+				topology->cpus[boundList[i]].bound = TRUE;
+			}
+		}
+		portLibrary->mem_free_memory(portLibrary, boundList);
+	}
+	if (0 != rc) {
+		return rc;
+	}
+
+	for (cpu = 0; cpu < cpuCount; cpu++) {
+		OMRCPUTopologyEntry *entry = &topology->cpus[cpu];
+
+		/* sysfs only describes the topology of online processors */
+		if (OMRPORT_PROCINFO_PROC_ONLINE == entry->online) {
+			if (!readLinuxCPUTopologyEntry(portLibrary, entry) && (OMRPORT_TOPOLOGY_NOT_AVAILABLE == missingCaches)) {
+				missingCaches = cpu;
+			}
+		}
+	}
+
+	/* Kernels without NUMA support have no node directory, leaving the nodes unknown */
+	if (readSysfsValue(SYSFS_NODE_DIRECTORY "/possible", value, sizeof(value))) {
+		unsigned long lastNode = 0;
+		unsigned long node = 0;
+
+		cursor = value;
+		while (NULL != (cursor = nextCPURange(cursor, &node, &lastNode))) {
+			for (; node <= lastNode; node++) {
+				char nodeCPUs[SYSFS_VALUE_LENGTH];
+				const char *nodeCursor = NULL;
+
+				portLibrary->str_printf(portLibrary, path, sizeof(path), SYSFS_NODE_DIRECTORY "/node%lu/cpulist", node);
+				if (!readSysfsValue(path, nodeCPUs, sizeof(nodeCPUs))) {
+					continue;
+				}
+				nodeCursor = nodeCPUs;
+				while (NULL != (nodeCursor = nextCPURange(nodeCursor, &first, &last))) {
+					for (i = first; (i <= last) && (i < (uintptr_t)cpuCount); i++) {
+						topology->cpus[i].node = (int32_t)node;
+					}
+				}
+			}
+		}
+	}
+
+	if (OMRPORT_TOPOLOGY_NOT_AVAILABLE != missingCaches) {
+#if defined(J9X86) || defined(J9HAMMER)
+		if (!fillCPUTopologyCachesFromCPUID(portLibrary, topology))
+#endif /* defined(J9X86) || defined(J9HAMMER) */
+		{
+			Trc_PRT_sysinfo_get_cpu_topology_cacheInfoMissing(missingCaches);
+		}
+	}
+
+	return 0;
+}
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+int32_t
+omrsysinfo_get_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	int32_t rc = OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED;
+
+	Trc_PRT_sysinfo_get_cpu_topology_Entered();
+
+	if (NULL == topology) {
+		Trc_PRT_sysinfo_get_cpu_topology_Exit(OMRPORT_ERROR_SYSINFO_NULL_OBJECT_RECEIVED, 0, 0);
+		return OMRPORT_ERROR_SYSINFO_NULL_OBJECT_RECEIVED;
+	}
+	memset(topology, 0, sizeof(OMRCPUTopology));
+
+#if defined(LINUX) && !defined(OMRZTPF)
+	rc = retrieveLinuxCPUTopology(portLibrary, topology);
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+	if (0 == rc) {
+		omrsysinfo_count_cpu_topology(topology);
+	} else {
+		portLibrary->sysinfo_destroy_cpu_topology(portLibrary, topology);
+	}
+
+	Trc_PRT_sysinfo_get_cpu_topology_Exit(rc, topology->cpuCount, topology->boundCount);
+	return rc;
+}
+
+void
+omrsysinfo_destroy_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	if ((NULL != topology) && (NULL != topology->cpus)) {
+		portLibrary->mem_free_memory(portLibrary, topology->cpus);
+		topology->cpus = NULL;
+		topology->cpuCount = 0;
+	}
+}
+
 #if defined(OMRZTPF)
 /*
  * Return the number of I-streams ("processors", as called by other
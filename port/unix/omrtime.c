@@ -34,6 +34,14 @@
 #include <sys/types.h>
 #include <sys/time.h>
 #include "omrport.h"
+#if defined(LINUX) && defined(J9HAMMER)
+#include <string.h>
+#include "omrportpriv.h"
+#include "omrutilbase.h"
+#include "ut_omrport.h"
+
+#define OMRTIME_USE_TSC
+#endif /* defined(LINUX) && defined(J9HAMMER) */
 
 /* Frequency is microseconds / second */
 #define OMRTIME_HIRES_CLOCK_FREQUENCY J9CONST_U64(1000000)
@@ -46,6 +54,27 @@ static clock_serv_t cs_t;
 static const clockid_t OMRTIME_NANO_CLOCK = CLOCK_MONOTONIC;
 #endif /* defined(OSX) */
 
+#if defined(OMRTIME_USE_TSC)
+/* The TSC is only trusted when the kernel itself has chosen it to drive CLOCK_MONOTONIC */
+#define OMRTIME_TSC_CLOCKSOURCE_FNAME "/sys/devices/system/clocksource/clocksource0/current_clocksource"
+#define OMRTIME_TSC_CLOCKSOURCE_NAME "tsc"
+#define OMRTIME_TSC_SCALE_SHIFT 32
+/* Length of the initial calibration against CLOCK_MONOTONIC */
+#define OMRTIME_TSC_CALIBRATION_NANOS J9CONST_I64(1000000)
+/* The first resync comes 10ms after calibration, the interval then grows fourfold up to one second */
+#define OMRTIME_TSC_FIRST_RESYNC_NANOS J9CONST_U64(10000000)
+#define OMRTIME_TSC_RESYNC_GROWTH 4
+/* Drift is corrected by changing the rate by at most 1/2048 (about 500ppm); larger gaps behind the system clock are stepped over */
+#define OMRTIME_TSC_MAX_SLEW_SHIFT 11
+#define OMRTIME_TSC_MAX_SLEW_NANOS J9CONST_I64(1000000)
+/* x86 does not reorder loads with other loads, so readers of the latch only need to stop the compiler doing so */
+#define OMRTIME_TSC_READ_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+static void startTSCClock(struct OMRPortLibrary *portLibrary);
+static int64_t tscNanoTime(struct OMRPortLibrary *portLibrary);
+static BOOLEAN resyncTSCClock(struct OMRPortLibrary *portLibrary, uintptr_t sequence);
+#endif /* defined(OMRTIME_USE_TSC) */
+
 
 /**
  * Query OS for timestamp.
@@ -110,6 +139,11 @@ int64_t
 omrtime_nano_time(struct OMRPortLibrary *portLibrary)
 {
 	int64_t hiresTime = 0;
+#if defined(OMRTIME_USE_TSC)
+	if (PPG_time_tscClock.enabled) {
+		return tscNanoTime(portLibrary);
+	}
+#endif /* defined(OMRTIME_USE_TSC) */
 #if defined(OSX)
 	mach_timespec_t mt;
 	if (KERN_SUCCESS == clock_get_time(cs_t, &mt)) {
@@ -257,9 +291,294 @@ omrtime_startup(struct OMRPortLibrary *portLibrary)
 	if (0 != clock_getres(OMRTIME_NANO_CLOCK, &ts)) {
 		rc = OMRPORT_ERROR_STARTUP_TIME;
 	}
+#if defined(OMRTIME_USE_TSC)
+	if (0 == rc) {
+		startTSCClock(portLibrary);
+	}
+#endif /* defined(OMRTIME_USE_TSC) */
 #endif /* defined(OSX) */
 
 	return rc;
 }
 
+uint64_t
+omrtime_cycle_clock(struct OMRPortLibrary *portLibrary)
+{
+#if defined(OMRTIME_USE_TSC)
+	if (PPG_time_tscClock.enabled) {
+		uint32_t low = 0;
+		uint32_t high = 0;
+
+		__asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+		return ((uint64_t)high << 32) | low;
+	}
+#endif /* defined(OMRTIME_USE_TSC) */
+	return (uint64_t)portLibrary->time_nano_time(portLibrary);
+}
+
+uint64_t
+omrtime_cycle_frequency(struct OMRPortLibrary *portLibrary)
+{
+#if defined(OMRTIME_USE_TSC)
+	if (PPG_time_tscClock.enabled) {
+		return PPG_time_tscClock.frequency;
+	}
+#endif /* defined(OMRTIME_USE_TSC) */
+	return (uint64_t)OMRTIME_NANOSECONDS_PER_SECOND;
+}
 
+uint64_t
+omrtime_cycles_to_nanos(struct OMRPortLibrary *portLibrary, uint64_t cycles)
+{
+#if defined(OMRTIME_USE_TSC)
+	if (PPG_time_tscClock.enabled) {
+		return (uint64_t)(((unsigned __int128)cycles * PPG_time_tscClock.rate) >> OMRTIME_TSC_SCALE_SHIFT);
+	}
+#endif /* defined(OMRTIME_USE_TSC) */
+	return cycles;
+}
+
+#if defined(OMRTIME_USE_TSC)
+/**
+ * Read the TSC after all earlier loads, so that a reader of the TSC clock cannot take its
+ * cycle count before reading the sequence number.  A reader may still use the previous
+ * parameters for a cycle count a little past the base of a resync that has not been
+ * published yet; the two sets differ by a fraction of a nanosecond over the few cycles involved.
+ */
+static VMINLINE uint64_t
+readTSCOrdered(void)
+{
+	uint32_t low = 0;
+	uint32_t high = 0;
+
+	__asm__ __volatile__("lfence; rdtsc" : "=a"(low), "=d"(high) : : "memory");
+	return ((uint64_t)high << 32) | low;
+}
+
+/**
+ * Read CLOCK_MONOTONIC along with the TSC value at the midpoint of the call.
+ *
+ * @return the clock in nanoseconds, 0 on failure
+ */
+static int64_t
+sampleTSCAndClock(uint64_t *cycles)
+{
+	struct timespec ts;
+	uint64_t before = readTSCOrdered();
+	uint64_t after = 0;
+
+	if (0 != clock_gettime(OMRTIME_NANO_CLOCK, &ts)) {
+		return 0;
+	}
+	after = readTSCOrdered();
+	*cycles = before + ((after - before) / 2);
+	return ((int64_t)ts.tv_sec * OMRTIME_NANOSECONDS_PER_SECOND) + (int64_t)ts.tv_nsec;
+}
+
+/**
+ * Convert a TSC value to nanoseconds with the given parameters.  Values from before the
+ * base, which another CPU can see for an instant after a resync, map to the base.
+ */
+static VMINLINE int64_t
+scaleTSC(uint64_t cycles, uint64_t baseCycles, int64_t baseNanos, uint64_t scale)
+{
+	if (cycles <= baseCycles) {
+		return baseNanos;
+	}
+	return baseNanos + (int64_t)(((unsigned __int128)(cycles - baseCycles) * scale) >> OMRTIME_TSC_SCALE_SHIFT);
+}
+
+/**
+ * Enable the TSC clock if the CPU reports an invariant TSC and the kernel uses the TSC as its
+ * clock source, calibrating it against CLOCK_MONOTONIC.  Otherwise omrtime_nano_time carries
+ * on using clock_gettime.
+ */
+static void
+startTSCClock(struct OMRPortLibrary *portLibrary)
+{
+	OMRTimeTSCClock *tsc = &PPG_time_tscClock;
+	OMRProcessorDesc desc;
+	char clockSource[32];
+	intptr_t fd = -1;
+	intptr_t bytesRead = 0;
+	uint64_t cycles = 0;
+	int64_t nanos = 0;
+
+	memset(tsc, 0, sizeof(OMRTimeTSCClock));
+
+	if ((0 != portLibrary->sysinfo_get_processor_description(portLibrary, &desc))
+		|| !portLibrary->sysinfo_processor_has_feature(portLibrary, &desc, OMR_FEATURE_X86_INVARIANT_TSC)
+	) {
+		return;
+	}
+	fd = portLibrary->file_open(portLibrary, OMRTIME_TSC_CLOCKSOURCE_FNAME, EsOpenRead, 0);
+	if (fd < 0) {
+		return;
+	}
+	bytesRead = portLibrary->file_read(portLibrary, fd, clockSource, sizeof(clockSource) - 1);
+	portLibrary->file_close(portLibrary, fd);
+	if (bytesRead <= 0) {
+		return;
+	}
+	clockSource[bytesRead] = '\0';
+	if ((0 != strncmp(clockSource, OMRTIME_TSC_CLOCKSOURCE_NAME, sizeof(OMRTIME_TSC_CLOCKSOURCE_NAME) - 1))
+		|| ('\n' != clockSource[sizeof(OMRTIME_TSC_CLOCKSOURCE_NAME) - 1])
+	) {
+		return;
+	}
+
+	tsc->startNanos = sampleTSCAndClock(&tsc->startCycles);
+	if (0 == tsc->startNanos) {
+		return;
+	}
+	do {
+		nanos = sampleTSCAndClock(&cycles);
+	} while ((0 != nanos) && ((nanos - tsc->startNanos) < OMRTIME_TSC_CALIBRATION_NANOS));
+	if ((0 == nanos) || (cycles <= tsc->startCycles)) {
+		return;
+	}
+
+	tsc->rate = (uint64_t)(((unsigned __int128)(nanos - tsc->startNanos) << OMRTIME_TSC_SCALE_SHIFT) / (cycles - tsc->startCycles));
+	tsc->frequency = (uint64_t)(((unsigned __int128)(cycles - tsc->startCycles) * OMRTIME_NANOSECONDS_PER_SECOND) / (uint64_t)(nanos - tsc->startNanos));
+	tsc->resyncInterval = (uint64_t)(((unsigned __int128)tsc->frequency * OMRTIME_TSC_FIRST_RESYNC_NANOS) / OMRTIME_NANOSECONDS_PER_SECOND);
+	tsc->parameters[0].baseCycles = cycles;
+	tsc->parameters[0].baseNanos = nanos;
+	tsc->parameters[0].scale = tsc->rate;
+	tsc->parameters[0].resyncCycles = cycles + tsc->resyncInterval;
+	tsc->enabled = TRUE;
+
+	Trc_PRT_time_tsc_clock_enabled(tsc->frequency);
+}
+
+/**
+ * Read the TSC clock in nanoseconds.  The result never goes backwards, on any thread, as long as the
+ * TSCs of all CPUs are synchronized, which the kernel checks before it selects the TSC clock source.
+ *
+ * Readers never wait for a resync, so this is async-signal-safe: a signal handler that interrupts a
+ * resync reads the parameters the resync is not writing, and leaves the resync to the thread doing it.
+ */
+static int64_t
+tscNanoTime(struct OMRPortLibrary *portLibrary)
+{
+	OMRTimeTSCClock *tsc = &PPG_time_tscClock;
+
+	for (;;) {
+		uintptr_t sequence = tsc->sequence;
+		OMRTimeTSCParameters *parameters = NULL;
+		uint64_t baseCycles = 0;
+		int64_t baseNanos = 0;
+		uint64_t scale = 0;
+		uint64_t resyncCycles = 0;
+		uint64_t cycles = 0;
+
+		OMRTIME_TSC_READ_BARRIER();
+		parameters = &tsc->parameters[sequence & 1];
+		baseCycles = parameters->baseCycles;
+		baseNanos = parameters->baseNanos;
+		scale = parameters->scale;
+		resyncCycles = parameters->resyncCycles;
+		cycles = readTSCOrdered();
+		OMRTIME_TSC_READ_BARRIER();
+		if (sequence != tsc->sequence) {
+			/* a resync was published meanwhile, and the next one may already be rewriting this set */
+			continue;
+		}
+		if ((cycles >= resyncCycles) && resyncTSCClock(portLibrary, sequence)) {
+			continue;
+		}
+		return scaleTSC(cycles, baseCycles, baseNanos, scale);
+	}
+}
+
+/**
+ * Bring the TSC clock parameters back in line with CLOCK_MONOTONIC.  The clock keeps its current
+ * value at the moment of the resync and its rate is adjusted, by at most OMRTIME_TSC_MAX_SLEW_SHIFT,
+ * so that it converges on the system clock over the next interval.
+ *
+ * The new parameters are written to the set readers are not using and then published by moving the
+ * sequence on.  If another thread is already resyncing the caller does not wait for it, but carries
+ * on with the current parameters.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] sequence The sequence number the caller read the expired parameters under.
+ *
+ * @return TRUE if the parameters have moved on from sequence, FALSE if another thread is resyncing
+ */
+static BOOLEAN
+resyncTSCClock(struct OMRPortLibrary *portLibrary, uintptr_t sequence)
+{
+	OMRTimeTSCClock *tsc = &PPG_time_tscClock;
+	OMRTimeTSCParameters *current = &tsc->parameters[sequence & 1];
+	OMRTimeTSCParameters *next = &tsc->parameters[(sequence + 1) & 1];
+	uint64_t sampleCycles = 0;
+	int64_t sampleNanos = 0;
+	uint64_t cycles = 0;
+
+	if (0 != compareAndSwapUDATA((uintptr_t *)&tsc->resyncing, 0, 1)) {
+		return FALSE;
+	}
+	if (sequence != tsc->sequence) {
+		/* another thread finished the resync first */
+		issueWriteBarrier();
+		tsc->resyncing = 0;
+		return TRUE;
+	}
+
+	/* readers keep using the current parameters, so they never wait on this system call */
+	sampleNanos = sampleTSCAndClock(&sampleCycles);
+	*next = *current;
+	if ((0 != sampleNanos) && (sampleCycles > tsc->startCycles)) {
+		int64_t error = sampleNanos - scaleTSC(sampleCycles, current->baseCycles, current->baseNanos, current->scale);
+		uint64_t elapsedCycles = sampleCycles - tsc->startCycles;
+		uint64_t elapsedNanos = (uint64_t)(sampleNanos - tsc->startNanos);
+		uint64_t rate = (uint64_t)(((unsigned __int128)elapsedNanos << OMRTIME_TSC_SCALE_SHIFT) / elapsedCycles);
+		uint64_t frequency = (uint64_t)(((unsigned __int128)elapsedCycles * OMRTIME_NANOSECONDS_PER_SECOND) / elapsedNanos);
+		uint64_t maxSlew = rate >> OMRTIME_TSC_MAX_SLEW_SHIFT;
+		uint64_t scale = rate;
+		int64_t nanos = 0;
+
+		if (error <= OMRTIME_TSC_MAX_SLEW_NANOS) {
+			/* Choose the rate that would remove the error by the end of the next interval */
+			__int128 correction = ((__int128)error << OMRTIME_TSC_SCALE_SHIFT) / (__int128)tsc->resyncInterval;
+
+			if (correction > (__int128)maxSlew) {
+				correction = (__int128)maxSlew;
+			} else if (correction < -(__int128)maxSlew) {
+				correction = -(__int128)maxSlew;
+			}
+			scale = (uint64_t)((__int128)rate + correction);
+		}
+
+		/* take the base as late as possible, to keep readers of the current parameters close to it */
+		cycles = readTSCOrdered();
+		if (error > OMRTIME_TSC_MAX_SLEW_NANOS) {
+			/* Too far behind to slew, step forward to the system clock */
+			nanos = sampleNanos + (int64_t)(((unsigned __int128)(cycles - sampleCycles) * rate) >> OMRTIME_TSC_SCALE_SHIFT);
+			Trc_PRT_time_tsc_clock_stepped(error);
+		} else {
+			nanos = scaleTSC(cycles, current->baseCycles, current->baseNanos, current->scale);
+		}
+
+		tsc->rate = rate;
+		tsc->frequency = frequency;
+		next->baseCycles = cycles;
+		next->baseNanos = nanos;
+		next->scale = scale;
+		if (tsc->resyncInterval < frequency) {
+			tsc->resyncInterval *= OMRTIME_TSC_RESYNC_GROWTH;
+			if (tsc->resyncInterval > frequency) {
+				tsc->resyncInterval = frequency;
+			}
+		}
+	} else {
+		cycles = readTSCOrdered();
+	}
+	next->resyncCycles = cycles + tsc->resyncInterval;
+
+	issueWriteBarrier();
+	tsc->sequence = sequence + 1;
+	issueWriteBarrier();
+	tsc->resyncing = 0;
+	return TRUE;
+}
+#endif /* defined(OMRTIME_USE_TSC) */
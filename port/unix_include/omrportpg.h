@@ -63,6 +63,36 @@ typedef struct OMRSTFLECache {
 	OMRSTFLEFacilities facilities;
 } OMRSTFLECache;
 
+#if defined(LINUX) && defined(J9HAMMER)
+/**
+ * Parameters of the calibrated TSC clock.  Nanoseconds are
+ * baseNanos + (((cycles - baseCycles) * scale) >> 32).
+ */
+typedef struct OMRTimeTSCParameters {
+	uint64_t baseCycles;
+	int64_t baseNanos;
+	uint64_t scale; /**< nanoseconds per cycle, 32.32 fixed point */
+	uint64_t resyncCycles; /**< cycle count at which the parameters are next compared with the system clock */
+} OMRTimeTSCParameters;
+
+/**
+ * State of the calibrated TSC clock behind omrtime_nano_time.  The parameters are
+ * published through a latch: readers use parameters[sequence & 1] while a resync
+ * fills in the other set, so a reader never waits for a resync to finish.
+ */
+typedef struct OMRTimeTSCClock {
+	volatile uintptr_t sequence; /**< incremented as each resync publishes its parameters */
+	volatile uintptr_t resyncing; /**< set while a thread computes the next parameters */
+	OMRTimeTSCParameters parameters[2];
+	uint64_t resyncInterval;
+	uint64_t startCycles; /**< calibration start, the long term rate is measured from here */
+	int64_t startNanos;
+	uint64_t rate; /**< long term nanoseconds per cycle, 32.32 fixed point */
+	volatile uint64_t frequency; /**< long term cycles per second */
+	BOOLEAN enabled;
+} OMRTimeTSCClock;
+#endif /* defined(LINUX) && defined(J9HAMMER) */
+
 typedef struct OMRPortPlatformGlobals {
 	uintptr_t numa_platform_supports_numa;
 	uintptr_t numa_platform_interleave_memory;
@@ -101,8 +131,12 @@ typedef struct OMRPortPlatformGlobals {
 	OMRCgroupEntry *cgroupEntryList; /**< head of the circular linked list, each element contains information about cgroup of the process for a subsystem */
 	uintptr_t performFullMemorySearch; /**< Always perform full range memory search even smart address can not be established */
 	BOOLEAN syscallNotAllowed; /**< Assigned True if the mempolicy syscall is failed due to security opts (Can be seen in case of docker) */
+	uintptr_t mmap_hugePageSize; /**< Transparent huge page size used to align OMRPORT_MMAP_FLAG_HUGEPAGE mappings, 0 if transparent huge pages are disabled */
 #endif /* defined(LINUX) */
 	OMRSTFLECache stfleCache;
+#if defined(LINUX) && defined(J9HAMMER)
+	OMRTimeTSCClock time_tscClock;
+#endif /* defined(LINUX) && defined(J9HAMMER) */
 } OMRPortPlatformGlobals;
 
 
@@ -150,9 +184,13 @@ typedef struct OMRPortPlatformGlobals {
 #define PPG_cgroupEntryList (portLibrary->portGlobals->platformGlobals.cgroupEntryList)
 #define PPG_numaSyscallNotAllowed (portLibrary->portGlobals->platformGlobals.syscallNotAllowed)
 #define PPG_performFullMemorySearch (portLibrary->portGlobals->platformGlobals.performFullMemorySearch)
+#define PPG_mmap_hugePageSize (portLibrary->portGlobals->platformGlobals.mmap_hugePageSize)
 #endif /* defined(LINUX) */
 
 #define PPG_stfleCache (portLibrary->portGlobals->platformGlobals.stfleCache)
+#if defined(LINUX) && defined(J9HAMMER)
+#define PPG_time_tscClock (portLibrary->portGlobals->platformGlobals.time_tscClock)
+#endif /* defined(LINUX) && defined(J9HAMMER) */
 
 #endif /* omrportpg_h */
 
@@ -43,6 +43,9 @@
 #include "omrport.h"
 
 #include "omriconvhelpers.h"
+#if defined(OMR_PORT_SOCKET_SUPPORT)
+#include "omrsockptypes.h"
+#endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
 
 #define J9ERROR_DEFAULT_BUFFER_SIZE 256 /**< default customized error message size if we need to create one */
 #define J9ERROR_MAXIMUM_BUFFER_SIZE 0xFFFFFFFF /**< maximum customized error message size if we need to create one */
@@ -65,6 +68,11 @@ typedef struct PortlibPTBuffers_struct {
 	char *reportedMessageBuffer; /**< last reported error message, either customized or from OS */
 	uintptr_t reportedMessageBufferSize; /**< reported message buffer size */
 
+#if defined(OMR_PORT_SOCKET_SUPPORT)
+	OMRAddrInfoNode addrInfoHints; /**< hints answered by omrsock_getaddrinfo_create_hints */
+	omr_os_addrinfo addrInfoHintsData; /**< storage for the hints */
+#endif /* defined(OMR_PORT_SOCKET_SUPPORT) */
+
 #if defined(J9VM_PROVIDE_ICONV)
 	iconv_t converterCache[UNCACHED_ICONV_DESCRIPTOR]; /**< Everything in J9IconvName before UNCACHED_ICONV_DESCRIPTOR is cached */
 #endif /* J9VM_PROVIDE_ICONV */
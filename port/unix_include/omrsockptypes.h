@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(OMRSOCKPTYPES_H_)
+#define OMRSOCKPTYPES_H_
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Platform types behind the opaque socket handles of @ref omrportsock.h
+ */
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+
+#include "omrcomp.h"
+
+typedef struct addrinfo omr_os_addrinfo;
+typedef struct sockaddr_storage omr_os_sockaddr_storage;
+
+/**
+ * @typedef
+ * @brief A socket created by @ref omrsock_socket or @ref omrsock_accept.
+ */
+typedef struct OMRSocket {
+	int data; /**< native socket descriptor */
+	int32_t zeroCopyState; /**< 0 until zero-copy sends are first requested, then 1 if enabled or -1 if unavailable */
+	uint32_t zeroCopySends; /**< zero-copy sends issued, the kernel numbers their completions from 0 */
+	int32_t nonBlocking; /**< 1 once @ref omrsock_fcntl has set OMRSOCK_O_NONBLOCK */
+} OMRSocket;
+
+#endif /* !defined(OMRSOCKPTYPES_H_) */
@@ -914,6 +914,39 @@ omrfile_write(struct OMRPortLibrary *portLibrary, intptr_t fd, const void *buf,
 	return offset;
 }
 
+intptr_t
+omrfile_writev(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRIOVec *iov, uint32_t iovCount)
+{
+	intptr_t total = 0;
+	uint32_t i = 0;
+
+	/* WriteFileGather needs unbuffered, page aligned I/O, so write one buffer at a time */
+	for (i = 0; i < iovCount; i++) {
+		intptr_t rc = portLibrary->file_write(portLibrary, fd, iov[i].base, (intptr_t)iov[i].length);
+		if (rc < 0) {
+			return (0 == total) ? rc : total;
+		}
+		total += rc;
+		if ((uintptr_t)rc != iov[i].length) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t inFD, int64_t inOffset, intptr_t outFD, int64_t outOffset, int64_t length)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
+int64_t
+omrfile_sendfile(struct OMRPortLibrary *portLibrary, intptr_t outFD, intptr_t inFD, int64_t inOffset, int64_t length)
+{
+	return OMRPORT_ERROR_NOT_SUPPORTED_ON_THIS_PLATFORM;
+}
+
 void
 omrfile_printf(struct OMRPortLibrary *portLibrary, intptr_t fd, const char *format, ...)
 {
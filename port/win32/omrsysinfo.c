@@ -1798,3 +1798,205 @@ omrsysinfo_cgroup_subsystem_iterator_destroy(struct OMRPortLibrary *portLibrary,
 	return;
 }
 
+int32_t
+omrsysinfo_get_cpu_list(struct OMRPortLibrary *portLibrary, uint32_t *cpuList, uintptr_t *cpuCount)
+{
+	uintptr_t processAffinity = 0;
+	uintptr_t systemAffinity = 0;
+	uintptr_t capacity = *cpuCount;
+	uintptr_t found = 0;
+	uint32_t i = 0;
+
+	/* Only the processor group of the process is visible through the affinity mask */
+	if (!GetProcessAffinityMask(GetCurrentProcess(), (PDWORD_PTR) &processAffinity, (PDWORD_PTR) &systemAffinity)) {
+		*cpuCount = 0;
+		return OMRPORT_ERROR_SYSINFO_ERROR_READING_PROCESSOR_INFO;
+	}
+	for (i = 0; i < (sizeof(uintptr_t) * 8); i++) {
+		if (0 != (processAffinity & ((uintptr_t)1 << i))) {
+			if (found < capacity) {
+				cpuList[found] = i;
+			}
+			found += 1;
+		}
+	}
+	*cpuCount = found;
+	return 0;
+}
+
+
+/**
+ * @internal
+ * Finds the lowest processor and the number of processors in an affinity mask.
+ *
+ * @param[in] mask the processor mask
+ * @param[out] lowest the lowest processor, OMRPORT_TOPOLOGY_NOT_AVAILABLE if the mask is empty
+ * @param[out] count the number of processors in the mask
+ */
+static void
+describeProcessorMask(ULONG_PTR mask, int32_t *lowest, int32_t *count)
+{
+	int32_t i = 0;
+
+	*lowest = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+	*count = 0;
+	for (i = 0; i < (int32_t)(sizeof(ULONG_PTR) * 8); i++) {
+		if (0 != (mask & ((ULONG_PTR)1 << i))) {
+			if (OMRPORT_TOPOLOGY_NOT_AVAILABLE == *lowest) {
+				*lowest = i;
+			}
+			*count += 1;
+		}
+	}
+}
+
+int32_t
+omrsysinfo_get_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION *infos = NULL;
+	DWORD length = 0;
+	DWORD infoCount = 0;
+	DWORD index = 0;
+	uintptr_t processAffinity = 0;
+	uintptr_t systemAffinity = 0;
+	int32_t cpuCount = 0;
+	int32_t package = 0;
+	int32_t cpu = 0;
+	int32_t rc = 0;
+
+	Trc_PRT_sysinfo_get_cpu_topology_Entered();
+
+	if (NULL == topology) {
+		Trc_PRT_sysinfo_get_cpu_topology_Exit(OMRPORT_ERROR_SYSINFO_NULL_OBJECT_RECEIVED, 0, 0);
+		return OMRPORT_ERROR_SYSINFO_NULL_OBJECT_RECEIVED;
+	}
+	memset(topology, 0, sizeof(OMRCPUTopology));
+
+	/* As with omrsysinfo_get_cpu_list(), only the processor group of the process is described */
+	if (!GetProcessAffinityMask(GetCurrentProcess(), (PDWORD_PTR) &processAffinity, (PDWORD_PTR) &systemAffinity)) {
+		rc = OMRPORT_ERROR_SYSINFO_ERROR_READING_PROCESSOR_INFO;
+		goto done;
+	}
+	for (cpu = 0; cpu < (int32_t)(sizeof(uintptr_t) * 8); cpu++) {
+		if (0 != (systemAffinity & ((uintptr_t)1 << cpu))) {
+			cpuCount = cpu + 1;
+		}
+	}
+
+	GetLogicalProcessorInformation(NULL, &length);
+	if ((0 == cpuCount) || (ERROR_INSUFFICIENT_BUFFER != GetLastError())) {
+		rc = OMRPORT_ERROR_SYSINFO_ERROR_READING_PROCESSOR_INFO;
+		goto done;
+	}
+	infos = portLibrary->mem_allocate_memory(portLibrary, length, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	topology->cpus = portLibrary->mem_allocate_memory(portLibrary, cpuCount * sizeof(OMRCPUTopologyEntry), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if ((NULL == infos) || (NULL == topology->cpus)) {
+		rc = OMRPORT_ERROR_SYSINFO_MEMORY_ALLOC_FAILED;
+		goto done;
+	}
+	if (!GetLogicalProcessorInformation(infos, &length)) {
+		rc = OMRPORT_ERROR_SYSINFO_ERROR_READING_PROCESSOR_INFO;
+		goto done;
+	}
+	infoCount = length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+
+	topology->cpuCount = cpuCount;
+	memset(topology->cpus, 0, cpuCount * sizeof(OMRCPUTopologyEntry));
+	for (cpu = 0; cpu < cpuCount; cpu++) {
+		OMRCPUTopologyEntry *entry = &topology->cpus[cpu];
+		intptr_t slot = 0;
+
+		entry->cpu = cpu;
+		entry->core = cpu;
+		entry->package = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+		entry->node = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+		entry->online = (0 != (systemAffinity & ((uintptr_t)1 << cpu))) ? OMRPORT_PROCINFO_PROC_ONLINE : OMRPORT_PROCINFO_PROC_OFFLINE;
+		entry->bound = (0 != (processAffinity & ((uintptr_t)1 << cpu)));
+		for (slot = 0; slot < OMRPORT_CACHE_SLOTS; slot++) {
+			entry->caches[slot].id = OMRPORT_TOPOLOGY_NOT_AVAILABLE;
+		}
+	}
+
+	for (index = 0; index < infoCount; index++) {
+		SYSTEM_LOGICAL_PROCESSOR_INFORMATION *info = &infos[index];
+		int32_t lowest = 0;
+		int32_t count = 0;
+		intptr_t slot = -1;
+
+		describeProcessorMask(info->ProcessorMask, &lowest, &count);
+		if (OMRPORT_TOPOLOGY_NOT_AVAILABLE == lowest) {
+			continue;
+		}
+		if (RelationCache == info->Relationship) {
+			CACHE_DESCRIPTOR *descriptor = &info->Cache;
+
+			if (1 == descriptor->Level) {
+				if (CacheData == descriptor->Type) {
+					slot = OMRPORT_CACHE_L1D;
+				} else if (CacheInstruction == descriptor->Type) {
+					slot = OMRPORT_CACHE_L1I;
+				}
+			} else if ((2 == descriptor->Level) && (CacheUnified == descriptor->Type)) {
+				slot = OMRPORT_CACHE_L2;
+			} else if ((3 == descriptor->Level) && (CacheUnified == descriptor->Type)) {
+				slot = OMRPORT_CACHE_L3;
+			}
+		}
+		for (cpu = lowest; cpu < cpuCount; cpu++) {
+			OMRCPUTopologyEntry *entry = &topology->cpus[cpu];
+
+			if (0 == (info->ProcessorMask & ((ULONG_PTR)1 << cpu))) {
+				continue;
+			}
+			switch (info->Relationship) {
+			case RelationProcessorCore:
+				entry->core = lowest;
+				break;
+			case RelationProcessorPackage:
+				entry->package = package;
+				break;
+			case RelationNumaNode:
+				entry->node = (int32_t)info->NumaNode.NodeNumber;
+				break;
+			case RelationCache:
+				if (slot >= 0) {
+					OMRCacheInfo *cache = &entry->caches[slot];
+
+					cache->size = info->Cache.Size;
+					cache->lineSize = info->Cache.LineSize;
+					cache->associativity = (CACHE_FULLY_ASSOCIATIVE == info->Cache.Associativity) ? 0 : info->Cache.Associativity;
+					cache->id = lowest;
+					cache->sharingCount = count;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		if (RelationProcessorPackage == info->Relationship) {
+			package += 1;
+		}
+	}
+
+	omrsysinfo_count_cpu_topology(topology);
+
+done:
+	if (NULL != infos) {
+		portLibrary->mem_free_memory(portLibrary, infos);
+	}
+	if (0 != rc) {
+		portLibrary->sysinfo_destroy_cpu_topology(portLibrary, topology);
+	}
+	Trc_PRT_sysinfo_get_cpu_topology_Exit(rc, topology->cpuCount, topology->boundCount);
+	return rc;
+}
+
+void
+omrsysinfo_destroy_cpu_topology(struct OMRPortLibrary *portLibrary, struct OMRCPUTopology *topology)
+{
+	if ((NULL != topology) && (NULL != topology->cpus)) {
+		portLibrary->mem_free_memory(portLibrary, topology->cpus);
+		topology->cpus = NULL;
+		topology->cpuCount = 0;
+	}
+}
@@ -306,3 +306,20 @@ omrtime_startup(struct OMRPortLibrary *portLibrary)
 	return init_timer();
 }
 
+uint64_t
+omrtime_cycle_clock(struct OMRPortLibrary *portLibrary)
+{
+	return portLibrary->time_hires_clock(portLibrary);
+}
+
+uint64_t
+omrtime_cycle_frequency(struct OMRPortLibrary *portLibrary)
+{
+	return portLibrary->time_hires_frequency(portLibrary);
+}
+
+uint64_t
+omrtime_cycles_to_nanos(struct OMRPortLibrary *portLibrary, uint64_t cycles)
+{
+	return portLibrary->time_hires_delta(portLibrary, 0, cycles, OMRPORT_TIME_DELTA_IN_NANOSECONDS);
+}
@@ -188,3 +188,15 @@ omrmmap_dont_need(struct OMRPortLibrary *portLibrary, const void *startAddress,
 		}
 	}
 }
+
+intptr_t
+omrmmap_advise(struct OMRPortLibrary *portLibrary, void *start, uintptr_t length, uint32_t advice)
+{
+	return OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+}
+
+intptr_t
+omrmmap_prefetch(struct OMRPortLibrary *portLibrary, J9MmapHandle *handle, uintptr_t offset, uintptr_t length)
+{
+	return OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+}
@@ -186,3 +186,15 @@ omrmmap_dont_need(struct OMRPortLibrary *portLibrary, const void *startAddress,
         return;
 }
 
+
+IDATA
+omrmmap_advise(struct OMRPortLibrary *portLibrary, void *start, UDATA length, U_32 advice)
+{
+	return OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+}
+
+IDATA
+omrmmap_prefetch(struct OMRPortLibrary *portLibrary, J9MmapHandle *handle, UDATA offset, UDATA length)
+{
+	return OMRPORT_ERROR_MMAP_ADVISE_UNSUPPORTED;
+}
@@ -84,7 +84,7 @@ static intptr_t init_spinParameters(omrthread_library_t lib);
 
 static void threadInterrupt(omrthread_t thread, uintptr_t interruptFlag);
 static void threadInterruptWake(omrthread_t thread, omrthread_monitor_t monitor);
-static void threadNotify(omrthread_t threadToNotify);
+static void threadNotify(omrthread_t threadToNotify, omrthread_monitor_t monitor);
 static int32_t J9THREAD_PROC interruptServer(void *entryArg);
 static intptr_t interrupt_waiting_thread(omrthread_t self, omrthread_t threadToInterrupt);
 
@@ -189,6 +189,13 @@ omrthread_t global_lock_owner = UNOWNED;
 	} while (0)
 #endif /* defined(OMR_OS_WINDOWS) || !defined(OMR_NOTIFY_POLICY_CONTROL) */
 
+#if defined(OMR_THR_FUTEX)
+/* Move the notified thread straight onto the monitor's mutex rather than waking it to block on it */
+#define NOTIFY_REQUEUE_WRAPPER(thread, monitor) OMROSCOND_NOTIFY_REQUEUE(MONITOR_WAIT_CONDITION((thread), (monitor)), (monitor)->mutex)
+#else /* defined(OMR_THR_FUTEX) */
+#define NOTIFY_REQUEUE_WRAPPER(thread, monitor) NOTIFY_WRAPPER(thread)
+#endif /* defined(OMR_THR_FUTEX) */
+
 /*
  * Thread Library
  */
@@ -305,6 +312,8 @@ omrthread_init(omrthread_library_t lib)
 		goto init_cleanup8;
 	}
 
+	omrthread_rwmutex_init_reader_slots(lib);
+
 	lib->global_pool = pool_new(sizeof(J9ThreadGlobal), 0, 0, 0, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_THREADS, omrthread_mallocWrapper, omrthread_freeWrapper, lib);
 	if (lib->global_pool == NULL) {
 		goto init_cleanup9;
@@ -353,7 +362,8 @@ omrthread_init(omrthread_library_t lib)
 init_cleanup11:		omrthread_attr_destroy(&lib->systemThreadAttr);
 #endif /* defined(OSX) */
 init_cleanup10:		pool_kill(lib->global_pool);
-init_cleanup9:		pool_kill(lib->thread_pool);
+init_cleanup9:		omrthread_rwmutex_free_reader_slots(lib);
+					pool_kill(lib->thread_pool);
 init_cleanup8:		OMROSMUTEX_DESTROY(lib->resourceUsageMutex);
 init_cleanup7:		OMROSMUTEX_DESTROY(lib->global_mutex);
 init_cleanup6:		OMROSMUTEX_DESTROY(lib->tls_mutex);
@@ -648,6 +658,12 @@ init_spinParameters(omrthread_library_t lib)
 	if (init_threadParam("adaptSpinSampleCountStopRatio", &lib->adaptSpinSampleCountStopRatio)) {
 		return -1;
 	}
+
+	/* Per-monitor spin budgets (see omrthread_spinlock_acquire) are on unless this is set to 0 */
+	lib->adaptSpinBudget = 1;
+	if (init_threadParam("adaptSpinBudget", &lib->adaptSpinBudget)) {
+		return -1;
+	}
 #endif
 
 #if (defined(OMR_THR_YIELD_ALG))
@@ -713,9 +729,13 @@ omrthread_shutdown(void)
 	free_monitor_pools();
 
 	TLS_DESTROY(lib->self_ptr);
+	NATIVE_SELF_SET(NULL);
+
+	omrthread_lock_order_free(lib);
 
 	pool_kill(lib->thread_pool);
 	lib->thread_pool = 0;
+	omrthread_rwmutex_free_reader_slots(lib);
 #if defined(OMR_THR_FORK_SUPPORT)
 	pool_kill(lib->rwmutexPool);
 #endif /* defined(OMR_THR_FORK_SUPPORT) */
@@ -1333,6 +1353,7 @@ omrthread_attach_ex(omrthread_t *handle, omrthread_attr_t *attr)
 	initialize_thread_priority(thread);
 
 	TLS_SET(lib->self_ptr, thread);
+	NATIVE_SELF_SET(thread);
 
 	thread->tid = omrthread_get_ras_tid();
 	thread->waitNumber = 0;
@@ -1514,6 +1535,7 @@ omrthread_detach(omrthread_t thread)
 			threadDestroy(thread, GLOBAL_NOT_LOCKED);
 		}
 		TLS_SET(library->self_ptr, NULL);
+		NATIVE_SELF_SET(NULL);
 	}
 }
 
@@ -1628,6 +1650,7 @@ thread_wrapper(WRAPPER_ARG arg)
 	thread->tid = omrthread_get_ras_tid();
 
 	TLS_SET(lib->self_ptr, thread);
+	NATIVE_SELF_SET(thread);
 
 #if defined(OMR_OS_WINDOWS)
 	if (lib->stack_usage) {
@@ -1945,6 +1968,8 @@ threadCreate(omrthread_t *handle, const omrthread_attr_t *attr, uintptr_t suspen
 
 #if defined(OMR_PORT_NUMA_SUPPORT)
 	memset(&(thread->numaAffinity), 0x0, sizeof(thread->numaAffinity));
+	/* The chosen node is only recorded in the affinity cache here; thread_wrapper binds the thread once it starts. */
+	omrthread_numa_place_thread(thread, tempAttr->numaPlacement, tempAttr->numaColocateWith);
 #endif /* OMR_PORT_NUMA_SUPPORT */
 
 #if defined(OMR_THR_MCS_LOCKS)
@@ -2038,6 +2063,12 @@ copyAttr(omrthread_attr_t *attrTo, const omrthread_attr_t *attrFrom)
 			goto destroyAttr;
 		}
 	}
+	if (((*attrTo)->numaPlacement != (*attrFrom)->numaPlacement) || ((*attrTo)->numaColocateWith != (*attrFrom)->numaColocateWith)) {
+		if (failedToSetAttr(omrthread_attr_set_numa_placement(attrTo, (*attrFrom)->numaPlacement, (*attrFrom)->numaColocateWith))) {
+			rc = J9THREAD_ERR_INVALID_ATTR;
+			goto destroyAttr;
+		}
+	}
 
 	return rc;
 	
@@ -2079,6 +2110,7 @@ threadAllocate(omrthread_library_t lib, int globalIsLocked)
 #if defined(J9ZOS390)
 		newThread->os_errno2 = 0;
 #endif /* J9ZOS390 */
+		omrthread_rwmutex_attach_reader_slots(lib, newThread);
 #if defined(OMR_THR_JLM)
 		if (newThread) {
 			if (IS_JLM_ENABLED(newThread)) {
@@ -2198,6 +2230,10 @@ threadFree(omrthread_t thread, int globalAlreadyLocked)
 	jlm_thread_free(lib, thread);
 #endif
 
+	omrthread_rwmutex_detach_reader_slots(lib, thread);
+#if defined(OMR_PORT_NUMA_SUPPORT)
+	omrthread_numa_release_thread(thread);
+#endif /* OMR_PORT_NUMA_SUPPORT */
 	pool_removeElement(lib->thread_pool, thread);
 	lib->threadCount--;
 
@@ -2283,11 +2319,13 @@ threadInternalExit(int globalAlreadyLocked)
 		GLOBAL_UNLOCK_SIMPLE(lib);
 		if (detached) {
 			TLS_SET(tlsKey, NULL);
+			NATIVE_SELF_SET(NULL);
 		}
 	}
 #else /* THREAD_ASSERTS */
 	if (detached) {
 		TLS_SET(lib->self_ptr, NULL);
+		NATIVE_SELF_SET(NULL);
 	}
 	GLOBAL_UNLOCK_SIMPLE(lib);
 #endif /* THREAD_ASSERTS */
@@ -3206,18 +3244,18 @@ threadEnqueue(omrthread_t *queue, omrthread_t thread)
  * @note: assumes the caller has THREAD_LOCK'd the
  * thread being notified (and owns the monitor being notified on)
  * @param[in] threadToNotify thread to notify
- * @param[in] setNotifiedFlag indicates whether to set the notified thread's notified flag.
+ * @param[in] monitor the monitor that the thread is waiting on
  * @return none
  */
 static void
-threadNotify(omrthread_t threadToNotify)
+threadNotify(omrthread_t threadToNotify, omrthread_monitor_t monitor)
 {
 	ASSERT(threadToNotify);
 	ASSERT(threadToNotify->flags & J9THREAD_FLAG_WAITING);
 
 	threadToNotify->flags &= ~J9THREAD_FLAG_WAITING;
 	threadToNotify->flags |= J9THREAD_FLAG_BLOCKED | J9THREAD_FLAG_NOTIFIED;
-	NOTIFY_WRAPPER(threadToNotify);
+	NOTIFY_REQUEUE_WRAPPER(threadToNotify, monitor);
 }
 
 /**
@@ -3716,6 +3754,11 @@ monitor_init(omrthread_monitor_t monitor, uintptr_t flags, omrthread_library_t l
 	monitor->userData = 0;
 	monitor->name = NULL;
 	monitor->pinCount = 0;
+	if (NULL != monitor->contention) {
+		/* The record belongs to the pool entry; start the new monitor with an empty one */
+		memset(monitor->contention, 0, sizeof(J9ThreadMonitorContention));
+	}
+	monitor->lockOrderClass = 0;
 
 #if defined(OMR_THR_CUSTOM_SPIN_OPTIONS)
 	monitor->customSpinOptions = NULL;
@@ -3740,6 +3783,13 @@ monitor_init(omrthread_monitor_t monitor, uintptr_t flags, omrthread_library_t l
 #if defined(OMR_THR_SPIN_WAKE_CONTROL)
 	monitor->spinThreads = 0;
 #endif /* defined(OMR_THR_SPIN_WAKE_CONTROL) */
+#if defined(OMR_THR_ADAPTIVE_SPIN)
+	/* Start with the full static budget; it is clamped to the spin counts on use */
+	monitor->spinBudget = UDATA_MAX;
+	monitor->spinHoldEstimate = 0;
+	monitor->spinSuccessRate = OMRTHREAD_ADAPT_SPIN_RATE_ONE;
+	monitor->spinProbeCounter = 0;
+#endif /* defined(OMR_THR_ADAPTIVE_SPIN) */
 
 	ASSERT(monitor->spinCount1 != 0);
 	ASSERT(monitor->spinCount2 != 0);
@@ -3923,12 +3973,18 @@ omrthread_monitor_enter_abortable_using_threadId(omrthread_monitor_t monitor, om
 static intptr_t
 monitor_enter(omrthread_t self, omrthread_monitor_t monitor)
 {
+	uint64_t blockedSince = 0;
+
 	ASSERT(self);
 	ASSERT(0 == self->monitor);
 	ASSERT(monitor);
 	ASSERT(monitor->owner != self);
 	ASSERT(FREE_TAG != monitor->count);
 
+	if (IS_LOCK_ORDER_TRACKING_ENABLED(self->library)) {
+		omrthread_lock_order_check(self, monitor);
+	}
+
 	self->lockedmonitorcount++; /* one more locked monitor on this thread */
 
 	THREAD_LOCK(self, CALLER_MONITOR_ENTER1);
@@ -3936,7 +3992,14 @@ monitor_enter(omrthread_t self, omrthread_monitor_t monitor)
 	self->monitor = monitor;
 	THREAD_UNLOCK(self);
 
-	MONITOR_LOCK(monitor, CALLER_MONITOR_ENTER);
+	if (IS_CONTENTION_PROFILE_ENABLED(self->library)) {
+		if (0 != MONITOR_TRY_LOCK(monitor)) {
+			blockedSince = omrthread_get_hires_clock();
+			MONITOR_LOCK(monitor, CALLER_MONITOR_ENTER);
+		}
+	} else {
+		MONITOR_LOCK(monitor, CALLER_MONITOR_ENTER);
+	}
 
 	UPDATE_JLM_MON_ENTER(self, monitor, !IS_RECURSIVE_ENTER, IS_SLOW_ENTER);
 
@@ -3950,6 +4013,14 @@ monitor_enter(omrthread_t self, omrthread_monitor_t monitor)
 	monitor->owner = self;
 	monitor->count = 1;
 
+	if (0 != blockedSince) {
+		omrthread_contention_record_enter(self, monitor, blockedSince);
+	}
+
+	if (IS_LOCK_ORDER_TRACKING_ENABLED(self->library)) {
+		omrthread_lock_order_push(self, monitor);
+	}
+
 	ASSERT(0 == self->monitor);
 
 	return 0;
@@ -3973,6 +4044,7 @@ static intptr_t
 monitor_enter_three_tier(omrthread_t self, omrthread_monitor_t monitor, BOOLEAN isAbortable)
 {
 	int blockedCount = 0;
+	uint64_t blockedSince = 0;
 #if defined(OMR_THR_MCS_LOCKS)
 	omrthread_mcs_node_t mcsNode = omrthread_mcs_node_allocate(self);
 #endif /* defined(OMR_THR_MCS_LOCKS) */
@@ -3984,6 +4056,10 @@ monitor_enter_three_tier(omrthread_t self, omrthread_monitor_t monitor, BOOLEAN
 	ASSERT(monitor->owner != self);
 	ASSERT(FREE_TAG != monitor->count);
 
+	if (IS_LOCK_ORDER_TRACKING_ENABLED(self->library)) {
+		omrthread_lock_order_check(self, monitor);
+	}
+
 	while (1) {
 #if defined(OMR_THR_MCS_LOCKS)
 		if (0 == omrthread_mcs_lock(self, monitor, mcsNode, (blockedCount != 0)))
@@ -4010,6 +4086,9 @@ monitor_enter_three_tier(omrthread_t self, omrthread_monitor_t monitor, BOOLEAN
 		}
 #endif /* !defined(OMR_THR_MCS_LOCKS) */
 
+		if ((0 == blockedCount) && IS_CONTENTION_PROFILE_ENABLED(self->library)) {
+			blockedSince = omrthread_get_hires_clock();
+		}
 		blockedCount++;
 
 		THREAD_LOCK(self, CALLER_MONITOR_ENTER_THREE_TIER2);
@@ -4101,6 +4180,14 @@ monitor_enter_three_tier(omrthread_t self, omrthread_monitor_t monitor, BOOLEAN
 
 	UPDATE_JLM_MON_ENTER(self, monitor, !IS_RECURSIVE_ENTER, (blockedCount > 0));
 
+	if (0 != blockedSince) {
+		omrthread_contention_record_enter(self, monitor, blockedSince);
+	}
+
+	if (IS_LOCK_ORDER_TRACKING_ENABLED(self->library)) {
+		omrthread_lock_order_push(self, monitor);
+	}
+
 	ASSERT(!(self->flags & J9THREAD_FLAG_BLOCKED));
 	ASSERT(0 == self->monitor);
 
@@ -4232,6 +4319,11 @@ omrthread_monitor_try_enter_using_threadId(omrthread_monitor_t monitor, omrthrea
 
 		UPDATE_JLM_MON_ENTER(threadId, monitor, !IS_RECURSIVE_ENTER, !IS_SLOW_ENTER);
 
+		/* a try-enter cannot deadlock, so it adds no edges, but later enters are ordered after it */
+		if (IS_LOCK_ORDER_TRACKING_ENABLED(threadId->library)) {
+			omrthread_lock_order_push(threadId, monitor);
+		}
+
 		return 0;
 	}
 
@@ -4340,6 +4432,9 @@ monitor_exit(omrthread_t self, omrthread_monitor_t monitor)
 		self->lockedmonitorcount--; /* one less locked monitor on this thread */
 		monitor->owner = NULL;
 		UPDATE_JLM_MON_EXIT(self, monitor);
+		if (0 != self->lockOrderHeldCount) {
+			omrthread_lock_order_pop(self, monitor);
+		}
 
 #if defined(OMR_THR_THREE_TIER_LOCKING)
 #if defined(OMR_THR_MCS_LOCKS)
@@ -4516,16 +4611,28 @@ static intptr_t
 monitor_wait(omrthread_monitor_t monitor, int64_t millis, intptr_t nanos, uintptr_t interruptible)
 {
 	omrthread_t self = MACRO_SELF();
+	uint64_t waitingSince = 0;
+	intptr_t rc = 0;
+
+	if (IS_CONTENTION_PROFILE_ENABLED(self->library)) {
+		waitingSince = omrthread_get_hires_clock();
+	}
 
 #if defined(OMR_THR_THREE_TIER_LOCKING)
 	if (self->library->flags & J9THREAD_LIB_FLAG_FAST_NOTIFY) {
-		return monitor_wait_three_tier(self, monitor, millis, nanos, interruptible);
+		rc = monitor_wait_three_tier(self, monitor, millis, nanos, interruptible);
 	} else {
-		return monitor_wait_original(self, monitor, millis, nanos, interruptible);
+		rc = monitor_wait_original(self, monitor, millis, nanos, interruptible);
 	}
 #else
-	return monitor_wait_original(self, monitor, millis, nanos, interruptible);
+	rc = monitor_wait_original(self, monitor, millis, nanos, interruptible);
 #endif
+
+	/* Only record waits after which the monitor is owned again */
+	if ((0 != waitingSince) && (J9THREAD_INVALID_ARGUMENT != rc) && (monitor->owner == self)) {
+		omrthread_contention_record_wait(self, monitor, waitingSince);
+	}
+	return rc;
 }
 
 /*
@@ -5190,7 +5297,7 @@ monitor_notify_original(omrthread_t self, omrthread_monitor_t monitor, int notif
 		next = queue->next;
 		THREAD_LOCK(queue, CALLER_NOTIFY_ONE_OR_ALL);
 		if (queue->flags & J9THREAD_FLAG_WAITING) {
-			threadNotify(queue);
+			threadNotify(queue, monitor);
 			Trc_THR_ThreadMonitorNotifyThreadNotified(self, queue, monitor);
 			someoneNotified = 1;
 		}
@@ -5387,6 +5494,7 @@ free_monitor_pools(void)
 				OMROSMUTEX_DESTROY(entry->mutex);
 			}
 		}
+		omrthread_contention_free_records(lib, pool);
 		omrthread_free_memory(lib, pool);
 		pool = next;
 	}
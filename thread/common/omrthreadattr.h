@@ -40,6 +40,8 @@ typedef struct omrthread_attr {
 	omrthread_prio_t priority; /* ignored if schedpolicy == INHERIT. */
 	omrthread_detachstate_t detachstate;
 	const char *name;
+	omrthread_numa_placement_t numaPlacement;
+	omrthread_t numaColocateWith; /* only used with J9THREAD_NUMA_PLACEMENT_COLOCATE */
 } omrthread_attr;
 
 #ifdef __cplusplus
@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Thread
+ * @brief Monitor contention profiler
+ */
+
+#include <string.h>
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrthread.h"
+#include "threaddef.h"
+#include "thread_internal.h"
+
+static J9ThreadMonitorContention *contention_record(omrthread_library_t lib, omrthread_monitor_t monitor);
+static uintptr_t contention_bucket(uint64_t elapsed);
+
+/**
+ * Start recording contention on every monitor.
+ *
+ * Each time a thread blocks entering a monitor, or waits on one, the time until it owns
+ * the monitor again is added to a log2 histogram kept with the monitor. Monitors that
+ * never block carry no profiling state.
+ *
+ * @param[in] callSiteSampleInterval sample the call site of every Nth blocked enter on a monitor, 0 for never
+ * @param[in] sampler call stack sampler, or NULL not to sample call sites
+ * @param[in] userData passed to sampler
+ * @return 0 on success
+ */
+intptr_t
+omrthread_contention_profile_enable(uintptr_t callSiteSampleInterval, omrthread_contention_sampler_t sampler, void *userData)
+{
+	omrthread_t self = MACRO_SELF();
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+
+	ASSERT(self);
+	ASSERT(lib);
+
+	GLOBAL_LOCK(self, CALLER_CONTENTION_PROFILE);
+	lib->contentionSampler = (0 == callSiteSampleInterval) ? NULL : sampler;
+	lib->contentionSamplerUserData = userData;
+	lib->contentionSampleInterval = callSiteSampleInterval;
+	issueWriteBarrier();
+	lib->flags |= J9THREAD_LIB_FLAG_CONTENTION_PROFILE_ENABLED;
+	GLOBAL_UNLOCK(self);
+
+	return 0;
+}
+
+/**
+ * Stop recording contention. The data recorded so far remains available.
+ */
+void
+omrthread_contention_profile_disable(void)
+{
+	omrthread_t self = MACRO_SELF();
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+
+	ASSERT(self);
+	ASSERT(lib);
+
+	GLOBAL_LOCK(self, CALLER_CONTENTION_PROFILE);
+	lib->flags &= ~J9THREAD_LIB_FLAG_CONTENTION_PROFILE_ENABLED;
+	GLOBAL_UNLOCK(self);
+}
+
+/**
+ * Discard the contention recorded so far for every monitor.
+ */
+void
+omrthread_contention_profile_reset(void)
+{
+	omrthread_monitor_walk_state_t walkState;
+	omrthread_monitor_t monitor = NULL;
+
+	omrthread_monitor_init_walk(&walkState);
+	while (NULL != (monitor = omrthread_monitor_walk(&walkState))) {
+		if (NULL != monitor->contention) {
+			memset(monitor->contention, 0, sizeof(J9ThreadMonitorContention));
+		}
+	}
+}
+
+/**
+ * Copy out the monitors that threads have spent the most time blocked entering.
+ *
+ * The records are a snapshot taken while the monitors may still be in use, so the
+ * fields of a record need not be mutually consistent. The name of a record is only
+ * valid while its monitor is not destroyed.
+ *
+ * @param[out] records array to receive the monitors, most contended first
+ * @param[in] maxRecords capacity of records
+ * @return the number of records filled in
+ */
+uintptr_t
+omrthread_contention_profile_dump(J9ThreadMonitorContentionInfo *records, uintptr_t maxRecords)
+{
+	omrthread_monitor_walk_state_t walkState;
+	omrthread_monitor_t monitor = NULL;
+	uintptr_t count = 0;
+
+	omrthread_monitor_init_walk(&walkState);
+	while (NULL != (monitor = omrthread_monitor_walk(&walkState))) {
+		J9ThreadMonitorContention *record = monitor->contention;
+		uint64_t blockedTime = 0;
+		uintptr_t slot = 0;
+
+		if ((NULL == record) || (0 == record->blockedEnterCount) || (0 == maxRecords)) {
+			continue;
+		}
+
+		/* Insertion sort into the caller's array, dropping the least contended when it is full */
+		blockedTime = record->blockedEnterTime;
+		slot = count;
+		while ((slot > 0) && (records[slot - 1].contention.blockedEnterTime < blockedTime)) {
+			if (slot < maxRecords) {
+				records[slot] = records[slot - 1];
+			}
+			slot -= 1;
+		}
+		if (slot < maxRecords) {
+			records[slot].monitor = monitor;
+			records[slot].name = monitor->name;
+			records[slot].contention = *record;
+			/* Keep the copy consistent with the order it was sorted into */
+			records[slot].contention.blockedEnterTime = blockedTime;
+			if (count < maxRecords) {
+				count += 1;
+			}
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Record a blocked monitor enter. The caller owns the monitor, which serializes
+ * updates to its contention record.
+ *
+ * @param[in] self the current thread
+ * @param[in] monitor the monitor entered
+ * @param[in] blockedSince hires clock time at which self started blocking
+ */
+void
+omrthread_contention_record_enter(omrthread_t self, omrthread_monitor_t monitor, uint64_t blockedSince)
+{
+	omrthread_library_t lib = self->library;
+	J9ThreadMonitorContention *record = contention_record(lib, monitor);
+
+	if (NULL != record) {
+		uint64_t elapsed = omrthread_hires_delta_nanos(blockedSince, omrthread_get_hires_clock());
+		omrthread_contention_sampler_t sampler = lib->contentionSampler;
+		uintptr_t interval = lib->contentionSampleInterval;
+
+		record->blockedEnterCount += 1;
+		record->blockedEnterTime += elapsed;
+		if (elapsed > record->maxBlockedEnterTime) {
+			record->maxBlockedEnterTime = elapsed;
+		}
+		record->blockedEnterHistogram[contention_bucket(elapsed)] += 1;
+
+		/* Sample the first blocked enter, then every Nth */
+		if ((NULL != sampler) && (0 != interval) && (0 == ((record->blockedEnterCount - 1) % interval))) {
+			record->callSiteFrameCount = sampler(lib->contentionSamplerUserData, record->callSite, J9THREAD_CONTENTION_CALLSITE_FRAMES);
+		}
+	}
+}
+
+/**
+ * Record a monitor wait. The caller owns the monitor again, which serializes
+ * updates to its contention record.
+ *
+ * @param[in] self the current thread
+ * @param[in] monitor the monitor waited on
+ * @param[in] waitingSince hires clock time at which self started waiting
+ */
+void
+omrthread_contention_record_wait(omrthread_t self, omrthread_monitor_t monitor, uint64_t waitingSince)
+{
+	J9ThreadMonitorContention *record = contention_record(self->library, monitor);
+
+	if (NULL != record) {
+		uint64_t elapsed = omrthread_hires_delta_nanos(waitingSince, omrthread_get_hires_clock());
+
+		record->waitCount += 1;
+		record->waitTime += elapsed;
+		record->waitHistogram[contention_bucket(elapsed)] += 1;
+	}
+}
+
+/**
+ * Free the contention records of a monitor pool that is being discarded.
+ *
+ * @param[in] lib the thread library
+ * @param[in] pool the monitor pool
+ */
+void
+omrthread_contention_free_records(omrthread_library_t lib, omrthread_monitor_pool_t pool)
+{
+	uintptr_t i = 0;
+
+	for (i = 0; i < MONITOR_POOL_SIZE; i++) {
+		if (NULL != pool->entries[i].contention) {
+			omrthread_free_memory(lib, pool->entries[i].contention);
+			pool->entries[i].contention = NULL;
+		}
+	}
+}
+
+/**
+ * Get the contention record of a monitor, allocating it on first use. A record stays
+ * with its monitor pool entry across destroy and reuse, so a concurrent dump never
+ * sees it freed.
+ *
+ * @param[in] lib the thread library
+ * @param[in] monitor a monitor owned by the current thread
+ * @return the record, or NULL if it could not be allocated
+ */
+static J9ThreadMonitorContention *
+contention_record(omrthread_library_t lib, omrthread_monitor_t monitor)
+{
+	J9ThreadMonitorContention *record = monitor->contention;
+
+	if (NULL == record) {
+		record = (J9ThreadMonitorContention *)omrthread_allocate_memory(lib, sizeof(J9ThreadMonitorContention), OMRMEM_CATEGORY_THREADS);
+		if (NULL != record) {
+			memset(record, 0, sizeof(J9ThreadMonitorContention));
+			issueWriteBarrier();
+			monitor->contention = record;
+		}
+	}
+	return record;
+}
+
+/**
+ * @param[in] elapsed an interval in nanoseconds
+ * @return the histogram bucket of the interval
+ */
+static uintptr_t
+contention_bucket(uint64_t elapsed)
+{
+	uint64_t micros = elapsed / 1000;
+	uintptr_t bucket = 0;
+
+	while ((0 != micros) && (bucket < (J9THREAD_CONTENTION_HISTOGRAM_BUCKETS - 1))) {
+		micros >>= 1;
+		bucket += 1;
+	}
+	return bucket;
+}
@@ -0,0 +1,481 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Thread
+ * @brief Lock-order tracker
+ *
+ * Monitors are grouped into classes by name, so every instance of a named monitor
+ * shares one node of the lock-order graph. Before a thread enters a monitor, an edge
+ * is added from the class of each tracked monitor it holds to the class of the monitor
+ * being entered. A new edge that closes a cycle is a lock-order inversion, which is
+ * reported once, before the thread can block.
+ *
+ * Edges are published in a hash table that is searched without locking, so a thread
+ * only takes the graph mutex the first time it sees a particular pair of classes.
+ */
+
+#include <string.h>
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrthread.h"
+#include "omrutilbase.h"
+#include "threaddef.h"
+#include "thread_internal.h"
+
+#define J9THREAD_LOCK_ORDER_CLASS_BITS 10
+#define J9THREAD_LOCK_ORDER_CLASSES ((uintptr_t)1 << J9THREAD_LOCK_ORDER_CLASS_BITS)
+#define J9THREAD_LOCK_ORDER_EDGE_BITS 11
+#define J9THREAD_LOCK_ORDER_EDGES ((uintptr_t)1 << J9THREAD_LOCK_ORDER_EDGE_BITS)
+/* Stop adding to the open-addressed tables once they are three quarters full */
+#define J9THREAD_LOCK_ORDER_TABLE_LIMIT(size) (((size) / 4) * 3)
+
+/* Value of J9ThreadMonitor.lockOrderClass for monitors that are not tracked */
+#define J9THREAD_LOCK_ORDER_UNTRACKED UDATA_MAX
+
+typedef struct J9ThreadLockOrderClass {
+	char *name;
+	uintptr_t hash;
+	uintptr_t firstEdge; /* index + 1 of the first edge out of this class, 0 if none */
+} J9ThreadLockOrderClass;
+
+typedef struct J9ThreadLockOrderEdgeRecord {
+	volatile uintptr_t key; /* 0 until the record is published */
+	uintptr_t from;
+	uintptr_t to;
+	uintptr_t nextEdge; /* index + 1 of the next edge out of the same class */
+	uintptr_t inverted;
+	uintptr_t frameCount;
+	void *frames[J9THREAD_LOCK_ORDER_FRAMES];
+} J9ThreadLockOrderEdgeRecord;
+
+typedef struct J9ThreadLockOrderGraph {
+	J9OSMutex mutex;
+	uintptr_t classCount;
+	uintptr_t edgeCount;
+	J9ThreadLockOrderClass classes[J9THREAD_LOCK_ORDER_CLASSES];
+	J9ThreadLockOrderEdgeRecord edges[J9THREAD_LOCK_ORDER_EDGES];
+	/* cycle search state, used with mutex held */
+	uint8_t visited[J9THREAD_LOCK_ORDER_CLASSES];
+	uintptr_t searchEdge[J9THREAD_LOCK_ORDER_CLASSES];
+	uintptr_t pathEdge[J9THREAD_LOCK_ORDER_CLASSES];
+} J9ThreadLockOrderGraph;
+
+static uintptr_t lock_order_class(J9ThreadLockOrderGraph *graph, omrthread_monitor_t monitor);
+static uintptr_t lock_order_edge_key(uintptr_t from, uintptr_t to);
+static uintptr_t lock_order_edge_slot(uintptr_t key);
+static BOOLEAN lock_order_has_edge(J9ThreadLockOrderGraph *graph, uintptr_t from, uintptr_t to);
+static BOOLEAN lock_order_add_edge(J9ThreadLockOrderGraph *graph, uintptr_t from, uintptr_t to, void **frames, uintptr_t frameCount, J9ThreadLockOrderInversion *inversion, void **conflictFrames);
+static uintptr_t lock_order_find_path(J9ThreadLockOrderGraph *graph, uintptr_t start, uintptr_t target);
+
+/**
+ * Start tracking the order in which named monitors are entered.
+ *
+ * Monitors without a name are not tracked. The graph persists until the thread library
+ * shuts down; enabling again continues to add to it.
+ *
+ * @param[in] sampler call stack sampler, called when a new edge is seen and when an inversion is found, or NULL
+ * @param[in] report called for each newly found inversion, or NULL
+ * @param[in] userData passed to sampler and report
+ * @return 0 on success, or J9THREAD_ERR_NOMEMORY if the graph could not be allocated
+ */
+intptr_t
+omrthread_lock_order_enable(omrthread_contention_sampler_t sampler, omrthread_lock_order_report_t report, void *userData)
+{
+	omrthread_t self = MACRO_SELF();
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+	intptr_t rc = 0;
+
+	ASSERT(self);
+	ASSERT(lib);
+
+	GLOBAL_LOCK(self, CALLER_LOCK_ORDER);
+	if (NULL == lib->lockOrderGraph) {
+		J9ThreadLockOrderGraph *graph = omrthread_allocate_memory(lib, sizeof(J9ThreadLockOrderGraph), OMRMEM_CATEGORY_THREADS);
+		if (NULL != graph) {
+			memset(graph, 0, sizeof(J9ThreadLockOrderGraph));
+			if (OMROSMUTEX_INIT(graph->mutex)) {
+				lib->lockOrderGraph = graph;
+			} else {
+				omrthread_free_memory(lib, graph);
+			}
+		}
+	}
+	if (NULL == lib->lockOrderGraph) {
+		rc = J9THREAD_ERR_NOMEMORY;
+	} else {
+		lib->lockOrderSampler = sampler;
+		lib->lockOrderReport = report;
+		lib->lockOrderUserData = userData;
+		issueWriteBarrier();
+		lib->flags |= J9THREAD_LIB_FLAG_LOCK_ORDER_ENABLED;
+	}
+	GLOBAL_UNLOCK(self);
+
+	return rc;
+}
+
+/**
+ * Stop tracking monitor order. The graph recorded so far remains available.
+ */
+void
+omrthread_lock_order_disable(void)
+{
+	omrthread_t self = MACRO_SELF();
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+
+	ASSERT(self);
+	ASSERT(lib);
+
+	GLOBAL_LOCK(self, CALLER_LOCK_ORDER);
+	lib->flags &= ~J9THREAD_LIB_FLAG_LOCK_ORDER_ENABLED;
+	GLOBAL_UNLOCK(self);
+}
+
+/**
+ * Copy out the edges of the lock-order graph, for example to render it with graphviz.
+ * The names are valid until the thread library shuts down.
+ *
+ * @param[out] edges array to receive the edges
+ * @param[in] maxEdges capacity of edges
+ * @return the number of edges in the graph, which may exceed maxEdges
+ */
+uintptr_t
+omrthread_lock_order_export(J9ThreadLockOrderEdge *edges, uintptr_t maxEdges)
+{
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+	J9ThreadLockOrderGraph *graph = lib->lockOrderGraph;
+	uintptr_t count = 0;
+	uintptr_t i = 0;
+
+	if (NULL == graph) {
+		return 0;
+	}
+
+	OMROSMUTEX_ENTER(graph->mutex);
+	for (i = 0; i < J9THREAD_LOCK_ORDER_EDGES; i++) {
+		J9ThreadLockOrderEdgeRecord *record = &graph->edges[i];
+		if (0 != record->key) {
+			if (count < maxEdges) {
+				J9ThreadLockOrderEdge *edge = &edges[count];
+				edge->heldName = graph->classes[record->from].name;
+				edge->enteredName = graph->classes[record->to].name;
+				edge->inverted = record->inverted;
+				edge->frameCount = record->frameCount;
+				memcpy(edge->frames, record->frames, sizeof(edge->frames));
+			}
+			count += 1;
+		}
+	}
+	OMROSMUTEX_EXIT(graph->mutex);
+
+	return count;
+}
+
+void
+omrthread_lock_order_check(omrthread_t self, omrthread_monitor_t monitor)
+{
+	omrthread_library_t lib = self->library;
+	J9ThreadLockOrderGraph *graph = lib->lockOrderGraph;
+	void *frames[J9THREAD_LOCK_ORDER_FRAMES];
+	uintptr_t frameCount = 0;
+	BOOLEAN sampled = FALSE;
+	uintptr_t count = OMR_MIN(self->lockOrderHeldCount, J9THREAD_LOCK_ORDER_MAX_HELD);
+	uintptr_t to = 0;
+	uintptr_t i = 0;
+
+	if ((0 == count) || (0 != self->lockOrderBusy) || (NULL == graph)) {
+		return;
+	}
+	to = lock_order_class(graph, monitor);
+	if (J9THREAD_LOCK_ORDER_UNTRACKED == to) {
+		return;
+	}
+
+	for (i = 0; i < count; i++) {
+		uintptr_t from = self->lockOrderHeld[i]->lockOrderClass;
+		J9ThreadLockOrderInversion inversion;
+		void *conflictFrames[J9THREAD_LOCK_ORDER_FRAMES];
+
+		if ((J9THREAD_LOCK_ORDER_UNTRACKED == from) || (0 == from) || (from == to)) {
+			continue;
+		}
+		if (lock_order_has_edge(graph, from - 1, to - 1)) {
+			continue;
+		}
+
+		/* a new edge: capture the call site outside the graph mutex, since the sampler may enter monitors */
+		self->lockOrderBusy = TRUE;
+		if (!sampled && (NULL != lib->lockOrderSampler)) {
+			frameCount = lib->lockOrderSampler(lib->lockOrderUserData, frames, J9THREAD_LOCK_ORDER_FRAMES);
+			sampled = TRUE;
+		}
+		if (lock_order_add_edge(graph, from - 1, to - 1, frames, frameCount, &inversion, conflictFrames)
+			&& (NULL != lib->lockOrderReport)
+		) {
+			inversion.thread = self;
+			inversion.frames = frames;
+			inversion.frameCount = frameCount;
+			lib->lockOrderReport(lib->lockOrderUserData, &inversion);
+		}
+		self->lockOrderBusy = FALSE;
+	}
+}
+
+void
+omrthread_lock_order_push(omrthread_t self, omrthread_monitor_t monitor)
+{
+	J9ThreadLockOrderGraph *graph = self->library->lockOrderGraph;
+
+	if ((NULL != graph) && (self->lockOrderHeldCount < J9THREAD_LOCK_ORDER_MAX_HELD)
+		&& (J9THREAD_LOCK_ORDER_UNTRACKED != lock_order_class(graph, monitor))
+	) {
+		self->lockOrderHeld[self->lockOrderHeldCount] = monitor;
+		self->lockOrderHeldCount += 1;
+	}
+}
+
+void
+omrthread_lock_order_pop(omrthread_t self, omrthread_monitor_t monitor)
+{
+	uintptr_t i = self->lockOrderHeldCount;
+
+	/* monitors are usually released in the reverse order they were entered */
+	while (i > 0) {
+		i -= 1;
+		if (monitor == self->lockOrderHeld[i]) {
+			self->lockOrderHeldCount -= 1;
+			memmove(&self->lockOrderHeld[i], &self->lockOrderHeld[i + 1], (self->lockOrderHeldCount - i) * sizeof(omrthread_monitor_t));
+			break;
+		}
+	}
+}
+
+void
+omrthread_lock_order_free(omrthread_library_t lib)
+{
+	J9ThreadLockOrderGraph *graph = lib->lockOrderGraph;
+
+	if (NULL != graph) {
+		uintptr_t i = 0;
+		for (i = 0; i < J9THREAD_LOCK_ORDER_CLASSES; i++) {
+			if (NULL != graph->classes[i].name) {
+				omrthread_free_memory(lib, graph->classes[i].name);
+			}
+		}
+		OMROSMUTEX_DESTROY(graph->mutex);
+		omrthread_free_memory(lib, graph);
+		lib->lockOrderGraph = NULL;
+	}
+	lib->flags &= ~J9THREAD_LIB_FLAG_LOCK_ORDER_ENABLED;
+}
+
+/**
+ * Find the class of a monitor's name, adding it if it is new, and cache it in the monitor.
+ *
+ * @return the class index + 1, or J9THREAD_LOCK_ORDER_UNTRACKED
+ */
+static uintptr_t
+lock_order_class(J9ThreadLockOrderGraph *graph, omrthread_monitor_t monitor)
+{
+	uintptr_t lockOrderClass = monitor->lockOrderClass;
+
+	if (0 == lockOrderClass) {
+		const char *name = monitor->name;
+
+		lockOrderClass = J9THREAD_LOCK_ORDER_UNTRACKED;
+		if (NULL != name) {
+			uintptr_t hash = 2166136261U;
+			uintptr_t slot = 0;
+			const char *cursor = NULL;
+
+			/* FNV-1a */
+			for (cursor = name; '\0' != *cursor; cursor++) {
+				hash = (hash ^ (uint8_t)*cursor) * 16777619U;
+			}
+
+			OMROSMUTEX_ENTER(graph->mutex);
+			slot = hash & (J9THREAD_LOCK_ORDER_CLASSES - 1);
+			for (;;) {
+				J9ThreadLockOrderClass *entry = &graph->classes[slot];
+				if (NULL == entry->name) {
+					if (graph->classCount < J9THREAD_LOCK_ORDER_TABLE_LIMIT(J9THREAD_LOCK_ORDER_CLASSES)) {
+						uintptr_t length = strlen(name);
+						entry->name = (char *)omrthread_allocate_memory(GLOBAL_DATA(default_library), length + 1, OMRMEM_CATEGORY_THREADS);
+						if (NULL != entry->name) {
+							memcpy(entry->name, name, length + 1);
+							entry->hash = hash;
+							graph->classCount += 1;
+							lockOrderClass = slot + 1;
+						}
+					}
+					break;
+				}
+				if ((hash == entry->hash) && (0 == strcmp(name, entry->name))) {
+					lockOrderClass = slot + 1;
+					break;
+				}
+				slot = (slot + 1) & (J9THREAD_LOCK_ORDER_CLASSES - 1);
+			}
+			OMROSMUTEX_EXIT(graph->mutex);
+		}
+		monitor->lockOrderClass = lockOrderClass;
+	}
+
+	return lockOrderClass;
+}
+
+static uintptr_t
+lock_order_edge_key(uintptr_t from, uintptr_t to)
+{
+	return ((from + 1) << J9THREAD_LOCK_ORDER_CLASS_BITS << 1) | (to + 1);
+}
+
+static uintptr_t
+lock_order_edge_slot(uintptr_t key)
+{
+	return ((uint32_t)key * 0x9E3779B1U) >> (32 - J9THREAD_LOCK_ORDER_EDGE_BITS);
+}
+
+/**
+ * Look an edge up without locking. Records are fully written before their key is
+ * published and are never removed.
+ */
+static BOOLEAN
+lock_order_has_edge(J9ThreadLockOrderGraph *graph, uintptr_t from, uintptr_t to)
+{
+	uintptr_t key = lock_order_edge_key(from, to);
+	uintptr_t slot = lock_order_edge_slot(key);
+
+	for (;;) {
+		uintptr_t entryKey = graph->edges[slot].key;
+		if (key == entryKey) {
+			return TRUE;
+		}
+		if (0 == entryKey) {
+			return FALSE;
+		}
+		slot = (slot + 1) & (J9THREAD_LOCK_ORDER_EDGES - 1);
+	}
+}
+
+/**
+ * Add an edge and check whether it closes a cycle.
+ *
+ * @param[out] inversion filled in, except for the entering thread's fields, if the edge is an inversion
+ * @param[out] conflictFrames buffer for inversion->conflictFrames
+ * @return TRUE if a new edge was added and closes a cycle
+ */
+static BOOLEAN
+lock_order_add_edge(J9ThreadLockOrderGraph *graph, uintptr_t from, uintptr_t to, void **frames, uintptr_t frameCount, J9ThreadLockOrderInversion *inversion, void **conflictFrames)
+{
+	uintptr_t key = lock_order_edge_key(from, to);
+	uintptr_t slot = lock_order_edge_slot(key);
+	BOOLEAN inverted = FALSE;
+
+	OMROSMUTEX_ENTER(graph->mutex);
+	for (;;) {
+		J9ThreadLockOrderEdgeRecord *record = &graph->edges[slot];
+		if (key == record->key) {
+			/* another thread added it first */
+			break;
+		}
+		if (0 == record->key) {
+			uintptr_t conflict = 0;
+
+			if (graph->edgeCount >= J9THREAD_LOCK_ORDER_TABLE_LIMIT(J9THREAD_LOCK_ORDER_EDGES)) {
+				break;
+			}
+			record->from = from;
+			record->to = to;
+			record->frameCount = OMR_MIN(frameCount, J9THREAD_LOCK_ORDER_FRAMES);
+			memcpy(record->frames, frames, record->frameCount * sizeof(void *));
+
+			/* a path back from to to from means some thread takes the two in the other order */
+			conflict = lock_order_find_path(graph, to, from);
+			if (0 != conflict) {
+				J9ThreadLockOrderEdgeRecord *conflictRecord = &graph->edges[conflict - 1];
+
+				inverted = TRUE;
+				record->inverted = TRUE;
+				inversion->heldName = graph->classes[from].name;
+				inversion->enteringName = graph->classes[to].name;
+				inversion->conflictHeldName = graph->classes[conflictRecord->from].name;
+				inversion->conflictEnteredName = graph->classes[conflictRecord->to].name;
+				inversion->conflictFrameCount = conflictRecord->frameCount;
+				memcpy(conflictFrames, conflictRecord->frames, conflictRecord->frameCount * sizeof(void *));
+				inversion->conflictFrames = conflictFrames;
+			}
+
+			record->nextEdge = graph->classes[from].firstEdge;
+			graph->classes[from].firstEdge = slot + 1;
+			graph->edgeCount += 1;
+			issueWriteBarrier();
+			record->key = key;
+			break;
+		}
+		slot = (slot + 1) & (J9THREAD_LOCK_ORDER_EDGES - 1);
+	}
+	OMROSMUTEX_EXIT(graph->mutex);
+
+	return inverted;
+}
+
+/**
+ * Depth-first search for a path between two classes. Called with the graph mutex held.
+ *
+ * @return index + 1 of the first edge on a path from start to target, or 0 if there is none
+ */
+static uintptr_t
+lock_order_find_path(J9ThreadLockOrderGraph *graph, uintptr_t start, uintptr_t target)
+{
+	intptr_t depth = 0;
+
+	memset(graph->visited, 0, sizeof(graph->visited));
+	graph->visited[start] = 1;
+	graph->searchEdge[0] = graph->classes[start].firstEdge;
+
+	while (depth >= 0) {
+		uintptr_t edge = graph->searchEdge[depth];
+		J9ThreadLockOrderEdgeRecord *record = NULL;
+
+		if (0 == edge) {
+			depth -= 1;
+			continue;
+		}
+		record = &graph->edges[edge - 1];
+		graph->searchEdge[depth] = record->nextEdge;
+		graph->pathEdge[depth] = edge;
+		if (target == record->to) {
+			return graph->pathEdge[0];
+		}
+		if (0 == graph->visited[record->to]) {
+			graph->visited[record->to] = 1;
+			depth += 1;
+			graph->searchEdge[depth] = graph->classes[record->to].firstEdge;
+		}
+	}
+
+	return 0;
+}
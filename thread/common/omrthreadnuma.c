@@ -144,3 +144,22 @@ uintptr_t
 omrthread_numa_get_current_node(){
 	return 0;
 }
+
+uintptr_t
+omrthread_numa_get_thread_node(omrthread_t thread)
+{
+	return 0;
+}
+
+#if defined(OMR_PORT_NUMA_SUPPORT)
+void
+omrthread_numa_place_thread(omrthread_t thread, omrthread_numa_placement_t placement, omrthread_t colocateWith)
+{
+	thread->numaPlacementNode = 0;
+}
+
+void
+omrthread_numa_release_thread(omrthread_t thread)
+{
+}
+#endif /* defined(OMR_PORT_NUMA_SUPPORT) */
@@ -0,0 +1,422 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Thread
+ * @brief Parking lot and word locks
+ *
+ * Threads blocked on an address wait in a global hash table of FIFO queues, in the
+ * style of WebKit's ParkingLot. Each parked thread blocks on its own OS condition,
+ * so the address itself needs no blocking structures and a lock built on the
+ * parking lot fits in a single word.
+ */
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrthread.h"
+#include "omrutilbase.h"
+#include "threaddef.h"
+#include "thread_internal.h"
+
+/* Must be a power of two */
+#define J9THREAD_PARKING_LOT_BUCKET_BITS 10
+#define J9THREAD_PARKING_LOT_BUCKETS ((uintptr_t)1 << J9THREAD_PARKING_LOT_BUCKET_BITS)
+#define J9THREAD_PARKING_LOT_BUCKET_SPINS 64
+
+/* Waiter states */
+#define J9THREAD_PARKING_LOT_QUEUED 0
+#define J9THREAD_PARKING_LOT_DEQUEUED 1 /* removed by an unparker which has not woken the thread yet */
+#define J9THREAD_PARKING_LOT_UNPARKED 2
+
+/* Word lock states */
+#define J9THREAD_WORDLOCK_LOCKED 1
+#define J9THREAD_WORDLOCK_PARKED 2
+#define J9THREAD_WORDLOCK_SPINS 40
+
+/* Waiters on a word lock park on the byte after it, so they never share a queue with threads entering it */
+#define WORDLOCK_WAIT_ADDRESS(lock) ((void *)((uintptr_t)(lock) + 1))
+
+#define BOUNDED_MILLIS(millis) ((millis) > 0x7FFFFFFF ? (intptr_t)0x7FFFFFFF : (intptr_t)(millis))
+
+typedef struct J9ThreadParkingLotWaiter {
+	omrthread_t thread;
+	void *address;
+	volatile uintptr_t state;
+	struct J9ThreadParkingLotWaiter *next;
+} J9ThreadParkingLotWaiter;
+
+typedef struct J9ThreadParkingLotBucket {
+	volatile uintptr_t lock;
+	J9ThreadParkingLotWaiter *head;
+	J9ThreadParkingLotWaiter *tail;
+} J9ThreadParkingLotBucket;
+
+static J9ThreadParkingLotBucket parkingLot[J9THREAD_PARKING_LOT_BUCKETS];
+
+static J9ThreadParkingLotBucket *bucketFor(void *address);
+static void lockBucket(J9ThreadParkingLotBucket *bucket);
+static void unlockBucket(J9ThreadParkingLotBucket *bucket);
+static BOOLEAN removeWaiter(J9ThreadParkingLotBucket *bucket, J9ThreadParkingLotWaiter *waiter);
+static void wakeWaiter(J9ThreadParkingLotWaiter *waiter);
+static void waitUntilUnparked(omrthread_t self, J9ThreadParkingLotWaiter *waiter);
+static uintptr_t wordlockValidate(void *userData);
+static void wordlockUnparked(void *userData, uintptr_t unparked, uintptr_t moreWaiters);
+static void wordlockBeforeSleep(void *userData);
+
+intptr_t
+omrthread_parking_lot_park(void *address, omrthread_parking_lot_validate_t validate, omrthread_parking_lot_before_sleep_t beforeSleep, void *userData, int64_t millis, intptr_t nanos)
+{
+	omrthread_t self = MACRO_SELF();
+	J9ThreadParkingLotBucket *bucket = bucketFor(address);
+	J9ThreadParkingLotWaiter waiter;
+	BOOLEAN timedOut = FALSE;
+
+	ASSERT(self);
+
+	waiter.thread = self;
+	waiter.address = address;
+	waiter.state = J9THREAD_PARKING_LOT_QUEUED;
+	waiter.next = NULL;
+
+	lockBucket(bucket);
+	if ((NULL != validate) && !validate(userData)) {
+		unlockBucket(bucket);
+		return J9THREAD_WOULD_BLOCK;
+	}
+	if (NULL == bucket->head) {
+		bucket->head = &waiter;
+	} else {
+		bucket->tail->next = &waiter;
+	}
+	bucket->tail = &waiter;
+	unlockBucket(bucket);
+
+	if (NULL != beforeSleep) {
+		beforeSleep(userData);
+	}
+
+	if ((0 == millis) && (0 == nanos)) {
+		waitUntilUnparked(self, &waiter);
+		return J9THREAD_SUCCESS;
+	}
+
+	THREAD_LOCK(self, CALLER_PARKING_LOT_PARK);
+	if (J9THREAD_PARKING_LOT_UNPARKED != waiter.state) {
+		OMROSCOND_WAIT_IF_TIMEDOUT(self->condition, self->mutex, BOUNDED_MILLIS(millis), nanos) {
+			timedOut = TRUE;
+			break;
+		} else if (J9THREAD_PARKING_LOT_UNPARKED == waiter.state) {
+			break;
+		}
+		OMROSCOND_WAIT_TIMED_LOOP();
+	}
+	THREAD_UNLOCK(self);
+
+	if (timedOut) {
+		/* leave the queue, unless an unparker has already taken this waiter */
+		lockBucket(bucket);
+		timedOut = (J9THREAD_PARKING_LOT_QUEUED == waiter.state) && removeWaiter(bucket, &waiter);
+		unlockBucket(bucket);
+		if (!timedOut) {
+			/* the unparker still refers to this waiter, so it must not go out of scope yet */
+			waitUntilUnparked(self, &waiter);
+		}
+	}
+
+	return timedOut ? J9THREAD_TIMED_OUT : J9THREAD_SUCCESS;
+}
+
+uintptr_t
+omrthread_parking_lot_unpark_one(void *address, omrthread_parking_lot_unpark_callback_t callback, void *userData)
+{
+	J9ThreadParkingLotBucket *bucket = bucketFor(address);
+	J9ThreadParkingLotWaiter *previous = NULL;
+	J9ThreadParkingLotWaiter *waiter = NULL;
+	J9ThreadParkingLotWaiter *each = NULL;
+	uintptr_t moreWaiters = FALSE;
+
+	lockBucket(bucket);
+	for (each = bucket->head; NULL != each; each = each->next) {
+		if (address == each->address) {
+			if (NULL == waiter) {
+				waiter = each;
+			} else {
+				moreWaiters = TRUE;
+				break;
+			}
+		} else if (NULL == waiter) {
+			previous = each;
+		}
+	}
+	if (NULL != waiter) {
+		if (NULL == previous) {
+			bucket->head = waiter->next;
+		} else {
+			previous->next = waiter->next;
+		}
+		if (bucket->tail == waiter) {
+			bucket->tail = previous;
+		}
+		waiter->state = J9THREAD_PARKING_LOT_DEQUEUED;
+	}
+	if (NULL != callback) {
+		callback(userData, NULL != waiter, moreWaiters);
+	}
+	unlockBucket(bucket);
+
+	if (NULL != waiter) {
+		wakeWaiter(waiter);
+		return 1;
+	}
+	return 0;
+}
+
+uintptr_t
+omrthread_parking_lot_unpark_all(void *address)
+{
+	J9ThreadParkingLotBucket *bucket = bucketFor(address);
+	J9ThreadParkingLotWaiter *previous = NULL;
+	J9ThreadParkingLotWaiter *each = NULL;
+	J9ThreadParkingLotWaiter *woken = NULL;
+	J9ThreadParkingLotWaiter *wokenTail = NULL;
+	uintptr_t count = 0;
+
+	lockBucket(bucket);
+	each = bucket->head;
+	while (NULL != each) {
+		J9ThreadParkingLotWaiter *next = each->next;
+		if (address == each->address) {
+			if (NULL == previous) {
+				bucket->head = next;
+			} else {
+				previous->next = next;
+			}
+			if (bucket->tail == each) {
+				bucket->tail = previous;
+			}
+			each->state = J9THREAD_PARKING_LOT_DEQUEUED;
+			each->next = NULL;
+			if (NULL == woken) {
+				woken = each;
+			} else {
+				wokenTail->next = each;
+			}
+			wokenTail = each;
+		} else {
+			previous = each;
+		}
+		each = next;
+	}
+	unlockBucket(bucket);
+
+	/* wake in FIFO order; a woken waiter's frame may be gone as soon as it is woken */
+	while (NULL != woken) {
+		J9ThreadParkingLotWaiter *next = woken->next;
+		wakeWaiter(woken);
+		woken = next;
+		count += 1;
+	}
+	return count;
+}
+
+void
+omrthread_wordlock_enter(omrthread_wordlock_t *lock)
+{
+	uintptr_t spins = 0;
+
+	if (0 == compareAndSwapUDATA((uintptr_t *)lock, 0, J9THREAD_WORDLOCK_LOCKED)) {
+		issueReadWriteBarrier();
+		return;
+	}
+
+	for (;;) {
+		uintptr_t value = *lock;
+
+		if (0 == (value & J9THREAD_WORDLOCK_LOCKED)) {
+			/* barge in even if others are parked; they retry when woken */
+			if (value == compareAndSwapUDATA((uintptr_t *)lock, value, value | J9THREAD_WORDLOCK_LOCKED)) {
+				issueReadWriteBarrier();
+				return;
+			}
+		} else if ((0 == (value & J9THREAD_WORDLOCK_PARKED)) && (spins < J9THREAD_WORDLOCK_SPINS)) {
+			spins += 1;
+			omrthread_yield();
+		} else if ((0 != (value & J9THREAD_WORDLOCK_PARKED))
+			|| (value == compareAndSwapUDATA((uintptr_t *)lock, value, value | J9THREAD_WORDLOCK_PARKED))
+		) {
+			omrthread_parking_lot_park((void *)lock, wordlockValidate, NULL, (void *)lock, 0, 0);
+		}
+	}
+}
+
+intptr_t
+omrthread_wordlock_try_enter(omrthread_wordlock_t *lock)
+{
+	uintptr_t value = *lock;
+
+	while (0 == (value & J9THREAD_WORDLOCK_LOCKED)) {
+		uintptr_t oldValue = compareAndSwapUDATA((uintptr_t *)lock, value, value | J9THREAD_WORDLOCK_LOCKED);
+		if (value == oldValue) {
+			issueReadWriteBarrier();
+			return 0;
+		}
+		value = oldValue;
+	}
+	return -1;
+}
+
+void
+omrthread_wordlock_exit(omrthread_wordlock_t *lock)
+{
+	issueReadWriteBarrier();
+	if (J9THREAD_WORDLOCK_LOCKED != compareAndSwapUDATA((uintptr_t *)lock, J9THREAD_WORDLOCK_LOCKED, 0)) {
+		/* there are parked threads: the callback releases the lock while their queue is locked */
+		omrthread_parking_lot_unpark_one((void *)lock, wordlockUnparked, (void *)lock);
+	}
+}
+
+intptr_t
+omrthread_wordlock_wait(omrthread_wordlock_t *lock, int64_t millis, intptr_t nanos)
+{
+	/* queued before the lock is released, so a notify made under the lock cannot be missed */
+	intptr_t rc = omrthread_parking_lot_park(WORDLOCK_WAIT_ADDRESS(lock), NULL, wordlockBeforeSleep, (void *)lock, millis, nanos);
+
+	omrthread_wordlock_enter(lock);
+	return rc;
+}
+
+void
+omrthread_wordlock_notify(omrthread_wordlock_t *lock)
+{
+	omrthread_parking_lot_unpark_one(WORDLOCK_WAIT_ADDRESS(lock), NULL, NULL);
+}
+
+void
+omrthread_wordlock_notify_all(omrthread_wordlock_t *lock)
+{
+	omrthread_parking_lot_unpark_all(WORDLOCK_WAIT_ADDRESS(lock));
+}
+
+static J9ThreadParkingLotBucket *
+bucketFor(void *address)
+{
+	uintptr_t hash = ((uintptr_t)address >> 2) * (uintptr_t)0x9E3779B97F4A7C15ULL;
+
+	return &parkingLot[hash >> ((sizeof(uintptr_t) * 8) - J9THREAD_PARKING_LOT_BUCKET_BITS)];
+}
+
+/**
+ * Buckets are held only to link or unlink waiters, so they use a yielding spinlock.
+ */
+static void
+lockBucket(J9ThreadParkingLotBucket *bucket)
+{
+	uintptr_t spins = 0;
+
+	while ((0 != bucket->lock) || (0 != compareAndSwapUDATA((uintptr_t *)&bucket->lock, 0, 1))) {
+		spins += 1;
+		if (spins >= J9THREAD_PARKING_LOT_BUCKET_SPINS) {
+			omrthread_yield();
+			spins = 0;
+		}
+	}
+	issueReadWriteBarrier();
+}
+
+static void
+unlockBucket(J9ThreadParkingLotBucket *bucket)
+{
+	issueReadWriteBarrier();
+	bucket->lock = 0;
+}
+
+static BOOLEAN
+removeWaiter(J9ThreadParkingLotBucket *bucket, J9ThreadParkingLotWaiter *waiter)
+{
+	J9ThreadParkingLotWaiter *previous = NULL;
+	J9ThreadParkingLotWaiter *each = bucket->head;
+
+	while ((NULL != each) && (waiter != each)) {
+		previous = each;
+		each = each->next;
+	}
+	if (NULL == each) {
+		return FALSE;
+	}
+	if (NULL == previous) {
+		bucket->head = waiter->next;
+	} else {
+		previous->next = waiter->next;
+	}
+	if (bucket->tail == waiter) {
+		bucket->tail = previous;
+	}
+	return TRUE;
+}
+
+/**
+ * Wake a dequeued waiter. The waiter cannot return from park, and so its thread cannot
+ * exit, until its state is set under the thread's mutex.
+ */
+static void
+wakeWaiter(J9ThreadParkingLotWaiter *waiter)
+{
+	omrthread_t thread = waiter->thread;
+
+	THREAD_LOCK(thread, CALLER_PARKING_LOT_UNPARK);
+	waiter->state = J9THREAD_PARKING_LOT_UNPARKED;
+	OMROSCOND_NOTIFY_ALL(thread->condition);
+	THREAD_UNLOCK(thread);
+}
+
+static void
+waitUntilUnparked(omrthread_t self, J9ThreadParkingLotWaiter *waiter)
+{
+	THREAD_LOCK(self, CALLER_PARKING_LOT_PARK);
+	if (J9THREAD_PARKING_LOT_UNPARKED != waiter->state) {
+		OMROSCOND_WAIT(self->condition, self->mutex);
+			if (J9THREAD_PARKING_LOT_UNPARKED == waiter->state) {
+				break;
+			}
+		OMROSCOND_WAIT_LOOP();
+	}
+	THREAD_UNLOCK(self);
+}
+
+static uintptr_t
+wordlockValidate(void *userData)
+{
+	return (J9THREAD_WORDLOCK_LOCKED | J9THREAD_WORDLOCK_PARKED) == *(omrthread_wordlock_t *)userData;
+}
+
+static void
+wordlockUnparked(void *userData, uintptr_t unparked, uintptr_t moreWaiters)
+{
+	*(omrthread_wordlock_t *)userData = moreWaiters ? J9THREAD_WORDLOCK_PARKED : 0;
+}
+
+static void
+wordlockBeforeSleep(void *userData)
+{
+	omrthread_wordlock_exit((omrthread_wordlock_t *)userData);
+}
@@ -0,0 +1,541 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Thread
+ * @brief Work-stealing task pool
+ *
+ * Each worker owns a fixed-size Chase-Lev deque: the owner pushes and pops at the
+ * bottom without locking and idle workers steal from the top with a compare-and-swap.
+ * Tasks forked by threads that are not workers of the pool go through a queue guarded
+ * by the pool monitor. Idle workers wait on the monitor until pendingTasks is non-zero,
+ * and joiners which are not workers wait on it until a task completes.
+ */
+
+#include <string.h>
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrthread.h"
+#include "omrutilbase.h"
+#include "threaddef.h"
+#include "thread_internal.h"
+
+/* Must be a power of two */
+#define J9THREAD_TASKPOOL_DEQUE_SIZE 1024
+
+#define J9THREAD_TASK_PENDING 0
+#define J9THREAD_TASK_DONE 1
+
+typedef struct J9ThreadTaskPoolWorker {
+	struct J9ThreadTaskPool *pool;
+	omrthread_t thread;
+	uintptr_t index;
+	uintptr_t node; /* NUMA node the worker is bound to, 0 if none */
+	uintptr_t stealSeed;
+	volatile uintptr_t top; /* next slot to steal */
+	volatile uintptr_t bottom; /* next slot to push */
+	J9ThreadTask *volatile deque[J9THREAD_TASKPOOL_DEQUE_SIZE];
+} J9ThreadTaskPoolWorker;
+
+typedef struct J9ThreadTaskPool {
+	omrthread_monitor_t monitor;
+	uintptr_t workerCount;
+	J9ThreadTaskPoolWorker *workers;
+	volatile uintptr_t pendingTasks; /* forked tasks which no thread has claimed yet */
+	volatile uintptr_t idleWorkers;
+	volatile uintptr_t blockedJoiners; /* non-workers waiting in omrthread_taskpool_join */
+	volatile uintptr_t shutdown;
+	J9ThreadTask *volatile queueHead; /* tasks forked by non-workers, oldest first */
+	J9ThreadTask *queueTail;
+	volatile uintptr_t externalSeed;
+} J9ThreadTaskPool;
+
+typedef struct J9ThreadParallelForRange {
+	omrthread_parallel_for_function_t function;
+	void *userData;
+	uintptr_t begin;
+	uintptr_t end;
+	uintptr_t grain;
+} J9ThreadParallelForRange;
+
+static int J9THREAD_PROC taskPoolWorkerMain(void *arg);
+static J9ThreadTaskPoolWorker *currentWorker(J9ThreadTaskPool *pool);
+static BOOLEAN dequePush(J9ThreadTaskPoolWorker *worker, J9ThreadTask *task);
+static J9ThreadTask *dequePop(J9ThreadTaskPoolWorker *worker);
+static J9ThreadTask *dequeSteal(J9ThreadTaskPoolWorker *victim);
+static J9ThreadTask *takeQueuedTask(J9ThreadTaskPool *pool);
+static J9ThreadTask *stealTask(J9ThreadTaskPool *pool, J9ThreadTaskPoolWorker *worker);
+static J9ThreadTask *findTask(J9ThreadTaskPool *pool, J9ThreadTaskPoolWorker *worker);
+static void runTask(J9ThreadTaskPool *pool, J9ThreadTask *task);
+static void wakeIdleWorker(J9ThreadTaskPool *pool);
+static void parallelForTask(omrthread_taskpool_t pool, void *arg);
+static uintptr_t nextRandom(uintptr_t *seed);
+
+intptr_t
+omrthread_taskpool_create(omrthread_taskpool_t *pool, uintptr_t workerCount, uint32_t category, omrthread_numa_placement_t placement)
+{
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+	J9ThreadTaskPool *newPool = NULL;
+	omrthread_attr_t attr = NULL;
+	intptr_t rc = J9THREAD_SUCCESS;
+	uintptr_t i = 0;
+
+	if ((NULL == pool) || (0 == workerCount)) {
+		return J9THREAD_ERR_INVALID_VALUE;
+	}
+
+	newPool = omrthread_allocate_memory(lib, sizeof(J9ThreadTaskPool), OMRMEM_CATEGORY_THREADS);
+	if (NULL == newPool) {
+		return J9THREAD_ERR_NOMEMORY;
+	}
+	memset(newPool, 0, sizeof(J9ThreadTaskPool));
+	newPool->workers = omrthread_allocate_memory(lib, sizeof(J9ThreadTaskPoolWorker) * workerCount, OMRMEM_CATEGORY_THREADS);
+	if (NULL == newPool->workers) {
+		rc = J9THREAD_ERR_NOMEMORY;
+		goto free_pool;
+	}
+	memset(newPool->workers, 0, sizeof(J9ThreadTaskPoolWorker) * workerCount);
+	if (0 != omrthread_monitor_init_with_name(&newPool->monitor, 0, "omrthread task pool")) {
+		rc = J9THREAD_ERR_CANT_INIT_MUTEX;
+		goto free_workers;
+	}
+
+	rc = omrthread_attr_init(&attr);
+	if (J9THREAD_SUCCESS != rc) {
+		goto destroy_monitor;
+	}
+	if ((J9THREAD_SUCCESS != (rc = omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE)))
+		|| (J9THREAD_SUCCESS != (rc = omrthread_attr_set_category(&attr, category)))
+		|| (J9THREAD_SUCCESS != (rc = omrthread_attr_set_numa_placement(&attr, placement, NULL)))
+	) {
+		goto destroy_attr;
+	}
+
+	/* workers look for work as soon as they start, so the count must be set first */
+	newPool->workerCount = workerCount;
+	for (i = 0; i < workerCount; i++) {
+		J9ThreadTaskPoolWorker *worker = &newPool->workers[i];
+		worker->pool = newPool;
+		worker->index = i;
+		worker->stealSeed = (i + 1) * 0x9E3779B9;
+		rc = omrthread_create_ex(&worker->thread, &attr, FALSE, taskPoolWorkerMain, worker);
+		if (J9THREAD_SUCCESS != rc) {
+			/* stop the workers which did start */
+			newPool->workerCount = i;
+			omrthread_attr_destroy(&attr);
+			omrthread_taskpool_destroy(newPool);
+			return rc;
+		}
+	}
+	omrthread_attr_destroy(&attr);
+	*pool = newPool;
+	return J9THREAD_SUCCESS;
+
+destroy_attr:
+	omrthread_attr_destroy(&attr);
+destroy_monitor:
+	omrthread_monitor_destroy(newPool->monitor);
+free_workers:
+	omrthread_free_memory(lib, newPool->workers);
+free_pool:
+	omrthread_free_memory(lib, newPool);
+	return rc;
+}
+
+void
+omrthread_taskpool_destroy(omrthread_taskpool_t pool)
+{
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+	uintptr_t i = 0;
+
+	omrthread_monitor_enter(pool->monitor);
+	pool->shutdown = TRUE;
+	omrthread_monitor_notify_all(pool->monitor);
+	omrthread_monitor_exit(pool->monitor);
+
+	for (i = 0; i < pool->workerCount; i++) {
+		omrthread_join(pool->workers[i].thread);
+	}
+
+	omrthread_monitor_destroy(pool->monitor);
+	omrthread_free_memory(lib, pool->workers);
+	omrthread_free_memory(lib, pool);
+}
+
+uintptr_t
+omrthread_taskpool_worker_count(omrthread_taskpool_t pool)
+{
+	return pool->workerCount;
+}
+
+intptr_t
+omrthread_taskpool_worker_index(omrthread_taskpool_t pool)
+{
+	J9ThreadTaskPoolWorker *worker = currentWorker(pool);
+	return (NULL == worker) ? -1 : (intptr_t)worker->index;
+}
+
+void
+omrthread_task_init(J9ThreadTask *task, omrthread_task_function_t function, void *arg)
+{
+	task->function = function;
+	task->arg = arg;
+	task->state = J9THREAD_TASK_PENDING;
+	task->next = NULL;
+}
+
+void
+omrthread_taskpool_fork(omrthread_taskpool_t pool, J9ThreadTask *task)
+{
+	J9ThreadTaskPoolWorker *worker = currentWorker(pool);
+
+	task->state = J9THREAD_TASK_PENDING;
+	if (NULL != worker) {
+		/* count the task before publishing it so a thief never sees the count underflow */
+		addAtomic(&pool->pendingTasks, 1);
+		if (!dequePush(worker, task)) {
+			subtractAtomic(&pool->pendingTasks, 1);
+			task->function(pool, task->arg);
+			task->state = J9THREAD_TASK_DONE;
+			return;
+		}
+		wakeIdleWorker(pool);
+	} else {
+		omrthread_monitor_enter(pool->monitor);
+		task->next = NULL;
+		if (NULL == pool->queueHead) {
+			pool->queueHead = task;
+		} else {
+			pool->queueTail->next = task;
+		}
+		pool->queueTail = task;
+		addAtomic(&pool->pendingTasks, 1);
+		if (0 != pool->idleWorkers) {
+			omrthread_monitor_notify(pool->monitor);
+		}
+		omrthread_monitor_exit(pool->monitor);
+	}
+}
+
+void
+omrthread_taskpool_join(omrthread_taskpool_t pool, J9ThreadTask *task)
+{
+	J9ThreadTaskPoolWorker *worker = currentWorker(pool);
+
+	while (J9THREAD_TASK_DONE != task->state) {
+		J9ThreadTask *other = findTask(pool, worker);
+		if (NULL != other) {
+			runTask(pool, other);
+		} else if (NULL != worker) {
+			/* the task is running elsewhere and there is nothing else to help with */
+			omrthread_yield();
+		} else {
+			omrthread_monitor_enter(pool->monitor);
+			pool->blockedJoiners += 1;
+			/* pairs with the barrier in runTask: either the task is seen done or this joiner is seen waiting */
+			issueReadWriteBarrier();
+			if (J9THREAD_TASK_DONE != task->state) {
+				omrthread_monitor_wait(pool->monitor);
+			}
+			pool->blockedJoiners -= 1;
+			omrthread_monitor_exit(pool->monitor);
+		}
+	}
+	/* make the task's results visible to the joiner */
+	issueReadBarrier();
+}
+
+void
+omrthread_taskpool_parallel_for(omrthread_taskpool_t pool, uintptr_t begin, uintptr_t end, uintptr_t grain, omrthread_parallel_for_function_t function, void *userData)
+{
+	J9ThreadParallelForRange range;
+
+	if (begin < end) {
+		range.function = function;
+		range.userData = userData;
+		range.begin = begin;
+		range.end = end;
+		range.grain = (0 == grain) ? 1 : grain;
+		parallelForTask(pool, &range);
+	}
+}
+
+/**
+ * Run one range of a parallel-for: fork the upper half of anything larger than the
+ * grain, process the lower half in place, then join.
+ */
+static void
+parallelForTask(omrthread_taskpool_t pool, void *arg)
+{
+	J9ThreadParallelForRange *range = (J9ThreadParallelForRange *)arg;
+
+	if ((range->end - range->begin) <= range->grain) {
+		range->function(range->userData, range->begin, range->end);
+	} else {
+		uintptr_t middle = range->begin + ((range->end - range->begin) / 2);
+		J9ThreadParallelForRange upper = *range;
+		J9ThreadParallelForRange lower = *range;
+		J9ThreadTask upperTask;
+
+		upper.begin = middle;
+		lower.end = middle;
+		omrthread_task_init(&upperTask, parallelForTask, &upper);
+		omrthread_taskpool_fork(pool, &upperTask);
+		parallelForTask(pool, &lower);
+		omrthread_taskpool_join(pool, &upperTask);
+	}
+}
+
+static int J9THREAD_PROC
+taskPoolWorkerMain(void *arg)
+{
+	J9ThreadTaskPoolWorker *worker = (J9ThreadTaskPoolWorker *)arg;
+	J9ThreadTaskPool *pool = worker->pool;
+	omrthread_t self = MACRO_SELF();
+	uintptr_t affinityCount = 1;
+
+	self->taskPoolWorker = worker;
+	/* remember the node chosen by the placement policy to prefer stealing from neighbours */
+	if ((0 != omrthread_numa_get_node_affinity(self, &worker->node, &affinityCount)) || (1 != affinityCount)) {
+		worker->node = 0;
+	}
+
+	for (;;) {
+		J9ThreadTask *task = findTask(pool, worker);
+		if (NULL != task) {
+			runTask(pool, task);
+		} else if (0 != pool->pendingTasks) {
+			/* a task is being published or a steal lost a race; try again shortly */
+			omrthread_yield();
+		} else {
+			BOOLEAN stop = FALSE;
+
+			omrthread_monitor_enter(pool->monitor);
+			pool->idleWorkers += 1;
+			/* pairs with the barrier in wakeIdleWorker: either the forker sees this worker idle or it sees the task */
+			issueReadWriteBarrier();
+			while ((0 == pool->pendingTasks) && !pool->shutdown) {
+				omrthread_monitor_wait(pool->monitor);
+			}
+			pool->idleWorkers -= 1;
+			stop = pool->shutdown && (0 == pool->pendingTasks);
+			omrthread_monitor_exit(pool->monitor);
+			if (stop) {
+				break;
+			}
+		}
+	}
+
+	self->taskPoolWorker = NULL;
+	return 0;
+}
+
+static J9ThreadTaskPoolWorker *
+currentWorker(J9ThreadTaskPool *pool)
+{
+	omrthread_t self = MACRO_SELF();
+	J9ThreadTaskPoolWorker *worker = NULL;
+
+	if ((NULL != self) && (NULL != self->taskPoolWorker) && (pool == self->taskPoolWorker->pool)) {
+		worker = self->taskPoolWorker;
+	}
+	return worker;
+}
+
+static void
+wakeIdleWorker(J9ThreadTaskPool *pool)
+{
+	issueReadWriteBarrier();
+	if (0 != pool->idleWorkers) {
+		omrthread_monitor_enter(pool->monitor);
+		omrthread_monitor_notify(pool->monitor);
+		omrthread_monitor_exit(pool->monitor);
+	}
+}
+
+static BOOLEAN
+dequePush(J9ThreadTaskPoolWorker *worker, J9ThreadTask *task)
+{
+	uintptr_t bottom = worker->bottom;
+
+	if ((bottom - worker->top) >= J9THREAD_TASKPOOL_DEQUE_SIZE) {
+		return FALSE;
+	}
+	worker->deque[bottom & (J9THREAD_TASKPOOL_DEQUE_SIZE - 1)] = task;
+	/* the slot must be visible before thieves can see the new bottom */
+	issueWriteBarrier();
+	worker->bottom = bottom + 1;
+	return TRUE;
+}
+
+static J9ThreadTask *
+dequePop(J9ThreadTaskPoolWorker *worker)
+{
+	uintptr_t bottom = worker->bottom;
+	uintptr_t top = 0;
+	J9ThreadTask *task = NULL;
+
+	if (bottom == worker->top) {
+		return NULL;
+	}
+	bottom -= 1;
+	worker->bottom = bottom;
+	/* publish the reservation before reading top, or a thief could take the same task */
+	issueReadWriteBarrier();
+	top = worker->top;
+	if ((intptr_t)(bottom - top) > 0) {
+		/* more than one task left; no thief can reach this one */
+		return worker->deque[bottom & (J9THREAD_TASKPOOL_DEQUE_SIZE - 1)];
+	}
+	if (bottom == top) {
+		/* the last task: race any thief for it, leaving the deque empty either way */
+		task = worker->deque[bottom & (J9THREAD_TASKPOOL_DEQUE_SIZE - 1)];
+		if (top != compareAndSwapUDATA((uintptr_t *)&worker->top, top, top + 1)) {
+			task = NULL;
+		}
+		worker->bottom = top + 1;
+	} else {
+		/* a thief took the last task before the reservation; top has already moved past it */
+		worker->bottom = bottom + 1;
+	}
+	return task;
+}
+
+static J9ThreadTask *
+dequeSteal(J9ThreadTaskPoolWorker *victim)
+{
+	uintptr_t top = victim->top;
+	uintptr_t bottom = 0;
+	J9ThreadTask *task = NULL;
+
+	issueReadWriteBarrier();
+	bottom = victim->bottom;
+	if ((intptr_t)(bottom - top) > 0) {
+		task = victim->deque[top & (J9THREAD_TASKPOOL_DEQUE_SIZE - 1)];
+		if (top != compareAndSwapUDATA((uintptr_t *)&victim->top, top, top + 1)) {
+			task = NULL;
+		}
+	}
+	return task;
+}
+
+static J9ThreadTask *
+takeQueuedTask(J9ThreadTaskPool *pool)
+{
+	J9ThreadTask *task = NULL;
+
+	if (NULL != pool->queueHead) {
+		omrthread_monitor_enter(pool->monitor);
+		task = pool->queueHead;
+		if (NULL != task) {
+			pool->queueHead = task->next;
+			if (NULL == task->next) {
+				pool->queueTail = NULL;
+			}
+		}
+		omrthread_monitor_exit(pool->monitor);
+	}
+	return task;
+}
+
+/**
+ * Try each other worker once from a random starting point, first those on the
+ * thief's own NUMA node and then the rest.
+ */
+static J9ThreadTask *
+stealTask(J9ThreadTaskPool *pool, J9ThreadTaskPoolWorker *worker)
+{
+	uintptr_t workerCount = pool->workerCount;
+	uintptr_t start = 0;
+	uintptr_t pass = 0;
+
+	if (NULL != worker) {
+		start = nextRandom(&worker->stealSeed) % workerCount;
+	} else {
+		start = addAtomic(&pool->externalSeed, 1) % workerCount;
+	}
+	for (pass = 0; pass < 2; pass++) {
+		uintptr_t i = 0;
+		for (i = 0; i < workerCount; i++) {
+			J9ThreadTaskPoolWorker *victim = &pool->workers[(start + i) % workerCount];
+			if (victim != worker) {
+				BOOLEAN sameNode = (NULL == worker) || (victim->node == worker->node);
+				if ((0 == pass) == sameNode) {
+					J9ThreadTask *task = dequeSteal(victim);
+					if (NULL != task) {
+						return task;
+					}
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+static J9ThreadTask *
+findTask(J9ThreadTaskPool *pool, J9ThreadTaskPoolWorker *worker)
+{
+	J9ThreadTask *task = NULL;
+
+	if (NULL != worker) {
+		task = dequePop(worker);
+	}
+	if (NULL == task) {
+		task = takeQueuedTask(pool);
+	}
+	if (NULL == task) {
+		task = stealTask(pool, worker);
+	}
+	return task;
+}
+
+static void
+runTask(J9ThreadTaskPool *pool, J9ThreadTask *task)
+{
+	subtractAtomic(&pool->pendingTasks, 1);
+	task->function(pool, task->arg);
+	/* the task's side effects must be visible before it is seen to be done */
+	issueWriteBarrier();
+	task->state = J9THREAD_TASK_DONE;
+	issueReadWriteBarrier();
+	if (0 != pool->blockedJoiners) {
+		omrthread_monitor_enter(pool->monitor);
+		omrthread_monitor_notify_all(pool->monitor);
+		omrthread_monitor_exit(pool->monitor);
+	}
+}
+
+/**
+ * xorshift step used to pick steal victims.
+ */
+static uintptr_t
+nextRandom(uintptr_t *seed)
+{
+	uintptr_t x = *seed;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*seed = x;
+	return x;
+}
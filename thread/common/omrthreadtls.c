@@ -34,6 +34,11 @@
 
 static void J9THREAD_PROC tls_null_finalizer(void *entry);
 
+#if defined(J9THREAD_NATIVE_TLS)
+/* the current thread, mirroring self_ptr; see NATIVE_SELF_SET */
+J9THREAD_NATIVE_TLS omrthread_t omrthread_native_self = NULL;
+#endif /* defined(J9THREAD_NATIVE_TLS) */
+
 /**
  * Allocate a thread local storage (TLS) key.
  *
@@ -151,6 +156,48 @@ omrthread_tls_set(omrthread_t thread, omrthread_tls_key_t key, void *value)
 
 
 
+/**
+ * Get the current thread's TLS value.
+ *
+ * Equivalent to omrthread_tls_get(omrthread_self(), key), but where the compiler supports
+ * native thread-local variables the current thread is found without a TLS key lookup.
+ * Keys come from omrthread_tls_alloc or omrthread_tls_alloc_with_finalizer, so values set
+ * through either path share the same slots and finalizers.
+ *
+ * @param[in] key key to have TLS value returned (value returned by omrthread_tls_alloc)
+ * @return the TLS value, or NULL if the current thread is not attached
+ *
+ * @see omrthread_tls_set_current, omrthread_tls_get
+ */
+void *
+omrthread_tls_get_current(omrthread_tls_key_t key)
+{
+	omrthread_t self = FAST_SELF();
+
+	return (NULL == self) ? NULL : self->tls[key - 1];
+}
+
+/**
+ * Set the current thread's TLS value.
+ *
+ * @param[in] key key to have TLS value set (value returned by omrthread_tls_alloc)
+ * @param[in] value value to be stored in TLS
+ * @return 0 on success or negative value if the current thread is not attached
+ *
+ * @see omrthread_tls_get_current, omrthread_tls_set
+ */
+intptr_t
+omrthread_tls_set_current(omrthread_tls_key_t key, void *value)
+{
+	omrthread_t self = FAST_SELF();
+
+	if (NULL == self) {
+		return -1;
+	}
+	self->tls[key - 1] = value;
+	return 0;
+}
+
 /**
  * Run finalizers on any non-NULL TLS values for the current thread
  *
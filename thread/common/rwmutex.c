@@ -22,18 +22,52 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "omrutilbase.h"
 #include "threaddef.h"
 #include "thread_internal.h"
 
 #undef  ASSERT
 #define ASSERT(x) /**/
 
+/*
+ * Read-biased mutexes.
+ *
+ * While a mutex is read-biased (readBias != 0) readers do not touch the mutex at all:
+ * a reader publishes the mutex in a free slot of its own cache line of reader slots,
+ * issues a full barrier and re-checks the bias. Since a thread is the only writer of
+ * its line, the read fast path causes no shared cache line traffic.
+ *
+ * A writer revokes the bias under syncMon, issues a full barrier and waits for every
+ * reader slot to drop the mutex before competing for status as usual. The mutex is
+ * marked as revoking until the wait completes, and other writers wait for that rather
+ * than treating the mutex as free. The revoking writer yields for a while, as fast-path
+ * read sections are usually short, and then blocks on syncMon; a reader that drops its
+ * slot while the mutex is revoking notifies syncMon. Readers that
+ * find the bias revoked, that have no free slot, or that run on a thread without a
+ * line of slots, use the syncMon protocol. Once RWMUTEX_REBIAS_READS such slow reads
+ * have completed without a writer waiting, the bias is restored; mutexes that see
+ * frequent writes therefore settle into the unbiased protocol.
+ *
+ * When a thread is freed while it still has a mutex published, its reads are moved to
+ * orphanedReads so that the line of slots can be reused. As with an unbiased mutex whose
+ * reader died, such a mutex can no longer be entered for write.
+ */
 typedef struct RWMutex {
 	omrthread_monitor_t syncMon;
 	intptr_t status;
 	omrthread_t writer;
+	volatile uintptr_t readBias;
+	uintptr_t flags;
+	uintptr_t writersWaiting;
+	uintptr_t rebiasDelay;
+	uintptr_t revoking; /* a writer is waiting for the reader slots to drain */
+	volatile uintptr_t orphanedReads; /* fast-path reads held by threads which have been freed */
 } RWMutex;
 
+#define RWMUTEX_REBIAS_READS 256
+/* times a revoking writer yields before it blocks until the fast-path readers have left */
+#define RWMUTEX_REVOKE_YIELDS 32
+
 #define ASSERT_RWMUTEX(m)\
     ASSERT((m));\
     ASSERT((m)->syncMon);
@@ -42,9 +76,162 @@ typedef struct RWMutex {
 #define RWMUTEX_STATUS_READING(m)  ((m)->status > 0)
 #define RWMUTEX_STATUS_WRITING(m)  ((m)->status < 0)
 
+#define RWMUTEX_CAN_BIAS(lib, m) \
+	((NULL != (lib)->rwmutexReaderSlots) && (0 == ((m)->flags & J9THREAD_RWMUTEX_NO_READ_BIAS)))
+
+static BOOLEAN rwmutex_is_read_published(omrthread_library_t lib, omrthread_rwmutex_t mutex);
+static void rwmutex_revoke_bias(omrthread_rwmutex_t mutex);
+static void rwmutex_drain_readers(omrthread_library_t lib, omrthread_rwmutex_t mutex);
+static void rwmutex_notify_revoking(omrthread_rwmutex_t mutex);
+
+/**
+ * Check whether any thread has the mutex published in one of its reader slots.
+ *
+ * @param[in] lib the thread library
+ * @param[in] mutex the mutex to look for
+ * @return TRUE if a slot holding the mutex was found
+ */
+static BOOLEAN
+rwmutex_is_read_published(omrthread_library_t lib, omrthread_rwmutex_t mutex)
+{
+	uintptr_t line = 0;
+
+	for (line = 0; line < J9THREAD_RWMUTEX_READER_LINES; line++) {
+		if (0 != lib->rwmutexReaderLineInUse[line]) {
+			volatile uintptr_t *slots = lib->rwmutexReaderSlots + (line * J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE);
+			uintptr_t i = 0;
+
+			for (i = 0; i < J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE; i++) {
+				if ((uintptr_t)mutex == slots[i]) {
+					return TRUE;
+				}
+			}
+		}
+	}
+	return FALSE;
+}
+
+/**
+ * Stop readers from taking the fast path.
+ * @note Assumes syncMon is held
+ *
+ * @param[in] mutex a read-biased mutex
+ */
+static void
+rwmutex_revoke_bias(omrthread_rwmutex_t mutex)
+{
+	mutex->readBias = 0;
+	mutex->rebiasDelay = RWMUTEX_REBIAS_READS;
+	/* order the store to readBias before the loads of the reader slots */
+	issueReadWriteBarrier();
+}
+
+/**
+ * Wait for every reader slot to drop a mutex whose bias has been revoked.
+ * @note Assumes syncMon is held and revoking is set; syncMon is released while yielding
+ *
+ * @param[in] lib the thread library
+ * @param[in] mutex the mutex being revoked
+ */
+static void
+rwmutex_drain_readers(omrthread_library_t lib, omrthread_rwmutex_t mutex)
+{
+	uintptr_t yields = 0;
+
+	omrthread_monitor_exit(mutex->syncMon);
+	while ((yields < RWMUTEX_REVOKE_YIELDS) && rwmutex_is_read_published(lib, mutex)) {
+		omrthread_yield();
+		yields += 1;
+	}
+	omrthread_monitor_enter(mutex->syncMon);
+	/* a reader that drops its slot from now on sees revoking and notifies syncMon, which it cannot enter before this thread waits */
+	while (rwmutex_is_read_published(lib, mutex)) {
+		omrthread_monitor_wait(mutex->syncMon);
+	}
+}
+
+/**
+ * Wake a writer waiting in rwmutex_drain_readers after a reader has dropped its slot.
+ *
+ * @param[in] mutex the mutex being revoked
+ */
+static void
+rwmutex_notify_revoking(omrthread_rwmutex_t mutex)
+{
+	omrthread_monitor_enter(mutex->syncMon);
+	omrthread_monitor_notify_all(mutex->syncMon);
+	omrthread_monitor_exit(mutex->syncMon);
+}
+
+void
+omrthread_rwmutex_init_reader_slots(omrthread_library_t lib)
+{
+	uintptr_t size = J9THREAD_RWMUTEX_READER_LINES * J9THREAD_RWMUTEX_READER_LINE_SIZE;
+
+	lib->rwmutexReaderSlots = NULL;
+	memset(lib->rwmutexReaderLineInUse, 0, sizeof(lib->rwmutexReaderLineInUse));
+	lib->rwmutexReaderSlotMemory = omrthread_allocate_memory(lib, size + J9THREAD_RWMUTEX_READER_LINE_SIZE, OMRMEM_CATEGORY_THREADS);
+	if (NULL != lib->rwmutexReaderSlotMemory) {
+		uintptr_t aligned = ((uintptr_t)lib->rwmutexReaderSlotMemory + J9THREAD_RWMUTEX_READER_LINE_SIZE - 1) & ~(uintptr_t)(J9THREAD_RWMUTEX_READER_LINE_SIZE - 1);
+		memset((void *)aligned, 0, size);
+		lib->rwmutexReaderSlots = (volatile uintptr_t *)aligned;
+	}
+}
+
+void
+omrthread_rwmutex_free_reader_slots(omrthread_library_t lib)
+{
+	if (NULL != lib->rwmutexReaderSlotMemory) {
+		omrthread_free_memory(lib, lib->rwmutexReaderSlotMemory);
+		lib->rwmutexReaderSlotMemory = NULL;
+		lib->rwmutexReaderSlots = NULL;
+	}
+}
+
+void
+omrthread_rwmutex_attach_reader_slots(omrthread_library_t lib, omrthread_t thread)
+{
+	thread->rwmutexReaderSlots = NULL;
+	if (NULL != lib->rwmutexReaderSlots) {
+		uintptr_t line = 0;
+		for (line = 0; line < J9THREAD_RWMUTEX_READER_LINES; line++) {
+			if (0 == lib->rwmutexReaderLineInUse[line]) {
+				lib->rwmutexReaderLineInUse[line] = 1;
+				thread->rwmutexReaderSlots = lib->rwmutexReaderSlots + (line * J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE);
+				break;
+			}
+		}
+	}
+}
+
+void
+omrthread_rwmutex_detach_reader_slots(omrthread_library_t lib, omrthread_t thread)
+{
+	volatile uintptr_t *slots = thread->rwmutexReaderSlots;
+
+	if (NULL != slots) {
+		uintptr_t i = 0;
+		for (i = 0; i < J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE; i++) {
+			if (0 != slots[i]) {
+				/* The thread died holding read access: keep the mutex read-locked, just as
+				 * an unbiased mutex would stay, but give the slot back.
+				 */
+				RWMutex *mutex = (RWMutex *)slots[i];
+				addAtomic(&mutex->orphanedReads, 1);
+				slots[i] = 0;
+			}
+		}
+		lib->rwmutexReaderLineInUse[(slots - lib->rwmutexReaderSlots) / J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE] = 0;
+		thread->rwmutexReaderSlots = NULL;
+	}
+}
+
 /**
  * Acquire and initialize a new read/write mutex from the threading library.
  *
+ * Unless J9THREAD_RWMUTEX_NO_READ_BIAS is specified, the mutex starts out read-biased:
+ * readers do not write to shared state until a writer revokes the bias.
+ *
  * @param[out] handle pointer to a omrthread_rwmutex_t to be set to point to the new mutex
  * @param[in] flags initial flag values for the mutex
  * @return J9THREAD_RWMUTEX_OK on success
@@ -72,6 +259,12 @@ omrthread_rwmutex_init(omrthread_rwmutex_t *handle, uintptr_t flags, const char
 		omrthread_monitor_init_with_name(&mutex->syncMon, 0, (char *)name);
 		mutex->status = 0;
 		mutex->writer = 0;
+		mutex->flags = flags;
+		mutex->writersWaiting = 0;
+		mutex->rebiasDelay = 0;
+		mutex->revoking = 0;
+		mutex->orphanedReads = 0;
+		mutex->readBias = RWMUTEX_CAN_BIAS(lib, mutex) ? 1 : 0;
 
 		ASSERT(handle);
 		*handle = mutex;
@@ -102,6 +295,8 @@ omrthread_rwmutex_destroy(omrthread_rwmutex_t mutex)
 	ASSERT(mutex->syncMon);
 	ASSERT(0 == mutex->status);
 	ASSERT(0 == mutex->writer);
+	ASSERT(!rwmutex_is_read_published(lib, mutex));
+	ASSERT(0 == mutex->orphanedReads);
 	omrthread_monitor_destroy(mutex->syncMon);
 #if defined(OMR_THR_FORK_SUPPORT)
 	ASSERT(0 != lib->rwmutexPool);
@@ -142,18 +337,51 @@ omrthread_rwmutex_destroy(omrthread_rwmutex_t mutex)
 intptr_t
 omrthread_rwmutex_enter_read(omrthread_rwmutex_t mutex)
 {
+	omrthread_t self = omrthread_self();
+	volatile uintptr_t *slots = self->rwmutexReaderSlots;
+	BOOLEAN retracted = FALSE;
+
 	ASSERT_RWMUTEX(mutex);
-	if (mutex->writer == omrthread_self()) {
+	if (mutex->writer == self) {
 		return J9THREAD_RWMUTEX_OK;
 	}
 
+	if ((0 != mutex->readBias) && (NULL != slots)) {
+		uintptr_t i = 0;
+		for (i = 0; i < J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE; i++) {
+			if (0 == slots[i]) {
+				slots[i] = (uintptr_t)mutex;
+				/* order the publication before the re-check of the bias (see rwmutex_revoke_bias) */
+				issueReadWriteBarrier();
+				if (0 != mutex->readBias) {
+					return J9THREAD_RWMUTEX_OK;
+				}
+				slots[i] = 0;
+				retracted = TRUE;
+				break;
+			}
+		}
+	}
+
 	omrthread_monitor_enter(mutex->syncMon);
 
+	if (retracted && (0 != mutex->revoking)) {
+		/* the revoking writer may have seen the slot before it was dropped */
+		omrthread_monitor_notify_all(mutex->syncMon);
+	}
 	while (mutex->status < 0) {
 		omrthread_monitor_wait(mutex->syncMon);
 	}
 	mutex->status++;
 
+	if ((0 == mutex->readBias) && (0 == mutex->writersWaiting) && RWMUTEX_CAN_BIAS(self->library, mutex)) {
+		if (0 == mutex->rebiasDelay) {
+			mutex->readBias = 1;
+		} else {
+			mutex->rebiasDelay--;
+		}
+	}
+
 	omrthread_monitor_exit(mutex->syncMon);
 	return J9THREAD_RWMUTEX_OK;
 }
@@ -170,11 +398,31 @@ omrthread_rwmutex_enter_read(omrthread_rwmutex_t mutex)
 intptr_t
 omrthread_rwmutex_exit_read(omrthread_rwmutex_t mutex)
 {
+	omrthread_t self = omrthread_self();
+	volatile uintptr_t *slots = self->rwmutexReaderSlots;
+
 	ASSERT_RWMUTEX(mutex);
-	if (mutex->writer == omrthread_self()) {
+	if (mutex->writer == self) {
 		return J9THREAD_RWMUTEX_OK;
 	}
 
+	if (NULL != slots) {
+		uintptr_t i = 0;
+		for (i = 0; i < J9THREAD_RWMUTEX_READER_SLOTS_PER_LINE; i++) {
+			if ((uintptr_t)mutex == slots[i]) {
+				/* complete the critical section before a revoking writer can observe the release */
+				issueReadWriteBarrier();
+				slots[i] = 0;
+				/* order the release before the check for a revoking writer (see rwmutex_drain_readers) */
+				issueReadWriteBarrier();
+				if (0 != mutex->revoking) {
+					rwmutex_notify_revoking(mutex);
+				}
+				return J9THREAD_RWMUTEX_OK;
+			}
+		}
+	}
+
 	omrthread_monitor_enter(mutex->syncMon);
 
 	mutex->status--;
@@ -226,9 +474,26 @@ omrthread_rwmutex_enter_write(omrthread_rwmutex_t mutex)
 
 	omrthread_monitor_enter(mutex->syncMon);
 
-	while (mutex->status != 0) {
-		omrthread_monitor_wait(mutex->syncMon);
+	/* readers may not restore the bias while a writer is waiting */
+	mutex->writersWaiting++;
+	for (;;) {
+		if (0 != mutex->revoking) {
+			/* another writer is draining the fast-path readers */
+			omrthread_monitor_wait(mutex->syncMon);
+		} else if (0 != mutex->readBias) {
+			/* set before the barrier in rwmutex_revoke_bias, so readers leaving after the slots are checked see it */
+			mutex->revoking = 1;
+			rwmutex_revoke_bias(mutex);
+			rwmutex_drain_readers(self->library, mutex);
+			mutex->revoking = 0;
+			omrthread_monitor_notify_all(mutex->syncMon);
+		} else if ((mutex->status != 0) || (0 != mutex->orphanedReads)) {
+			omrthread_monitor_wait(mutex->syncMon);
+		} else {
+			break;
+		}
 	}
+	mutex->writersWaiting--;
 	mutex->status--;
 	mutex->writer = self;
 
@@ -263,11 +528,19 @@ omrthread_rwmutex_try_enter_write(omrthread_rwmutex_t mutex)
 	}
 
 	omrthread_monitor_enter(mutex->syncMon);
-	if (mutex->status != 0) {
+	if ((mutex->status != 0) || (0 != mutex->revoking) || (0 != mutex->orphanedReads)) {
 		/* must get out */
 		omrthread_monitor_exit(mutex->syncMon);
 		return J9THREAD_RWMUTEX_WOULDBLOCK;
 	}
+	if (0 != mutex->readBias) {
+		rwmutex_revoke_bias(mutex);
+		if (rwmutex_is_read_published(self->library, mutex)) {
+			/* fast-path readers are still inside; the bias stays revoked */
+			omrthread_monitor_exit(mutex->syncMon);
+			return J9THREAD_RWMUTEX_WOULDBLOCK;
+		}
+	}
 	mutex->status--;
 	mutex->writer = self;
 
@@ -330,7 +603,7 @@ omrthread_rwmutex_is_writelocked(omrthread_rwmutex_t mutex)
 void
 omrthread_rwmutex_reset(omrthread_rwmutex_t rwmutex, omrthread_t self)
 {
-	if (RWMUTEX_STATUS_READING(rwmutex)) {
+	if (RWMUTEX_STATUS_READING(rwmutex) || (0 != rwmutex->orphanedReads) || rwmutex_is_read_published(self->library, rwmutex)) {
 		fprintf(stderr, "ERROR: found read-locked rwmutex during post-fork reset!\n");
 		abort();
 	}
@@ -341,6 +614,8 @@ omrthread_rwmutex_reset(omrthread_rwmutex_t rwmutex, omrthread_t self)
 		 */
 		rwmutex->writer = NULL;
 		rwmutex->status = 0;
+		rwmutex->writersWaiting = 0;
+		rwmutex->revoking = 0;
 	}
 }
 
@@ -141,6 +141,83 @@ paint_stack(omrthread_t thread);
 uint64_t
 omrthread_get_hires_clock(void);
 
+/**
+ * @brief Convert an interval of omrthread_get_hires_clock values into nanoseconds.
+ * @param startTime
+ * @param endTime
+ * @return uint64_t
+ */
+uint64_t
+omrthread_hires_delta_nanos(uint64_t startTime, uint64_t endTime);
+
+/* ------------- omrthreadcontention.c ------------ */
+
+/**
+ * @brief Record that self blocked entering monitor, which it now owns.
+ * @param self the current thread
+ * @param monitor the monitor entered
+ * @param blockedSince hires clock time at which self started blocking
+ * @return void
+ */
+void
+omrthread_contention_record_enter(omrthread_t self, omrthread_monitor_t monitor, uint64_t blockedSince);
+
+/**
+ * @brief Record that self waited on monitor, which it owns again.
+ * @param self the current thread
+ * @param monitor the monitor waited on
+ * @param waitingSince hires clock time at which self started waiting
+ * @return void
+ */
+void
+omrthread_contention_record_wait(omrthread_t self, omrthread_monitor_t monitor, uint64_t waitingSince);
+
+/**
+ * @brief Free the contention records of a monitor pool being discarded.
+ * @param lib the thread library
+ * @param pool the monitor pool
+ * @return void
+ */
+void
+omrthread_contention_free_records(omrthread_library_t lib, omrthread_monitor_pool_t pool);
+
+/* ------------- omrthreadlockorder.c ------------ */
+
+/**
+ * @brief Record the order of monitor after every tracked monitor self holds, before self enters it.
+ * @param self the current thread
+ * @param monitor the monitor about to be entered
+ * @return void
+ */
+void
+omrthread_lock_order_check(omrthread_t self, omrthread_monitor_t monitor);
+
+/**
+ * @brief Note that self now owns monitor.
+ * @param self the current thread
+ * @param monitor the monitor entered
+ * @return void
+ */
+void
+omrthread_lock_order_push(omrthread_t self, omrthread_monitor_t monitor);
+
+/**
+ * @brief Note that self has released monitor.
+ * @param self the current thread
+ * @param monitor the monitor exited
+ * @return void
+ */
+void
+omrthread_lock_order_pop(omrthread_t self, omrthread_monitor_t monitor);
+
+/**
+ * @brief Free the lock-order graph at library shutdown.
+ * @param lib the thread library
+ * @return void
+ */
+void
+omrthread_lock_order_free(omrthread_library_t lib);
+
 /* ------------- omrthreadnuma.c ------------ */
 void
 omrthread_numa_init(omrthread_library_t threadLibrary);
@@ -158,6 +235,24 @@ omrthread_add_node_number_to_affinity_cache(omrthread_t thread, uintptr_t nodeNu
 BOOLEAN
 omrthread_does_affinity_cache_contain_node(omrthread_t thread, uintptr_t nodeNumber);
 
+/**
+ * @brief Choose a NUMA node for a thread which has not started yet
+ * @param thread the new thread; its affinity cache must be empty
+ * @param placement the policy from the creation attribute
+ * @param colocateWith the thread to co-locate with (NULL for the current thread)
+ * @return void
+ */
+void
+omrthread_numa_place_thread(omrthread_t thread, omrthread_numa_placement_t placement, omrthread_t colocateWith);
+
+/**
+ * @brief Release the node reservation made by omrthread_numa_place_thread
+ * @param thread
+ * @return void
+ */
+void
+omrthread_numa_release_thread(omrthread_t thread);
+
 enum {J9THREAD_MAX_NUMA_NODE = 1024};
 #endif /* defined(OMR_PORT_NUMA_SUPPORT) */
 
@@ -261,6 +356,55 @@ initialize_thread_priority(omrthread_t thread);
 intptr_t
 set_priority_spread(void);
 
+/**
+ * Allocate the table of per-thread reader slots used by read-biased rwmutexes.
+ * Failure is not fatal: rwmutexes simply never become read-biased.
+ *
+ * @param [in] lib Thread library
+ */
+void
+omrthread_rwmutex_init_reader_slots(omrthread_library_t lib);
+
+/**
+ * Free the table of per-thread reader slots.
+ *
+ * @param [in] lib Thread library
+ */
+void
+omrthread_rwmutex_free_reader_slots(omrthread_library_t lib);
+
+/**
+ * Give a thread its own line of reader slots, if one is free.
+ * @note Assumes the global lock is held
+ *
+ * @param [in] lib Thread library
+ * @param [in] thread Thread being allocated
+ */
+void
+omrthread_rwmutex_attach_reader_slots(omrthread_library_t lib, omrthread_t thread);
+
+/**
+ * Return a thread's line of reader slots to the library.
+ * @note Assumes the global lock is held
+ *
+ * @param [in] lib Thread library
+ * @param [in] thread Thread being freed
+ */
+void
+omrthread_rwmutex_detach_reader_slots(omrthread_library_t lib, omrthread_t thread);
+
+#if defined(LINUX)
+/**
+ * Find the processor a task last ran on from field 39 of its /proc stat file.
+ *
+ * @param [in] taskDirectory File descriptor of /proc/self/task, or AT_FDCWD
+ * @param [in] tid Kernel thread id of the task
+ * @return the processor index, or -1 if it could not be read
+ */
+intptr_t
+omrthread_get_task_last_cpu(int taskDirectory, uintptr_t tid);
+#endif /* defined(LINUX) */
+
 #if defined(OMR_THR_FORK_SUPPORT)
 /**
  * @param [in] omrthread_rwmutex_t rwmutex to reset
@@ -162,6 +162,11 @@ enum {
 	CALLER_STORE_EXIT_CPU_USAGE,
 	CALLER_GET_JVM_CPU_USAGE_INFO,
 	CALLER_SET_FLAG_ENABLE_CPU_MONITOR,
+	CALLER_CONTENTION_PROFILE,
+	CALLER_PARKING_LOT_PARK,
+	CALLER_PARKING_LOT_UNPARK,
+	CALLER_LOCK_ORDER,
+	CALLER_NUMA_COLOCATE,
 	CALLER_LAST_INDEX
 };
 #define MAX_CALLER_INDEX CALLER_LAST_INDEX
@@ -185,8 +190,40 @@ enum {
  */
 #define CUSTOM_ADAPTIVE_SPIN_TRUE  (1)
 
+/*
+ * Per-monitor spin budgets (see omrthread_spinlock_acquire).
+ * Success rates are fixed point out of OMRTHREAD_ADAPT_SPIN_RATE_ONE. Hold estimates
+ * count acquire attempts, scaled by 1 << OMRTHREAD_ADAPT_SPIN_ESTIMATE_SHIFT. Both move
+ * 1 / (1 << OMRTHREAD_ADAPT_SPIN_DECAY_SHIFT) of the way toward each new observation.
+ */
+#define OMRTHREAD_ADAPT_SPIN_RATE_ONE  256
+#define OMRTHREAD_ADAPT_SPIN_MIN_RATE  (OMRTHREAD_ADAPT_SPIN_RATE_ONE / 8)
+#define OMRTHREAD_ADAPT_SPIN_ESTIMATE_SHIFT  4
+#define OMRTHREAD_ADAPT_SPIN_DECAY_SHIFT  3
+#define OMRTHREAD_ADAPT_SPIN_PROBE_INTERVAL  64
+
 #define MACRO_SELF() ((omrthread_t)TLS_GET(((omrthread_library_t)GLOBAL_DATA(default_library))->self_ptr))
 
+/*
+ * Where the compiler provides native thread-local storage, the current omrthread_t is
+ * also cached in a native thread-local variable, kept in step with self_ptr, so the
+ * fast TLS path (omrthread_tls_get_current) avoids calling pthread_getspecific.
+ */
+#if defined(OMR_OS_WINDOWS) && defined(_MSC_VER)
+#define J9THREAD_NATIVE_TLS __declspec(thread)
+#elif (defined(LINUX) || defined(OSX)) && defined(__GNUC__) && !defined(OMRZTPF)
+#define J9THREAD_NATIVE_TLS __thread
+#endif /* defined(OMR_OS_WINDOWS) && defined(_MSC_VER) */
+
+#if defined(J9THREAD_NATIVE_TLS)
+extern J9THREAD_NATIVE_TLS omrthread_t omrthread_native_self;
+#define FAST_SELF() (omrthread_native_self)
+#define NATIVE_SELF_SET(thread) (omrthread_native_self = (thread))
+#else /* defined(J9THREAD_NATIVE_TLS) */
+#define FAST_SELF() MACRO_SELF()
+#define NATIVE_SELF_SET(thread)
+#endif /* defined(J9THREAD_NATIVE_TLS) */
+
 #if defined(THREAD_ASSERTS)
 #define GLOBAL_LOCK(self, caller) \
 	do { \
@@ -273,6 +310,10 @@ enum {
 #define IS_JLM_TIME_STAMPS_ENABLED(thread, monitor) ((thread)->library->flags & J9THREAD_LIB_FLAG_JLM_TIME_STAMPS_ENABLED)
 #endif /* IS_JLM_TIME_STAMPS_ENABLED */
 
+#define IS_CONTENTION_PROFILE_ENABLED(lib) OMR_ARE_ANY_BITS_SET((lib)->flags, J9THREAD_LIB_FLAG_CONTENTION_PROFILE_ENABLED)
+
+#define IS_LOCK_ORDER_TRACKING_ENABLED(lib) OMR_ARE_ANY_BITS_SET((lib)->flags, J9THREAD_LIB_FLAG_LOCK_ORDER_ENABLED)
+
 #define IS_JLM_HST_ENABLED(thread) ((thread)->library->flags & J9THREAD_LIB_FLAG_JLMHST_ENABLED)
 
 /* MACROS FOR ADAPTIVE SPINNING */
@@ -469,6 +510,9 @@ enum {
 				(monitor)->tracing->holdtime_avg = 0; \
 				(monitor)->tracing->spin2_count = 0; \
 				(monitor)->tracing->yield_count = 0; \
+				(monitor)->tracing->spin_acquire_count = 0; \
+				(monitor)->tracing->spin_fail_count = 0; \
+				(monitor)->tracing->spin_skip_count = 0; \
 			} \
 			if (isSlowEnter) { \
 				(monitor)->tracing->slow_count++; \
@@ -42,10 +42,75 @@ omrthread_monitor_unpin(omrthread_monitor_t monitor, omrthread_t self)
 
 #if defined(OMR_THR_THREE_TIER_LOCKING)
 
+#if defined(OMR_THR_ADAPTIVE_SPIN)
+/**
+ * Update a monitor's spin budget after a contended acquire attempt.
+ *
+ * The budget is the number of failed compare-and-swaps a thread may make before blocking.
+ * A successful spin sets it to a multiple of the recent hold estimate (the number of
+ * attempts spinning threads needed), so long holds among short ones still block quickly.
+ * Running out of budget halves it; once it falls below one round of spinning, or spinning
+ * rarely succeeds, the monitor blocks immediately and only spins again for a periodic probe.
+ *
+ * When the spin succeeded the caller owns the spinlock and the updates are exclusive.
+ * Otherwise they race with other threads; the values are heuristics and are clamped on use.
+ *
+ * @param[in] monitor the monitor
+ * @param[in] acquired TRUE if the spinlock was acquired
+ * @param[in] attempts the number of compare-and-swaps made
+ * @param[in] budget the budget that was in effect
+ * @param[in] probing TRUE if spinning was a probe of a monitor that blocks immediately
+ * @param[in] spinCount2 compare-and-swaps per yield
+ * @param[in] spinLimit the largest allowed budget
+ */
+static void
+adaptSpinBudget(omrthread_monitor_t monitor, BOOLEAN acquired, uintptr_t attempts, uintptr_t budget, BOOLEAN probing, uintptr_t spinCount2, uintptr_t spinLimit)
+{
+	uintptr_t rate = monitor->spinSuccessRate;
+
+	if (acquired) {
+		intptr_t estimate = (intptr_t)monitor->spinHoldEstimate;
+		intptr_t sample = (intptr_t)(attempts << OMRTHREAD_ADAPT_SPIN_ESTIMATE_SHIFT);
+		uintptr_t newBudget = 0;
+
+		estimate += (sample - estimate) / (1 << OMRTHREAD_ADAPT_SPIN_DECAY_SHIFT);
+		monitor->spinHoldEstimate = (uintptr_t)estimate;
+		monitor->spinSuccessRate = rate + ((OMRTHREAD_ADAPT_SPIN_RATE_ONE - rate) >> OMRTHREAD_ADAPT_SPIN_DECAY_SHIFT);
+
+		newBudget = ((uintptr_t)estimate >> OMRTHREAD_ADAPT_SPIN_ESTIMATE_SHIFT) * 4;
+		newBudget = OMR_MIN(OMR_MAX(newBudget, spinCount2), spinLimit);
+		if (probing) {
+			Trc_THR_Adapt_SpinBudgetRestored(monitor, newBudget, monitor->spinSuccessRate);
+		}
+		monitor->spinBudget = newBudget;
+	} else if ((0 == budget) && !probing) {
+		/* blocked without spinning */
+		if (0 != monitor->spinProbeCounter) {
+			monitor->spinProbeCounter -= 1;
+		}
+	} else {
+		rate -= rate >> OMRTHREAD_ADAPT_SPIN_DECAY_SHIFT;
+		monitor->spinSuccessRate = rate;
+		budget /= 2;
+		if ((budget < spinCount2) || (rate < OMRTHREAD_ADAPT_SPIN_MIN_RATE)) {
+			if (!probing) {
+				Trc_THR_Adapt_SpinBudgetExhausted(monitor, attempts, rate);
+			}
+			budget = 0;
+			monitor->spinProbeCounter = OMRTHREAD_ADAPT_SPIN_PROBE_INTERVAL;
+		}
+		monitor->spinBudget = budget;
+	}
+}
+#endif /* defined(OMR_THR_ADAPTIVE_SPIN) */
+
 /**
  * Spin on a monitor's spinlockState field until we can atomically swap out a value of SPINLOCK_UNOWNED
  * for the value SPINLOCK_OWNED.
  *
+ * With adaptive spinning, the number of attempts is further limited by the monitor's spin budget
+ * (see adaptSpinBudget).
+ *
  * @param[in] self the current omrthread_t
  * @param[in] monitor the monitor whose spinlock will be acquired
  *
@@ -88,6 +153,22 @@ omrthread_spinlock_acquire(omrthread_t self, omrthread_monitor_t monitor)
 	uintptr_t spinCount3 = spinCount3Init;
 	uintptr_t spinCount2 = spinCount2Init;
 
+#if defined(OMR_THR_ADAPTIVE_SPIN)
+	uintptr_t const spinLimit = spinCount3Init * spinCount2Init;
+	BOOLEAN const adaptBudget = (0 != lib->adaptSpinBudget) && IS_ADAPTIVE_SPIN_REQUIRED(monitor);
+	uintptr_t budget = spinLimit;
+	uintptr_t attempts = 0;
+	BOOLEAN probing = FALSE;
+	if (adaptBudget) {
+		budget = OMR_MIN(monitor->spinBudget, spinLimit);
+		if ((0 == budget) && (0 == monitor->spinProbeCounter)) {
+			/* see whether spinning pays off again */
+			budget = spinCount2Init;
+			probing = TRUE;
+		}
+	}
+#endif /* defined(OMR_THR_ADAPTIVE_SPIN) */
+
 	for (; spinCount3 > 0; spinCount3--) {
 		for (spinCount2 = spinCount2Init; spinCount2 > 0; spinCount2--) {
 			/* Try to put 0 into the target field (-1 indicates free)'. */
@@ -100,6 +181,13 @@ omrthread_spinlock_acquire(omrthread_t self, omrthread_monitor_t monitor)
 			if (OMR_ARE_ALL_BITS_SET(monitor->flags, J9THREAD_MONITOR_DISABLE_SPINNING)) {
 				goto update_jlm;
 			}
+#if defined(OMR_THR_ADAPTIVE_SPIN)
+			/* Stop spinning once the monitor's spin budget is used up */
+			attempts += 1;
+			if (adaptBudget && (attempts > budget)) {
+				goto update_jlm;
+			}
+#endif /* defined(OMR_THR_ADAPTIVE_SPIN) */
 			VM_AtomicSupport::yieldCPU();
 			/* begin tight loop */
 			for (uintptr_t spinCount1 = spinCount1Init; spinCount1 > 0; spinCount1--)	{
@@ -136,6 +224,30 @@ update_jlm:
 	}
 #endif /* OMR_THR_JLM */
 
+#if defined(OMR_THR_ADAPTIVE_SPIN)
+	/* Uncontended acquires say nothing about hold times */
+	if (0 != attempts) {
+		if (adaptBudget) {
+			adaptSpinBudget(monitor, (0 == result), attempts, budget, probing, spinCount2Init, spinLimit);
+		}
+#if defined(OMR_THR_JLM)
+		if (NULL != tracing) {
+			if (0 == result) {
+				VM_AtomicSupport::add(&tracing->spin_acquire_count, 1);
+			} else if (adaptBudget && (0 == budget)) {
+				VM_AtomicSupport::add(&tracing->spin_skip_count, 1);
+			} else {
+				VM_AtomicSupport::add(&tracing->spin_fail_count, 1);
+			}
+			if (adaptBudget) {
+				tracing->spin_budget = OMR_MIN(monitor->spinBudget, spinLimit);
+				tracing->spin_success_percent = (monitor->spinSuccessRate * 100) / OMRTHREAD_ADAPT_SPIN_RATE_ONE;
+			}
+		}
+#endif /* OMR_THR_JLM */
+	}
+#endif /* defined(OMR_THR_ADAPTIVE_SPIN) */
+
 #if defined(OMR_THR_SPIN_WAKE_CONTROL)
 	if (spinning && (OMRTHREAD_IGNORE_SPIN_THREAD_BOUND != lib->maxSpinThreads)) {
 		VM_AtomicSupport::subtract(&monitor->spinThreads, 1);
@@ -56,6 +56,15 @@
 #define I32MAXVAL	0x7FFFFFFF
 #endif
 
+#if defined(LINUX)
+/* for reading /proc/self/task in omrthread_get_sched_stats */
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif /* defined(LINUX) */
+
 #if defined(LINUX)
 /* pthread_getcpuclockid() is not always declared in pthread.h */
 extern int pthread_getcpuclockid(pthread_t thread_id, clockid_t *clock_id);
@@ -859,6 +868,35 @@ omrthread_get_hires_clock(void)
 #endif /* defined(OSX) */
 }
 
+/**
+ * Convert an interval between two values of @ref omrthread_get_hires_clock into
+ * nanoseconds. Only Windows needs a conversion: there the clock counts performance
+ * counter ticks, like omrtime_hires_delta in the port library.
+ *
+ * @param[in] startTime the earlier clock value
+ * @param[in] endTime the later clock value
+ * @return the interval in nanoseconds
+ */
+uint64_t
+omrthread_hires_delta_nanos(uint64_t startTime, uint64_t endTime)
+{
+	uint64_t delta = endTime - startTime;
+#if defined(OMR_OS_WINDOWS)
+	LARGE_INTEGER freq;
+
+	if (QueryPerformanceFrequency(&freq) && (0 != freq.QuadPart)) {
+		uint64_t ticksPerSecond = (uint64_t)freq.QuadPart;
+
+		/* Convert whole seconds and the remainder separately so the multiply cannot overflow */
+		delta = ((delta / ticksPerSecond) * 1000000000) + (((delta % ticksPerSecond) * 1000000000) / ticksPerSecond);
+	} else {
+		/* the clock fell back to GetTickCount(), which counts milliseconds */
+		delta *= 1000000;
+	}
+#endif /* defined(OMR_OS_WINDOWS) */
+	return delta;
+}
+
 #define THREAD_WALK_RESOURCE_USAGE_MUTEX_HELD	0x1
 #define THREAD_WALK_MONITOR_MUTEX_HELD			0x2
 
@@ -1024,3 +1062,169 @@ omrthread_get_jvm_cpu_usage_info_error_recovery(void)
 		GLOBAL_UNLOCK_SIMPLE(lib);
 	}
 }
+
+#if defined(LINUX)
+/**
+ * Read a file of a task through an already open /proc/self/task directory, which saves
+ * resolving the full path for every thread.
+ *
+ * @param[in] taskDirectory file descriptor of /proc/self/task, or AT_FDCWD to resolve the full path
+ * @param[in] tid the task
+ * @param[in] name file name within the task directory
+ * @param[out] buffer receives the NUL terminated file content (truncated to fit)
+ * @param[in] bufferSize size of buffer
+ * @return TRUE if anything was read
+ */
+static BOOLEAN
+readTaskFile(int taskDirectory, uintptr_t tid, const char *name, char *buffer, size_t bufferSize)
+{
+	char path[64];
+	ssize_t bytesRead = -1;
+	int file = -1;
+
+	snprintf(path, sizeof(path), "%s%" PRIuPTR "/%s", (AT_FDCWD == taskDirectory) ? "/proc/self/task/" : "", tid, name);
+	file = openat(taskDirectory, path, O_RDONLY | O_CLOEXEC);
+	if (-1 != file) {
+		bytesRead = read(file, buffer, bufferSize - 1);
+		close(file);
+	}
+	if (bytesRead <= 0) {
+		return FALSE;
+	}
+	buffer[bytesRead] = '\0';
+	return TRUE;
+}
+
+/**
+ * Return the value following a "key:" line of a /proc status file, or -1 if absent.
+ */
+static int64_t
+findStatusValue(const char *status, const char *key)
+{
+	const char *line = strstr(status, key);
+	int64_t value = -1;
+
+	if (NULL != line) {
+		value = (int64_t)strtoll(line + strlen(key), NULL, 10);
+	}
+	return value;
+}
+
+intptr_t
+omrthread_get_task_last_cpu(int taskDirectory, uintptr_t tid)
+{
+	char buffer[1024];
+	intptr_t cpu = -1;
+
+	if (readTaskFile(taskDirectory, tid, "stat", buffer, sizeof(buffer))) {
+		/* the command name may contain spaces, so count the fields from its closing parenthesis */
+		char *cursor = strrchr(buffer, ')');
+		uintptr_t field = 2;
+		while ((NULL != cursor) && (field < 39)) {
+			cursor = strchr(cursor + 1, ' ');
+			field += 1;
+		}
+		if (NULL != cursor) {
+			cpu = (intptr_t)strtol(cursor + 1, NULL, 10);
+		}
+	}
+	return cpu;
+}
+
+/**
+ * Fill in the requested fields of one sample from /proc/self/task/<tid>.
+ * schedstat gives nanosecond CPU and run-queue times, status the context switch
+ * counts, and field 39 of stat the CPU the task last ran on.
+ */
+static void
+sampleTask(int taskDirectory, J9ThreadSchedStats *sample, uintptr_t fields)
+{
+	char buffer[4096];
+
+	if (OMR_ARE_ANY_BITS_SET(fields, J9THREAD_SCHED_STATS_CPU_TIME)
+		&& readTaskFile(taskDirectory, sample->tid, "schedstat", buffer, sizeof(buffer))
+	) {
+		long long cpuTime = 0;
+		long long runDelay = 0;
+		if (2 == sscanf(buffer, "%lld %lld", &cpuTime, &runDelay)) {
+			sample->cpuTime = (int64_t)cpuTime;
+			sample->runDelay = (int64_t)runDelay;
+		}
+	}
+	if (OMR_ARE_ANY_BITS_SET(fields, J9THREAD_SCHED_STATS_CONTEXT_SWITCHES)
+		&& readTaskFile(taskDirectory, sample->tid, "status", buffer, sizeof(buffer))
+	) {
+		/* the leading newline keeps "voluntary" from matching inside "nonvoluntary" */
+		sample->voluntaryContextSwitches = findStatusValue(buffer, "\nvoluntary_ctxt_switches:");
+		sample->involuntaryContextSwitches = findStatusValue(buffer, "\nnonvoluntary_ctxt_switches:");
+	}
+	if (OMR_ARE_ANY_BITS_SET(fields, J9THREAD_SCHED_STATS_LAST_CPU)) {
+		sample->lastCpu = omrthread_get_task_last_cpu(taskDirectory, sample->tid);
+	}
+}
+#endif /* defined(LINUX) */
+
+/*
+ * See thread_api.h for description
+ */
+intptr_t
+omrthread_get_sched_stats(J9ThreadSchedStats *stats, uintptr_t *count, uintptr_t fields)
+{
+	omrthread_library_t lib = GLOBAL_DATA(default_library);
+	uintptr_t capacity = *count;
+	uintptr_t liveThreads = 0;
+	uintptr_t sampled = 0;
+	omrthread_t walkThread = NULL;
+	pool_state state;
+
+	/* Only snapshot the thread list under the global lock */
+	GLOBAL_LOCK_SIMPLE(lib);
+	walkThread = pool_startDo(lib->thread_pool, &state);
+	for (; NULL != walkThread; walkThread = pool_nextDo(&state)) {
+		uintptr_t flags = walkThread->flags;
+		if (OMR_ARE_ANY_BITS_SET(flags, J9THREAD_FLAG_STARTED | J9THREAD_FLAG_ATTACHED)
+			&& OMR_ARE_NO_BITS_SET(flags, J9THREAD_FLAG_DEAD)
+		) {
+			if (liveThreads < capacity) {
+				J9ThreadSchedStats *sample = &stats[liveThreads];
+				sample->thread = walkThread;
+				sample->tid = walkThread->tid;
+				sample->cpuTime = -1;
+				sample->runDelay = -1;
+				sample->voluntaryContextSwitches = -1;
+				sample->involuntaryContextSwitches = -1;
+				sample->lastCpu = -1;
+#if !defined(LINUX)
+				/* Without a batch source, fall back to the per-thread query while the thread cannot exit */
+				if (OMR_ARE_ANY_BITS_SET(fields, J9THREAD_SCHED_STATS_CPU_TIME)) {
+					int64_t cpuTime = 0;
+					THREAD_LOCK(walkThread, CALLER_GET_JVM_CPU_USAGE_INFO);
+					if (J9THREAD_SUCCESS == omrthread_get_cpu_time_ex(walkThread, &cpuTime)) {
+						sample->cpuTime = cpuTime;
+					}
+					THREAD_UNLOCK(walkThread);
+				}
+#endif /* !defined(LINUX) */
+			}
+			liveThreads += 1;
+		}
+	}
+	GLOBAL_UNLOCK_SIMPLE(lib);
+
+	sampled = (liveThreads < capacity) ? liveThreads : capacity;
+#if defined(LINUX)
+	if ((0 != sampled) && OMR_ARE_ANY_BITS_SET(fields, J9THREAD_SCHED_STATS_ALL)) {
+		int taskDirectory = open("/proc/self/task", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (-1 != taskDirectory) {
+			uintptr_t i = 0;
+			for (i = 0; i < sampled; i++) {
+				sampleTask(taskDirectory, &stats[i], fields);
+			}
+			close(taskDirectory);
+		}
+	}
+#endif /* defined(LINUX) */
+
+	*count = liveThreads;
+	return J9THREAD_SUCCESS;
+}
@@ -75,6 +75,8 @@ omr_add_exports(j9thr_obj
 	omrthread_tls_free
 	omrthread_tls_get
 	omrthread_tls_set
+	omrthread_tls_get_current
+	omrthread_tls_set_current
 	omrthread_yield
 	omrthread_yield_new
 	omrthread_exit
@@ -89,6 +91,13 @@ omr_add_exports(j9thr_obj
 	omrthread_monitor_init_walk
 	omrthread_monitor_walk
 	omrthread_monitor_walk_no_locking
+	omrthread_contention_profile_enable
+	omrthread_contention_profile_disable
+	omrthread_contention_profile_reset
+	omrthread_contention_profile_dump
+	omrthread_lock_order_enable
+	omrthread_lock_order_disable
+	omrthread_lock_order_export
 	omrthread_rwmutex_init
 	omrthread_rwmutex_destroy
 	omrthread_rwmutex_enter_read
@@ -103,6 +112,7 @@ omr_add_exports(j9thr_obj
 	omrthread_numa_set_enabled
 	omrthread_numa_set_node_affinity
 	omrthread_numa_get_node_affinity
+	omrthread_numa_get_thread_node
 	omrthread_map_native_priority
 	omrthread_set_priority_spread
 	omrthread_set_name
@@ -125,6 +135,7 @@ omr_add_exports(j9thr_obj
 	omrthread_attr_set_stacksize
 	omrthread_attr_set_category
 	omrthread_attr_set_detachstate
+	omrthread_attr_set_numa_placement
 
 	# for builder use only
 	omrthread_monitor_lock
@@ -155,9 +166,31 @@ omr_add_exports(j9thr_obj
 	omrthread_get_process_cpu_time
 	omrthread_get_jvm_cpu_usage_info
 	omrthread_get_jvm_cpu_usage_info_error_recovery
+	omrthread_get_sched_stats
 	omrthread_get_category
 	omrthread_set_category
 
+	# task pool
+	omrthread_taskpool_create
+	omrthread_taskpool_destroy
+	omrthread_taskpool_worker_count
+	omrthread_taskpool_worker_index
+	omrthread_task_init
+	omrthread_taskpool_fork
+	omrthread_taskpool_join
+	omrthread_taskpool_parallel_for
+
+	# parking lot and word locks
+	omrthread_parking_lot_park
+	omrthread_parking_lot_unpark_one
+	omrthread_parking_lot_unpark_all
+	omrthread_wordlock_enter
+	omrthread_wordlock_try_enter
+	omrthread_wordlock_exit
+	omrthread_wordlock_wait
+	omrthread_wordlock_notify
+	omrthread_wordlock_notify_all
+
 	# temp for the JIT
 	j9thread_self
 	j9thread_tls_get
@@ -41,6 +41,7 @@
 #include <stdio.h>
 
 #include "omrcfg.h"
+#include "omrutilbase.h"
 #include "threaddef.h"
 
 #if defined(J9ZTPF)
@@ -71,8 +72,13 @@ static cpu_set_t defaultAffinityMask = {{0}};
 static struct {
 	cpu_set_t cpu_set;
 	uintptr_t cpu_count;
+	uintptr_t usable_cpu_count; /* CPUs of this node which are also in defaultAffinityMask (i.e. allowed by the cgroup cpuset) */
+	volatile uintptr_t placed_count; /* live threads placed on this node by a placement policy */
 } *numaNodeData;
 
+/* next node to be used by J9THREAD_NUMA_PLACEMENT_INTERLEAVE */
+static volatile uintptr_t interleaveCursor = 0;
+
 /**
  * Tests whether a given bitfield is a subset or equal to another bitfield.
  * It does this by checking that each element of the subset has a
@@ -166,6 +172,8 @@ initializeNumaNodeData(omrthread_library_t threadLibrary, uintptr_t numNodes)
 		for (nodeIndex = 0; nodeIndex <= numNodes; nodeIndex++) {
 			CPU_ZERO(&numaNodeData[nodeIndex].cpu_set);
 			numaNodeData[nodeIndex].cpu_count = 0;
+			numaNodeData[nodeIndex].usable_cpu_count = 0;
+			numaNodeData[nodeIndex].placed_count = 0;
 		}
 
 		nodes = opendir(NODE_PATH);
@@ -307,6 +315,18 @@ omrthread_numa_init(omrthread_library_t threadLibrary)
 		isNumaAvailable = FALSE;
 	}
 
+	if (isNumaAvailable) {
+		/* The inherited mask already reflects any cgroup cpuset restriction, so it bounds what placement can use on each node */
+		uintptr_t node = 0;
+		for (node = 0; node <= numNodes; node++) {
+			cpu_set_t usableCPUs;
+
+			memcpy(&usableCPUs, &numaNodeData[node].cpu_set, sizeof(cpu_set_t));
+			cpuset_logical_and(&usableCPUs, &defaultAffinityMask);
+			numaNodeData[node].usable_cpu_count = CPU_COUNT(&usableCPUs);
+		}
+	}
+
 	if (!isNumaAvailable) {
 		/* Clean up */
 		omrthread_numa_shutdown(threadLibrary);
@@ -568,3 +588,127 @@ omrthread_numa_get_current_node()
 #endif
     return node;
 }
+
+#if defined(OMR_PORT_NUMA_SUPPORT)
+/**
+ * Pick the next node with usable CPUs in round-robin order.
+ *
+ * @return the node, or 0 if no node has a usable CPU
+ */
+static uintptr_t
+selectInterleavedNode(void)
+{
+	uintptr_t attempts = 0;
+
+	for (attempts = 0; attempts < numNodes; attempts++) {
+		uintptr_t node = ((addAtomic(&interleaveCursor, 1) - 1) % numNodes) + 1;
+		if (0 != numaNodeData[node].usable_cpu_count) {
+			return node;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Pick the lowest node which has fewer placed threads than usable CPUs. Once every
+ * node is full the overflow is interleaved. The counts are read without a lock, so
+ * concurrent creations may overfill a node by a few threads.
+ *
+ * @return the node, or 0 if no node has a usable CPU
+ */
+static uintptr_t
+selectFillFirstNode(void)
+{
+	uintptr_t node = 0;
+
+	for (node = 1; node <= numNodes; node++) {
+		if (numaNodeData[node].placed_count < numaNodeData[node].usable_cpu_count) {
+			return node;
+		}
+	}
+	return selectInterleavedNode();
+}
+
+void
+omrthread_numa_place_thread(omrthread_t thread, omrthread_numa_placement_t placement, omrthread_t colocateWith)
+{
+	uintptr_t node = 0;
+
+	thread->numaPlacementNode = 0;
+	if (isNumaAvailable) {
+		switch (placement) {
+		case J9THREAD_NUMA_PLACEMENT_INTERLEAVE:
+			node = selectInterleavedNode();
+			break;
+		case J9THREAD_NUMA_PLACEMENT_FILL_FIRST:
+			node = selectFillFirstNode();
+			break;
+		case J9THREAD_NUMA_PLACEMENT_COLOCATE: {
+			omrthread_t target = (NULL != colocateWith) ? colocateWith : MACRO_SELF();
+			if (NULL != target) {
+				BOOLEAN hasAffinity = FALSE;
+				uintptr_t targetNode = 0;
+
+				/* prefer the target's explicit binding, which may span several nodes */
+				THREAD_LOCK(target, CALLER_NUMA_COLOCATE);
+				for (targetNode = 1; targetNode <= numNodes; targetNode++) {
+					if (omrthread_does_affinity_cache_contain_node(target, targetNode)) {
+						omrthread_add_node_number_to_affinity_cache(thread, targetNode);
+						hasAffinity = TRUE;
+					}
+				}
+				THREAD_UNLOCK(target);
+				if (!hasAffinity) {
+					node = omrthread_numa_get_thread_node(target);
+				}
+			}
+			break;
+		}
+		default:
+			break;
+		}
+
+		if (0 != node) {
+			omrthread_add_node_number_to_affinity_cache(thread, node);
+			thread->numaPlacementNode = node;
+			addAtomic(&numaNodeData[node].placed_count, 1);
+		}
+	}
+}
+
+void
+omrthread_numa_release_thread(omrthread_t thread)
+{
+	uintptr_t node = thread->numaPlacementNode;
+
+	if ((0 != node) && (NULL != numaNodeData)) {
+		subtractAtomic(&numaNodeData[node].placed_count, 1);
+	}
+	thread->numaPlacementNode = 0;
+}
+#endif /* defined(OMR_PORT_NUMA_SUPPORT) */
+
+uintptr_t
+omrthread_numa_get_thread_node(omrthread_t thread)
+{
+	uintptr_t node = 0;
+#if defined(OMR_PORT_NUMA_SUPPORT)
+	if (isNumaAvailable && (NULL != thread)) {
+		if (MACRO_SELF() == thread) {
+			node = omrthread_numa_get_current_node();
+		} else if (0 != (thread->flags & (J9THREAD_FLAG_STARTED | J9THREAD_FLAG_ATTACHED))) {
+			intptr_t cpu = omrthread_get_task_last_cpu(AT_FDCWD, thread->tid);
+			if ((0 <= cpu) && (cpu < CPU_SETSIZE)) {
+				uintptr_t candidate = 0;
+				for (candidate = 1; candidate <= numNodes; candidate++) {
+					if (CPU_ISSET(cpu, &numaNodeData[candidate].cpu_set)) {
+						node = candidate;
+						break;
+					}
+				}
+			}
+		}
+	}
+#endif /* defined(OMR_PORT_NUMA_SUPPORT) */
+	return node;
+}
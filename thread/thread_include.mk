@@ -33,12 +33,16 @@ OBJECTS :=\
   j9sem \
   omrthread \
   omrthreadattr \
+  omrthreadcontention \
   omrthreaddebug \
   omrthreaderror \
   omrthreadinspect \
+  omrthreadlockorder \
   omrthreadmem \
   omrthreadnuma \
+  omrthreadparkinglot \
   omrthreadpriority \
+  omrthreadtaskpool \
   omrthreadtls \
   priority \
   thrcreate \
@@ -183,6 +187,8 @@ define WRITE_COMMON_THREAD_EXPORTS
 @echo omrthread_tls_free >>$@
 @echo omrthread_tls_get >>$@
 @echo omrthread_tls_set >>$@
+@echo omrthread_tls_get_current >>$@
+@echo omrthread_tls_set_current >>$@
 @echo omrthread_yield >>$@
 @echo omrthread_yield_new >>$@
 @echo omrthread_exit >>$@
@@ -197,6 +203,13 @@ define WRITE_COMMON_THREAD_EXPORTS
 @echo omrthread_monitor_init_walk >>$@
 @echo omrthread_monitor_walk >>$@
 @echo omrthread_monitor_walk_no_locking >>$@
+@echo omrthread_contention_profile_enable >>$@
+@echo omrthread_contention_profile_disable >>$@
+@echo omrthread_contention_profile_reset >>$@
+@echo omrthread_contention_profile_dump >>$@
+@echo omrthread_lock_order_enable >>$@
+@echo omrthread_lock_order_disable >>$@
+@echo omrthread_lock_order_export >>$@
 @echo omrthread_rwmutex_init >>$@
 @echo omrthread_rwmutex_destroy >>$@
 @echo omrthread_rwmutex_enter_read >>$@
@@ -211,6 +224,7 @@ define WRITE_COMMON_THREAD_EXPORTS
 @echo omrthread_numa_set_enabled >>$@
 @echo omrthread_numa_set_node_affinity >>$@
 @echo omrthread_numa_get_node_affinity >>$@
+@echo omrthread_numa_get_thread_node >>$@
 @echo omrthread_map_native_priority >>$@
 @echo omrthread_set_priority_spread >>$@
 @echo omrthread_set_name >>$@
@@ -233,6 +247,7 @@ define WRITE_COMMON_THREAD_EXPORTS
 @echo omrthread_attr_set_stacksize >>$@
 @echo omrthread_attr_set_category >>$@
 @echo omrthread_attr_set_detachstate>>$@
+@echo omrthread_attr_set_numa_placement >>$@
 
 @# for builder use only
 @echo omrthread_monitor_lock >>$@
@@ -263,9 +278,31 @@ define WRITE_COMMON_THREAD_EXPORTS
 @echo omrthread_get_process_cpu_time >>$@
 @echo omrthread_get_jvm_cpu_usage_info >>$@
 @echo omrthread_get_jvm_cpu_usage_info_error_recovery >>$@
+@echo omrthread_get_sched_stats >>$@
 @echo omrthread_get_category >>$@
 @echo omrthread_set_category >>$@
 
+@# task pool
+@echo omrthread_taskpool_create >>$@
+@echo omrthread_taskpool_destroy >>$@
+@echo omrthread_taskpool_worker_count >>$@
+@echo omrthread_taskpool_worker_index >>$@
+@echo omrthread_task_init >>$@
+@echo omrthread_taskpool_fork >>$@
+@echo omrthread_taskpool_join >>$@
+@echo omrthread_taskpool_parallel_for >>$@
+
+@# parking lot and word locks
+@echo omrthread_parking_lot_park >>$@
+@echo omrthread_parking_lot_unpark_one >>$@
+@echo omrthread_parking_lot_unpark_all >>$@
+@echo omrthread_wordlock_enter >>$@
+@echo omrthread_wordlock_try_enter >>$@
+@echo omrthread_wordlock_exit >>$@
+@echo omrthread_wordlock_wait >>$@
+@echo omrthread_wordlock_notify >>$@
+@echo omrthread_wordlock_notify_all >>$@
+
 @# temp for the JIT
 @echo j9thread_self >>$@
 @echo j9thread_tls_get >>$@
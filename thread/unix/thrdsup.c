@@ -39,6 +39,12 @@
 #include <tpf/tpfapi.h>
 #endif /* if defined(OMRZTPF) */
 
+#if defined(OMR_THR_FUTEX)
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif /* defined(OMR_THR_FUTEX) */
+
 #if (defined(LINUX) || defined(OSX)) && defined(J9X86)
 #include <fpu_control.h>
 #endif /* (defined(LINUX) || defined(OSX)) && defined(J9X86) */
@@ -455,3 +461,206 @@ j9OSCond_allocAndInit(J9OSCond *cond)
 }
 
 #endif /* defined(OMR_THR_FORK_SUPPORT) */
+
+#if defined(OMR_THR_FUTEX)
+
+#define J9_FUTEX_UNLOCKED 0
+#define J9_FUTEX_LOCKED 1
+#define J9_FUTEX_CONTENDED 2
+
+static intptr_t
+futexCall(volatile uint32_t *uaddr, int op, uint32_t val, const struct timespec *timeout, volatile uint32_t *uaddr2, uint32_t val3)
+{
+	return (intptr_t)syscall(SYS_futex, uaddr, op, val, timeout, uaddr2, val3);
+}
+
+static uint32_t
+futexExchange(volatile uint32_t *word, uint32_t newValue)
+{
+	uint32_t oldValue = *word;
+	uint32_t seen = 0;
+
+	while (oldValue != (seen = compareAndSwapU32((uint32_t *)word, oldValue, newValue))) {
+		oldValue = seen;
+	}
+	return oldValue;
+}
+
+/* Atomically increment a futex word, returning the new value */
+static uint32_t
+futexAdvance(volatile uint32_t *word)
+{
+	uint32_t oldValue = *word;
+	uint32_t seen = 0;
+
+	while (oldValue != (seen = compareAndSwapU32((uint32_t *)word, oldValue, oldValue + 1))) {
+		oldValue = seen;
+	}
+	return oldValue + 1;
+}
+
+/**
+ * Take a mutex that was found held, marking it contended so that the owner's
+ * exit wakes a sleeper. Also used to reacquire the mutex after a condition
+ * wait, since other waiters may have been requeued onto the same word.
+ */
+static void
+futexMutexEnterContended(J9OSFutexMutex *mutex)
+{
+	while (J9_FUTEX_UNLOCKED != futexExchange(&mutex->state, J9_FUTEX_CONTENDED)) {
+		futexCall(&mutex->state, FUTEX_WAIT | FUTEX_PRIVATE_FLAG, J9_FUTEX_CONTENDED, NULL, NULL, 0);
+	}
+}
+
+/**
+ * @param[in] mutex The mutex to init
+ * @return 1 on success
+ */
+intptr_t
+j9OSFutexMutex_init(J9OSFutexMutex *mutex)
+{
+	mutex->state = J9_FUTEX_UNLOCKED;
+	return 1;
+}
+
+/**
+ * @param[in] mutex The mutex to destroy
+ * @return 0 on success
+ */
+intptr_t
+j9OSFutexMutex_destroy(J9OSFutexMutex *mutex)
+{
+	return (J9_FUTEX_UNLOCKED == mutex->state) ? 0 : EBUSY;
+}
+
+/**
+ * @param[in] mutex The mutex to enter
+ * @return 0 on success
+ */
+intptr_t
+j9OSFutexMutex_enter(J9OSFutexMutex *mutex)
+{
+	if (J9_FUTEX_UNLOCKED != compareAndSwapU32((uint32_t *)&mutex->state, J9_FUTEX_UNLOCKED, J9_FUTEX_LOCKED)) {
+		futexMutexEnterContended(mutex);
+	}
+	return 0;
+}
+
+/**
+ * @param[in] mutex The mutex to exit
+ * @return 0 on success
+ */
+intptr_t
+j9OSFutexMutex_exit(J9OSFutexMutex *mutex)
+{
+	if (J9_FUTEX_CONTENDED == futexExchange(&mutex->state, J9_FUTEX_UNLOCKED)) {
+		futexCall(&mutex->state, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, NULL, NULL, 0);
+	}
+	return 0;
+}
+
+/**
+ * @param[in] cond The cond to init
+ * @return 1 on success
+ */
+intptr_t
+j9OSFutexCond_init(J9OSFutexCond *cond)
+{
+	cond->seq = 0;
+	return 1;
+}
+
+/**
+ * @param[in] cond The cond to destroy
+ * @return 0 on success
+ */
+intptr_t
+j9OSFutexCond_destroy(J9OSFutexCond *cond)
+{
+	return 0;
+}
+
+/**
+ * Release mutex, sleep until cond is notified or abstime passes, and reacquire mutex.
+ * As with pthread_cond_wait(), the caller must tolerate spurious wakeups.
+ *
+ * @param[in] cond The cond to wait on
+ * @param[in] mutex The mutex owned by the caller
+ * @param[in] abstime Deadline on TIMEOUT_CLOCK, or NULL to wait indefinitely
+ * @return 0 when woken, ETIMEDOUT if the deadline passed
+ */
+intptr_t
+j9OSFutexCond_wait(J9OSFutexCond *cond, J9OSFutexMutex *mutex, const struct timespec *abstime)
+{
+	uint32_t seq = cond->seq;
+	int op = FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG;
+	intptr_t rc = 0;
+
+#if J9THREAD_USE_MONOTONIC_COND_CLOCK
+	if (CLOCK_REALTIME == TIMEOUT_CLOCK) {
+		op |= FUTEX_CLOCK_REALTIME;
+	}
+#else /* J9THREAD_USE_MONOTONIC_COND_CLOCK */
+	op |= FUTEX_CLOCK_REALTIME;
+#endif /* J9THREAD_USE_MONOTONIC_COND_CLOCK */
+
+	j9OSFutexMutex_exit(mutex);
+	if ((0 != futexCall(&cond->seq, op, seq, abstime, NULL, FUTEX_BITSET_MATCH_ANY)) && (ETIMEDOUT == errno)) {
+		rc = ETIMEDOUT;
+	}
+	futexMutexEnterContended(mutex);
+	return rc;
+}
+
+/**
+ * @param[in] cond The cond to notify
+ * @return 0 on success
+ */
+intptr_t
+j9OSFutexCond_notify(J9OSFutexCond *cond)
+{
+	futexAdvance(&cond->seq);
+	futexCall(&cond->seq, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, NULL, NULL, 0);
+	return 0;
+}
+
+/**
+ * @param[in] cond The cond to notify
+ * @return 0 on success
+ */
+intptr_t
+j9OSFutexCond_notifyAll(J9OSFutexCond *cond)
+{
+	futexAdvance(&cond->seq);
+	futexCall(&cond->seq, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, INT_MAX, NULL, NULL, 0);
+	return 0;
+}
+
+/**
+ * Notify all waiters on cond without waking them: they are moved onto mutex
+ * with FUTEX_CMP_REQUEUE and run one at a time as the mutex is released,
+ * instead of waking only to block again on a mutex the notifier still holds.
+ *
+ * @note the caller must own mutex, and every waiter on cond must be waiting with mutex
+ * @param[in] cond The cond to notify
+ * @param[in] mutex The mutex owned by the caller
+ * @return 0 on success
+ */
+intptr_t
+j9OSFutexCond_notifyRequeue(J9OSFutexCond *cond, J9OSFutexMutex *mutex)
+{
+	uint32_t seq = futexAdvance(&cond->seq);
+	intptr_t requeued = futexCall(&cond->seq, FUTEX_CMP_REQUEUE | FUTEX_PRIVATE_FLAG, 0,
+			(const struct timespec *)(uintptr_t)INT_MAX, &mutex->state, seq);
+
+	if (requeued > 0) {
+		/* The requeued waiters are now sleeping on the mutex, so its exit has to wake them */
+		futexExchange(&mutex->state, J9_FUTEX_CONTENDED);
+	} else if (requeued < 0) {
+		/* cond was notified concurrently through another mutex; fall back to waking everyone */
+		futexCall(&cond->seq, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, INT_MAX, NULL, NULL, 0);
+	}
+	return 0;
+}
+
+#endif /* defined(OMR_THR_FUTEX) */
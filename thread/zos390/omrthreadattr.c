@@ -120,6 +120,10 @@ omrthread_attr_init(omrthread_attr_t *attr)
 		goto destroy_attr;
 	}
 
+	if (failedToSetAttr(omrthread_attr_set_numa_placement((omrthread_attr_t *)&newAttr, J9THREAD_NUMA_PLACEMENT_NONE, NULL))) {
+		goto destroy_attr;
+	}
+
 	*attr = (omrthread_attr_t)newAttr;
 	ASSERT(J9THREAD_ATTR_IS_VALID(attr));
 
@@ -324,6 +328,26 @@ omrthread_attr_set_category(omrthread_attr_t *attr, uint32_t category)
 	return rc;
 }
 
+/*
+ * See thread_api.h for description
+ */
+intptr_t
+omrthread_attr_set_numa_placement(omrthread_attr_t *attr, omrthread_numa_placement_t placement, omrthread_t colocateWith)
+{
+	if (!J9THREAD_ATTR_IS_VALID(attr)) {
+		return J9THREAD_ERR_INVALID_ATTR;
+	}
+
+	if ((placement < 0) || (placement >= omrthread_numa_placement_LastEnum)) {
+		return J9THREAD_ERR_INVALID_VALUE;
+	}
+
+	(*attr)->numaPlacement = placement;
+	(*attr)->numaColocateWith = (J9THREAD_NUMA_PLACEMENT_COLOCATE == placement) ? colocateWith : NULL;
+
+	return J9THREAD_SUCCESS;
+}
+
 static intptr_t
 failedToSetAttr(intptr_t rc)
 {